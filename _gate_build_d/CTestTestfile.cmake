@@ -0,0 +1,12 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_gate_build_d
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("_deps/opensslquic-build")
+subdirs("src/inc")
+subdirs("src/generated")
+subdirs("src/core")
+subdirs("src/platform")
+subdirs("src/bin")
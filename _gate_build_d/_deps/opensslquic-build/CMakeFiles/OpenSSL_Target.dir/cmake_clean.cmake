@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/OpenSSL_Target"
+  "quictls/lib/libcrypto.a"
+  "quictls/lib/libssl.a"
+  "submodules/quictls/Makefile"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/OpenSSL_Target.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
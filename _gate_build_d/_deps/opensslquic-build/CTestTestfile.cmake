@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/submodules
+# Build directory: /root/repo/_gate_build_d/_deps/opensslquic-build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
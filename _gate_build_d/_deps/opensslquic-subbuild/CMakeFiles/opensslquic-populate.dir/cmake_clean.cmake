@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/opensslquic-populate"
+  "CMakeFiles/opensslquic-populate-complete"
+  "opensslquic-populate-prefix/src/opensslquic-populate-stamp/opensslquic-populate-build"
+  "opensslquic-populate-prefix/src/opensslquic-populate-stamp/opensslquic-populate-configure"
+  "opensslquic-populate-prefix/src/opensslquic-populate-stamp/opensslquic-populate-download"
+  "opensslquic-populate-prefix/src/opensslquic-populate-stamp/opensslquic-populate-install"
+  "opensslquic-populate-prefix/src/opensslquic-populate-stamp/opensslquic-populate-mkdir"
+  "opensslquic-populate-prefix/src/opensslquic-populate-stamp/opensslquic-populate-patch"
+  "opensslquic-populate-prefix/src/opensslquic-populate-stamp/opensslquic-populate-test"
+  "opensslquic-populate-prefix/src/opensslquic-populate-stamp/opensslquic-populate-update"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/opensslquic-populate.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+cmake_minimum_required(VERSION 3.5)
+
+file(MAKE_DIRECTORY
+  "/root/repo/submodules"
+  "/root/repo/_gate_build_d/_deps/opensslquic-build"
+  "/root/repo/_gate_build_d/_deps/opensslquic-subbuild/opensslquic-populate-prefix"
+  "/root/repo/_gate_build_d/_deps/opensslquic-subbuild/opensslquic-populate-prefix/tmp"
+  "/root/repo/_gate_build_d/_deps/opensslquic-subbuild/opensslquic-populate-prefix/src/opensslquic-populate-stamp"
+  "/root/repo/_gate_build_d/_deps/opensslquic-subbuild/opensslquic-populate-prefix/src"
+  "/root/repo/_gate_build_d/_deps/opensslquic-subbuild/opensslquic-populate-prefix/src/opensslquic-populate-stamp"
+)
+
+set(configSubDirs )
+foreach(subDir IN LISTS configSubDirs)
+    file(MAKE_DIRECTORY "/root/repo/_gate_build_d/_deps/opensslquic-subbuild/opensslquic-populate-prefix/src/opensslquic-populate-stamp/${subDir}")
+endforeach()
+if(cfgdir)
+  file(MAKE_DIRECTORY "/root/repo/_gate_build_d/_deps/opensslquic-subbuild/opensslquic-populate-prefix/src/opensslquic-populate-stamp${cfgdir}") # cfgdir has leading slash
+endif()
@@ -0,0 +1,35 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/platform/certificates_posix.c" "src/platform/CMakeFiles/msquic_platform.dir/certificates_posix.c.o" "gcc" "src/platform/CMakeFiles/msquic_platform.dir/certificates_posix.c.o.d"
+  "/root/repo/src/platform/cgroup.c" "src/platform/CMakeFiles/msquic_platform.dir/cgroup.c.o" "gcc" "src/platform/CMakeFiles/msquic_platform.dir/cgroup.c.o.d"
+  "/root/repo/src/platform/crypt.c" "src/platform/CMakeFiles/msquic_platform.dir/crypt.c.o" "gcc" "src/platform/CMakeFiles/msquic_platform.dir/crypt.c.o.d"
+  "/root/repo/src/platform/crypt_openssl.c" "src/platform/CMakeFiles/msquic_platform.dir/crypt_openssl.c.o" "gcc" "src/platform/CMakeFiles/msquic_platform.dir/crypt_openssl.c.o.d"
+  "/root/repo/src/platform/datapath_epoll.c" "src/platform/CMakeFiles/msquic_platform.dir/datapath_epoll.c.o" "gcc" "src/platform/CMakeFiles/msquic_platform.dir/datapath_epoll.c.o.d"
+  "/root/repo/src/platform/datapath_linux.c" "src/platform/CMakeFiles/msquic_platform.dir/datapath_linux.c.o" "gcc" "src/platform/CMakeFiles/msquic_platform.dir/datapath_linux.c.o.d"
+  "/root/repo/src/platform/datapath_raw_dummy.c" "src/platform/CMakeFiles/msquic_platform.dir/datapath_raw_dummy.c.o" "gcc" "src/platform/CMakeFiles/msquic_platform.dir/datapath_raw_dummy.c.o.d"
+  "/root/repo/src/platform/datapath_unix.c" "src/platform/CMakeFiles/msquic_platform.dir/datapath_unix.c.o" "gcc" "src/platform/CMakeFiles/msquic_platform.dir/datapath_unix.c.o.d"
+  "/root/repo/src/platform/datapath_xplat.c" "src/platform/CMakeFiles/msquic_platform.dir/datapath_xplat.c.o" "gcc" "src/platform/CMakeFiles/msquic_platform.dir/datapath_xplat.c.o.d"
+  "/root/repo/src/platform/hashtable.c" "src/platform/CMakeFiles/msquic_platform.dir/hashtable.c.o" "gcc" "src/platform/CMakeFiles/msquic_platform.dir/hashtable.c.o.d"
+  "/root/repo/src/platform/pcp.c" "src/platform/CMakeFiles/msquic_platform.dir/pcp.c.o" "gcc" "src/platform/CMakeFiles/msquic_platform.dir/pcp.c.o.d"
+  "/root/repo/src/platform/platform_posix.c" "src/platform/CMakeFiles/msquic_platform.dir/platform_posix.c.o" "gcc" "src/platform/CMakeFiles/msquic_platform.dir/platform_posix.c.o.d"
+  "/root/repo/src/platform/platform_worker.c" "src/platform/CMakeFiles/msquic_platform.dir/platform_worker.c.o" "gcc" "src/platform/CMakeFiles/msquic_platform.dir/platform_worker.c.o.d"
+  "/root/repo/src/platform/selfsign_openssl.c" "src/platform/CMakeFiles/msquic_platform.dir/selfsign_openssl.c.o" "gcc" "src/platform/CMakeFiles/msquic_platform.dir/selfsign_openssl.c.o.d"
+  "/root/repo/src/platform/storage_posix.c" "src/platform/CMakeFiles/msquic_platform.dir/storage_posix.c.o" "gcc" "src/platform/CMakeFiles/msquic_platform.dir/storage_posix.c.o.d"
+  "/root/repo/src/platform/tls_quictls.c" "src/platform/CMakeFiles/msquic_platform.dir/tls_quictls.c.o" "gcc" "src/platform/CMakeFiles/msquic_platform.dir/tls_quictls.c.o.d"
+  "/root/repo/src/platform/toeplitz.c" "src/platform/CMakeFiles/msquic_platform.dir/toeplitz.c.o" "gcc" "src/platform/CMakeFiles/msquic_platform.dir/toeplitz.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
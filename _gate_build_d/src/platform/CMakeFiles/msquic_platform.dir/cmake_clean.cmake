@@ -0,0 +1,43 @@
+file(REMOVE_RECURSE
+  "../../obj/Debug/libmsquic_platform.a"
+  "../../obj/Debug/libmsquic_platform.pdb"
+  "CMakeFiles/msquic_platform.dir/certificates_posix.c.o"
+  "CMakeFiles/msquic_platform.dir/certificates_posix.c.o.d"
+  "CMakeFiles/msquic_platform.dir/cgroup.c.o"
+  "CMakeFiles/msquic_platform.dir/cgroup.c.o.d"
+  "CMakeFiles/msquic_platform.dir/crypt.c.o"
+  "CMakeFiles/msquic_platform.dir/crypt.c.o.d"
+  "CMakeFiles/msquic_platform.dir/crypt_openssl.c.o"
+  "CMakeFiles/msquic_platform.dir/crypt_openssl.c.o.d"
+  "CMakeFiles/msquic_platform.dir/datapath_epoll.c.o"
+  "CMakeFiles/msquic_platform.dir/datapath_epoll.c.o.d"
+  "CMakeFiles/msquic_platform.dir/datapath_linux.c.o"
+  "CMakeFiles/msquic_platform.dir/datapath_linux.c.o.d"
+  "CMakeFiles/msquic_platform.dir/datapath_raw_dummy.c.o"
+  "CMakeFiles/msquic_platform.dir/datapath_raw_dummy.c.o.d"
+  "CMakeFiles/msquic_platform.dir/datapath_unix.c.o"
+  "CMakeFiles/msquic_platform.dir/datapath_unix.c.o.d"
+  "CMakeFiles/msquic_platform.dir/datapath_xplat.c.o"
+  "CMakeFiles/msquic_platform.dir/datapath_xplat.c.o.d"
+  "CMakeFiles/msquic_platform.dir/hashtable.c.o"
+  "CMakeFiles/msquic_platform.dir/hashtable.c.o.d"
+  "CMakeFiles/msquic_platform.dir/pcp.c.o"
+  "CMakeFiles/msquic_platform.dir/pcp.c.o.d"
+  "CMakeFiles/msquic_platform.dir/platform_posix.c.o"
+  "CMakeFiles/msquic_platform.dir/platform_posix.c.o.d"
+  "CMakeFiles/msquic_platform.dir/platform_worker.c.o"
+  "CMakeFiles/msquic_platform.dir/platform_worker.c.o.d"
+  "CMakeFiles/msquic_platform.dir/selfsign_openssl.c.o"
+  "CMakeFiles/msquic_platform.dir/selfsign_openssl.c.o.d"
+  "CMakeFiles/msquic_platform.dir/storage_posix.c.o"
+  "CMakeFiles/msquic_platform.dir/storage_posix.c.o.d"
+  "CMakeFiles/msquic_platform.dir/tls_quictls.c.o"
+  "CMakeFiles/msquic_platform.dir/tls_quictls.c.o.d"
+  "CMakeFiles/msquic_platform.dir/toeplitz.c.o"
+  "CMakeFiles/msquic_platform.dir/toeplitz.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/msquic_platform.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,151 @@
+# Generated by CMake
+
+if("${CMAKE_MAJOR_VERSION}.${CMAKE_MINOR_VERSION}" LESS 2.8)
+   message(FATAL_ERROR "CMake >= 2.8.0 required")
+endif()
+if(CMAKE_VERSION VERSION_LESS "2.8.3")
+   message(FATAL_ERROR "CMake >= 2.8.3 required")
+endif()
+cmake_policy(PUSH)
+cmake_policy(VERSION 2.8.3...3.23)
+#----------------------------------------------------------------
+# Generated CMake target import file.
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Protect against multiple inclusion, which would fail when already imported targets are added once more.
+set(_cmake_targets_defined "")
+set(_cmake_targets_not_defined "")
+set(_cmake_expected_targets "")
+foreach(_cmake_expected_target IN ITEMS msquic::msquic msquic::platform msquic::inc msquic::logging_inc msquic::warnings msquic::main_binary_link_args msquic::OpenSSL msquic::OpenSSLQuic)
+  list(APPEND _cmake_expected_targets "${_cmake_expected_target}")
+  if(TARGET "${_cmake_expected_target}")
+    list(APPEND _cmake_targets_defined "${_cmake_expected_target}")
+  else()
+    list(APPEND _cmake_targets_not_defined "${_cmake_expected_target}")
+  endif()
+endforeach()
+unset(_cmake_expected_target)
+if(_cmake_targets_defined STREQUAL _cmake_expected_targets)
+  unset(_cmake_targets_defined)
+  unset(_cmake_targets_not_defined)
+  unset(_cmake_expected_targets)
+  unset(CMAKE_IMPORT_FILE_VERSION)
+  cmake_policy(POP)
+  return()
+endif()
+if(NOT _cmake_targets_defined STREQUAL "")
+  string(REPLACE ";" ", " _cmake_targets_defined_text "${_cmake_targets_defined}")
+  string(REPLACE ";" ", " _cmake_targets_not_defined_text "${_cmake_targets_not_defined}")
+  message(FATAL_ERROR "Some (but not all) targets in this export set were already defined.\nTargets Defined: ${_cmake_targets_defined_text}\nTargets not yet defined: ${_cmake_targets_not_defined_text}\n")
+endif()
+unset(_cmake_targets_defined)
+unset(_cmake_targets_not_defined)
+unset(_cmake_expected_targets)
+
+
+# Compute the installation prefix relative to this file.
+get_filename_component(_IMPORT_PREFIX "${CMAKE_CURRENT_LIST_FILE}" PATH)
+get_filename_component(_IMPORT_PREFIX "${_IMPORT_PREFIX}" PATH)
+get_filename_component(_IMPORT_PREFIX "${_IMPORT_PREFIX}" PATH)
+if(_IMPORT_PREFIX STREQUAL "/")
+  set(_IMPORT_PREFIX "")
+endif()
+
+# Create imported target msquic::msquic
+add_library(msquic::msquic SHARED IMPORTED)
+
+set_target_properties(msquic::msquic PROPERTIES
+  INTERFACE_INCLUDE_DIRECTORIES "${_IMPORT_PREFIX}/include"
+)
+
+# Create imported target msquic::platform
+add_library(msquic::platform STATIC IMPORTED)
+
+set_target_properties(msquic::platform PROPERTIES
+  INTERFACE_LINK_LIBRARIES "msquic::inc;\$<LINK_ONLY:msquic::warnings>;\$<LINK_ONLY:msquic::main_binary_link_args>;msquic::OpenSSL"
+)
+
+# Create imported target msquic::inc
+add_library(msquic::inc INTERFACE IMPORTED)
+
+set_target_properties(msquic::inc PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "_GNU_SOURCE;HAS_SENDMMSG;HAS__SC_PHYS_PAGES;HAS_SYSCONF;VER_BUILD_ID=0;VER_SUFFIX=-private;VER_GIT_HASH=a77c1f626a9926c18515b98f3b57f4e44613b129;QUIC_SENT_PACKET_RING=1;QUIC_TEST_OPENSSL_FLAGS=1;QUIC_ENABLE_CA_CERTIFICATE_FILE_TESTS;QUIC_EVENTS_STUB;QUIC_LOGS_STUB;CXPLAT_NUMA_AWARE;CX_PLATFORM_LINUX;QUIC_SHARED_EPHEMERAL_WORKAROUND"
+  INTERFACE_COMPILE_FEATURES "cxx_std_17;c_std_11"
+  INTERFACE_COMPILE_OPTIONS "-fms-extensions;-fPIC;\$<\$<COMPILE_LANGUAGE:CXX>:-fms-extensions;-fPIC>"
+  INTERFACE_INCLUDE_DIRECTORIES "${_IMPORT_PREFIX}/include"
+  INTERFACE_LINK_LIBRARIES "msquic::logging_inc"
+)
+
+# Create imported target msquic::logging_inc
+add_library(msquic::logging_inc INTERFACE IMPORTED)
+
+# Create imported target msquic::warnings
+add_library(msquic::warnings INTERFACE IMPORTED)
+
+set_target_properties(msquic::warnings PROPERTIES
+  INTERFACE_COMPILE_OPTIONS "-Werror;-Wall;-Wextra;-Wformat=2;-Wno-type-limits;-Wno-unknown-pragmas;-Wno-multichar;-Wno-missing-field-initializers"
+)
+
+# Create imported target msquic::main_binary_link_args
+add_library(msquic::main_binary_link_args INTERFACE IMPORTED)
+
+# Create imported target msquic::OpenSSL
+add_library(msquic::OpenSSL INTERFACE IMPORTED)
+
+set_target_properties(msquic::OpenSSL PROPERTIES
+  INTERFACE_LINK_LIBRARIES "msquic::OpenSSLQuic"
+)
+
+# Create imported target msquic::OpenSSLQuic
+add_library(msquic::OpenSSLQuic INTERFACE IMPORTED)
+
+set_target_properties(msquic::OpenSSLQuic PROPERTIES
+  INTERFACE_INCLUDE_DIRECTORIES "${_IMPORT_PREFIX}/include"
+  INTERFACE_LINK_LIBRARIES "/root/repo/_gate_build_r/_deps/opensslquic-build/quictls/lib/libssl.a;/root/repo/_gate_build_r/_deps/opensslquic-build/quictls/lib/libcrypto.a"
+)
+
+if(CMAKE_VERSION VERSION_LESS 3.0.0)
+  message(FATAL_ERROR "This file relies on consumers using CMake 3.0.0 or greater.")
+endif()
+
+# Load information for each installed configuration.
+file(GLOB _cmake_config_files "${CMAKE_CURRENT_LIST_DIR}/msquic-*.cmake")
+foreach(_cmake_config_file IN LISTS _cmake_config_files)
+  include("${_cmake_config_file}")
+endforeach()
+unset(_cmake_config_file)
+unset(_cmake_config_files)
+
+# Cleanup temporary variables.
+set(_IMPORT_PREFIX)
+
+# Loop over all imported files and verify that they actually exist
+foreach(_cmake_target IN LISTS _cmake_import_check_targets)
+  foreach(_cmake_file IN LISTS "_cmake_import_check_files_for_${_cmake_target}")
+    if(NOT EXISTS "${_cmake_file}")
+      message(FATAL_ERROR "The imported target \"${_cmake_target}\" references the file
+   \"${_cmake_file}\"
+but this file does not exist.  Possible reasons include:
+* The file was deleted, renamed, or moved to another location.
+* An install or uninstall procedure did not complete successfully.
+* The installation package was faulty and contained
+   \"${CMAKE_CURRENT_LIST_FILE}\"
+but not all the files it references.
+")
+    endif()
+  endforeach()
+  unset(_cmake_file)
+  unset("_cmake_import_check_files_for_${_cmake_target}")
+endforeach()
+unset(_cmake_target)
+unset(_cmake_import_check_targets)
+
+# This file does not depend on other imported targets which have
+# been exported from the same project but in a separate export set.
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
+cmake_policy(POP)
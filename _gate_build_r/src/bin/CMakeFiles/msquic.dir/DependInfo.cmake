@@ -0,0 +1,28 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/bin/linux/init.c" "src/bin/CMakeFiles/msquic.dir/linux/init.c.o" "gcc" "src/bin/CMakeFiles/msquic.dir/linux/init.c.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/_gate_build_r/bin/Release/libmsquic.so" "/root/repo/_gate_build_r/bin/Release/libmsquic.so.2.7.0"
+  "/root/repo/_gate_build_r/bin/Release/libmsquic.so.2" "/root/repo/_gate_build_r/bin/Release/libmsquic.so.2.7.0"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build_r/src/core/CMakeFiles/core.dir/DependInfo.cmake"
+  "/root/repo/_gate_build_r/src/platform/CMakeFiles/msquic_platform.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../../bin/Release/libmsquic.pdb"
+  "../../bin/Release/libmsquic.so"
+  "../../bin/Release/libmsquic.so.2"
+  "../../bin/Release/libmsquic.so.2.7.0"
+  "CMakeFiles/msquic.dir/linux/init.c.o"
+  "CMakeFiles/msquic.dir/linux/init.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/msquic.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,93 @@
+file(REMOVE_RECURSE
+  "../../obj/Release/libcore.a"
+  "../../obj/Release/libcore.pdb"
+  "CMakeFiles/core.dir/ack_tracker.c.o"
+  "CMakeFiles/core.dir/ack_tracker.c.o.d"
+  "CMakeFiles/core.dir/api.c.o"
+  "CMakeFiles/core.dir/api.c.o.d"
+  "CMakeFiles/core.dir/bbr.c.o"
+  "CMakeFiles/core.dir/bbr.c.o.d"
+  "CMakeFiles/core.dir/bbr3.c.o"
+  "CMakeFiles/core.dir/bbr3.c.o.d"
+  "CMakeFiles/core.dir/binding.c.o"
+  "CMakeFiles/core.dir/binding.c.o.d"
+  "CMakeFiles/core.dir/configuration.c.o"
+  "CMakeFiles/core.dir/configuration.c.o.d"
+  "CMakeFiles/core.dir/congestion_control.c.o"
+  "CMakeFiles/core.dir/congestion_control.c.o.d"
+  "CMakeFiles/core.dir/connection.c.o"
+  "CMakeFiles/core.dir/connection.c.o.d"
+  "CMakeFiles/core.dir/connection_pool.c.o"
+  "CMakeFiles/core.dir/connection_pool.c.o.d"
+  "CMakeFiles/core.dir/crypto.c.o"
+  "CMakeFiles/core.dir/crypto.c.o.d"
+  "CMakeFiles/core.dir/crypto_tls.c.o"
+  "CMakeFiles/core.dir/crypto_tls.c.o.d"
+  "CMakeFiles/core.dir/cubic.c.o"
+  "CMakeFiles/core.dir/cubic.c.o.d"
+  "CMakeFiles/core.dir/custom_cc.c.o"
+  "CMakeFiles/core.dir/custom_cc.c.o.d"
+  "CMakeFiles/core.dir/datagram.c.o"
+  "CMakeFiles/core.dir/datagram.c.o.d"
+  "CMakeFiles/core.dir/frame.c.o"
+  "CMakeFiles/core.dir/frame.c.o.d"
+  "CMakeFiles/core.dir/library.c.o"
+  "CMakeFiles/core.dir/library.c.o.d"
+  "CMakeFiles/core.dir/listener.c.o"
+  "CMakeFiles/core.dir/listener.c.o.d"
+  "CMakeFiles/core.dir/lookup.c.o"
+  "CMakeFiles/core.dir/lookup.c.o.d"
+  "CMakeFiles/core.dir/loss_detection.c.o"
+  "CMakeFiles/core.dir/loss_detection.c.o.d"
+  "CMakeFiles/core.dir/mtu_discovery.c.o"
+  "CMakeFiles/core.dir/mtu_discovery.c.o.d"
+  "CMakeFiles/core.dir/operation.c.o"
+  "CMakeFiles/core.dir/operation.c.o.d"
+  "CMakeFiles/core.dir/pacing_wheel.c.o"
+  "CMakeFiles/core.dir/pacing_wheel.c.o.d"
+  "CMakeFiles/core.dir/packet.c.o"
+  "CMakeFiles/core.dir/packet.c.o.d"
+  "CMakeFiles/core.dir/packet_builder.c.o"
+  "CMakeFiles/core.dir/packet_builder.c.o.d"
+  "CMakeFiles/core.dir/packet_space.c.o"
+  "CMakeFiles/core.dir/packet_space.c.o.d"
+  "CMakeFiles/core.dir/partition.c.o"
+  "CMakeFiles/core.dir/partition.c.o.d"
+  "CMakeFiles/core.dir/path.c.o"
+  "CMakeFiles/core.dir/path.c.o.d"
+  "CMakeFiles/core.dir/range.c.o"
+  "CMakeFiles/core.dir/range.c.o.d"
+  "CMakeFiles/core.dir/recv_buffer.c.o"
+  "CMakeFiles/core.dir/recv_buffer.c.o.d"
+  "CMakeFiles/core.dir/registration.c.o"
+  "CMakeFiles/core.dir/registration.c.o.d"
+  "CMakeFiles/core.dir/send.c.o"
+  "CMakeFiles/core.dir/send.c.o.d"
+  "CMakeFiles/core.dir/send_buffer.c.o"
+  "CMakeFiles/core.dir/send_buffer.c.o.d"
+  "CMakeFiles/core.dir/sent_packet_metadata.c.o"
+  "CMakeFiles/core.dir/sent_packet_metadata.c.o.d"
+  "CMakeFiles/core.dir/settings.c.o"
+  "CMakeFiles/core.dir/settings.c.o.d"
+  "CMakeFiles/core.dir/sliding_window_extremum.c.o"
+  "CMakeFiles/core.dir/sliding_window_extremum.c.o.d"
+  "CMakeFiles/core.dir/stream.c.o"
+  "CMakeFiles/core.dir/stream.c.o.d"
+  "CMakeFiles/core.dir/stream_recv.c.o"
+  "CMakeFiles/core.dir/stream_recv.c.o.d"
+  "CMakeFiles/core.dir/stream_send.c.o"
+  "CMakeFiles/core.dir/stream_send.c.o.d"
+  "CMakeFiles/core.dir/stream_set.c.o"
+  "CMakeFiles/core.dir/stream_set.c.o.d"
+  "CMakeFiles/core.dir/timer_wheel.c.o"
+  "CMakeFiles/core.dir/timer_wheel.c.o.d"
+  "CMakeFiles/core.dir/version_neg.c.o"
+  "CMakeFiles/core.dir/version_neg.c.o.d"
+  "CMakeFiles/core.dir/worker.c.o"
+  "CMakeFiles/core.dir/worker.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/core/crypto_tls.c" "src/core/CMakeFiles/core_fuzz.dir/crypto_tls.c.o" "gcc" "src/core/CMakeFiles/core_fuzz.dir/crypto_tls.c.o.d"
+  "/root/repo/src/core/frame.c" "src/core/CMakeFiles/core_fuzz.dir/frame.c.o" "gcc" "src/core/CMakeFiles/core_fuzz.dir/frame.c.o.d"
+  "/root/repo/src/core/range.c" "src/core/CMakeFiles/core_fuzz.dir/range.c.o" "gcc" "src/core/CMakeFiles/core_fuzz.dir/range.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
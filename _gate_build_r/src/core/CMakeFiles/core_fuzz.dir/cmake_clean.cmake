@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "../../obj/Release/libcore_fuzz.a"
+  "../../obj/Release/libcore_fuzz.pdb"
+  "CMakeFiles/core_fuzz.dir/crypto_tls.c.o"
+  "CMakeFiles/core_fuzz.dir/crypto_tls.c.o.d"
+  "CMakeFiles/core_fuzz.dir/frame.c.o"
+  "CMakeFiles/core_fuzz.dir/frame.c.o.d"
+  "CMakeFiles/core_fuzz.dir/range.c.o"
+  "CMakeFiles/core_fuzz.dir/range.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/core_fuzz.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
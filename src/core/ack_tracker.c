@@ -78,6 +78,7 @@ QuicAckTrackerReset(
     Tracker->LargestPacketNumberRecvTime = 0;
     Tracker->AlreadyWrittenAckFrame = FALSE;
     Tracker->NonZeroRecvECN = FALSE;
+    Tracker->LastRecvCe = FALSE;
     CxPlatZeroMemory(&Tracker->ReceivedECN, sizeof(Tracker->ReceivedECN));
     QuicRangeReset(&Tracker->PacketNumbersToAck);
     QuicRangeReset(&Tracker->PacketNumbersReceived);
@@ -226,11 +227,15 @@ QuicAckTrackerAckPacket(
         case CXPLAT_ECN_CE:
             Tracker->NonZeroRecvECN = TRUE;
             Tracker->ReceivedECN.CE_Count++;
+            Connection->Stats.Recv.EcnCePackets++;
             break;
         default:
             break;
     }
 
+    const BOOLEAN CeStateChanged = Tracker->LastRecvCe != (ECN == CXPLAT_ECN_CE);
+    Tracker->LastRecvCe = ECN == CXPLAT_ECN_CE;
+
     Tracker->AlreadyWrittenAckFrame = FALSE;
 
     if (AckType == QUIC_ACK_TYPE_NON_ACK_ELICITING) {
@@ -253,7 +258,9 @@ QuicAckTrackerAckPacket(
     //      gap between the smallest Unreported Missing packet and the Largest
     //      Unacked is greater than or equal to the Reordering Threshold value. This logic is
     //      disabled if the Reordering Threshold is 0.
-    //   5. The delayed ACK timer fires after the configured time.
+    //   5. The packet's CE marking differs from the previous packet's, so the
+    //      peer gets CE feedback once per congestion episode without delay.
+    //   6. The delayed ACK timer fires after the configured time.
     //
     // If we don't queue an immediate ACK and this is the first ACK eliciting
     // packet received, we make sure the ACK delay timer is started.
@@ -262,6 +269,7 @@ QuicAckTrackerAckPacket(
     if (AckType == QUIC_ACK_TYPE_ACK_IMMEDIATE ||
         Connection->Settings.MaxAckDelayMs == 0 ||
         (Tracker->AckElicitingPacketsToAcknowledge >= (uint16_t)Connection->PacketTolerance) ||
+        CeStateChanged ||
         (NewLargestPacketNumber && 
         QuicAckTrackerDidHitReorderingThreshold(Tracker, Connection->ReorderingThreshold))) {
         //
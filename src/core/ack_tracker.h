@@ -56,6 +56,13 @@ typedef struct QUIC_ACK_TRACKER {
     //
     BOOLEAN NonZeroRecvECN : 1;
 
+    //
+    // Indicates that the last received packet was marked CE. A change in this
+    // state triggers an immediate ACK so that the peer learns about each
+    // congestion episode within a round trip.
+    //
+    BOOLEAN LastRecvCe : 1;
+
 } QUIC_ACK_TRACKER;
 
 //
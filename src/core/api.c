@@ -1256,11 +1256,15 @@ MsQuicStreamSend(
         QUIC_SEND_REQUEST** ApiSendRequestsTail = &Stream->ApiSendRequests;
         while (*ApiSendRequestsTail != NULL) {
             ApiSendRequestsTail = &((*ApiSendRequestsTail)->Next);
-            QueueOper = FALSE; // Not necessary if the previous send hasn't been flushed yet.
         }
         *ApiSendRequestsTail = SendRequest;
         Status = QUIC_STATUS_SUCCESS;
 
+        //
+        // Not necessary if a queued operation hasn't flushed the stream yet.
+        //
+        QueueOper = !Stream->ApiSendQueued;
+
         if (!SendInline && QueueOper) {
             //
             // Async stream operations need to hold a ref on the stream so that
@@ -1268,6 +1272,7 @@ MsQuicStreamSend(
             // ref is released after the operation is processed.
             //
             QuicStreamAddRef(Stream, QUIC_STREAM_REF_OPERATION);
+            Stream->ApiSendQueued = TRUE;
         }
     }
     CxPlatDispatchLockRelease(&Stream->ApiSendRequestLock);
@@ -1297,6 +1302,16 @@ MsQuicStreamSend(
         }
 
     } else if (QueueOper) {
+        if (!IsPriority &&
+            QuicOperationCoalesceStreamSend(
+                &Connection->OperQ, Connection->Partition, Stream)) {
+            //
+            // The stream was added to the send operation already at the tail
+            // of the queue, along with the ref we took above.
+            //
+            goto Exit;
+        }
+
         Oper = QuicConnAllocOperation(Connection, QUIC_OPER_TYPE_API_CALL);
         if (Oper == NULL) {
             QuicTraceEvent(
@@ -1309,6 +1324,9 @@ MsQuicStreamSend(
             // We failed to alloc the operation we needed to queue, so make sure
             // to release the ref we took above.
             //
+            CxPlatDispatchLockAcquire(&Stream->ApiSendRequestLock);
+            Stream->ApiSendQueued = FALSE;
+            CxPlatDispatchLockRelease(&Stream->ApiSendRequestLock);
             QuicStreamRelease(Stream, QUIC_STREAM_REF_OPERATION);
 
             //
@@ -1336,6 +1354,7 @@ MsQuicStreamSend(
 
         Oper->API_CALL.Context->Type = QUIC_API_TYPE_STRM_SEND;
         Oper->API_CALL.Context->STRM_SEND.Stream = Stream;
+        Oper->API_CALL.Context->STRM_SEND.LastStream = Stream;
 
         //
         // Queue the operation but don't wait for the completion.
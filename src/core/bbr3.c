@@ -0,0 +1,1727 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Bottleneck Bandwidth and RTT version 3 (BBRv3) congestion control.
+
+    Compared to bbr.c, the model is additionally bounded by loss and ECN:
+
+    - InflightHi is the volume of inflight data that last caused more than
+      kBbr3LossThreshPercent loss (or a CE ratio above kBbr3EcnThresh) while
+      probing. It is only raised again by an explicit probe.
+    - BwLo / InflightLo are short term lower bounds, multiplicatively reduced
+      by kBbr3Beta on every round with loss (and by the ECN alpha on every
+      round with CE marks) while not probing.
+
+    PROBE_BW is split into DOWN / CRUISE / REFILL / UP phases. Bandwidth is
+    only probed every 2-3 seconds (or sooner if a Reno flow would have probed
+    by then), which keeps the time spent above the bottleneck rate, and thus
+    the harm to coexisting loss based flows, low.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "bbr3.c.clog.h"
+#endif
+
+typedef enum BBR3_STATE {
+
+    BBR3_STATE_STARTUP,
+
+    BBR3_STATE_DRAIN,
+
+    BBR3_STATE_PROBE_BW_DOWN,
+
+    BBR3_STATE_PROBE_BW_CRUISE,
+
+    BBR3_STATE_PROBE_BW_REFILL,
+
+    BBR3_STATE_PROBE_BW_UP,
+
+    BBR3_STATE_PROBE_RTT
+
+} BBR3_STATE;
+
+typedef enum BBR3_RECOVERY_STATE {
+
+    BBR3_RECOVERY_STATE_NOT_RECOVERY = 0,
+
+    BBR3_RECOVERY_STATE_CONSERVATIVE = 1,
+
+    BBR3_RECOVERY_STATE_GROWTH = 2,
+
+} BBR3_RECOVERY_STATE;
+
+//
+// Bandwidth is measured as (bytes / BW_UNIT) per second
+//
+#define BW_UNIT 8 // 1 << 3
+
+//
+// Gain is measured as (1 / GAIN_UNIT)
+//
+#define GAIN_UNIT 256 // 1 << 8
+
+#define kBbr3MicroSecsInSec 1000000ULL
+
+#define kBbr3MilliSecsInSec 1000ULL
+
+static const uint64_t kBbr3QuantaFactor = 3;
+
+static const uint32_t kBbr3MinCwndInMss = 4;
+
+static const uint32_t kBbr3DefaultRecoveryCwndInMss = 2000;
+
+static const uint64_t kBbr3LowPacingRateThresholdBytesPerSecond = 1200ULL * 1000;
+
+static const uint64_t kBbr3HighPacingRateThresholdBytesPerSecond = 24ULL * 1000 * 1000;
+
+//
+// Gains for each state.
+//
+static const uint32_t kBbr3StartupPacingGain = GAIN_UNIT * 277 / 100; // 4*ln(2)
+static const uint32_t kBbr3StartupCwndGain = GAIN_UNIT * 2;
+static const uint32_t kBbr3DrainPacingGain = GAIN_UNIT * 35 / 100;
+static const uint32_t kBbr3CwndGain = GAIN_UNIT * 2;
+static const uint32_t kBbr3ProbeUpCwndGain = GAIN_UNIT * 9 / 4;
+static const uint32_t kBbr3ProbeDownPacingGain = GAIN_UNIT * 90 / 100;
+static const uint32_t kBbr3ProbeUpPacingGain = GAIN_UNIT * 5 / 4;
+static const uint32_t kBbr3ProbeRttCwndGain = GAIN_UNIT / 2;
+
+//
+// Pace slightly below the estimated bandwidth to avoid building a queue.
+//
+static const uint32_t kBbr3PacingMarginPercent = 1;
+
+//
+// The expected bandwidth growth per round trip during STARTUP, and how many
+// rounds without it until the pipe is considered full.
+//
+static const uint32_t kBbr3StartupGrowthTarget = GAIN_UNIT * 5 / 4;
+static const uint8_t kBbr3StartupFullBwRounds = 3;
+
+//
+// Loss rate (per round trip) above which inflight is considered too high.
+//
+static const uint32_t kBbr3LossThreshPercent = 2;
+
+//
+// Minimum number of lost packets in a STARTUP round before loss ends STARTUP.
+//
+static const uint32_t kBbr3StartupFullLossCount = 6;
+
+//
+// Multiplicative decrease applied to the lower bounds on loss.
+//
+static const uint32_t kBbr3Beta = GAIN_UNIT * 7 / 10;
+
+//
+// Fraction of InflightHi left unused while cruising, so other flows can grow.
+//
+static const uint32_t kBbr3Headroom = GAIN_UNIT * 15 / 100;
+
+//
+// CE ratio above which inflight is considered too high, the EWMA gain of the
+// ECN alpha (as a shift) and the fraction of alpha applied to InflightLo.
+//
+static const uint32_t kBbr3EcnThresh = GAIN_UNIT / 2;
+static const uint32_t kBbr3EcnAlphaGainShift = 4;
+static const uint32_t kBbr3EcnFactor = GAIN_UNIT / 3;
+static const uint8_t kBbr3StartupEcnRounds = 2;
+
+//
+// Wall clock time between bandwidth probes is uniformly chosen in
+// [kBbr3ProbeWaitBaseUs, kBbr3ProbeWaitBaseUs + kBbr3ProbeWaitRandUs).
+// A probe also starts after at most kBbr3ProbeBwMaxRounds round trips, or
+// the BDP in packets if lower, which is when Reno would have probed.
+//
+static const uint64_t kBbr3ProbeWaitBaseUs = S_TO_US(2);
+static const uint32_t kBbr3ProbeWaitRandUs = S_TO_US(1);
+static const uint32_t kBbr3ProbeBwMaxRounds = 63;
+
+//
+// PROBE_RTT is entered when the min RTT has not been refreshed for
+// kBbr3ProbeRttIntervalUs, and held for at least kBbr3ProbeRttTimeInUs.
+//
+static const uint64_t kBbr3ProbeRttIntervalUs = S_TO_US(5);
+static const uint32_t kBbr3ProbeRttTimeInUs = 200 * 1000;
+
+//
+// Time until a MinRtt measurement is expired.
+//
+static const uint64_t kBbr3MinRttExpirationInMicroSecs = S_TO_US(10);
+
+static const uint32_t kBbr3MaxAckHeightFilterLen = 10;
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint64_t
+Bbr3CongestionControlGetMaxBandwidth(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return CXPLAT_MAX(Cc->Bbr3.MaxBwFilter[0], Cc->Bbr3.MaxBwFilter[1]);
+}
+
+//
+// The bandwidth used by the model: the max bandwidth, bounded by BwLo.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint64_t
+Bbr3CongestionControlGetBandwidth(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return CXPLAT_MIN(Bbr3CongestionControlGetMaxBandwidth(Cc), Cc->Bbr3.BwLo);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+Bbr3CongestionControlGetMinCongestionWindow(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const uint16_t DatagramPayloadLength =
+        // NOLINTNEXTLINE(clang-analyzer-security.ArrayBound): False positive: embedded Cc is valid.
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+    return kBbr3MinCwndInMss * DatagramPayloadLength;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+Bbr3CongestionControlInRecovery(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Bbr3.RecoveryState != BBR3_RECOVERY_STATE_NOT_RECOVERY;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+Bbr3CongestionControlIsProbingBw(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return
+        Cc->Bbr3.BbrState == BBR3_STATE_STARTUP ||
+        Cc->Bbr3.BbrState == BBR3_STATE_PROBE_BW_REFILL ||
+        Cc->Bbr3.BbrState == BBR3_STATE_PROBE_BW_UP;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+Bbr3CongestionControlIsProbeBw(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return
+        Cc->Bbr3.BbrState >= BBR3_STATE_PROBE_BW_DOWN &&
+        Cc->Bbr3.BbrState <= BBR3_STATE_PROBE_BW_UP;
+}
+
+//
+// Returns Gain * BDP plus the send quanta, using the model bandwidth.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+Bbr3CongestionControlGetTargetCwnd(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t Gain
+    )
+{
+    const QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    uint64_t BandwidthEst = Bbr3CongestionControlGetBandwidth(Cc);
+
+    if (!BandwidthEst || !Bbr->MinRttTimestampValid) {
+        return (uint32_t)((uint64_t)Gain * Bbr->InitialCongestionWindow / GAIN_UNIT);
+    }
+
+    uint64_t Bdp = BandwidthEst * Bbr->MinRtt / kBbr3MicroSecsInSec / BW_UNIT;
+    uint64_t TargetCwnd = (Bdp * Gain / GAIN_UNIT) + (kBbr3QuantaFactor * Bbr->SendQuantum);
+    return (uint32_t)CXPLAT_MIN(TargetCwnd, UINT32_MAX);
+}
+
+//
+// InflightHi less some headroom, used as the cap while cruising.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+Bbr3CongestionControlGetInflightWithHeadroom(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    if (Bbr->InflightHi == UINT32_MAX) {
+        return UINT32_MAX;
+    }
+
+    const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+
+    uint32_t Headroom = CXPLAT_MAX(
+        (uint32_t)((uint64_t)Bbr->InflightHi * kBbr3Headroom / GAIN_UNIT),
+        (uint32_t)DatagramPayloadLength);
+    uint32_t Inflight = Bbr->InflightHi > Headroom ? Bbr->InflightHi - Headroom : 0;
+    return CXPLAT_MAX(Inflight, Bbr3CongestionControlGetMinCongestionWindow(Cc));
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+Bbr3CongestionControlGetProbeRttCwnd(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return CXPLAT_MAX(
+        Bbr3CongestionControlGetTargetCwnd(Cc, kBbr3ProbeRttCwndGain),
+        Bbr3CongestionControlGetMinCongestionWindow(Cc));
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+Bbr3CongestionControlGetCongestionWindow(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    if (Bbr->BbrState == BBR3_STATE_PROBE_RTT) {
+        return CXPLAT_MIN(Bbr->CongestionWindow, Bbr3CongestionControlGetProbeRttCwnd(Cc));
+    }
+
+    if (Bbr3CongestionControlInRecovery(Cc)) {
+        return CXPLAT_MIN(Bbr->CongestionWindow, Bbr->RecoveryWindow);
+    }
+
+    return Bbr->CongestionWindow;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+Bbr3CongestionControlIsAppLimited(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Bbr3.AppLimited;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicConnLogBbr3(
+    _In_ QUIC_CONNECTION* const Connection
+    )
+{
+    QUIC_CONGESTION_CONTROL* Cc = &Connection->CongestionControl;
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    QuicTraceEvent(
+        ConnBbr,
+        "[conn][%p] BBR: State=%u RState=%u CongestionWindow=%u BytesInFlight=%u BytesInFlightMax=%u MinRttEst=%lu EstBw=%lu AppLimited=%u",
+        Connection,
+        Bbr->BbrState,
+        Bbr->RecoveryState,
+        Bbr3CongestionControlGetCongestionWindow(Cc),
+        Bbr->BytesInFlight,
+        Bbr->BytesInFlightMax,
+        Bbr->MinRtt,
+        Bbr3CongestionControlGetBandwidth(Cc) / BW_UNIT,
+        Bbr3CongestionControlIsAppLimited(Cc));
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlGetNetworkStatistics(
+    _In_ const QUIC_CONNECTION* const Connection,
+    _In_ const QUIC_CONGESTION_CONTROL* const Cc,
+    _Out_ QUIC_NETWORK_STATISTICS* NetworkStatistics
+    )
+{
+    const QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+    const QUIC_PATH* Path = &Connection->Paths[0];
+
+    NetworkStatistics->BytesInFlight = Bbr->BytesInFlight;
+    NetworkStatistics->PostedBytes = Connection->SendBuffer.PostedBytes;
+    NetworkStatistics->IdealBytes = Connection->SendBuffer.IdealBytes;
+    NetworkStatistics->SmoothedRTT = Path->SmoothedRtt;
+    NetworkStatistics->CongestionWindow = Bbr3CongestionControlGetCongestionWindow(Cc);
+    NetworkStatistics->Bandwidth = Bbr3CongestionControlGetBandwidth(Cc) / BW_UNIT;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlIndicateConnectionEvent(
+    _In_ QUIC_CONNECTION* const Connection,
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONNECTION_EVENT Event;
+    Event.Type = QUIC_CONNECTION_EVENT_NETWORK_STATISTICS;
+
+    Bbr3CongestionControlGetNetworkStatistics(Connection, Cc, &Event.NETWORK_STATISTICS);
+
+    QuicTraceLogConnVerbose(
+        IndicateDataAcked,
+        Connection,
+        "Indicating QUIC_CONNECTION_EVENT_NETWORK_STATISTICS [BytesInFlight=%u,PostedBytes=%llu,IdealBytes=%llu,SmoothedRTT=%llu,CongestionWindow=%u,Bandwidth=%llu]",
+        Event.NETWORK_STATISTICS.BytesInFlight,
+        Event.NETWORK_STATISTICS.PostedBytes,
+        Event.NETWORK_STATISTICS.IdealBytes,
+        Event.NETWORK_STATISTICS.SmoothedRTT,
+        Event.NETWORK_STATISTICS.CongestionWindow,
+        Event.NETWORK_STATISTICS.Bandwidth);
+    QuicConnIndicateEvent(Connection, &Event);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+Bbr3CongestionControlCanSend(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    uint32_t CongestionWindow = Bbr3CongestionControlGetCongestionWindow(Cc);
+    return Cc->Bbr3.BytesInFlight < CongestionWindow || Cc->Bbr3.Exemptions > 0;
+}
+
+void
+Bbr3CongestionControlLogOutFlowStatus(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const QUIC_PATH* Path = &Connection->Paths[0];
+    const QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    QuicTraceEvent(
+        ConnOutFlowStatsV2,
+        "[conn][%p] OUT: BytesSent=%llu InFlight=%u CWnd=%u ConnFC=%llu ISB=%llu PostedBytes=%llu SRtt=%llu 1Way=%llu",
+        Connection,
+        Connection->Stats.Send.TotalBytes,
+        Bbr->BytesInFlight,
+        Bbr->CongestionWindow,
+        Connection->Send.PeerMaxData - Connection->Send.OrderedStreamBytesSent,
+        Connection->SendBuffer.IdealBytes,
+        Connection->SendBuffer.PostedBytes,
+        Path->GotFirstRttSample ? Path->SmoothedRtt : 0,
+        Path->OneWayDelay);
+}
+
+//
+// Returns TRUE if we became unblocked.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+Bbr3CongestionControlUpdateBlockedState(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN PreviousCanSendState
+    )
+{
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    QuicConnLogOutFlowStats(Connection);
+
+    if (PreviousCanSendState != Bbr3CongestionControlCanSend(Cc)) {
+        if (PreviousCanSendState) {
+            QuicConnAddOutFlowBlockedReason(
+                Connection, QUIC_FLOW_BLOCKED_CONGESTION_CONTROL);
+        } else {
+            QuicConnRemoveOutFlowBlockedReason(
+                Connection, QUIC_FLOW_BLOCKED_CONGESTION_CONTROL);
+            Connection->Send.LastFlushTime = CxPlatTimeUs64(); // Reset last flush time
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+Bbr3CongestionControlGetBytesInFlightMax(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Bbr3.BytesInFlightMax;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint8_t
+Bbr3CongestionControlGetExemptions(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Bbr3.Exemptions;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlSetExemption(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint8_t NumPackets
+    )
+{
+    Cc->Bbr3.Exemptions = NumPackets;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlOnDataSent(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t NumRetransmittableBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    BOOLEAN PreviousCanSendState = Bbr3CongestionControlCanSend(Cc);
+
+    if (!Bbr->BytesInFlight && Bbr3CongestionControlIsAppLimited(Cc)) {
+        Bbr->ExitingQuiescence = TRUE;
+    }
+
+    Bbr->BytesInFlight += NumRetransmittableBytes;
+    if (Bbr->BytesInFlightMax < Bbr->BytesInFlight) {
+        Bbr->BytesInFlightMax = Bbr->BytesInFlight;
+        QuicSendBufferConnectionAdjust(QuicCongestionControlGetConnection(Cc));
+    }
+
+    if (Bbr->Exemptions > 0) {
+        --Bbr->Exemptions;
+    }
+
+    Bbr3CongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+Bbr3CongestionControlOnDataInvalidated(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t NumRetransmittableBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    BOOLEAN PreviousCanSendState = Bbr3CongestionControlCanSend(Cc);
+
+    CXPLAT_DBG_ASSERT(Bbr->BytesInFlight >= NumRetransmittableBytes);
+    Bbr->BytesInFlight -= NumRetransmittableBytes;
+
+    return Bbr3CongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+//
+// Computes the delivery rate of every packet in the ACK the same way bbr.c
+// does, feeds the max bandwidth filter and returns the largest sample.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint64_t
+Bbr3CongestionControlSampleBandwidth(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ACK_EVENT* AckEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+    uint64_t MaxDeliveryRate = 0;
+
+    if (Bbr->AppLimited && Bbr->AppLimitedExitTarget < AckEvent->LargestAck) {
+        Bbr->AppLimited = FALSE;
+    }
+
+    QUIC_SENT_PACKET_METADATA* AckedPacketsIterator = AckEvent->AckedPackets;
+    while (AckedPacketsIterator != NULL) {
+        QUIC_SENT_PACKET_METADATA* AckedPacket = AckedPacketsIterator;
+        AckedPacketsIterator = AckedPacketsIterator->Next;
+
+        if (AckedPacket->PacketLength == 0) {
+            continue;
+        }
+
+        Bbr->PacketsDeliveredInRound++;
+
+        uint64_t SendRate = UINT64_MAX;
+        uint64_t AckRate = UINT64_MAX;
+
+        if (AckedPacket->Flags.HasLastAckedPacketInfo) {
+            CXPLAT_DBG_ASSERT(AckedPacket->TotalBytesSent >= AckedPacket->LastAckedPacketInfo.TotalBytesSent);
+            CXPLAT_DBG_ASSERT(CxPlatTimeAtOrBefore64(AckedPacket->LastAckedPacketInfo.SentTime, AckedPacket->SentTime));
+
+            uint64_t AckElapsed = 0;
+            uint64_t SendElapsed = CxPlatTimeDiff64(AckedPacket->LastAckedPacketInfo.SentTime, AckedPacket->SentTime);
+
+            if (SendElapsed) {
+                SendRate = (kBbr3MicroSecsInSec * BW_UNIT *
+                    (AckedPacket->TotalBytesSent - AckedPacket->LastAckedPacketInfo.TotalBytesSent) /
+                    SendElapsed);
+            }
+
+            if (!CxPlatTimeAtOrBefore64(AckEvent->AdjustedAckTime, AckedPacket->LastAckedPacketInfo.AdjustedAckTime)) {
+                AckElapsed = CxPlatTimeDiff64(AckedPacket->LastAckedPacketInfo.AdjustedAckTime, AckEvent->AdjustedAckTime);
+            } else {
+                AckElapsed = CxPlatTimeDiff64(AckedPacket->LastAckedPacketInfo.AckTime, AckEvent->TimeNow);
+            }
+
+            CXPLAT_DBG_ASSERT(AckEvent->NumTotalAckedRetransmittableBytes >= AckedPacket->LastAckedPacketInfo.TotalBytesAcked);
+            if (AckElapsed) {
+                AckRate = (kBbr3MicroSecsInSec * BW_UNIT *
+                           (AckEvent->NumTotalAckedRetransmittableBytes - AckedPacket->LastAckedPacketInfo.TotalBytesAcked) /
+                           AckElapsed);
+            }
+        } else if (!CxPlatTimeAtOrBefore64(AckEvent->TimeNow, AckedPacket->SentTime)) {
+            SendRate = (kBbr3MicroSecsInSec * BW_UNIT *
+                        AckEvent->NumTotalAckedRetransmittableBytes /
+                        CxPlatTimeDiff64(AckedPacket->SentTime, AckEvent->TimeNow));
+        }
+
+        if (SendRate == UINT64_MAX && AckRate == UINT64_MAX) {
+            continue;
+        }
+
+        uint64_t DeliveryRate = CXPLAT_MIN(SendRate, AckRate);
+
+        if (DeliveryRate >= Bbr3CongestionControlGetMaxBandwidth(Cc) ||
+            !AckedPacket->Flags.IsAppLimited) {
+            if (Bbr->MaxBwFilter[1] < DeliveryRate) {
+                Bbr->MaxBwFilter[1] = DeliveryRate;
+            }
+        }
+
+        if (MaxDeliveryRate < DeliveryRate) {
+            MaxDeliveryRate = DeliveryRate;
+        }
+    }
+
+    if (Bbr->BwLatest < MaxDeliveryRate) {
+        Bbr->BwLatest = MaxDeliveryRate;
+    }
+
+    return MaxDeliveryRate;
+}
+
+//
+// Starts a new PROBE_BW cycle for the max bandwidth filter, which keeps the
+// max of the current and the previous cycle.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlAdvanceMaxBwFilter(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    if (Bbr->MaxBwFilter[1] == 0) {
+        return; // No samples in the current cycle yet; keep the old ones.
+    }
+    Bbr->MaxBwFilter[0] = Bbr->MaxBwFilter[1];
+    Bbr->MaxBwFilter[1] = 0;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlResetLowerBounds(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    Cc->Bbr3.BwLo = UINT64_MAX;
+    Cc->Bbr3.InflightLo = UINT32_MAX;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlResetCongestionSignals(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    Bbr->LossInRound = FALSE;
+    Bbr->EcnInRound = FALSE;
+    Bbr->BytesLostInRound = 0;
+    Bbr->PacketsLostInRound = 0;
+    Bbr->PacketsDeliveredInRound = 0;
+    Bbr->CePacketsInRound = 0;
+    Bbr->BwLatest = 0;
+    Bbr->InflightLatest = 0;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+Bbr3CongestionControlGetCeRatio(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    if (Bbr->PacketsDeliveredInRound == 0) {
+        return Bbr->CePacketsInRound ? GAIN_UNIT : 0;
+    }
+    uint64_t Ratio = (uint64_t)Bbr->CePacketsInRound * GAIN_UNIT / Bbr->PacketsDeliveredInRound;
+    return (uint32_t)CXPLAT_MIN(Ratio, GAIN_UNIT);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+Bbr3CongestionControlIsLossTooHigh(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t Inflight
+    )
+{
+    return
+        (uint64_t)Cc->Bbr3.BytesLostInRound * 100 >
+        (uint64_t)kBbr3LossThreshPercent * Inflight;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlPickProbeWait(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    uint32_t RandomValue = 0;
+    CxPlatRandom(sizeof(uint32_t), &RandomValue);
+
+    //
+    // Randomize both the round based and the wall clock based wait so that
+    // flows sharing a bottleneck don't probe in lock step.
+    //
+    Bbr->RoundsSinceProbe = RandomValue & 1;
+    Bbr->ProbeWaitUs = kBbr3ProbeWaitBaseUs + (RandomValue >> 1) % kBbr3ProbeWaitRandUs;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlStartProbeBwDown(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    Bbr3CongestionControlResetCongestionSignals(Cc);
+    Bbr3CongestionControlAdvanceMaxBwFilter(Cc);
+    Bbr3CongestionControlPickProbeWait(Cc);
+
+    Bbr->BbrState = BBR3_STATE_PROBE_BW_DOWN;
+    Bbr->PacingGain = kBbr3ProbeDownPacingGain;
+    Bbr->CwndGain = kBbr3CwndGain;
+    Bbr->ProbeUpCount = UINT32_MAX;
+    Bbr->ProbeUpAcked = 0;
+    Bbr->CycleStart = TimeNow;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlStartProbeBwCruise(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    Cc->Bbr3.BbrState = BBR3_STATE_PROBE_BW_CRUISE;
+    Cc->Bbr3.PacingGain = GAIN_UNIT;
+    Cc->Bbr3.CwndGain = kBbr3CwndGain;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlStartProbeBwRefill(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    Bbr3CongestionControlResetLowerBounds(Cc);
+    Bbr->BbrState = BBR3_STATE_PROBE_BW_REFILL;
+    Bbr->PacingGain = GAIN_UNIT;
+    Bbr->CwndGain = kBbr3CwndGain;
+    Bbr->ProbeUpRounds = 0;
+    Bbr->ProbeUpCount = UINT32_MAX;
+    Bbr->ProbeUpAcked = 0;
+    Bbr->BwProbeSamples = TRUE;
+    Bbr->RefillRound = Bbr->RoundTripCounter;
+}
+
+//
+// Each round of PROBE_BW_UP doubles the growth of InflightHi, starting at one
+// datagram per round.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlRaiseInflightHiSlope(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    uint32_t GrowthThisRound = 1u << CXPLAT_MIN(Bbr->ProbeUpRounds, 30);
+    Bbr->ProbeUpRounds = CXPLAT_MIN(Bbr->ProbeUpRounds + 1, 30);
+    Bbr->ProbeUpCount = CXPLAT_MAX(Bbr->CongestionWindow / GrowthThisRound, 1);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlStartProbeBwUp(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    Bbr->BbrState = BBR3_STATE_PROBE_BW_UP;
+    Bbr->PacingGain = kBbr3ProbeUpPacingGain;
+    Bbr->CwndGain = kBbr3ProbeUpCwndGain;
+    Bbr->CycleStart = TimeNow;
+    Bbr3CongestionControlRaiseInflightHiSlope(Cc);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlTransitToStartup(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    Cc->Bbr3.BbrState = BBR3_STATE_STARTUP;
+    Cc->Bbr3.PacingGain = kBbr3StartupPacingGain;
+    Cc->Bbr3.CwndGain = kBbr3StartupCwndGain;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlTransitToDrain(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    Cc->Bbr3.BbrState = BBR3_STATE_DRAIN;
+    Cc->Bbr3.PacingGain = kBbr3DrainPacingGain;
+    Cc->Bbr3.CwndGain = kBbr3StartupCwndGain;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlTransitToProbeRtt(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t LargestSentPacketNumber
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    Bbr->BbrState = BBR3_STATE_PROBE_RTT;
+    Bbr->PacingGain = GAIN_UNIT;
+    Bbr->CwndGain = kBbr3ProbeRttCwndGain;
+    Bbr->ProbeRttEndTimeValid = FALSE;
+    Bbr->ProbeRttRoundValid = FALSE;
+
+    Bbr->AppLimited = TRUE;
+    Bbr->AppLimitedExitTarget = LargestSentPacketNumber;
+}
+
+//
+// Reacts to inflight having been too high while probing: remember it in
+// InflightHi and stop probing.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlHandleInflightTooHigh(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t Inflight,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    Bbr->BwProbeSamples = FALSE;
+
+    if (!Bbr->AppLimited) {
+        uint32_t Target = Bbr3CongestionControlGetTargetCwnd(Cc, GAIN_UNIT);
+        Bbr->InflightHi = CXPLAT_MAX(
+            Inflight,
+            (uint32_t)((uint64_t)Target * kBbr3Beta / GAIN_UNIT));
+    }
+
+    if (Bbr->BbrState == BBR3_STATE_PROBE_BW_UP) {
+        Bbr3CongestionControlStartProbeBwDown(Cc, TimeNow);
+    }
+}
+
+//
+// Pulls BwLo / InflightLo down after a round with loss or CE marks.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlAdaptLowerBounds(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    if (Bbr3CongestionControlIsProbingBw(Cc)) {
+        return;
+    }
+
+    if (Bbr->BwLo == UINT64_MAX) {
+        Bbr->BwLo = Bbr3CongestionControlGetMaxBandwidth(Cc);
+    }
+    if (Bbr->InflightLo == UINT32_MAX) {
+        Bbr->InflightLo = Bbr->CongestionWindow;
+    }
+
+    uint32_t EcnInflightLo = UINT32_MAX;
+    if (Bbr->EcnInRound && Bbr->EcnAlpha) {
+        uint64_t Reduction = (uint64_t)Bbr->EcnAlpha * kBbr3EcnFactor / GAIN_UNIT;
+        EcnInflightLo = (uint32_t)((uint64_t)Bbr->InflightLo * (GAIN_UNIT - Reduction) / GAIN_UNIT);
+    }
+
+    if (Bbr->LossInRound) {
+        Bbr->BwLo = CXPLAT_MAX(Bbr->BwLatest, Bbr->BwLo * kBbr3Beta / GAIN_UNIT);
+        Bbr->InflightLo = CXPLAT_MAX(
+            Bbr->InflightLatest,
+            (uint32_t)((uint64_t)Bbr->InflightLo * kBbr3Beta / GAIN_UNIT));
+    }
+
+    Bbr->InflightLo = CXPLAT_MAX(
+        CXPLAT_MIN(Bbr->InflightLo, EcnInflightLo),
+        Bbr3CongestionControlGetMinCongestionWindow(Cc));
+}
+
+//
+// Called on the first ACK of every round trip to act on the congestion signals
+// of the round that just ended, then reset them.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlOnRoundEnd(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    uint32_t CeRatio = Bbr3CongestionControlGetCeRatio(Cc);
+    if (Bbr->EcnEligible) {
+        Bbr->EcnAlpha =
+            Bbr->EcnAlpha - (Bbr->EcnAlpha >> kBbr3EcnAlphaGainShift) +
+            (CeRatio >> kBbr3EcnAlphaGainShift);
+    }
+
+    if (Bbr->BbrState == BBR3_STATE_STARTUP) {
+        //
+        // Leave STARTUP on persistent heavy loss or CE marking, remembering
+        // the inflight that caused it as the upper bound.
+        //
+        if (Bbr->LossInRound &&
+            Bbr->PacketsLostInRound >= kBbr3StartupFullLossCount &&
+            Bbr3CongestionControlIsLossTooHigh(Cc, Bbr->InflightLatest + Bbr->BytesLostInRound)) {
+            Bbr->FullBwReached = TRUE;
+            Bbr->InflightHi = CXPLAT_MAX(
+                Bbr3CongestionControlGetTargetCwnd(Cc, GAIN_UNIT), Bbr->InflightLatest);
+        }
+
+        if (Bbr->EcnInRound && CeRatio > kBbr3EcnThresh) {
+            if (++Bbr->StartupEcnRounds >= kBbr3StartupEcnRounds) {
+                Bbr->FullBwReached = TRUE;
+            }
+        } else {
+            Bbr->StartupEcnRounds = 0;
+        }
+
+    } else if (
+        Bbr->BbrState == BBR3_STATE_PROBE_BW_UP &&
+        Bbr->BwProbeSamples &&
+        Bbr->EcnInRound && CeRatio > kBbr3EcnThresh) {
+        Bbr3CongestionControlHandleInflightTooHigh(Cc, Bbr->InflightLatest, TimeNow);
+    }
+
+    if (Bbr->LossInRound || Bbr->EcnInRound) {
+        Bbr3CongestionControlAdaptLowerBounds(Cc);
+    }
+
+    if (Bbr->BbrState == BBR3_STATE_PROBE_BW_DOWN ||
+        Bbr->BbrState == BBR3_STATE_PROBE_BW_CRUISE) {
+        Bbr->RoundsSinceProbe++;
+    }
+
+    Bbr3CongestionControlResetCongestionSignals(Cc);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+Bbr3CongestionControlCheckTimeToProbeBw(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+
+    uint32_t RenoRounds = CXPLAT_MIN(
+        Bbr3CongestionControlGetTargetCwnd(Cc, GAIN_UNIT) / DatagramPayloadLength,
+        kBbr3ProbeBwMaxRounds);
+
+    if (CxPlatTimeDiff64(Bbr->CycleStart, TimeNow) >= Bbr->ProbeWaitUs ||
+        Bbr->RoundsSinceProbe >= RenoRounds) {
+        Bbr3CongestionControlStartProbeBwRefill(Cc);
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlProbeInflightHiUpward(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t AckedBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    if (Bbr->InflightHi == UINT32_MAX || Bbr->CongestionWindow < Bbr->InflightHi) {
+        return; // Not limited by InflightHi, so no need to raise it.
+    }
+
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+
+    Bbr->ProbeUpAcked += AckedBytes;
+    if (Bbr->ProbeUpAcked >= Bbr->ProbeUpCount) {
+        uint32_t Delta = Bbr->ProbeUpAcked / Bbr->ProbeUpCount;
+        Bbr->ProbeUpAcked -= Delta * Bbr->ProbeUpCount;
+        uint64_t InflightHi = (uint64_t)Bbr->InflightHi + (uint64_t)Delta * DatagramPayloadLength;
+        Bbr->InflightHi = (uint32_t)CXPLAT_MIN(InflightHi, UINT32_MAX - 1);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlUpdateProbeBwCyclePhase(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ACK_EVENT* AckEvent,
+    _In_ uint32_t PrevInflightBytes,
+    _In_ BOOLEAN NewRoundTrip
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    if (!Bbr->FullBwReached || !Bbr3CongestionControlIsProbeBw(Cc)) {
+        return;
+    }
+
+    //
+    // Without a loss or ECN reaction, inflight that was delivered fine is
+    // evidence that InflightHi may be raised.
+    //
+    if (!Bbr3CongestionControlIsLossTooHigh(Cc, PrevInflightBytes)) {
+        if (Bbr->InflightHi != UINT32_MAX && PrevInflightBytes > Bbr->InflightHi) {
+            Bbr->InflightHi = PrevInflightBytes;
+        }
+        if (Bbr->BbrState == BBR3_STATE_PROBE_BW_UP) {
+            Bbr3CongestionControlProbeInflightHiUpward(Cc, AckEvent->NumRetransmittableBytes);
+        }
+    }
+
+    switch (Bbr->BbrState) {
+    case BBR3_STATE_PROBE_BW_DOWN:
+        if (Bbr3CongestionControlCheckTimeToProbeBw(Cc, AckEvent->TimeNow)) {
+            break;
+        }
+        if (Bbr->BytesInFlight <= Bbr3CongestionControlGetInflightWithHeadroom(Cc) &&
+            Bbr->BytesInFlight <= Bbr3CongestionControlGetTargetCwnd(Cc, GAIN_UNIT)) {
+            Bbr3CongestionControlStartProbeBwCruise(Cc);
+        }
+        break;
+
+    case BBR3_STATE_PROBE_BW_CRUISE:
+        Bbr3CongestionControlCheckTimeToProbeBw(Cc, AckEvent->TimeNow);
+        break;
+
+    case BBR3_STATE_PROBE_BW_REFILL:
+        //
+        // Spend one round at the estimated bandwidth to refill the pipe so
+        // that the UP phase measures the bottleneck and not our own backlog.
+        //
+        if (NewRoundTrip && Bbr->RoundTripCounter > Bbr->RefillRound) {
+            Bbr3CongestionControlStartProbeBwUp(Cc, AckEvent->TimeNow);
+        }
+        break;
+
+    case BBR3_STATE_PROBE_BW_UP:
+        if (NewRoundTrip) {
+            Bbr3CongestionControlRaiseInflightHiSlope(Cc);
+        }
+        if (Bbr->MinRttTimestampValid &&
+            CxPlatTimeDiff64(Bbr->CycleStart, AckEvent->TimeNow) > Bbr->MinRtt &&
+            PrevInflightBytes >= Bbr3CongestionControlGetTargetCwnd(Cc, kBbr3ProbeUpPacingGain)) {
+            Bbr3CongestionControlStartProbeBwDown(Cc, AckEvent->TimeNow);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlHandleAckInProbeRtt(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN NewRoundTrip,
+    _In_ uint64_t LargestSentPacketNumber,
+    _In_ uint64_t AckTime
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    Bbr->AppLimited = TRUE;
+    Bbr->AppLimitedExitTarget = LargestSentPacketNumber;
+
+    if (!Bbr->ProbeRttEndTimeValid &&
+        Bbr->BytesInFlight <= Bbr3CongestionControlGetProbeRttCwnd(Cc)) {
+
+        Bbr->ProbeRttEndTime = AckTime + kBbr3ProbeRttTimeInUs;
+        Bbr->ProbeRttEndTimeValid = TRUE;
+        Bbr->ProbeRttRoundValid = FALSE;
+        return;
+    }
+
+    if (Bbr->ProbeRttEndTimeValid) {
+
+        if (!Bbr->ProbeRttRoundValid && NewRoundTrip) {
+            Bbr->ProbeRttRoundValid = TRUE;
+            Bbr->ProbeRttRound = Bbr->RoundTripCounter;
+        }
+
+        if (Bbr->ProbeRttRoundValid && CxPlatTimeAtOrBefore64(Bbr->ProbeRttEndTime, AckTime)) {
+            Bbr->ProbeRttMinTimestamp = AckTime;
+            Bbr->ProbeRttMinTimestampValid = TRUE;
+            Bbr3CongestionControlResetLowerBounds(Cc);
+
+            if (Bbr->FullBwReached) {
+                Bbr3CongestionControlStartProbeBwDown(Cc, AckTime);
+                Bbr3CongestionControlStartProbeBwCruise(Cc);
+            } else {
+                Bbr3CongestionControlTransitToStartup(Cc);
+            }
+        }
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlUpdateRecoveryWindow(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t BytesAcked
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    CXPLAT_DBG_ASSERT(Bbr->RecoveryState != BBR3_RECOVERY_STATE_NOT_RECOVERY);
+
+    if (Bbr->RecoveryState == BBR3_RECOVERY_STATE_GROWTH) {
+        Bbr->RecoveryWindow += BytesAcked;
+    }
+
+    uint32_t RecoveryWindow = CXPLAT_MAX(
+        Bbr->RecoveryWindow, Bbr->BytesInFlight + BytesAcked);
+
+    Bbr->RecoveryWindow = CXPLAT_MAX(RecoveryWindow, Bbr3CongestionControlGetMinCongestionWindow(Cc));
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlUpdateAckAggregation(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ACK_EVENT* AckEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    if (!Bbr->AckAggregationStartTimeValid) {
+        Bbr->AckAggregationStartTime = AckEvent->TimeNow;
+        Bbr->AckAggregationStartTimeValid = TRUE;
+        return;
+    }
+
+    uint64_t ExpectedAckBytes = Bbr3CongestionControlGetMaxBandwidth(Cc) *
+                                CxPlatTimeDiff64(Bbr->AckAggregationStartTime, AckEvent->TimeNow) /
+                                kBbr3MicroSecsInSec /
+                                BW_UNIT;
+
+    if (Bbr->AggregatedAckBytes <= ExpectedAckBytes) {
+        Bbr->AggregatedAckBytes = AckEvent->NumRetransmittableBytes;
+        Bbr->AckAggregationStartTime = AckEvent->TimeNow;
+        return;
+    }
+
+    Bbr->AggregatedAckBytes += AckEvent->NumRetransmittableBytes;
+
+    QuicSlidingWindowExtremumUpdateMax(&Bbr->MaxAckHeightFilter,
+        Bbr->AggregatedAckBytes - ExpectedAckBytes, Bbr->RoundTripCounter);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlSetSendQuantum(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    uint64_t PacingRate = Bbr3CongestionControlGetBandwidth(Cc) * Bbr->PacingGain / GAIN_UNIT;
+
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+
+    if (PacingRate < kBbr3LowPacingRateThresholdBytesPerSecond * BW_UNIT) {
+        Bbr->SendQuantum = (uint64_t)DatagramPayloadLength;
+    } else if (PacingRate < kBbr3HighPacingRateThresholdBytesPerSecond * BW_UNIT) {
+        Bbr->SendQuantum = (uint64_t)DatagramPayloadLength * 2;
+    } else {
+        Bbr->SendQuantum = CXPLAT_MIN(PacingRate * kBbr3MilliSecsInSec / BW_UNIT, 64 * 1024 /* 64k */);
+    }
+}
+
+//
+// Caps the congestion window by InflightHi (or InflightHi less headroom while
+// cruising or in PROBE_RTT) and InflightLo.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlBoundCwndForModel(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    uint32_t Cap = UINT32_MAX;
+    if (Bbr->BbrState == BBR3_STATE_PROBE_BW_CRUISE ||
+        Bbr->BbrState == BBR3_STATE_PROBE_RTT) {
+        Cap = Bbr3CongestionControlGetInflightWithHeadroom(Cc);
+    } else if (Bbr3CongestionControlIsProbeBw(Cc)) {
+        Cap = Bbr->InflightHi;
+    }
+
+    Cap = CXPLAT_MIN(Cap, Bbr->InflightLo);
+    Cap = CXPLAT_MAX(Cap, Bbr3CongestionControlGetMinCongestionWindow(Cc));
+
+    Bbr->CongestionWindow = CXPLAT_MIN(Bbr->CongestionWindow, Cap);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlUpdateCongestionWindow(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TotalBytesAcked,
+    _In_ uint64_t AckedBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    if (Bbr->BbrState == BBR3_STATE_PROBE_RTT) {
+        return;
+    }
+
+    Bbr3CongestionControlSetSendQuantum(Cc);
+
+    uint64_t TargetCwnd = Bbr3CongestionControlGetTargetCwnd(Cc, Bbr->CwndGain);
+    if (Bbr->FullBwReached) {
+        QUIC_SLIDING_WINDOW_EXTREMUM_ENTRY Entry = (QUIC_SLIDING_WINDOW_EXTREMUM_ENTRY) { .Value = 0, .Time = 0 };
+        QUIC_STATUS Status = QuicSlidingWindowExtremumGet(&Bbr->MaxAckHeightFilter, &Entry);
+        if (QUIC_SUCCEEDED(Status)) {
+            TargetCwnd += Entry.Value;
+        }
+    }
+
+    uint64_t CongestionWindow = Bbr->CongestionWindow;
+
+    if (Bbr->FullBwReached) {
+        CongestionWindow = CXPLAT_MIN(TargetCwnd, CongestionWindow + AckedBytes);
+    } else if (CongestionWindow < TargetCwnd || TotalBytesAcked < Bbr->InitialCongestionWindow) {
+        CongestionWindow += AckedBytes;
+    }
+
+    Bbr->CongestionWindow = (uint32_t)CXPLAT_MIN(
+        CXPLAT_MAX(CongestionWindow, Bbr3CongestionControlGetMinCongestionWindow(Cc)),
+        UINT32_MAX);
+
+    Bbr3CongestionControlBoundCwndForModel(Cc);
+
+    QuicConnLogBbr3(QuicCongestionControlGetConnection(Cc));
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+Bbr3CongestionControlGetSendAllowance(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeSinceLastSend, // microsec
+    _In_ BOOLEAN TimeSinceLastSendValid
+    )
+{
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    uint32_t CongestionWindow = Bbr3CongestionControlGetCongestionWindow(Cc);
+
+    uint32_t SendAllowance = 0;
+
+    if (Bbr->BytesInFlight >= CongestionWindow) {
+        //
+        // We are CC blocked, so we can't send anything.
+        //
+        SendAllowance = 0;
+
+    } else if (
+        !TimeSinceLastSendValid ||
+        !Connection->Settings.PacingEnabled ||
+        !Bbr->MinRttTimestampValid ||
+        Bbr->MinRtt < QUIC_SEND_PACING_INTERVAL) {
+        //
+        // We're not in the necessary state to pace.
+        //
+        SendAllowance = CongestionWindow - Bbr->BytesInFlight;
+
+    } else {
+        //
+        // We are pacing, so send the pacing rate (bandwidth * gain, less a
+        // small margin) times the time since the last send.
+        //
+        uint64_t PacingRate =
+            Bbr3CongestionControlGetBandwidth(Cc) * Bbr->PacingGain / GAIN_UNIT *
+            (100 - kBbr3PacingMarginPercent) / 100;
+
+        if (Bbr->BbrState == BBR3_STATE_STARTUP) {
+            SendAllowance = (uint32_t)CXPLAT_MAX(
+                PacingRate * TimeSinceLastSend / kBbr3MicroSecsInSec / BW_UNIT,
+                (uint64_t)CongestionWindow * Bbr->PacingGain / GAIN_UNIT - Bbr->BytesInFlight);
+        } else {
+            SendAllowance = (uint32_t)CXPLAT_MIN(
+                PacingRate * TimeSinceLastSend / kBbr3MicroSecsInSec / BW_UNIT,
+                UINT32_MAX);
+        }
+
+        if (SendAllowance > CongestionWindow - Bbr->BytesInFlight) {
+            SendAllowance = CongestionWindow - Bbr->BytesInFlight;
+        }
+
+        if (SendAllowance > (CongestionWindow >> 2)) {
+            SendAllowance = CongestionWindow >> 2; // Don't send more than a quarter of the current window.
+        }
+    }
+    return SendAllowance;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+Bbr3CongestionControlOnDataAcknowledged(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ACK_EVENT* AckEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    BOOLEAN PreviousCanSendState = Bbr3CongestionControlCanSend(Cc);
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    if (AckEvent->IsImplicit) {
+        Bbr3CongestionControlUpdateCongestionWindow(
+            Cc, AckEvent->NumTotalAckedRetransmittableBytes, AckEvent->NumRetransmittableBytes);
+
+        if (Connection->Settings.NetStatsEventEnabled) {
+            Bbr3CongestionControlIndicateConnectionEvent(Connection, Cc);
+        }
+        return Bbr3CongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+    }
+
+    uint32_t PrevInflightBytes = Bbr->BytesInFlight;
+
+    CXPLAT_DBG_ASSERT(Bbr->BytesInFlight >= AckEvent->NumRetransmittableBytes);
+    Bbr->BytesInFlight -= AckEvent->NumRetransmittableBytes;
+    Bbr->LastAckTime = AckEvent->TimeNow;
+
+    if (AckEvent->MinRttValid) {
+        Bbr->ProbeRttExpired = Bbr->ProbeRttMinTimestampValid ?
+            CxPlatTimeAtOrBefore64(Bbr->ProbeRttMinTimestamp + kBbr3ProbeRttIntervalUs, AckEvent->TimeNow) :
+            FALSE;
+        if (!Bbr->ProbeRttMinTimestampValid ||
+            Bbr->ProbeRttExpired ||
+            Bbr->ProbeRttMinRtt > AckEvent->MinRtt) {
+            Bbr->ProbeRttMinRtt = AckEvent->MinRtt;
+            Bbr->ProbeRttMinTimestamp = AckEvent->TimeNow;
+            Bbr->ProbeRttMinTimestampValid = TRUE;
+        }
+
+        BOOLEAN MinRttExpired = Bbr->MinRttTimestampValid ?
+            CxPlatTimeAtOrBefore64(Bbr->MinRttTimestamp + kBbr3MinRttExpirationInMicroSecs, AckEvent->TimeNow) :
+            TRUE;
+        if (MinRttExpired || Bbr->MinRtt > Bbr->ProbeRttMinRtt) {
+            Bbr->MinRtt = Bbr->ProbeRttMinRtt;
+            Bbr->MinRttTimestamp = Bbr->ProbeRttMinTimestamp;
+            Bbr->MinRttTimestampValid = TRUE;
+        }
+    }
+
+    BOOLEAN NewRoundTrip = FALSE;
+    if (!Bbr->EndOfRoundTripValid || Bbr->EndOfRoundTrip < AckEvent->LargestAck) {
+        if (Bbr->EndOfRoundTripValid) {
+            Bbr3CongestionControlOnRoundEnd(Cc, AckEvent->TimeNow);
+        }
+        Bbr->RoundTripCounter++;
+        Bbr->EndOfRoundTripValid = TRUE;
+        Bbr->EndOfRoundTrip = AckEvent->LargestSentPacketNumber;
+        NewRoundTrip = TRUE;
+    }
+
+    BOOLEAN LastAckedPacketAppLimited =
+        AckEvent->AckedPackets == NULL ? FALSE : AckEvent->IsLargestAckedPacketAppLimited;
+
+    Bbr3CongestionControlSampleBandwidth(Cc, AckEvent);
+    Bbr->InflightLatest += AckEvent->NumRetransmittableBytes;
+
+    if (Bbr3CongestionControlInRecovery(Cc)) {
+        CXPLAT_DBG_ASSERT(Bbr->EndOfRecoveryValid);
+        if (NewRoundTrip && Bbr->RecoveryState != BBR3_RECOVERY_STATE_GROWTH) {
+            Bbr->RecoveryState = BBR3_RECOVERY_STATE_GROWTH;
+        }
+        if (!AckEvent->HasLoss && Bbr->EndOfRecovery < AckEvent->LargestAck) {
+            Bbr->RecoveryState = BBR3_RECOVERY_STATE_NOT_RECOVERY;
+            QuicTraceEvent(
+                ConnRecoveryExit,
+                "[conn][%p] Recovery complete",
+                Connection);
+        } else {
+            Bbr3CongestionControlUpdateRecoveryWindow(Cc, AckEvent->NumRetransmittableBytes);
+        }
+    }
+
+    Bbr3CongestionControlUpdateAckAggregation(Cc, AckEvent);
+
+    if (!Bbr->FullBwReached && NewRoundTrip && !LastAckedPacketAppLimited) {
+        uint64_t BandwidthTarget = Bbr->FullBw * kBbr3StartupGrowthTarget / GAIN_UNIT;
+        uint64_t CurrentBandwidth = Bbr3CongestionControlGetMaxBandwidth(Cc);
+
+        if (CurrentBandwidth >= BandwidthTarget) {
+            Bbr->FullBw = CurrentBandwidth;
+            Bbr->FullBwCount = 0;
+        } else if (++Bbr->FullBwCount >= kBbr3StartupFullBwRounds) {
+            Bbr->FullBwReached = TRUE;
+        }
+    }
+
+    if (Bbr->BbrState == BBR3_STATE_STARTUP && Bbr->FullBwReached) {
+        Bbr3CongestionControlTransitToDrain(Cc);
+    }
+
+    if (Bbr->BbrState == BBR3_STATE_DRAIN &&
+        Bbr->BytesInFlight <= Bbr3CongestionControlGetTargetCwnd(Cc, GAIN_UNIT)) {
+        Bbr3CongestionControlStartProbeBwDown(Cc, AckEvent->TimeNow);
+    }
+
+    Bbr3CongestionControlUpdateProbeBwCyclePhase(Cc, AckEvent, PrevInflightBytes, NewRoundTrip);
+
+    if (Bbr->BbrState != BBR3_STATE_PROBE_RTT &&
+        !Bbr->ExitingQuiescence &&
+        Bbr->ProbeRttExpired) {
+        Bbr3CongestionControlTransitToProbeRtt(Cc, AckEvent->LargestSentPacketNumber);
+    }
+
+    Bbr->ExitingQuiescence = FALSE;
+    Bbr->ProbeRttExpired = FALSE;
+
+    if (Bbr->BbrState == BBR3_STATE_PROBE_RTT) {
+        Bbr3CongestionControlHandleAckInProbeRtt(
+            Cc, NewRoundTrip, AckEvent->LargestSentPacketNumber, AckEvent->TimeNow);
+    }
+
+    Bbr3CongestionControlUpdateCongestionWindow(
+        Cc, AckEvent->NumTotalAckedRetransmittableBytes, AckEvent->NumRetransmittableBytes);
+
+    if (Connection->Settings.NetStatsEventEnabled) {
+        Bbr3CongestionControlIndicateConnectionEvent(Connection, Cc);
+    }
+
+    return Bbr3CongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlOnDataLost(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_LOSS_EVENT* LossEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+
+    QuicTraceEvent(
+        ConnCongestionV2,
+        "[conn][%p] Congestion event: IsEcn=%hu",
+        Connection,
+        FALSE);
+    Connection->Stats.Send.CongestionCount++;
+
+    BOOLEAN PreviousCanSendState = Bbr3CongestionControlCanSend(Cc);
+
+    CXPLAT_DBG_ASSERT(LossEvent->NumRetransmittableBytes > 0);
+
+    uint32_t PrevInflightBytes = Bbr->BytesInFlight;
+
+    CXPLAT_DBG_ASSERT(Bbr->BytesInFlight >= LossEvent->NumRetransmittableBytes);
+    Bbr->BytesInFlight -= LossEvent->NumRetransmittableBytes;
+
+    Bbr->LossInRound = TRUE;
+    Bbr->BytesLostInRound += LossEvent->NumRetransmittableBytes;
+    Bbr->PacketsLostInRound +=
+        (LossEvent->NumRetransmittableBytes + DatagramPayloadLength - 1) / DatagramPayloadLength;
+
+    //
+    // Only a bandwidth probe reacts to loss immediately; otherwise loss is
+    // folded into the lower bounds at the end of the round.
+    //
+    if (Bbr->BwProbeSamples &&
+        Bbr3CongestionControlIsLossTooHigh(Cc, PrevInflightBytes)) {
+        Bbr3CongestionControlHandleInflightTooHigh(Cc, PrevInflightBytes, Bbr->LastAckTime);
+    }
+
+    uint32_t RecoveryWindow = Bbr->RecoveryWindow;
+    uint32_t MinCongestionWindow = Bbr3CongestionControlGetMinCongestionWindow(Cc);
+
+    if (!Bbr3CongestionControlInRecovery(Cc)) {
+        Bbr->RecoveryState = BBR3_RECOVERY_STATE_CONSERVATIVE;
+        RecoveryWindow = CXPLAT_MAX(Bbr->BytesInFlight, MinCongestionWindow);
+
+        Bbr->UndoBwLo = Bbr->BwLo;
+        Bbr->UndoInflightHi = Bbr->InflightHi;
+        Bbr->UndoInflightLo = Bbr->InflightLo;
+    }
+
+    Bbr->EndOfRecoveryValid = TRUE;
+    Bbr->EndOfRecovery = LossEvent->LargestSentPacketNumber;
+
+    if (LossEvent->PersistentCongestion) {
+        Bbr->RecoveryWindow = MinCongestionWindow;
+
+        QuicTraceEvent(
+            ConnPersistentCongestion,
+            "[conn][%p] Persistent congestion event",
+            Connection);
+        Connection->Stats.Send.PersistentCongestionCount++;
+    } else {
+        Bbr->RecoveryWindow =
+            RecoveryWindow > LossEvent->NumRetransmittableBytes + MinCongestionWindow
+            ? RecoveryWindow - LossEvent->NumRetransmittableBytes
+            : MinCongestionWindow;
+    }
+
+    Bbr3CongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+    QuicConnLogBbr3(Connection);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlOnEcn(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ECN_EVENT* EcnEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    if (!Bbr->EcnInRound) {
+        QuicTraceEvent(
+            ConnCongestionV2,
+            "[conn][%p] Congestion event: IsEcn=%hu",
+            Connection,
+            TRUE);
+        Connection->Stats.Send.EcnCongestionCount++;
+    }
+
+    //
+    // CE marks only shape the model at round granularity (see
+    // Bbr3CongestionControlOnRoundEnd); there is no immediate window cut.
+    //
+    Bbr->EcnEligible = TRUE;
+    Bbr->EcnInRound = TRUE;
+    Bbr->CePacketsInRound += EcnEvent->NewCeCount ? (uint32_t)EcnEvent->NewCeCount : 1;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+Bbr3CongestionControlOnSpuriousCongestionEvent(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    if (!Bbr3CongestionControlInRecovery(Cc)) {
+        return FALSE;
+    }
+
+    BOOLEAN PreviousCanSendState = Bbr3CongestionControlCanSend(Cc);
+
+    QuicTraceEvent(
+        ConnSpuriousCongestion,
+        "[conn][%p] Spurious congestion event",
+        QuicCongestionControlGetConnection(Cc));
+
+    Bbr->BwLo = Bbr->UndoBwLo;
+    Bbr->InflightHi = Bbr->UndoInflightHi;
+    Bbr->InflightLo = Bbr->UndoInflightLo;
+    Bbr->RecoveryState = BBR3_RECOVERY_STATE_NOT_RECOVERY;
+    Bbr->LossInRound = FALSE;
+    Bbr->BytesLostInRound = 0;
+    Bbr->PacketsLostInRound = 0;
+
+    return Bbr3CongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlSetAppLimited(
+    _In_ struct QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    uint64_t LargestSentPacketNumber = Connection->LossDetection.LargestSentPacketNumber;
+
+    if (Bbr->BytesInFlight > Bbr3CongestionControlGetCongestionWindow(Cc)) {
+        return;
+    }
+
+    Bbr->AppLimited = TRUE;
+    Bbr->AppLimitedExitTarget = LargestSentPacketNumber;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlReset(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN FullReset
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+
+    Bbr->CongestionWindow = Bbr->InitialCongestionWindowPackets * DatagramPayloadLength;
+    Bbr->InitialCongestionWindow = Bbr->InitialCongestionWindowPackets * DatagramPayloadLength;
+    Bbr->RecoveryWindow = kBbr3DefaultRecoveryCwndInMss * DatagramPayloadLength;
+    Bbr->BytesInFlightMax = Bbr->CongestionWindow / 2;
+
+    if (FullReset) {
+        Bbr->BytesInFlight = 0;
+    }
+    Bbr->Exemptions = 0;
+
+    Bbr->RecoveryState = BBR3_RECOVERY_STATE_NOT_RECOVERY;
+    Bbr3CongestionControlTransitToStartup(Cc);
+    Bbr->RoundTripCounter = 0;
+    Bbr->FullBwReached = FALSE;
+    Bbr->FullBw = 0;
+    Bbr->FullBwCount = 0;
+    Bbr->StartupEcnRounds = 0;
+    Bbr->SendQuantum = 0;
+    Bbr->ExitingQuiescence = FALSE;
+    Bbr->AppLimited = FALSE;
+    Bbr->AppLimitedExitTarget = 0;
+
+    Bbr->MaxBwFilter[0] = 0;
+    Bbr->MaxBwFilter[1] = 0;
+    Bbr->InflightHi = UINT32_MAX;
+    Bbr3CongestionControlResetLowerBounds(Cc);
+    Bbr3CongestionControlResetCongestionSignals(Cc);
+    Bbr->EcnEligible = FALSE;
+    Bbr->EcnAlpha = GAIN_UNIT; // Start conservative until the first CE ratio is known.
+    Bbr->BwProbeSamples = FALSE;
+    Bbr->UndoBwLo = UINT64_MAX;
+    Bbr->UndoInflightHi = UINT32_MAX;
+    Bbr->UndoInflightLo = UINT32_MAX;
+
+    Bbr->CycleStart = 0;
+    Bbr->LastAckTime = 0;
+    Bbr->ProbeWaitUs = kBbr3ProbeWaitBaseUs;
+    Bbr->RoundsSinceProbe = 0;
+    Bbr->ProbeUpRounds = 0;
+    Bbr->ProbeUpCount = UINT32_MAX;
+    Bbr->ProbeUpAcked = 0;
+    Bbr->RefillRound = 0;
+
+    Bbr->AckAggregationStartTimeValid = FALSE;
+    Bbr->AckAggregationStartTime = 0;
+    Bbr->AggregatedAckBytes = 0;
+    QuicSlidingWindowExtremumReset(&Bbr->MaxAckHeightFilter);
+
+    Bbr->EndOfRecoveryValid = FALSE;
+    Bbr->EndOfRecovery = 0;
+
+    Bbr->EndOfRoundTripValid = FALSE;
+    Bbr->EndOfRoundTrip = 0;
+
+    Bbr->ProbeRttRoundValid = FALSE;
+    Bbr->ProbeRttRound = 0;
+    Bbr->ProbeRttEndTimeValid = FALSE;
+    Bbr->ProbeRttEndTime = 0;
+
+    Bbr->MinRttTimestampValid = FALSE;
+    Bbr->MinRtt = UINT64_MAX;
+    Bbr->MinRttTimestamp = 0;
+    Bbr->ProbeRttMinTimestampValid = FALSE;
+    Bbr->ProbeRttExpired = FALSE;
+    Bbr->ProbeRttMinRtt = UINT64_MAX;
+    Bbr->ProbeRttMinTimestamp = 0;
+
+    Bbr3CongestionControlLogOutFlowStatus(Cc);
+    QuicConnLogBbr3(Connection);
+}
+
+static const QUIC_CONGESTION_CONTROL QuicCongestionControlBbr3 = {
+    .Name = "BBRv3",
+    .QuicCongestionControlCanSend = Bbr3CongestionControlCanSend,
+    .QuicCongestionControlSetExemption = Bbr3CongestionControlSetExemption,
+    .QuicCongestionControlReset = Bbr3CongestionControlReset,
+    .QuicCongestionControlGetSendAllowance = Bbr3CongestionControlGetSendAllowance,
+    .QuicCongestionControlGetCongestionWindow = Bbr3CongestionControlGetCongestionWindow,
+    .QuicCongestionControlOnDataSent = Bbr3CongestionControlOnDataSent,
+    .QuicCongestionControlOnDataInvalidated = Bbr3CongestionControlOnDataInvalidated,
+    .QuicCongestionControlOnDataAcknowledged = Bbr3CongestionControlOnDataAcknowledged,
+    .QuicCongestionControlOnDataLost = Bbr3CongestionControlOnDataLost,
+    .QuicCongestionControlOnEcn = Bbr3CongestionControlOnEcn,
+    .QuicCongestionControlOnSpuriousCongestionEvent = Bbr3CongestionControlOnSpuriousCongestionEvent,
+    .QuicCongestionControlLogOutFlowStatus = Bbr3CongestionControlLogOutFlowStatus,
+    .QuicCongestionControlGetExemptions = Bbr3CongestionControlGetExemptions,
+    .QuicCongestionControlGetBytesInFlightMax = Bbr3CongestionControlGetBytesInFlightMax,
+    .QuicCongestionControlIsAppLimited = Bbr3CongestionControlIsAppLimited,
+    .QuicCongestionControlSetAppLimited = Bbr3CongestionControlSetAppLimited,
+    .QuicCongestionControlGetNetworkStatistics = Bbr3CongestionControlGetNetworkStatistics
+};
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlInitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings
+    )
+{
+    *Cc = QuicCongestionControlBbr3;
+
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr = &Cc->Bbr3;
+
+    Bbr->InitialCongestionWindowPackets = Settings->InitialWindowPackets;
+    Bbr->MaxAckHeightFilter = QuicSlidingWindowExtremumInitialize(
+            kBbr3MaxAckHeightFilterLen, kBbr3DefaultFilterCapacity, Bbr->MaxAckHeightFilterEntries);
+
+    Bbr3CongestionControlReset(Cc, TRUE);
+}
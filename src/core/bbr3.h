@@ -0,0 +1,258 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+#include "sliding_window_extremum.h"
+
+#define kBbr3DefaultFilterCapacity 3
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+typedef struct QUIC_CONGESTION_CONTROL_BBR3 {
+
+    //
+    // Whether the bottleneck bandwidth has been detected (STARTUP is done)
+    //
+    BOOLEAN FullBwReached : 1;
+
+    //
+    // TRUE when exiting quiescence
+    //
+    BOOLEAN ExitingQuiescence : 1;
+
+    //
+    // If TRUE, EndOfRecovery is valid
+    //
+    BOOLEAN EndOfRecoveryValid : 1;
+
+    //
+    // If TRUE, EndOfRoundTrip is valid
+    //
+    BOOLEAN EndOfRoundTripValid : 1;
+
+    //
+    // If TRUE, AckAggregationStartTime is valid
+    //
+    BOOLEAN AckAggregationStartTimeValid : 1;
+
+    //
+    // If TRUE, ProbeRttRound is valid
+    //
+    BOOLEAN ProbeRttRoundValid : 1;
+
+    //
+    // If TRUE, ProbeRttEndTime is valid
+    //
+    BOOLEAN ProbeRttEndTimeValid : 1;
+
+    //
+    // If TRUE, there has been at least one MinRtt sample
+    //
+    BOOLEAN MinRttTimestampValid : 1;
+
+    //
+    // If TRUE, there has been at least one ProbeRttMinRtt sample
+    //
+    BOOLEAN ProbeRttMinTimestampValid : 1;
+
+    //
+    // TRUE if the ProbeRttMinRtt sample expired on the latest ACK
+    //
+    BOOLEAN ProbeRttExpired : 1;
+
+    //
+    // TRUE if bandwidth is limited by the application
+    //
+    BOOLEAN AppLimited : 1;
+
+    //
+    // Congestion signals seen during the current round trip
+    //
+    BOOLEAN LossInRound : 1;
+    BOOLEAN EcnInRound : 1;
+
+    //
+    // TRUE once the peer has reported any CE marks. Until then the ECN alpha
+    // is not maintained.
+    //
+    BOOLEAN EcnEligible : 1;
+
+    //
+    // TRUE while the current bandwidth probe may still tighten InflightHi.
+    // Cleared after the first reaction so a probe only backs off once.
+    //
+    BOOLEAN BwProbeSamples : 1;
+
+    //
+    // The size of the initial congestion window in packets
+    //
+    uint32_t InitialCongestionWindowPackets;
+
+    uint32_t CongestionWindow; // bytes
+
+    uint32_t InitialCongestionWindow; // bytes
+
+    uint32_t RecoveryWindow; // bytes
+
+    //
+    // The number of bytes considered to be still in the network.
+    //
+    uint32_t BytesInFlight;
+    uint32_t BytesInFlightMax;
+
+    //
+    // A count of packets which can be sent ignoring CongestionWindow.
+    //
+    uint8_t Exemptions;
+
+    //
+    // Current state of the BBR3_STATE state machine
+    //
+    uint32_t BbrState;
+
+    //
+    // Current state of recovery
+    //
+    uint32_t RecoveryState;
+
+    //
+    // The dynamic gain factors applied to the BDP and the bandwidth estimate
+    //
+    uint32_t CwndGain;
+    uint32_t PacingGain;
+
+    //
+    // The maximum size of transmission aggregates
+    //
+    uint64_t SendQuantum;
+
+    //
+    // Count of packet-timed round trips
+    //
+    uint64_t RoundTripCounter;
+
+    //
+    // Receiving acknowledgment of a packet after EndOfRoundTrip will
+    // indicate the current round trip is ended
+    //
+    uint64_t EndOfRoundTrip;
+
+    //
+    // Receiving acknowledgment of a packet after EndOfRecovery will cause
+    // BBR to exit the recovery mode
+    //
+    uint64_t EndOfRecovery;
+
+    //
+    // Target packet number to quit the AppLimited state
+    //
+    uint64_t AppLimitedExitTarget;
+
+    //
+    // STARTUP bandwidth plateau detection
+    //
+    uint64_t FullBw;
+    uint8_t FullBwCount;
+
+    //
+    // Consecutive STARTUP rounds with a CE ratio above the threshold
+    //
+    uint8_t StartupEcnRounds;
+
+    //
+    // Upper bound of the model: the max bandwidth over the last two PROBE_BW
+    // cycles, and the volume of inflight data that last caused loss or heavy
+    // ECN marking (UINT32_MAX when unset).
+    //
+    uint64_t MaxBwFilter[2];
+    uint32_t InflightHi;
+
+    //
+    // Short term lower bounds of the model, only pulled down by congestion
+    // during non-probing phases and reset when a new probe starts
+    // (UINT64_MAX / UINT32_MAX when unset).
+    //
+    uint64_t BwLo;
+    uint32_t InflightLo;
+
+    //
+    // The max delivery rate and delivered bytes seen in the current round
+    //
+    uint64_t BwLatest;
+    uint32_t InflightLatest;
+
+    //
+    // Per round loss and ECN accounting
+    //
+    uint32_t BytesLostInRound;
+    uint32_t PacketsLostInRound;
+    uint32_t PacketsDeliveredInRound;
+    uint32_t CePacketsInRound;
+
+    //
+    // EWMA of the per round CE ratio, in GAIN_UNIT
+    //
+    uint32_t EcnAlpha;
+
+    //
+    // Bounds saved when entering recovery, restored on a spurious loss
+    //
+    uint64_t UndoBwLo;
+    uint32_t UndoInflightHi;
+    uint32_t UndoInflightLo;
+
+    //
+    // PROBE_BW cycle bookkeeping
+    //
+    uint64_t CycleStart;
+    uint64_t ProbeWaitUs;
+    uint64_t LastAckTime; // Times phase changes triggered by loss events
+    uint32_t RoundsSinceProbe;
+    uint32_t ProbeUpRounds;
+    uint32_t ProbeUpCount; // bytes acked per MTU of InflightHi growth
+    uint32_t ProbeUpAcked;
+    uint64_t RefillRound;
+
+    //
+    // Ack aggregation estimation
+    //
+    uint64_t AckAggregationStartTime;
+    uint64_t AggregatedAckBytes;
+    QUIC_SLIDING_WINDOW_EXTREMUM MaxAckHeightFilter;
+    QUIC_SLIDING_WINDOW_EXTREMUM_ENTRY MaxAckHeightFilterEntries[kBbr3DefaultFilterCapacity];
+
+    //
+    // PROBE_RTT bookkeeping
+    //
+    uint64_t ProbeRttRound;
+    uint64_t ProbeRttEndTime;
+
+    uint64_t MinRtt; // microseconds
+    uint64_t MinRttTimestamp; // microseconds
+
+    //
+    // The min RTT over the shorter PROBE_RTT interval. Expiry of this sample
+    // is what schedules PROBE_RTT.
+    //
+    uint64_t ProbeRttMinRtt; // microseconds
+    uint64_t ProbeRttMinTimestamp; // microseconds
+
+} QUIC_CONGESTION_CONTROL_BBR3;
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlInitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings
+    );
+
+#if defined(__cplusplus)
+}
+#endif
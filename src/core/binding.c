@@ -844,7 +844,7 @@ QuicBindingProcessStatelessOperation(
         Binding,
         OperationType);
 
-    CXPLAT_SEND_CONFIG SendConfig = { RecvPacket->Route, 0, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0 };
+    CXPLAT_SEND_CONFIG SendConfig = { RecvPacket->Route, 0, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0, 0 };
     CXPLAT_SEND_DATA* SendData = CxPlatSendDataAlloc(Binding->Socket, &SendConfig);
     if (SendData == NULL) {
         QuicTraceEvent(
@@ -1112,7 +1112,8 @@ QuicBindingProcessStatelessOperation(
         RecvPacket->Route,
         SendData,
         SendDatagram->Length,
-        1);
+        1,
+        NULL);
     SendData = NULL;
 
 Exit:
@@ -1255,6 +1256,45 @@ QuicBindingPreprocessPacket(
     return TRUE;
 }
 
+//
+// Lightweight version of QuicBindingPreprocessPacket for a datagram from the
+// same coalesced receive as Leader, a validated short header packet. Succeeds
+// only if the datagram is a short header packet with the same destination CID,
+// in which case it is ready to be delivered along with Leader. Otherwise, the
+// datagram must go through the full QuicBindingPreprocessPacket.
+//
+QUIC_INLINE
+BOOLEAN
+QuicBindingPreprocessTrainPacket(
+    _In_ const QUIC_RX_PACKET* Leader,
+    _Inout_ QUIC_RX_PACKET* Packet
+    )
+{
+    CXPLAT_DBG_ASSERT(Leader->ValidatedHeaderInv && Leader->IsShortHeader);
+
+    if (Packet->BufferLength < MIN_INV_SHORT_HDR_LENGTH + Leader->DestCidLen ||
+        ((const QUIC_HEADER_INVARIANT*)Packet->Buffer)->IsLongHeader ||
+        memcmp(
+            Packet->Buffer + MIN_INV_SHORT_HDR_LENGTH,
+            Leader->DestCid,
+            Leader->DestCidLen) != 0) {
+        return FALSE;
+    }
+
+    CxPlatZeroMemory(   // Zero out everything from PacketNumber forward
+        &Packet->PacketNumber,
+        sizeof(QUIC_RX_PACKET) - offsetof(QUIC_RX_PACKET, PacketNumber));
+    Packet->AvailBuffer = Packet->Buffer;
+    Packet->AvailBufferLength = Packet->BufferLength;
+    Packet->DestCid = Packet->Invariant->SHORT_HDR.DestCid;
+    Packet->DestCidLen = Leader->DestCidLen;
+    Packet->HeaderLength = MIN_INV_SHORT_HDR_LENGTH + Leader->DestCidLen;
+    Packet->IsShortHeader = TRUE;
+    Packet->ValidatedHeaderInv = TRUE;
+
+    return TRUE;
+}
+
 //
 // Returns TRUE if we should respond to the connection attempt with a Retry
 // packet.
@@ -1665,6 +1705,8 @@ QuicBindingReceive(
     uint32_t SubChainBytes = 0;
     uint32_t TotalChainLength = 0;
     uint32_t TotalDatagramBytes = 0;
+    const CXPLAT_ROUTE* TrainRoute = NULL;
+    uint64_t TrainPacketId = 0;
 
     CXPLAT_DBG_ASSERT(Socket == Binding->Socket);
 
@@ -1677,6 +1719,12 @@ QuicBindingReceive(
     // code will check that each packet has a destination CID matching the
     // connection it was delivered to.
     //
+    // Datagrams split from the same coalesced (GRO) receive are adjacent in
+    // the chain and share a route. Such a train almost always carries a
+    // single destination CID, so its packets are added to the current
+    // subchain with minimal per-packet validation, and the whole train is
+    // delivered (one lookup) as a single batch.
+    //
 
     CXPLAT_DBG_ASSERT(DatagramChain->PartitionIndex < MsQuicLib.PartitionCount);
     QUIC_PARTITION* Partition = &MsQuicLib.Partitions[DatagramChain->PartitionIndex];
@@ -1693,9 +1741,25 @@ QuicBindingReceive(
         DatagramChain = Datagram->Next;
         Datagram->Next = NULL;
 
+        if (Datagram->Route != TrainRoute) {
+            //
+            // First datagram of a new train. Reserve packet IDs for the whole
+            // train at once.
+            //
+            uint32_t TrainLength = 1;
+            for (const CXPLAT_RECV_DATA* Next = DatagramChain;
+                 Next != NULL && Next->Route == Datagram->Route;
+                 Next = Next->Next) {
+                TrainLength++;
+            }
+            TrainRoute = Datagram->Route;
+            TrainPacketId =
+                (uint64_t)InterlockedExchangeAdd64(
+                    (int64_t*)&Partition->ReceivePacketId, (int64_t)TrainLength);
+        }
+
         QUIC_RX_PACKET* Packet = (QUIC_RX_PACKET*)Datagram;
-        Packet->PacketId =
-            PartitionShifted | InterlockedIncrement64((int64_t*)&Partition->ReceivePacketId);
+        Packet->PacketId = PartitionShifted | ++TrainPacketId;
         Packet->PacketNumber = 0;
         Packet->SendTimestamp = UINT64_MAX;
         Packet->AvailBuffer = Datagram->Buffer;
@@ -1732,6 +1796,21 @@ QuicBindingReceive(
         }
 #endif
 
+        //
+        // Fast path for the rest of a train whose short header packets are
+        // being collected in the current subchain.
+        //
+        if (SubChain != NULL &&
+            SubChain->Route == Datagram->Route &&
+            ((QUIC_RX_PACKET*)SubChain)->IsShortHeader &&
+            QuicBindingPreprocessTrainPacket((QUIC_RX_PACKET*)SubChain, Packet)) {
+            SubChainLength++;
+            SubChainBytes += Datagram->BufferLength;
+            *SubChainDataTail = Datagram;
+            SubChainDataTail = &Datagram->Next;
+            continue;
+        }
+
         //
         // Perform initial validation.
         //
@@ -1849,7 +1928,8 @@ QuicBindingSend(
     _In_ const CXPLAT_ROUTE* Route,
     _In_ CXPLAT_SEND_DATA* SendData,
     _In_ uint32_t BytesToSend,
-    _In_ uint32_t DatagramsToSend
+    _In_ uint32_t DatagramsToSend,
+    _Inout_opt_ CXPLAT_SEND_BATCH* SendBatch
     )
 {
 #if QUIC_TEST_DATAPATH_HOOKS_ENABLED
@@ -1870,12 +1950,18 @@ QuicBindingSend(
                 "[bind][%p] Test dropped packet",
                 Binding);
             CxPlatSendDataFree(SendData);
+        } else if (SendBatch != NULL) {
+            CxPlatSocketSendBatched(Binding->Socket, &RouteCopy, SendData, SendBatch);
         } else {
             CxPlatSocketSend(Binding->Socket, &RouteCopy, SendData);
         }
     } else {
 #endif
-        CxPlatSocketSend(Binding->Socket, Route, SendData);
+        if (SendBatch != NULL) {
+            CxPlatSocketSendBatched(Binding->Socket, Route, SendData, SendBatch);
+        } else {
+            CxPlatSocketSend(Binding->Socket, Route, SendData);
+        }
 #if QUIC_TEST_DATAPATH_HOOKS_ENABLED
     }
 #endif
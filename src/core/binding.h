@@ -482,7 +482,8 @@ QuicBindingReleaseStatelessOperation(
 
 //
 // Sends data to a remote host. Note, the buffer must remain valid for
-// the duration of the send operation.
+// the duration of the send operation. If a send batch is passed, the send may
+// be held in it until the batch is flushed.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
@@ -492,7 +493,8 @@ QuicBindingSend(
     _In_ const CXPLAT_ROUTE* Route,
     _In_ CXPLAT_SEND_DATA* SendData,
     _In_ uint32_t BytesToSend,
-    _In_ uint32_t DatagramsToSend
+    _In_ uint32_t DatagramsToSend,
+    _Inout_opt_ CXPLAT_SEND_BATCH* SendBatch
     );
 
 
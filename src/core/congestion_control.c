@@ -24,7 +24,14 @@ QuicCongestionControlInitialize(
     _In_ const QUIC_SETTINGS_INTERNAL* Settings
     )
 {
-    CXPLAT_DBG_ASSERT(Settings->CongestionControlAlgorithm < QUIC_CONGESTION_CONTROL_ALGORITHM_MAX);
+    QuicCongestionControlUninitialize(Cc);
+
+    const QUIC_CUSTOM_CONGESTION_CONTROL* Custom =
+        QuicLibraryGetCustomCongestionControl(Settings->CongestionControlAlgorithm);
+    if (Custom != NULL &&
+        QUIC_SUCCEEDED(CustomCongestionControlInitialize(Cc, Settings, Custom))) {
+        return;
+    }
 
     switch (Settings->CongestionControlAlgorithm) {
     default:
@@ -40,5 +47,8 @@ QuicCongestionControlInitialize(
     case QUIC_CONGESTION_CONTROL_ALGORITHM_BBR:
         BbrCongestionControlInitialize(Cc, Settings);
         break;
+    case QUIC_CONGESTION_CONTROL_ALGORITHM_BBR3:
+        Bbr3CongestionControlInitialize(Cc, Settings);
+        break;
     }
 }
@@ -6,7 +6,13 @@
 --*/
 
 #include "bbr.h"
+#include "bbr3.h"
 #include "cubic.h"
+#include "custom_cc.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
 
 typedef struct QUIC_ACK_EVENT {
 
@@ -23,6 +29,11 @@ typedef struct QUIC_ACK_EVENT {
 
     uint32_t NumRetransmittableBytes;
 
+    //
+    // Number of newly acknowledged packets that were sent with an ECT mark.
+    //
+    uint32_t NumEcnEctPacketsAcked;
+
     QUIC_SENT_PACKET_METADATA* AckedPackets;
 
     //
@@ -73,6 +84,11 @@ typedef struct QUIC_ECN_EVENT {
 
     uint64_t LargestSentPacketNumber;
 
+    //
+    // Number of packets newly reported as CE marked by the peer.
+    //
+    uint64_t NewCeCount;
+
 } QUIC_ECN_EVENT;
 
 typedef struct QUIC_CONGESTION_CONTROL {
@@ -82,6 +98,14 @@ typedef struct QUIC_CONGESTION_CONTROL {
     //
     const char* Name;
 
+    //
+    // TRUE if the connection sends ECT(1) and the algorithm responds to CE
+    // marks in proportion to the marking fraction (L4S). Only set by the
+    // algorithms that implement that response (currently Cubic). The others
+    // fall back to classic ECN with ECT(0), even if L4S is enabled.
+    //
+    BOOLEAN L4sEnabled;
+
     BOOLEAN (*QuicCongestionControlCanSend)(
         _In_ struct QUIC_CONGESTION_CONTROL* Cc
         );
@@ -161,12 +185,21 @@ typedef struct QUIC_CONGESTION_CONTROL {
         _Out_ struct QUIC_NETWORK_STATISTICS* NetworkStatistics
         );
 
+    //
+    // Optional. Releases any algorithm state not stored inline.
+    //
+    void (*QuicCongestionControlUninitialize)(
+        _In_ struct QUIC_CONGESTION_CONTROL* Cc
+        );
+
     //
     // Algorithm specific state.
     //
     union {
         QUIC_CONGESTION_CONTROL_CUBIC Cubic;
         QUIC_CONGESTION_CONTROL_BBR Bbr;
+        QUIC_CONGESTION_CONTROL_BBR3 Bbr3;
+        QUIC_CONGESTION_CONTROL_CUSTOM Custom;
     };
 
 } QUIC_CONGESTION_CONTROL;
@@ -217,6 +250,23 @@ QuicCongestionControlInitialize(
     _In_ const QUIC_SETTINGS_INTERNAL* Settings
     );
 
+//
+// Releases any algorithm specific resources. Safe to call on a zeroed or
+// already uninitialized Cc.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+void
+QuicCongestionControlUninitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    if (Cc->QuicCongestionControlUninitialize) {
+        Cc->QuicCongestionControlUninitialize(Cc);
+        Cc->QuicCongestionControlUninitialize = NULL;
+    }
+}
+
 //
 // Returns TRUE if more bytes can be sent on the network.
 //
@@ -412,3 +462,7 @@ QuicCongestionControlSetAppLimited(
 {
     Cc->QuicCongestionControlSetAppLimited(Cc);
 }
+
+#if defined(__cplusplus)
+}
+#endif
@@ -16,7 +16,8 @@ Abstract:
     The only requirement here is that this function is not called in parallel
     on multiple threads. The function will drain up to QUIC_SETTINGS_INTERNAL's
     MaxOperationsPerDrain operations per call, so as to not starve any other
-    work.
+    work. While no other connection is waiting on the worker, that quota is
+    allowed to grow (see QuicConnUpdateOperDrainQuota).
 
     While most of the connection specific work is managed by other modules,
     the following things are managed in this file:
@@ -71,7 +72,7 @@ QuicConnAlloc(
     const uint16_t PartitionId = QuicPartitionIdCreate(Partition->Index);
     CXPLAT_DBG_ASSERT(Partition->Index == QuicPartitionIdGetIndex(PartitionId));
 
-    QUIC_CONNECTION* Connection = CxPlatPoolAlloc(&Partition->ConnectionPool);
+    QUIC_CONNECTION* Connection = CxPlatPoolAllocUninitialized(&Partition->ConnectionPool);
     if (Connection == NULL) {
         QuicTraceEvent(
             AllocFailure,
@@ -81,7 +82,10 @@ QuicConnAlloc(
         return QUIC_STATUS_OUT_OF_MEMORY;
     }
 
-    CxPlatZeroMemory(Connection, sizeof(QUIC_CONNECTION));
+    //
+    // The arena is zeroed piecemeal as its objects are initialized.
+    //
+    CxPlatZeroMemory(Connection, offsetof(QUIC_CONNECTION, Arena));
     Connection->Partition = Partition;
 
 #if DEBUG
@@ -304,6 +308,52 @@ Error:
     return Status;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STREAM*
+QuicConnArenaAllocStream(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    long InUse = Connection->ArenaStreamsInUse;
+    for (;;) {
+        uint32_t Index = 0;
+        while (Index < QUIC_CONN_ARENA_STREAM_COUNT && (InUse & (1 << Index))) {
+            Index++;
+        }
+        if (Index == QUIC_CONN_ARENA_STREAM_COUNT) {
+            QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_CONN_ARENA_OVERFLOW);
+            return NULL;
+        }
+        const long Observed =
+            InterlockedCompareExchange(
+                &Connection->ArenaStreamsInUse, InUse | (1 << Index), InUse);
+        if (Observed == InUse) {
+            QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_CONN_ARENA_ALLOC);
+            return &Connection->Arena.Streams[Index].Stream;
+        }
+        InUse = Observed;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicConnArenaFreeStream(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (!QuicConnArenaContains(Connection, Stream)) {
+        return FALSE;
+    }
+    const uint32_t Index =
+        (uint32_t)(CXPLAT_CONTAINING_RECORD(Stream, QUIC_CONN_ARENA_STREAM, Stream) -
+            Connection->Arena.Streams);
+    CXPLAT_DBG_ASSERT(Index < QUIC_CONN_ARENA_STREAM_COUNT);
+    CXPLAT_DBG_ASSERT(Connection->ArenaStreamsInUse & (1 << Index));
+    InterlockedAnd(&Connection->ArenaStreamsInUse, ~(1 << Index));
+    return TRUE;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicConnFree(
@@ -323,9 +373,11 @@ QuicConnFree(
     }
     CXPLAT_TEL_ASSERT(Connection->SourceCids.Next == NULL);
     CXPLAT_TEL_ASSERT(CxPlatListIsEmpty(&Connection->Streams.ClosedStreams));
+    CXPLAT_DBG_ASSERT(Connection->ArenaStreamsInUse == 0);
     QuicRangeUninitialize(&Connection->DecodedAckRanges);
     QuicCryptoUninitialize(&Connection->Crypto);
     QuicLossDetectionUninitialize(&Connection->LossDetection);
+    QuicCongestionControlUninitialize(&Connection->CongestionControl);
     QuicSendUninitialize(&Connection->Send);
     for (uint32_t i = 0; i < ARRAYSIZE(Connection->Packets); i++) {
         if (Connection->Packets[i] != NULL) {
@@ -354,6 +406,7 @@ QuicConnFree(
     QuicConnUnregister(Connection);
     if (Connection->Worker != NULL) {
         QuicTimerWheelRemoveConnection(&Connection->Worker->TimerWheel, Connection);
+        QuicPacingWheelRemoveConnection(&Connection->Worker->PacingWheel, Connection);
         QuicOperationQueueClear(&Connection->OperQ, Partition);
     }
     if (Connection->ReceiveQueue != NULL) {
@@ -1298,13 +1351,6 @@ QuicConnTimerExpired(
                     QUIC_CONN_TIMER_ACK_DELAY);
                 QuicSendProcessDelayedAckTimer(&Connection->Send);
                 FlushSendImmediate = TRUE;
-            } else if (Type == QUIC_CONN_TIMER_PACING) {
-                QuicTraceEvent(
-                    ConnExecTimerOper,
-                    "[conn][%p] Execute: %u",
-                    Connection,
-                    QUIC_CONN_TIMER_PACING);
-                FlushSendImmediate = TRUE;
             } else {
                 QUIC_OPERATION* Oper;
                 if ((Oper = QuicConnAllocOperation(Connection, QUIC_OPER_TYPE_TIMER_EXPIRED)) != NULL) {
@@ -1338,6 +1384,20 @@ QuicConnTimerExpired(
     }
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnPacingDeparture(
+    _Inout_ QUIC_CONNECTION* Connection
+    )
+{
+    QuicTraceEvent(
+        ConnExecTimerOper,
+        "[conn][%p] Execute: %u",
+        Connection,
+        QUIC_CONN_TIMER_PACING);
+    (void)QuicSendFlush(&Connection->Send);
+}
+
 //
 // Sends a shutdown being notification to the app, which represents the first
 // indication that we know the connection is closed (locally or remotely).
@@ -1409,6 +1469,7 @@ QuicConnOnShutdownComplete(
     // Clean up the rest of the internal state.
     //
     QuicTimerWheelRemoveConnection(&Connection->Worker->TimerWheel, Connection);
+    QuicPacingWheelRemoveConnection(&Connection->Worker->PacingWheel, Connection);
     QuicLossDetectionUninitialize(&Connection->LossDetection);
     QuicSendUninitialize(&Connection->Send);
     QuicDatagramSendShutdown(&Connection->Datagram);
@@ -3099,6 +3160,7 @@ QuicConnProcessPeerTransportParameters(
 
     Connection->Send.PeerMaxData =
         Connection->PeerTransportParams.InitialMaxData;
+    QuicSendUnblockAllStreams(&Connection->Send);
 
     QuicStreamSetInitializeTransportParameters(
         &Connection->Streams,
@@ -3375,6 +3437,24 @@ QuicConnQueueRouteCompletion(
     QuicConnRelease(Connection, QUIC_CONN_REF_ROUTE);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Function_class_(CXPLAT_TLS_PROCESS_COMPLETE_CALLBACK)
+void
+QuicConnQueueTlsCompletion(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    //
+    // Only one TLS call can be pending at a time, so the embedded operation
+    // is always available. The connection's QUIC_CONN_REF_TLS reference is
+    // released once the operation has been processed.
+    //
+    QUIC_OPERATION* Oper = &Connection->TlsCompleteOper;
+    Oper->FreeAfterProcess = FALSE;
+    Oper->Type = QUIC_OPER_TYPE_TLS_COMPLETE;
+    QuicConnQueueOper(Connection, Oper);
+}
+
 //
 // Updates the current destination CID to the received packet's source CID, if
 // not already equal. Only used during the handshake, on the client side.
@@ -4895,6 +4975,7 @@ QuicConnRecvFrames(
                 UpdatedFlowControl = TRUE;
                 QuicConnRemoveOutFlowBlockedReason(
                     Connection, QUIC_FLOW_BLOCKED_CONN_FLOW_CONTROL);
+                QuicSendUnblockAllStreams(&Connection->Send);
                 QuicSendQueueFlush(
                     &Connection->Send, REASON_CONNECTION_FLOW_CONTROL);
             }
@@ -6487,6 +6568,14 @@ QuicConnParamSet(
 
             QuicBindingMoveSourceConnectionIDs(
                 OldBinding, Connection->Paths[0].Binding, Connection);
+
+            //
+            // Sends held in the worker's batch still use the old binding's
+            // socket, so they must go out before it can be released.
+            //
+            if (Connection->SendBatchLink.Flink != NULL) {
+                QuicWorkerFlushSends(Connection->Worker);
+            }
             QuicLibraryReleaseBinding(OldBinding);
 
             QuicTraceEvent(
@@ -6671,6 +6760,11 @@ QuicConnParamSet(
 
         Connection->State.UseRoundRobinStreamScheduling =
             Scheme == QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN;
+        Connection->State.UseWeightedFairStreamScheduling =
+            Scheme == QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR;
+        Connection->State.UseDeadlineStreamScheduling =
+            Scheme == QUIC_STREAM_SCHEDULING_SCHEME_DEADLINE;
+        QuicSendReorderStreams(&Connection->Send);
 
         QuicTraceLogConnInfo(
             UpdateStreamSchedulingScheme,
@@ -7152,6 +7246,21 @@ QuicConnGetV2Statistics(
     if (STATISTICS_HAS_FIELD(*StatsLength, ReceiveQueueDelayMaxUs)) {
         Stats->ReceiveQueueDelayMaxUs = Connection->Stats.Schedule.ReceiveQueueDelayMaxUs;
     }
+    if (STATISTICS_HAS_FIELD(*StatsLength, SendEcnEctPackets)) {
+        Stats->SendEcnEctPackets = Connection->Send.NumPacketsSentWithEct;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, SendEcnCePackets)) {
+        Stats->SendEcnCePackets = Connection->Stats.Send.EcnCePackets;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, RecvEcnCePackets)) {
+        Stats->RecvEcnCePackets = Connection->Stats.Recv.EcnCePackets;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, SendBatchCount)) {
+        Stats->SendBatchCount = Connection->Stats.Send.BatchCount;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, SendBatchDatagrams)) {
+        Stats->SendBatchDatagrams = Connection->Stats.Send.BatchDatagrams;
+    }
 
     *StatsLength = CXPLAT_MIN(*StatsLength, sizeof(QUIC_STATISTICS_V2));
 
@@ -7476,7 +7585,11 @@ QuicConnParamGet(
         *BufferLength = sizeof(QUIC_STREAM_SCHEDULING_SCHEME);
         *(QUIC_STREAM_SCHEDULING_SCHEME*)Buffer =
             Connection->State.UseRoundRobinStreamScheduling ?
-                QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN : QUIC_STREAM_SCHEDULING_SCHEME_FIFO;
+                QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN :
+            Connection->State.UseWeightedFairStreamScheduling ?
+                QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR :
+            Connection->State.UseDeadlineStreamScheduling ?
+                QUIC_STREAM_SCHEDULING_SCHEME_DEADLINE : QUIC_STREAM_SCHEDULING_SCHEME_FIFO;
 
         Status = QUIC_STATUS_SUCCESS;
         break;
@@ -7933,7 +8046,7 @@ QuicConnProcessApiOperation(
         break;
 
     case QUIC_API_TYPE_STRM_SEND:
-        QuicStreamSendFlush(
+        QuicStreamSendFlushChain(
             ApiCtx->STRM_SEND.Stream);
         break;
 
@@ -8081,7 +8194,9 @@ QuicConnDrainOperations(
 {
     QUIC_OPERATION* Oper;
     const uint32_t MaxOperationCount =
-        Connection->Settings.MaxOperationsPerDrain;
+        CXPLAT_MAX(
+            (uint32_t)Connection->OperDrainQuota,
+            (uint32_t)Connection->Settings.MaxOperationsPerDrain);
     uint32_t OperationCount = 0;
     BOOLEAN HasMoreWorkToDo = TRUE;
 
@@ -8202,6 +8317,11 @@ QuicConnDrainOperations(
                 Connection, Oper->ROUTE.PhysicalAddress, Oper->ROUTE.PathId, Oper->ROUTE.Succeeded);
             break;
 
+        case QUIC_OPER_TYPE_TLS_COMPLETE:
+            QuicCryptoProcessTlsCompleteOperation(&Connection->Crypto);
+            QuicConnRelease(Connection, QUIC_CONN_REF_TLS);
+            break;
+
         default:
             CXPLAT_FRE_ASSERT(FALSE);
             break;
@@ -8217,6 +8337,8 @@ QuicConnDrainOperations(
         QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_CONN_OPER_COMPLETED);
     }
 
+    QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_CONN_OPER_DRAINS);
+
     if (Connection->State.ProcessShutdownComplete) {
         QuicConnOnShutdownComplete(Connection);
     }
@@ -8,6 +8,10 @@
 #include "connection.h.clog.h"
 #endif
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 typedef struct QUIC_LISTENER QUIC_LISTENER;
 
 //
@@ -142,6 +146,18 @@ typedef union QUIC_CONNECTION_STATE {
         //
         BOOLEAN UseRoundRobinStreamScheduling : 1;
 
+        //
+        // Indicates the connection is using the weighted fair queuing stream
+        // scheduling scheme.
+        //
+        BOOLEAN UseWeightedFairStreamScheduling : 1;
+
+        //
+        // Indicates the connection is using the earliest deadline first stream
+        // scheduling scheme.
+        //
+        BOOLEAN UseDeadlineStreamScheduling : 1;
+
         //
         // Indicates that this connection has resumption enabled and needs to
         // keep the TLS state and transport parameters until it is done sending
@@ -226,7 +242,10 @@ typedef enum QUIC_CONNECTION_REF {
     QUIC_CONN_REF_LOOKUP_RESULT,        // For connections returned from lookups.
     QUIC_CONN_REF_WORKER,               // Worker is (queued for) processing.
     QUIC_CONN_REF_TIMER_WHEEL,          // The timer wheel is tracking the connection.
+    QUIC_CONN_REF_PACING_WHEEL,         // The pacing wheel is tracking the connection.
+    QUIC_CONN_REF_SEND_BATCH,           // The worker's send batch holds a send.
     QUIC_CONN_REF_ROUTE,                // Route resolution is undergoing.
+    QUIC_CONN_REF_TLS,                  // A TLS call is pending.
     QUIC_CONN_REF_STREAM,               // A stream depends on the connection.
 
     QUIC_CONN_REF_COUNT
@@ -290,6 +309,11 @@ typedef struct QUIC_CONN_STATS {
         uint64_t TotalBytes;            // Sum of UDP payloads
         uint64_t TotalStreamBytes;      // Sum of stream payloads
 
+        uint64_t EcnCePackets;          // Packets the peer reported as CE marked.
+
+        uint64_t BatchCount;            // Send calls made to the datapath.
+        uint64_t BatchDatagrams;        // UDP datagrams across all send calls.
+
         uint32_t CongestionCount;
         uint32_t EcnCongestionCount;
         uint32_t PersistentCongestionCount;
@@ -303,6 +327,7 @@ typedef struct QUIC_CONN_STATS {
         uint64_t DecryptionFailures;    // Count of packets that failed to decrypt.
         uint64_t ValidPackets;          // Count of packets that successfully decrypted or had no encryption.
         uint64_t ValidAckFrames;        // Count of receive ACK frames.
+        uint64_t EcnCePackets;          // Packets received with the CE codepoint.
 
         uint64_t TotalBytes;            // Sum of UDP payloads
         uint64_t TotalStreamBytes;      // Sum of stream payloads
@@ -315,6 +340,34 @@ typedef struct QUIC_CONN_STATS {
 
 } QUIC_CONN_STATS;
 
+//
+// A stream and its initial receive buffer, in the connection's arena.
+//
+typedef struct QUIC_CONN_ARENA_STREAM {
+    QUIC_STREAM Stream;
+    QUIC_RECV_CHUNK RecvChunk;
+    uint8_t RecvBuffer[QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE];
+} QUIC_CONN_ARENA_STREAM;
+
+//
+// Storage allocated together with the connection for the objects nearly every
+// connection needs, so that a short-lived connection takes one allocation
+// instead of one per object. Nothing is freed back to it individually; it is
+// released with the connection. It isn't zeroed when the connection is
+// allocated, only as each object is initialized.
+//
+typedef struct QUIC_CONN_ARENA {
+    QUIC_PACKET_SPACE Packets[QUIC_ENCRYPT_LEVEL_COUNT];
+    QUIC_RECV_CHUNK CryptoRecvChunk;
+    uint8_t CryptoRecvBuffer[
+        CXPLAT_MAX(QUIC_MAX_TLS_CLIENT_SEND_BUFFER, QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE)];
+    QUIC_CONN_ARENA_STREAM Streams[QUIC_CONN_ARENA_STREAM_COUNT];
+} QUIC_CONN_ARENA;
+
+CXPLAT_STATIC_ASSERT(
+    QUIC_CONN_ARENA_STREAM_COUNT > 0 && QUIC_CONN_ARENA_STREAM_COUNT < 32,
+    "Arena streams are tracked by a bit each in a long");
+
 //
 // Connection-specific state.
 //   N.B. In general, all variables should only be written on the QUIC worker
@@ -351,6 +404,18 @@ typedef struct QUIC_CONNECTION {
     //
     CXPLAT_LIST_ENTRY TimerLink;
 
+    //
+    // Link in the pacing wheel's list, and the time of the next paced send
+    // while it is in the wheel.
+    //
+    CXPLAT_LIST_ENTRY PacingLink;
+    uint64_t PacingDepartureTime;
+
+    //
+    // Link in the worker's list of connections with sends in its send batch.
+    //
+    CXPLAT_LIST_ENTRY SendBatchLink;
+
     //
     // The worker that is processing this connection.
     //
@@ -578,6 +643,14 @@ typedef struct QUIC_CONNECTION {
     uint16_t BackUpOperUsed;
     QUIC_OPERATION CloseOper;
     QUIC_API_CONTEXT CloseApiContext;
+    QUIC_OPERATION TlsCompleteOper;
+
+    //
+    // The number of operations the next call to QuicConnDrainOperations may
+    // process, if more than the MaxOperationsPerDrain setting. Updated by the
+    // worker after each drain.
+    //
+    uint16_t OperDrainQuota;
 
     //
     // The status code used for indicating transport closed notifications.
@@ -708,6 +781,16 @@ typedef struct QUIC_CONNECTION {
         QUIC_FLOW_BLOCKED_TIMING_TRACKER FlowControl;
     } BlockedTimings;
 
+    //
+    // Bit per Arena.Streams entry in use. Streams may be opened on any thread.
+    //
+    long ArenaStreamsInUse;
+
+    //
+    // Must be last: QuicConnAlloc only zeroes the fields before it.
+    //
+    QUIC_CONN_ARENA Arena;
+
 } QUIC_CONNECTION;
 
 typedef struct QUIC_SERIALIZED_RESUMPTION_STATE {
@@ -1054,6 +1137,42 @@ QuicConnFree(
     _In_ __drv_freesMem(Mem) QUIC_CONNECTION* Connection
     );
 
+//
+// Returns TRUE if the object is part of the connection's arena.
+//
+QUIC_INLINE
+BOOLEAN
+QuicConnArenaContains(
+    _In_ const QUIC_CONNECTION* Connection,
+    _In_ const void* Object
+    )
+{
+    return
+        (const uint8_t*)Object >= (const uint8_t*)&Connection->Arena &&
+        (const uint8_t*)Object < (const uint8_t*)(&Connection->Arena + 1);
+}
+
+//
+// Takes a free stream from the connection's arena. Returns NULL if they are
+// all in use. The stream isn't zeroed.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STREAM*
+QuicConnArenaAllocStream(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
+//
+// Returns a stream to the connection's arena. Returns FALSE if the stream
+// isn't part of the arena.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicConnArenaFreeStream(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_STREAM* Stream
+    );
+
 //
 // Releases the handle usage of the app.
 //
@@ -1442,6 +1561,15 @@ QuicConnTimerExpired(
     _In_ uint64_t TimeNow
     );
 
+//
+// Called when the connection's paced send is due.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnPacingDeparture(
+    _Inout_ QUIC_CONNECTION* Connection
+    );
+
 //
 // Re-arms (or cancels) the path validation timer based on the earliest
 // in-progress path validation deadline across all paths.
@@ -1472,6 +1600,33 @@ QuicConnGetAckDelay(
     return (uint64_t)Connection->Settings.MaxAckDelayMs;
 }
 
+//
+// Adapts the drain quota of the connection after a drain. A connection that
+// used its whole quota while no other connection was waiting on the worker
+// gets twice as many operations next time, up to
+// QUIC_MAX_OPERATIONS_PER_DRAIN_SCALE times the setting, so that it makes
+// fewer trips through the worker queue. Otherwise it is back to the setting.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_INLINE
+void
+QuicConnUpdateOperDrainQuota(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ BOOLEAN QuotaExhausted,
+    _In_ BOOLEAN WorkerContended
+    )
+{
+    if (QuotaExhausted && !WorkerContended) {
+        const uint32_t BaseQuota = Connection->Settings.MaxOperationsPerDrain;
+        const uint32_t Quota =
+            2 * CXPLAT_MAX((uint32_t)Connection->OperDrainQuota, BaseQuota);
+        Connection->OperDrainQuota =
+            (uint16_t)CXPLAT_MIN(Quota, BaseQuota * QUIC_MAX_OPERATIONS_PER_DRAIN_SCALE);
+    } else {
+        Connection->OperDrainQuota = 0;
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_INLINE
 void
@@ -1683,6 +1838,16 @@ QuicConnQueueRouteCompletion(
     _In_ BOOLEAN Succeeded
     );
 
+//
+// Queues the completion of a pending TLS call to a connection for processing.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Function_class_(CXPLAT_TLS_PROCESS_COMPLETE_CALLBACK)
+void
+QuicConnQueueTlsCompletion(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
 //
 // Queues up an update to the packet tolerance we want the peer to use.
 //
@@ -1780,3 +1945,7 @@ QuicMtuDiscoveryCheckSearchCompleteTimeout(
         }
     }
 }
+
+#if defined(__cplusplus)
+}
+#endif
@@ -26,11 +26,13 @@ Abstract:
 CXPLAT_TLS_RECEIVE_TP_CALLBACK QuicConnReceiveTP;
 CXPLAT_TLS_RECEIVE_TICKET_CALLBACK QuicConnRecvResumptionTicket;
 CXPLAT_TLS_PEER_CERTIFICATE_RECEIVED_CALLBACK QuicConnPeerCertReceived;
+CXPLAT_TLS_PROCESS_COMPLETE_CALLBACK QuicConnQueueTlsCompletion;
 
 CXPLAT_TLS_CALLBACKS QuicTlsCallbacks = {
     QuicConnReceiveTP,
     QuicConnRecvResumptionTicket,
-    QuicConnPeerCertReceived
+    QuicConnPeerCertReceived,
+    QuicConnQueueTlsCompletion
 };
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -116,6 +118,7 @@ QuicCryptoInitialize(
     const uint8_t* HandshakeCid;
     uint8_t HandshakeCidLength;
     BOOLEAN RecvBufferInitialized = FALSE;
+    QUIC_RECV_CHUNK* PreallocatedRecvChunk = NULL;
 
     const QUIC_VERSION_INFO* VersionInfo = &QuicSupportedVersionList[0]; // Default to latest
     for (uint32_t i = 0; i < ARRAYSIZE(QuicSupportedVersionList); ++i) {
@@ -143,13 +146,26 @@ QuicCryptoInitialize(
         goto Exit;
     }
 
+    if (InitialRecvBufferLength <= sizeof(Connection->Arena.CryptoRecvBuffer)) {
+        PreallocatedRecvChunk = &Connection->Arena.CryptoRecvChunk;
+        QuicRecvChunkInitialize(
+            PreallocatedRecvChunk,
+            InitialRecvBufferLength,
+            Connection->Arena.CryptoRecvBuffer,
+            FALSE);
+        PreallocatedRecvChunk->AllocatedInArena = TRUE;
+        QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_CONN_ARENA_ALLOC);
+    } else {
+        QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_CONN_ARENA_OVERFLOW);
+    }
+
     Status =
         QuicRecvBufferInitialize(
             &Crypto->RecvBuffer,
             InitialRecvBufferLength,
             QUIC_DEFAULT_STREAM_FC_WINDOW_SIZE / 2,
             QUIC_RECV_BUF_MODE_SINGLE,
-            NULL);
+            PreallocatedRecvChunk);
     if (QUIC_FAILED(Status)) {
         goto Exit;
     }
@@ -1709,7 +1725,8 @@ QuicCryptoProcessDataComplete(
     _In_ uint32_t RecvBufferConsumed
     )
 {
-    if (Crypto->TicketValidationPending || Crypto->CertValidationPending) {
+    if (Crypto->TicketValidationPending || Crypto->CertValidationPending ||
+        Crypto->TlsCallPending) {
         Crypto->PendingValidationBufferLength = RecvBufferConsumed;
         return;
     }
@@ -1780,6 +1797,48 @@ QuicCryptoCustomCertValidationComplete(
     Crypto->PendingValidationBufferLength = 0;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCryptoProcessTlsCompleteOperation(
+    _In_ QUIC_CRYPTO* Crypto
+    )
+{
+    QUIC_CONNECTION* Connection = QuicCryptoGetConnection(Crypto);
+
+    CXPLAT_DBG_ASSERT(Crypto->TlsCallPending);
+    Crypto->TlsCallPending = FALSE;
+
+    //
+    // Always collect the results so TLS can clean up its side of the call.
+    //
+    Crypto->ResultFlags =
+        CxPlatTlsProcessDataComplete(Crypto->TLS, &Crypto->TlsState);
+
+    QuicTraceLogConnVerbose(
+        CryptoTlsCallComplete,
+        Connection,
+        "TLS processing completed");
+
+    //
+    // The connection might have been shutdown while TLS was processing.
+    // Nothing to do in that case.
+    //
+    if (Connection->State.ShutdownComplete) {
+        Crypto->PendingValidationBufferLength = 0;
+        return;
+    }
+
+    QuicCryptoProcessDataComplete(Crypto, Crypto->PendingValidationBufferLength);
+    Crypto->PendingValidationBufferLength = 0;
+
+    if (QuicRecvBufferHasUnreadData(&Crypto->RecvBuffer)) {
+        //
+        // More data was received while TLS was processing.
+        //
+        QuicCryptoProcessData(Crypto, FALSE);
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicCryptoCustomTicketValidationComplete(
@@ -1864,10 +1923,11 @@ QuicCryptoProcessData(
     uint32_t BufferCount = 1;
     QUIC_BUFFER Buffer;
 
-    if (Crypto->CertValidationPending ||
+    if (Crypto->CertValidationPending || Crypto->TlsCallPending ||
         (Crypto->TicketValidationPending && !Crypto->TicketValidationRejecting)) {
         //
-        // An async validation is pending, don't process any more data until it is complete.
+        // An async validation or TLS call is pending, don't process any more
+        // data until it is complete.
         //
         return Status;
     }
@@ -1982,6 +2042,19 @@ QuicCryptoProcessData(
             &Buffer.Length,
             &Crypto->TlsState);
 
+    if (Crypto->ResultFlags & CXPLAT_TLS_RESULT_PENDING) {
+        //
+        // TLS finishes on another thread and queues a TLS completion operation
+        // to the connection. Hold a reference until it's processed.
+        //
+        QuicTraceLogConnVerbose(
+            CryptoTlsCallPending,
+            QuicCryptoGetConnection(Crypto),
+            "TLS processing pending");
+        Crypto->TlsCallPending = TRUE;
+        QuicConnAddRef(QuicCryptoGetConnection(Crypto), QUIC_CONN_REF_TLS);
+    }
+
     QuicCryptoProcessDataComplete(Crypto, Buffer.Length);
 
     return Status;
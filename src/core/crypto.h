@@ -39,6 +39,11 @@ typedef struct QUIC_CRYPTO {
     //
     BOOLEAN CertValidationPending : 1;
 
+    //
+    // Indicates a CxPlatTlsProcessData call is being completed asynchronously.
+    //
+    BOOLEAN TlsCallPending : 1;
+
     //
     // The TLS context for processing handshake messages.
     //
@@ -286,6 +291,15 @@ QuicCryptoCustomTicketValidationComplete(
     _In_ BOOLEAN Result
     );
 
+//
+// Invoked when TLS has finished a pending CxPlatTlsProcessData call.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCryptoProcessTlsCompleteOperation(
+    _In_ QUIC_CRYPTO* Crypto
+    );
+
 //
 // Helper function to determine how much complete TLS data is contained in the
 // buffer, and should be passed to TLS.
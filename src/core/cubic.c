@@ -22,6 +22,15 @@ Abstract:
 #define TEN_TIMES_BETA_CUBIC 7
 #define TEN_TIMES_C_CUBIC 4
 
+//
+// L4S response (as in DCTCP/Prague): once per round trip with CE marks the
+// window is reduced by Alpha/2, where Alpha is a moving average (gain 1/16) of
+// the per round trip CE fraction. Alpha is fixed point with 16 fraction bits.
+//
+#define L4S_ALPHA_SHIFT 16
+#define L4S_ALPHA_MAX (1u << L4S_ALPHA_SHIFT)
+#define L4S_ALPHA_GAIN_SHIFT 4
+
 //
 // Shifting nth root algorithm.
 //
@@ -161,6 +170,9 @@ CubicCongestionControlReset(
     Cubic->HyStartRoundEnd = Connection->Send.NextPacketNumber;
     CubicCongestionHyStartResetPerRttRound(Cubic);
     CubicCongestionHyStartChangeState(Cc, HYSTART_NOT_STARTED);
+    Cubic->L4sRoundEnd = Connection->Send.NextPacketNumber;
+    Cubic->L4sEctPacketsInRound = 0;
+    Cubic->L4sCePacketsInRound = 0;
     Cubic->IsInRecovery = FALSE;
     Cubic->HasHadCongestionEvent = FALSE;
     Cubic->CongestionWindow = DatagramPayloadLength * Cubic->InitialWindowPackets;
@@ -367,6 +379,81 @@ CubicCongestionControlOnCongestionEvent(
     }
 }
 
+//
+// Scalable (L4S) response to CE marks. The reduction is proportional to the
+// recent marking fraction, so a lightly marked flow backs off only slightly,
+// and the window grows back with the Reno friendly slope of 1 MSS per RTT.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CubicCongestionControlOnL4sCongestionEvent(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUBIC* Cubic = &Cc->Cubic;
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+    QuicTraceEvent(
+        ConnCongestionV2,
+        "[conn][%p] Congestion event: IsEcn=%hu",
+        Connection,
+        TRUE);
+    Connection->Stats.Send.CongestionCount++;
+
+    Cubic->IsInRecovery = TRUE;
+    Cubic->HasHadCongestionEvent = TRUE;
+
+    const uint32_t Reduction =
+        (uint32_t)(((uint64_t)Cubic->CongestionWindow * Cubic->L4sAlpha) >> (L4S_ALPHA_SHIFT + 1));
+
+    Cubic->WindowPrior =
+    Cubic->WindowMax =
+    Cubic->WindowLastMax =
+    Cubic->SlowStartThreshold =
+    Cubic->CongestionWindow =
+    Cubic->AimdWindow =
+        CXPLAT_MAX(
+            (uint32_t)DatagramPayloadLength * QUIC_PERSISTENT_CONGESTION_WINDOW_PACKETS,
+            Cubic->CongestionWindow - Reduction);
+    Cubic->KCubic = 0;
+}
+
+//
+// Folds the CE fraction of the round trip that just ended into L4sAlpha.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CubicCongestionControlL4sUpdateAlpha(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ACK_EVENT* AckEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUBIC* Cubic = &Cc->Cubic;
+
+    Cubic->L4sEctPacketsInRound += AckEvent->NumEcnEctPacketsAcked;
+    if (AckEvent->LargestAck < Cubic->L4sRoundEnd) {
+        return;
+    }
+
+    if (Cubic->L4sEctPacketsInRound != 0) {
+        uint32_t Fraction = L4S_ALPHA_MAX;
+        if (Cubic->L4sCePacketsInRound < Cubic->L4sEctPacketsInRound) {
+            Fraction =
+                (uint32_t)(((uint64_t)Cubic->L4sCePacketsInRound << L4S_ALPHA_SHIFT) /
+                Cubic->L4sEctPacketsInRound);
+        }
+        Cubic->L4sAlpha =
+            Cubic->L4sAlpha - (Cubic->L4sAlpha >> L4S_ALPHA_GAIN_SHIFT) +
+            (Fraction >> L4S_ALPHA_GAIN_SHIFT);
+    }
+
+    Cubic->L4sEctPacketsInRound = 0;
+    Cubic->L4sCePacketsInRound = 0;
+    Cubic->L4sRoundEnd = QuicCongestionControlGetConnection(Cc)->Send.NextPacketNumber;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 CubicCongestionControlOnDataSent(
@@ -450,6 +537,10 @@ CubicCongestionControlOnDataAcknowledged(
     CXPLAT_DBG_ASSERT(Cubic->BytesInFlight >= BytesAcked);
     Cubic->BytesInFlight -= BytesAcked;
 
+    if (Cc->L4sEnabled) {
+        CubicCongestionControlL4sUpdateAlpha(Cc, AckEvent);
+    }
+
     if (Cubic->IsInRecovery) {
         if (AckEvent->LargestAck > Cubic->RecoverySentPacketNumber) {
             //
@@ -762,6 +853,10 @@ CubicCongestionControlOnEcn(
 
     BOOLEAN PreviousCanSendState = CubicCongestionControlCanSend(Cc);
 
+    if (Cc->L4sEnabled) {
+        Cubic->L4sCePacketsInRound += (uint32_t)EcnEvent->NewCeCount;
+    }
+
     //
     // If the ECN signal is received after the most recent congestion event
     // (or if there hasn't been a congestion event yet) then treat it as a
@@ -772,10 +867,14 @@ CubicCongestionControlOnEcn(
 
         Cubic->RecoverySentPacketNumber = EcnEvent->LargestSentPacketNumber;
         QuicCongestionControlGetConnection(Cc)->Stats.Send.EcnCongestionCount++;
-        CubicCongestionControlOnCongestionEvent(
-            Cc,
-            FALSE,
-            TRUE);
+        if (Cc->L4sEnabled) {
+            CubicCongestionControlOnL4sCongestionEvent(Cc);
+        } else {
+            CubicCongestionControlOnCongestionEvent(
+                Cc,
+                FALSE,
+                TRUE);
+        }
         CubicCongestionHyStartChangeState(Cc, HYSTART_DONE);
     }
 
@@ -934,6 +1033,9 @@ CubicCongestionControlInitialize(
     Cubic->HyStartState = HYSTART_NOT_STARTED;
     Cubic->CWndSlowStartGrowthDivisor = 1;
     CubicCongestionHyStartResetPerRttRound(Cubic);
+    Cc->L4sEnabled = Settings->EcnL4sEnabled;
+    Cubic->L4sAlpha = L4S_ALPHA_MAX;
+    Cubic->L4sRoundEnd = Connection->Send.NextPacketNumber;
 
     QuicConnLogOutFlowStats(Connection);
     QuicConnLogCubic(Connection);
@@ -114,6 +114,15 @@ typedef struct QUIC_CONGESTION_CONTROL_CUBIC {
     //
     uint64_t RecoverySentPacketNumber;
 
+    //
+    // L4S state. L4sAlpha is the moving average of the fraction of packets
+    // marked CE per round trip, in units of 1/65536.
+    //
+    uint32_t L4sAlpha;
+    uint32_t L4sEctPacketsInRound;
+    uint32_t L4sCePacketsInRound;
+    uint64_t L4sRoundEnd; // Packet Number
+
 } QUIC_CONGESTION_CONTROL_CUBIC;
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
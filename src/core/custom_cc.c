@@ -0,0 +1,507 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Adapts an app registered congestion control algorithm (see
+    QUIC_PARAM_GLOBAL_CUSTOM_CONGESTION_CONTROL) to the internal congestion
+    control interface.
+
+    The algorithm only owns the congestion window (and optionally the pacing
+    rate). Bytes in flight, probe exemptions, pacing and the connection's
+    blocked state are all handled here, the same way as for Cubic.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "custom_cc.c.clog.h"
+#endif
+
+#include "custom_cc.h"
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CustomCongestionControlCanSend(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+    return Custom->BytesInFlight < Custom->CongestionWindow || Custom->Exemptions > 0;
+}
+
+//
+// Reads back the algorithm's congestion window. It is never allowed to drop
+// below the persistent congestion window so that a misbehaving algorithm can't
+// stall the connection forever.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlRefreshWindow(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+    const uint32_t MinWindow =
+        (uint32_t)QuicPathGetDatagramPayloadSize(
+            &QuicCongestionControlGetConnection(Cc)->Paths[0]) *
+        QUIC_PERSISTENT_CONGESTION_WINDOW_PACKETS;
+
+    Custom->CongestionWindow =
+        CXPLAT_MAX(Custom->Algorithm->GetCongestionWindow(Custom->State), MinWindow);
+}
+
+//
+// Returns TRUE if we became unblocked.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CustomCongestionControlUpdateBlockedState(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN PreviousCanSendState
+    )
+{
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    QuicConnLogOutFlowStats(Connection);
+    if (PreviousCanSendState != CustomCongestionControlCanSend(Cc)) {
+        if (PreviousCanSendState) {
+            QuicConnAddOutFlowBlockedReason(
+                Connection, QUIC_FLOW_BLOCKED_CONGESTION_CONTROL);
+        } else {
+            QuicConnRemoveOutFlowBlockedReason(
+                Connection, QUIC_FLOW_BLOCKED_CONGESTION_CONTROL);
+            Connection->Send.LastFlushTime = CxPlatTimeUs64(); // Reset last flush time
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlSetExemption(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint8_t NumPackets
+    )
+{
+    Cc->Custom.Exemptions = NumPackets;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlReset(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN FullReset
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    Custom->Algorithm->Reset(Custom->State, FullReset);
+    CustomCongestionControlRefreshWindow(Cc);
+    Custom->BytesInFlightMax = Custom->CongestionWindow / 2;
+    Custom->LastSendAllowance = 0;
+    if (FullReset) {
+        Custom->BytesInFlight = 0;
+    }
+
+    QuicConnLogOutFlowStats(QuicCongestionControlGetConnection(Cc));
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+CustomCongestionControlGetSendAllowance(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeSinceLastSend, // microsec
+    _In_ BOOLEAN TimeSinceLastSendValid
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    uint32_t SendAllowance;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    if (Custom->BytesInFlight >= Custom->CongestionWindow) {
+        //
+        // We are CC blocked, so we can't send anything.
+        //
+        SendAllowance = 0;
+
+    } else if (
+        !TimeSinceLastSendValid ||
+        !Connection->Settings.PacingEnabled ||
+        !Connection->Paths[0].GotFirstRttSample ||
+        Connection->Paths[0].SmoothedRtt < QUIC_MIN_PACING_RTT) {
+        //
+        // We're not in the necessary state to pace.
+        //
+        SendAllowance = Custom->CongestionWindow - Custom->BytesInFlight;
+
+    } else {
+        //
+        // Pace at the algorithm's rate if it has one. Otherwise, spread the
+        // window (plus 25% for growth, as Cubic does in congestion avoidance)
+        // over the RTT.
+        //
+        const uint64_t PacingRate =
+            Custom->Algorithm->GetPacingRate != NULL ?
+                Custom->Algorithm->GetPacingRate(Custom->State) : 0;
+        uint64_t NewAllowance;
+        if (PacingRate != 0) {
+            NewAllowance = (PacingRate * TimeSinceLastSend) / 1000000;
+        } else {
+            const uint64_t EstimatedWnd =
+                Custom->CongestionWindow + (Custom->CongestionWindow >> 2);
+            NewAllowance =
+                (EstimatedWnd * TimeSinceLastSend) / Connection->Paths[0].SmoothedRtt;
+        }
+
+        SendAllowance = Custom->LastSendAllowance + (uint32_t)NewAllowance;
+        if (NewAllowance > UINT32_MAX ||
+            SendAllowance < Custom->LastSendAllowance || // Overflow case
+            SendAllowance > (Custom->CongestionWindow - Custom->BytesInFlight)) {
+            SendAllowance = Custom->CongestionWindow - Custom->BytesInFlight;
+        }
+
+        Custom->LastSendAllowance = SendAllowance;
+    }
+    return SendAllowance;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CustomCongestionControlOnDataSent(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t NumRetransmittableBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    BOOLEAN PreviousCanSendState = CustomCongestionControlCanSend(Cc);
+
+    Custom->BytesInFlight += NumRetransmittableBytes;
+    if (Custom->BytesInFlightMax < Custom->BytesInFlight) {
+        Custom->BytesInFlightMax = Custom->BytesInFlight;
+        QuicSendBufferConnectionAdjust(QuicCongestionControlGetConnection(Cc));
+    }
+
+    if (NumRetransmittableBytes > Custom->LastSendAllowance) {
+        Custom->LastSendAllowance = 0;
+    } else {
+        Custom->LastSendAllowance -= NumRetransmittableBytes;
+    }
+
+    if (Custom->Exemptions > 0) {
+        --Custom->Exemptions;
+    }
+
+    if (Custom->Algorithm->OnDataSent != NULL) {
+        Custom->Algorithm->OnDataSent(Custom->State, NumRetransmittableBytes);
+        CustomCongestionControlRefreshWindow(Cc);
+    }
+
+    CustomCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CustomCongestionControlOnDataInvalidated(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t NumRetransmittableBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    BOOLEAN PreviousCanSendState = CustomCongestionControlCanSend(Cc);
+
+    CXPLAT_DBG_ASSERT(Custom->BytesInFlight >= NumRetransmittableBytes);
+    Custom->BytesInFlight -= NumRetransmittableBytes;
+
+    return CustomCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlGetNetworkStatistics(
+    _In_ const QUIC_CONNECTION* const Connection,
+    _In_ const QUIC_CONGESTION_CONTROL* const Cc,
+    _Out_ QUIC_NETWORK_STATISTICS* NetworkStatistics
+    )
+{
+    const QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+    const QUIC_PATH* Path = &Connection->Paths[0];
+
+    NetworkStatistics->BytesInFlight = Custom->BytesInFlight;
+    NetworkStatistics->PostedBytes = Connection->SendBuffer.PostedBytes;
+    NetworkStatistics->IdealBytes = Connection->SendBuffer.IdealBytes;
+    NetworkStatistics->SmoothedRTT = Path->SmoothedRtt;
+    NetworkStatistics->CongestionWindow = Custom->CongestionWindow;
+    NetworkStatistics->Bandwidth = Path->SmoothedRtt == 0 ? 0 : Custom->CongestionWindow / Path->SmoothedRtt;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CustomCongestionControlOnDataAcknowledged(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ACK_EVENT* AckEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    BOOLEAN PreviousCanSendState = CustomCongestionControlCanSend(Cc);
+
+    CXPLAT_DBG_ASSERT(Custom->BytesInFlight >= AckEvent->NumRetransmittableBytes);
+    Custom->BytesInFlight -= AckEvent->NumRetransmittableBytes;
+
+    QUIC_CUSTOM_CONGESTION_CONTROL_ACK Ack;
+    Ack.TimeNow = AckEvent->TimeNow;
+    Ack.LargestAck = AckEvent->LargestAck;
+    Ack.LargestSentPacketNumber = AckEvent->LargestSentPacketNumber;
+    Ack.SmoothedRtt = AckEvent->SmoothedRtt;
+    Ack.MinRtt = AckEvent->MinRtt;
+    Ack.OneWayDelay = AckEvent->OneWayDelay;
+    Ack.BytesAcked = AckEvent->NumRetransmittableBytes;
+    Ack.BytesInFlight = Custom->BytesInFlight;
+    Ack.DatagramPayloadLength = QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+    Ack.MinRttValid = AckEvent->MinRttValid;
+    Ack.HasLoss = AckEvent->HasLoss;
+    Ack.IsLargestAckedPacketAppLimited = AckEvent->IsLargestAckedPacketAppLimited;
+
+    Custom->Algorithm->OnDataAcknowledged(Custom->State, &Ack);
+    CustomCongestionControlRefreshWindow(Cc);
+
+    if (Connection->Settings.NetStatsEventEnabled) {
+        QUIC_CONNECTION_EVENT Event;
+        Event.Type = QUIC_CONNECTION_EVENT_NETWORK_STATISTICS;
+        CustomCongestionControlGetNetworkStatistics(
+            Connection, Cc, &Event.NETWORK_STATISTICS);
+        QuicConnIndicateEvent(Connection, &Event);
+    }
+
+    return CustomCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlOnDataLost(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_LOSS_EVENT* LossEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    BOOLEAN PreviousCanSendState = CustomCongestionControlCanSend(Cc);
+
+    CXPLAT_DBG_ASSERT(Custom->BytesInFlight >= LossEvent->NumRetransmittableBytes);
+    Custom->BytesInFlight -= LossEvent->NumRetransmittableBytes;
+
+    QUIC_CUSTOM_CONGESTION_CONTROL_LOSS Loss;
+    Loss.LargestPacketNumber = LossEvent->LargestPacketNumberLost;
+    Loss.LargestSentPacketNumber = LossEvent->LargestSentPacketNumber;
+    Loss.BytesLost = LossEvent->NumRetransmittableBytes;
+    Loss.BytesInFlight = Custom->BytesInFlight;
+    Loss.DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(
+            &QuicCongestionControlGetConnection(Cc)->Paths[0]);
+    Loss.PersistentCongestion = LossEvent->PersistentCongestion;
+
+    Custom->Algorithm->OnDataLost(Custom->State, &Loss);
+    CustomCongestionControlRefreshWindow(Cc);
+
+    CustomCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlOnEcn(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ECN_EVENT* EcnEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    if (Custom->Algorithm->OnEcn == NULL) {
+        return;
+    }
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    BOOLEAN PreviousCanSendState = CustomCongestionControlCanSend(Cc);
+
+    QUIC_CUSTOM_CONGESTION_CONTROL_LOSS Loss;
+    Loss.LargestPacketNumber = EcnEvent->LargestPacketNumberAcked;
+    Loss.LargestSentPacketNumber = EcnEvent->LargestSentPacketNumber;
+    Loss.BytesLost = 0;
+    Loss.BytesInFlight = Custom->BytesInFlight;
+    Loss.DatagramPayloadLength = QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+    Loss.PersistentCongestion = FALSE;
+
+    Connection->Stats.Send.EcnCongestionCount++;
+    Custom->Algorithm->OnEcn(Custom->State, &Loss);
+    CustomCongestionControlRefreshWindow(Cc);
+
+    CustomCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CustomCongestionControlOnSpuriousCongestionEvent(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    if (Custom->Algorithm->OnSpuriousCongestionEvent == NULL) {
+        return FALSE;
+    }
+
+    BOOLEAN PreviousCanSendState = CustomCongestionControlCanSend(Cc);
+
+    if (!Custom->Algorithm->OnSpuriousCongestionEvent(Custom->State)) {
+        return FALSE;
+    }
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    QuicTraceEvent(
+        ConnSpuriousCongestion,
+        "[conn][%p] Spurious congestion event",
+        Connection);
+
+    CustomCongestionControlRefreshWindow(Cc);
+    return CustomCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+void
+CustomCongestionControlLogOutFlowStatus(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const QUIC_PATH* Path = &Connection->Paths[0];
+    const QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    QuicTraceEvent(
+        ConnOutFlowStatsV2,
+        "[conn][%p] OUT: BytesSent=%llu InFlight=%u CWnd=%u ConnFC=%llu ISB=%llu PostedBytes=%llu SRtt=%llu 1Way=%llu",
+        Connection,
+        Connection->Stats.Send.TotalBytes,
+        Custom->BytesInFlight,
+        Custom->CongestionWindow,
+        Connection->Send.PeerMaxData - Connection->Send.OrderedStreamBytesSent,
+        Connection->SendBuffer.IdealBytes,
+        Connection->SendBuffer.PostedBytes,
+        Path->GotFirstRttSample ? Path->SmoothedRtt : 0,
+        Path->OneWayDelay);
+}
+
+uint32_t
+CustomCongestionControlGetBytesInFlightMax(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Custom.BytesInFlightMax;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint8_t
+CustomCongestionControlGetExemptions(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Custom.Exemptions;
+}
+
+uint32_t
+CustomCongestionControlGetCongestionWindow(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Custom.CongestionWindow;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CustomCongestionControlIsAppLimited(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    UNREFERENCED_PARAMETER(Cc);
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlSetAppLimited(
+    _In_ struct QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    UNREFERENCED_PARAMETER(Cc);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlUninitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+    Custom->Algorithm->Delete(Custom->State);
+    Custom->State = NULL;
+}
+
+static const QUIC_CONGESTION_CONTROL QuicCongestionControlCustom = {
+    .QuicCongestionControlCanSend = CustomCongestionControlCanSend,
+    .QuicCongestionControlSetExemption = CustomCongestionControlSetExemption,
+    .QuicCongestionControlReset = CustomCongestionControlReset,
+    .QuicCongestionControlGetSendAllowance = CustomCongestionControlGetSendAllowance,
+    .QuicCongestionControlOnDataSent = CustomCongestionControlOnDataSent,
+    .QuicCongestionControlOnDataInvalidated = CustomCongestionControlOnDataInvalidated,
+    .QuicCongestionControlOnDataAcknowledged = CustomCongestionControlOnDataAcknowledged,
+    .QuicCongestionControlOnDataLost = CustomCongestionControlOnDataLost,
+    .QuicCongestionControlOnEcn = CustomCongestionControlOnEcn,
+    .QuicCongestionControlOnSpuriousCongestionEvent = CustomCongestionControlOnSpuriousCongestionEvent,
+    .QuicCongestionControlLogOutFlowStatus = CustomCongestionControlLogOutFlowStatus,
+    .QuicCongestionControlGetExemptions = CustomCongestionControlGetExemptions,
+    .QuicCongestionControlGetBytesInFlightMax = CustomCongestionControlGetBytesInFlightMax,
+    .QuicCongestionControlIsAppLimited = CustomCongestionControlIsAppLimited,
+    .QuicCongestionControlSetAppLimited = CustomCongestionControlSetAppLimited,
+    .QuicCongestionControlGetCongestionWindow = CustomCongestionControlGetCongestionWindow,
+    .QuicCongestionControlGetNetworkStatistics = CustomCongestionControlGetNetworkStatistics,
+    .QuicCongestionControlUninitialize = CustomCongestionControlUninitialize
+};
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CustomCongestionControlInitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings,
+    _In_ const QUIC_CUSTOM_CONGESTION_CONTROL* Algorithm
+    )
+{
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    QUIC_CUSTOM_CONGESTION_CONTROL_PARAMS Params;
+    Params.DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+    Params.InitialWindowPackets = Settings->InitialWindowPackets;
+    Params.SendIdleTimeoutMs = Settings->SendIdleTimeoutMs;
+
+    void* State = NULL;
+    QUIC_STATUS Status = Algorithm->Create(Algorithm->Context, &Params, &State);
+    if (QUIC_FAILED(Status)) {
+        return Status;
+    }
+
+    *Cc = QuicCongestionControlCustom;
+    Cc->Name = Algorithm->Name;
+
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+    Custom->Algorithm = Algorithm;
+    Custom->State = State;
+    CustomCongestionControlRefreshWindow(Cc);
+    Custom->BytesInFlightMax = Custom->CongestionWindow / 2;
+
+    QuicConnLogOutFlowStats(Connection);
+
+    return QUIC_STATUS_SUCCESS;
+}
@@ -0,0 +1,63 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+typedef struct QUIC_CONGESTION_CONTROL_CUSTOM {
+
+    //
+    // The app registered algorithm (QUIC_PARAM_GLOBAL_CUSTOM_CONGESTION_CONTROL)
+    // and the per-connection state it created.
+    //
+    const QUIC_CUSTOM_CONGESTION_CONTROL* Algorithm;
+    void* State;
+
+    //
+    // The algorithm's congestion window, refreshed after every callback that
+    // can change it.
+    //
+    uint32_t CongestionWindow; // bytes
+
+    //
+    // The number of bytes considered to be still in the network. Tracked here
+    // instead of by the algorithm so that the send path never depends on the
+    // app's bookkeeping.
+    //
+    uint32_t BytesInFlight;
+    uint32_t BytesInFlightMax;
+
+    //
+    // The leftover send allowance from a previous send. Only used when pacing.
+    //
+    uint32_t LastSendAllowance; // bytes
+
+    //
+    // A count of packets which can be sent ignoring CongestionWindow.
+    //
+    uint8_t Exemptions;
+
+} QUIC_CONGESTION_CONTROL_CUSTOM;
+
+//
+// Initializes Cc to use the app registered algorithm. On failure, Cc is left
+// for the caller to initialize with a built-in algorithm instead.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CustomCongestionControlInitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings,
+    _In_ const QUIC_CUSTOM_CONGESTION_CONTROL* Algorithm
+    );
+
+#if defined(__cplusplus)
+}
+#endif
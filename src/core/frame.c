@@ -341,10 +341,9 @@ QuicAckFrameDecode(
         }
 
         //
-        // N.B. The efficiency here isn't great because we are always inserting
-        // values less than the current minimum, which requires a complete
-        // memmove of the current array. A circular buffer that allows both
-        // forward and backward growth would fix this.
+        // N.B. The blocks are always inserted before the current minimum. The
+        // range keeps free space at the front of its array for this, so these
+        // inserts don't need to move the rest of the array.
         //
 
         if (!QuicRangeAddRange(AckRanges, Largest - Count + 1, Count, &DontCare)) {
@@ -684,6 +684,7 @@ MsQuicLibraryLazyUninitialize(
 #endif
         CxPlatDataPathUninitialize(MsQuicLib.Datapath);
         MsQuicLib.Datapath = NULL;
+        MsQuicLib.SendTxTimeSupported = FALSE;
     }
 
 #if DEBUG
@@ -915,6 +916,8 @@ QuicLibraryLazyInitialize(
 
     CXPLAT_DATAPATH_INIT_CONFIG InitConfig = {0};
     InitConfig.EnableDscpOnRecv = MsQuicLib.EnableDscpOnRecv;
+    InitConfig.EnableSendZeroCopy = MsQuicLib.EnableSendZeroCopy;
+    InitConfig.EnableSendTxTime = MsQuicLib.EnableSendTxTime;
     InitConfig.XdpMapConfigs = MsQuicLib.XdpMapConfigs;
     InitConfig.XdpMapConfigCount = MsQuicLib.XdpMapConfigCount;
 
@@ -931,6 +934,9 @@ QuicLibraryLazyInitialize(
             DataPathInitialized,
             "[data] Initialized, DatapathFeatures=%u",
             QuicLibraryGetDatapathFeatures());
+        MsQuicLib.SendTxTimeSupported =
+            !!(CxPlatDataPathGetSupportedFeatures(MsQuicLib.Datapath, CXPLAT_SOCKET_FLAG_NONE) &
+               CXPLAT_DATAPATH_FEATURE_SEND_TXTIME);
         if (MsQuicLib.ExecutionConfig &&
             MsQuicLib.ExecutionConfig->PollingIdleTimeoutUs != 0) {
             CxPlatDataPathUpdatePollingIdleTimeout(
@@ -1418,6 +1424,60 @@ QuicLibrarySetGlobalParam(
         break;
     }
 
+    case QUIC_PARAM_GLOBAL_DATAPATH_SEND_ZERO_COPY_ENABLED: {
+
+        if (BufferLength != sizeof(BOOLEAN)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (MsQuicLib.LazyInitComplete) {
+            //
+            // Not allowed to change the datapath config after we've already
+            // started running the library.
+            //
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        MsQuicLib.EnableSendZeroCopy = *(BOOLEAN*)Buffer;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    case QUIC_PARAM_GLOBAL_DATAPATH_SEND_TXTIME_ENABLED: {
+
+        if (BufferLength != sizeof(BOOLEAN)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (MsQuicLib.LazyInitComplete) {
+            //
+            // Not allowed to change the datapath config after we've already
+            // started running the library.
+            //
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        MsQuicLib.EnableSendTxTime = *(BOOLEAN*)Buffer;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
     case QUIC_PARAM_GLOBAL_VERSION_NEGOTIATION_ENABLED:
 
         if (Buffer == NULL ||
@@ -1531,6 +1591,57 @@ QuicLibrarySetGlobalParam(
         break;
     }
 
+    case QUIC_PARAM_GLOBAL_CUSTOM_CONGESTION_CONTROL: {
+        if (Buffer == NULL ||
+            BufferLength != sizeof(QUIC_CUSTOM_CONGESTION_CONTROL)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        const QUIC_CUSTOM_CONGESTION_CONTROL* Custom =
+            (const QUIC_CUSTOM_CONGESTION_CONTROL*)Buffer;
+        if (Custom->Algorithm < QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_BASE ||
+            Custom->Algorithm >= QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_BASE +
+                QUIC_MAX_CUSTOM_CONGESTION_CONTROL_ALGORITHMS ||
+            Custom->Name == NULL ||
+            Custom->Create == NULL ||
+            Custom->Delete == NULL ||
+            Custom->Reset == NULL ||
+            Custom->OnDataAcknowledged == NULL ||
+            Custom->OnDataLost == NULL ||
+            Custom->GetCongestionWindow == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        CxPlatLockAcquire(&MsQuicLib.Lock);
+
+        //
+        // Connections read the registered algorithms without any lock, so they
+        // can only be changed before the first registration is opened.
+        //
+        if (MsQuicLib.LazyInitComplete) {
+            CxPlatLockRelease(&MsQuicLib.Lock);
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        MsQuicLib.CustomCongestionControl[
+            Custom->Algorithm - QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_BASE] = *Custom;
+        CxPlatLockRelease(&MsQuicLib.Lock);
+        break;
+    }
+
+    case QUIC_PARAM_GLOBAL_TLS_SIGNING_POOL_SIZE:
+        if (Buffer == NULL ||
+            BufferLength != sizeof(uint16_t)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        Status = CxPlatTlsSetSigningPoolSize(*(uint16_t*)Buffer);
+        break;
+
     default:
         Status = QUIC_STATUS_INVALID_PARAMETER;
         break;
@@ -1832,6 +1943,8 @@ QuicLibraryGetGlobalParam(
             QUIC_STATISTICS_V2_SIZE_3,
             QUIC_STATISTICS_V2_SIZE_4,
             QUIC_STATISTICS_V2_SIZE_5,
+            QUIC_STATISTICS_V2_SIZE_6,
+            QUIC_STATISTICS_V2_SIZE_7,
         };
         static const uint32_t NumStatSizes = ARRAYSIZE(StatSizes);
         uint32_t MaxSizes = *BufferLength / sizeof(uint32_t);
@@ -2165,7 +2278,8 @@ QuicLibraryGetParam(
     case QUIC_PARAM_PREFIX_TLS_SCHANNEL:
         if (Connection == NULL) {
             Status = QUIC_STATUS_INVALID_PARAMETER;
-        } else if (Connection->Crypto.TLS == NULL) {
+        } else if (Connection->Crypto.TLS == NULL ||
+            Connection->Crypto.TlsCallPending) {
             Status = QUIC_STATUS_INVALID_STATE;
         } else {
             Status = CxPlatTlsParamGet(Connection->Crypto.TLS, Param, BufferLength, Buffer);
@@ -91,6 +91,24 @@ typedef struct QUIC_LIBRARY {
     //
     BOOLEAN EnableDscpOnRecv : 1;
 
+    //
+    // Whether the datapath will send from registered buffers with zero-copy
+    // send operations, where supported.
+    //
+    BOOLEAN EnableSendZeroCopy : 1;
+
+    //
+    // Whether the datapath will schedule paced sends at their departure time
+    // (earliest departure time offload), where supported.
+    //
+    BOOLEAN EnableSendTxTime : 1;
+
+    //
+    // Whether the (non-XDP) datapath supports scheduling sends at their
+    // departure time. Only valid after lazy initialization.
+    //
+    BOOLEAN SendTxTimeSupported : 1;
+
 #ifdef CxPlatVerifierEnabled
     //
     // The app or driver verifier is globally enabled.
@@ -211,6 +229,15 @@ typedef struct QUIC_LIBRARY {
     const CXPLAT_XDP_MAP_CONFIG* XdpMapConfigs;
     uint32_t XdpMapConfigCount;
 
+    //
+    // App provided congestion control algorithms, indexed by algorithm value
+    // minus QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_BASE. Set via
+    // QUIC_PARAM_GLOBAL_CUSTOM_CONGESTION_CONTROL before any registration and
+    // read-only afterwards. Unregistered slots have a NULL Create.
+    //
+    QUIC_CUSTOM_CONGESTION_CONTROL
+        CustomCongestionControl[QUIC_MAX_CUSTOM_CONGESTION_CONTROL_ALGORITHMS];
+
     //
     // Datapath instance for the library.
     //
@@ -394,6 +421,28 @@ QuicLibraryGetCurrentPartition(
     return QuicLibraryGetPartitionFromProcessorIndex(CurrentProc);
 }
 
+//
+// Returns the app registered congestion control algorithm for the given
+// algorithm value, or NULL if it isn't a registered custom algorithm.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+const QUIC_CUSTOM_CONGESTION_CONTROL*
+QuicLibraryGetCustomCongestionControl(
+    _In_ uint16_t Algorithm
+    )
+{
+    if (Algorithm < QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_BASE ||
+        Algorithm >= QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_BASE +
+            QUIC_MAX_CUSTOM_CONGESTION_CONTROL_ALGORITHMS) {
+        return NULL;
+    }
+    const QUIC_CUSTOM_CONGESTION_CONTROL* Custom =
+        &MsQuicLib.CustomCongestionControl[
+            Algorithm - QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_BASE];
+    return Custom->Create != NULL ? Custom : NULL;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_INLINE
 uint16_t
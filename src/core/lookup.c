@@ -14,11 +14,65 @@ Abstract:
 #include "lookup.c.clog.h"
 #endif
 
+//
+// Memory that has been unlinked from a lock-free table, but may still be in
+// use by readers. Freed once the lookup's reader epoch has advanced twice
+// since it was retired.
+//
+typedef struct QUIC_LOOKUP_RETIRED {
+
+    struct QUIC_LOOKUP_RETIRED* Next;
+    long Epoch;
+
+    //
+    // If set, the lookup table's reference on this connection, released along
+    // with the memory so that readers can still safely add their own.
+    //
+    QUIC_CONNECTION* Connection;
+
+} QUIC_LOOKUP_RETIRED;
+
+//
+// Entry in a lock-free local CID table. It holds a copy of the CID so readers
+// never touch the QUIC_CID_HASH_ENTRY, whose lifetime the connection controls.
+//
+typedef struct QUIC_RCU_CID_ENTRY {
+
+    QUIC_LOOKUP_RETIRED Retired;
+    struct QUIC_RCU_CID_ENTRY* Next;
+    const QUIC_CID_HASH_ENTRY* SourceCid; // Only used by writers.
+    QUIC_CONNECTION* Connection;
+    uint32_t Hash;
+    uint8_t Length;
+    uint8_t Data[0];
+
+} QUIC_RCU_CID_ENTRY;
+
+//
+// Lock-free local CID table. Readers only ever see a fully built table; growing
+// the table publishes a new copy and retires the old one.
+//
+typedef struct QUIC_RCU_CID_TABLE {
+
+    QUIC_LOOKUP_RETIRED Retired;
+    uint32_t Mask;
+    uint32_t Count;
+    QUIC_RCU_CID_ENTRY* Buckets[0];
+
+} QUIC_RCU_CID_TABLE;
+
+#define QUIC_RCU_CID_TABLE_INITIAL_SIZE 16
+
 typedef struct QUIC_CACHEALIGN QUIC_PARTITIONED_HASHTABLE {
 
     CXPLAT_DISPATCH_RW_LOCK RwLock;
     CXPLAT_HASHTABLE Table;
 
+    //
+    // Only used (instead of Table) if the lookup has lock-free reads.
+    //
+    QUIC_RCU_CID_TABLE* RcuTable;
+
 } QUIC_PARTITIONED_HASHTABLE;
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -40,6 +94,310 @@ QuicLookupInitialize(
     CxPlatDispatchRwLockInitialize(&Lookup->RwLock);
 }
 
+//
+// Unlinks all the retired memory that no reader can still reference, and
+// returns it to be passed to QuicLookupFreeRetired once the Lookup->RwLock is
+// released. Requires the Lookup->RwLock to be exclusively held.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_LOOKUP_RETIRED*
+QuicLookupReclaim(
+    _In_ QUIC_LOOKUP* Lookup,
+    _In_ BOOLEAN All
+    )
+{
+    QUIC_LOOKUP_RETIRED* Reclaimed = NULL;
+    QUIC_LOOKUP_RETIRED** Prev = &Lookup->Retired;
+    while (*Prev != NULL) {
+        QUIC_LOOKUP_RETIRED* Retired = *Prev;
+        if (All || (long)(Lookup->ReaderEpoch - Retired->Epoch) >= 2) {
+            *Prev = Retired->Next;
+            Retired->Next = Reclaimed;
+            Reclaimed = Retired;
+        } else {
+            Prev = &Retired->Next;
+        }
+    }
+    return Reclaimed;
+}
+
+//
+// Frees memory returned by QuicLookupReclaim and releases the connection
+// references it held. Must not be called with the Lookup->RwLock held, as
+// releasing the last reference cleans up the connection.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLookupFreeRetired(
+    _In_opt_ QUIC_LOOKUP_RETIRED* Reclaimed
+    )
+{
+    while (Reclaimed != NULL) {
+        QUIC_LOOKUP_RETIRED* Retired = Reclaimed;
+        Reclaimed = Reclaimed->Next;
+        if (Retired->Connection != NULL) {
+            QuicConnRelease(Retired->Connection, QUIC_CONN_REF_LOOKUP_TABLE);
+        }
+        CXPLAT_FREE(Retired, QUIC_POOL_LOOKUP_HASHTABLE);
+    }
+}
+
+//
+// Advances the reader epoch, if no reader that started before the previous
+// advance is still active. Requires the Lookup->RwLock to be exclusively held.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicLookupTryAdvanceEpoch(
+    _In_ QUIC_LOOKUP* Lookup
+    )
+{
+    const uint32_t StaleParity = (uint32_t)(Lookup->ReaderEpoch + 1) & 1;
+    for (uint32_t i = 0; i < Lookup->ReaderCount; i++) {
+        //
+        // N.B. The interlocked read orders it after any preceding unlink.
+        //
+        if (InterlockedCompareExchange(&Lookup->Readers[i].Count[StaleParity], 0, 0) != 0) {
+            return FALSE;
+        }
+    }
+    InterlockedIncrement(&Lookup->ReaderEpoch);
+    return TRUE;
+}
+
+//
+// Advances the reader epoch as far as active readers currently allow and
+// unlinks the retired memory that became unreachable. Never waits: whatever
+// is still held back is finished by the last of those readers on its way out
+// (see QuicLookupFindConnectionByLocalCidLockFree). Requires the
+// Lookup->RwLock to be exclusively held.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_LOOKUP_RETIRED*
+QuicLookupTryReclaim(
+    _In_ QUIC_LOOKUP* Lookup
+    )
+{
+    if (Lookup->Retired == NULL) {
+        return NULL;
+    }
+    if (QuicLookupTryAdvanceEpoch(Lookup)) {
+        (void)QuicLookupTryAdvanceEpoch(Lookup);
+    }
+    return QuicLookupReclaim(Lookup, FALSE);
+}
+
+//
+// Adds unlinked memory to the lookup's retired list, optionally along with the
+// lookup table's reference on a connection. Requires the Lookup->RwLock to be
+// exclusively held.
+//
+QUIC_INLINE
+void
+QuicLookupRetire(
+    _In_ QUIC_LOOKUP* Lookup,
+    _In_ QUIC_LOOKUP_RETIRED* Retired,
+    _In_opt_ QUIC_CONNECTION* Connection
+    )
+{
+    Retired->Epoch = Lookup->ReaderEpoch;
+    Retired->Connection = Connection;
+    Retired->Next = Lookup->Retired;
+    Lookup->Retired = Retired;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_RCU_CID_TABLE*
+QuicRcuCidTableAlloc(
+    _In_ uint32_t BucketCount
+    )
+{
+    CXPLAT_DBG_ASSERT((BucketCount & (BucketCount - 1)) == 0);
+    const size_t Size = sizeof(QUIC_RCU_CID_TABLE) + BucketCount * sizeof(QUIC_RCU_CID_ENTRY*);
+    QUIC_RCU_CID_TABLE* Table = CXPLAT_ALLOC_NONPAGED(Size, QUIC_POOL_LOOKUP_HASHTABLE);
+    if (Table != NULL) {
+        CxPlatZeroMemory(Table, Size);
+        Table->Mask = BucketCount - 1;
+    }
+    return Table;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRcuCidTableFree(
+    _In_ QUIC_RCU_CID_TABLE* Table
+    )
+{
+    for (uint32_t i = 0; i <= Table->Mask; i++) {
+        QUIC_RCU_CID_ENTRY* Entry = Table->Buckets[i];
+        while (Entry != NULL) {
+            QUIC_RCU_CID_ENTRY* Next = Entry->Next;
+            CXPLAT_FREE(Entry, QUIC_POOL_LOOKUP_HASHTABLE);
+            Entry = Next;
+        }
+    }
+    CXPLAT_FREE(Table, QUIC_POOL_LOOKUP_HASHTABLE);
+}
+
+//
+// Doubles the number of buckets of a lock-free table. Entries are copied, so
+// that readers still traversing the old table are unaffected, and the old
+// table and entries are retired. Requires the Lookup->RwLock to be exclusively
+// held. On allocation failure, the table is left as is.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLookupRcuGrow(
+    _In_ QUIC_LOOKUP* Lookup,
+    _In_ QUIC_PARTITIONED_HASHTABLE* Table
+    )
+{
+    QUIC_RCU_CID_TABLE* OldTable = Table->RcuTable;
+    QUIC_RCU_CID_TABLE* NewTable = QuicRcuCidTableAlloc((OldTable->Mask + 1) * 2);
+    if (NewTable == NULL) {
+        return;
+    }
+
+    for (uint32_t i = 0; i <= OldTable->Mask; i++) {
+        for (const QUIC_RCU_CID_ENTRY* Entry = OldTable->Buckets[i]; Entry != NULL; Entry = Entry->Next) {
+            const size_t EntrySize = sizeof(QUIC_RCU_CID_ENTRY) + Entry->Length;
+            QUIC_RCU_CID_ENTRY* NewEntry = CXPLAT_ALLOC_NONPAGED(EntrySize, QUIC_POOL_LOOKUP_HASHTABLE);
+            if (NewEntry == NULL) {
+                QuicRcuCidTableFree(NewTable);
+                return;
+            }
+            CxPlatCopyMemory(NewEntry, Entry, EntrySize);
+            NewEntry->Next = NewTable->Buckets[Entry->Hash & NewTable->Mask];
+            NewTable->Buckets[Entry->Hash & NewTable->Mask] = NewEntry;
+            NewTable->Count++;
+        }
+    }
+
+    InterlockedExchangePointer((void**)&Table->RcuTable, NewTable);
+
+    for (uint32_t i = 0; i <= OldTable->Mask; i++) {
+        for (QUIC_RCU_CID_ENTRY* Entry = OldTable->Buckets[i]; Entry != NULL; Entry = Entry->Next) {
+            QuicLookupRetire(Lookup, &Entry->Retired, NULL);
+        }
+    }
+    QuicLookupRetire(Lookup, &OldTable->Retired, NULL);
+}
+
+//
+// Inserts a source connection ID into a lock-free table. Requires the
+// Lookup->RwLock to be exclusively held.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicLookupRcuInsert(
+    _In_ QUIC_LOOKUP* Lookup,
+    _In_ QUIC_PARTITIONED_HASHTABLE* Table,
+    _In_ uint32_t Hash,
+    _In_ const QUIC_CID_HASH_ENTRY* SourceCid
+    )
+{
+    if (Table->RcuTable->Count > Table->RcuTable->Mask) {
+        QuicLookupRcuGrow(Lookup, Table);
+    }
+
+    QUIC_RCU_CID_ENTRY* Entry =
+        CXPLAT_ALLOC_NONPAGED(
+            sizeof(QUIC_RCU_CID_ENTRY) + SourceCid->CID.Length,
+            QUIC_POOL_LOOKUP_HASHTABLE);
+    if (Entry == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "lock-free CID entry",
+            sizeof(QUIC_RCU_CID_ENTRY) + SourceCid->CID.Length);
+        return FALSE;
+    }
+
+    QUIC_RCU_CID_TABLE* RcuTable = Table->RcuTable;
+    Entry->SourceCid = SourceCid;
+    Entry->Connection = SourceCid->Connection;
+    Entry->Hash = Hash;
+    Entry->Length = SourceCid->CID.Length;
+    CxPlatCopyMemory(Entry->Data, SourceCid->CID.Data, SourceCid->CID.Length);
+    Entry->Next = RcuTable->Buckets[Hash & RcuTable->Mask];
+
+    //
+    // Publish the fully initialized entry.
+    //
+    InterlockedExchangePointer((void**)&RcuTable->Buckets[Hash & RcuTable->Mask], Entry);
+    RcuTable->Count++;
+
+    return TRUE;
+}
+
+//
+// Unlinks and retires a source connection ID from a lock-free table, along
+// with the lookup table's reference on the connection. Returns FALSE if the
+// entry wasn't found and the caller still owns that reference. Requires the
+// Lookup->RwLock to be exclusively held.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicLookupRcuRemove(
+    _In_ QUIC_LOOKUP* Lookup,
+    _In_ QUIC_PARTITIONED_HASHTABLE* Table,
+    _In_ const QUIC_CID_HASH_ENTRY* SourceCid
+    )
+{
+    QUIC_RCU_CID_TABLE* RcuTable = Table->RcuTable;
+    const uint32_t Hash = CxPlatHashSimple(SourceCid->CID.Length, SourceCid->CID.Data);
+    QUIC_RCU_CID_ENTRY** Prev = &RcuTable->Buckets[Hash & RcuTable->Mask];
+    while (*Prev != NULL && (*Prev)->SourceCid != SourceCid) {
+        Prev = &(*Prev)->Next;
+    }
+
+    QUIC_RCU_CID_ENTRY* Entry = *Prev;
+    if (Entry == NULL) {
+        return FALSE; // Only possible if the insert failed during a rebalance.
+    }
+
+    //
+    // N.B. Entry->Next is left as is, so that readers currently on the entry
+    // can continue their traversal.
+    //
+    InterlockedExchangePointer((void**)Prev, Entry->Next);
+    RcuTable->Count--;
+    QuicLookupRetire(Lookup, &Entry->Retired, Entry->Connection);
+    return TRUE;
+}
+
+//
+// Looks up the connection in a lock-free table. The caller must either be a
+// registered reader or hold the Lookup->RwLock exclusively.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_CONNECTION*
+QuicRcuCidTableLookup(
+    _In_ QUIC_PARTITIONED_HASHTABLE* Table,
+    _In_reads_(Length)
+        const uint8_t* const DestCid,
+    _In_ uint8_t Length,
+    _In_ uint32_t Hash
+    )
+{
+    const QUIC_RCU_CID_TABLE* RcuTable =
+        (const QUIC_RCU_CID_TABLE*)QuicReadPtrNoFence((void**)&Table->RcuTable);
+    const QUIC_RCU_CID_ENTRY* Entry =
+        (const QUIC_RCU_CID_ENTRY*)QuicReadPtrNoFence(
+            (void**)&RcuTable->Buckets[Hash & RcuTable->Mask]);
+
+    while (Entry != NULL) {
+        if (Entry->Hash == Hash &&
+            Entry->Length == Length &&
+            memcmp(DestCid, Entry->Data, Length) == 0) {
+            return Entry->Connection;
+        }
+        Entry = (const QUIC_RCU_CID_ENTRY*)QuicReadPtrNoFence((void**)&Entry->Next);
+    }
+
+    return NULL;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicLookupUninitialize(
@@ -60,10 +418,22 @@ QuicLookupUninitialize(
             CxPlatHashtableUninitialize(&Table->Table);
 #pragma warning(pop)
             CxPlatDispatchRwLockUninitialize(&Table->RwLock);
+            if (Table->RcuTable != NULL) {
+                CXPLAT_DBG_ASSERT(Table->RcuTable->Count == 0);
+                QuicRcuCidTableFree(Table->RcuTable);
+            }
         }
         CXPLAT_FREE(Lookup->HASH.Tables, QUIC_POOL_LOOKUP_HASHTABLE);
     }
 
+    if (Lookup->Readers != NULL) {
+        //
+        // No readers are left at this point.
+        //
+        QuicLookupFreeRetired(QuicLookupReclaim(Lookup, TRUE));
+        CXPLAT_FREE(Lookup->Readers, QUIC_POOL_LOOKUP_HASHTABLE);
+    }
+
     if (Lookup->MaximizePartitioning) {
         CXPLAT_DBG_ASSERT(Lookup->RemoteHashTable.NumEntries == 0);
         CxPlatHashtableUninitialize(&Lookup->RemoteHashTable);
@@ -95,7 +465,20 @@ QuicLookupCreateHashTable(
         uint16_t Cleanup = 0;
         uint8_t Failed = FALSE;
         for (uint16_t i = 0; i < PartitionCount; i++) {
+            Lookup->HASH.Tables[i].RcuTable = NULL;
+            if (Lookup->Readers != NULL) {
+                Lookup->HASH.Tables[i].RcuTable =
+                    QuicRcuCidTableAlloc(QUIC_RCU_CID_TABLE_INITIAL_SIZE);
+                if (Lookup->HASH.Tables[i].RcuTable == NULL) {
+                    Cleanup = i;
+                    Failed = TRUE;
+                    break;
+                }
+            }
             if (!CxPlatHashtableInitializeEx(&Lookup->HASH.Tables[i].Table, CXPLAT_HASH_MIN_SIZE)) {
+                if (Lookup->HASH.Tables[i].RcuTable != NULL) {
+                    QuicRcuCidTableFree(Lookup->HASH.Tables[i].RcuTable);
+                }
                 Cleanup = i;
                 Failed = TRUE;
                 break;
@@ -105,6 +488,9 @@ QuicLookupCreateHashTable(
         if (Failed) {
             for (uint16_t i = 0; i < Cleanup; i++) {
                 CxPlatHashtableUninitialize(&Lookup->HASH.Tables[i].Table);
+                if (Lookup->HASH.Tables[i].RcuTable != NULL) {
+                    QuicRcuCidTableFree(Lookup->HASH.Tables[i].RcuTable);
+                }
             }
             CXPLAT_FREE(Lookup->HASH.Tables, QUIC_POOL_LOOKUP_HASHTABLE);
             Lookup->HASH.Tables = NULL;
@@ -254,11 +640,35 @@ QuicLookupMaximizePartitioning(
             CxPlatHashtableInitializeEx(
                 &Lookup->RemoteHashTable, CXPLAT_HASH_MIN_SIZE);
         if (Result) {
+            //
+            // Maximized lookups are on the receive path of (potentially) many
+            // connections, so switch to lock-free reads if the local CID tables
+            // are about to be recreated anyway. Best effort.
+            //
+            if (Lookup->PartitionCount < MsQuicLib.PartitionCount) {
+                const uint32_t ReaderCount = CxPlatProcCount();
+                Lookup->Readers =
+                    CXPLAT_ALLOC_NONPAGED(
+                        sizeof(QUIC_LOOKUP_READER) * ReaderCount,
+                        QUIC_POOL_LOOKUP_HASHTABLE);
+                if (Lookup->Readers != NULL) {
+                    CxPlatZeroMemory(Lookup->Readers, sizeof(QUIC_LOOKUP_READER) * ReaderCount);
+                    Lookup->ReaderCount = ReaderCount;
+                }
+            }
             Lookup->MaximizePartitioning = TRUE;
             Result = QuicLookupRebalance(Lookup, NULL);
             if (!Result) {
                 CxPlatHashtableUninitialize(&Lookup->RemoteHashTable);
                 Lookup->MaximizePartitioning = FALSE;
+                if (Lookup->Readers != NULL) {
+                    CXPLAT_FREE(Lookup->Readers, QUIC_POOL_LOOKUP_HASHTABLE);
+                    Lookup->Readers = NULL;
+                    Lookup->ReaderCount = 0;
+                }
+            } else if (Lookup->Readers != NULL) {
+                CXPLAT_DBG_ASSERT(Lookup->PartitionCount == MsQuicLib.PartitionCount);
+                InterlockedExchangePointer((void**)&Lookup->LockFreeTables, Lookup->HASH.Tables);
             }
         }
     }
@@ -369,14 +779,18 @@ QuicLookupFindConnectionByLocalCidInternal(
         PartitionIndex %= Lookup->PartitionCount;
         QUIC_PARTITIONED_HASHTABLE* Table = &Lookup->HASH.Tables[PartitionIndex];
 
-        CxPlatDispatchRwLockAcquireShared(&Table->RwLock, PrevIrql);
-        Connection =
-            QuicHashLookupConnection(
-                &Table->Table,
-                CID,
-                CIDLen,
-                Hash);
-        CxPlatDispatchRwLockReleaseShared(&Table->RwLock, PrevIrql);
+        if (Table->RcuTable != NULL) {
+            Connection = QuicRcuCidTableLookup(Table, CID, CIDLen, Hash);
+        } else {
+            CxPlatDispatchRwLockAcquireShared(&Table->RwLock, PrevIrql);
+            Connection =
+                QuicHashLookupConnection(
+                    &Table->Table,
+                    CID,
+                    CIDLen,
+                    Hash);
+            CxPlatDispatchRwLockReleaseShared(&Table->RwLock, PrevIrql);
+        }
     }
 
 #if QUIC_DEBUG_HASHTABLE_LOOKUP
@@ -487,13 +901,19 @@ QuicLookupInsertLocalCid(
         PartitionIndex %= Lookup->PartitionCount;
         QUIC_PARTITIONED_HASHTABLE* Table = &Lookup->HASH.Tables[PartitionIndex];
 
-        CxPlatDispatchRwLockAcquireExclusive(&Table->RwLock, PrevIrql);
-        CxPlatHashtableInsert(
-            &Table->Table,
-            &SourceCid->Entry,
-            Hash,
-            NULL);
-        CxPlatDispatchRwLockReleaseExclusive(&Table->RwLock, PrevIrql);
+        if (Table->RcuTable != NULL) {
+            if (!QuicLookupRcuInsert(Lookup, Table, Hash, SourceCid)) {
+                return FALSE;
+            }
+        } else {
+            CxPlatDispatchRwLockAcquireExclusive(&Table->RwLock, PrevIrql);
+            CxPlatHashtableInsert(
+                &Table->Table,
+                &SourceCid->Entry,
+                Hash,
+                NULL);
+            CxPlatDispatchRwLockReleaseExclusive(&Table->RwLock, PrevIrql);
+        }
     }
 
     if (UpdateRefCount) {
@@ -574,11 +994,13 @@ QuicLookupInsertRemoteHash(
 }
 
 //
-// Removes a source connection ID from the lookup table. Requires the
-// Lookup->RwLock to be exlusively held.
+// Removes a source connection ID from the lookup table. Returns FALSE if the
+// release of the table's reference on the connection was deferred until no
+// lock-free reader can find it anymore. Requires the Lookup->RwLock to be
+// exlusively held.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
-void
+BOOLEAN
 QuicLookupRemoveLocalCidInt(
     _In_ QUIC_LOOKUP* Lookup,
     _In_ QUIC_CID_HASH_ENTRY* SourceCid
@@ -617,10 +1039,88 @@ QuicLookupRemoveLocalCidInt(
         PartitionIndex &= MsQuicLib.PartitionMask;
         PartitionIndex %= Lookup->PartitionCount;
         QUIC_PARTITIONED_HASHTABLE* Table = &Lookup->HASH.Tables[PartitionIndex];
+        if (Table->RcuTable != NULL) {
+            return !QuicLookupRcuRemove(Lookup, Table, SourceCid);
+        }
         CxPlatDispatchRwLockAcquireExclusive(&Table->RwLock, PrevIrql);
         CxPlatHashtableRemove(&Table->Table, &SourceCid->Entry, NULL);
         CxPlatDispatchRwLockReleaseExclusive(&Table->RwLock, PrevIrql);
     }
+
+    return TRUE;
+}
+
+//
+// Lock-free version of QuicLookupFindConnectionByLocalCid.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_CONNECTION*
+QuicLookupFindConnectionByLocalCidLockFree(
+    _In_ QUIC_LOOKUP* Lookup,
+    _In_ QUIC_PARTITIONED_HASHTABLE* Tables,
+    _In_reads_(CIDLen)
+        const uint8_t* const CID,
+    _In_ uint8_t CIDLen,
+    _In_ uint32_t Hash
+    )
+{
+    CXPLAT_DBG_ASSERT(CIDLen >= QUIC_MIN_INITIAL_CONNECTION_ID_LENGTH);
+
+    CXPLAT_STATIC_ASSERT(QUIC_CID_PID_LENGTH == 2, "The code below assumes 2 bytes");
+    uint16_t PartitionIndex;
+    CxPlatCopyMemory(&PartitionIndex, CID + MsQuicLib.CidServerIdLength, 2);
+    PartitionIndex &= MsQuicLib.PartitionMask;
+    PartitionIndex %= MsQuicLib.PartitionCount;
+
+    //
+    // Register as a reader for the current epoch. Writers don't free anything
+    // unlinked while this reader might still reference it, and the connection
+    // keeps its lookup table reference until then as well, so it's safe to
+    // add a reference to it below.
+    //
+    QUIC_LOOKUP_READER* Reader =
+        &Lookup->Readers[CxPlatProcCurrentNumber() % Lookup->ReaderCount];
+    const uint32_t Parity = (uint32_t)Lookup->ReaderEpoch & 1;
+    InterlockedIncrement(&Reader->Count[Parity]);
+
+    QUIC_CONNECTION* Connection =
+        QuicRcuCidTableLookup(&Tables[PartitionIndex], CID, CIDLen, Hash);
+    if (Connection != NULL) {
+        QuicConnAddRef(Connection, QUIC_CONN_REF_LOOKUP_RESULT);
+    }
+
+    if (InterlockedDecrement(&Reader->Count[Parity]) == 0 &&
+        Parity != ((uint32_t)Lookup->ReaderEpoch & 1) &&
+        QuicReadPtrNoFence((void**)&Lookup->Retired) != NULL) {
+        //
+        // The epoch moved on while this reader was active, so it may have been
+        // the last one holding back reclamation. Writers don't wait for that,
+        // so finish it here.
+        //
+        CxPlatDispatchRwLockAcquireExclusive(&Lookup->RwLock, PrevIrql);
+        QUIC_LOOKUP_RETIRED* Reclaimed = QuicLookupTryReclaim(Lookup);
+        CxPlatDispatchRwLockReleaseExclusive(&Lookup->RwLock, PrevIrql);
+        QuicLookupFreeRetired(Reclaimed);
+    }
+
+#if QUIC_DEBUG_HASHTABLE_LOOKUP
+    if (Connection != NULL) {
+        QuicTraceLogVerbose(
+            LookupCidFound,
+            "[look][%p] Lookup Hash=%u found %p",
+            Lookup,
+            Hash,
+            Connection);
+    } else {
+        QuicTraceLogVerbose(
+            LookupCidNotFound,
+            "[look][%p] Lookup Hash=%u not found",
+            Lookup,
+            Hash);
+    }
+#endif
+
+    return Connection;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -634,6 +1134,18 @@ QuicLookupFindConnectionByLocalCid(
 {
     uint32_t Hash = CxPlatHashSimple(CIDLen, CID);
 
+    QUIC_PARTITIONED_HASHTABLE* LockFreeTables =
+        (QUIC_PARTITIONED_HASHTABLE*)QuicReadPtrNoFence((void**)&Lookup->LockFreeTables);
+    if (LockFreeTables != NULL) {
+        return
+            QuicLookupFindConnectionByLocalCidLockFree(
+                Lookup,
+                LockFreeTables,
+                CID,
+                CIDLen,
+                Hash);
+    }
+
     CxPlatDispatchRwLockAcquireShared(&Lookup->RwLock, PrevIrql);
 
     QUIC_CONNECTION* ExistingConnection =
@@ -759,7 +1271,9 @@ QuicLookupAddLocalCid(
         }
     }
 
+    QUIC_LOOKUP_RETIRED* Reclaimed = QuicLookupTryReclaim(Lookup);
     CxPlatDispatchRwLockReleaseExclusive(&Lookup->RwLock, PrevIrql);
+    QuicLookupFreeRetired(Reclaimed);
 
     return Result;
 }
@@ -826,12 +1340,17 @@ QuicLookupRemoveLocalCid(
     _In_ CXPLAT_SLIST_ENTRY** Entry
     )
 {
+    QUIC_CONNECTION* Connection = SourceCid->Connection;
     CxPlatDispatchRwLockAcquireExclusive(&Lookup->RwLock, PrevIrql);
-    QuicLookupRemoveLocalCidInt(Lookup, SourceCid);
+    const BOOLEAN ReleaseRef = QuicLookupRemoveLocalCidInt(Lookup, SourceCid);
     SourceCid->CID.IsInLookupTable = FALSE;
     *Entry = (*Entry)->Next;
+    QUIC_LOOKUP_RETIRED* Reclaimed = QuicLookupTryReclaim(Lookup);
     CxPlatDispatchRwLockReleaseExclusive(&Lookup->RwLock, PrevIrql);
-    QuicConnRelease(SourceCid->Connection, QUIC_CONN_REF_LOOKUP_TABLE);
+    QuicLookupFreeRetired(Reclaimed);
+    if (ReleaseRef) {
+        QuicConnRelease(Connection, QUIC_CONN_REF_LOOKUP_TABLE);
+    }
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -876,13 +1395,16 @@ QuicLookupRemoveLocalCids(
                 QUIC_CID_HASH_ENTRY,
                 Link);
         if (CID->CID.IsInLookupTable) {
-            QuicLookupRemoveLocalCidInt(Lookup, CID);
+            if (QuicLookupRemoveLocalCidInt(Lookup, CID)) {
+                ReleaseRefCount++;
+            }
             CID->CID.IsInLookupTable = FALSE;
-            ReleaseRefCount++;
         }
         CXPLAT_FREE(CID, QUIC_POOL_CIDHASH);
     }
+    QUIC_LOOKUP_RETIRED* Reclaimed = QuicLookupTryReclaim(Lookup);
     CxPlatDispatchRwLockReleaseExclusive(&Lookup->RwLock, PrevIrql);
+    QuicLookupFreeRetired(Reclaimed);
 
     for (uint8_t i = 0; i < ReleaseRefCount; i++) {
 #pragma prefast(suppress:6001, "SAL doesn't understand ref counts")
@@ -899,6 +1421,7 @@ QuicLookupMoveLocalConnectionIDs(
     )
 {
     CXPLAT_SLIST_ENTRY* Entry = Connection->SourceCids.Next;
+    uint8_t ReleaseRefCount = 0;
 
     CxPlatDispatchRwLockAcquireExclusive(&LookupSrc->RwLock, PrevIrql1);
     while (Entry != NULL) {
@@ -907,13 +1430,19 @@ QuicLookupMoveLocalConnectionIDs(
                 Entry,
                 QUIC_CID_HASH_ENTRY,
                 Link);
-        if (CID->CID.IsInLookupTable) {
-            QuicLookupRemoveLocalCidInt(LookupSrc, CID);
-            QuicConnRelease(Connection, QUIC_CONN_REF_LOOKUP_TABLE);
+        if (CID->CID.IsInLookupTable &&
+            QuicLookupRemoveLocalCidInt(LookupSrc, CID)) {
+            ReleaseRefCount++;
         }
         Entry = Entry->Next;
     }
+    QUIC_LOOKUP_RETIRED* Reclaimed = QuicLookupTryReclaim(LookupSrc);
     CxPlatDispatchRwLockReleaseExclusive(&LookupSrc->RwLock, PrevIrql1);
+    QuicLookupFreeRetired(Reclaimed);
+
+    for (uint8_t i = 0; i < ReleaseRefCount; i++) {
+        QuicConnRelease(Connection, QUIC_CONN_REF_LOOKUP_TABLE);
+    }
 
     CxPlatDispatchRwLockAcquireExclusive(&LookupDest->RwLock, PrevIrql2);
 #pragma prefast(suppress:6001, "SAL doesn't understand ref counts")
@@ -5,7 +5,22 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 typedef struct QUIC_PARTITIONED_HASHTABLE QUIC_PARTITIONED_HASHTABLE;
+typedef struct QUIC_LOOKUP_RETIRED QUIC_LOOKUP_RETIRED;
+
+//
+// Per-processor count of active lock-free readers, indexed by the parity of
+// the reader epoch they observed when they started.
+//
+typedef struct QUIC_CACHEALIGN QUIC_LOOKUP_READER {
+
+    long Count[2];
+
+} QUIC_LOOKUP_READER;
 
 typedef struct QUIC_REMOTE_HASH_ENTRY {
 
@@ -69,6 +84,25 @@ typedef struct QUIC_LOOKUP {
     //
     CXPLAT_HASHTABLE RemoteHashTable;
 
+    //
+    // Lock-free local CID reads. Enabled when partitioning is maximized, at
+    // which point LockFreeTables is published (equal to HASH.Tables) and local
+    // CID lookups no longer take any lock. Instead, readers announce
+    // themselves in a per-processor counter for the current ReaderEpoch, and
+    // writers (still serialized by RwLock) defer freeing unlinked memory, and
+    // releasing the connection references it held, until all readers that
+    // could have seen it are gone. Neither side ever waits on the other.
+    //
+    QUIC_PARTITIONED_HASHTABLE* LockFreeTables;
+    QUIC_LOOKUP_READER* Readers;
+    uint32_t ReaderCount;
+    volatile long ReaderEpoch;
+
+    //
+    // Memory unlinked from the lock-free tables, waiting to be freed.
+    //
+    QUIC_LOOKUP_RETIRED* Retired;
+
 } QUIC_LOOKUP;
 
 //
@@ -200,3 +234,7 @@ QuicLookupMoveLocalConnectionIDs(
     _In_ QUIC_LOOKUP* LookupDest,
     _In_ QUIC_CONNECTION* Connection
     );
+
+#if defined(__cplusplus)
+}
+#endif
@@ -95,23 +95,29 @@ QuicLossValidate(
     )
 {
     uint32_t AckElicitingPackets = 0;
-    QUIC_SENT_PACKET_METADATA** Tail = &LossDetection->SentPackets;
-    while (*Tail) {
-        CXPLAT_DBG_ASSERT(!(*Tail)->Flags.Freed);
-        if ((*Tail)->Flags.IsAckEliciting) {
+    QUIC_SENT_PACKET_CURSOR Cursor;
+    QUIC_SENT_PACKET_METADATA* Packet;
+    QUIC_SENT_PACKET_METADATA* LastPacket = NULL;
+    for (Packet = QuicSentPacketStoreFirst(&LossDetection->SentPackets, &Cursor);
+         Packet != NULL;
+         Packet = QuicSentPacketStoreNext(&LossDetection->SentPackets, &Cursor)) {
+        CXPLAT_DBG_ASSERT(!Packet->Flags.Freed);
+        if (Packet->Flags.IsAckEliciting) {
             AckElicitingPackets++;
         }
-        Tail = &((*Tail)->Next);
+        LastPacket = Packet;
     }
-    CXPLAT_DBG_ASSERT(Tail == LossDetection->SentPacketsTail);
+    CXPLAT_DBG_ASSERT(LastPacket == QuicSentPacketStoreLast(&LossDetection->SentPackets));
     CXPLAT_DBG_ASSERT(LossDetection->PacketsInFlight == AckElicitingPackets);
 
-    Tail = &LossDetection->LostPackets;
-    while (*Tail) {
-        CXPLAT_DBG_ASSERT(!(*Tail)->Flags.Freed);
-        Tail = &((*Tail)->Next);
+    LastPacket = NULL;
+    for (Packet = QuicSentPacketStoreFirst(&LossDetection->LostPackets, &Cursor);
+         Packet != NULL;
+         Packet = QuicSentPacketStoreNext(&LossDetection->LostPackets, &Cursor)) {
+        CXPLAT_DBG_ASSERT(!Packet->Flags.Freed);
+        LastPacket = Packet;
     }
-    CXPLAT_DBG_ASSERT(Tail == LossDetection->LostPacketsTail);
+    CXPLAT_DBG_ASSERT(LastPacket == QuicSentPacketStoreLast(&LossDetection->LostPackets));
 }
 #else
 #define QuicLossValidate(LossDetection)
@@ -123,10 +129,8 @@ QuicLossDetectionInitialize(
     _Inout_ QUIC_LOSS_DETECTION* LossDetection
     )
 {
-    LossDetection->SentPackets = NULL;
-    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
-    LossDetection->LostPackets = NULL;
-    LossDetection->LostPacketsTail = &LossDetection->LostPackets;
+    QuicSentPacketStoreInitialize(&LossDetection->SentPackets);
+    QuicSentPacketStoreInitialize(&LossDetection->LostPackets);
     QuicLossDetectionInitializeInternalState(LossDetection);
 }
 
@@ -137,10 +141,11 @@ QuicLossDetectionUninitialize(
     )
 {
     QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
+    QUIC_SENT_PACKET_CURSOR Cursor;
+    QUIC_SENT_PACKET_METADATA* Packet;
 
-    while (LossDetection->SentPackets != NULL) {
-        QUIC_SENT_PACKET_METADATA* Packet = LossDetection->SentPackets;
-        LossDetection->SentPackets = LossDetection->SentPackets->Next;
+    while ((Packet = QuicSentPacketStoreFirst(&LossDetection->SentPackets, &Cursor)) != NULL) {
+        QuicSentPacketStoreRemove(&LossDetection->SentPackets, &Cursor);
 
         if (Packet->Flags.IsAckEliciting) {
             QuicTraceLogVerbose(
@@ -153,9 +158,8 @@ QuicLossDetectionUninitialize(
 
         QuicLossDetectionOnPacketDiscarded(LossDetection, Packet, FALSE);
     }
-    while (LossDetection->LostPackets != NULL) {
-        QUIC_SENT_PACKET_METADATA* Packet = LossDetection->LostPackets;
-        LossDetection->LostPackets = LossDetection->LostPackets->Next;
+    while ((Packet = QuicSentPacketStoreFirst(&LossDetection->LostPackets, &Cursor)) != NULL) {
+        QuicSentPacketStoreRemove(&LossDetection->LostPackets, &Cursor);
 
         QuicTraceLogVerbose(
             PacketTxLostDiscarded,
@@ -165,6 +169,9 @@ QuicLossDetectionUninitialize(
 
         QuicLossDetectionOnPacketDiscarded(LossDetection, Packet, FALSE);
     }
+
+    QuicSentPacketStoreUninitialize(&LossDetection->SentPackets);
+    QuicSentPacketStoreUninitialize(&LossDetection->LostPackets);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -174,6 +181,8 @@ QuicLossDetectionReset(
     )
 {
     QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
+    QUIC_SENT_PACKET_CURSOR Cursor;
+    QUIC_SENT_PACKET_METADATA* Packet;
 
     QuicConnTimerCancel(Connection, QUIC_CONN_TIMER_LOSS_DETECTION);
 
@@ -186,19 +195,15 @@ QuicLossDetectionReset(
     // Throw away any outstanding packets.
     //
 
-    while (LossDetection->SentPackets != NULL) {
-        QUIC_SENT_PACKET_METADATA* Packet = LossDetection->SentPackets;
-        LossDetection->SentPackets = LossDetection->SentPackets->Next;
+    while ((Packet = QuicSentPacketStoreFirst(&LossDetection->SentPackets, &Cursor)) != NULL) {
+        QuicSentPacketStoreRemove(&LossDetection->SentPackets, &Cursor);
         QuicLossDetectionRetransmitFrames(LossDetection, Packet, TRUE);
     }
-    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
 
-    while (LossDetection->LostPackets != NULL) {
-        QUIC_SENT_PACKET_METADATA* Packet = LossDetection->LostPackets;
-        LossDetection->LostPackets = LossDetection->LostPackets->Next;
+    while ((Packet = QuicSentPacketStoreFirst(&LossDetection->LostPackets, &Cursor)) != NULL) {
+        QuicSentPacketStoreRemove(&LossDetection->LostPackets, &Cursor);
         QuicLossDetectionRetransmitFrames(LossDetection, Packet, TRUE);
     }
-    LossDetection->LostPacketsTail = &LossDetection->LostPackets;
 
     QuicLossValidate(LossDetection);
 }
@@ -214,9 +219,11 @@ QuicLossDetectionOldestOutstandingPacket(
     _In_ QUIC_LOSS_DETECTION* LossDetection
     )
 {
-    QUIC_SENT_PACKET_METADATA* Packet = LossDetection->SentPackets;
+    QUIC_SENT_PACKET_CURSOR Cursor;
+    QUIC_SENT_PACKET_METADATA* Packet =
+        QuicSentPacketStoreFirst(&LossDetection->SentPackets, &Cursor);
     while (Packet != NULL && !Packet->Flags.IsAckEliciting) {
-        Packet = Packet->Next;
+        Packet = QuicSentPacketStoreNext(&LossDetection->SentPackets, &Cursor);
     }
     return Packet;
 }
@@ -419,14 +426,18 @@ QuicLossDetectionOnPacketSent(
         sizeof(QUIC_SENT_PACKET_METADATA) +
         sizeof(QUIC_SENT_FRAME_METADATA) * TempSentPacket->FrameCount);
 
-    LossDetection->LargestSentPacketNumber = TempSentPacket->PacketNumber;
-
     //
     // Add to the outstanding-packet queue.
     //
-    SentPacket->Next = NULL;
-    *LossDetection->SentPacketsTail = SentPacket;
-    LossDetection->SentPacketsTail = &SentPacket->Next;
+    if (!QuicSentPacketStoreInsert(&LossDetection->SentPackets, SentPacket)) {
+        //
+        // Same as above, but the metadata copy must be freed too.
+        //
+        QuicLossDetectionRetransmitFrames(LossDetection, SentPacket, TRUE);
+        return;
+    }
+
+    LossDetection->LargestSentPacketNumber = TempSentPacket->PacketNumber;
 
     CXPLAT_DBG_ASSERT(
         SentPacket->Flags.KeyType != QUIC_PACKET_KEY_0_RTT ||
@@ -456,8 +467,11 @@ QuicLossDetectionOnPacketSent(
     uint64_t SendPostedBytes = Connection->SendBuffer.PostedBytes;
 
     CXPLAT_LIST_ENTRY* Entry = Connection->Send.SendStreams.Flink;
+    if (Entry == &Connection->Send.SendStreams) {
+        Entry = Connection->Send.BlockedSendStreams.Flink;
+    }
     QUIC_STREAM* Stream =
-        (Entry != &(Connection->Send.SendStreams)) ?
+        (Entry != &(Connection->Send.BlockedSendStreams)) ?
           CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink) :
           NULL;
 
@@ -914,9 +928,10 @@ QuicLossDetectionDetectAndHandleLostPackets(
 {
     QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
     uint32_t LostRetransmittableBytes = 0;
+    QUIC_SENT_PACKET_CURSOR Cursor;
     QUIC_SENT_PACKET_METADATA* Packet;
 
-    if (LossDetection->LostPackets != NULL) {
+    if (!QuicSentPacketStoreIsEmpty(&LossDetection->LostPackets)) {
         //
         // Clean out any packets in the LostPackets list that we are pretty
         // confident will never be acknowledged.
@@ -926,7 +941,7 @@ QuicLossDetectionDetectAndHandleLostPackets(
                 LossDetection,
                 &Connection->Paths[0], // TODO - Is this right?
                 2);
-        while ((Packet = LossDetection->LostPackets) != NULL &&
+        while ((Packet = QuicSentPacketStoreFirst(&LossDetection->LostPackets, &Cursor)) != NULL &&
                 Packet->PacketNumber < LossDetection->LargestAck &&
                 CxPlatTimeDiff64(Packet->SentTime, TimeNow) > TwoPto) {
             QuicTraceLogVerbose(
@@ -934,17 +949,14 @@ QuicLossDetectionDetectAndHandleLostPackets(
                 "[%c][TX][%llu] Forgetting",
                 PtkConnPre(Connection),
                 Packet->PacketNumber);
-            LossDetection->LostPackets = Packet->Next;
+            QuicSentPacketStoreRemove(&LossDetection->LostPackets, &Cursor);
             QuicLossDetectionOnPacketDiscarded(LossDetection, Packet, TRUE);
         }
-        if (LossDetection->LostPackets == NULL) {
-            LossDetection->LostPacketsTail = &LossDetection->LostPackets;
-        }
 
         QuicLossValidate(LossDetection);
     }
 
-    if (LossDetection->SentPackets != NULL) {
+    if (!QuicSentPacketStoreIsEmpty(&LossDetection->SentPackets)) {
         //
         // Remove "suspect" packets inferred lost from out-of-order ACKs.
         // The spec has:
@@ -957,8 +969,7 @@ QuicLossDetectionDetectAndHandleLostPackets(
         uint64_t Rtt = CXPLAT_MAX(Path->SmoothedRtt, Path->LatestRttSample);
         uint64_t TimeReorderThreshold = QUIC_TIME_REORDER_THRESHOLD(Rtt);
         uint64_t LargestLostPacketNumber = 0;
-        QUIC_SENT_PACKET_METADATA* PrevPacket = NULL;
-        Packet = LossDetection->SentPackets;
+        Packet = QuicSentPacketStoreFirst(&LossDetection->SentPackets, &Cursor);
         while (Packet != NULL) {
 
             BOOLEAN NonretransmittableHandshakePacket =
@@ -968,8 +979,7 @@ QuicLossDetectionDetectAndHandleLostPackets(
                 QuicKeyTypeToEncryptLevel(Packet->Flags.KeyType);
 
             if (EncryptLevel > LossDetection->LargestAckEncryptLevel) {
-                PrevPacket = Packet;
-                Packet = Packet->Next;
+                Packet = QuicSentPacketStoreNext(&LossDetection->SentPackets, &Cursor);
                 continue;
             }
 
@@ -1020,22 +1030,16 @@ QuicLossDetectionDetectAndHandleLostPackets(
             }
 
             LargestLostPacketNumber = Packet->PacketNumber;
-            if (PrevPacket == NULL) {
-                LossDetection->SentPackets = Packet->Next;
-                if (Packet->Next == NULL) {
-                    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
-                }
-            } else {
-                PrevPacket->Next = Packet->Next;
-                if (Packet->Next == NULL) {
-                    LossDetection->SentPacketsTail = &PrevPacket->Next;
-                }
-            }
+            QUIC_SENT_PACKET_METADATA* NextPacket =
+                QuicSentPacketStoreRemove(&LossDetection->SentPackets, &Cursor);
 
-            *LossDetection->LostPacketsTail = Packet;
-            LossDetection->LostPacketsTail = &Packet->Next;
-            Packet = Packet->Next;
-            *LossDetection->LostPacketsTail = NULL;
+            if (!QuicSentPacketStoreInsert(&LossDetection->LostPackets, Packet)) {
+                //
+                // Can't remember the packet, so just forget it right away.
+                //
+                QuicLossDetectionOnPacketDiscarded(LossDetection, Packet, TRUE);
+            }
+            Packet = NextPacket;
         }
 
         QuicLossValidate(LossDetection);
@@ -1079,7 +1083,7 @@ QuicLossDetectionDiscardPackets(
 {
     QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
     QUIC_ENCRYPT_LEVEL EncryptLevel = QuicKeyTypeToEncryptLevel(KeyType);
-    QUIC_SENT_PACKET_METADATA* PrevPacket;
+    QUIC_SENT_PACKET_CURSOR Cursor;
     QUIC_SENT_PACKET_METADATA* Packet;
     uint32_t AckedRetransmittableBytes = 0;
     uint64_t TimeNow = CxPlatTimeUs64();
@@ -1090,23 +1094,11 @@ QuicLossDetectionDiscardPackets(
     // Implicitly ACK all outstanding packets.
     //
 
-    PrevPacket = NULL;
-    Packet = LossDetection->LostPackets;
+    Packet = QuicSentPacketStoreFirst(&LossDetection->LostPackets, &Cursor);
     while (Packet != NULL) {
-        QUIC_SENT_PACKET_METADATA* NextPacket = Packet->Next;
-
         if (Packet->Flags.KeyType == KeyType) {
-            if (PrevPacket != NULL) {
-                PrevPacket->Next = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->LostPacketsTail = &PrevPacket->Next;
-                }
-            } else {
-                LossDetection->LostPackets = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->LostPacketsTail = &LossDetection->LostPackets;
-                }
-            }
+            QUIC_SENT_PACKET_METADATA* NextPacket =
+                QuicSentPacketStoreRemove(&LossDetection->LostPackets, &Cursor);
 
             QuicTraceLogVerbose(
                 PacketTxAckedImplicit,
@@ -1127,30 +1119,17 @@ QuicLossDetectionDiscardPackets(
             Packet = NextPacket;
 
         } else {
-            PrevPacket = Packet;
-            Packet = NextPacket;
+            Packet = QuicSentPacketStoreNext(&LossDetection->LostPackets, &Cursor);
         }
     }
 
     QuicLossValidate(LossDetection);
 
-    PrevPacket = NULL;
-    Packet = LossDetection->SentPackets;
+    Packet = QuicSentPacketStoreFirst(&LossDetection->SentPackets, &Cursor);
     while (Packet != NULL) {
-        QUIC_SENT_PACKET_METADATA* NextPacket = Packet->Next;
-
         if (Packet->Flags.KeyType == KeyType) {
-            if (PrevPacket != NULL) {
-                PrevPacket->Next = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->SentPacketsTail = &PrevPacket->Next;
-                }
-            } else {
-                LossDetection->SentPackets = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
-                }
-            }
+            QUIC_SENT_PACKET_METADATA* NextPacket =
+                QuicSentPacketStoreRemove(&LossDetection->SentPackets, &Cursor);
 
             QuicTraceLogVerbose(
                 PacketTxAckedImplicit,
@@ -1176,8 +1155,7 @@ QuicLossDetectionDiscardPackets(
             Packet = NextPacket;
 
         } else {
-            PrevPacket = Packet;
-            Packet = NextPacket;
+            Packet = QuicSentPacketStoreNext(&LossDetection->SentPackets, &Cursor);
         }
     }
 
@@ -1219,7 +1197,7 @@ QuicLossDetectionOnZeroRttRejected(
     )
 {
     QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
-    QUIC_SENT_PACKET_METADATA* PrevPacket;
+    QUIC_SENT_PACKET_CURSOR Cursor;
     QUIC_SENT_PACKET_METADATA* Packet;
     uint32_t CountRetransmittableBytes = 0;
 
@@ -1227,23 +1205,11 @@ QuicLossDetectionOnZeroRttRejected(
     // Marks all the packets as lost so they can be retransmitted immediately.
     //
 
-    PrevPacket = NULL;
-    Packet = LossDetection->SentPackets;
+    Packet = QuicSentPacketStoreFirst(&LossDetection->SentPackets, &Cursor);
     while (Packet != NULL) {
-        QUIC_SENT_PACKET_METADATA* NextPacket = Packet->Next;
-
         if (Packet->Flags.KeyType == QUIC_PACKET_KEY_0_RTT) {
-            if (PrevPacket != NULL) {
-                PrevPacket->Next = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->SentPacketsTail = &PrevPacket->Next;
-                }
-            } else {
-                LossDetection->SentPackets = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
-                }
-            }
+            QUIC_SENT_PACKET_METADATA* NextPacket =
+                QuicSentPacketStoreRemove(&LossDetection->SentPackets, &Cursor);
 
             QuicTraceLogVerbose(
                 PacketTx0RttRejected,
@@ -1261,8 +1227,7 @@ QuicLossDetectionOnZeroRttRejected(
             Packet = NextPacket;
 
         } else {
-            PrevPacket = Packet;
-            Packet = NextPacket;
+            Packet = QuicSentPacketStoreNext(&LossDetection->SentPackets, &Cursor);
         }
     }
 
@@ -1307,9 +1272,12 @@ QuicLossDetectionProcessAckBlocks(
 
     *InvalidAckBlock = FALSE;
 
-    QUIC_SENT_PACKET_METADATA** LostPacketsStart = &LossDetection->LostPackets;
-    QUIC_SENT_PACKET_METADATA** SentPacketsStart = &LossDetection->SentPackets;
+    QUIC_SENT_PACKET_CURSOR LostCursor;
+    QUIC_SENT_PACKET_CURSOR SentCursor;
+    QuicSentPacketStoreFirst(&LossDetection->LostPackets, &LostCursor);
+    QuicSentPacketStoreFirst(&LossDetection->SentPackets, &SentCursor);
     QUIC_SENT_PACKET_METADATA* LargestAckedPacket = NULL;
+    QUIC_SENT_PACKET_METADATA* AckedPacket;
 
     uint32_t i = 0;
     QUIC_SUBRANGE* AckBlock;
@@ -1335,25 +1303,23 @@ QuicLossDetectionProcessAckBlocks(
         // Check to see if any packets in the LostPackets list are acknowledged,
         // which would mean we mistakenly classified those packets as lost.
         //
-        if (*LostPacketsStart != NULL) {
+        if (!QuicSentPacketStoreIsEmpty(&LossDetection->LostPackets)) {
             QUIC_SENT_PACKET_METADATA* LastLostPacket =
-                CXPLAT_CONTAINING_RECORD(
-                    LossDetection->LostPacketsTail, QUIC_SENT_PACKET_METADATA,
-                    Next);
+                QuicSentPacketStoreLast(&LossDetection->LostPackets);
             if (LastLostPacket->PacketNumber < AckBlock->Low) {
                 goto CheckSentPackets;
             }
-            while (*LostPacketsStart && (*LostPacketsStart)->PacketNumber < AckBlock->Low) {
-                LostPacketsStart = &((*LostPacketsStart)->Next);
-            }
 
-            QUIC_SENT_PACKET_METADATA** End = LostPacketsStart;
-            while (*End && (*End)->PacketNumber <= QuicRangeGetHigh(AckBlock)) {
+            AckedPacket =
+                QuicSentPacketStoreSeek(
+                    &LossDetection->LostPackets, &LostCursor, AckBlock->Low);
+            while (AckedPacket != NULL &&
+                   AckedPacket->PacketNumber <= QuicRangeGetHigh(AckBlock)) {
                 QuicTraceLogVerbose(
                     PacketTxSpuriousLoss,
                     "[%c][TX][%llu] Spurious loss detected",
                     PtkConnPre(Connection),
-                    (*End)->PacketNumber);
+                    AckedPacket->PacketNumber);
                 Connection->Stats.Send.SpuriousLostPackets++;
                 QuicPerfCounterDecrement(
                     Connection->Partition, QUIC_PERF_COUNTER_PKTS_SUSPECTED_LOST);
@@ -1362,22 +1328,15 @@ QuicLossDetectionProcessAckBlocks(
                 // because we already told the congestion control module that
                 // this packet left the network.
                 //
-                End = &((*End)->Next);
+                *AckedPacketsTail = AckedPacket;
+                AckedPacketsTail = &AckedPacket->Next;
+                AckedPacket =
+                    QuicSentPacketStoreRemove(&LossDetection->LostPackets, &LostCursor);
             }
 
-            if (LostPacketsStart != End) {
-                *AckedPacketsTail = *LostPacketsStart;
-                AckedPacketsTail = End;
-                *LostPacketsStart = *End;
-                *End = NULL;
-                if (End == LossDetection->LostPacketsTail) {
-                    LossDetection->LostPacketsTail = LostPacketsStart;
-                }
-
-                QuicLossValidate(LossDetection);
-            }
+            QuicLossValidate(LossDetection);
 
-            if (LossDetection->LostPackets == NULL) {
+            if (QuicSentPacketStoreIsEmpty(&LossDetection->LostPackets)) {
                 //
                 // All previously considered lost packets were found to be
                 // spuriously lost. Inform congestion control.
@@ -1394,40 +1353,28 @@ QuicLossDetectionProcessAckBlocks(
 
 CheckSentPackets:
         //
-        // Now find all the acknowledged packets in the SentPackets list.
+        // Now find all the acknowledged packets in the SentPackets list, and
+        // remove them from the outstanding packet list.
         //
-        if (*SentPacketsStart != NULL) {
-            while (*SentPacketsStart && (*SentPacketsStart)->PacketNumber < AckBlock->Low) {
-                SentPacketsStart = &((*SentPacketsStart)->Next);
-            }
-
-            QUIC_SENT_PACKET_METADATA** End = SentPacketsStart;
-            while (*End && (*End)->PacketNumber <= QuicRangeGetHigh(AckBlock)) {
-
-                if ((*End)->Flags.IsAckEliciting) {
-                    LossDetection->PacketsInFlight--;
-                    AckedRetransmittableBytes += (*End)->PacketLength;
-                }
-                LargestAckedPacket = *End;
-                End = &((*End)->Next);
-            }
+        AckedPacket =
+            QuicSentPacketStoreSeek(
+                &LossDetection->SentPackets, &SentCursor, AckBlock->Low);
+        while (AckedPacket != NULL &&
+               AckedPacket->PacketNumber <= QuicRangeGetHigh(AckBlock)) {
 
-            if (SentPacketsStart != End) {
-                //
-                // Remove the ACKed packets from the outstanding packet list.
-                //
-                *AckedPacketsTail = *SentPacketsStart;
-                AckedPacketsTail = End;
-                *SentPacketsStart = *End;
-                *End = NULL;
-                if (End == LossDetection->SentPacketsTail) {
-                    LossDetection->SentPacketsTail = SentPacketsStart;
-                }
-
-                QuicLossValidate(LossDetection);
+            if (AckedPacket->Flags.IsAckEliciting) {
+                LossDetection->PacketsInFlight--;
+                AckedRetransmittableBytes += AckedPacket->PacketLength;
             }
+            LargestAckedPacket = AckedPacket;
+            *AckedPacketsTail = AckedPacket;
+            AckedPacketsTail = &AckedPacket->Next;
+            AckedPacket =
+                QuicSentPacketStoreRemove(&LossDetection->SentPackets, &SentCursor);
         }
 
+        QuicLossValidate(LossDetection);
+
         if (LargestAckedPacket != NULL &&
             LossDetection->LargestAck <= LargestAckedPacket->PacketNumber) {
             LossDetection->LargestAck = LargestAckedPacket->PacketNumber;
@@ -1441,6 +1388,8 @@ CheckSentPackets:
         }
     }
 
+    *AckedPacketsTail = NULL;
+
     if (AckedPackets == NULL) {
         //
         // Nothing was acknowledged, so we can exit now.
@@ -1531,8 +1480,18 @@ CheckSentPackets:
             BOOLEAN EcnValidated = TRUE;
             int64_t EctCeDeltaSum = 0;
             if (Ecn != NULL) {
+                //
+                // In L4S mode all packets are sent with ECT(1), so the ECT(1)
+                // count is the one that must track what was sent and the
+                // ECT(0) count must stay zero.
+                //
+                const BOOLEAN L4sEnabled = Connection->CongestionControl.L4sEnabled;
+                const uint64_t SentEctCount =
+                    L4sEnabled ? Ecn->ECT_1_Count : Ecn->ECT_0_Count;
+                const uint64_t OtherEctCount =
+                    L4sEnabled ? Ecn->ECT_0_Count : Ecn->ECT_1_Count;
                 EctCeDeltaSum += Ecn->CE_Count - Packets->EcnCeCounter;
-                EctCeDeltaSum += Ecn->ECT_0_Count - Packets->EcnEctCounter;
+                EctCeDeltaSum += SentEctCount - Packets->EcnEctCounter;
                 //
                 // Conditions where ECN validation fails:
                 // 1. Reneging ECN counts from the peer.
@@ -1540,13 +1499,16 @@ CheckSentPackets:
                 //
                 if (EctCeDeltaSum < 0 ||
                     EctCeDeltaSum < EcnEctCounter ||
-                    Ecn->ECT_1_Count != 0 ||
-                    Connection->Send.NumPacketsSentWithEct < Ecn->ECT_0_Count) {
+                    OtherEctCount != 0 ||
+                    Connection->Send.NumPacketsSentWithEct < SentEctCount) {
                     EcnValidated = FALSE;
                 } else {
-                    BOOLEAN NewCE = Ecn->CE_Count > Packets->EcnCeCounter;
+                    uint64_t NewCeCount =
+                        Ecn->CE_Count > Packets->EcnCeCounter ?
+                            Ecn->CE_Count - Packets->EcnCeCounter : 0;
                     Packets->EcnCeCounter = Ecn->CE_Count;
-                    Packets->EcnEctCounter = Ecn->ECT_0_Count;
+                    Packets->EcnEctCounter = SentEctCount;
+                    Connection->Stats.Send.EcnCePackets += NewCeCount;
                     if (Path->EcnValidationState <= ECN_VALIDATION_UNKNOWN) {
                         Path->EcnValidationState = ECN_VALIDATION_CAPABLE;
                         QuicTraceEvent(
@@ -1557,10 +1519,11 @@ CheckSentPackets:
                     }
 
                     if (Path->EcnValidationState == ECN_VALIDATION_CAPABLE &&
-                        NewCE) {
+                        NewCeCount != 0) {
                         QUIC_ECN_EVENT EcnEvent = {
                             .LargestPacketNumberAcked = LargestAckedPacketNum,
                             .LargestSentPacketNumber = LossDetection->LargestSentPacketNumber,
+                            .NewCeCount = NewCeCount,
                         };
                         QuicCongestionControlOnEcn(&Connection->CongestionControl, &EcnEvent);
                     }
@@ -1608,12 +1571,13 @@ CheckSentPackets:
             .SmoothedRtt = Path->SmoothedRtt,
             .MinRtt = MinRtt,
             .OneWayDelay = Path->OneWayDelay,
-            .HasLoss = (LossDetection->LostPackets != NULL),
+            .HasLoss = !QuicSentPacketStoreIsEmpty(&LossDetection->LostPackets),
             .AdjustedAckTime = TimeNow - AckDelay,
             .AckedPackets = AckedPackets,
             .NumTotalAckedRetransmittableBytes = LossDetection->TotalBytesAcked,
             .IsLargestAckedPacketAppLimited = IsLargestAckedPacketAppLimited,
             .MinRttValid = TRUE,
+            .NumEcnEctPacketsAcked = (uint32_t)EcnEctCounter,
         };
 
         if (QuicCongestionControlOnDataAcknowledged(&Connection->CongestionControl, &AckEvent)) {
@@ -1769,7 +1733,9 @@ QuicLossDetectionScheduleProbe(
     // Not enough new stream data exists to fill the probing packets. Schedule
     // retransmits if possible.
     //
-    QUIC_SENT_PACKET_METADATA* Packet = LossDetection->SentPackets;
+    QUIC_SENT_PACKET_CURSOR Cursor;
+    QUIC_SENT_PACKET_METADATA* Packet =
+        QuicSentPacketStoreFirst(&LossDetection->SentPackets, &Cursor);
     while (Packet != NULL) {
         if (Packet->Flags.IsAckEliciting) {
             QuicTraceLogVerbose(
@@ -1789,7 +1755,7 @@ QuicLossDetectionScheduleProbe(
                 return;
             }
         }
-        Packet = Packet->Next;
+        Packet = QuicSentPacketStoreNext(&LossDetection->SentPackets, &Cursor);
     }
 
     //
@@ -63,15 +63,15 @@ typedef struct QUIC_LOSS_DETECTION {
     // numbers than those in the SentPackets list. The only case this is not
     // true is during the handshake. Since multiple encryption levels are used
     // in parallel, higher numbered packets in lower encryption levels can be
-    // "lost" sooner than the higher encryption levels.
+    // "lost" sooner than the higher encryption levels. (With
+    // QUIC_SENT_PACKET_RING, both are always in packet number order.)
     //
 
     //
     // Outstanding packets.
     //
     uint64_t LargestSentPacketNumber;
-    QUIC_SENT_PACKET_METADATA* SentPackets;
-    QUIC_SENT_PACKET_METADATA** SentPacketsTail;
+    QUIC_SENT_PACKET_STORE SentPackets;
 
     //
     // Lost packets. The purpose of this list is to remember packets a little
@@ -79,8 +79,7 @@ typedef struct QUIC_LOSS_DETECTION {
     // comes in later than expected. For accounting purposes we don't consider
     // these packets to be in the network.
     //
-    QUIC_SENT_PACKET_METADATA* LostPackets;
-    QUIC_SENT_PACKET_METADATA** LostPacketsTail;
+    QUIC_SENT_PACKET_STORE LostPackets;
 
     //
     // Number of probes sent.
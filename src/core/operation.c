@@ -210,6 +210,40 @@ QuicOperationEnqueueFront(
     return StartProcessing;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicOperationCoalesceStreamSend(
+    _In_ QUIC_OPERATION_QUEUE* OperQ,
+    _In_ QUIC_PARTITION* Partition,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    BOOLEAN Coalesced = FALSE;
+    CxPlatDispatchLockAcquire(&OperQ->Lock);
+    //
+    // Only the tail operation is considered, so the stream's sends keep their
+    // order relative to every other operation queued on the connection. A
+    // priority operation is left alone so normal sends don't jump ahead.
+    //
+    if (!CxPlatListIsEmpty(&OperQ->List) &&
+        OperQ->PriorityTail != &OperQ->List.Blink->Flink) {
+        QUIC_OPERATION* Tail =
+            CXPLAT_CONTAINING_RECORD(OperQ->List.Blink, QUIC_OPERATION, Link);
+        if (Tail->Type == QUIC_OPER_TYPE_API_CALL &&
+            Tail->API_CALL.Context->Type == QUIC_API_TYPE_STRM_SEND) {
+            CXPLAT_DBG_ASSERT(Stream->ApiSendNext == NULL);
+            Tail->API_CALL.Context->STRM_SEND.LastStream->ApiSendNext = Stream;
+            Tail->API_CALL.Context->STRM_SEND.LastStream = Stream;
+            Coalesced = TRUE;
+        }
+    }
+    CxPlatDispatchLockRelease(&OperQ->Lock);
+    if (Coalesced) {
+        QuicPerfCounterIncrement(Partition, QUIC_PERF_COUNTER_CONN_OPER_COALESCED);
+    }
+    return Coalesced;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_OPERATION*
 QuicOperationDequeue(
@@ -280,12 +314,23 @@ QuicOperationQueueClear(
                             QUIC_STREAM_SHUTDOWN_FLAG_ABORT | QUIC_STREAM_SHUTDOWN_FLAG_IMMEDIATE,
                             0);
                     }
-                } else if (ApiCtx->Type == QUIC_API_TYPE_STRM_SEND &&
-                    !ApiCtx->STRM_START.Stream->Flags.Started) {
-                    QuicStreamShutdown(
-                        ApiCtx->STRM_START.Stream,
-                        QUIC_STREAM_SHUTDOWN_FLAG_ABORT | QUIC_STREAM_SHUTDOWN_FLAG_IMMEDIATE,
-                        0);
+                } else if (ApiCtx->Type == QUIC_API_TYPE_STRM_SEND) {
+                    QUIC_STREAM* Stream = ApiCtx->STRM_SEND.Stream;
+                    do {
+                        QUIC_STREAM* Next = Stream->ApiSendNext;
+                        Stream->ApiSendNext = NULL;
+                        Stream->ApiSendQueued = FALSE;
+                        if (!Stream->Flags.Started) {
+                            QuicStreamShutdown(
+                                Stream,
+                                QUIC_STREAM_SHUTDOWN_FLAG_ABORT | QUIC_STREAM_SHUTDOWN_FLAG_IMMEDIATE,
+                                0);
+                        }
+                        if (Stream != ApiCtx->STRM_SEND.Stream) {
+                            QuicStreamRelease(Stream, QUIC_STREAM_REF_OPERATION);
+                        }
+                        Stream = Next;
+                    } while (Stream != NULL);
                 }
             }
             QuicOperationFree(Oper);
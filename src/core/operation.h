@@ -9,6 +9,10 @@
 #include "operation.h.clog.h"
 #endif
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 typedef struct QUIC_SEND_REQUEST QUIC_SEND_REQUEST;
 
 //
@@ -31,6 +35,7 @@ typedef enum QUIC_OPERATION_TYPE {
     QUIC_OPER_TYPE_TIMER_EXPIRED,       // A timer expired.
     QUIC_OPER_TYPE_TRACE_RUNDOWN,       // A trace rundown was triggered.
     QUIC_OPER_TYPE_ROUTE_COMPLETION,    // Process route completion event.
+    QUIC_OPER_TYPE_TLS_COMPLETE,        // A pending TLS call completed.
 
     //
     // All stateless operations follow.
@@ -154,6 +159,7 @@ typedef struct QUIC_API_CONTEXT {
         } STRM_SHUTDOWN;
         struct {
             QUIC_STREAM* Stream;
+            QUIC_STREAM* LastStream; // Tail of the Stream->ApiSendNext chain.
         } STRM_SEND;
         struct {
             QUIC_STREAM* Stream;
@@ -190,7 +196,7 @@ typedef struct QUIC_API_CONTEXT {
 
 typedef enum QUIC_CONN_TIMER_TYPE {
 
-    QUIC_CONN_TIMER_PACING,
+    QUIC_CONN_TIMER_PACING,             // Scheduled by the worker's pacing wheel.
     QUIC_CONN_TIMER_ACK_DELAY,
     QUIC_CONN_TIMER_LOSS_DETECTION,
     QUIC_CONN_TIMER_KEEP_ALIVE,
@@ -413,6 +419,20 @@ QuicOperationEnqueueFront(
     _In_ QUIC_OPERATION* Oper
     );
 
+//
+// Adds the stream to the STRM_SEND operation at the tail of the queue, if there
+// is one, instead of queuing a new operation for it. Returns TRUE if the stream
+// was added, in which case the operation now owns the caller's stream
+// reference.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicOperationCoalesceStreamSend(
+    _In_ QUIC_OPERATION_QUEUE* OperQ,
+    _In_ QUIC_PARTITION* Partition,
+    _In_ QUIC_STREAM* Stream
+    );
+
 //
 // Dequeues an operation. Returns NULL if the queue is empty.
 //
@@ -432,3 +452,7 @@ QuicOperationQueueClear(
     _In_ QUIC_OPERATION_QUEUE* OperQ,
     _In_ QUIC_PARTITION* Partition
     );
+
+#if defined(__cplusplus)
+}
+#endif
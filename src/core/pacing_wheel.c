@@ -0,0 +1,222 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    The pacing wheel schedules the paced sends of all the connections on a
+    worker. Without it, each pacing blocked connection arms its own pacing
+    timer, and each expiration is handled individually, so thousands of paced
+    flows translate into thousands of wake ups, each sending a tiny burst.
+
+    Instead, a connection that has exhausted its pacing allowance is placed in
+    the slot for the tick of its next departure. The worker drains all due
+    ticks at once and flushes every departing connection back to back. So the
+    number of wake ups (and the sends they produce) is bounded by the tick
+    rate, not the number of connections.
+
+    The wheel is a single level of QUIC_PACING_WHEEL_SLOT_COUNT unsorted slots,
+    each QUIC_PACING_WHEEL_TICK_US wide. Pacing delays are always short, so
+    anything beyond the range of the wheel is simply placed in the last slot.
+    Insertion and removal are O(1), and the next departure is found with a scan
+    of the occupied slot bit mask.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "pacing_wheel.c.clog.h"
+#endif
+
+#define PACING_SLOT_MASK    (QUIC_PACING_WHEEL_SLOT_COUNT - 1)
+
+CXPLAT_STATIC_ASSERT(
+    QUIC_PACING_WHEEL_SLOT_COUNT == 64,
+    "Occupied mask is 64 bits");
+
+QUIC_INLINE
+uint32_t
+QuicPacingWheelLowestSetBit(
+    _In_ uint64_t Mask
+    )
+{
+    CXPLAT_DBG_ASSERT(Mask != 0);
+#ifdef _MSC_VER
+    unsigned long Index;
+    _BitScanForward64(&Index, Mask);
+    return (uint32_t)Index;
+#else
+    return (uint32_t)__builtin_ctzll(Mask);
+#endif
+}
+
+//
+// Returns the first occupied tick at or after CurrentTick, or UINT64_MAX.
+//
+static
+uint64_t
+QuicPacingWheelNextTick(
+    _In_ const QUIC_PACING_WHEEL* PacingWheel
+    )
+{
+    if (PacingWheel->Occupied == 0) {
+        return UINT64_MAX;
+    }
+    const uint32_t Slot = (uint32_t)(PacingWheel->CurrentTick & PACING_SLOT_MASK);
+    const uint64_t Rotated =
+        Slot == 0 ?
+            PacingWheel->Occupied :
+            (PacingWheel->Occupied >> Slot) |
+                (PacingWheel->Occupied << (QUIC_PACING_WHEEL_SLOT_COUNT - Slot));
+    return PacingWheel->CurrentTick + QuicPacingWheelLowestSetBit(Rotated);
+}
+
+static
+void
+QuicPacingWheelUpdateNextDeparture(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel
+    )
+{
+    const uint64_t NextTick = QuicPacingWheelNextTick(PacingWheel);
+    PacingWheel->NextDepartureTime =
+        NextTick == UINT64_MAX ? UINT64_MAX : NextTick * QUIC_PACING_WHEEL_TICK_US;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelInitialize(
+    _Out_ QUIC_PACING_WHEEL* PacingWheel
+    )
+{
+    CxPlatZeroMemory(PacingWheel, sizeof(*PacingWheel));
+    PacingWheel->NextDepartureTime = UINT64_MAX;
+    for (uint32_t i = 0; i < QUIC_PACING_WHEEL_SLOT_COUNT; ++i) {
+        CxPlatListInitializeHead(&PacingWheel->Slots[i]);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelUninitialize(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel
+    )
+{
+    UNREFERENCED_PARAMETER(PacingWheel);
+    CXPLAT_TEL_ASSERT(PacingWheel->ConnectionCount == 0);
+    CXPLAT_TEL_ASSERT(PacingWheel->Occupied == 0);
+}
+
+static
+void
+QuicPacingWheelUnlink(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel,
+    _Inout_ QUIC_CONNECTION* Connection
+    )
+{
+    const uint32_t Slot =
+        (uint32_t)((Connection->PacingDepartureTime / QUIC_PACING_WHEEL_TICK_US) & PACING_SLOT_MASK);
+    CxPlatListEntryRemove(&Connection->PacingLink);
+    Connection->PacingLink.Flink = NULL;
+    if (CxPlatListIsEmpty(&PacingWheel->Slots[Slot])) {
+        PacingWheel->Occupied &= ~(1ull << Slot);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelInsertConnection(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel,
+    _Inout_ QUIC_CONNECTION* Connection,
+    _In_ uint64_t TimeNow,
+    _In_ uint64_t DepartureTime
+    )
+{
+    if (Connection->PacingLink.Flink != NULL) {
+        QuicPacingWheelUnlink(PacingWheel, Connection);
+    } else {
+        PacingWheel->ConnectionCount++;
+        QuicConnAddRef(Connection, QUIC_CONN_REF_PACING_WHEEL);
+    }
+
+    //
+    // All ticks before the next occupied one are empty, so the wheel can be
+    // advanced up to the current time, even if it hasn't been drained.
+    //
+    const uint64_t NowTick = TimeNow / QUIC_PACING_WHEEL_TICK_US;
+    if (PacingWheel->CurrentTick < NowTick) {
+        const uint64_t NextTick = QuicPacingWheelNextTick(PacingWheel);
+        PacingWheel->CurrentTick = CXPLAT_MIN(NowTick, NextTick);
+    }
+
+    uint64_t Tick =
+        (DepartureTime + QUIC_PACING_WHEEL_TICK_US - 1) / QUIC_PACING_WHEEL_TICK_US;
+    if (Tick < PacingWheel->CurrentTick) {
+        Tick = PacingWheel->CurrentTick;
+    } else if (Tick >= PacingWheel->CurrentTick + QUIC_PACING_WHEEL_SLOT_COUNT) {
+        Tick = PacingWheel->CurrentTick + QUIC_PACING_WHEEL_SLOT_COUNT - 1;
+    }
+
+    const uint32_t Slot = (uint32_t)(Tick & PACING_SLOT_MASK);
+    Connection->PacingDepartureTime = Tick * QUIC_PACING_WHEEL_TICK_US;
+    CxPlatListInsertTail(&PacingWheel->Slots[Slot], &Connection->PacingLink);
+    PacingWheel->Occupied |= 1ull << Slot;
+
+    QuicPacingWheelUpdateNextDeparture(PacingWheel);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelRemoveConnection(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel,
+    _Inout_ QUIC_CONNECTION* Connection
+    )
+{
+    if (Connection->PacingLink.Flink != NULL) {
+        QuicPacingWheelUnlink(PacingWheel, Connection);
+        PacingWheel->ConnectionCount--;
+        QuicPacingWheelUpdateNextDeparture(PacingWheel);
+        QuicConnRelease(Connection, QUIC_CONN_REF_PACING_WHEEL);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelGetDue(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel,
+    _In_ uint64_t TimeNow,
+    _Inout_ CXPLAT_LIST_ENTRY* OutputListHead
+    )
+{
+    const uint64_t NowTick = TimeNow / QUIC_PACING_WHEEL_TICK_US;
+    if (NowTick < PacingWheel->CurrentTick) {
+        return;
+    }
+
+    uint32_t DepartureCount = 0;
+    uint64_t Tick;
+    while ((Tick = QuicPacingWheelNextTick(PacingWheel)) <= NowTick) {
+        const uint32_t Slot = (uint32_t)(Tick & PACING_SLOT_MASK);
+        CXPLAT_LIST_ENTRY* ListHead = &PacingWheel->Slots[Slot];
+        while (!CxPlatListIsEmpty(ListHead)) {
+            QUIC_CONNECTION* Connection =
+                CXPLAT_CONTAINING_RECORD(
+                    CxPlatListRemoveHead(ListHead), QUIC_CONNECTION, PacingLink);
+            CxPlatListInsertTail(OutputListHead, &Connection->PacingLink);
+            QuicConnAddRef(Connection, QUIC_CONN_REF_WORKER);
+            QuicConnRelease(Connection, QUIC_CONN_REF_PACING_WHEEL);
+            PacingWheel->ConnectionCount--;
+            DepartureCount++;
+        }
+        PacingWheel->Occupied &= ~(1ull << Slot);
+        PacingWheel->CurrentTick = Tick + 1;
+    }
+    PacingWheel->CurrentTick = NowTick + 1;
+
+    if (DepartureCount != 0) {
+        PacingWheel->TickCount++;
+        PacingWheel->DepartureCount += DepartureCount;
+    }
+
+    QuicPacingWheelUpdateNextDeparture(PacingWheel);
+}
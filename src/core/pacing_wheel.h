@@ -0,0 +1,115 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+typedef struct QUIC_CONNECTION QUIC_CONNECTION;
+
+//
+// The pacing wheel has QUIC_PACING_WHEEL_SLOT_COUNT slots, each
+// QUIC_PACING_WHEEL_TICK_US wide. Connections are bucketed by the tick of
+// their next departure, so all connections departing in the same tick are
+// flushed back to back in a single pass of the worker.
+//
+#define QUIC_PACING_WHEEL_SLOT_COUNT    64
+#define QUIC_PACING_WHEEL_TICK_US       250
+
+typedef struct QUIC_PACING_WHEEL {
+
+    //
+    // The start time (in us) of the next occupied tick, or UINT64_MAX if the
+    // wheel is empty.
+    //
+    uint64_t NextDepartureTime;
+
+    //
+    // The first tick that hasn't been drained yet.
+    //
+    uint64_t CurrentTick;
+
+    //
+    // Total number of connections in the pacing wheel.
+    //
+    uint32_t ConnectionCount;
+
+    //
+    // Bit mask of non-empty slots.
+    //
+    uint64_t Occupied;
+
+    //
+    // The (unsorted) list of connections for each tick.
+    //
+    CXPLAT_LIST_ENTRY Slots[QUIC_PACING_WHEEL_SLOT_COUNT];
+
+    //
+    // Number of ticks that had at least one departure and the total number of
+    // departures across them.
+    //
+    uint64_t TickCount;
+    uint64_t DepartureCount;
+
+} QUIC_PACING_WHEEL;
+
+//
+// Initializes the pacing wheel.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelInitialize(
+    _Out_ QUIC_PACING_WHEEL* PacingWheel
+    );
+
+//
+// Cleans up the pacing wheel.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelUninitialize(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel
+    );
+
+//
+// Schedules (or reschedules) the connection to depart at the first tick at or
+// after DepartureTime.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelInsertConnection(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel,
+    _Inout_ QUIC_CONNECTION* Connection,
+    _In_ uint64_t TimeNow,
+    _In_ uint64_t DepartureTime
+    );
+
+//
+// Removes the connection from the pacing wheel, if it is in it.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelRemoveConnection(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel,
+    _Inout_ QUIC_CONNECTION* Connection
+    );
+
+//
+// Moves all connections due to depart at or before TimeNow to the output
+// list. Each returned connection holds a QUIC_CONN_REF_WORKER reference.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelGetDue(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel,
+    _In_ uint64_t TimeNow,
+    _Inout_ CXPLAT_LIST_ENTRY* ListHead
+    );
+
+#if defined(__cplusplus)
+}
+#endif
@@ -33,6 +33,65 @@ QuicPacketBuilderSendBatch(
     _Inout_ QUIC_PACKET_BUILDER* Builder
     );
 
+//
+// Picks how many datagrams to send in the flush and how long to wait between
+// pacing chunks. Each send system call has a fixed cost (as measured by the
+// datapath), so the pacing interval is stretched until a chunk holds enough
+// datagrams to amortize it (bounded to a fraction of the RTT), and flushes
+// that the congestion window allows to be large aren't cut short.
+//
+static
+void
+QuicPacketBuilderUpdateBatching(
+    _Inout_ QUIC_PACKET_BUILDER* Builder
+    )
+{
+    QUIC_CONNECTION* Connection = Builder->Connection;
+    const QUIC_PATH* Path = Builder->Path;
+    const uint32_t Mtu = Path->Mtu;
+
+    uint32_t AllowanceDatagrams = Builder->SendAllowance / Mtu;
+    Builder->MaxDatagrams =
+        (uint8_t)CXPLAT_MIN(
+            CXPLAT_MAX(AllowanceDatagrams, QUIC_MAX_DATAGRAMS_PER_SEND),
+            QUIC_MAX_DATAGRAMS_PER_SEND_LIMIT);
+
+    Builder->PacingInterval = QUIC_SEND_PACING_INTERVAL;
+    if (!Connection->Settings.PacingEnabled ||
+        !Path->GotFirstRttSample ||
+        Path->SmoothedRtt < QUIC_MIN_PACING_RTT) {
+        return;
+    }
+
+    uint64_t TargetDatagrams =
+        (Connection->Worker->AverageSendCost + QUIC_SEND_BATCH_COST_PER_DATAGRAM_NS - 1) /
+        QUIC_SEND_BATCH_COST_PER_DATAGRAM_NS;
+    if (TargetDatagrams <= 1) {
+        return;
+    }
+    if (TargetDatagrams > QUIC_MAX_DATAGRAMS_PER_SEND) {
+        TargetDatagrams = QUIC_MAX_DATAGRAMS_PER_SEND;
+    }
+
+    //
+    // The time the pacer (at roughly CWND / RTT) takes to release the target
+    // number of datagrams.
+    //
+    const uint64_t CongestionWindow =
+        QuicCongestionControlGetCongestionWindow(&Connection->CongestionControl);
+    if (CongestionWindow == 0) {
+        return;
+    }
+    uint64_t Interval = TargetDatagrams * Mtu * Path->SmoothedRtt / CongestionWindow;
+    const uint64_t MaxInterval = Path->SmoothedRtt / QUIC_SEND_PACING_MIN_CHUNKS_PER_RTT;
+    if (Interval > MaxInterval) {
+        Interval = MaxInterval;
+    }
+    if (Interval > QUIC_SEND_PACING_INTERVAL) {
+        Builder->PacingInterval = (uint32_t)Interval;
+    }
+}
+
 #if DEBUG
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
@@ -122,10 +181,15 @@ QuicPacketBuilderInitialize(
 
     uint64_t TimeNow = CxPlatTimeUs64();
     uint64_t TimeSinceLastSend;
-    if (Connection->Send.LastFlushTimeValid) {
+    if (Connection->Send.LastFlushTimeValid &&
+        CxPlatTimeAtOrBefore64(Connection->Send.LastFlushTime, TimeNow)) {
         TimeSinceLastSend =
             CxPlatTimeDiff64(Connection->Send.LastFlushTime, TimeNow);
     } else {
+        //
+        // Either there hasn't been a flush yet, or the allowance has already
+        // been handed out up to a future departure time.
+        //
         TimeSinceLastSend = 0;
     }
     Builder->SendAllowance =
@@ -136,12 +200,63 @@ QuicPacketBuilderInitialize(
     if (Builder->SendAllowance > Path->Allowance) {
         Builder->SendAllowance = Path->Allowance;
     }
-    Connection->Send.LastFlushTime = TimeNow;
+    if (!Connection->Send.LastFlushTimeValid ||
+        CxPlatTimeAtOrBefore64(Connection->Send.LastFlushTime, TimeNow)) {
+        Connection->Send.LastFlushTime = TimeNow;
+    }
     Connection->Send.LastFlushTimeValid = TRUE;
 
+    //
+    // Don't overtake sends still held by the datapath for their departure.
+    //
+    Builder->TxTime =
+        CxPlatTimeAtOrBefore64(Connection->Send.LastDepartureTime, TimeNow) ?
+            0 : Connection->Send.LastDepartureTime;
+
+    QuicPacketBuilderUpdateBatching(Builder);
+
     return TRUE;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicPacketBuilderScheduleDeparture(
+    _Inout_ QUIC_PACKET_BUILDER* Builder,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_CONNECTION* Connection = Builder->Connection;
+    if (!MsQuicLib.SendTxTimeSupported || Connection->Settings.XdpEnabled) {
+        return FALSE;
+    }
+
+    const uint64_t DepartureTime =
+        CXPLAT_MAX(Connection->Send.LastFlushTime, TimeNow) + Builder->PacingInterval;
+    if (DepartureTime >
+            TimeNow + CXPLAT_MAX(QUIC_SEND_TXTIME_HORIZON, Builder->PacingInterval)) {
+        return FALSE;
+    }
+
+    if (Builder->SendData != NULL) {
+        QuicPacketBuilderFinalize(Builder, TRUE);
+        CXPLAT_DBG_ASSERT(Builder->SendData == NULL);
+    }
+
+    Builder->SendAllowance =
+        QuicCongestionControlGetSendAllowance(
+            &Connection->CongestionControl,
+            CxPlatTimeDiff64(Connection->Send.LastFlushTime, DepartureTime),
+            TRUE);
+    if (Builder->SendAllowance > Builder->Path->Allowance) {
+        Builder->SendAllowance = Builder->Path->Allowance;
+    }
+    Builder->TxTime = DepartureTime;
+    Connection->Send.LastFlushTime = DepartureTime;
+    Connection->Send.LastDepartureTime = DepartureTime;
+
+    return Builder->SendAllowance > 0;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicPacketBuilderCleanup(
@@ -155,8 +270,6 @@ QuicPacketBuilderCleanup(
     }
 
     QuicSentPacketMetadataReleaseFrames(Builder->Metadata, Builder->Connection);
-
-    CxPlatSecureZeroMemory(Builder->HpMask, sizeof(Builder->HpMask));
 }
 
 //
@@ -238,7 +351,7 @@ QuicPacketBuilderPrepare(
             QuicPacketBuilderFinalize(Builder, FlushDatagrams);
         }
         if (Builder->SendData == NULL &&
-            Builder->TotalCountDatagrams >= QUIC_MAX_DATAGRAMS_PER_SEND) {
+            Builder->TotalCountDatagrams >= Builder->MaxDatagrams) {
             goto Error;
         }
         NewQuicPacket = TRUE;
@@ -263,10 +376,13 @@ QuicPacketBuilderPrepare(
                     MaxUdpPayloadSizeForFamily(
                         QuicAddrGetFamily(&Builder->Path->Route.RemoteAddress),
                         DatagramSize),
-                Builder->EcnEctSet ? CXPLAT_ECN_ECT_0 : CXPLAT_ECN_NON_ECT,
+                !Builder->EcnEctSet ?
+                    CXPLAT_ECN_NON_ECT :
+                    (Connection->CongestionControl.L4sEnabled ? CXPLAT_ECN_ECT_1 : CXPLAT_ECN_ECT_0),
                 Builder->Connection->Registration->ExecProfile == QUIC_EXECUTION_PROFILE_TYPE_MAX_THROUGHPUT ?
                     CXPLAT_SEND_FLAGS_MAX_THROUGHPUT : CXPLAT_SEND_FLAGS_NONE,
-                Connection->DSCP
+                Connection->DSCP,
+                Builder->TxTime
             };
             Builder->SendData =
                 CxPlatSendDataAlloc(Builder->Path->Binding->Socket, &SendConfig);
@@ -696,14 +812,26 @@ QuicPacketBuilderFinalizeHeaderProtection(
 {
     CXPLAT_DBG_ASSERT(Builder->Key != NULL);
 
+    uint8_t CipherBatch[CXPLAT_HP_SAMPLE_LENGTH * QUIC_MAX_CRYPTO_BATCH_COUNT];
+    uint8_t HpMask[CXPLAT_HP_SAMPLE_LENGTH * QUIC_MAX_CRYPTO_BATCH_COUNT];
+
+    for (uint8_t i = 0; i < Builder->BatchCount; ++i) {
+        const uint8_t* PnStart =
+            Builder->HeaderBatch[i] + 1 + Builder->Path->DestCid->CID.Length;
+        CxPlatCopyMemory(
+            CipherBatch + i * CXPLAT_HP_SAMPLE_LENGTH,
+            PnStart + 4,
+            CXPLAT_HP_SAMPLE_LENGTH);
+    }
+
     QUIC_STATUS Status;
     if (QUIC_FAILED(
         Status =
         CxPlatHpComputeMask(
             Builder->Key->HeaderKey,
             Builder->BatchCount,
-            Builder->CipherBatch,
-            Builder->HpMask))) {
+            CipherBatch,
+            HpMask))) {
         CXPLAT_TEL_ASSERT(FALSE);
         QuicConnFatalError(Builder->Connection, Status, "HP failure");
         return;
@@ -712,13 +840,14 @@ QuicPacketBuilderFinalizeHeaderProtection(
     for (uint8_t i = 0; i < Builder->BatchCount; ++i) {
         uint16_t Offset = i * CXPLAT_HP_SAMPLE_LENGTH;
         uint8_t* Header = Builder->HeaderBatch[i];
-        Header[0] ^= (Builder->HpMask[Offset] & 0x1f); // Bottom 5 bits for SH
+        Header[0] ^= (HpMask[Offset] & 0x1f); // Bottom 5 bits for SH
         Header += 1 + Builder->Path->DestCid->CID.Length;
         for (uint8_t j = 0; j < Builder->PacketNumberLength; ++j) {
-            Header[j] ^= Builder->HpMask[Offset + 1 + j];
+            Header[j] ^= HpMask[Offset + 1 + j];
         }
     }
 
+    CxPlatSecureZeroMemory(HpMask, Builder->BatchCount * CXPLAT_HP_SAMPLE_LENGTH);
     Builder->BatchCount = 0;
 }
 
@@ -908,10 +1037,6 @@ QuicPacketBuilderFinalize(
                 // Batch the header protection for short header packets.
                 //
 
-                CxPlatCopyMemory(
-                    Builder->CipherBatch + Builder->BatchCount * CXPLAT_HP_SAMPLE_LENGTH,
-                    PnStart + 4,
-                    CXPLAT_HP_SAMPLE_LENGTH);
                 Builder->HeaderBatch[Builder->BatchCount] = Header;
 
                 if (++Builder->BatchCount == QUIC_MAX_CRYPTO_BATCH_COUNT) {
@@ -921,6 +1046,8 @@ QuicPacketBuilderFinalize(
             } else {
                 CXPLAT_DBG_ASSERT(Builder->BatchCount == 0);
 
+                uint8_t HpMask[CXPLAT_HP_SAMPLE_LENGTH];
+
                 //
                 // Individually do header protection for long header packets as
                 // they generally use different keys.
@@ -932,16 +1059,17 @@ QuicPacketBuilderFinalize(
                         Builder->Key->HeaderKey,
                         1,
                         PnStart + 4,
-                        Builder->HpMask))) {
+                        HpMask))) {
                     CXPLAT_TEL_ASSERT(FALSE);
                     QuicConnFatalError(Connection, Status, "HP failure");
                     goto Exit;
                 }
 
-                Header[0] ^= (Builder->HpMask[0] & 0x0f); // Bottom 4 bits for LH
+                Header[0] ^= (HpMask[0] & 0x0f); // Bottom 4 bits for LH
                 for (uint8_t i = 0; i < Builder->PacketNumberLength; ++i) {
-                    PnStart[i] ^= Builder->HpMask[1 + i];
+                    PnStart[i] ^= HpMask[1 + i];
                 }
+                CxPlatSecureZeroMemory(HpMask, sizeof(HpMask));
             }
         }
 
@@ -997,6 +1125,12 @@ QuicPacketBuilderFinalize(
     //
     CXPLAT_DBG_ASSERT(Builder->Metadata->FrameCount != 0);
 
+    //
+    // N.B. This is when the packet is handed to the datapath, even if it's
+    // held until a later departure time. RTT samples include that short wait
+    // (see QuicPacketBuilderScheduleDeparture), but a send time in the future
+    // would make them underflow.
+    //
     Builder->Metadata->SentTime = CxPlatTimeUs64();
     Builder->Metadata->PacketLength =
         Builder->HeaderLength + PayloadLength;
@@ -1094,22 +1228,31 @@ QuicPacketBuilderSendBatch(
     _Inout_ QUIC_PACKET_BUILDER* Builder
     )
 {
+    QUIC_CONNECTION* Connection = Builder->Connection;
+    const uint8_t BatchDatagrams =
+        Builder->TotalCountDatagrams - Builder->BatchStartDatagrams;
+
     QuicTraceLogConnVerbose(
         PacketBuilderSendBatch,
-        Builder->Connection,
+        Connection,
         "Sending batch. %hu datagrams",
-        (uint16_t)Builder->TotalCountDatagrams);
+        (uint16_t)BatchDatagrams);
 
     QuicBindingSend(
         Builder->Path->Binding,
-        Builder->Connection->Partition,
+        Connection->Partition,
         &Builder->Path->Route,
         Builder->SendData,
         Builder->TotalDatagramsLength,
-        Builder->TotalCountDatagrams);
+        BatchDatagrams,
+        QuicWorkerGetSendBatch(Connection->Worker, Connection));
+
+    Connection->Stats.Send.BatchCount++;
+    Connection->Stats.Send.BatchDatagrams += BatchDatagrams;
 
     Builder->PacketBatchSent = TRUE;
     Builder->SendData = NULL;
     Builder->TotalDatagramsLength = 0;
+    Builder->BatchStartDatagrams = Builder->TotalCountDatagrams;
     Builder->Metadata->FrameCount = 0;
 }
@@ -41,17 +41,6 @@ typedef struct QUIC_PACKET_BUILDER {
     //
     QUIC_PACKET_KEY* Key;
 
-    //
-    // Cipher text across multiple packets to batch header protection.
-    //
-    uint8_t CipherBatch[CXPLAT_HP_SAMPLE_LENGTH * QUIC_MAX_CRYPTO_BATCH_COUNT];
-
-    //
-    // Output header protection mask.
-    //
-    uint8_t HpMask[CXPLAT_HP_SAMPLE_LENGTH * QUIC_MAX_CRYPTO_BATCH_COUNT];
-
-
     //
     // Headers that need to be batched.
     //
@@ -71,7 +60,7 @@ typedef struct QUIC_PACKET_BUILDER {
     //
     // The number of batched packets to do header protection on.
     //
-    uint8_t BatchCount : 4;
+    uint8_t BatchCount : 5;
 
     //
     // Indicates whether ECN ECT bit is set on the packets to be sent.
@@ -93,6 +82,16 @@ typedef struct QUIC_PACKET_BUILDER {
     //
     uint8_t TotalCountDatagrams;
 
+    //
+    // The value of TotalCountDatagrams when the current batch was started.
+    //
+    uint8_t BatchStartDatagrams;
+
+    //
+    // Hint for the number of datagrams to send in this flush.
+    //
+    uint8_t MaxDatagrams;
+
     //
     // The size of the encryption AEAD tag at the end of the current QUIC
     // packet.
@@ -151,8 +150,18 @@ typedef struct QUIC_PACKET_BUILDER {
     //
     uint32_t SendAllowance;
 
+    //
+    // The time, in microseconds, between pacing chunks.
+    //
+    uint32_t PacingInterval;
+
     uint64_t BatchId;
 
+    //
+    // The departure time of the current batch, or 0 to send it immediately.
+    //
+    uint64_t TxTime;
+
     //
     // Represents the metadata of the current QUIC packet.
     //
@@ -229,6 +238,19 @@ QuicPacketBuilderFinalize(
     _In_ BOOLEAN FlushBatchedDatagrams
     );
 
+//
+// Called when the current pacing chunk is exhausted. If the datapath supports
+// departure times, sends out the current batch and starts a new one, with the
+// allowance for the next pacing interval and departing at its start. Returns
+// FALSE if not supported, or if the next departure is too far ahead.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicPacketBuilderScheduleDeparture(
+    _Inout_ QUIC_PACKET_BUILDER* Builder,
+    _In_ uint64_t TimeNow
+    );
+
 //
 // Returns TRUE if congestion control isn't currently blocking sends.
 //
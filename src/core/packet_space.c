@@ -23,16 +23,13 @@ QuicPacketSpaceInitialize(
     _Out_ QUIC_PACKET_SPACE** NewPackets
     )
 {
-    QUIC_PACKET_SPACE* Packets =
-        CxPlatPoolAlloc(&Connection->Partition->PacketSpacePool);
-    if (Packets == NULL) {
-        QuicTraceEvent(
-            AllocFailure,
-            "Allocation of '%s' failed. (%llu bytes)",
-            "packet space",
-            sizeof(QUIC_PACKET_SPACE));
-        return QUIC_STATUS_OUT_OF_MEMORY;
-    }
+    //
+    // Each encryption level's packet space is initialized at most once per
+    // connection, so it always fits in the connection's arena.
+    //
+    CXPLAT_DBG_ASSERT(EncryptLevel < ARRAYSIZE(Connection->Arena.Packets));
+    QUIC_PACKET_SPACE* Packets = &Connection->Arena.Packets[EncryptLevel];
+    QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_CONN_ARENA_ALLOC);
 
     CxPlatZeroMemory(Packets, sizeof(QUIC_PACKET_SPACE));
     Packets->Connection = Connection;
@@ -62,7 +59,7 @@ QuicPacketSpaceUninitialize(
     }
 
     QuicAckTrackerUninitialize(&Packets->AckTracker);
-    CxPlatPoolFree(Packets);
+    CXPLAT_DBG_ASSERT(QuicConnArenaContains(Packets->Connection, Packets));
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
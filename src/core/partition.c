@@ -35,7 +35,6 @@ QuicPartitionInitialize(
     Partition->Processor = Processor;
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_CONNECTION), QUIC_POOL_CONN, &Partition->ConnectionPool);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_TRANSPORT_PARAMETERS), QUIC_POOL_TP, &Partition->TransportParamPool);
-    CxPlatPoolInitialize(FALSE, sizeof(QUIC_PACKET_SPACE), QUIC_POOL_TP, &Partition->PacketSpacePool);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_STREAM), QUIC_POOL_STREAM, &Partition->StreamPool);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_RECV_CHUNK)+QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE, QUIC_POOL_SBUF, &Partition->DefaultReceiveBufferPool);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_SEND_REQUEST), QUIC_POOL_SEND_REQUEST, &Partition->SendRequestPool);
@@ -60,7 +59,6 @@ QuicPartitionUninitialize(
     }
     CxPlatPoolUninitialize(&Partition->ConnectionPool);
     CxPlatPoolUninitialize(&Partition->TransportParamPool);
-    CxPlatPoolUninitialize(&Partition->PacketSpacePool);
     CxPlatPoolUninitialize(&Partition->StreamPool);
     CxPlatPoolUninitialize(&Partition->DefaultReceiveBufferPool);
     CxPlatPoolUninitialize(&Partition->SendRequestPool);
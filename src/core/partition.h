@@ -84,7 +84,6 @@ typedef struct QUIC_CACHEALIGN QUIC_PARTITION {
     //
     CXPLAT_POOL ConnectionPool;             // QUIC_CONNECTION
     CXPLAT_POOL TransportParamPool;         // QUIC_TRANSPORT_PARAMETER
-    CXPLAT_POOL PacketSpacePool;            // QUIC_PACKET_SPACE
     CXPLAT_POOL StreamPool;                 // QUIC_STREAM
     CXPLAT_POOL DefaultReceiveBufferPool;   // QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE
     CXPLAT_POOL SendRequestPool;            // QUIC_SEND_REQUEST
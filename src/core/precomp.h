@@ -48,6 +48,7 @@
 #include "transport_params.h"
 #include "lookup.h"
 #include "timer_wheel.h"
+#include "pacing_wheel.h"
 #include "settings.h"
 #include "sent_packet_metadata.h"
 #include "partition.h"
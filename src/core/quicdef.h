@@ -191,6 +191,13 @@ typedef struct QUIC_RX_PACKET QUIC_RX_PACKET;
 //
 #define QUIC_MAX_OPERATIONS_PER_DRAIN           16
 
+//
+// The factor by which a connection's drain quota may grow beyond the
+// MaxOperationsPerDrain setting while no other connection is waiting on its
+// worker.
+//
+#define QUIC_MAX_OPERATIONS_PER_DRAIN_SCALE     8
+
 //
 // Used as a hint for the maximum number of UDP datagrams to send for each
 // FLUSH_SEND operation. The actual number will generally exceed this value up
@@ -198,6 +205,21 @@ typedef struct QUIC_RX_PACKET QUIC_RX_PACKET;
 //
 #define QUIC_MAX_DATAGRAMS_PER_SEND             40
 
+//
+// The upper bound for the (adaptive) hint above, used when the congestion
+// window allows sending much more than QUIC_MAX_DATAGRAMS_PER_SEND at once.
+// TotalCountDatagrams is 8 bits, so this must leave room for the final USO
+// buffer to be filled.
+//
+#define QUIC_MAX_DATAGRAMS_PER_SEND_LIMIT       128
+
+//
+// The amortized cost, in nanoseconds, of handing a batch to the datapath that
+// each datagram in the batch should carry. Used with the measured cost of a
+// send call to pick the number of datagrams worth batching together.
+//
+#define QUIC_SEND_BATCH_COST_PER_DATAGRAM_NS    1000
+
 //
 // The number of packets we write for a single stream before going to the next
 // one in the round robin.
@@ -210,9 +232,10 @@ typedef struct QUIC_RX_PACKET QUIC_RX_PACKET;
 #define QUIC_MAX_RECEIVE_BATCH_COUNT            32
 
 //
-// The maximum number of crypto operations to batch.
+// The maximum number of crypto operations to batch. Sized so the native
+// header protection kernels can run full vector iterations.
 //
-#define QUIC_MAX_CRYPTO_BATCH_COUNT             8
+#define QUIC_MAX_CRYPTO_BATCH_COUNT             16
 
 //
 // The maximum number of received packets that may be processed in a single
@@ -247,6 +270,13 @@ typedef struct QUIC_RX_PACKET QUIC_RX_PACKET;
 //
 #define QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE    0x1000  // 4096
 
+//
+// The number of streams, with their initial receive buffers, that are
+// allocated together with their connection. Any more come from the partition's
+// pools.
+//
+#define QUIC_CONN_ARENA_STREAM_COUNT            2
+
 //
 // The default connection flow control window value, in bytes.
 //
@@ -415,6 +445,18 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_SEND_PACING_INTERVAL               1000
 
+//
+// The minimum number of pacing chunks per RTT. Bounds how far the pacing
+// interval may be stretched to batch more datagrams per send.
+//
+#define QUIC_SEND_PACING_MIN_CHUNKS_PER_RTT     4
+
+//
+// How far ahead, in microseconds, paced sends may be handed to the datapath
+// when it supports departure times.
+//
+#define QUIC_SEND_TXTIME_HORIZON                (2 * QUIC_SEND_PACING_INTERVAL)
+
 //
 // The maximum number of bytes to send in a given key phase
 // before performing a key phase update. Roughly, 274GB.
@@ -539,6 +581,12 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_DEFAULT_ECN_ENABLED                     FALSE
 
+//
+// The default value for sending ECT(1) and using a scalable (L4S) response to
+// CE marks instead of ECT(0) and the classic response.
+//
+#define QUIC_DEFAULT_ECN_L4S_ENABLED                 FALSE
+
 //
 // The default settings for enabling HyStart support.
 //
@@ -680,6 +728,7 @@ CXPLAT_STATIC_ASSERT(
 #define QUIC_SETTING_DATAGRAM_RECEIVE_ENABLED       "DatagramReceiveEnabled"
 #define QUIC_SETTING_GREASE_QUIC_BIT_ENABLED        "GreaseQuicBitEnabled"
 #define QUIC_SETTING_ECN_ENABLED                    "EcnEnabled"
+#define QUIC_SETTING_ECN_L4S_ENABLED                "EcnL4sEnabled"
 #define QUIC_SETTING_HYSTART_ENABLED                "HyStartEnabled"
 #define QUIC_SETTING_ENCRYPTION_OFFLOAD_ALLOWED     "EncryptionOffloadAllowed"
 #define QUIC_SETTING_RELIABLE_RESET_ENABLED         "ReliableResetEnabled"
@@ -8,6 +8,11 @@ Abstract:
     A set of unique 64-bit values, stored as an array of subranges ordered from
     smallest to largest.
 
+    The subranges may start anywhere in the allocated buffer, leaving unused
+    space at either end. This allows subranges to be appended (the common
+    in-order case), prepended (as the ACK frame decoder does) or removed from
+    the front (QuicRangeSetMin) without moving the rest of the array.
+
 --*/
 
 #include "precomp.h"
@@ -15,6 +20,18 @@ Abstract:
 #include "range.c.clog.h"
 #endif
 
+//
+// Returns the start of the allocated buffer backing the subranges.
+//
+QUIC_INLINE
+QUIC_SUBRANGE*
+QuicRangeGetBuffer(
+    _In_ const QUIC_RANGE* Range
+    )
+{
+    return Range->SubRanges - Range->FrontSpace;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicRangeInitialize(
@@ -24,6 +41,7 @@ QuicRangeInitialize(
 {
     Range->UsedLength = 0;
     Range->AllocLength = QUIC_RANGE_INITIAL_SUB_COUNT;
+    Range->FrontSpace = 0;
     Range->MaxAllocSize = MaxAllocSize;
     CXPLAT_FRE_ASSERT(sizeof(QUIC_SUBRANGE) * QUIC_RANGE_INITIAL_SUB_COUNT < MaxAllocSize);
     Range->SubRanges = Range->PreAllocSubRanges;
@@ -36,7 +54,7 @@ QuicRangeUninitialize(
     )
 {
     if (Range->AllocLength != QUIC_RANGE_INITIAL_SUB_COUNT) {
-        CXPLAT_FREE(Range->SubRanges, QUIC_POOL_RANGE);
+        CXPLAT_FREE(QuicRangeGetBuffer(Range), QUIC_POOL_RANGE);
     }
 }
 
@@ -47,6 +65,8 @@ QuicRangeReset(
     )
 {
     Range->UsedLength = 0;
+    Range->SubRanges = QuicRangeGetBuffer(Range);
+    Range->FrontSpace = 0;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -84,12 +104,16 @@ QuicRangeGrow(
 
     //
     // Move the items to the new array and make room for the next index to write.
+    // When inserting at the front, the items are moved to the end of the new
+    // array so that following inserts at the front don't need to move them.
     //
 
     CXPLAT_DBG_ASSERT(Range->SubRanges != 0);
+    CXPLAT_DBG_ASSERT(Range->FrontSpace == 0);
     if (NextIndex == 0) {
+        Range->FrontSpace = NewAllocLength - Range->UsedLength - 1;
         memcpy(
-            NewSubRanges + 1,
+            NewSubRanges + Range->FrontSpace + 1,
             Range->SubRanges,
             Range->UsedLength * sizeof(QUIC_SUBRANGE));
     } else if (NextIndex == Range->UsedLength) {
@@ -111,7 +135,7 @@ QuicRangeGrow(
     if (Range->AllocLength != QUIC_RANGE_INITIAL_SUB_COUNT) {
         CXPLAT_FREE(Range->SubRanges, QUIC_POOL_RANGE);
     }
-    Range->SubRanges = NewSubRanges;
+    Range->SubRanges = NewSubRanges + Range->FrontSpace;
     Range->AllocLength = NewAllocLength;
     Range->UsedLength++; // For the next write index.
 
@@ -153,15 +177,51 @@ QuicRangeMakeSpace(
         }
     } else {
         CXPLAT_DBG_ASSERT(Range->SubRanges != 0);
-        if (*Index == 0) {
+        const uint32_t BackSpace =
+            Range->AllocLength - Range->FrontSpace - Range->UsedLength;
+        if (*Index == Range->UsedLength && BackSpace != 0) {
+            //
+            // No need to copy. Appending to the end.
+            //
+        } else if (*Index == 0 && Range->FrontSpace != 0) {
+            //
+            // No need to copy. Prepending to the front.
+            //
+            Range->SubRanges--;
+            Range->FrontSpace--;
+        } else if (*Index == 0) {
+            //
+            // Move everything to the end of the buffer so that the following
+            // inserts at the front don't need to copy.
+            //
             memmove(
-                Range->SubRanges + 1,
+                Range->SubRanges + BackSpace,
                 Range->SubRanges,
                 Range->UsedLength * sizeof(QUIC_SUBRANGE));
+            Range->SubRanges += BackSpace - 1;
+            Range->FrontSpace += BackSpace - 1;
         } else if (*Index == Range->UsedLength) {
             //
-            // No need to copy. Appending to the end.
+            // Move everything to the start of the buffer so that the following
+            // appends don't need to copy.
             //
+            memmove(
+                QuicRangeGetBuffer(Range),
+                Range->SubRanges,
+                Range->UsedLength * sizeof(QUIC_SUBRANGE));
+            Range->SubRanges = QuicRangeGetBuffer(Range);
+            Range->FrontSpace = 0;
+        } else if (Range->FrontSpace != 0 &&
+            (BackSpace == 0 || *Index < Range->UsedLength - *Index)) {
+            //
+            // Move the (smaller) part before the insert down.
+            //
+            memmove(
+                Range->SubRanges - 1,
+                Range->SubRanges,
+                *Index * sizeof(QUIC_SUBRANGE));
+            Range->SubRanges--;
+            Range->FrontSpace--;
         } else {
             memmove(
                 Range->SubRanges + *Index + 1,
@@ -185,7 +245,28 @@ QuicRangeRemoveSubranges(
     CXPLAT_DBG_ASSERT(Count > 0);
     CXPLAT_DBG_ASSERT(Index + Count <= Range->UsedLength);
 
-    if (Index + Count < Range->UsedLength) {
+    BOOLEAN Moved = FALSE;
+
+    if (Index + Count == Range->UsedLength) {
+        //
+        // No need to copy. Removing from the end.
+        //
+    } else if (Index < Range->UsedLength - Index - Count) {
+        //
+        // Move the (smaller) part before the removed subranges up. This
+        // doesn't copy anything for the common case of removing from the
+        // front.
+        //
+        if (Index != 0) {
+            memmove(
+                Range->SubRanges + Count,
+                Range->SubRanges,
+                Index * sizeof(QUIC_SUBRANGE));
+            Moved = TRUE;
+        }
+        Range->SubRanges += Count;
+        Range->FrontSpace += Count;
+    } else {
         memmove(
             Range->SubRanges + Index,
             Range->SubRanges + Index + Count,
@@ -193,6 +274,10 @@ QuicRangeRemoveSubranges(
     }
 
     Range->UsedLength -= Count;
+    if (Range->UsedLength == 0) {
+        Range->SubRanges = QuicRangeGetBuffer(Range);
+        Range->FrontSpace = 0;
+    }
 
     if (Range->AllocLength >= QUIC_RANGE_INITIAL_SUB_COUNT * 2 &&
         Range->UsedLength < Range->AllocLength / 4) {
@@ -207,20 +292,21 @@ QuicRangeRemoveSubranges(
             NewSubRanges =
                 CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_SUBRANGE) * NewAllocLength, QUIC_POOL_RANGE);
             if (NewSubRanges == NULL) {
-                return FALSE;
+                return Moved;
             }
         }
         memcpy(
             NewSubRanges,
             Range->SubRanges,
             Range->UsedLength * sizeof(QUIC_SUBRANGE));
-        CXPLAT_FREE(Range->SubRanges, QUIC_POOL_RANGE);
+        CXPLAT_FREE(QuicRangeGetBuffer(Range), QUIC_POOL_RANGE);
         Range->SubRanges = NewSubRanges;
         Range->AllocLength = NewAllocLength;
+        Range->FrontSpace = 0;
         return TRUE;
     }
 
-    return FALSE;
+    return Moved;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -262,7 +348,14 @@ QuicRangeAddRange(
     *RangeUpdated = FALSE;
 
 #if QUIC_RANGE_USE_BINARY_SEARCH
-    if ((Sub = QuicRangeGetSafe(Range, Range->UsedLength - 1)) != NULL &&
+    if ((Sub = QuicRangeGetSafe(Range, 0)) != NULL &&
+        Sub->Low > Low + Count) {
+        //
+        // New value is before (and not adjacent to) the current first subrange,
+        // as is always the case when decoding ACK frames.
+        //
+        i = 0;
+    } else if ((Sub = QuicRangeGetSafe(Range, Range->UsedLength - 1)) != NULL &&
         Sub->Low + Sub->Count > Low) {
 #endif
         //
@@ -364,7 +457,7 @@ QuicRangeAddRange(
         if (RemoveCount != 0) {
             if (QuicRangeRemoveSubranges(Range, i + 1, RemoveCount)) {
                 //
-                // The subranges were reallocated, so update our Sub pointer.
+                // The subranges were moved, so update our Sub pointer.
                 //
                 Sub = QuicRangeGet(Range, i);
             }
@@ -45,9 +45,11 @@ QuicRangeGetHigh(
 typedef struct QUIC_RANGE {
 
     //
-    // Array of subranges that represent the set of intervals.
+    // Array of subranges that represent the set of intervals. This points
+    // 'FrontSpace' entries into the allocated buffer, so that values can be
+    // added to or removed from either end without moving the whole array.
     //
-    _Field_size_(AllocLength)
+    _Field_size_(AllocLength - FrontSpace)
     QUIC_SUBRANGE* SubRanges;
 
     //
@@ -56,11 +58,16 @@ typedef struct QUIC_RANGE {
     uint32_t UsedLength;
 
     //
-    // The number of allocated subranges in the 'SubRanges' array.
+    // The number of allocated subranges in the buffer backing 'SubRanges'.
     //
     _Field_range_(1, QUIC_MAX_RANGE_ALLOC_SIZE)
     uint32_t AllocLength;
 
+    //
+    // The number of unused subranges in the buffer before 'SubRanges'.
+    //
+    uint32_t FrontSpace;
+
     //
     // The maximum allocation byte count for the 'SubRanges' array.
     //
@@ -299,8 +306,9 @@ QuicRangeAddRange(
     );
 
 //
-// Removes a number of subranges from the range. Returns TRUE if the list was
-// shrunk (reallocated) because of the removal operation.
+// Removes a number of subranges from the range. Returns TRUE if the subranges
+// before 'Index' were moved (or the list was shrunk) because of the removal
+// operation.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
@@ -174,6 +174,7 @@ QuicRecvChunkInitialize(
     Chunk->Buffer = Buffer;
     Chunk->ExternalReference = FALSE;
     Chunk->AllocatedFromPool = AllocatedFromPool;
+    Chunk->AllocatedInArena = FALSE;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -185,8 +186,12 @@ QuicRecvChunkFree(
     //
     // The data buffer of the chunk is allocated in the same allocation
     // as the chunk itself if and only if it is owned by the receive buffer:
-    // freeing the chunk will free the data buffer as needed.
+    // freeing the chunk will free the data buffer as needed. Chunks in a
+    // connection's arena are released with the connection.
     //
+    if (Chunk->AllocatedInArena) {
+        return;
+    }
     if (Chunk->AllocatedFromPool) {
         CxPlatPoolFree(Chunk);
     } else {
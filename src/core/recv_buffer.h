@@ -25,6 +25,7 @@ typedef struct QUIC_RECV_CHUNK {
     uint32_t AllocLength;            // Allocation size of Buffer
     uint8_t ExternalReference  : 1;  // Indicates the buffer is being used externally.
     uint8_t AllocatedFromPool  : 1;  // Indicates the buffer is was allocated from a pool.
+    uint8_t AllocatedInArena   : 1;  // Indicates the buffer is part of a connection's arena.
     uint8_t* Buffer;                 // Pointer to the buffer itself. Doesn't need to be freed independently:
                                      //  - for internally allocated buffers, points in the same allocation.
                                      //  - for app-owned buffers, the buffer isn't owned
@@ -33,6 +33,8 @@ QuicSendInitialize(
     )
 {
     CxPlatListInitializeHead(&Send->SendStreams);
+    CxPlatListInitializeHead(&Send->SendPriorityGroups);
+    CxPlatListInitializeHead(&Send->BlockedSendStreams);
     Send->MaxData = Settings->ConnFlowControlWindow;
     Send->SkippedPacketNumber = UINT64_MAX;
 
@@ -69,18 +71,23 @@ QuicSendUninitialize(
     //
     // Release all the stream refs.
     //
-    CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Flink;
-    while (Entry != &Send->SendStreams) {
+    CXPLAT_LIST_ENTRY* Lists[] = { &Send->SendStreams, &Send->BlockedSendStreams };
+    for (uint32_t i = 0; i < ARRAYSIZE(Lists); ++i) {
+        CXPLAT_LIST_ENTRY* Entry = Lists[i]->Flink;
+        while (Entry != Lists[i]) {
 
-        QUIC_STREAM* Stream =
-            CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink);
-        CXPLAT_DBG_ASSERT(Stream->SendFlags != 0);
+            QUIC_STREAM* Stream =
+                CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink);
+            CXPLAT_DBG_ASSERT(Stream->SendFlags != 0);
 
-        Entry = Entry->Flink;
-        Stream->SendFlags = 0;
-        Stream->SendLink.Flink = NULL;
+            Entry = Entry->Flink;
+            Stream->SendFlags = 0;
+            Stream->SendLink.Flink = NULL;
+            Stream->SendPriorityLink.Flink = NULL;
+            Stream->Flags.SendBlocked = FALSE;
 
-        QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
+            QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
+        }
     }
 }
 
@@ -102,13 +109,13 @@ QuicSendReset(
 {
     Send->SendFlags = 0;
     Send->LastFlushTime = 0;
+    Send->LastDepartureTime = 0;
     if (Send->DelayedAckTimerActive) {
         QuicConnTimerCancel(QuicSendGetConnection(Send), QUIC_CONN_TIMER_ACK_DELAY);
         Send->DelayedAckTimerActive = FALSE;
     }
-    QuicConnTimerCancel(
-        QuicSendGetConnection(Send),
-        QUIC_CONN_TIMER_PACING);
+    QUIC_CONNECTION* Connection = QuicSendGetConnection(Send);
+    QuicPacingWheelRemoveConnection(&Connection->Worker->PacingWheel, Connection);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -121,7 +128,7 @@ QuicSendCanSendFlagsNow(
     // NOLINTNEXTLINE(clang-analyzer-security.ArrayBound): False positive: embedded Send is valid.
     if (Connection->Crypto.TlsState.WriteKey < QUIC_PACKET_KEY_1_RTT) {
         if (Connection->Crypto.TlsState.WriteKeys[QUIC_PACKET_KEY_0_RTT] != NULL &&
-            CxPlatListIsEmpty(&Send->SendStreams)) {
+            !QuicSendHasQueuedStreams(Send)) {
             return TRUE;
         }
         if ((!Connection->State.Started && QuicConnIsClient(Connection)) ||
@@ -155,6 +162,216 @@ QuicSendQueueFlush(
     }
 }
 
+//
+// Returns TRUE if the send queue is ordered by the streams' schedule keys
+// instead of by priority.
+//
+QUIC_INLINE
+BOOLEAN
+QuicSendUsesScheduleKeys(
+    _In_ const QUIC_CONNECTION* Connection
+    )
+{
+    return
+        Connection->State.UseWeightedFairStreamScheduling ||
+        Connection->State.UseDeadlineStreamScheduling;
+}
+
+//
+// Returns the deadline of the next new data the stream has to send. Streams
+// without a deadline, or that already missed it, go after all the others.
+//
+QUIC_INLINE
+uint64_t
+QuicSendGetStreamDeadline(
+    _In_ const QUIC_STREAM* Stream,
+    _In_ uint64_t TimeNow
+    )
+{
+    if (Stream->SendBookmark == NULL ||
+        Stream->SendBookmark->Deadline == 0 ||
+        Stream->SendBookmark->Deadline < TimeNow) {
+        return UINT64_MAX;
+    }
+    return Stream->SendBookmark->Deadline;
+}
+
+//
+// Computes the stream's schedule key and inserts it into the send queue after
+// all the streams with the same or a lower key.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendInsertStreamByKey(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (Stream->Connection->State.UseWeightedFairStreamScheduling) {
+        if (Stream->SendScheduleKey < Send->VirtualTime) {
+            Stream->SendScheduleKey = Send->VirtualTime;
+        }
+    } else {
+        Stream->SendScheduleKey =
+            QuicSendGetStreamDeadline(Stream, CxPlatTimeUs64());
+    }
+
+    //
+    // Search from the end, since most streams are (re)inserted with the
+    // highest key.
+    //
+    CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Blink;
+    while (Entry != &Send->SendStreams &&
+        CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink)->SendScheduleKey >
+            Stream->SendScheduleKey) {
+        Entry = Entry->Blink;
+    }
+    CxPlatListInsertHead(Entry, &Stream->SendLink);
+    Stream->SendPriorityLink.Flink = NULL;
+}
+
+//
+// Inserts the stream into the send queue, after all the streams of the same or
+// higher priority.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendInsertStream(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (QuicSendUsesScheduleKeys(Stream->Connection)) {
+        QuicSendInsertStreamByKey(Send, Stream);
+        return;
+    }
+
+    CXPLAT_LIST_ENTRY* Entry = Send->SendPriorityGroups.Flink;
+    while (Entry != &Send->SendPriorityGroups) {
+        QUIC_STREAM* First =
+            CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendPriorityLink);
+        if (Stream->SendPriority > First->SendPriority) {
+            //
+            // Higher priority than any stream in this group, so the stream
+            // starts a new group, right before this one.
+            //
+            CxPlatListInsertTail(&First->SendLink, &Stream->SendLink);
+            CxPlatListInsertTail(Entry, &Stream->SendPriorityLink);
+            return;
+        }
+        if (Stream->SendPriority == First->SendPriority) {
+            //
+            // Insert at the end of this group, which is right before the first
+            // stream of the next group.
+            //
+            CXPLAT_LIST_ENTRY* Next =
+                Entry->Flink == &Send->SendPriorityGroups ?
+                    &Send->SendStreams :
+                    &CXPLAT_CONTAINING_RECORD(
+                        Entry->Flink, QUIC_STREAM, SendPriorityLink)->SendLink;
+            CxPlatListInsertTail(Next, &Stream->SendLink);
+            Stream->SendPriorityLink.Flink = NULL;
+            return;
+        }
+        Entry = Entry->Flink;
+    }
+
+    //
+    // Lower priority than all queued streams.
+    //
+    CxPlatListInsertTail(&Send->SendStreams, &Stream->SendLink);
+    CxPlatListInsertTail(&Send->SendPriorityGroups, &Stream->SendPriorityLink);
+}
+
+//
+// Removes the stream from whichever send list it is in. The caller is
+// responsible for clearing SendLink.Flink if it isn't going to be reinserted.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendRemoveStream(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (Stream->Flags.SendBlocked) {
+        Stream->Flags.SendBlocked = FALSE;
+
+    } else if (Stream->SendPriorityLink.Flink != NULL) {
+        //
+        // The stream is the first of its priority. If the next stream is in the
+        // same group (i.e. isn't the first of its own), it takes over.
+        //
+        // N.B. This doesn't compare priorities, because the stream's priority
+        // may have already been changed by the caller.
+        //
+        CXPLAT_LIST_ENTRY* Next = Stream->SendLink.Flink;
+        if (Next != &Send->SendStreams) {
+            QUIC_STREAM* NextStream =
+                CXPLAT_CONTAINING_RECORD(Next, QUIC_STREAM, SendLink);
+            if (NextStream->SendPriorityLink.Flink == NULL) {
+                CxPlatListInsertHead(
+                    &Stream->SendPriorityLink, &NextStream->SendPriorityLink);
+            }
+        }
+        CxPlatListEntryRemove(&Stream->SendPriorityLink);
+        Stream->SendPriorityLink.Flink = NULL;
+    }
+
+    CxPlatListEntryRemove(&Stream->SendLink);
+}
+
+//
+// Returns TRUE if the only thing the stream has to send is new data, and that
+// data is blocked by the stream's or the connection's flow control. Nothing
+// else but those windows opening or new send flags being queued on the stream
+// can change that.
+//
+QUIC_INLINE
+BOOLEAN
+QuicSendIsStreamFlowControlBlocked(
+    _In_ const QUIC_SEND* Send,
+    _In_ const QUIC_STREAM* Stream
+    )
+{
+    return
+        QuicStreamAllowedByPeer(Stream) &&
+        (Stream->SendFlags & QUIC_STREAM_SEND_FLAG_DATA) &&
+        !(Stream->SendFlags & ~(QUIC_STREAM_SEND_FLAG_DATA | QUIC_STREAM_SEND_FLAG_FIN)) &&
+        !Stream->Flags.SendDelayed &&
+        !RECOV_WINDOW_OPEN(Stream) &&
+        Stream->NextSendOffset < Stream->QueuedSendOffset &&
+        (Stream->NextSendOffset >= Stream->MaxAllowedSendOffset ||
+         Send->OrderedStreamBytesSent >= Send->PeerMaxData);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendUnblockStream(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (Stream->Flags.SendBlocked) {
+        QuicSendRemoveStream(Send, Stream);
+        QuicSendInsertStream(Send, Stream);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendUnblockAllStreams(
+    _In_ QUIC_SEND* Send
+    )
+{
+    while (!CxPlatListIsEmpty(&Send->BlockedSendStreams)) {
+        QUIC_STREAM* Stream =
+            CXPLAT_CONTAINING_RECORD(
+                Send->BlockedSendStreams.Flink, QUIC_STREAM, SendLink);
+        QuicSendUnblockStream(Send, Stream);
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicSendQueueFlushForStream(
@@ -167,20 +384,18 @@ QuicSendQueueFlushForStream(
         //
         // Not previously queued, so add the stream to the end of the queue.
         //
-        CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Blink;
-        while (Entry != &Send->SendStreams) {
-            //
-            // Search back to front for the right place (based on priority) to
-            // insert the stream.
-            //
-            if (Stream->SendPriority <=
-                CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink)->SendPriority) {
-                break;
-            }
-            Entry = Entry->Blink;
-        }
-        CxPlatListInsertHead(Entry, &Stream->SendLink); // Insert after current Entry
+        QuicSendInsertStream(Send, Stream);
         QuicStreamAddRef(Stream, QUIC_STREAM_REF_SEND);
+    } else if (Stream->Flags.SendBlocked) {
+        QuicSendUnblockStream(Send, Stream);
+    } else if (Stream->Connection->State.UseDeadlineStreamScheduling &&
+        Stream->SendScheduleKey !=
+            QuicSendGetStreamDeadline(Stream, CxPlatTimeUs64())) {
+        //
+        // Newly queued data may have given the stream an earlier deadline.
+        //
+        QuicSendRemoveStream(Send, Stream);
+        QuicSendInsertStream(Send, Stream);
     }
 
     //
@@ -209,21 +424,69 @@ QuicSendUpdateStreamPriority(
     )
 {
     CXPLAT_DBG_ASSERT(Stream->SendLink.Flink != NULL);
-    CxPlatListEntryRemove(&Stream->SendLink);
+    if (!Stream->Flags.SendBlocked) {
+        //
+        // Blocked streams are inserted based on their new priority once they
+        // are unblocked.
+        //
+        QuicSendRemoveStream(Send, Stream);
+        QuicSendInsertStream(Send, Stream);
+    }
+}
 
-    CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Blink;
-    while (Entry != &Send->SendStreams) {
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendReorderStreams(
+    _In_ QUIC_SEND* Send
+    )
+{
+    CXPLAT_LIST_ENTRY Streams;
+    CxPlatListInitializeHead(&Streams);
+    CxPlatListMoveItems(&Send->SendStreams, &Streams);
+    CxPlatListMoveItems(&Send->BlockedSendStreams, &Streams);
+    CxPlatListInitializeHead(&Send->SendPriorityGroups);
+
+    while (!CxPlatListIsEmpty(&Streams)) {
+        QUIC_STREAM* Stream =
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&Streams), QUIC_STREAM, SendLink);
+        Stream->Flags.SendBlocked = FALSE;
+        Stream->SendPriorityLink.Flink = NULL;
+        QuicSendInsertStream(Send, Stream);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendOnStreamDataWritten(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint16_t Length
+    )
+{
+    QUIC_CONNECTION* Connection = Stream->Connection;
+    if (!QuicSendUsesScheduleKeys(Connection)) {
+        return;
+    }
+
+    if (Connection->State.UseWeightedFairStreamScheduling) {
         //
-        // Search back to front for the right place (based on priority) to
-        // insert the stream.
+        // Advance the stream's virtual time by the bytes sent, scaled by the
+        // inverse of its weight (priority + 1). A stream with twice the weight
+        // gets to send twice as many bytes over the same virtual time.
         //
-        if (Stream->SendPriority <=
-            CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink)->SendPriority) {
-            break;
-        }
-        Entry = Entry->Blink;
+        Stream->SendScheduleKey +=
+            ((uint64_t)Length << 16) / ((uint64_t)Stream->SendPriority + 1);
+
+    } else if (Stream->SendScheduleKey ==
+            QuicSendGetStreamDeadline(Stream, CxPlatTimeUs64())) {
+        return; // Still sending the same request.
+    }
+
+    if (Stream->SendLink.Flink != NULL && !Stream->Flags.SendBlocked) {
+        QuicSendRemoveStream(Send, Stream);
+        QuicSendInsertStream(Send, Stream);
     }
-    CxPlatListInsertHead(Entry, &Stream->SendLink); // Insert after current Entry
 }
 
 #if DEBUG
@@ -277,11 +540,12 @@ QuicSendClear(
     //
     // Remove any queued up streams.
     //
+    QuicSendUnblockAllStreams(Send);
     while (!CxPlatListIsEmpty(&Send->SendStreams)) {
 
         QUIC_STREAM* Stream =
-            CXPLAT_CONTAINING_RECORD(
-                CxPlatListRemoveHead(&Send->SendStreams), QUIC_STREAM, SendLink);
+            CXPLAT_CONTAINING_RECORD(Send->SendStreams.Flink, QUIC_STREAM, SendLink);
+        QuicSendRemoveStream(Send, Stream);
 
         CXPLAT_DBG_ASSERT(Stream->SendFlags != 0);
         Stream->SendFlags = 0;
@@ -423,6 +687,14 @@ QuicSendSetStreamSendFlag(
         SendFlags &= ~QUIC_STREAM_SEND_FLAG_MAX_DATA;
     }
 
+    if (SendFlags != 0) {
+        //
+        // Queuing anything (even data that is already queued, as for lost data
+        // to retransmit) might let a stream blocked by flow control send again.
+        //
+        QuicSendUnblockStream(Send, Stream);
+    }
+
     if ((Stream->SendFlags | SendFlags) != Stream->SendFlags ||
         (Stream->Flags.SendDelayed && (SendFlags & QUIC_STREAM_SEND_FLAG_DATA))) {
 
@@ -454,8 +726,6 @@ QuicSendClearStreamSendFlag(
     _In_ uint32_t SendFlags
     )
 {
-    UNREFERENCED_PARAMETER(Send);
-
     if (Stream->SendFlags & SendFlags) {
 
         QuicTraceLogStreamVerbose(
@@ -473,7 +743,7 @@ QuicSendClearStreamSendFlag(
             //
             // Since there are no flags left, remove the stream from the queue.
             //
-            CxPlatListEntryRemove(&Stream->SendLink);
+            QuicSendRemoveStream(Send, Stream);
             Stream->SendLink.Flink = NULL;
             QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
         }
@@ -1013,17 +1283,31 @@ QuicSendGetNextStream(
     )
 {
     QUIC_CONNECTION* Connection = QuicSendGetConnection(Send);
-    CXPLAT_DBG_ASSERT(!QuicConnIsClosed(Connection) || CxPlatListIsEmpty(&Send->SendStreams));
-
-    CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Flink;
-    while (Entry != &Send->SendStreams) {
+    CXPLAT_DBG_ASSERT(!QuicConnIsClosed(Connection) || !QuicSendHasQueuedStreams(Send));
 
+    if (Connection->State.UseDeadlineStreamScheduling) {
         //
-        // TODO: performance: We currently search through blocked
-        // streams repeatedly as we loop.
+        // Streams whose deadline passed while they were queued are moved
+        // behind all the streams that can still make theirs.
         //
+        const uint64_t TimeNow = CxPlatTimeUs64();
+        while (!CxPlatListIsEmpty(&Send->SendStreams)) {
+            QUIC_STREAM* Stream =
+                CXPLAT_CONTAINING_RECORD(Send->SendStreams.Flink, QUIC_STREAM, SendLink);
+            if (Stream->SendScheduleKey == UINT64_MAX ||
+                Stream->SendScheduleKey >= TimeNow) {
+                break;
+            }
+            QuicSendRemoveStream(Send, Stream);
+            QuicSendInsertStream(Send, Stream);
+        }
+    }
+
+    CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Flink;
+    while (Entry != &Send->SendStreams) {
 
         QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink);
+        Entry = Entry->Flink;
 
         //
         // Make sure, given the current state of the connection and the stream,
@@ -1033,26 +1317,28 @@ QuicSendGetNextStream(
 
             if (Connection->State.UseRoundRobinStreamScheduling) {
                 //
-                // Move the stream after any streams of the same priority. Start
-                // with the "next" entry in the list and keep going until the
-                // next entry's priority is less. Then move the stream before
-                // that entry.
+                // Move the stream after any streams of the same priority, unless
+                // it is already the last one (i.e. the next entry is the end of
+                // the list or the first stream of the next priority).
                 //
-                CXPLAT_LIST_ENTRY* LastEntry = Stream->SendLink.Flink;
-                while (LastEntry != &Send->SendStreams) {
-                    if (Stream->SendPriority >
-                        CXPLAT_CONTAINING_RECORD(LastEntry, QUIC_STREAM, SendLink)->SendPriority) {
-                        break;
-                    }
-                    LastEntry = LastEntry->Flink;
-                }
-                if (LastEntry->Blink != &Stream->SendLink) {
-                    CxPlatListEntryRemove(&Stream->SendLink);
-                    CxPlatListInsertTail(LastEntry, &Stream->SendLink);
+                if (Entry != &Send->SendStreams &&
+                    CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink)->SendPriorityLink.Flink == NULL) {
+                    QuicSendRemoveStream(Send, Stream);
+                    QuicSendInsertStream(Send, Stream);
                 }
 
                 *PacketCount = QUIC_STREAM_SEND_BATCH_COUNT;
 
+            } else if (QuicSendUsesScheduleKeys(Connection)) {
+                //
+                // The stream is repositioned by its new key after each packet
+                // (see QuicSendOnStreamDataWritten).
+                //
+                if (Connection->State.UseWeightedFairStreamScheduling) {
+                    Send->VirtualTime = Stream->SendScheduleKey;
+                }
+                *PacketCount = 1;
+
             } else { // FIFO prioritization scheme
                 *PacketCount = UINT32_MAX;
             }
@@ -1060,7 +1346,19 @@ QuicSendGetNextStream(
             return Stream;
         }
 
-        Entry = Entry->Flink;
+        if ((Connection->State.UseRoundRobinStreamScheduling ||
+             QuicSendUsesScheduleKeys(Connection)) &&
+            QuicSendIsStreamFlowControlBlocked(Send, Stream)) {
+            //
+            // Park the stream so that it isn't searched again on every call
+            // while it waits on flow control. Not done for FIFO, since it is
+            // put back at the end of its priority once unblocked, which would
+            // break FIFO ordering.
+            //
+            QuicSendRemoveStream(Send, Stream);
+            CxPlatListInsertTail(&Send->BlockedSendStreams, &Stream->SendLink);
+            Stream->Flags.SendBlocked = TRUE;
+        }
     }
 
     return NULL;
@@ -1222,7 +1520,7 @@ QuicSendFlush(
         return TRUE;
     }
 
-    QuicConnTimerCancel(Connection, QUIC_CONN_TIMER_PACING);
+    QuicPacingWheelRemoveConnection(&Connection->Worker->PacingWheel, Connection);
     QuicConnRemoveOutFlowBlockedReason(
         Connection, QUIC_FLOW_BLOCKED_SCHEDULING | QUIC_FLOW_BLOCKED_PACING);
 
@@ -1249,6 +1547,7 @@ QuicSendFlush(
     //
     if (Connection->Settings.DestCidUpdateIdleTimeoutMs != 0 &&
         Send->LastFlushTimeValid &&
+        CxPlatTimeAtOrBefore64(Send->LastFlushTime, TimeNow) &&
         CxPlatTimeDiff64(Send->LastFlushTime, TimeNow) >= MS_TO_US(Connection->Settings.DestCidUpdateIdleTimeoutMs) &&
         !Path->InitiatedCidUpdate) {
         if (QuicConnRetireCurrentDestCid(Connection, Path)) {
@@ -1344,16 +1643,29 @@ QuicSendFlush(
             SendFlags &= QUIC_CONN_SEND_FLAGS_BYPASS_CC;
             if (!SendFlags) {
                 if (QuicCongestionControlCanSend(&Connection->CongestionControl)) {
+                    if (QuicPacketBuilderScheduleDeparture(&Builder, TimeNow)) {
+                        //
+                        // The datapath holds the next pacing chunk until its
+                        // departure time, so keep sending.
+                        //
+                        continue;
+                    }
+
                     //
                     // The current pacing chunk is finished. We need to schedule a
-                    // new pacing send.
+                    // new pacing send on the worker's pacing wheel. If departures
+                    // have been scheduled ahead, wake up when the last of them
+                    // leaves.
                     //
                     QuicConnAddOutFlowBlockedReason(
                         Connection, QUIC_FLOW_BLOCKED_PACING);
-                    QuicConnTimerSet(
+                    QuicPacingWheelInsertConnection(
+                        &Connection->Worker->PacingWheel,
                         Connection,
-                        QUIC_CONN_TIMER_PACING,
-                        QUIC_SEND_PACING_INTERVAL);
+                        TimeNow,
+                        CXPLAT_MAX(
+                            TimeNow + Builder.PacingInterval,
+                            Send->LastDepartureTime));
                     Result = QUIC_SEND_DELAYED_PACING;
                 } else {
                     //
@@ -1435,7 +1747,7 @@ QuicSendFlush(
                 // If the stream no longer has anything to send, remove it from the
                 // list and release Send's reference on it.
                 //
-                CxPlatListEntryRemove(&Stream->SendLink);
+                QuicSendRemoveStream(Send, Stream);
                 Stream->SendLink.Flink = NULL;
                 QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
                 Stream = NULL;
@@ -1482,7 +1794,7 @@ QuicSendFlush(
 #endif
 
     } while (Builder.SendData != NULL ||
-        Builder.TotalCountDatagrams < QUIC_MAX_DATAGRAMS_PER_SEND);
+        Builder.TotalCountDatagrams < Builder.MaxDatagrams);
 
     if (Builder.SendData != NULL) {
         //
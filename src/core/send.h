@@ -5,6 +5,10 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 #define SEND_PACKET_SHORT_HEADER_TYPE 0xff
 
 QUIC_INLINE
@@ -279,10 +283,18 @@ typedef struct QUIC_SEND {
     uint64_t NextSkippedPacketNumber;
 
     //
-    // Last time send flush occurred. Used for pacing calculations.
+    // Last time send flush occurred. Used for pacing calculations. May be in
+    // the future if paced sends were handed to the datapath with departure
+    // times.
     //
     uint64_t LastFlushTime;
 
+    //
+    // The latest departure time handed to the datapath. Later sends must not
+    // depart before it, or they would be reordered with the queued ones.
+    //
+    uint64_t LastDepartureTime;
+
     //
     // The total number of packets sent with each corresponding ECT codepoint in all encryption
     // level.
@@ -324,10 +336,34 @@ typedef struct QUIC_SEND {
     uint32_t SendFlags;
 
     //
-    // List of streams with data or control frames to send.
+    // List of streams with data or control frames to send, ordered from
+    // highest to lowest priority. For the weighted fair and deadline
+    // scheduling schemes, it is instead ordered by each stream's
+    // 'SendScheduleKey', from lowest to highest.
     //
     CXPLAT_LIST_ENTRY SendStreams;
 
+    //
+    // List of the first stream of each priority in 'SendStreams', ordered from
+    // highest to lowest priority. Used to find the end of a priority's streams
+    // without walking all the streams in 'SendStreams'.
+    //
+    CXPLAT_LIST_ENTRY SendPriorityGroups;
+
+    //
+    // List of streams that still have data queued to send, but are blocked by
+    // flow control. They are moved back to 'SendStreams' (at the end of their
+    // priority) when they might be able to send again.
+    //
+    CXPLAT_LIST_ENTRY BlockedSendStreams;
+
+    //
+    // The weighted fair queuing virtual time, which is the schedule key of the
+    // last stream picked to send. Newly queued streams start from here so that
+    // they don't get credit for the time they were idle.
+    //
+    uint64_t VirtualTime;
+
     //
     // The current token to send with an Initial packet.
     //
@@ -422,6 +458,62 @@ QuicSendQueueFlushForStream(
     _In_ BOOLEAN DelaySend
     );
 
+//
+// Moves the stream back to the send queue if it was blocked by flow control.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendUnblockStream(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    );
+
+//
+// Moves all streams blocked by flow control back to the send queue, in response
+// to the connection's flow control window opening.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendUnblockAllStreams(
+    _In_ QUIC_SEND* Send
+    );
+
+//
+// Reorders all the queued streams after the stream scheduling scheme changes.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendReorderStreams(
+    _In_ QUIC_SEND* Send
+    );
+
+//
+// Charges the stream for the stream data just written to a packet, updating
+// its place in the send queue if the scheduling scheme depends on it.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendOnStreamDataWritten(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint16_t Length
+    );
+
+//
+// Returns TRUE if any streams are queued to send, including those blocked by
+// flow control.
+//
+QUIC_INLINE
+BOOLEAN
+QuicSendHasQueuedStreams(
+    _In_ const QUIC_SEND* Send
+    )
+{
+    return
+        !CxPlatListIsEmpty(&Send->SendStreams) ||
+        !CxPlatListIsEmpty(&Send->BlockedSendStreams);
+}
+
 //
 // Updates the stream's order in response to a priority change.
 //
@@ -523,3 +615,7 @@ QuicSendClearStreamSendFlag(
     _In_ QUIC_STREAM* Stream,
     _In_ uint32_t SendFlag
     );
+
+#if defined(__cplusplus)
+}
+#endif
@@ -149,7 +149,17 @@ QuicSendBufferFill(
     CXPLAT_DBG_ASSERT(Connection->Settings.SendBufferingEnabled);
 
     Entry = Connection->Send.SendStreams.Flink;
-    while (QuicSendBufferHasSpace(&Connection->SendBuffer) && Entry != &(Connection->Send.SendStreams)) {
+    while (QuicSendBufferHasSpace(&Connection->SendBuffer)) {
+
+        if (Entry == &Connection->Send.SendStreams) {
+            //
+            // Streams blocked by flow control get their requests buffered too.
+            //
+            Entry = Connection->Send.BlockedSendStreams.Flink;
+        }
+        if (Entry == &Connection->Send.BlockedSendStreams) {
+            break;
+        }
 
         QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink);
         Entry = Entry->Flink;
@@ -134,3 +134,256 @@ QuicSentPacketPoolReturnPacketMetadata(
     QuicSentPacketMetadataReleaseFrames(Metadata, Connection);
     CxPlatPoolFree(Metadata);
 }
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSentPacketStoreInitialize(
+    _Out_ QUIC_SENT_PACKET_STORE* Store
+    )
+{
+#ifdef QUIC_SENT_PACKET_RING
+    Store->Slots = NULL;
+    Store->Mask = 0;
+    Store->Occupied = NULL;
+    Store->Count = 0;
+    Store->Base = 0;
+    Store->End = 0;
+#else
+    Store->Head = NULL;
+    Store->Tail = &Store->Head;
+#endif
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSentPacketStoreUninitialize(
+    _In_ QUIC_SENT_PACKET_STORE* Store
+    )
+{
+    CXPLAT_DBG_ASSERT(QuicSentPacketStoreIsEmpty(Store));
+#ifdef QUIC_SENT_PACKET_RING
+    if (Store->Slots != NULL) {
+        CXPLAT_FREE(Store->Slots, QUIC_POOL_SENT_PACKET_RING);
+        Store->Slots = NULL;
+        Store->Occupied = NULL;
+    }
+#else
+    UNREFERENCED_PARAMETER(Store);
+#endif
+}
+
+#ifdef QUIC_SENT_PACKET_RING
+
+QUIC_INLINE
+uint32_t
+QuicSentPacketRingLowestSetBit(
+    _In_ uint64_t Bits
+    )
+{
+    CXPLAT_DBG_ASSERT(Bits != 0);
+#ifdef _MSC_VER
+    unsigned long Index;
+    _BitScanForward64(&Index, Bits);
+    return (uint32_t)Index;
+#else
+    return (uint32_t)__builtin_ctzll(Bits);
+#endif
+}
+
+QUIC_INLINE
+uint32_t
+QuicSentPacketRingLeadingZeros(
+    _In_ uint64_t Bits
+    )
+{
+    CXPLAT_DBG_ASSERT(Bits != 0);
+#ifdef _MSC_VER
+    unsigned long Index;
+    _BitScanReverse64(&Index, Bits);
+    return 63 - (uint32_t)Index;
+#else
+    return (uint32_t)__builtin_clzll(Bits);
+#endif
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketRingScan(
+    _In_ const QUIC_SENT_PACKET_STORE* Store,
+    _Out_ QUIC_SENT_PACKET_CURSOR* Cursor,
+    _In_ uint64_t PacketNumber
+    )
+{
+    //
+    // N.B. Set bits after the current one in the same word that belong to
+    // packet numbers before Base always map to packet numbers at or after End,
+    // since the ring never covers more than its slot count.
+    //
+    PacketNumber = CXPLAT_MAX(PacketNumber, Store->Base);
+    while (PacketNumber < Store->End) {
+        const uint32_t Index = (uint32_t)(PacketNumber & Store->Mask);
+        const uint64_t Bits = Store->Occupied[Index / 64] >> (Index % 64);
+        if (Bits != 0) {
+            PacketNumber += QuicSentPacketRingLowestSetBit(Bits);
+            if (PacketNumber >= Store->End) {
+                break;
+            }
+            *Cursor = PacketNumber;
+            return QUIC_SENT_PACKET_RING_SLOT(Store, PacketNumber);
+        }
+        PacketNumber += 64 - (Index % 64);
+    }
+    *Cursor = Store->End;
+    return NULL;
+}
+
+//
+// Returns the largest packet number in the ring at or before the given one.
+// There must be one.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint64_t
+QuicSentPacketRingScanBack(
+    _In_ const QUIC_SENT_PACKET_STORE* Store,
+    _In_ uint64_t PacketNumber
+    )
+{
+    while (TRUE) {
+        CXPLAT_DBG_ASSERT(PacketNumber >= Store->Base);
+        const uint32_t Index = (uint32_t)(PacketNumber & Store->Mask);
+        const uint64_t Bits = Store->Occupied[Index / 64] << (63 - (Index % 64));
+        if (Bits != 0) {
+            return PacketNumber - QuicSentPacketRingLeadingZeros(Bits);
+        }
+        PacketNumber -= (Index % 64) + 1;
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketRingRemove(
+    _Inout_ QUIC_SENT_PACKET_STORE* Store,
+    _Inout_ QUIC_SENT_PACKET_CURSOR* Cursor
+    )
+{
+    const uint64_t PacketNumber = *Cursor;
+    const uint32_t Index = (uint32_t)(PacketNumber & Store->Mask);
+    CXPLAT_DBG_ASSERT(PacketNumber >= Store->Base && PacketNumber < Store->End);
+    CXPLAT_DBG_ASSERT(Store->Slots[Index] != NULL);
+
+    Store->Slots[Index] = NULL;
+    Store->Occupied[Index / 64] &= ~(1ull << (Index % 64));
+    if (--Store->Count == 0) {
+        Store->Base = Store->End;
+        *Cursor = Store->End;
+        return NULL;
+    }
+
+    if (PacketNumber + 1 == Store->End) {
+        Store->End = QuicSentPacketRingScanBack(Store, PacketNumber - 1) + 1;
+    }
+    QUIC_SENT_PACKET_METADATA* Packet =
+        QuicSentPacketRingScan(Store, Cursor, PacketNumber + 1);
+    if (PacketNumber == Store->Base) {
+        CXPLAT_DBG_ASSERT(Packet != NULL);
+        Store->Base = *Cursor;
+    }
+    return Packet;
+}
+
+//
+// Reallocates the ring so that it can cover a span of at least SpanLength
+// packet numbers.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicSentPacketRingGrow(
+    _Inout_ QUIC_SENT_PACKET_STORE* Store,
+    _In_ uint64_t SpanLength
+    )
+{
+    uint64_t NewCapacity =
+        Store->Slots == NULL ?
+            QUIC_SENT_PACKET_RING_INITIAL_CAPACITY :
+            ((uint64_t)Store->Mask + 1) * 2;
+    while (NewCapacity < SpanLength) {
+        NewCapacity *= 2;
+    }
+    if (NewCapacity > QUIC_SENT_PACKET_RING_MAX_CAPACITY) {
+        return FALSE;
+    }
+
+    const size_t AllocSize =
+        (size_t)NewCapacity * sizeof(QUIC_SENT_PACKET_METADATA*) +
+        (size_t)NewCapacity / 8;
+    QUIC_SENT_PACKET_METADATA** NewSlots =
+        CXPLAT_ALLOC_NONPAGED(AllocSize, QUIC_POOL_SENT_PACKET_RING);
+    if (NewSlots == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "sent packet ring",
+            (uint64_t)AllocSize);
+        return FALSE;
+    }
+    CxPlatZeroMemory(NewSlots, AllocSize);
+    uint64_t* NewOccupied = (uint64_t*)(NewSlots + NewCapacity);
+
+    const uint32_t NewMask = (uint32_t)(NewCapacity - 1);
+    if (Store->Slots != NULL) {
+        for (uint64_t PacketNumber = Store->Base; PacketNumber < Store->End; ++PacketNumber) {
+            QUIC_SENT_PACKET_METADATA* Packet =
+                QUIC_SENT_PACKET_RING_SLOT(Store, PacketNumber);
+            if (Packet != NULL) {
+                const uint32_t Index = (uint32_t)(PacketNumber & NewMask);
+                NewSlots[Index] = Packet;
+                NewOccupied[Index / 64] |= 1ull << (Index % 64);
+            }
+        }
+        CXPLAT_FREE(Store->Slots, QUIC_POOL_SENT_PACKET_RING);
+    }
+
+    Store->Slots = NewSlots;
+    Store->Mask = NewMask;
+    Store->Occupied = NewOccupied;
+    return TRUE;
+}
+
+#endif // QUIC_SENT_PACKET_RING
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicSentPacketStoreInsert(
+    _Inout_ QUIC_SENT_PACKET_STORE* Store,
+    _In_ QUIC_SENT_PACKET_METADATA* Packet
+    )
+{
+#ifdef QUIC_SENT_PACKET_RING
+    const uint64_t PacketNumber = Packet->PacketNumber;
+    uint64_t Base = PacketNumber;
+    uint64_t End = PacketNumber + 1;
+    if (Store->Count != 0) {
+        Base = CXPLAT_MIN(Base, Store->Base);
+        End = CXPLAT_MAX(End, Store->End);
+    }
+
+    if ((Store->Slots == NULL || End - Base > (uint64_t)Store->Mask + 1) &&
+        !QuicSentPacketRingGrow(Store, End - Base)) {
+        return FALSE;
+    }
+
+    const uint32_t Index = (uint32_t)(PacketNumber & Store->Mask);
+    CXPLAT_DBG_ASSERT(Store->Slots[Index] == NULL);
+    Store->Slots[Index] = Packet;
+    Store->Occupied[Index / 64] |= 1ull << (Index % 64);
+    Store->Count++;
+    Store->Base = Base;
+    Store->End = End;
+#else
+    Packet->Next = NULL;
+    *Store->Tail = Packet;
+    Store->Tail = &Packet->Next;
+#endif
+    return TRUE;
+}
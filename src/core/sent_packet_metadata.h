@@ -5,6 +5,10 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 //
 // The maximum number of frames we will write to a single packet.
 //
@@ -243,3 +247,256 @@ QuicSentPacketPoolReturnPacketMetadata(
     _In_ QUIC_SENT_PACKET_METADATA* Metadata,
     _In_ QUIC_CONNECTION* Connection
     );
+
+//
+// An ordered store of sent packet metadata, used by loss detection to track
+// outstanding and lost packets.
+//
+// By default, this is a singly-linked list through the metadata's Next field,
+// kept in the order the packets were inserted. With QUIC_SENT_PACKET_RING, it
+// is instead a ring of pointers indexed directly by packet number, always in
+// packet number order. Finding a packet (or the start of an ACK range) is O(1)
+// and scans walk an occupancy bitmap, 64 packet numbers at a time, instead of
+// chasing pointers. The cost is a pointer (and a bit) per packet number
+// between the oldest and newest packet in the store.
+//
+// Packets are visited with a QUIC_SENT_PACKET_CURSOR. The cursor stays valid
+// across removals done through it, but not across any other modification.
+//
+#ifdef QUIC_SENT_PACKET_RING
+
+//
+// The initial number of slots allocated for the ring. Must be a multiple of 64.
+//
+#define QUIC_SENT_PACKET_RING_INITIAL_CAPACITY  64
+
+//
+// The maximum span of packet numbers the ring can track, which bounds it to
+// about 520KB. That covers tens of MB in flight with full sized packets; beyond
+// it, new packets are handled as if lost right away.
+//
+#define QUIC_SENT_PACKET_RING_MAX_CAPACITY      0x10000
+
+typedef struct QUIC_SENT_PACKET_STORE {
+
+    //
+    // Power of two array of packets, indexed by packet number modulo the
+    // slot count. NULL until the first packet is inserted.
+    //
+    QUIC_SENT_PACKET_METADATA** Slots;
+    uint32_t Mask;
+
+    //
+    // One bit per slot, set if the slot has a packet. Shares the allocation
+    // with Slots.
+    //
+    uint64_t* Occupied;
+
+    //
+    // The number of packets in the ring.
+    //
+    uint32_t Count;
+
+    //
+    // The range of packet numbers [Base, End) currently covered by the ring.
+    // When the ring isn't empty, both the first and last packet numbers of the
+    // range always have a packet.
+    //
+    uint64_t Base;
+    uint64_t End;
+
+} QUIC_SENT_PACKET_STORE;
+
+//
+// The packet number of the current packet.
+//
+typedef uint64_t QUIC_SENT_PACKET_CURSOR;
+
+#define QUIC_SENT_PACKET_RING_SLOT(Store, PacketNumber) \
+    ((Store)->Slots[(PacketNumber) & (Store)->Mask])
+
+#else
+
+typedef struct QUIC_SENT_PACKET_STORE {
+
+    QUIC_SENT_PACKET_METADATA* Head;
+    QUIC_SENT_PACKET_METADATA** Tail;
+
+} QUIC_SENT_PACKET_STORE;
+
+//
+// The link pointing to the current packet.
+//
+typedef QUIC_SENT_PACKET_METADATA** QUIC_SENT_PACKET_CURSOR;
+
+#endif
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSentPacketStoreInitialize(
+    _Out_ QUIC_SENT_PACKET_STORE* Store
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSentPacketStoreUninitialize(
+    _In_ QUIC_SENT_PACKET_STORE* Store
+    );
+
+//
+// Adds the packet to the store. Only fails (with the ring) if the memory to
+// track the packet couldn't be allocated.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicSentPacketStoreInsert(
+    _Inout_ QUIC_SENT_PACKET_STORE* Store,
+    _In_ QUIC_SENT_PACKET_METADATA* Packet
+    );
+
+QUIC_INLINE
+BOOLEAN
+QuicSentPacketStoreIsEmpty(
+    _In_ const QUIC_SENT_PACKET_STORE* Store
+    )
+{
+#ifdef QUIC_SENT_PACKET_RING
+    return Store->Count == 0;
+#else
+    return Store->Head == NULL;
+#endif
+}
+
+#ifdef QUIC_SENT_PACKET_RING
+//
+// Moves the cursor to the first packet at or after the given packet number,
+// and returns it.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketRingScan(
+    _In_ const QUIC_SENT_PACKET_STORE* Store,
+    _Out_ QUIC_SENT_PACKET_CURSOR* Cursor,
+    _In_ uint64_t PacketNumber
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketRingRemove(
+    _Inout_ QUIC_SENT_PACKET_STORE* Store,
+    _Inout_ QUIC_SENT_PACKET_CURSOR* Cursor
+    );
+#endif
+
+//
+// Moves the cursor to the first packet in the store, and returns it.
+//
+QUIC_INLINE
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketStoreFirst(
+    _In_ QUIC_SENT_PACKET_STORE* Store,
+    _Out_ QUIC_SENT_PACKET_CURSOR* Cursor
+    )
+{
+#ifdef QUIC_SENT_PACKET_RING
+    return QuicSentPacketRingScan(Store, Cursor, Store->Base);
+#else
+    *Cursor = &Store->Head;
+    return Store->Head;
+#endif
+}
+
+//
+// Moves the cursor past the current packet, and returns the next one.
+//
+QUIC_INLINE
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketStoreNext(
+    _In_ QUIC_SENT_PACKET_STORE* Store,
+    _Inout_ QUIC_SENT_PACKET_CURSOR* Cursor
+    )
+{
+#ifdef QUIC_SENT_PACKET_RING
+    return QuicSentPacketRingScan(Store, Cursor, *Cursor + 1);
+#else
+    UNREFERENCED_PARAMETER(Store);
+    CXPLAT_DBG_ASSERT(**Cursor != NULL);
+    *Cursor = &(**Cursor)->Next;
+    return **Cursor;
+#endif
+}
+
+//
+// Moves the cursor forward to the first packet with a packet number at or
+// after the given one, and returns it. The cursor never moves backwards.
+//
+QUIC_INLINE
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketStoreSeek(
+    _In_ QUIC_SENT_PACKET_STORE* Store,
+    _Inout_ QUIC_SENT_PACKET_CURSOR* Cursor,
+    _In_ uint64_t PacketNumber
+    )
+{
+#ifdef QUIC_SENT_PACKET_RING
+    return
+        QuicSentPacketRingScan(
+            Store, Cursor, CXPLAT_MAX(PacketNumber, *Cursor));
+#else
+    UNREFERENCED_PARAMETER(Store);
+    while (**Cursor != NULL && (**Cursor)->PacketNumber < PacketNumber) {
+        *Cursor = &(**Cursor)->Next;
+    }
+    return **Cursor;
+#endif
+}
+
+//
+// Removes the current packet from the store, and returns the next one, which
+// the cursor now points to. The removed packet's Next field is undefined.
+//
+QUIC_INLINE
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketStoreRemove(
+    _In_ QUIC_SENT_PACKET_STORE* Store,
+    _Inout_ QUIC_SENT_PACKET_CURSOR* Cursor
+    )
+{
+#ifdef QUIC_SENT_PACKET_RING
+    return QuicSentPacketRingRemove(Store, Cursor);
+#else
+    QUIC_SENT_PACKET_METADATA* Packet = **Cursor;
+    CXPLAT_DBG_ASSERT(Packet != NULL);
+    **Cursor = Packet->Next;
+    if (Packet->Next == NULL) {
+        Store->Tail = *Cursor;
+    }
+    return **Cursor;
+#endif
+}
+
+//
+// Returns the last packet in the store, or NULL if the store is empty.
+//
+QUIC_INLINE
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketStoreLast(
+    _In_ const QUIC_SENT_PACKET_STORE* Store
+    )
+{
+#ifdef QUIC_SENT_PACKET_RING
+    return
+        Store->Count == 0 ?
+            NULL : QUIC_SENT_PACKET_RING_SLOT(Store, Store->End - 1);
+#else
+    return
+        Store->Head == NULL ?
+            NULL :
+            CXPLAT_CONTAINING_RECORD(Store->Tail, QUIC_SENT_PACKET_METADATA, Next);
+#endif
+}
+
+#if defined(__cplusplus)
+}
+#endif
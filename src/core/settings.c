@@ -150,6 +150,9 @@ QuicSettingsSetDefault(
     if (!Settings->IsSet.EcnEnabled) {
         Settings->EcnEnabled = QUIC_DEFAULT_ECN_ENABLED;
     }
+    if (!Settings->IsSet.EcnL4sEnabled) {
+        Settings->EcnL4sEnabled = QUIC_DEFAULT_ECN_L4S_ENABLED;
+    }
     if (!Settings->IsSet.HyStartEnabled) {
         Settings->HyStartEnabled = QUIC_DEFAULT_HYSTART_ENABLED;
     }
@@ -324,6 +327,9 @@ QuicSettingsCopy(
     if (!Destination->IsSet.EcnEnabled) {
         Destination->EcnEnabled = Source->EcnEnabled;
     }
+    if (!Destination->IsSet.EcnL4sEnabled) {
+        Destination->EcnL4sEnabled = Source->EcnL4sEnabled;
+    }
     if (!Destination->IsSet.HyStartEnabled) {
         Destination->HyStartEnabled = Source->HyStartEnabled;
     }
@@ -698,7 +704,11 @@ QuicSettingApply(
             Destination->EcnEnabled = Source->EcnEnabled;
             Destination->IsSet.EcnEnabled = TRUE;
         }
-    } else if (Source->IsSet.EcnEnabled) {
+        if (Source->IsSet.EcnL4sEnabled && (!Destination->IsSet.EcnL4sEnabled || OverWrite)) {
+            Destination->EcnL4sEnabled = Source->EcnL4sEnabled;
+            Destination->IsSet.EcnL4sEnabled = TRUE;
+        }
+    } else if (Source->IsSet.EcnEnabled || Source->IsSet.EcnL4sEnabled) {
         return FALSE;
     }
 
@@ -1357,6 +1367,16 @@ VersionSettingsFail:
             &ValueLen);
         Settings->EcnEnabled = !!Value;
     }
+    if (!Settings->IsSet.EcnL4sEnabled) {
+        Value = QUIC_DEFAULT_ECN_L4S_ENABLED;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_ECN_L4S_ENABLED,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->EcnL4sEnabled = !!Value;
+    }
     if (!Settings->IsSet.HyStartEnabled) {
         Value = QUIC_DEFAULT_HYSTART_ENABLED;
         ValueLen = sizeof(Value);
@@ -1500,6 +1520,7 @@ QuicSettingsDump(
     QuicTraceLogVerbose(SettingDestCidUpdateIdleTimeoutMs,  "[sett] DestCidUpdateIdleTimeoutMs = %u", Settings->DestCidUpdateIdleTimeoutMs);
     QuicTraceLogVerbose(SettingGreaseQuicBitEnabled,        "[sett] GreaseQuicBitEnabled   = %hhu", Settings->GreaseQuicBitEnabled);
     QuicTraceLogVerbose(SettingEcnEnabled,                  "[sett] EcnEnabled             = %hhu", Settings->EcnEnabled);
+    QuicTraceLogVerbose(SettingEcnL4sEnabled,               "[sett] EcnL4sEnabled          = %hhu", Settings->EcnL4sEnabled);
     QuicTraceLogVerbose(SettingHyStartEnabled,              "[sett] HyStartEnabled         = %hhu", Settings->HyStartEnabled);
     QuicTraceLogVerbose(SettingEncryptionOffloadAllowed,    "[sett] EncryptionOffloadAllowed = %hhu", Settings->EncryptionOffloadAllowed);
     QuicTraceLogVerbose(SettingReliableResetEnabled,        "[sett] ReliableResetEnabled   = %hhu", Settings->ReliableResetEnabled);
@@ -1654,6 +1675,9 @@ QuicSettingsDumpNew(
     if (Settings->IsSet.EcnEnabled) {
         QuicTraceLogVerbose(SettingEcnEnabled,                      "[sett] EcnEnabled             = %hhu", Settings->EcnEnabled);
     }
+    if (Settings->IsSet.EcnL4sEnabled) {
+        QuicTraceLogVerbose(SettingEcnL4sEnabled,                   "[sett] EcnL4sEnabled          = %hhu", Settings->EcnL4sEnabled);
+    }
     if (Settings->IsSet.HyStartEnabled) {
         QuicTraceLogVerbose(SettingHyStartEnabled,                  "[sett] HyStartEnabled         = %hhu", Settings->HyStartEnabled);
     }
@@ -1907,6 +1931,14 @@ QuicSettingsSettingsToInternal(
         SettingsSize,
         InternalSettings);
 
+    SETTING_COPY_FLAG_TO_INTERNAL_SIZED(
+        Flags,
+        EcnL4sEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
     SETTING_COPY_FLAG_TO_INTERNAL_SIZED(
         Flags,
         OneWayDelayEnabled,
@@ -2092,6 +2124,14 @@ QuicSettingsGetSettings(
         *SettingsLength,
         InternalSettings);
 
+    SETTING_COPY_FLAG_FROM_INTERNAL_SIZED(
+        Flags,
+        EcnL4sEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
     SETTING_COPY_FLAG_FROM_INTERNAL_SIZED(
         Flags,
         OneWayDelayEnabled,
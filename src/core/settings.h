@@ -64,7 +64,8 @@ typedef struct QUIC_SETTINGS_INTERNAL {
             uint64_t StreamMultiReceiveEnabled              : 1;
             uint64_t XdpEnabled                             : 1;
             uint64_t QTIPEnabled                            : 1;
-            uint64_t RESERVED                               : 14;
+            uint64_t EcnL4sEnabled                          : 1;
+            uint64_t RESERVED                               : 13;
         } IsSet;
     };
 
@@ -117,6 +118,7 @@ typedef struct QUIC_SETTINGS_INTERNAL {
     uint8_t StreamMultiReceiveEnabled       : 1;
     uint8_t XdpEnabled                      : 1;
     uint8_t QTIPEnabled                     : 1;
+    uint8_t EcnL4sEnabled                   : 1;
     uint8_t MtuDiscoveryMissingProbeCount;
 } QUIC_SETTINGS_INTERNAL;
 
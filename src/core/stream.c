@@ -29,10 +29,13 @@ QuicStreamInitialize(
     QUIC_STREAM* Stream;
     QUIC_RECV_CHUNK* PreallocatedRecvChunk = NULL;
 
-    Stream = CxPlatPoolAlloc(&Connection->Partition->StreamPool);
+    Stream = QuicConnArenaAllocStream(Connection);
     if (Stream == NULL) {
-        Status = QUIC_STATUS_OUT_OF_MEMORY;
-        goto Exit;
+        Stream = CxPlatPoolAlloc(&Connection->Partition->StreamPool);
+        if (Stream == NULL) {
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Exit;
+        }
     }
 
     QuicTraceEvent(
@@ -131,17 +134,31 @@ QuicStreamInitialize(
 
     if (InitialRecvBufferLength == QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE &&
         RecvBufferMode != QUIC_RECV_BUF_MODE_APP_OWNED) {
-        PreallocatedRecvChunk =
-            CxPlatPoolAlloc(&Connection->Partition->DefaultReceiveBufferPool);
-        if (PreallocatedRecvChunk == NULL) {
-            Status = QUIC_STATUS_OUT_OF_MEMORY;
-            goto Exit;
+        if (QuicConnArenaContains(Connection, Stream)) {
+            QUIC_CONN_ARENA_STREAM* ArenaStream =
+                CXPLAT_CONTAINING_RECORD(Stream, QUIC_CONN_ARENA_STREAM, Stream);
+            PreallocatedRecvChunk = &ArenaStream->RecvChunk;
+            QuicRecvChunkInitialize(
+                PreallocatedRecvChunk,
+                InitialRecvBufferLength,
+                ArenaStream->RecvBuffer,
+                FALSE);
+            PreallocatedRecvChunk->AllocatedInArena = TRUE;
+            QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_CONN_ARENA_ALLOC);
+        } else {
+            PreallocatedRecvChunk =
+                CxPlatPoolAlloc(&Connection->Partition->DefaultReceiveBufferPool);
+            if (PreallocatedRecvChunk == NULL) {
+                Status = QUIC_STATUS_OUT_OF_MEMORY;
+                goto Exit;
+            }
+            QuicRecvChunkInitialize(
+                PreallocatedRecvChunk,
+                InitialRecvBufferLength,
+                (uint8_t *)(PreallocatedRecvChunk + 1),
+                TRUE);
+            QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_CONN_ARENA_OVERFLOW);
         }
-        QuicRecvChunkInitialize(
-            PreallocatedRecvChunk,
-            InitialRecvBufferLength,
-            (uint8_t *)(PreallocatedRecvChunk + 1),
-            TRUE);
     }
 
     const uint32_t FlowControlWindowSize = Stream->Flags.Unidirectional
@@ -173,6 +190,9 @@ QuicStreamInitialize(
 
 Exit:
 
+    if (PreallocatedRecvChunk) {
+        QuicRecvChunkFree(PreallocatedRecvChunk);
+    }
     if (Stream) {
 #if DEBUG
         CXPLAT_DBG_ASSERT(!CxPlatRefDecrement(&Stream->RefTypeBiasedCount[QUIC_STREAM_REF_APP]));
@@ -184,10 +204,9 @@ Exit:
         QuicPerfCounterDecrement(Connection->Partition, QUIC_PERF_COUNTER_STRM_ACTIVE);
         CxPlatDispatchLockUninitialize(&Stream->ApiSendRequestLock);
         Stream->Flags.Freed = TRUE;
-        CxPlatPoolFree(Stream);
-    }
-    if (PreallocatedRecvChunk) {
-        CxPlatPoolFree(PreallocatedRecvChunk);
+        if (!QuicConnArenaFreeStream(Connection, Stream)) {
+            CxPlatPoolFree(Stream);
+        }
     }
 
     return Status;
@@ -229,7 +248,9 @@ QuicStreamFree(
     CxPlatRefUninitialize(&Stream->RefCount);
 
     Stream->Flags.Freed = TRUE;
-    CxPlatPoolFree(Stream);
+    if (!QuicConnArenaFreeStream(Connection, Stream)) {
+        CxPlatPoolFree(Stream);
+    }
 
     if (WasStarted) {
 #pragma warning(push)
@@ -749,6 +770,21 @@ QuicStreamParamSet(
         Status = QUIC_STATUS_SUCCESS;
         break;
 
+    case QUIC_PARAM_STREAM_SEND_DEADLINE:
+
+        if (BufferLength != sizeof(Stream->SendDeadlineUs) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        //
+        // Only applies to sends queued after this point.
+        //
+        Stream->SendDeadlineUs = *(uint64_t*)Buffer;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
     default:
         Status = QUIC_STATUS_INVALID_PARAMETER;
         break;
@@ -947,6 +983,25 @@ QuicStreamParamGet(
         Status = QUIC_STATUS_SUCCESS;
         break;
 
+    case QUIC_PARAM_STREAM_SEND_DEADLINE:
+
+        if (*BufferLength < sizeof(Stream->SendDeadlineUs)) {
+            *BufferLength = sizeof(Stream->SendDeadlineUs);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(Stream->SendDeadlineUs);
+        *(uint64_t*)Buffer = Stream->SendDeadlineUs;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
     case QUIC_PARAM_STREAM_RELIABLE_OFFSET_RECV:
         if (*BufferLength < sizeof(uint64_t)) {
             *BufferLength = sizeof(uint64_t);
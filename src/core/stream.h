@@ -9,6 +9,10 @@
 #include "stream.h.clog.h"
 #endif
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 typedef struct QUIC_CONNECTION QUIC_CONNECTION;
 
 //
@@ -99,6 +103,12 @@ typedef struct QUIC_SEND_REQUEST {
     //
     void* ClientContext;
 
+    //
+    // The absolute time (in microseconds) the request should be sent by, for
+    // the deadline scheduling scheme. Zero if there is no deadline.
+    //
+    uint64_t Deadline;
+
 } QUIC_SEND_REQUEST;
 
 //
@@ -159,6 +169,8 @@ typedef union QUIC_STREAM_FLAGS {
         BOOLEAN InStreamTable           : 1;    // The stream is currently in the connection's table.
         BOOLEAN InWaitingList           : 1;    // The stream is currently in the waiting list for stream id FC.
         BOOLEAN DelayIdFcUpdate         : 1;    // Delay stream ID FC updates to StreamClose.
+
+        BOOLEAN SendBlocked             : 1;    // Queued in the blocked send list, waiting on flow control.
     };
 } QUIC_STREAM_FLAGS;
 
@@ -260,6 +272,12 @@ typedef struct QUIC_STREAM {
     //
     CXPLAT_LIST_ENTRY SendLink;
 
+    //
+    // The list entry in the output module's priority group list, if this is
+    // the first queued stream of its priority. Otherwise, Flink is NULL.
+    //
+    CXPLAT_LIST_ENTRY SendPriorityLink;
+
 #if DEBUG
     //
     // The list entry in the stream set's list of all allocated streams.
@@ -310,6 +328,15 @@ typedef struct QUIC_STREAM {
     CXPLAT_DISPATCH_LOCK ApiSendRequestLock;
     QUIC_SEND_REQUEST* ApiSendRequests;
 
+    //
+    // Set while the stream is on a queued STRM_SEND operation. Sends on
+    // different streams queued back to back share a single operation, which
+    // chains the streams through ApiSendNext. Both are protected by
+    // ApiSendRequestLock once the operation has been dequeued.
+    //
+    BOOLEAN ApiSendQueued;
+    QUIC_STREAM* ApiSendNext;
+
     //
     // Queued send requests.
     //
@@ -398,6 +425,18 @@ typedef struct QUIC_STREAM {
     //
     uint16_t SendPriority;
 
+    //
+    // The deadline (in microseconds) given to each send request queued on the
+    // stream, relative to when it is queued. Zero if there is no deadline.
+    //
+    uint64_t SendDeadlineUs;
+
+    //
+    // The key the stream is ordered by in the send queue for the weighted fair
+    // (virtual start time) and deadline (absolute deadline) scheduling schemes.
+    //
+    uint64_t SendScheduleKey;
+
     //
     // Recv State
     //
@@ -906,6 +945,18 @@ QuicStreamSendFlush(
     _In_ QUIC_STREAM* Stream
     );
 
+//
+// Flushes the queued API sends of every stream on a STRM_SEND operation,
+// starting with Stream. The operation reference on Stream is released with
+// the operation, the references on the streams chained after it are released
+// here.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicStreamSendFlushChain(
+    _In_ QUIC_STREAM* Stream
+    );
+
 //
 // Copies the bytes of a send request and completes it early.
 //
@@ -1077,3 +1128,7 @@ QuicStreamNotifyReceiveBufferNeeded(
     _In_ QUIC_STREAM* Stream,
     _In_ uint64_t BufferLengthNeeded
     );
+
+#if defined(__cplusplus)
+}
+#endif
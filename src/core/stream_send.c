@@ -551,6 +551,17 @@ QuicStreamEnqueueSendRequest(
 
     SendRequest->StreamOffset = Stream->QueuedSendOffset;
     Stream->QueuedSendOffset += SendRequest->TotalLength;
+    SendRequest->Deadline = 0;
+    if (Stream->SendDeadlineUs != 0) {
+        //
+        // Saturate, as the app can set any relative deadline. A deadline that
+        // far out is no different from none.
+        //
+        const uint64_t TimeNow = CxPlatTimeUs64();
+        SendRequest->Deadline =
+            Stream->SendDeadlineUs < UINT64_MAX - TimeNow ?
+                TimeNow + Stream->SendDeadlineUs : UINT64_MAX;
+    }
 
     if (SendRequest->Flags & QUIC_SEND_FLAG_ALLOW_0_RTT &&
         Stream->Queued0Rtt == SendRequest->StreamOffset) {
@@ -680,6 +691,32 @@ QuicStreamSendFlush(
         TotalBytesSent);
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicStreamSendFlushChain(
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    QUIC_STREAM* First = Stream;
+    do {
+        //
+        // Take the stream off the operation before flushing it. From then on
+        // a new StreamSend call queues (or coalesces) a new operation for it.
+        //
+        CxPlatDispatchLockAcquire(&Stream->ApiSendRequestLock);
+        QUIC_STREAM* Next = Stream->ApiSendNext;
+        Stream->ApiSendNext = NULL;
+        Stream->ApiSendQueued = FALSE;
+        CxPlatDispatchLockRelease(&Stream->ApiSendRequestLock);
+
+        QuicStreamSendFlush(Stream);
+        if (Stream != First) {
+            QuicStreamRelease(Stream, QUIC_STREAM_REF_OPERATION);
+        }
+        Stream = Next;
+    } while (Stream != NULL);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicStreamCopyFromSendRequests(
@@ -1206,6 +1243,9 @@ QuicStreamSendWrite(
                 Stream->SendFlags &= ~QUIC_STREAM_SEND_FLAG_DATA;
             }
 
+            QuicSendOnStreamDataWritten(
+                &Stream->Connection->Send, Stream, StreamFrameLength);
+
             if (Builder->Metadata->FrameCount == QUIC_MAX_FRAMES_PER_PACKET) {
                 return TRUE;
             }
@@ -413,6 +413,7 @@ QuicStreamSetInitializeTransportParameters(
             Stream->MaxAllowedSendOffset = NewMaxAllowedSendOffset;
             FlowBlockedFlagsToRemove |= QUIC_FLOW_BLOCKED_STREAM_FLOW_CONTROL;
             Stream->SendWindow = (uint32_t)CXPLAT_MIN(Stream->MaxAllowedSendOffset, UINT32_MAX);
+            QuicSendUnblockStream(&Connection->Send, Stream);
         }
 
         if (FlowBlockedFlagsToRemove) {
@@ -43,6 +43,13 @@ Abstract:
     updating the timer wheel's next expiration if this connection was currently
     next to expire.
 
+    When built with QUIC_HIERARCHICAL_TIMER_WHEEL, a multi-level timer wheel
+    with millisecond granularity is used instead. Each level's slots are
+    unsorted lists, so insertion and removal are O(1). Connections in the upper
+    levels are cascaded down to lower levels as time advances, which amortizes
+    to at most one move per level per connection. There is no resizing, so the
+    cost of an update doesn't depend on the number of connections.
+
 --*/
 
 #include "precomp.h"
@@ -50,6 +57,453 @@ Abstract:
 #include "timer_wheel.c.clog.h"
 #endif
 
+#ifdef QUIC_HIERARCHICAL_TIMER_WHEEL
+
+#define QUIC_TIMER_WHEEL_LEVEL_MASK     ((uint64_t)QUIC_TIMER_WHEEL_LEVEL_SLOTS - 1)
+
+//
+// Helper to get the span (in ms) of a single slot at a given level.
+//
+#define LEVEL_SLOT_SPAN_MS(Level) (1ull << ((Level) * QUIC_TIMER_WHEEL_LEVEL_BITS))
+
+//
+// Helper to get the slot index of a time (in ms) at a given level.
+//
+#define TIME_MS_TO_LEVEL_SLOT_INDEX(TimeMs, Level) \
+    ((uint32_t)(((TimeMs) >> ((Level) * QUIC_TIMER_WHEEL_LEVEL_BITS)) & QUIC_TIMER_WHEEL_LEVEL_MASK))
+
+QUIC_INLINE
+uint32_t
+QuicTimerWheelLowestSetBit(
+    _In_ uint64_t Mask
+    )
+{
+    CXPLAT_DBG_ASSERT(Mask != 0);
+#ifdef _MSC_VER
+    unsigned long Index;
+    _BitScanForward64(&Index, Mask);
+    return (uint32_t)Index;
+#else
+    return (uint32_t)__builtin_ctzll(Mask);
+#endif
+}
+
+QUIC_INLINE
+uint32_t
+QuicTimerWheelHighestSetBit(
+    _In_ uint64_t Mask
+    )
+{
+    CXPLAT_DBG_ASSERT(Mask != 0);
+#ifdef _MSC_VER
+    unsigned long Index;
+    _BitScanReverse64(&Index, Mask);
+    return (uint32_t)Index;
+#else
+    return 63 - (uint32_t)__builtin_clzll(Mask);
+#endif
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicTimerWheelInitialize(
+    _Inout_ QUIC_TIMER_WHEEL* TimerWheel
+    )
+{
+    TimerWheel->NextExpirationTime = UINT64_MAX;
+    TimerWheel->ConnectionCount = 0;
+    TimerWheel->CurrentMs = US_TO_MS(CxPlatTimeUs64());
+    CxPlatListInitializeHead(&TimerWheel->Overflow);
+    for (uint32_t i = 0; i < QUIC_TIMER_WHEEL_LEVEL_COUNT; ++i) {
+        TimerWheel->Occupied[i] = 0;
+        for (uint32_t j = 0; j < QUIC_TIMER_WHEEL_LEVEL_SLOTS; ++j) {
+            CxPlatListInitializeHead(&TimerWheel->Levels[i][j]);
+        }
+    }
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTimerWheelUninitializeList(
+    _In_ CXPLAT_LIST_ENTRY* ListHead
+    )
+{
+    CXPLAT_LIST_ENTRY* Entry = ListHead->Flink;
+    while (Entry != ListHead) {
+        QUIC_CONNECTION* Connection =
+            CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, TimerLink);
+        QuicTraceLogConnWarning(
+            StillInTimerWheel,
+            Connection,
+            "Still in timer wheel! Connection was likely leaked!");
+        CXPLAT_DBG_ASSERT(!Connection);
+        Entry = Entry->Flink;
+    }
+    CXPLAT_TEL_ASSERT(CxPlatListIsEmpty(ListHead));
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTimerWheelUninitialize(
+    _Inout_ QUIC_TIMER_WHEEL* TimerWheel
+    )
+{
+    for (uint32_t i = 0; i < QUIC_TIMER_WHEEL_LEVEL_COUNT; ++i) {
+        for (uint32_t j = 0; j < QUIC_TIMER_WHEEL_LEVEL_SLOTS; ++j) {
+            QuicTimerWheelUninitializeList(&TimerWheel->Levels[i][j]);
+        }
+    }
+    QuicTimerWheelUninitializeList(&TimerWheel->Overflow);
+    CXPLAT_TEL_ASSERT(TimerWheel->ConnectionCount == 0);
+    CXPLAT_TEL_ASSERT(TimerWheel->NextExpirationTime == UINT64_MAX);
+}
+
+//
+// Places the connection in the slot for its expiration time, relative to the
+// timer wheel's current time.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTimerWheelInsert(
+    _Inout_ QUIC_TIMER_WHEEL* TimerWheel,
+    _Inout_ QUIC_CONNECTION* Connection
+    )
+{
+    uint64_t ExpirationMs = US_TO_MS(Connection->EarliestExpirationTime);
+    if (ExpirationMs < TimerWheel->CurrentMs) {
+        ExpirationMs = TimerWheel->CurrentMs; // Already expired.
+    }
+
+    //
+    // The level is determined by the most significant digit (of
+    // QUIC_TIMER_WHEEL_LEVEL_BITS bits) that differs from the current time.
+    //
+    const uint64_t Diff = ExpirationMs ^ TimerWheel->CurrentMs;
+    const uint32_t Level =
+        Diff == 0 ?
+            0 : QuicTimerWheelHighestSetBit(Diff) / QUIC_TIMER_WHEEL_LEVEL_BITS;
+
+    if (Level >= QUIC_TIMER_WHEEL_LEVEL_COUNT) {
+        CxPlatListInsertTail(&TimerWheel->Overflow, &Connection->TimerLink);
+    } else {
+        const uint32_t SlotIndex = TIME_MS_TO_LEVEL_SLOT_INDEX(ExpirationMs, Level);
+        CxPlatListInsertTail(&TimerWheel->Levels[Level][SlotIndex], &Connection->TimerLink);
+        TimerWheel->Occupied[Level] |= 1ull << SlotIndex;
+    }
+}
+
+//
+// Returns the (possibly stale) occupied bits of the slots at or after the
+// given index.
+//
+QUIC_INLINE
+uint64_t
+QuicTimerWheelOccupiedFrom(
+    _In_ const QUIC_TIMER_WHEEL* TimerWheel,
+    _In_ uint32_t Level,
+    _In_ uint32_t SlotIndex
+    )
+{
+    if (SlotIndex >= QUIC_TIMER_WHEEL_LEVEL_SLOTS) {
+        return 0;
+    }
+    return TimerWheel->Occupied[Level] & (UINT64_MAX << SlotIndex);
+}
+
+//
+// Returns the next time (in ms) at which connections in the upper levels (or
+// the overflow list) need to be cascaded down, or UINT64_MAX if there are no
+// such connections.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint64_t
+QuicTimerWheelNextCascadeTime(
+    _Inout_ QUIC_TIMER_WHEEL* TimerWheel
+    )
+{
+    for (uint32_t Level = 1; Level < QUIC_TIMER_WHEEL_LEVEL_COUNT; ++Level) {
+        //
+        // All connections in this level are in slots after the current one.
+        //
+        uint64_t Bits =
+            QuicTimerWheelOccupiedFrom(
+                TimerWheel,
+                Level,
+                TIME_MS_TO_LEVEL_SLOT_INDEX(TimerWheel->CurrentMs, Level) + 1);
+        while (Bits != 0) {
+            const uint32_t SlotIndex = QuicTimerWheelLowestSetBit(Bits);
+            if (!CxPlatListIsEmpty(&TimerWheel->Levels[Level][SlotIndex])) {
+                const uint64_t SpanStart =
+                    TimerWheel->CurrentMs & ~(LEVEL_SLOT_SPAN_MS(Level + 1) - 1);
+                return SpanStart + SlotIndex * LEVEL_SLOT_SPAN_MS(Level);
+            }
+            TimerWheel->Occupied[Level] &= ~(1ull << SlotIndex);
+            Bits &= Bits - 1;
+        }
+    }
+
+    if (!CxPlatListIsEmpty(&TimerWheel->Overflow)) {
+        return
+            (TimerWheel->CurrentMs | (LEVEL_SLOT_SPAN_MS(QUIC_TIMER_WHEEL_LEVEL_COUNT) - 1)) + 1;
+    }
+
+    return UINT64_MAX;
+}
+
+//
+// Moves all connections in the list to the slots for their expiration times.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTimerWheelCascade(
+    _Inout_ QUIC_TIMER_WHEEL* TimerWheel,
+    _Inout_ CXPLAT_LIST_ENTRY* ListHead
+    )
+{
+    CXPLAT_LIST_ENTRY Cascading;
+    CxPlatListInitializeHead(&Cascading);
+    CxPlatListMoveItems(ListHead, &Cascading);
+    while (!CxPlatListIsEmpty(&Cascading)) {
+        QUIC_CONNECTION* Connection =
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&Cascading),
+                QUIC_CONNECTION,
+                TimerLink);
+        QuicTimerWheelInsert(TimerWheel, Connection);
+    }
+}
+
+//
+// Called to recalculate NextExpirationTime.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTimerWheelUpdate(
+    _Inout_ QUIC_TIMER_WHEEL* TimerWheel
+    )
+{
+    TimerWheel->NextExpirationTime = UINT64_MAX;
+
+    if (TimerWheel->ConnectionCount != 0) {
+        //
+        // The first non-empty slot in level 0 has the earliest expiration, but
+        // since a slot spans a full millisecond, its connections must be
+        // compared.
+        //
+        uint64_t Bits =
+            QuicTimerWheelOccupiedFrom(
+                TimerWheel,
+                0,
+                TIME_MS_TO_LEVEL_SLOT_INDEX(TimerWheel->CurrentMs, 0));
+        while (Bits != 0 && TimerWheel->NextExpirationTime == UINT64_MAX) {
+            const uint32_t SlotIndex = QuicTimerWheelLowestSetBit(Bits);
+            CXPLAT_LIST_ENTRY* ListHead = &TimerWheel->Levels[0][SlotIndex];
+            if (CxPlatListIsEmpty(ListHead)) {
+                TimerWheel->Occupied[0] &= ~(1ull << SlotIndex);
+            }
+            for (CXPLAT_LIST_ENTRY* Entry = ListHead->Flink; Entry != ListHead; Entry = Entry->Flink) {
+                QUIC_CONNECTION* ConnectionEntry =
+                    CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, TimerLink);
+                if (ConnectionEntry->EarliestExpirationTime < TimerWheel->NextExpirationTime) {
+                    TimerWheel->NextExpirationTime = ConnectionEntry->EarliestExpirationTime;
+                }
+            }
+            Bits &= Bits - 1;
+        }
+
+        if (TimerWheel->NextExpirationTime == UINT64_MAX) {
+            //
+            // Otherwise, wake up when the next upper level slot is cascaded.
+            //
+            const uint64_t NextCascadeTime = QuicTimerWheelNextCascadeTime(TimerWheel);
+            CXPLAT_DBG_ASSERT(NextCascadeTime != UINT64_MAX);
+            if (NextCascadeTime != UINT64_MAX) {
+                TimerWheel->NextExpirationTime = MS_TO_US(NextCascadeTime);
+            }
+        }
+    }
+
+    if (TimerWheel->NextExpirationTime == UINT64_MAX) {
+        QuicTraceLogVerbose(
+            TimerWheelNextExpirationNull,
+            "[time][%p] Next Expiration = {NULL}.",
+            TimerWheel);
+    } else {
+        QuicTraceLogVerbose(
+            TimerWheelNextExpiration,
+            "[time][%p] Next Expiration = {%llu, %p}.",
+            TimerWheel,
+            TimerWheel->NextExpirationTime,
+            NULL);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTimerWheelRemoveConnection(
+    _Inout_ QUIC_TIMER_WHEEL* TimerWheel,
+    _Inout_ QUIC_CONNECTION* Connection
+    )
+{
+    if (Connection->TimerLink.Flink != NULL) {
+        QuicTraceLogVerbose(
+            TimerWheelRemoveConnection,
+            "[time][%p] Removing Connection %p.",
+            TimerWheel,
+            Connection);
+        CxPlatListEntryRemove(&Connection->TimerLink);
+        Connection->TimerLink.Flink = NULL;
+        TimerWheel->ConnectionCount--;
+
+        //
+        // NextExpirationTime is left as is, as it is still a lower bound.
+        //
+        if (TimerWheel->ConnectionCount == 0) {
+            TimerWheel->NextExpirationTime = UINT64_MAX;
+        }
+
+        QuicConnRelease(Connection, QUIC_CONN_REF_TIMER_WHEEL);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTimerWheelUpdateConnection(
+    _Inout_ QUIC_TIMER_WHEEL* TimerWheel,
+    _Inout_ QUIC_CONNECTION* Connection
+    )
+{
+    uint64_t ExpirationTime = Connection->EarliestExpirationTime;
+
+    if (Connection->TimerLink.Flink != NULL) {
+        if (ExpirationTime == UINT64_MAX || Connection->State.ShutdownComplete) {
+            QuicTimerWheelRemoveConnection(TimerWheel, Connection);
+            return; // Nothing else to do.
+        }
+
+        CxPlatListEntryRemove(&Connection->TimerLink);
+
+    } else if (ExpirationTime != UINT64_MAX && !Connection->State.ShutdownComplete) {
+        //
+        // It wasn't in the wheel already, so we must be adding it to the wheel.
+        //
+        TimerWheel->ConnectionCount++;
+        QuicConnAddRef(Connection, QUIC_CONN_REF_TIMER_WHEEL);
+
+    } else {
+        return; // Ignore
+    }
+
+    QuicTimerWheelInsert(TimerWheel, Connection);
+
+    QuicTraceLogVerbose(
+        TimerWheelUpdateConnection,
+        "[time][%p] Updating Connection %p.",
+        TimerWheel,
+        Connection);
+
+    if (ExpirationTime < TimerWheel->NextExpirationTime) {
+        TimerWheel->NextExpirationTime = ExpirationTime;
+        QuicTraceLogVerbose(
+            TimerWheelNextExpiration,
+            "[time][%p] Next Expiration = {%llu, %p}.",
+            TimerWheel,
+            ExpirationTime,
+            Connection);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTimerWheelGetExpired(
+    _Inout_ QUIC_TIMER_WHEEL* TimerWheel,
+    _In_ uint64_t TimeNow,
+    _Inout_ CXPLAT_LIST_ENTRY* OutputListHead
+    )
+{
+    uint64_t NowMs = US_TO_MS(TimeNow);
+    if (NowMs < TimerWheel->CurrentMs) {
+        NowMs = TimerWheel->CurrentMs;
+    }
+
+    while (TRUE) {
+        //
+        // Expire the level 0 slots up to the current time, or the end of the
+        // current level 0 span.
+        //
+        const BOOLEAN SameSpan =
+            (TimerWheel->CurrentMs ^ NowMs) < QUIC_TIMER_WHEEL_LEVEL_SLOTS;
+        const uint32_t LastSlotIndex =
+            SameSpan ?
+                TIME_MS_TO_LEVEL_SLOT_INDEX(NowMs, 0) :
+                QUIC_TIMER_WHEEL_LEVEL_SLOTS - 1;
+        uint64_t Bits =
+            QuicTimerWheelOccupiedFrom(
+                TimerWheel,
+                0,
+                TIME_MS_TO_LEVEL_SLOT_INDEX(TimerWheel->CurrentMs, 0));
+        if (LastSlotIndex < QUIC_TIMER_WHEEL_LEVEL_SLOTS - 1) {
+            Bits &= (1ull << (LastSlotIndex + 1)) - 1;
+        }
+
+        while (Bits != 0) {
+            const uint32_t SlotIndex = QuicTimerWheelLowestSetBit(Bits);
+            CXPLAT_LIST_ENTRY* ListHead = &TimerWheel->Levels[0][SlotIndex];
+            CXPLAT_LIST_ENTRY* Entry = ListHead->Flink;
+            while (Entry != ListHead) {
+                QUIC_CONNECTION* ConnectionEntry =
+                    CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, TimerLink);
+                Entry = Entry->Flink;
+                if (ConnectionEntry->EarliestExpirationTime > TimeNow) {
+                    continue; // Only possible in the slot for NowMs.
+                }
+                CxPlatListEntryRemove(&ConnectionEntry->TimerLink);
+                CxPlatListInsertTail(OutputListHead, &ConnectionEntry->TimerLink);
+                QuicConnAddRef(ConnectionEntry, QUIC_CONN_REF_WORKER);
+                QuicConnRelease(ConnectionEntry, QUIC_CONN_REF_TIMER_WHEEL);
+                TimerWheel->ConnectionCount--;
+            }
+            if (CxPlatListIsEmpty(ListHead)) {
+                TimerWheel->Occupied[0] &= ~(1ull << SlotIndex);
+            }
+            Bits &= Bits - 1;
+        }
+
+        if (SameSpan) {
+            TimerWheel->CurrentMs = NowMs;
+            break;
+        }
+
+        //
+        // Level 0 is now empty. Skip ahead to the next time connections need
+        // to be cascaded down from the upper levels.
+        //
+        const uint64_t NextCascadeTime = QuicTimerWheelNextCascadeTime(TimerWheel);
+        if (NextCascadeTime > NowMs) {
+            TimerWheel->CurrentMs = NowMs;
+            break;
+        }
+
+        TimerWheel->CurrentMs = NextCascadeTime;
+        if ((NextCascadeTime & (LEVEL_SLOT_SPAN_MS(QUIC_TIMER_WHEEL_LEVEL_COUNT) - 1)) == 0) {
+            QuicTimerWheelCascade(TimerWheel, &TimerWheel->Overflow);
+        }
+        for (uint32_t Level = QUIC_TIMER_WHEEL_LEVEL_COUNT - 1; Level > 0; --Level) {
+            if ((NextCascadeTime & (LEVEL_SLOT_SPAN_MS(Level) - 1)) == 0) {
+                const uint32_t SlotIndex = TIME_MS_TO_LEVEL_SLOT_INDEX(NextCascadeTime, Level);
+                QuicTimerWheelCascade(TimerWheel, &TimerWheel->Levels[Level][SlotIndex]);
+                TimerWheel->Occupied[Level] &= ~(1ull << SlotIndex);
+            }
+        }
+    }
+
+    QuicTimerWheelUpdate(TimerWheel);
+}
+
+#else // QUIC_HIERARCHICAL_TIMER_WHEEL
+
 //
 // The initial count of slots in the timer wheel.
 //
@@ -433,3 +887,5 @@ QuicTimerWheelGetExpired(
         QuicTimerWheelUpdate(TimerWheel);
     }
 }
+
+#endif // QUIC_HIERARCHICAL_TIMER_WHEEL
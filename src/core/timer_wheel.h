@@ -5,13 +5,35 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 typedef struct QUIC_CONNECTION QUIC_CONNECTION;
 
+#ifdef QUIC_HIERARCHICAL_TIMER_WHEEL
+
+//
+// The hierarchical timer wheel has QUIC_TIMER_WHEEL_LEVEL_COUNT levels of
+// QUIC_TIMER_WHEEL_LEVEL_SLOTS slots each. Level 0 slots are 1 ms wide and
+// each level above is QUIC_TIMER_WHEEL_LEVEL_SLOTS times coarser, for a total
+// range of 2^30 ms (~12 days). Anything further out sits in an overflow list.
+//
+#define QUIC_TIMER_WHEEL_LEVEL_BITS     6
+#define QUIC_TIMER_WHEEL_LEVEL_SLOTS    (1 << QUIC_TIMER_WHEEL_LEVEL_BITS)
+#define QUIC_TIMER_WHEEL_LEVEL_COUNT    5
+
+#endif
+
 typedef struct QUIC_TIMER_WHEEL {
 
     //
     // The expiration time (in us) for the next timer in the timer wheel.
     //
+    // N.B. For the hierarchical timer wheel this may be earlier than the
+    // actual next expiration (but never later), as timers in the upper levels
+    // are only tracked at slot granularity.
+    //
     uint64_t NextExpirationTime;
 
     //
@@ -19,6 +41,32 @@ typedef struct QUIC_TIMER_WHEEL {
     //
     uint64_t ConnectionCount;
 
+#ifdef QUIC_HIERARCHICAL_TIMER_WHEEL
+
+    //
+    // The time (in ms) the timer wheel has been advanced to. All slots before
+    // this have already been expired or cascaded to lower levels.
+    //
+    uint64_t CurrentMs;
+
+    //
+    // Per-level bit masks of (possibly) non-empty slots. Bits are cleared
+    // lazily, when an empty slot is found while searching.
+    //
+    uint64_t Occupied[QUIC_TIMER_WHEEL_LEVEL_COUNT];
+
+    //
+    // Connections that expire beyond the range of the top level.
+    //
+    CXPLAT_LIST_ENTRY Overflow;
+
+    //
+    // The (unsorted) slots for each level.
+    //
+    CXPLAT_LIST_ENTRY Levels[QUIC_TIMER_WHEEL_LEVEL_COUNT][QUIC_TIMER_WHEEL_LEVEL_SLOTS];
+
+#else
+
     //
     // The connection with the timer that expires next.
     //
@@ -34,6 +82,8 @@ typedef struct QUIC_TIMER_WHEEL {
     //
     CXPLAT_LIST_ENTRY* Slots;
 
+#endif
+
 } QUIC_TIMER_WHEEL;
 
 //
@@ -85,3 +135,7 @@ QuicTimerWheelGetExpired(
     _In_ uint64_t TimeNow,
     _Inout_ CXPLAT_LIST_ENTRY* ListHead
     );
+
+#if defined(__cplusplus)
+}
+#endif
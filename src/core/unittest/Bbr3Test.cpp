@@ -0,0 +1,781 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit tests for BBRv3 congestion control.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "Bbr3Test.cpp.clog.h"
+#endif
+
+#include <list>
+#include <vector>
+
+extern "C" {
+void Bbr3CongestionControlInitialize(QUIC_CONGESTION_CONTROL* Cc, const QUIC_SETTINGS_INTERNAL* Settings);
+void BbrCongestionControlInitialize(QUIC_CONGESTION_CONTROL* Cc, const QUIC_SETTINGS_INTERNAL* Settings);
+void CubicCongestionControlInitialize(QUIC_CONGESTION_CONTROL* Cc, const QUIC_SETTINGS_INTERNAL* Settings);
+}
+
+//
+// State definitions mirrored from bbr3.c for readable assertions.
+//
+enum BBR3_STATE {
+    BBR3_STATE_STARTUP          = 0,
+    BBR3_STATE_DRAIN            = 1,
+    BBR3_STATE_PROBE_BW_DOWN    = 2,
+    BBR3_STATE_PROBE_BW_CRUISE  = 3,
+    BBR3_STATE_PROBE_BW_REFILL  = 4,
+    BBR3_STATE_PROBE_BW_UP      = 5,
+    BBR3_STATE_PROBE_RTT        = 6
+};
+
+enum BBR3_RECOVERY_STATE {
+    BBR3_RECOVERY_STATE_NOT_RECOVERY = 0,
+    BBR3_RECOVERY_STATE_CONSERVATIVE = 1,
+    BBR3_RECOVERY_STATE_GROWTH       = 2
+};
+
+static const uint32_t kGainUnit = 256;
+static const uint64_t kBwUnit = 8;
+
+static void InitBbr3MockConnection(
+    QUIC_CONNECTION& Connection,
+    uint16_t Mtu,
+    bool PacingEnabled)
+{
+    Connection.Paths[0].Mtu = Mtu;
+    Connection.Paths[0].IsActive = TRUE;
+    Connection.Settings.PacingEnabled = PacingEnabled ? TRUE : FALSE;
+    Connection.Settings.HyStartEnabled = FALSE;
+    Connection.Settings.NetStatsEventEnabled = FALSE;
+    Connection.Send.PeerMaxData = UINT64_MAX;
+}
+
+//
+// GoogleTest fixture for BBRv3 congestion control tests.
+//
+class Bbr3Test : public ::testing::Test {
+protected:
+    QUIC_CONNECTION Connection{};
+    QUIC_SETTINGS_INTERNAL Settings{};
+    QUIC_CONGESTION_CONTROL_BBR3* Bbr;
+    QUIC_CONGESTION_CONTROL* CC;
+    uint16_t Mss;
+    uint64_t TimeNow;
+    uint64_t NextPacketNumber;
+
+    static const uint64_t kRate = 1250 * 1000; // 10 Mbps, in bytes per second
+    static const uint64_t kMinRtt = 40 * 1000;
+    static const uint32_t kRoundBytes = 12500;
+
+    void InitializeWithDefaults(bool PacingEnabled = false)
+    {
+        Settings.InitialWindowPackets = 10;
+        InitBbr3MockConnection(Connection, 1280, PacingEnabled);
+        CC = &Connection.CongestionControl;
+        Bbr3CongestionControlInitialize(CC, &Settings);
+        Bbr = &CC->Bbr3;
+        Mss = QuicPathGetDatagramPayloadSize(&Connection.Paths[0]);
+        TimeNow = 1000000;
+        NextPacketNumber = 1;
+    }
+
+    uint64_t MaxBw() const
+    {
+        return CXPLAT_MAX(Bbr->MaxBwFilter[0], Bbr->MaxBwFilter[1]);
+    }
+
+    //
+    // Sends and acknowledges one packet carrying Bytes, sampled at Rate bytes
+    // per second. Every call acknowledges a packet sent after the previous
+    // ACK, so each one starts a new round trip. ExtraInflight bytes are sent
+    // (and left in flight) before the ACK.
+    //
+    void PumpRound(
+        uint64_t Rate = kRate,
+        uint32_t Bytes = kRoundBytes,
+        uint64_t AdvanceUs = kMinRtt,
+        uint32_t ExtraInflight = 0)
+    {
+        TimeNow += AdvanceUs;
+        uint64_t ElapsedUs = (uint64_t)Bytes * 1000000 / Rate;
+
+        QUIC_MAX_SENT_PACKET_METADATA PacketBuf{};
+        auto& Packet = PacketBuf.Metadata;
+        Packet.PacketNumber = NextPacketNumber;
+        Packet.PacketLength = (uint16_t)Bytes;
+        Packet.Flags.HasLastAckedPacketInfo = TRUE;
+        Packet.TotalBytesSent = 10000 + Bytes;
+        Packet.SentTime = TimeNow - kMinRtt;
+        Packet.LastAckedPacketInfo.TotalBytesSent = 10000;
+        Packet.LastAckedPacketInfo.SentTime = Packet.SentTime - ElapsedUs;
+        Packet.LastAckedPacketInfo.AdjustedAckTime = TimeNow - ElapsedUs;
+        Packet.LastAckedPacketInfo.AckTime = TimeNow - ElapsedUs;
+
+        CC->QuicCongestionControlOnDataSent(CC, Bytes);
+        if (ExtraInflight != 0) {
+            CC->QuicCongestionControlOnDataSent(CC, ExtraInflight);
+        }
+
+        QUIC_ACK_EVENT Ack{};
+        Ack.TimeNow = TimeNow;
+        Ack.AdjustedAckTime = TimeNow;
+        Ack.LargestAck = NextPacketNumber;
+        Ack.LargestSentPacketNumber = NextPacketNumber;
+        Ack.NumRetransmittableBytes = Bytes;
+        Ack.NumTotalAckedRetransmittableBytes = Bytes;
+        Ack.AckedPackets = &Packet;
+        Ack.SmoothedRtt = kMinRtt;
+        Ack.MinRtt = kMinRtt;
+        Ack.MinRttValid = TRUE;
+        NextPacketNumber++;
+
+        CC->QuicCongestionControlOnDataAcknowledged(CC, &Ack);
+    }
+
+    void Lose(uint32_t Bytes, uint64_t LargestSentPacketNumber)
+    {
+        QUIC_LOSS_EVENT Loss{};
+        Loss.NumRetransmittableBytes = Bytes;
+        Loss.LargestPacketNumberLost = NextPacketNumber - 1;
+        Loss.LargestSentPacketNumber = LargestSentPacketNumber;
+        CC->QuicCongestionControlOnDataLost(CC, &Loss);
+    }
+
+    void MarkCe(uint64_t Count = 1)
+    {
+        QUIC_ECN_EVENT Ecn{};
+        Ecn.LargestPacketNumberAcked = NextPacketNumber - 1;
+        Ecn.LargestSentPacketNumber = NextPacketNumber - 1;
+        Ecn.NewCeCount = Count;
+        CC->QuicCongestionControlOnEcn(CC, &Ecn);
+    }
+
+    //
+    // Four rounds at a constant rate: one to fill the bandwidth filter and
+    // three without growth to detect the plateau. With nothing left in
+    // flight DRAIN and PROBE_BW_DOWN are passed through on the same ACK.
+    //
+    void DriveToProbeBw()
+    {
+        for (int i = 0; i < 4; ++i) {
+            PumpRound();
+        }
+        ASSERT_TRUE(Bbr->FullBwReached);
+        ASSERT_EQ((uint32_t)BBR3_STATE_PROBE_BW_CRUISE, Bbr->BbrState);
+    }
+
+    //
+    // The wall clock probe wait is at most 3 seconds, so waiting longer
+    // always starts a probe. The following round moves on to PROBE_BW_UP.
+    //
+    void DriveToProbeUp()
+    {
+        DriveToProbeBw();
+        PumpRound(kRate, kRoundBytes, 3100 * 1000);
+        ASSERT_EQ((uint32_t)BBR3_STATE_PROBE_BW_REFILL, Bbr->BbrState);
+        PumpRound();
+        ASSERT_EQ((uint32_t)BBR3_STATE_PROBE_BW_UP, Bbr->BbrState);
+    }
+};
+
+TEST_F(Bbr3Test, Initialize)
+{
+    InitializeWithDefaults();
+
+    ASSERT_STREQ("BBRv3", CC->Name);
+    ASSERT_NE(nullptr, CC->QuicCongestionControlOnEcn);
+    ASSERT_EQ((uint32_t)BBR3_STATE_STARTUP, Bbr->BbrState);
+    ASSERT_EQ(10u * Mss, Bbr->CongestionWindow);
+    ASSERT_EQ(UINT32_MAX, Bbr->InflightHi);
+    ASSERT_EQ(UINT32_MAX, Bbr->InflightLo);
+    ASSERT_EQ(UINT64_MAX, Bbr->BwLo);
+    ASSERT_EQ(kGainUnit, Bbr->EcnAlpha);
+    ASSERT_FALSE(Bbr->FullBwReached);
+    ASSERT_TRUE(CC->QuicCongestionControlCanSend(CC));
+}
+
+TEST_F(Bbr3Test, SelectedBySettings)
+{
+    InitBbr3MockConnection(Connection, 1280, false);
+    Settings.InitialWindowPackets = 10;
+    Settings.CongestionControlAlgorithm = QUIC_CONGESTION_CONTROL_ALGORITHM_BBR3;
+    QuicCongestionControlInitialize(&Connection.CongestionControl, &Settings);
+    ASSERT_STREQ("BBRv3", Connection.CongestionControl.Name);
+}
+
+TEST_F(Bbr3Test, L4sFallsBackToClassicEcn)
+{
+    //
+    // BBRv3 has no scalable response to CE marks, so it must not have the
+    // connection send ECT(1), even after replacing Cubic with L4S enabled.
+    //
+    InitBbr3MockConnection(Connection, 1280, false);
+    Settings.InitialWindowPackets = 10;
+    Settings.EcnL4sEnabled = TRUE;
+    Settings.CongestionControlAlgorithm = QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC;
+    QuicCongestionControlInitialize(&Connection.CongestionControl, &Settings);
+    ASSERT_TRUE(Connection.CongestionControl.L4sEnabled);
+
+    Settings.CongestionControlAlgorithm = QUIC_CONGESTION_CONTROL_ALGORITHM_BBR3;
+    QuicCongestionControlInitialize(&Connection.CongestionControl, &Settings);
+    ASSERT_STREQ("BBRv3", Connection.CongestionControl.Name);
+    ASSERT_FALSE(Connection.CongestionControl.L4sEnabled);
+}
+
+TEST_F(Bbr3Test, StartupExitsOnBandwidthPlateau)
+{
+    InitializeWithDefaults();
+
+    PumpRound();
+    PumpRound();
+    PumpRound();
+    ASSERT_EQ((uint32_t)BBR3_STATE_STARTUP, Bbr->BbrState);
+    ASSERT_EQ(2u, (uint32_t)Bbr->FullBwCount);
+
+    PumpRound();
+    ASSERT_TRUE(Bbr->FullBwReached);
+    ASSERT_EQ((uint32_t)BBR3_STATE_PROBE_BW_CRUISE, Bbr->BbrState);
+    ASSERT_EQ(kBwUnit * kRate, MaxBw());
+}
+
+TEST_F(Bbr3Test, StartupStaysWhileBandwidthGrows)
+{
+    InitializeWithDefaults();
+
+    uint64_t Rate = kRate;
+    for (int i = 0; i < 6; ++i) {
+        PumpRound(Rate);
+        Rate *= 2;
+    }
+    ASSERT_EQ((uint32_t)BBR3_STATE_STARTUP, Bbr->BbrState);
+    ASSERT_FALSE(Bbr->FullBwReached);
+}
+
+TEST_F(Bbr3Test, StartupExitsOnHeavyLoss)
+{
+    InitializeWithDefaults();
+
+    PumpRound();
+    CC->QuicCongestionControlOnDataSent(CC, 20 * Mss);
+    Lose(8 * Mss, NextPacketNumber - 1);
+    ASSERT_EQ((uint32_t)BBR3_STATE_STARTUP, Bbr->BbrState);
+
+    //
+    // The loss is acted on when the round ends, even though bandwidth is
+    // still growing.
+    //
+    PumpRound(2 * kRate);
+    ASSERT_TRUE(Bbr->FullBwReached);
+    ASSERT_NE(UINT32_MAX, Bbr->InflightHi);
+    ASSERT_NE((uint32_t)BBR3_STATE_STARTUP, Bbr->BbrState);
+}
+
+TEST_F(Bbr3Test, StartupExitsOnPersistentEcn)
+{
+    InitializeWithDefaults();
+
+    PumpRound();
+    MarkCe();
+    PumpRound(2 * kRate);
+    ASSERT_EQ((uint32_t)BBR3_STATE_STARTUP, Bbr->BbrState);
+    ASSERT_EQ(1u, (uint32_t)Bbr->StartupEcnRounds);
+
+    MarkCe();
+    PumpRound(4 * kRate);
+    ASSERT_TRUE(Bbr->FullBwReached);
+    ASSERT_NE((uint32_t)BBR3_STATE_STARTUP, Bbr->BbrState);
+}
+
+TEST_F(Bbr3Test, ProbeBwCycle)
+{
+    InitializeWithDefaults();
+    DriveToProbeUp();
+
+    ASSERT_EQ(kGainUnit * 5 / 4, Bbr->PacingGain);
+    ASSERT_TRUE(Bbr->BwProbeSamples);
+
+    //
+    // UP ends once inflight reached 1.25 BDP and it's been more than MinRtt.
+    //
+    const uint32_t Backlog = 100000;
+    PumpRound(kRate, kRoundBytes, 2 * kMinRtt, Backlog);
+    ASSERT_EQ((uint32_t)BBR3_STATE_PROBE_BW_DOWN, Bbr->BbrState);
+    ASSERT_LT(Bbr->PacingGain, kGainUnit);
+
+    //
+    // DOWN holds until the queue built by the probe has drained.
+    //
+    PumpRound();
+    ASSERT_EQ((uint32_t)BBR3_STATE_PROBE_BW_DOWN, Bbr->BbrState);
+
+    CC->QuicCongestionControlOnDataInvalidated(CC, Backlog);
+    PumpRound();
+    ASSERT_EQ((uint32_t)BBR3_STATE_PROBE_BW_CRUISE, Bbr->BbrState);
+    ASSERT_EQ(kGainUnit, Bbr->PacingGain);
+}
+
+TEST_F(Bbr3Test, HighLossWhileProbingSetsInflightHi)
+{
+    InitializeWithDefaults();
+    DriveToProbeUp();
+
+    const uint32_t Inflight = 100 * Mss;
+    CC->QuicCongestionControlOnDataSent(CC, Inflight);
+    Lose(5 * Mss, NextPacketNumber + 100);
+
+    ASSERT_EQ(Inflight, Bbr->InflightHi);
+    ASSERT_FALSE(Bbr->BwProbeSamples);
+    ASSERT_EQ((uint32_t)BBR3_STATE_PROBE_BW_DOWN, Bbr->BbrState);
+}
+
+TEST_F(Bbr3Test, LowLossWhileProbingIsTolerated)
+{
+    InitializeWithDefaults();
+    DriveToProbeUp();
+
+    CC->QuicCongestionControlOnDataSent(CC, 100 * Mss);
+    Lose(Mss, NextPacketNumber + 100);
+
+    ASSERT_EQ(UINT32_MAX, Bbr->InflightHi);
+    ASSERT_TRUE(Bbr->BwProbeSamples);
+    ASSERT_EQ((uint32_t)BBR3_STATE_PROBE_BW_UP, Bbr->BbrState);
+}
+
+TEST_F(Bbr3Test, LossWhileCruisingLowersBounds)
+{
+    InitializeWithDefaults();
+    DriveToProbeBw();
+
+    const uint32_t CongestionWindow = Bbr->CongestionWindow;
+    CC->QuicCongestionControlOnDataSent(CC, 10 * Mss);
+    Lose(Mss, NextPacketNumber - 1);
+
+    //
+    // Outside of a probe, loss doesn't touch the model until the round ends.
+    //
+    ASSERT_EQ(UINT32_MAX, Bbr->InflightLo);
+    ASSERT_EQ(UINT32_MAX, Bbr->InflightHi);
+
+    //
+    // Nothing was delivered in the lossy round (the congestion signals were
+    // reset when PROBE_BW_DOWN started) so both bounds are cut by beta.
+    //
+    PumpRound();
+    const uint32_t Beta = kGainUnit * 7 / 10;
+    ASSERT_EQ(CongestionWindow * Beta / kGainUnit, Bbr->InflightLo);
+    ASSERT_LE(Bbr->CongestionWindow, Bbr->InflightLo);
+    ASSERT_EQ(MaxBw() * Beta / kGainUnit, Bbr->BwLo);
+    ASSERT_EQ(UINT32_MAX, Bbr->InflightHi);
+
+    //
+    // The next probe starts from a clean slate.
+    //
+    PumpRound(kRate, kRoundBytes, 3100 * 1000);
+    ASSERT_EQ((uint32_t)BBR3_STATE_PROBE_BW_REFILL, Bbr->BbrState);
+    ASSERT_EQ(UINT32_MAX, Bbr->InflightLo);
+    ASSERT_EQ(UINT64_MAX, Bbr->BwLo);
+}
+
+TEST_F(Bbr3Test, EcnScalesInflightLo)
+{
+    InitializeWithDefaults();
+    DriveToProbeBw();
+
+    const uint32_t CongestionWindow = Bbr->CongestionWindow;
+    MarkCe();
+    ASSERT_EQ(1u, Connection.Stats.Send.EcnCongestionCount);
+
+    //
+    // Every delivered packet of the round was marked, so alpha stays at 1 and
+    // the window is reduced by the full ECN factor of 1/3.
+    //
+    PumpRound();
+    ASSERT_EQ(kGainUnit, Bbr->EcnAlpha);
+    const uint32_t Expected = CXPLAT_MAX(
+        CongestionWindow * (kGainUnit - kGainUnit / 3) / kGainUnit,
+        4u * Mss);
+    ASSERT_EQ(Expected, Bbr->InflightLo);
+    ASSERT_EQ(MaxBw(), Bbr->BwLo);
+    ASSERT_EQ(0u, Connection.Stats.Send.CongestionCount);
+
+    //
+    // Alpha then decays by 1/16 for each round without marks.
+    //
+    PumpRound();
+    ASSERT_EQ(kGainUnit - kGainUnit / 16, Bbr->EcnAlpha);
+    PumpRound();
+    ASSERT_EQ(225u, Bbr->EcnAlpha);
+    ASSERT_EQ(Expected, Bbr->InflightLo);
+}
+
+TEST_F(Bbr3Test, CruiseLeavesHeadroomBelowInflightHi)
+{
+    InitializeWithDefaults();
+    DriveToProbeBw();
+
+    Bbr->InflightHi = 30 * Mss;
+    PumpRound();
+
+    const uint32_t Headroom = CXPLAT_MAX(
+        Bbr->InflightHi * (kGainUnit * 15 / 100) / kGainUnit, (uint32_t)Mss);
+    ASSERT_EQ(Bbr->InflightHi - Headroom, Bbr->CongestionWindow);
+}
+
+TEST_F(Bbr3Test, SpuriousLossRestoresBounds)
+{
+    InitializeWithDefaults();
+    DriveToProbeBw();
+
+    CC->QuicCongestionControlOnDataSent(CC, 10 * Mss);
+    Lose(Mss, NextPacketNumber + 10);
+    PumpRound();
+    ASSERT_NE(UINT32_MAX, Bbr->InflightLo);
+    ASSERT_EQ((uint32_t)BBR3_RECOVERY_STATE_GROWTH, Bbr->RecoveryState);
+
+    CC->QuicCongestionControlOnSpuriousCongestionEvent(CC);
+    ASSERT_EQ((uint32_t)BBR3_RECOVERY_STATE_NOT_RECOVERY, Bbr->RecoveryState);
+    ASSERT_EQ(UINT32_MAX, Bbr->InflightLo);
+    ASSERT_EQ(UINT64_MAX, Bbr->BwLo);
+    ASSERT_FALSE(CC->QuicCongestionControlOnSpuriousCongestionEvent(CC));
+}
+
+TEST_F(Bbr3Test, ProbeRtt)
+{
+    InitializeWithDefaults();
+    DriveToProbeBw();
+
+    const uint32_t CongestionWindow = CC->QuicCongestionControlGetCongestionWindow(CC);
+    PumpRound(kRate, kRoundBytes, 5 * 1000 * 1000);
+    ASSERT_EQ((uint32_t)BBR3_STATE_PROBE_RTT, Bbr->BbrState);
+    ASSERT_LT(CC->QuicCongestionControlGetCongestionWindow(CC), CongestionWindow);
+    ASSERT_TRUE(Bbr->ProbeRttEndTimeValid);
+
+    //
+    // Held for at least a round trip and 200ms.
+    //
+    PumpRound(kRate, kRoundBytes, 100 * 1000);
+    ASSERT_EQ((uint32_t)BBR3_STATE_PROBE_RTT, Bbr->BbrState);
+
+    PumpRound(kRate, kRoundBytes, 150 * 1000);
+    ASSERT_EQ((uint32_t)BBR3_STATE_PROBE_BW_CRUISE, Bbr->BbrState);
+    ASSERT_EQ(TimeNow, Bbr->ProbeRttMinTimestamp);
+}
+
+TEST_F(Bbr3Test, PacingAllowance)
+{
+    InitializeWithDefaults(true);
+    DriveToProbeBw();
+
+    //
+    // Cruising paces at the estimated bandwidth less a 1% margin.
+    //
+    const uint64_t PacingRate = MaxBw() * 99 / 100;
+    ASSERT_EQ(
+        (uint32_t)(PacingRate * 500 / 1000000 / kBwUnit),
+        CC->QuicCongestionControlGetSendAllowance(CC, 500, TRUE));
+
+    //
+    // Without a valid time since the last send, the whole window is allowed.
+    //
+    ASSERT_EQ(
+        CC->QuicCongestionControlGetCongestionWindow(CC),
+        CC->QuicCongestionControlGetSendAllowance(CC, 500, FALSE));
+}
+
+//
+// Packet level simulation of a FIFO bottleneck with a drop tail buffer, used
+// to compare the algorithms end to end. All times are in microseconds.
+//
+struct Bbr3SimLink {
+    uint64_t RateBytesPerSec;
+    uint32_t BufferBytes;
+    uint64_t OneWayDelayUs;
+    uint32_t RandomLossPerMille;
+    uint32_t RandomState;
+    double BusyUntil;
+
+    //
+    // Returns the time the ACK for a packet sent at TimeNow arrives back at
+    // the sender, or 0 if the packet is dropped.
+    //
+    uint64_t Transmit(uint64_t TimeNow, uint16_t Length)
+    {
+        double Start = CXPLAT_MAX(BusyUntil, (double)TimeNow);
+        double Queued = (Start - (double)TimeNow) * RateBytesPerSec / 1e6;
+        if (Queued + Length > BufferBytes) {
+            return 0;
+        }
+        BusyUntil = Start + Length * 1e6 / RateBytesPerSec;
+
+        RandomState ^= RandomState << 13;
+        RandomState ^= RandomState >> 17;
+        RandomState ^= RandomState << 5;
+        if (RandomState % 1000 < RandomLossPerMille) {
+            return 0;
+        }
+
+        return (uint64_t)BusyUntil + 2 * OneWayDelayUs;
+    }
+};
+
+struct Bbr3SimPacket {
+    QUIC_MAX_SENT_PACKET_METADATA Buffer;
+    uint64_t AckTime;
+    bool Done;
+};
+
+//
+// A sender with infinite data, doing the loss detection and delivery rate
+// bookkeeping of loss_detection.c in simplified form.
+//
+struct Bbr3SimFlow {
+    QUIC_CONNECTION* Connection;
+    QUIC_CONGESTION_CONTROL* Cc;
+    uint16_t Mss;
+    std::list<Bbr3SimPacket> Outstanding;
+
+    uint64_t NextPacketNumber {0};
+    uint64_t LargestAcked {0};
+    bool HasLargestAcked {false};
+    uint64_t SmoothedRtt {333 * 1000};
+    uint64_t MinRtt {UINT64_MAX};
+    uint64_t LastSendTime {0};
+    bool HasSent {false};
+
+    uint64_t TotalBytesSent {0};
+    uint64_t TotalBytesAcked {0};
+    uint64_t TotalBytesLost {0};
+    uint64_t TotalBytesSentAtLastAck {0};
+    uint64_t TimeOfLastPacketAcked {0};
+    uint64_t TimeOfLastAckedPacketSent {0};
+
+    Bbr3SimFlow(
+        void (*Initialize)(QUIC_CONGESTION_CONTROL*, const QUIC_SETTINGS_INTERNAL*)
+        )
+    {
+        Connection = new QUIC_CONNECTION();
+        InitBbr3MockConnection(*Connection, 1280, true);
+        QUIC_SETTINGS_INTERNAL Settings{};
+        Settings.InitialWindowPackets = 10;
+        Cc = &Connection->CongestionControl;
+        Initialize(Cc, &Settings);
+        Mss = QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+    }
+
+    ~Bbr3SimFlow() { delete Connection; }
+
+    void OnAcksAndLosses(uint64_t TimeNow)
+    {
+        QUIC_SENT_PACKET_METADATA* AckedPackets = NULL;
+        QUIC_SENT_PACKET_METADATA** Tail = &AckedPackets;
+        uint32_t AckedBytes = 0;
+
+        for (auto& Packet : Outstanding) {
+            auto& Metadata = Packet.Buffer.Metadata;
+            if (Packet.AckTime == 0 || Packet.AckTime > TimeNow) {
+                continue;
+            }
+            Packet.Done = true;
+            Metadata.Next = NULL;
+            *Tail = &Metadata;
+            Tail = &Metadata.Next;
+            AckedBytes += Metadata.PacketLength;
+
+            TotalBytesAcked += Metadata.PacketLength;
+            TotalBytesSentAtLastAck = Metadata.TotalBytesSent;
+            TimeOfLastPacketAcked = TimeNow;
+            TimeOfLastAckedPacketSent = Metadata.SentTime;
+            LargestAcked = Metadata.PacketNumber;
+            HasLargestAcked = true;
+
+            uint64_t Rtt = TimeNow - Metadata.SentTime;
+            MinRtt = CXPLAT_MIN(MinRtt, Rtt);
+            SmoothedRtt = TotalBytesAcked == Metadata.PacketLength ?
+                Rtt : (7 * SmoothedRtt + Rtt) / 8;
+        }
+
+        //
+        // Packet threshold of 3, time threshold of 9/8 RTT and a simple
+        // timeout in place of a PTO.
+        //
+        uint32_t LostBytes = 0;
+        uint64_t LargestLost = 0;
+        for (auto& Packet : Outstanding) {
+            auto& Metadata = Packet.Buffer.Metadata;
+            if (Packet.Done) {
+                continue;
+            }
+            bool Lost =
+                TimeNow >= Metadata.SentTime + 3 * SmoothedRtt ||
+                (HasLargestAcked && Metadata.PacketNumber < LargestAcked &&
+                 (Metadata.PacketNumber + 3 <= LargestAcked ||
+                  TimeNow >= Metadata.SentTime + SmoothedRtt * 9 / 8));
+            if (Lost) {
+                Packet.Done = true;
+                LostBytes += Metadata.PacketLength;
+                LargestLost = Metadata.PacketNumber;
+            }
+        }
+
+        if (LostBytes != 0) {
+            TotalBytesLost += LostBytes;
+            QUIC_LOSS_EVENT Loss{};
+            Loss.LargestPacketNumberLost = LargestLost;
+            Loss.LargestSentPacketNumber = NextPacketNumber - 1;
+            Loss.NumRetransmittableBytes = LostBytes;
+            Cc->QuicCongestionControlOnDataLost(Cc, &Loss);
+        }
+
+        if (AckedBytes != 0) {
+            Connection->Paths[0].GotFirstRttSample = TRUE;
+            Connection->Paths[0].SmoothedRtt = SmoothedRtt;
+            Connection->Paths[0].MinRtt = MinRtt;
+
+            QUIC_ACK_EVENT Ack{};
+            Ack.TimeNow = TimeNow;
+            Ack.AdjustedAckTime = TimeNow;
+            Ack.LargestAck = LargestAcked;
+            Ack.LargestSentPacketNumber = NextPacketNumber - 1;
+            Ack.NumRetransmittableBytes = AckedBytes;
+            Ack.NumTotalAckedRetransmittableBytes = TotalBytesAcked;
+            Ack.AckedPackets = AckedPackets;
+            Ack.SmoothedRtt = SmoothedRtt;
+            Ack.MinRtt = MinRtt;
+            Ack.MinRttValid = TRUE;
+            Ack.HasLoss = LostBytes != 0;
+            Cc->QuicCongestionControlOnDataAcknowledged(Cc, &Ack);
+        }
+
+        Outstanding.remove_if([](const Bbr3SimPacket& Packet) { return Packet.Done; });
+    }
+
+    void Send(uint64_t TimeNow, Bbr3SimLink& Link)
+    {
+        uint32_t Allowance =
+            Cc->QuicCongestionControlGetSendAllowance(
+                Cc, TimeNow - LastSendTime, HasSent ? TRUE : FALSE);
+
+        //
+        // Only whole datagrams are sent; any remainder of the allowance
+        // carries over by not resetting the time of the last send.
+        //
+        while (Allowance >= Mss && Cc->QuicCongestionControlCanSend(Cc)) {
+            Outstanding.emplace_back();
+            auto& Packet = Outstanding.back();
+            auto& Metadata = Packet.Buffer.Metadata;
+
+            TotalBytesSent += Mss;
+            Metadata.PacketNumber = NextPacketNumber++;
+            Metadata.PacketLength = Mss;
+            Metadata.SentTime = TimeNow;
+            Metadata.TotalBytesSent = TotalBytesSent;
+            if (TimeOfLastPacketAcked != 0) {
+                Metadata.Flags.HasLastAckedPacketInfo = TRUE;
+                Metadata.LastAckedPacketInfo.SentTime = TimeOfLastAckedPacketSent;
+                Metadata.LastAckedPacketInfo.AckTime = TimeOfLastPacketAcked;
+                Metadata.LastAckedPacketInfo.AdjustedAckTime = TimeOfLastPacketAcked;
+                Metadata.LastAckedPacketInfo.TotalBytesSent = TotalBytesSentAtLastAck;
+                Metadata.LastAckedPacketInfo.TotalBytesAcked = TotalBytesAcked;
+            }
+            Packet.AckTime = Link.Transmit(TimeNow, Mss);
+            Packet.Done = false;
+
+            Connection->LossDetection.LargestSentPacketNumber = Metadata.PacketNumber;
+            Cc->QuicCongestionControlOnDataSent(Cc, Mss);
+            Allowance -= Mss;
+            LastSendTime = TimeNow;
+            HasSent = true;
+        }
+    }
+};
+
+static void
+Bbr3SimRun(
+    Bbr3SimLink& Link,
+    std::vector<Bbr3SimFlow*>& Flows,
+    uint64_t DurationUs
+    )
+{
+    const uint64_t TickUs = 100;
+    const uint64_t StartTime = 1000000;
+    uint64_t Tick = 0;
+    for (uint64_t TimeNow = StartTime; TimeNow < StartTime + DurationUs; TimeNow += TickUs, ++Tick) {
+        for (size_t i = 0; i < Flows.size(); ++i) {
+            Flows[(i + Tick) % Flows.size()]->OnAcksAndLosses(TimeNow);
+        }
+        for (size_t i = 0; i < Flows.size(); ++i) {
+            Flows[(i + Tick) % Flows.size()]->Send(TimeNow, Link);
+        }
+    }
+}
+
+//
+// A single flow over a 20 Mbps, 40ms path with a half BDP buffer and 1%
+// random loss. BBR's fixed 2 BDP window keeps overflowing the buffer, while
+// BBRv3 learns InflightHi from the loss and stays near the random loss rate.
+// BBRv3 trades some throughput for that, as the random loss pulls its short
+// term lower bounds down between probes.
+//
+TEST(Bbr3SimTest, ShallowBufferRandomLoss)
+{
+    const uint64_t DurationUs = 20 * 1000 * 1000;
+    uint64_t Acked[2], Lost[2], Sent[2];
+    void (*Algorithms[2])(QUIC_CONGESTION_CONTROL*, const QUIC_SETTINGS_INTERNAL*) = {
+        BbrCongestionControlInitialize, Bbr3CongestionControlInitialize
+    };
+
+    for (int i = 0; i < 2; ++i) {
+        Bbr3SimLink Link = { 2500 * 1000, 50 * 1000, 20 * 1000, 10, 0x12345678, 0 };
+        Bbr3SimFlow Flow(Algorithms[i]);
+        std::vector<Bbr3SimFlow*> Flows = { &Flow };
+        Bbr3SimRun(Link, Flows, DurationUs);
+        Acked[i] = Flow.TotalBytesAcked;
+        Lost[i] = Flow.TotalBytesLost;
+        Sent[i] = Flow.TotalBytesSent;
+        printf("%s: goodput %llu kbps, loss %llu.%02llu%%\n",
+            Flow.Cc->Name,
+            (unsigned long long)(Acked[i] * 8 * 1000 / DurationUs),
+            (unsigned long long)(Lost[i] * 100 / Sent[i]),
+            (unsigned long long)(Lost[i] * 10000 / Sent[i] % 100));
+    }
+
+    const uint64_t Capacity = 2500 * 1000 * DurationUs / 1000000;
+    ASSERT_LT(Lost[1] * Sent[0], Lost[0] * Sent[1]);
+    ASSERT_LT(Lost[1] * 100, Sent[1] * 2);
+    ASSERT_GT(Acked[1] * 2, Capacity);
+}
+
+//
+// One Cubic flow sharing a 20 Mbps, 40ms path with a 1 BDP buffer with
+// either BBR or BBRv3. BBRv3 leaves Cubic a larger share.
+//
+TEST(Bbr3SimTest, CubicCoexistence)
+{
+    const uint64_t DurationUs = 30 * 1000 * 1000;
+    uint64_t CubicShare[2];
+    void (*Algorithms[2])(QUIC_CONGESTION_CONTROL*, const QUIC_SETTINGS_INTERNAL*) = {
+        BbrCongestionControlInitialize, Bbr3CongestionControlInitialize
+    };
+
+    for (int i = 0; i < 2; ++i) {
+        Bbr3SimLink Link = { 2500 * 1000, 100 * 1000, 20 * 1000, 0, 0x12345678, 0 };
+        Bbr3SimFlow Cubic(CubicCongestionControlInitialize);
+        Bbr3SimFlow Flow(Algorithms[i]);
+        std::vector<Bbr3SimFlow*> Flows = { &Cubic, &Flow };
+        Bbr3SimRun(Link, Flows, DurationUs);
+        CubicShare[i] =
+            Cubic.TotalBytesAcked * 100 / (Cubic.TotalBytesAcked + Flow.TotalBytesAcked);
+        printf("Cubic vs %s: Cubic share %llu%%\n",
+            Flow.Cc->Name, (unsigned long long)CubicShare[i]);
+    }
+
+    ASSERT_GT(CubicShare[1], CubicShare[0]);
+}
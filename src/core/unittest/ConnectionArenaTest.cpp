@@ -0,0 +1,103 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the connection arena.
+
+--*/
+
+#include "main.h"
+
+//
+// Only the connection fields the arena uses are initialized.
+//
+struct ArenaConnectionScope {
+    QUIC_CONNECTION* Connection;
+    ArenaConnectionScope() {
+        Connection =
+            (QUIC_CONNECTION*)CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_CONNECTION), QUIC_POOL_CONN);
+        CxPlatZeroMemory(Connection, offsetof(QUIC_CONNECTION, Arena));
+        Connection->Partition =
+            (QUIC_PARTITION*)CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_PARTITION), QUIC_POOL_TEST);
+        CxPlatZeroMemory(Connection->Partition, sizeof(QUIC_PARTITION));
+    }
+    ~ArenaConnectionScope() {
+        CXPLAT_FREE(Connection->Partition, QUIC_POOL_TEST);
+        CXPLAT_FREE(Connection, QUIC_POOL_CONN);
+    }
+    int64_t Counter(QUIC_PERFORMANCE_COUNTERS Type) const {
+        return Connection->Partition->PerfCounters[Type];
+    }
+};
+
+TEST(ConnectionArenaTest, StreamsUntilFull)
+{
+    ArenaConnectionScope Scope;
+    QUIC_STREAM* Streams[QUIC_CONN_ARENA_STREAM_COUNT];
+    for (uint32_t i = 0; i < QUIC_CONN_ARENA_STREAM_COUNT; ++i) {
+        Streams[i] = QuicConnArenaAllocStream(Scope.Connection);
+        ASSERT_NE(nullptr, Streams[i]);
+        ASSERT_TRUE(QuicConnArenaContains(Scope.Connection, Streams[i]));
+        for (uint32_t j = 0; j < i; ++j) {
+            ASSERT_NE(Streams[j], Streams[i]);
+        }
+    }
+    ASSERT_EQ(nullptr, QuicConnArenaAllocStream(Scope.Connection));
+    ASSERT_EQ(QUIC_CONN_ARENA_STREAM_COUNT, Scope.Counter(QUIC_PERF_COUNTER_CONN_ARENA_ALLOC));
+    ASSERT_EQ(1, Scope.Counter(QUIC_PERF_COUNTER_CONN_ARENA_OVERFLOW));
+
+    for (uint32_t i = 0; i < QUIC_CONN_ARENA_STREAM_COUNT; ++i) {
+        ASSERT_TRUE(QuicConnArenaFreeStream(Scope.Connection, Streams[i]));
+    }
+    ASSERT_EQ(0, Scope.Connection->ArenaStreamsInUse);
+}
+
+TEST(ConnectionArenaTest, StreamReuse)
+{
+    ArenaConnectionScope Scope;
+    QUIC_STREAM* First = QuicConnArenaAllocStream(Scope.Connection);
+    ASSERT_NE(nullptr, First);
+    QUIC_STREAM* Second = QuicConnArenaAllocStream(Scope.Connection);
+    ASSERT_NE(nullptr, Second);
+
+    //
+    // A freed entry is handed out again while the others stay in use.
+    //
+    ASSERT_TRUE(QuicConnArenaFreeStream(Scope.Connection, First));
+    ASSERT_EQ(First, QuicConnArenaAllocStream(Scope.Connection));
+
+    ASSERT_TRUE(QuicConnArenaFreeStream(Scope.Connection, First));
+    ASSERT_TRUE(QuicConnArenaFreeStream(Scope.Connection, Second));
+}
+
+TEST(ConnectionArenaTest, FreeSeparateStream)
+{
+    ArenaConnectionScope Scope;
+    QUIC_STREAM* Stream =
+        (QUIC_STREAM*)CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_STREAM), QUIC_POOL_TEST);
+    ASSERT_NE(nullptr, Stream);
+    ASSERT_FALSE(QuicConnArenaContains(Scope.Connection, Stream));
+    ASSERT_FALSE(QuicConnArenaFreeStream(Scope.Connection, Stream));
+    CXPLAT_FREE(Stream, QUIC_POOL_TEST);
+}
+
+TEST(ConnectionArenaTest, RecvChunkFree)
+{
+    ArenaConnectionScope Scope;
+    QUIC_RECV_CHUNK* Chunk = &Scope.Connection->Arena.CryptoRecvChunk;
+    QuicRecvChunkInitialize(
+        Chunk,
+        sizeof(Scope.Connection->Arena.CryptoRecvBuffer),
+        Scope.Connection->Arena.CryptoRecvBuffer,
+        FALSE);
+    ASSERT_FALSE(Chunk->AllocatedInArena);
+    Chunk->AllocatedInArena = TRUE;
+
+    //
+    // The chunk is left in place; it is released with the connection.
+    //
+    QuicRecvChunkFree(Chunk);
+}
@@ -355,6 +355,106 @@ TEST_F(CubicTest, OnEcn_CongestionSignal)
     ASSERT_TRUE(Cubic->HasHadCongestionEvent);
 }
 
+//
+// Test: L4S - First CE Mark
+// Scenario: With L4S enabled the CE fraction estimate (alpha) starts at 1, so
+// the first CE mark halves the window like DCTCP/Prague, instead of the
+// classic BETA reduction.
+//
+TEST_F(CubicTest, L4s_FirstCeHalvesWindow)
+{
+    Settings.EcnL4sEnabled = TRUE;
+    InitializeDefaultWithRtt(/*WindowPackets = */ 20, /*HyStart = */ false);
+    ASSERT_TRUE(CC->L4sEnabled);
+    uint32_t InitialWindow = Cubic->CongestionWindow;
+
+    CC->QuicCongestionControlOnDataSent(CC, 10000);
+
+    QUIC_ECN_EVENT EcnEvent{};
+    EcnEvent.LargestPacketNumberAcked = 10;
+    EcnEvent.LargestSentPacketNumber = 15;
+    EcnEvent.NewCeCount = 1;
+    CC->QuicCongestionControlOnEcn(CC, &EcnEvent);
+
+    ASSERT_EQ(Cubic->CongestionWindow, InitialWindow - InitialWindow / 2);
+    ASSERT_EQ(Cubic->SlowStartThreshold, Cubic->CongestionWindow);
+    ASSERT_EQ(Cubic->KCubic, 0u);
+    ASSERT_TRUE(Cubic->IsInRecovery);
+    ASSERT_EQ(Connection.Stats.Send.EcnCongestionCount, 1u);
+
+    //
+    // More CE marks in the same round trip don't reduce the window again.
+    //
+    EcnEvent.LargestPacketNumberAcked = 12;
+    CC->QuicCongestionControlOnEcn(CC, &EcnEvent);
+    ASSERT_EQ(Cubic->CongestionWindow, InitialWindow - InitialWindow / 2);
+    ASSERT_EQ(Connection.Stats.Send.EcnCongestionCount, 1u);
+}
+
+//
+// Test: L4S - Proportional Response
+// Scenario: Alpha follows the per round trip CE fraction, so a steady 10%
+// marking rate converges to alpha ~= 0.1 and each later CE round trip only
+// takes ~5% off the window. Rounds without marks decay alpha.
+//
+TEST_F(CubicTest, L4s_ReductionProportionalToCeFraction)
+{
+    Settings.EcnL4sEnabled = TRUE;
+    InitializeDefaultWithRtt(/*WindowPackets = */ 20, /*HyStart = */ false);
+
+    uint64_t PacketNumber = 0;
+    uint64_t TimeNow = 1000000;
+    auto Round = [&](uint32_t CePackets) {
+        PacketNumber += 100;
+        TimeNow += 50000;
+        Connection.Send.NextPacketNumber = PacketNumber + 1;
+        if (CePackets != 0) {
+            QUIC_ECN_EVENT EcnEvent{};
+            EcnEvent.LargestPacketNumberAcked = PacketNumber;
+            EcnEvent.LargestSentPacketNumber = PacketNumber;
+            EcnEvent.NewCeCount = CePackets;
+            CC->QuicCongestionControlOnEcn(CC, &EcnEvent);
+        }
+        QUIC_ACK_EVENT AckEvent = MakeAckEvent(TimeNow, PacketNumber, PacketNumber, 0);
+        AckEvent.NumEcnEctPacketsAcked = 100;
+        CC->QuicCongestionControlOnDataAcknowledged(CC, &AckEvent);
+    };
+
+    for (uint32_t i = 0; i < 200; ++i) {
+        Round(10);
+    }
+
+    //
+    // 10% of 65536 is 6553. The integer EWMA settles within 16 of that.
+    //
+    ASSERT_GE(Cubic->L4sAlpha, 6500u);
+    ASSERT_LE(Cubic->L4sAlpha, 6600u);
+
+    //
+    // The next CE round trip takes alpha/2 of the window off.
+    //
+    const uint32_t Window = 100000;
+    Cubic->CongestionWindow = Window;
+    QUIC_ECN_EVENT EcnEvent{};
+    EcnEvent.LargestPacketNumberAcked = PacketNumber + 1;
+    EcnEvent.LargestSentPacketNumber = PacketNumber + 1;
+    EcnEvent.NewCeCount = 1;
+    CC->QuicCongestionControlOnEcn(CC, &EcnEvent);
+    const uint32_t ExpectedWindow =
+        Window - (uint32_t)(((uint64_t)Window * Cubic->L4sAlpha) >> 17);
+    ASSERT_EQ(Cubic->CongestionWindow, ExpectedWindow);
+    ASSERT_GT(Cubic->CongestionWindow, Window * 9 / 10);
+
+    //
+    // Unmarked round trips decay alpha by 1/16 each.
+    //
+    const uint32_t PreviousAlpha = Cubic->L4sAlpha;
+    for (uint32_t i = 0; i < 16; ++i) {
+        Round(0);
+    }
+    ASSERT_LT(Cubic->L4sAlpha, PreviousAlpha / 2);
+}
+
 //
 // Test: Fast Convergence - Window Reduction Path
 // Scenario: Tests CUBIC's fast convergence algorithm. When a new congestion event occurs
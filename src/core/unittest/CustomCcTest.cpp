@@ -0,0 +1,344 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit tests for app registered (custom) congestion control.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "CustomCcTest.cpp.clog.h"
+#endif
+
+//
+// A fake algorithm that records every callback and exposes a window the test
+// controls.
+//
+struct FakeCc {
+    QUIC_STATUS CreateStatus {QUIC_STATUS_SUCCESS};
+    QUIC_CUSTOM_CONGESTION_CONTROL_PARAMS Params {};
+    uint32_t Window {0};
+    uint64_t PacingRate {0};
+    BOOLEAN SpuriousResult {FALSE};
+    uint32_t CreateCount {0};
+    uint32_t DeleteCount {0};
+    uint32_t ResetCount {0};
+    BOOLEAN LastFullReset {FALSE};
+    uint32_t BytesSent {0};
+    uint32_t AckCount {0};
+    QUIC_CUSTOM_CONGESTION_CONTROL_ACK LastAck {};
+    uint32_t LossCount {0};
+    uint32_t EcnCount {0};
+    QUIC_CUSTOM_CONGESTION_CONTROL_LOSS LastLoss {};
+
+    static
+    QUIC_STATUS
+    QUIC_API
+    Create(
+        _In_opt_ void* Context,
+        _In_ const QUIC_CUSTOM_CONGESTION_CONTROL_PARAMS* Params,
+        _Outptr_ void** State
+        )
+    {
+        auto Fake = (FakeCc*)Context;
+        Fake->CreateCount++;
+        Fake->Params = *Params;
+        *State = Fake;
+        return Fake->CreateStatus;
+    }
+    static void QUIC_API Delete(_In_ void* State) {
+        ((FakeCc*)State)->DeleteCount++;
+    }
+    static void QUIC_API Reset(_In_ void* State, _In_ BOOLEAN FullReset) {
+        ((FakeCc*)State)->ResetCount++;
+        ((FakeCc*)State)->LastFullReset = FullReset;
+    }
+    static void QUIC_API OnDataSent(_In_ void* State, _In_ uint32_t Bytes) {
+        ((FakeCc*)State)->BytesSent += Bytes;
+    }
+    static void QUIC_API OnDataAcknowledged(_In_ void* State, _In_ const QUIC_CUSTOM_CONGESTION_CONTROL_ACK* Ack) {
+        ((FakeCc*)State)->AckCount++;
+        ((FakeCc*)State)->LastAck = *Ack;
+    }
+    static void QUIC_API OnDataLost(_In_ void* State, _In_ const QUIC_CUSTOM_CONGESTION_CONTROL_LOSS* Loss) {
+        ((FakeCc*)State)->LossCount++;
+        ((FakeCc*)State)->LastLoss = *Loss;
+    }
+    static void QUIC_API OnEcn(_In_ void* State, _In_ const QUIC_CUSTOM_CONGESTION_CONTROL_LOSS* Loss) {
+        ((FakeCc*)State)->EcnCount++;
+        ((FakeCc*)State)->LastLoss = *Loss;
+    }
+    static BOOLEAN QUIC_API OnSpuriousCongestionEvent(_In_ void* State) {
+        return ((FakeCc*)State)->SpuriousResult;
+    }
+    static uint32_t QUIC_API GetCongestionWindow(_In_ const void* State) {
+        return ((const FakeCc*)State)->Window;
+    }
+    static uint64_t QUIC_API GetPacingRate(_In_ const void* State) {
+        return ((const FakeCc*)State)->PacingRate;
+    }
+
+    QUIC_CUSTOM_CONGESTION_CONTROL Algorithm() {
+        QUIC_CUSTOM_CONGESTION_CONTROL Custom {};
+        Custom.Algorithm = QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_BASE;
+        Custom.Name = "Fake";
+        Custom.Context = this;
+        Custom.Create = Create;
+        Custom.Delete = Delete;
+        Custom.Reset = Reset;
+        Custom.OnDataSent = OnDataSent;
+        Custom.OnDataAcknowledged = OnDataAcknowledged;
+        Custom.OnDataLost = OnDataLost;
+        Custom.OnEcn = OnEcn;
+        Custom.OnSpuriousCongestionEvent = OnSpuriousCongestionEvent;
+        Custom.GetCongestionWindow = GetCongestionWindow;
+        Custom.GetPacingRate = GetPacingRate;
+        return Custom;
+    }
+};
+
+struct CustomCcTest : public ::testing::Test {
+    QUIC_CONNECTION Connection {};
+    QUIC_SETTINGS_INTERNAL Settings {};
+    QUIC_CONGESTION_CONTROL* Cc {&Connection.CongestionControl};
+    FakeCc Fake;
+    QUIC_CUSTOM_CONGESTION_CONTROL Algorithm {};
+    uint32_t Mtu {1280};
+
+    void SetUp() override {
+        Connection.Paths[0].Mtu = (uint16_t)Mtu;
+        Connection.Paths[0].IsActive = TRUE;
+        Connection.Send.PeerMaxData = UINT64_MAX;
+        Settings.InitialWindowPackets = 10;
+        Settings.SendIdleTimeoutMs = 1000;
+        Fake.Window = 10 * DatagramPayloadLength();
+        Algorithm = Fake.Algorithm();
+    }
+
+    void TearDown() override {
+        QuicCongestionControlUninitialize(Cc);
+    }
+
+    uint32_t DatagramPayloadLength() {
+        return QuicPathGetDatagramPayloadSize(&Connection.Paths[0]);
+    }
+
+    void Initialize() {
+        ASSERT_EQ(QUIC_STATUS_SUCCESS, CustomCongestionControlInitialize(Cc, &Settings, &Algorithm));
+    }
+};
+
+TEST_F(CustomCcTest, Initialize)
+{
+    Initialize();
+    ASSERT_EQ(1u, Fake.CreateCount);
+    ASSERT_EQ(DatagramPayloadLength(), Fake.Params.DatagramPayloadLength);
+    ASSERT_EQ(10u, Fake.Params.InitialWindowPackets);
+    ASSERT_EQ(1000u, Fake.Params.SendIdleTimeoutMs);
+    ASSERT_STREQ("Fake", Cc->Name);
+    ASSERT_EQ(Fake.Window, QuicCongestionControlGetCongestionWindow(Cc));
+    ASSERT_EQ(Fake.Window / 2, QuicCongestionControlGetBytesInFlightMax(Cc));
+    ASSERT_TRUE(QuicCongestionControlCanSend(Cc));
+
+    QuicCongestionControlUninitialize(Cc);
+    ASSERT_EQ(1u, Fake.DeleteCount);
+    QuicCongestionControlUninitialize(Cc);
+    ASSERT_EQ(1u, Fake.DeleteCount);
+}
+
+TEST_F(CustomCcTest, CreateFailure)
+{
+    Fake.CreateStatus = QUIC_STATUS_OUT_OF_MEMORY;
+    ASSERT_EQ(QUIC_STATUS_OUT_OF_MEMORY, CustomCongestionControlInitialize(Cc, &Settings, &Algorithm));
+    ASSERT_EQ(0u, Fake.DeleteCount);
+    ASSERT_EQ(nullptr, Cc->QuicCongestionControlUninitialize);
+}
+
+TEST_F(CustomCcTest, SendAckAndLoss)
+{
+    Initialize();
+    const uint32_t Window = Fake.Window;
+
+    QuicCongestionControlOnDataSent(Cc, Window);
+    ASSERT_EQ(Window, Fake.BytesSent);
+    ASSERT_FALSE(QuicCongestionControlCanSend(Cc));
+    ASSERT_EQ(Window, QuicCongestionControlGetBytesInFlightMax(Cc));
+
+    //
+    // Exemptions still allow probes to go out when blocked.
+    //
+    QuicCongestionControlSetExemption(Cc, 1);
+    ASSERT_TRUE(QuicCongestionControlCanSend(Cc));
+    QuicCongestionControlOnDataSent(Cc, 100);
+    ASSERT_EQ(0u, QuicCongestionControlGetExemptions(Cc));
+    ASSERT_FALSE(QuicCongestionControlCanSend(Cc));
+
+    QUIC_ACK_EVENT AckEvent {};
+    AckEvent.TimeNow = 123456;
+    AckEvent.LargestAck = 5;
+    AckEvent.LargestSentPacketNumber = 9;
+    AckEvent.NumRetransmittableBytes = 1000;
+    AckEvent.SmoothedRtt = 50000;
+    AckEvent.MinRtt = 40000;
+    AckEvent.MinRttValid = TRUE;
+    AckEvent.OneWayDelay = 20000;
+    AckEvent.HasLoss = TRUE;
+    Fake.Window = Window + 2000; // The algorithm grows its window on this ACK.
+    ASSERT_TRUE(QuicCongestionControlOnDataAcknowledged(Cc, &AckEvent));
+    ASSERT_EQ(1u, Fake.AckCount);
+    ASSERT_EQ(123456u, Fake.LastAck.TimeNow);
+    ASSERT_EQ(5u, Fake.LastAck.LargestAck);
+    ASSERT_EQ(9u, Fake.LastAck.LargestSentPacketNumber);
+    ASSERT_EQ(50000u, Fake.LastAck.SmoothedRtt);
+    ASSERT_EQ(40000u, Fake.LastAck.MinRtt);
+    ASSERT_TRUE(Fake.LastAck.MinRttValid);
+    ASSERT_EQ(20000u, Fake.LastAck.OneWayDelay);
+    ASSERT_TRUE(Fake.LastAck.HasLoss);
+    ASSERT_EQ(1000u, Fake.LastAck.BytesAcked);
+    ASSERT_EQ(Window + 100 - 1000, Fake.LastAck.BytesInFlight);
+    ASSERT_EQ(DatagramPayloadLength(), Fake.LastAck.DatagramPayloadLength);
+    ASSERT_EQ(Window + 2000, QuicCongestionControlGetCongestionWindow(Cc));
+    ASSERT_TRUE(QuicCongestionControlCanSend(Cc));
+
+    QUIC_LOSS_EVENT LossEvent {};
+    LossEvent.LargestPacketNumberLost = 7;
+    LossEvent.LargestSentPacketNumber = 9;
+    LossEvent.NumRetransmittableBytes = 500;
+    LossEvent.PersistentCongestion = TRUE;
+    Fake.Window = Window / 2;
+    QuicCongestionControlOnDataLost(Cc, &LossEvent);
+    ASSERT_EQ(1u, Fake.LossCount);
+    ASSERT_EQ(7u, Fake.LastLoss.LargestPacketNumber);
+    ASSERT_EQ(9u, Fake.LastLoss.LargestSentPacketNumber);
+    ASSERT_EQ(500u, Fake.LastLoss.BytesLost);
+    ASSERT_EQ(Window + 100 - 1500, Fake.LastLoss.BytesInFlight);
+    ASSERT_TRUE(Fake.LastLoss.PersistentCongestion);
+    ASSERT_EQ(Window / 2, QuicCongestionControlGetCongestionWindow(Cc));
+    ASSERT_FALSE(QuicCongestionControlCanSend(Cc));
+
+    ASSERT_TRUE(QuicCongestionControlOnDataInvalidated(Cc, Window + 100 - 1500));
+    ASSERT_TRUE(QuicCongestionControlCanSend(Cc));
+}
+
+TEST_F(CustomCcTest, Ecn)
+{
+    Initialize();
+
+    QUIC_ECN_EVENT EcnEvent {};
+    EcnEvent.LargestPacketNumberAcked = 3;
+    EcnEvent.LargestSentPacketNumber = 4;
+    QuicCongestionControlOnEcn(Cc, &EcnEvent);
+    ASSERT_EQ(1u, Fake.EcnCount);
+    ASSERT_EQ(3u, Fake.LastLoss.LargestPacketNumber);
+    ASSERT_EQ(0u, Fake.LastLoss.BytesLost);
+    ASSERT_EQ(1u, Connection.Stats.Send.EcnCongestionCount);
+
+    //
+    // ECN is optional for the algorithm.
+    //
+    QuicCongestionControlUninitialize(Cc);
+    Algorithm.OnEcn = nullptr;
+    Initialize();
+    QuicCongestionControlOnEcn(Cc, &EcnEvent);
+    ASSERT_EQ(1u, Fake.EcnCount);
+    ASSERT_EQ(1u, Connection.Stats.Send.EcnCongestionCount);
+}
+
+TEST_F(CustomCcTest, ResetAndSpurious)
+{
+    Initialize();
+    QuicCongestionControlOnDataSent(Cc, 1000);
+
+    QuicCongestionControlReset(Cc, FALSE);
+    ASSERT_EQ(1u, Fake.ResetCount);
+    ASSERT_FALSE(Fake.LastFullReset);
+    ASSERT_TRUE(QuicCongestionControlCanSend(Cc));
+
+    QuicCongestionControlReset(Cc, TRUE);
+    ASSERT_TRUE(Fake.LastFullReset);
+
+    ASSERT_FALSE(QuicCongestionControlOnSpuriousCongestionEvent(Cc));
+    QuicCongestionControlOnDataSent(Cc, Fake.Window);
+    ASSERT_FALSE(QuicCongestionControlCanSend(Cc));
+    Fake.SpuriousResult = TRUE;
+    Fake.Window *= 2;
+    ASSERT_TRUE(QuicCongestionControlOnSpuriousCongestionEvent(Cc));
+    ASSERT_TRUE(QuicCongestionControlCanSend(Cc));
+}
+
+TEST_F(CustomCcTest, MinimumWindow)
+{
+    Fake.Window = 0;
+    Initialize();
+    ASSERT_EQ(
+        DatagramPayloadLength() * QUIC_PERSISTENT_CONGESTION_WINDOW_PACKETS,
+        QuicCongestionControlGetCongestionWindow(Cc));
+}
+
+TEST_F(CustomCcTest, Pacing)
+{
+    Initialize();
+    Connection.Settings.PacingEnabled = TRUE;
+    Connection.Paths[0].GotFirstRttSample = TRUE;
+    Connection.Paths[0].SmoothedRtt = 100 * 1000;
+
+    //
+    // Without a pacing rate, the window (plus 25%) is spread over the RTT.
+    //
+    const uint32_t Window = Fake.Window;
+    ASSERT_EQ(
+        (Window + Window / 4) / 10,
+        QuicCongestionControlGetSendAllowance(Cc, 10 * 1000, TRUE));
+    QuicCongestionControlOnDataSent(Cc, (Window + Window / 4) / 10);
+
+    //
+    // With one, it is used directly.
+    //
+    Fake.PacingRate = 1000 * 1000; // 1 MB/s
+    ASSERT_EQ(1000u, QuicCongestionControlGetSendAllowance(Cc, 1000, TRUE));
+
+    //
+    // Not pacing gives the whole remaining window.
+    //
+    ASSERT_EQ(
+        Window - (Window + Window / 4) / 10,
+        QuicCongestionControlGetSendAllowance(Cc, 1000, FALSE));
+}
+
+TEST_F(CustomCcTest, LibraryRegistration)
+{
+    const uint16_t Index =
+        Algorithm.Algorithm - QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_BASE;
+    ASSERT_EQ(nullptr, QuicLibraryGetCustomCongestionControl(Algorithm.Algorithm));
+    ASSERT_EQ(nullptr, QuicLibraryGetCustomCongestionControl(QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC));
+
+    MsQuicLib.CustomCongestionControl[Index] = Algorithm;
+    Settings.CongestionControlAlgorithm = Algorithm.Algorithm;
+    QuicCongestionControlInitialize(Cc, &Settings);
+    ASSERT_STREQ("Fake", Cc->Name);
+    ASSERT_EQ(1u, Fake.CreateCount);
+
+    //
+    // Re-initializing (as done after settings are applied) releases the
+    // previous state first.
+    //
+    QuicCongestionControlInitialize(Cc, &Settings);
+    ASSERT_EQ(2u, Fake.CreateCount);
+    ASSERT_EQ(1u, Fake.DeleteCount);
+
+    //
+    // Falls back to Cubic if the algorithm can't create its state.
+    //
+    Fake.CreateStatus = QUIC_STATUS_OUT_OF_MEMORY;
+    QuicCongestionControlInitialize(Cc, &Settings);
+    ASSERT_EQ(2u, Fake.DeleteCount);
+    ASSERT_STREQ("Cubic", Cc->Name);
+
+    MsQuicLib.CustomCongestionControl[Index] = {};
+    QuicCongestionControlInitialize(Cc, &Settings);
+    ASSERT_STREQ("Cubic", Cc->Name);
+}
@@ -0,0 +1,364 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit tests for the local CID lookup: lock-free lookups racing with inserts,
+    removals and the rebalance to partitioned tables, and the deferred
+    reclamation of memory and connection references held back by readers.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "LookupTest.cpp.clog.h"
+#endif
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+extern "C"
+void
+MsQuicCalculatePartitionMask(
+    void
+    );
+
+#define LOOKUP_PARTITION_COUNT 4
+#define LOOKUP_READER_THREAD_COUNT 2
+
+static
+void
+LookupAdd(
+    _In_ QUIC_LOOKUP* Lookup,
+    _In_ QUIC_CID_HASH_ENTRY* Cid
+    )
+{
+    QUIC_CONNECTION* Collision = NULL;
+    ASSERT_TRUE(QuicLookupAddLocalCid(Lookup, Cid, &Collision));
+    ASSERT_EQ(nullptr, Collision);
+}
+
+//
+// Only the connection fields the lookup uses are initialized. The test keeps
+// the initial reference, so the lookup never frees the connection.
+//
+struct LookupConnection {
+    QUIC_CONNECTION* Connection;
+    std::vector<QUIC_CID_HASH_ENTRY*> DetachedCids;
+    LookupConnection() {
+        Connection =
+            (QUIC_CONNECTION*)CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_CONNECTION), QUIC_POOL_CONN);
+        CxPlatZeroMemory(Connection, sizeof(QUIC_CONNECTION));
+        Connection->RefCount = 1;
+#if DEBUG
+        for (uint32_t i = 0; i < QUIC_CONN_REF_COUNT; ++i) {
+            Connection->RefTypeBiasedCount[i] = 1;
+        }
+        Connection->RefTypeBiasedCount[QUIC_CONN_REF_HANDLE_OWNER] = 2;
+#endif
+    }
+    ~LookupConnection() {
+        while (Connection->SourceCids.Next != NULL) {
+            CXPLAT_FREE(
+                CXPLAT_CONTAINING_RECORD(
+                    CxPlatListPopEntry(&Connection->SourceCids),
+                    QUIC_CID_HASH_ENTRY,
+                    Link),
+                QUIC_POOL_CIDHASH);
+        }
+        for (auto Cid : DetachedCids) {
+            CXPLAT_FREE(Cid, QUIC_POOL_CIDHASH);
+        }
+        CXPLAT_FREE(Connection, QUIC_POOL_CONN);
+    }
+    QUIC_CID_HASH_ENTRY* AllocCid(uint32_t Id) {
+        const uint8_t Length = MsQuicLib.CidTotalLength;
+        QUIC_CID_HASH_ENTRY* Cid =
+            (QUIC_CID_HASH_ENTRY*)CXPLAT_ALLOC_NONPAGED(
+                sizeof(QUIC_CID_HASH_ENTRY) + Length,
+                QUIC_POOL_CIDHASH);
+        CxPlatZeroMemory(Cid, sizeof(QUIC_CID_HASH_ENTRY) + Length);
+        Cid->Connection = Connection;
+        Cid->CID.Length = Length;
+        Cid->CID.Data[MsQuicLib.CidServerIdLength] = (uint8_t)Id; // Spread across partitions.
+        CxPlatCopyMemory(Cid->CID.Data + Length - sizeof(Id), &Id, sizeof(Id));
+        return Cid;
+    }
+    //
+    // Allocates a source CID that isn't on the connection's source CID list,
+    // so the test adds it to and removes it from the lookup on its own.
+    //
+    QUIC_CID_HASH_ENTRY* NewDetachedCid(uint32_t Id) {
+        QUIC_CID_HASH_ENTRY* Cid = AllocCid(Id);
+        DetachedCids.push_back(Cid);
+        return Cid;
+    }
+    //
+    // Adds a new source CID to the lookup and then to the connection's source
+    // CID list, like the connection does.
+    //
+    void AddCid(QUIC_LOOKUP* Lookup, uint32_t Id) {
+        QUIC_CID_HASH_ENTRY* Cid = AllocCid(Id);
+        LookupAdd(Lookup, Cid);
+        CxPlatListPushEntry(&Connection->SourceCids, &Cid->Link);
+    }
+    long RefCount() const { return Connection->RefCount; }
+};
+
+//
+// Removes a CID that isn't on the connection's source CID list.
+//
+static
+void
+LookupRemoveDetached(
+    _In_ QUIC_LOOKUP* Lookup,
+    _In_ QUIC_CID_HASH_ENTRY* Cid
+    )
+{
+    CXPLAT_SLIST_ENTRY* Link = &Cid->Link;
+    Cid->Link.Next = NULL;
+    QuicLookupRemoveLocalCid(Lookup, Cid, &Link);
+}
+
+static
+QUIC_CONNECTION*
+LookupFind(
+    _In_ QUIC_LOOKUP* Lookup,
+    _In_reads_(Length) const uint8_t* Cid,
+    _In_ uint8_t Length
+    )
+{
+    QUIC_CONNECTION* Connection = QuicLookupFindConnectionByLocalCid(Lookup, Cid, Length);
+    if (Connection != NULL) {
+        QuicConnRelease(Connection, QUIC_CONN_REF_LOOKUP_RESULT);
+    }
+    return Connection;
+}
+
+//
+// Runs lookups for a set of CIDs on several threads until stopped, and counts
+// the results that didn't match what the CID may map to at any point.
+//
+struct LookupReaders {
+    struct Target {
+        uint8_t Data[QUIC_CID_MAX_LENGTH];
+        uint8_t Length;
+        QUIC_CONNECTION* Connection;
+        bool MayBeMissing;
+    };
+    QUIC_LOOKUP* Lookup;
+    std::vector<Target> Targets;
+    std::atomic<bool> Stop {false};
+    std::atomic<uint64_t> Iterations {0};
+    std::atomic<uint64_t> Failures {0};
+    std::vector<std::thread> Threads;
+    LookupReaders(QUIC_LOOKUP* Lookup) : Lookup(Lookup) { }
+    ~LookupReaders() { Join(); }
+    void Add(const QUIC_CID_HASH_ENTRY* Cid, bool MayBeMissing) {
+        Target T;
+        CxPlatCopyMemory(T.Data, Cid->CID.Data, Cid->CID.Length);
+        T.Length = Cid->CID.Length;
+        T.Connection = Cid->Connection;
+        T.MayBeMissing = MayBeMissing;
+        Targets.push_back(T);
+    }
+    void Start() {
+        for (uint32_t i = 0; i < LOOKUP_READER_THREAD_COUNT; ++i) {
+            Threads.emplace_back([this] {
+                while (!Stop) {
+                    for (const auto& T : Targets) {
+                        QUIC_CONNECTION* Connection = LookupFind(Lookup, T.Data, T.Length);
+                        if (Connection != T.Connection &&
+                            !(Connection == NULL && T.MayBeMissing)) {
+                            ++Failures;
+                        }
+                    }
+                    ++Iterations;
+                }
+            });
+        }
+    }
+    //
+    // Waits for every reader to complete a few more passes over the targets.
+    //
+    void WaitForProgress() {
+        const uint64_t Target = Iterations + 4 * LOOKUP_READER_THREAD_COUNT;
+        while (Iterations < Target) {
+            std::this_thread::yield();
+        }
+    }
+    void Join() {
+        Stop = true;
+        for (auto& Thread : Threads) {
+            Thread.join();
+        }
+        Threads.clear();
+    }
+};
+
+//
+// Partitions are normally set up when the first registration is opened. Use
+// several, so CIDs are spread over more than one table.
+//
+class LookupTest : public ::testing::Test {
+protected:
+    uint16_t OldPartitionCount;
+    uint16_t OldPartitionMask;
+    void SetUp() override {
+        OldPartitionCount = MsQuicLib.PartitionCount;
+        OldPartitionMask = MsQuicLib.PartitionMask;
+        MsQuicLib.PartitionCount = LOOKUP_PARTITION_COUNT;
+        MsQuicCalculatePartitionMask();
+    }
+    void TearDown() override {
+        MsQuicLib.PartitionCount = OldPartitionCount;
+        MsQuicLib.PartitionMask = OldPartitionMask;
+    }
+};
+
+TEST_F(LookupTest, LockFreeLookupRacesInsertRemove)
+{
+    QUIC_LOOKUP Lookup;
+    QuicLookupInitialize(&Lookup);
+    ASSERT_TRUE(QuicLookupMaximizePartitioning(&Lookup));
+    ASSERT_NE(nullptr, Lookup.LockFreeTables);
+
+    LookupConnection Stable, Churn;
+    for (uint32_t i = 0; i < 32; ++i) {
+        Stable.AddCid(&Lookup, i);
+    }
+    std::vector<QUIC_CID_HASH_ENTRY*> ChurnCids;
+    for (uint32_t i = 0; i < 64; ++i) {
+        ChurnCids.push_back(Churn.NewDetachedCid(0x10000 + i));
+    }
+
+    {
+        LookupReaders Readers(&Lookup);
+        for (CXPLAT_SLIST_ENTRY* Link = Stable.Connection->SourceCids.Next; Link != NULL; Link = Link->Next) {
+            Readers.Add(CXPLAT_CONTAINING_RECORD(Link, QUIC_CID_HASH_ENTRY, Link), false);
+        }
+        for (auto Cid : ChurnCids) {
+            Readers.Add(Cid, true);
+        }
+        Readers.Start();
+
+        //
+        // The first round also grows the tables while they are being read.
+        //
+        for (uint32_t Round = 0; Round < 50; ++Round) {
+            for (auto Cid : ChurnCids) {
+                LookupAdd(&Lookup, Cid);
+            }
+            Readers.WaitForProgress();
+            for (auto Cid : ChurnCids) {
+                LookupRemoveDetached(&Lookup, Cid);
+            }
+            Readers.WaitForProgress();
+        }
+
+        Readers.Join();
+        ASSERT_EQ(0u, Readers.Failures.load());
+    }
+
+    for (auto Cid : ChurnCids) {
+        ASSERT_EQ(nullptr, LookupFind(&Lookup, Cid->CID.Data, Cid->CID.Length));
+    }
+
+    //
+    // With no readers left, the next removal reclaims everything retired.
+    //
+    QuicLookupRemoveLocalCids(&Lookup, Stable.Connection);
+    ASSERT_EQ(nullptr, Lookup.Retired);
+    ASSERT_EQ(1, Stable.RefCount());
+    ASSERT_EQ(1, Churn.RefCount());
+    QuicLookupUninitialize(&Lookup);
+}
+
+TEST_F(LookupTest, LockFreeLookupRacesRebalance)
+{
+    for (uint32_t Round = 0; Round < 20; ++Round) {
+        QUIC_LOOKUP Lookup;
+        QuicLookupInitialize(&Lookup);
+
+        //
+        // A single connection starts out in the unpartitioned lookup.
+        //
+        LookupConnection Connection;
+        for (uint32_t i = 0; i < 4; ++i) {
+            Connection.AddCid(&Lookup, i);
+        }
+        ASSERT_EQ(0u, Lookup.PartitionCount);
+
+        {
+            LookupReaders Readers(&Lookup);
+            for (CXPLAT_SLIST_ENTRY* Link = Connection.Connection->SourceCids.Next; Link != NULL; Link = Link->Next) {
+                Readers.Add(CXPLAT_CONTAINING_RECORD(Link, QUIC_CID_HASH_ENTRY, Link), false);
+            }
+            Readers.Start();
+            Readers.WaitForProgress();
+
+            ASSERT_TRUE(QuicLookupMaximizePartitioning(&Lookup));
+            ASSERT_NE(nullptr, Lookup.LockFreeTables);
+
+            Readers.WaitForProgress();
+            Readers.Join();
+            ASSERT_EQ(0u, Readers.Failures.load());
+        }
+
+        QuicLookupRemoveLocalCids(&Lookup, Connection.Connection);
+        ASSERT_EQ(nullptr, Lookup.Retired);
+        ASSERT_EQ(1, Connection.RefCount());
+        QuicLookupUninitialize(&Lookup);
+    }
+}
+
+TEST_F(LookupTest, LockFreeReclaimDeferredForActiveReader)
+{
+    QUIC_LOOKUP Lookup;
+    QuicLookupInitialize(&Lookup);
+    ASSERT_TRUE(QuicLookupMaximizePartitioning(&Lookup));
+    ASSERT_NE(nullptr, Lookup.LockFreeTables);
+
+    LookupConnection Connection;
+    QUIC_CID_HASH_ENTRY* Cid = Connection.NewDetachedCid(1);
+    LookupAdd(&Lookup, Cid);
+    ASSERT_EQ(2, Connection.RefCount());
+
+    //
+    // Register a reader the way a lock-free lookup does, as if it was still in
+    // the middle of its traversal.
+    //
+    QUIC_LOOKUP_READER* Reader = &Lookup.Readers[0];
+    const uint32_t Parity = (uint32_t)Lookup.ReaderEpoch & 1;
+    InterlockedIncrement(&Reader->Count[Parity]);
+
+    //
+    // The CID is unlinked right away, but the entry and the lookup table's
+    // reference on the connection are kept for the reader.
+    //
+    LookupRemoveDetached(&Lookup, Cid);
+    ASSERT_EQ(nullptr, LookupFind(&Lookup, Cid->CID.Data, Cid->CID.Length));
+    ASSERT_NE(nullptr, Lookup.Retired);
+    ASSERT_EQ(2, Connection.RefCount());
+
+    //
+    // Other writers don't wait for the reader either.
+    //
+    QUIC_CID_HASH_ENTRY* Cid2 = Connection.NewDetachedCid(2);
+    LookupAdd(&Lookup, Cid2);
+    ASSERT_NE(nullptr, Lookup.Retired);
+    ASSERT_EQ(3, Connection.RefCount());
+
+    //
+    // Once the reader is gone, the next writer reclaims what it held back.
+    //
+    InterlockedDecrement(&Reader->Count[Parity]);
+    LookupRemoveDetached(&Lookup, Cid2);
+    ASSERT_EQ(nullptr, Lookup.Retired);
+    ASSERT_EQ(1, Connection.RefCount());
+
+    QuicLookupUninitialize(&Lookup);
+}
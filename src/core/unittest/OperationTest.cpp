@@ -0,0 +1,117 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the connection operation queue.
+
+--*/
+
+#include "main.h"
+
+//
+// Only the fields the operation queue uses are initialized.
+//
+struct OperationQueueScope {
+    QUIC_OPERATION_QUEUE OperQ;
+    QUIC_PARTITION* Partition;
+    QUIC_STREAM* Streams[4];
+    OperationQueueScope() {
+        QuicOperationQueueInitialize(&OperQ);
+        Partition =
+            (QUIC_PARTITION*)CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_PARTITION), QUIC_POOL_TEST);
+        CxPlatZeroMemory(Partition, sizeof(QUIC_PARTITION));
+        for (uint32_t i = 0; i < ARRAYSIZE(Streams); ++i) {
+            Streams[i] =
+                (QUIC_STREAM*)CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_STREAM), QUIC_POOL_TEST);
+            CxPlatZeroMemory(Streams[i], sizeof(QUIC_STREAM));
+        }
+    }
+    ~OperationQueueScope() {
+        while (QuicOperationDequeue(&OperQ, Partition) != NULL) { }
+        QuicOperationQueueUninitialize(&OperQ);
+        for (uint32_t i = 0; i < ARRAYSIZE(Streams); ++i) {
+            CXPLAT_FREE(Streams[i], QUIC_POOL_TEST);
+        }
+        CXPLAT_FREE(Partition, QUIC_POOL_TEST);
+    }
+};
+
+struct StreamSendOperation {
+    QUIC_OPERATION Oper;
+    QUIC_API_CONTEXT ApiCtx;
+    StreamSendOperation(QUIC_STREAM* Stream) {
+        CxPlatZeroMemory(&Oper, sizeof(Oper));
+        CxPlatZeroMemory(&ApiCtx, sizeof(ApiCtx));
+        Oper.Type = QUIC_OPER_TYPE_API_CALL;
+        Oper.API_CALL.Context = &ApiCtx;
+        ApiCtx.Type = QUIC_API_TYPE_STRM_SEND;
+        ApiCtx.STRM_SEND.Stream = Stream;
+        ApiCtx.STRM_SEND.LastStream = Stream;
+    }
+};
+
+TEST(OperationTest, CoalesceStreamSendEmpty)
+{
+    OperationQueueScope Scope;
+    ASSERT_FALSE(QuicOperationCoalesceStreamSend(&Scope.OperQ, Scope.Partition, Scope.Streams[0]));
+    ASSERT_EQ(0, Scope.Partition->PerfCounters[QUIC_PERF_COUNTER_CONN_OPER_COALESCED]);
+}
+
+TEST(OperationTest, CoalesceStreamSendTail)
+{
+    OperationQueueScope Scope;
+    StreamSendOperation Send(Scope.Streams[0]);
+    QuicOperationEnqueue(&Scope.OperQ, Scope.Partition, &Send.Oper);
+
+    ASSERT_TRUE(QuicOperationCoalesceStreamSend(&Scope.OperQ, Scope.Partition, Scope.Streams[1]));
+    ASSERT_TRUE(QuicOperationCoalesceStreamSend(&Scope.OperQ, Scope.Partition, Scope.Streams[2]));
+    ASSERT_EQ(2, Scope.Partition->PerfCounters[QUIC_PERF_COUNTER_CONN_OPER_COALESCED]);
+
+    //
+    // The streams are chained in the order their sends were queued.
+    //
+    ASSERT_EQ(Scope.Streams[1], Scope.Streams[0]->ApiSendNext);
+    ASSERT_EQ(Scope.Streams[2], Scope.Streams[1]->ApiSendNext);
+    ASSERT_EQ(nullptr, Scope.Streams[2]->ApiSendNext);
+    ASSERT_EQ(Scope.Streams[2], Send.ApiCtx.STRM_SEND.LastStream);
+
+    ASSERT_EQ(&Send.Oper, QuicOperationDequeue(&Scope.OperQ, Scope.Partition));
+    ASSERT_EQ(nullptr, QuicOperationDequeue(&Scope.OperQ, Scope.Partition));
+}
+
+TEST(OperationTest, CoalesceStreamSendKeepsOrder)
+{
+    OperationQueueScope Scope;
+    StreamSendOperation Send(Scope.Streams[0]);
+    QuicOperationEnqueue(&Scope.OperQ, Scope.Partition, &Send.Oper);
+
+    QUIC_OPERATION Flush;
+    CxPlatZeroMemory(&Flush, sizeof(Flush));
+    Flush.Type = QUIC_OPER_TYPE_FLUSH_SEND;
+    QuicOperationEnqueue(&Scope.OperQ, Scope.Partition, &Flush);
+
+    //
+    // A send operation that isn't at the tail can't take more streams.
+    //
+    ASSERT_FALSE(QuicOperationCoalesceStreamSend(&Scope.OperQ, Scope.Partition, Scope.Streams[1]));
+    ASSERT_EQ(nullptr, Scope.Streams[0]->ApiSendNext);
+}
+
+TEST(OperationTest, CoalesceStreamSendSkipsPriority)
+{
+    OperationQueueScope Scope;
+    StreamSendOperation Send(Scope.Streams[0]);
+    QuicOperationEnqueuePriority(&Scope.OperQ, Scope.Partition, &Send.Oper);
+
+    ASSERT_FALSE(QuicOperationCoalesceStreamSend(&Scope.OperQ, Scope.Partition, Scope.Streams[1]));
+
+    StreamSendOperation Send2(Scope.Streams[1]);
+    QuicOperationEnqueue(&Scope.OperQ, Scope.Partition, &Send2.Oper);
+
+    ASSERT_TRUE(QuicOperationCoalesceStreamSend(&Scope.OperQ, Scope.Partition, Scope.Streams[2]));
+    ASSERT_EQ(nullptr, Scope.Streams[0]->ApiSendNext);
+    ASSERT_EQ(Scope.Streams[2], Scope.Streams[1]->ApiSendNext);
+}
@@ -0,0 +1,199 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the worker pacing wheel.
+
+--*/
+
+#include "main.h"
+
+//
+// Only the connection fields the pacing wheel uses are initialized.
+//
+struct PacingConnections {
+    QUIC_CONNECTION** Connections;
+    uint32_t Count;
+    PacingConnections(uint32_t _Count) : Count(_Count) {
+        Connections = new(std::nothrow) QUIC_CONNECTION*[Count];
+        for (uint32_t i = 0; i < Count; ++i) {
+            Connections[i] =
+                (QUIC_CONNECTION*)CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_CONNECTION), QUIC_POOL_CONN);
+            CxPlatZeroMemory(Connections[i], sizeof(QUIC_CONNECTION));
+            Connections[i]->RefCount = 1;
+#if DEBUG
+            CxPlatRefInitializeMultiple(Connections[i]->RefTypeBiasedCount, QUIC_CONN_REF_COUNT);
+#endif
+        }
+    }
+    ~PacingConnections() {
+        for (uint32_t i = 0; i < Count; ++i) {
+            CXPLAT_FREE(Connections[i], QUIC_POOL_CONN);
+        }
+        delete [] Connections;
+    }
+    QUIC_CONNECTION* operator[](uint32_t Index) { return Connections[Index]; }
+};
+
+struct SmartPacingWheel {
+    QUIC_PACING_WHEEL Wheel;
+    SmartPacingWheel() {
+        QuicPacingWheelInitialize(&Wheel);
+    }
+    ~SmartPacingWheel() {
+        QuicPacingWheelUninitialize(&Wheel);
+    }
+    void Insert(QUIC_CONNECTION* Connection, uint64_t TimeNow, uint64_t DepartureTime) {
+        QuicPacingWheelInsertConnection(&Wheel, Connection, TimeNow, DepartureTime);
+    }
+    //
+    // Processes due connections the same way the worker does, and returns how
+    // many there were.
+    //
+    uint32_t Drain(uint64_t TimeNow) {
+        CXPLAT_LIST_ENTRY Due;
+        CxPlatListInitializeHead(&Due);
+        QuicPacingWheelGetDue(&Wheel, TimeNow, &Due);
+        uint32_t DueCount = 0;
+        while (!CxPlatListIsEmpty(&Due)) {
+            CXPLAT_LIST_ENTRY* Entry = CxPlatListRemoveHead(&Due);
+            Entry->Flink = NULL;
+            QUIC_CONNECTION* Connection =
+                CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, PacingLink);
+            EXPECT_LE(Connection->PacingDepartureTime, TimeNow);
+            QuicConnRelease(Connection, QUIC_CONN_REF_WORKER);
+            DueCount++;
+        }
+        return DueCount;
+    }
+};
+
+//
+// A tick aligned start time, so tick boundaries in the tests are predictable.
+//
+static uint64_t PacingTestStartTime()
+{
+    const uint64_t TimeNow = CxPlatTimeUs64();
+    return TimeNow - (TimeNow % QUIC_PACING_WHEEL_TICK_US);
+}
+
+TEST(PacingWheelTest, SameTickDepartsTogether)
+{
+    PacingConnections Conns(3);
+    SmartPacingWheel Wheel;
+    const uint64_t TimeNow = PacingTestStartTime();
+
+    ASSERT_EQ(UINT64_MAX, Wheel.Wheel.NextDepartureTime);
+    Wheel.Insert(Conns[0], TimeNow, TimeNow + 1000);
+    Wheel.Insert(Conns[1], TimeNow + 10, TimeNow + 1010);
+    Wheel.Insert(Conns[2], TimeNow + 100, TimeNow + 1100);
+    ASSERT_EQ(3u, Wheel.Wheel.ConnectionCount);
+    ASSERT_EQ(2, Conns[0]->RefCount);
+
+    //
+    // The first departs on its tick boundary, the others round up to the next
+    // tick and depart together.
+    //
+    ASSERT_EQ(TimeNow + 1000, Wheel.Wheel.NextDepartureTime);
+    ASSERT_EQ(0u, Wheel.Drain(TimeNow + 999));
+    ASSERT_EQ(1u, Wheel.Drain(TimeNow + 1000));
+    ASSERT_EQ(TimeNow + 1000 + QUIC_PACING_WHEEL_TICK_US, Wheel.Wheel.NextDepartureTime);
+    ASSERT_EQ(2u, Wheel.Drain(TimeNow + 1000 + QUIC_PACING_WHEEL_TICK_US));
+
+    ASSERT_EQ(0u, Wheel.Wheel.ConnectionCount);
+    ASSERT_EQ(UINT64_MAX, Wheel.Wheel.NextDepartureTime);
+    ASSERT_EQ(2ull, Wheel.Wheel.TickCount);
+    ASSERT_EQ(3ull, Wheel.Wheel.DepartureCount);
+    ASSERT_EQ(1, Conns[0]->RefCount);
+}
+
+TEST(PacingWheelTest, RescheduleAndRemove)
+{
+    PacingConnections Conns(2);
+    SmartPacingWheel Wheel;
+    const uint64_t TimeNow = PacingTestStartTime();
+
+    Wheel.Insert(Conns[0], TimeNow, TimeNow + 500);
+    Wheel.Insert(Conns[1], TimeNow, TimeNow + 1000);
+    ASSERT_EQ(TimeNow + 500, Wheel.Wheel.NextDepartureTime);
+
+    Wheel.Insert(Conns[0], TimeNow, TimeNow + 2000); // Move later
+    ASSERT_EQ(2u, Wheel.Wheel.ConnectionCount);
+    ASSERT_EQ(2, Conns[0]->RefCount);
+    ASSERT_EQ(TimeNow + 1000, Wheel.Wheel.NextDepartureTime);
+
+    QuicPacingWheelRemoveConnection(&Wheel.Wheel, Conns[1]);
+    ASSERT_EQ(1u, Wheel.Wheel.ConnectionCount);
+    ASSERT_EQ(1, Conns[1]->RefCount);
+    ASSERT_EQ(nullptr, Conns[1]->PacingLink.Flink);
+    ASSERT_EQ(TimeNow + 2000, Wheel.Wheel.NextDepartureTime);
+
+    QuicPacingWheelRemoveConnection(&Wheel.Wheel, Conns[1]); // No-op
+    ASSERT_EQ(0u, Wheel.Drain(TimeNow + 1999));
+    ASSERT_EQ(1u, Wheel.Drain(TimeNow + 2000));
+    ASSERT_EQ(UINT64_MAX, Wheel.Wheel.NextDepartureTime);
+}
+
+TEST(PacingWheelTest, IdleAndLateDrain)
+{
+    PacingConnections Conns(2);
+    SmartPacingWheel Wheel;
+    uint64_t TimeNow = PacingTestStartTime();
+
+    Wheel.Insert(Conns[0], TimeNow, TimeNow + 1000);
+    ASSERT_EQ(1u, Wheel.Drain(TimeNow + 1000));
+
+    //
+    // Nothing drains the wheel while it's idle, so the insert must advance it
+    // past all the stale ticks.
+    //
+    TimeNow += 10 * 1000 * 1000;
+    Wheel.Insert(Conns[0], TimeNow, TimeNow + 1000);
+    ASSERT_EQ(TimeNow + 1000, Wheel.Wheel.NextDepartureTime);
+
+    //
+    // Departures beyond the range of the wheel go in the last slot.
+    //
+    Wheel.Insert(Conns[1], TimeNow, TimeNow + 1000 * 1000);
+    ASSERT_EQ(
+        TimeNow + (QUIC_PACING_WHEEL_SLOT_COUNT - 1) * QUIC_PACING_WHEEL_TICK_US,
+        Conns[1]->PacingDepartureTime);
+
+    //
+    // A late drain releases everything that is due, in one pass.
+    //
+    ASSERT_EQ(2u, Wheel.Drain(TimeNow + 1000 * 1000));
+    ASSERT_EQ(0u, Wheel.Wheel.ConnectionCount);
+    ASSERT_EQ(UINT64_MAX, Wheel.Wheel.NextDepartureTime);
+}
+
+TEST(PacingWheelTest, ManyConnectionsBoundedByTicks)
+{
+    const uint32_t ConnCount = 1000;
+    PacingConnections Conns(ConnCount);
+    SmartPacingWheel Wheel;
+    const uint64_t TimeNow = PacingTestStartTime();
+
+    //
+    // Every connection blocks on pacing at a different time within the same
+    // millisecond, as if processed one after the other by the worker.
+    //
+    for (uint32_t i = 0; i < ConnCount; ++i) {
+        const uint64_t BlockTime = TimeNow + i;
+        Wheel.Insert(Conns[i], BlockTime, BlockTime + 1000);
+    }
+    ASSERT_EQ(ConnCount, Wheel.Wheel.ConnectionCount);
+
+    uint32_t Departures = 0;
+    uint32_t Wakes = 0;
+    while (Wheel.Wheel.NextDepartureTime != UINT64_MAX) {
+        Departures += Wheel.Drain(Wheel.Wheel.NextDepartureTime);
+        Wakes++;
+    }
+    ASSERT_EQ(ConnCount, Departures);
+    ASSERT_LE(Wakes, 1000 / QUIC_PACING_WHEEL_TICK_US + 1);
+    ASSERT_EQ((uint64_t)Wakes, Wheel.Wheel.TickCount);
+}
@@ -753,3 +753,195 @@ TEST(RangeTest, SearchRangeThree)
     ASSERT_EQ(index, 2);
 #endif
 }
+
+TEST(RangeTest, AddDescending)
+{
+    SmartRange range;
+    for (uint32_t i = 0; i < 100; i++) {
+        range.Add(1000 - i*3);
+        ASSERT_EQ(range.ValidCount(), i + 1);
+        ASSERT_EQ(range.Min(), 1000ull - i*3);
+        ASSERT_EQ(range.Max(), 1000ull);
+    }
+    for (uint32_t i = 0; i < 100; i++) {
+        ASSERT_EQ(QuicRangeGet(&range.range, i)->Low, 703ull + i*3);
+    }
+    //
+    // Fill in the gaps from both ends, merging everything into one subrange.
+    //
+    for (uint32_t i = 0; i < 50; i++) {
+        range.Add(1000 - i*3 - 2, 2);
+        range.Add(703 + i*3 + 1, 2);
+    }
+    ASSERT_EQ(range.ValidCount(), 1u);
+    ASSERT_EQ(range.Min(), 703ull);
+    ASSERT_EQ(range.Max(), 1000ull);
+}
+
+TEST(RangeTest, SetMinThenAppend)
+{
+    SmartRange range;
+    for (uint32_t Round = 0; Round < 10; Round++) {
+        for (uint32_t i = 0; i < 100; i++) {
+            range.Add((Round * 100 + i) * 2);
+        }
+        QuicRangeSetMin(&range.range, (Round * 100 + 90) * 2);
+        ASSERT_EQ(range.ValidCount(), 10u);
+        ASSERT_EQ(range.Min(), (Round * 100 + 90) * 2ull);
+        ASSERT_EQ(range.Max(), (Round * 100 + 99) * 2ull);
+    }
+    range.Add(0);
+    ASSERT_EQ(range.ValidCount(), 11u);
+    ASSERT_EQ(range.Min(), 0ull);
+}
+
+//
+// The following are microbenchmarks for the range hot paths, using packet
+// number patterns similar to what the ACK tracker and ACK frame decoder see.
+// Run them with --gtest_also_run_disabled_tests --gtest_filter=*Bench*. Each
+// reports the best of several rounds to filter out scheduling noise.
+//
+
+struct BenchRandom {
+    uint32_t State {0x12345678};
+    uint32_t Next() {
+        State = State * 1103515245 + 12345;
+        return State >> 8;
+    }
+};
+
+template<typename T>
+void
+RangeBench(
+    const char* Name,
+    uint64_t Operations,
+    T Round
+    )
+{
+    uint64_t Best = UINT64_MAX;
+    for (uint32_t i = 0; i < 5; ++i) {
+        const uint64_t Begin = CxPlatTimeUs64();
+        Round();
+        const uint64_t Elapsed = CxPlatTimeDiff64(Begin, CxPlatTimeUs64());
+        if (Elapsed < Best) {
+            Best = Elapsed;
+        }
+    }
+    printf("%s: %llu ops in %llu us (%llu ns/op)\n",
+        Name,
+        (unsigned long long)Operations,
+        (unsigned long long)Best,
+        (unsigned long long)(Best * 1000 / Operations));
+}
+
+//
+// Adds packet numbers in order with the given loss percentage, and the same
+// percentage reordered by a few packets. Calls SetMin every other packet to
+// keep a trailing window of values, unless Window is zero.
+//
+static
+void
+RangeBenchReceive(
+    _Inout_ QUIC_RANGE* Range,
+    uint64_t Count,
+    uint32_t LossPercent,
+    uint64_t Window
+    )
+{
+    const uint32_t ReorderDistance = 8;
+    uint64_t Delayed[ReorderDistance] = {0};
+    uint32_t DelayedCount = 0;
+    BenchRandom Random;
+    QuicRangeReset(Range);
+    for (uint64_t PacketNumber = 0; PacketNumber < Count; ++PacketNumber) {
+        if (Random.Next() % 100 < LossPercent) {
+            continue;
+        }
+        if (DelayedCount < ReorderDistance && Random.Next() % 100 < LossPercent) {
+            Delayed[DelayedCount++] = PacketNumber;
+            continue;
+        }
+        ASSERT_TRUE(QuicRangeAddValue(Range, PacketNumber));
+        if (DelayedCount != 0 && PacketNumber % ReorderDistance == 0) {
+            ASSERT_TRUE(QuicRangeAddValue(Range, Delayed[--DelayedCount]));
+        }
+        if (Window != 0 && (PacketNumber & 1) && PacketNumber > Window) {
+            QuicRangeSetMin(Range, PacketNumber - Window);
+        }
+    }
+}
+
+TEST(RangeTest, DISABLED_BenchReceive)
+{
+    //
+    // Tracking received packet numbers for duplicate detection, which runs at
+    // the allocation cap and ages out the oldest values.
+    //
+    const uint64_t Count = 1000000;
+    SmartRange Received(QUIC_MAX_RANGE_DUPLICATE_PACKETS);
+    RangeBench("receive 1% loss", Count, [&]() {
+        RangeBenchReceive(&Received.range, Count, 1, 0);
+    });
+    RangeBench("receive 5% loss", Count, [&]() {
+        RangeBenchReceive(&Received.range, Count, 5, 0);
+    });
+}
+
+TEST(RangeTest, DISABLED_BenchReceiveSetMin)
+{
+    //
+    // Tracking packet numbers to acknowledge, dropping the ones the peer has
+    // acknowledged receiving an ACK for.
+    //
+    const uint64_t Count = 1000000;
+    SmartRange ToAck(QUIC_MAX_RANGE_ACK_PACKETS);
+    RangeBench("receive+setmin 1% loss", Count, [&]() {
+        RangeBenchReceive(&ToAck.range, Count, 1, 2000);
+    });
+    RangeBench("receive+setmin 5% loss", Count, [&]() {
+        RangeBenchReceive(&ToAck.range, Count, 5, 2000);
+    });
+}
+
+TEST(RangeTest, DISABLED_BenchAckFrame)
+{
+    //
+    // Encode and decode an ACK frame with many blocks, as sent under heavy
+    // loss, into a range sized like the connection's DecodedAckRanges.
+    //
+    const uint32_t Iterations = 20000;
+    const uint32_t Blocks = 200;
+    SmartRange Acks;
+    BenchRandom Random;
+    for (uint32_t i = 0; i < Blocks; ++i) {
+        Acks.Add(1000 + i * 20, 1 + Random.Next() % 16);
+    }
+    ASSERT_EQ(Acks.ValidCount(), Blocks);
+
+    uint8_t Buffer[4096];
+    uint16_t Offset = 0;
+    RangeBench("encode 200 blocks", Iterations, [&]() {
+        for (uint32_t i = 0; i < Iterations; ++i) {
+            Offset = 0;
+            ASSERT_TRUE(
+                QuicAckFrameEncode(
+                    &Acks.range, 0, nullptr, &Offset, sizeof(Buffer), Buffer));
+        }
+    });
+
+    const uint16_t FrameLength = Offset;
+    SmartRange Decoded(QUIC_MAX_RANGE_DECODE_ACKS);
+    RangeBench("decode 200 blocks", Iterations, [&]() {
+        for (uint32_t i = 0; i < Iterations; ++i) {
+            BOOLEAN InvalidFrame;
+            uint64_t AckDelay;
+            Decoded.Reset();
+            Offset = 1; // Skip the frame type.
+            ASSERT_TRUE(
+                QuicAckFrameDecode(
+                    QUIC_FRAME_ACK, FrameLength, Buffer, &Offset, &InvalidFrame,
+                    &Decoded.range, nullptr, &AckDelay));
+        }
+    });
+    ASSERT_EQ(Decoded.ValidCount(), Blocks);
+}
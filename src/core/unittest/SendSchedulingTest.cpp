@@ -0,0 +1,412 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit tests for the stream send queue: the round robin, weighted fair and
+    deadline scheduling schemes, and the parking of streams blocked by flow
+    control.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "SendSchedulingTest.cpp.clog.h"
+#endif
+
+extern "C"
+void
+QuicSendInsertStreamByKey(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    );
+
+extern "C"
+void
+QuicSendInsertStream(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    );
+
+extern "C"
+QUIC_STREAM*
+QuicSendGetNextStream(
+    _In_ QUIC_SEND* Send,
+    _Out_ uint32_t* PacketCount
+    );
+
+#define SCHEDULING_STREAM_COUNT 4
+
+enum SchedulingScheme {
+    RoundRobin,
+    WeightedFair,
+    Deadline
+};
+
+//
+// Only the connection and stream fields the send queue uses are initialized.
+//
+struct SchedulingConnection {
+    QUIC_CONNECTION* Connection;
+    QUIC_STREAM* Streams;
+    QUIC_SEND_REQUEST Requests[SCHEDULING_STREAM_COUNT];
+    SchedulingConnection(SchedulingScheme Scheme) {
+        Connection =
+            (QUIC_CONNECTION*)CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_CONNECTION), QUIC_POOL_CONN);
+        CXPLAT_FRE_ASSERT(Connection);
+        CxPlatZeroMemory(Connection, sizeof(QUIC_CONNECTION));
+        if (Scheme == Deadline) {
+            Connection->State.UseDeadlineStreamScheduling = TRUE;
+        } else if (Scheme == WeightedFair) {
+            Connection->State.UseWeightedFairStreamScheduling = TRUE;
+        } else {
+            Connection->State.UseRoundRobinStreamScheduling = TRUE;
+        }
+        Connection->Crypto.TlsState.WriteKey = QUIC_PACKET_KEY_1_RTT;
+        Connection->Streams.Types[STREAM_ID_FLAG_IS_CLIENT | STREAM_ID_FLAG_IS_BI_DIR].MaxTotalStreamCount =
+            SCHEDULING_STREAM_COUNT;
+        Connection->Send.PeerMaxData = UINT64_MAX;
+        CxPlatListInitializeHead(&Connection->Send.SendStreams);
+        CxPlatListInitializeHead(&Connection->Send.SendPriorityGroups);
+        CxPlatListInitializeHead(&Connection->Send.BlockedSendStreams);
+        Streams = new(std::nothrow) QUIC_STREAM[SCHEDULING_STREAM_COUNT];
+        CXPLAT_FRE_ASSERT(Streams);
+        CxPlatZeroMemory(Streams, sizeof(QUIC_STREAM) * SCHEDULING_STREAM_COUNT);
+        CxPlatZeroMemory(Requests, sizeof(Requests));
+        for (uint32_t i = 0; i < SCHEDULING_STREAM_COUNT; ++i) {
+            Streams[i].Connection = Connection;
+            Streams[i].ID = (i << 2) | STREAM_ID_FLAG_IS_CLIENT | STREAM_ID_FLAG_IS_BI_DIR;
+            Streams[i].MaxAllowedSendOffset = UINT64_MAX;
+        }
+    }
+    ~SchedulingConnection() {
+        delete [] Streams;
+        CXPLAT_FREE(Connection, QUIC_POOL_CONN);
+    }
+    QUIC_SEND* Send() { return &Connection->Send; }
+    void Insert(uint32_t Index) {
+        QuicSendInsertStreamByKey(Send(), &Streams[Index]);
+    }
+    void SetDeadline(uint32_t Index, uint64_t Deadline) {
+        Requests[Index].Deadline = Deadline;
+        Streams[Index].SendBookmark = &Requests[Index];
+    }
+    //
+    // Queues new data on the stream, the same way QuicStreamSendFlush does.
+    //
+    void QueueData(uint32_t Index, uint64_t Length) {
+        Streams[Index].QueuedSendOffset += Length;
+        Streams[Index].SendFlags |= QUIC_STREAM_SEND_FLAG_DATA;
+        if (Streams[Index].SendLink.Flink == NULL) {
+            QuicSendInsertStream(Send(), &Streams[Index]);
+        }
+    }
+    //
+    // Returns the index of the stream the send loop would frame next, or
+    // SCHEDULING_STREAM_COUNT if there is none.
+    //
+    uint32_t Next() {
+        uint32_t PacketCount;
+        QUIC_STREAM* Stream = QuicSendGetNextStream(Send(), &PacketCount);
+        return Stream == NULL ? SCHEDULING_STREAM_COUNT : (uint32_t)(Stream - Streams);
+    }
+    bool IsParked(uint32_t Index) {
+        return Streams[Index].Flags.SendBlocked;
+    }
+    uint32_t QueuedCount() {
+        uint32_t Count = 0;
+        for (CXPLAT_LIST_ENTRY* Entry = Send()->SendStreams.Flink;
+            Entry != &Send()->SendStreams; Entry = Entry->Flink) {
+            ++Count;
+        }
+        return Count;
+    }
+    //
+    // Returns the index of the stream at the given position in the queue.
+    //
+    uint32_t At(uint32_t Position) {
+        CXPLAT_LIST_ENTRY* Entry = Send()->SendStreams.Flink;
+        while (Position-- > 0) {
+            Entry = Entry->Flink;
+        }
+        return (uint32_t)(CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink) - Streams);
+    }
+    //
+    // Sends a packet's worth from the first stream in the queue, the same way
+    // the send loop does, and returns the index of the stream.
+    //
+    uint32_t SendOne(uint16_t Length) {
+        QUIC_STREAM* Stream =
+            CXPLAT_CONTAINING_RECORD(Send()->SendStreams.Flink, QUIC_STREAM, SendLink);
+        Send()->VirtualTime = Stream->SendScheduleKey;
+        QuicSendOnStreamDataWritten(Send(), Stream, Length);
+        return (uint32_t)(Stream - Streams);
+    }
+};
+
+TEST(SendSchedulingTest, WeightedFairShare)
+{
+    SchedulingConnection Conn(WeightedFair);
+    Conn.Streams[0].SendPriority = 0; // Weight 1
+    Conn.Streams[1].SendPriority = 1; // Weight 2
+    Conn.Streams[2].SendPriority = 3; // Weight 4
+    Conn.Insert(0);
+    Conn.Insert(1);
+    Conn.Insert(2);
+
+    uint64_t Bytes[3] = {0};
+    for (uint32_t i = 0; i < 7000; ++i) {
+        Bytes[Conn.SendOne(1000)] += 1000;
+    }
+
+    //
+    // Each stream gets bytes in proportion to its weight, to within a packet.
+    //
+    ASSERT_NEAR((double)Bytes[0], 1000000.0, 1000.0);
+    ASSERT_NEAR((double)Bytes[1], 2000000.0, 1000.0);
+    ASSERT_NEAR((double)Bytes[2], 4000000.0, 1000.0);
+}
+
+TEST(SendSchedulingTest, WeightedFairNewStreamStartsAtVirtualTime)
+{
+    SchedulingConnection Conn(WeightedFair);
+    Conn.Insert(0);
+    Conn.Insert(1);
+    for (uint32_t i = 0; i < 100; ++i) {
+        Conn.SendOne(1000);
+    }
+
+    //
+    // A stream that joins late doesn't get to catch up on the time it wasn't
+    // sending, so it shares evenly from here on.
+    //
+    Conn.Insert(2);
+    ASSERT_EQ(Conn.Streams[2].SendScheduleKey, Conn.Send()->VirtualTime);
+
+    uint64_t Bytes[3] = {0};
+    for (uint32_t i = 0; i < 300; ++i) {
+        Bytes[Conn.SendOne(1000)] += 1000;
+    }
+    ASSERT_NEAR((double)Bytes[2], 100000.0, 1000.0);
+}
+
+TEST(SendSchedulingTest, EarliestDeadlineFirst)
+{
+    SchedulingConnection Conn(Deadline);
+    const uint64_t TimeNow = CxPlatTimeUs64();
+    Conn.SetDeadline(0, 0);                     // No deadline
+    Conn.SetDeadline(1, TimeNow + 30000000);
+    Conn.SetDeadline(2, TimeNow + 10000000);
+    Conn.SetDeadline(3, 1);                     // Already missed
+    for (uint32_t i = 0; i < SCHEDULING_STREAM_COUNT; ++i) {
+        Conn.Insert(i);
+    }
+
+    //
+    // Streams without a (reachable) deadline go last, in insertion order.
+    //
+    ASSERT_EQ(Conn.At(0), 2u);
+    ASSERT_EQ(Conn.At(1), 1u);
+    ASSERT_EQ(Conn.At(2), 0u);
+    ASSERT_EQ(Conn.At(3), 3u);
+}
+
+TEST(SendSchedulingTest, ReorderToDeadlines)
+{
+    SchedulingConnection Conn(WeightedFair);
+    const uint64_t TimeNow = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < SCHEDULING_STREAM_COUNT; ++i) {
+        Conn.SetDeadline(i, TimeNow + (SCHEDULING_STREAM_COUNT - i) * 10000000ull);
+        Conn.Insert(i);
+    }
+    for (uint32_t i = 0; i < SCHEDULING_STREAM_COUNT; ++i) {
+        ASSERT_EQ(Conn.At(i), i);
+    }
+
+    //
+    // Switching schemes requeues every stream by its new key.
+    //
+    Conn.Connection->State.UseWeightedFairStreamScheduling = FALSE;
+    Conn.Connection->State.UseDeadlineStreamScheduling = TRUE;
+    QuicSendReorderStreams(Conn.Send());
+    for (uint32_t i = 0; i < SCHEDULING_STREAM_COUNT; ++i) {
+        ASSERT_EQ(Conn.At(i), SCHEDULING_STREAM_COUNT - 1 - i);
+    }
+}
+
+TEST(SendSchedulingTest, RoundRobinWithinPriority)
+{
+    SchedulingConnection Conn(RoundRobin);
+    Conn.Streams[0].SendPriority = 1;
+    Conn.Streams[1].SendPriority = 2;
+    Conn.Streams[2].SendPriority = 2;
+    Conn.Streams[3].SendPriority = 2;
+    for (uint32_t i = 0; i < SCHEDULING_STREAM_COUNT; ++i) {
+        Conn.QueueData(i, 10000);
+    }
+
+    //
+    // The higher priority streams take turns, and the lower priority one waits
+    // until they have nothing left to send.
+    //
+    for (uint32_t i = 0; i < 6; ++i) {
+        ASSERT_EQ(Conn.Next(), 1 + i % 3);
+    }
+    ASSERT_EQ(Conn.At(3), 0u);
+
+    Conn.Streams[1].NextSendOffset = Conn.Streams[1].QueuedSendOffset;
+    Conn.Streams[2].NextSendOffset = Conn.Streams[2].QueuedSendOffset;
+    Conn.Streams[3].NextSendOffset = Conn.Streams[3].QueuedSendOffset;
+    ASSERT_EQ(Conn.Next(), 0u);
+}
+
+TEST(SendSchedulingTest, ParkOnConnectionFlowControl)
+{
+    SchedulingConnection Conn(RoundRobin);
+    Conn.Send()->PeerMaxData = 1000;
+    Conn.Send()->OrderedStreamBytesSent = 1000;
+    Conn.QueueData(0, 1000);
+    Conn.QueueData(1, 1000);
+
+    ASSERT_EQ(Conn.Next(), (uint32_t)SCHEDULING_STREAM_COUNT);
+    ASSERT_TRUE(Conn.IsParked(0));
+    ASSERT_TRUE(Conn.IsParked(1));
+    ASSERT_EQ(Conn.QueuedCount(), 0u);
+    ASSERT_TRUE(QuicSendHasQueuedStreams(Conn.Send()));
+
+    //
+    // MAX_DATA raises the connection's limit and unparks every stream, in the
+    // order they were parked.
+    //
+    Conn.Send()->PeerMaxData = 2000;
+    QuicSendUnblockAllStreams(Conn.Send());
+    ASSERT_FALSE(Conn.IsParked(0));
+    ASSERT_FALSE(Conn.IsParked(1));
+    ASSERT_EQ(Conn.QueuedCount(), 2u);
+    ASSERT_EQ(Conn.At(0), 0u);
+    ASSERT_EQ(Conn.At(1), 1u);
+    ASSERT_EQ(Conn.Next(), 0u);
+}
+
+TEST(SendSchedulingTest, ParkOnStreamFlowControl)
+{
+    SchedulingConnection Conn(RoundRobin);
+    Conn.Streams[0].MaxAllowedSendOffset = 0;
+    Conn.QueueData(0, 1000);
+    Conn.QueueData(1, 1000);
+
+    //
+    // Only the stream that is out of flow control is parked.
+    //
+    ASSERT_EQ(Conn.Next(), 1u);
+    ASSERT_TRUE(Conn.IsParked(0));
+    ASSERT_FALSE(Conn.IsParked(1));
+    ASSERT_EQ(Conn.QueuedCount(), 1u);
+
+    //
+    // MAX_STREAM_DATA raises the stream's limit and unparks it.
+    //
+    Conn.Send()->FlushOperationPending = TRUE; // Don't queue a flush operation.
+    QUIC_MAX_STREAM_DATA_EX Frame = { Conn.Streams[0].ID, 5000 };
+    uint8_t Buffer[32];
+    uint16_t BufferLength = 0;
+    ASSERT_TRUE(QuicMaxStreamDataFrameEncode(&Frame, &BufferLength, sizeof(Buffer), Buffer));
+    QUIC_RX_PACKET Packet;
+    CxPlatZeroMemory(&Packet, sizeof(Packet));
+    uint16_t Offset = sizeof(uint8_t); // Frame type
+    BOOLEAN UpdatedFlowControl = FALSE;
+    ASSERT_EQ(
+        QUIC_STATUS_SUCCESS,
+        QuicStreamRecv(
+            &Conn.Streams[0],
+            &Packet,
+            QUIC_FRAME_MAX_STREAM_DATA,
+            BufferLength,
+            Buffer,
+            &Offset,
+            &UpdatedFlowControl));
+    ASSERT_TRUE(UpdatedFlowControl);
+    ASSERT_FALSE(Conn.IsParked(0));
+    ASSERT_EQ(Conn.QueuedCount(), 2u);
+    ASSERT_EQ(Conn.At(1), 0u);
+}
+
+TEST(SendSchedulingTest, UnparkOnTransportParameters)
+{
+    SchedulingConnection Conn(WeightedFair);
+    Conn.Send()->PeerMaxData = 0;
+    Conn.QueueData(0, 1000);
+    ASSERT_EQ(Conn.Next(), (uint32_t)SCHEDULING_STREAM_COUNT);
+    ASSERT_TRUE(Conn.IsParked(0));
+
+    //
+    // The peer's transport parameters replace the connection's initial limit
+    // (after resuming with 0-RTT, for instance), which unparks the streams the
+    // same way MAX_DATA does.
+    //
+    Conn.Connection->PeerTransportParams.InitialMaxData = 10000;
+    Conn.Send()->PeerMaxData = Conn.Connection->PeerTransportParams.InitialMaxData;
+    QuicSendUnblockAllStreams(Conn.Send());
+    ASSERT_FALSE(Conn.IsParked(0));
+    ASSERT_EQ(Conn.Next(), 0u);
+}
+
+TEST(SendSchedulingTest, NotParkedWithOtherWork)
+{
+    SchedulingConnection Conn(RoundRobin);
+    Conn.Send()->PeerMaxData = 0;
+
+    //
+    // A stream that has a control frame or lost data to send isn't blocked by
+    // flow control, so it stays queued.
+    //
+    Conn.QueueData(0, 1000);
+    Conn.Streams[0].SendFlags |= QUIC_STREAM_SEND_FLAG_MAX_DATA;
+    Conn.QueueData(1, 1000);
+    Conn.Streams[1].NextSendOffset = 1000;
+    Conn.Streams[1].QueuedSendOffset = 2000;
+    Conn.Streams[1].RecoveryNextOffset = 0;
+    Conn.Streams[1].RecoveryEndOffset = 1000;
+    ASSERT_EQ(Conn.Next(), 0u);
+    ASSERT_EQ(Conn.Next(), 1u);
+    ASSERT_FALSE(Conn.IsParked(0));
+    ASSERT_FALSE(Conn.IsParked(1));
+
+    //
+    // FIFO scheduling never parks, since a stream unparked at the end of its
+    // priority would lose its place.
+    //
+    Conn.Connection->State.UseRoundRobinStreamScheduling = FALSE;
+    Conn.QueueData(2, 1000);
+    Conn.Streams[0].SendFlags = QUIC_STREAM_SEND_FLAG_DATA;
+    Conn.Streams[1].RecoveryEndOffset = 0;
+    ASSERT_EQ(Conn.Next(), (uint32_t)SCHEDULING_STREAM_COUNT);
+    ASSERT_FALSE(Conn.IsParked(2));
+    ASSERT_EQ(Conn.QueuedCount(), 3u);
+}
+
+TEST(SendSchedulingTest, UnparkKeepsPriorityOrder)
+{
+    SchedulingConnection Conn(RoundRobin);
+    Conn.Streams[0].SendPriority = 2;
+    Conn.Streams[1].SendPriority = 2;
+    Conn.Streams[2].SendPriority = 1;
+    Conn.Streams[0].MaxAllowedSendOffset = 0;
+    Conn.QueueData(0, 1000);
+    Conn.QueueData(1, 1000);
+    Conn.QueueData(2, 1000);
+    ASSERT_EQ(Conn.Next(), 1u);
+    ASSERT_TRUE(Conn.IsParked(0));
+
+    //
+    // An unparked stream goes back to the end of its own priority group.
+    //
+    Conn.Streams[0].MaxAllowedSendOffset = 5000;
+    QuicSendUnblockStream(Conn.Send(), &Conn.Streams[0]);
+    ASSERT_EQ(Conn.QueuedCount(), 3u);
+    ASSERT_EQ(Conn.At(0), 1u);
+    ASSERT_EQ(Conn.At(1), 0u);
+    ASSERT_EQ(Conn.At(2), 2u);
+}
@@ -0,0 +1,292 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the sent packet store (list or QUIC_SENT_PACKET_RING) used
+    by loss detection.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "SentPacketStoreTest.cpp.clog.h"
+#endif
+
+//
+// Only the packet number of the metadata is used by the store.
+//
+struct TestPackets {
+    QUIC_SENT_PACKET_METADATA* Packets;
+    uint32_t Count;
+    TestPackets(uint32_t _Count) : Count(_Count) {
+        Packets = new(std::nothrow) QUIC_SENT_PACKET_METADATA[Count];
+        CxPlatZeroMemory(Packets, Count * sizeof(QUIC_SENT_PACKET_METADATA));
+        for (uint32_t i = 0; i < Count; ++i) {
+            Packets[i].PacketNumber = i;
+        }
+    }
+    ~TestPackets() {
+        delete [] Packets;
+    }
+    QUIC_SENT_PACKET_METADATA* operator[](uint64_t Index) { return &Packets[Index]; }
+};
+
+struct SmartStore {
+    QUIC_SENT_PACKET_STORE Store;
+    SmartStore() {
+        QuicSentPacketStoreInitialize(&Store);
+    }
+    ~SmartStore() {
+        QUIC_SENT_PACKET_CURSOR Cursor;
+        while (QuicSentPacketStoreFirst(&Store, &Cursor) != NULL) {
+            QuicSentPacketStoreRemove(&Store, &Cursor);
+        }
+        QuicSentPacketStoreUninitialize(&Store);
+    }
+    void Insert(QUIC_SENT_PACKET_METADATA* Packet) {
+        ASSERT_TRUE(QuicSentPacketStoreInsert(&Store, Packet));
+    }
+    //
+    // Removes all the packets in [Low, High], like an ACK block, and returns
+    // how many there were.
+    //
+    uint32_t RemoveRange(QUIC_SENT_PACKET_CURSOR* Cursor, uint64_t Low, uint64_t High) {
+        uint32_t Removed = 0;
+        QUIC_SENT_PACKET_METADATA* Packet = QuicSentPacketStoreSeek(&Store, Cursor, Low);
+        while (Packet != NULL && Packet->PacketNumber <= High) {
+            Packet = QuicSentPacketStoreRemove(&Store, Cursor);
+            Removed++;
+        }
+        return Removed;
+    }
+    uint32_t Count() {
+        uint32_t Count = 0;
+        uint64_t Last = 0;
+        QUIC_SENT_PACKET_CURSOR Cursor;
+        for (QUIC_SENT_PACKET_METADATA* Packet = QuicSentPacketStoreFirst(&Store, &Cursor);
+             Packet != NULL;
+             Packet = QuicSentPacketStoreNext(&Store, &Cursor)) {
+            if (Count++ != 0) {
+                EXPECT_LT(Last, Packet->PacketNumber);
+            }
+            Last = Packet->PacketNumber;
+        }
+        return Count;
+    }
+};
+
+TEST(SentPacketStoreTest, Basic)
+{
+    TestPackets Packets(8);
+    SmartStore Store;
+    QUIC_SENT_PACKET_CURSOR Cursor;
+
+    ASSERT_TRUE(QuicSentPacketStoreIsEmpty(&Store.Store));
+    ASSERT_EQ(nullptr, QuicSentPacketStoreFirst(&Store.Store, &Cursor));
+    ASSERT_EQ(nullptr, QuicSentPacketStoreLast(&Store.Store));
+
+    for (uint32_t i = 0; i < 8; ++i) {
+        if (i != 3) { // Skipped packet number
+            Store.Insert(Packets[i]);
+        }
+    }
+    ASSERT_FALSE(QuicSentPacketStoreIsEmpty(&Store.Store));
+    ASSERT_EQ(7u, Store.Count());
+    ASSERT_EQ(Packets[0], QuicSentPacketStoreFirst(&Store.Store, &Cursor));
+    ASSERT_EQ(Packets[7], QuicSentPacketStoreLast(&Store.Store));
+
+    ASSERT_EQ(Packets[4], QuicSentPacketStoreSeek(&Store.Store, &Cursor, 3));
+    ASSERT_EQ(Packets[5], QuicSentPacketStoreRemove(&Store.Store, &Cursor));
+    ASSERT_EQ(Packets[6], QuicSentPacketStoreNext(&Store.Store, &Cursor));
+    ASSERT_EQ(Packets[6], QuicSentPacketStoreSeek(&Store.Store, &Cursor, 1)); // Never backwards
+    ASSERT_EQ(Packets[7], QuicSentPacketStoreRemove(&Store.Store, &Cursor));
+    ASSERT_EQ(nullptr, QuicSentPacketStoreRemove(&Store.Store, &Cursor));
+    ASSERT_EQ(Packets[5], QuicSentPacketStoreLast(&Store.Store));
+    ASSERT_EQ(4u, Store.Count());
+
+    QuicSentPacketStoreFirst(&Store.Store, &Cursor);
+    ASSERT_EQ(3u, Store.RemoveRange(&Cursor, 0, 2));
+    ASSERT_EQ(Packets[5], QuicSentPacketStoreFirst(&Store.Store, &Cursor));
+    ASSERT_EQ(1u, Store.RemoveRange(&Cursor, 5, 5));
+    ASSERT_TRUE(QuicSentPacketStoreIsEmpty(&Store.Store));
+    ASSERT_EQ(nullptr, QuicSentPacketStoreLast(&Store.Store));
+
+    Store.Insert(Packets[2]); // Reuse after empty
+    ASSERT_EQ(Packets[2], QuicSentPacketStoreFirst(&Store.Store, &Cursor));
+    ASSERT_EQ(Packets[2], QuicSentPacketStoreLast(&Store.Store));
+}
+
+TEST(SentPacketStoreTest, AckRanges)
+{
+    //
+    // Enough packets to make the ring grow and wrap several times, acked in
+    // blocks of ascending ranges with gaps that are later "lost".
+    //
+    const uint32_t Count = 20000;
+    TestPackets Packets(Count);
+    SmartStore Sent;
+    SmartStore Lost;
+    uint32_t Outstanding = 0;
+    uint32_t LostCount = 0;
+    uint64_t Next = 0;
+
+    while (Next < Count) {
+        for (uint32_t i = 0; i < 100 && Next < Count; ++i) {
+            Sent.Insert(Packets[Next++]);
+            Outstanding++;
+        }
+
+        //
+        // ACK everything but every 7th packet of the last 100.
+        //
+        QUIC_SENT_PACKET_CURSOR Cursor;
+        QuicSentPacketStoreFirst(&Sent.Store, &Cursor);
+        uint64_t Low = Next > 100 ? Next - 100 : 0;
+        while (Low < Next) {
+            uint64_t High = CXPLAT_MIN(Low + 6, Next) - 1;
+            Outstanding -= Sent.RemoveRange(&Cursor, Low, High);
+            Low = High + 2;
+        }
+        ASSERT_EQ(Outstanding, Sent.Count());
+
+        //
+        // Move everything but the newest packets to the lost store.
+        //
+        QUIC_SENT_PACKET_METADATA* Packet = QuicSentPacketStoreFirst(&Sent.Store, &Cursor);
+        while (Packet != NULL && Packet->PacketNumber + 10 < Next) {
+            QUIC_SENT_PACKET_METADATA* NextPacket = QuicSentPacketStoreRemove(&Sent.Store, &Cursor);
+            Lost.Insert(Packet);
+            Outstanding--;
+            LostCount++;
+            Packet = NextPacket;
+        }
+        ASSERT_EQ(Outstanding, Sent.Count());
+        ASSERT_EQ(LostCount, Lost.Count());
+    }
+
+    //
+    // A late ACK for every packet finds all the (spuriously) lost ones.
+    //
+    QUIC_SENT_PACKET_CURSOR Cursor;
+    QuicSentPacketStoreFirst(&Lost.Store, &Cursor);
+    ASSERT_EQ(LostCount, Lost.RemoveRange(&Cursor, 0, Count));
+    ASSERT_TRUE(QuicSentPacketStoreIsEmpty(&Lost.Store));
+}
+
+#ifdef QUIC_SENT_PACKET_RING
+TEST(SentPacketStoreTest, RingOutOfOrderInsert)
+{
+    //
+    // During the handshake, packets can be declared lost out of order.
+    //
+    TestPackets Packets(1000);
+    SmartStore Store;
+    QUIC_SENT_PACKET_CURSOR Cursor;
+
+    Store.Insert(Packets[500]);
+    Store.Insert(Packets[999]);
+    Store.Insert(Packets[0]);
+    Store.Insert(Packets[700]);
+    ASSERT_EQ(4u, Store.Count());
+    ASSERT_EQ(Packets[0], QuicSentPacketStoreFirst(&Store.Store, &Cursor));
+    ASSERT_EQ(Packets[999], QuicSentPacketStoreLast(&Store.Store));
+    ASSERT_EQ(Packets[500], QuicSentPacketStoreSeek(&Store.Store, &Cursor, 1));
+
+    QuicSentPacketStoreSeek(&Store.Store, &Cursor, 999);
+    ASSERT_EQ(nullptr, QuicSentPacketStoreRemove(&Store.Store, &Cursor));
+    ASSERT_EQ(Packets[700], QuicSentPacketStoreLast(&Store.Store));
+}
+#endif
+
+//
+// Compares ACK processing and loss scans over a large, high BDP window of
+// outstanding packets. Run explicitly with --gtest_also_run_disabled_tests,
+// ideally in a release build, once with and once without
+// QUIC_SENT_PACKET_RING to compare the two implementations.
+//
+TEST(SentPacketStoreTest, DISABLED_HighBdpAckProcessing)
+{
+    const uint32_t InFlight = 50000;
+    const uint32_t PacketsPerAck = 2;
+    const uint32_t AckWindow = 256;
+    const uint32_t Count = InFlight * 20;
+    TestPackets Packets(Count);
+    bool* Dropped = new(std::nothrow) bool[Count];
+    SmartStore Sent;
+    SmartStore Lost;
+    uint32_t Random = 0x12345678;
+    for (uint32_t i = 0; i < Count; ++i) {
+        Random = Random * 1103515245 + 12345;
+        Dropped[i] = (Random >> 8) % 100 == 0; // ~1% loss
+    }
+
+    uint64_t Next = 0;
+    while (Next < InFlight) {
+        Sent.Insert(Packets[Next++]);
+    }
+
+    uint64_t Acks = 0;
+    uint64_t LostCount = 0;
+    uint64_t LargestAcked = 0;
+    const uint64_t Begin = CxPlatTimeUs64();
+    while (Next < Count) {
+        //
+        // Each ACK acknowledges the next few packets and also repeats the
+        // ranges (split by the dropped packets) of the last AckWindow packet
+        // numbers, like the peer does until its ACKs are acknowledged.
+        //
+        LargestAcked += PacketsPerAck;
+        QUIC_SENT_PACKET_CURSOR LostCursor;
+        QUIC_SENT_PACKET_CURSOR SentCursor;
+        QuicSentPacketStoreFirst(&Lost.Store, &LostCursor);
+        QuicSentPacketStoreFirst(&Sent.Store, &SentCursor);
+        uint64_t Low = LargestAcked > AckWindow ? LargestAcked - AckWindow : 0;
+        while (Low <= LargestAcked) {
+            if (Dropped[Low]) {
+                Low++;
+                continue;
+            }
+            uint64_t High = Low;
+            while (High < LargestAcked && !Dropped[High + 1]) {
+                High++;
+            }
+            Lost.RemoveRange(&LostCursor, Low, High);
+            Sent.RemoveRange(&SentCursor, Low, High);
+            Low = High + 2;
+        }
+        Acks++;
+
+        //
+        // FACK loss scan from the oldest outstanding packet.
+        //
+        QUIC_SENT_PACKET_METADATA* Packet = QuicSentPacketStoreFirst(&Sent.Store, &SentCursor);
+        while (Packet != NULL && Packet->PacketNumber + 3 < LargestAcked) {
+            QUIC_SENT_PACKET_METADATA* NextPacket = QuicSentPacketStoreRemove(&Sent.Store, &SentCursor);
+            ASSERT_TRUE(QuicSentPacketStoreInsert(&Lost.Store, Packet));
+            Packet = NextPacket;
+            LostCount++;
+        }
+
+        //
+        // Forget lost packets once they are a full window behind.
+        //
+        while ((Packet = QuicSentPacketStoreFirst(&Lost.Store, &LostCursor)) != NULL &&
+               Packet->PacketNumber + InFlight < LargestAcked) {
+            QuicSentPacketStoreRemove(&Lost.Store, &LostCursor);
+        }
+
+        for (uint32_t i = 0; i < PacketsPerAck && Next < Count; ++i) {
+            Sent.Insert(Packets[Next++]);
+        }
+    }
+    const uint64_t Elapsed = CxPlatTimeDiff64(Begin, CxPlatTimeUs64());
+    printf("%llu ACKs (%llu packets lost) in %llu us (%llu ns/ACK)\n",
+        (unsigned long long)Acks,
+        (unsigned long long)LostCount,
+        (unsigned long long)Elapsed,
+        (unsigned long long)(Elapsed * 1000 / Acks));
+    delete [] Dropped;
+}
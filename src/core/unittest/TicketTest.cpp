@@ -623,6 +623,7 @@ TEST(ResumptionTicketTest, ServerEncDecNoAppDataWithIpV4CR)
         { QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC, "CUBIC" },
 #if defined(QUIC_API_ENABLE_PREVIEW_FEATURES)
         { QUIC_CONGESTION_CONTROL_ALGORITHM_BBR, "BBR" },
+        { QUIC_CONGESTION_CONTROL_ALGORITHM_BBR3, "BBR3" },
 #endif
     };
 
@@ -829,6 +830,7 @@ TEST(ResumptionTicketTest, ServerEncDecNoAppDataWithIpV6CR)
         { QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC, "CUBIC" },
 #if defined(QUIC_API_ENABLE_PREVIEW_FEATURES)
         { QUIC_CONGESTION_CONTROL_ALGORITHM_BBR, "BBR" },
+        { QUIC_CONGESTION_CONTROL_ALGORITHM_BBR3, "BBR3" },
 #endif
     };
 
@@ -0,0 +1,236 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the connection timer wheel.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "TimerWheelTest.cpp.clog.h"
+#endif
+
+//
+// Only the connection fields the timer wheel uses are initialized.
+//
+struct TestConnections {
+    QUIC_CONNECTION** Connections;
+    uint32_t Count;
+    TestConnections(uint32_t _Count) : Count(_Count) {
+        Connections = new(std::nothrow) QUIC_CONNECTION*[Count];
+        for (uint32_t i = 0; i < Count; ++i) {
+            Connections[i] =
+                (QUIC_CONNECTION*)CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_CONNECTION), QUIC_POOL_CONN);
+            CxPlatZeroMemory(Connections[i], sizeof(QUIC_CONNECTION));
+            Connections[i]->RefCount = 1;
+#if DEBUG
+            CxPlatRefInitializeMultiple(Connections[i]->RefTypeBiasedCount, QUIC_CONN_REF_COUNT);
+#endif
+            Connections[i]->EarliestExpirationTime = UINT64_MAX;
+        }
+    }
+    ~TestConnections() {
+        for (uint32_t i = 0; i < Count; ++i) {
+            CXPLAT_FREE(Connections[i], QUIC_POOL_CONN);
+        }
+        delete [] Connections;
+    }
+    QUIC_CONNECTION* operator[](uint32_t Index) { return Connections[Index]; }
+};
+
+struct SmartTimerWheel {
+    QUIC_TIMER_WHEEL Wheel;
+    SmartTimerWheel() {
+        EXPECT_EQ(QUIC_STATUS_SUCCESS, QuicTimerWheelInitialize(&Wheel));
+    }
+    ~SmartTimerWheel() {
+        QuicTimerWheelUninitialize(&Wheel);
+    }
+    void Set(QUIC_CONNECTION* Connection, uint64_t ExpirationTime) {
+        Connection->EarliestExpirationTime = ExpirationTime;
+        QuicTimerWheelUpdateConnection(&Wheel, Connection);
+    }
+    //
+    // Processes expired connections the same way the worker does, and
+    // returns how many there were.
+    //
+    uint32_t Expire(uint64_t TimeNow) {
+        CXPLAT_LIST_ENTRY Expired;
+        CxPlatListInitializeHead(&Expired);
+        QuicTimerWheelGetExpired(&Wheel, TimeNow, &Expired);
+        uint32_t ExpiredCount = 0;
+        while (!CxPlatListIsEmpty(&Expired)) {
+            CXPLAT_LIST_ENTRY* Entry = CxPlatListRemoveHead(&Expired);
+            Entry->Flink = NULL;
+            QUIC_CONNECTION* Connection =
+                CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, TimerLink);
+            EXPECT_LE(Connection->EarliestExpirationTime, TimeNow);
+            Connection->EarliestExpirationTime = UINT64_MAX;
+            QuicConnRelease(Connection, QUIC_CONN_REF_WORKER);
+            ExpiredCount++;
+        }
+        return ExpiredCount;
+    }
+};
+
+TEST(TimerWheelTest, Basic)
+{
+    TestConnections Conns(2);
+    SmartTimerWheel Wheel;
+    const uint64_t TimeNow = CxPlatTimeUs64();
+
+    ASSERT_EQ(UINT64_MAX, Wheel.Wheel.NextExpirationTime);
+    Wheel.Set(Conns[0], TimeNow + 10000);
+    Wheel.Set(Conns[1], TimeNow + 5000);
+    ASSERT_EQ(2ull, Wheel.Wheel.ConnectionCount);
+    ASSERT_LE(Wheel.Wheel.NextExpirationTime, TimeNow + 5000);
+
+    ASSERT_EQ(0u, Wheel.Expire(TimeNow + 4999));
+    ASSERT_EQ(1u, Wheel.Expire(TimeNow + 5000));
+    ASSERT_EQ(UINT64_MAX, Conns[1]->EarliestExpirationTime);
+    ASSERT_LE(Wheel.Wheel.NextExpirationTime, TimeNow + 10000);
+    ASSERT_GT(Wheel.Wheel.NextExpirationTime, TimeNow + 5000);
+
+    ASSERT_EQ(1u, Wheel.Expire(TimeNow + 10000));
+    ASSERT_EQ(0ull, Wheel.Wheel.ConnectionCount);
+    ASSERT_EQ(UINT64_MAX, Wheel.Wheel.NextExpirationTime);
+}
+
+TEST(TimerWheelTest, UpdateAndRemove)
+{
+    TestConnections Conns(3);
+    SmartTimerWheel Wheel;
+    const uint64_t TimeNow = CxPlatTimeUs64();
+
+    Wheel.Set(Conns[0], TimeNow + 1000);
+    Wheel.Set(Conns[1], TimeNow + 2000);
+    Wheel.Set(Conns[2], TimeNow + 3000);
+    ASSERT_EQ(2, Conns[0]->RefCount);
+
+    Wheel.Set(Conns[0], TimeNow + 60 * 1000 * 1000); // Move later
+    Wheel.Set(Conns[2], TimeNow + 500);              // Move earlier
+    ASSERT_EQ(3ull, Wheel.Wheel.ConnectionCount);
+    ASSERT_LE(Wheel.Wheel.NextExpirationTime, TimeNow + 500);
+
+    Wheel.Set(Conns[1], UINT64_MAX); // Removes
+    ASSERT_EQ(2ull, Wheel.Wheel.ConnectionCount);
+    ASSERT_EQ(1, Conns[1]->RefCount);
+    ASSERT_EQ(nullptr, Conns[1]->TimerLink.Flink);
+
+    ASSERT_EQ(1u, Wheel.Expire(TimeNow + 2000));
+    ASSERT_EQ(UINT64_MAX, Conns[2]->EarliestExpirationTime);
+
+    QuicTimerWheelRemoveConnection(&Wheel.Wheel, Conns[0]);
+    ASSERT_EQ(0ull, Wheel.Wheel.ConnectionCount);
+    ASSERT_EQ(1, Conns[0]->RefCount);
+    ASSERT_EQ(UINT64_MAX, Wheel.Wheel.NextExpirationTime);
+}
+
+TEST(TimerWheelTest, ExpireInOrder)
+{
+    //
+    // Timers spanning from sub-millisecond to many days, to cover every level
+    // (and the overflow) of the hierarchical timer wheel. The wheel is always
+    // driven by NextExpirationTime, like the worker does.
+    //
+    const uint64_t Delays[] = {
+        0, 1, 999, 1000, 1001, 63999, 64000, 250000, 4096000, 5000000,
+        30000000, 600000000, 7200000000ull, 86400000000ull, 1728000000000ull
+    };
+    const uint32_t Count = ARRAYSIZE(Delays);
+    TestConnections Conns(Count);
+    SmartTimerWheel Wheel;
+    const uint64_t Start = CxPlatTimeUs64();
+
+    for (uint32_t i = 0; i < Count; ++i) {
+        Wheel.Set(Conns[Count - 1 - i], Start + Delays[Count - 1 - i]);
+    }
+
+    uint32_t Expired = 0;
+    uint32_t Iterations = 0;
+    uint64_t TimeNow = Start;
+    while (Wheel.Wheel.NextExpirationTime != UINT64_MAX) {
+        ASSERT_GE(Wheel.Wheel.NextExpirationTime, TimeNow);
+        TimeNow = Wheel.Wheel.NextExpirationTime;
+        for (uint32_t i = Expired; i < Count; ++i) {
+            ASSERT_GE(Start + Delays[i], TimeNow); // Never late
+        }
+        Expired += Wheel.Expire(TimeNow);
+        for (uint32_t i = 0; i < Expired; ++i) {
+            ASSERT_EQ(UINT64_MAX, Conns[i]->EarliestExpirationTime);
+        }
+        ASSERT_LT(++Iterations, 1000u);
+    }
+    ASSERT_EQ(Count, Expired);
+    ASSERT_EQ(0ull, Wheel.Wheel.ConnectionCount);
+}
+
+//
+// Churns the ACK/loss timers of 1M idle connections. Run explicitly with
+// --gtest_also_run_disabled_tests, ideally in a release build, to compare the
+// timer wheel implementations (QUIC_HIERARCHICAL_TIMER_WHEEL).
+//
+TEST(TimerWheelTest, DISABLED_Churn1M)
+{
+    const uint32_t Count = 1000000;
+    const uint32_t Rounds = 8;
+    const uint64_t IdleTimeoutUs = 30 * 1000 * 1000;
+    TestConnections Conns(Count);
+    SmartTimerWheel Wheel;
+    uint64_t TimeNow = CxPlatTimeUs64();
+    uint32_t Random = 0x12345678;
+
+    uint64_t Begin = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Count; ++i) {
+        Random = Random * 1103515245 + 12345;
+        Wheel.Set(Conns[i], TimeNow + IdleTimeoutUs + (Random >> 8) % 1000000);
+    }
+    uint64_t Elapsed = CxPlatTimeDiff64(Begin, CxPlatTimeUs64());
+    printf("Insert: %u connections in %llu us\n", Count, (unsigned long long)Elapsed);
+
+    //
+    // Every round, each connection arms a short ACK/loss timer and then goes
+    // back to its idle timeout, while time advances 1 ms per 1/32 of the
+    // connections.
+    //
+    uint64_t Updates = 0;
+    uint32_t ExpiredCount = 0;
+    Begin = CxPlatTimeUs64();
+    for (uint32_t Round = 0; Round < Rounds; ++Round) {
+        for (uint32_t i = 0; i < Count; ++i) {
+            Random = Random * 1103515245 + 12345;
+            Wheel.Set(Conns[i], TimeNow + 1000 + (Random >> 8) % 25000);
+            Wheel.Set(Conns[i], TimeNow + IdleTimeoutUs + (Random >> 8) % 1000000);
+            Updates += 2;
+            if (i % (Count / 32) == 0) {
+                TimeNow += 1000;
+                ExpiredCount += Wheel.Expire(TimeNow);
+            }
+        }
+    }
+    Elapsed = CxPlatTimeDiff64(Begin, CxPlatTimeUs64());
+    printf("Churn: %llu updates in %llu us (%llu ns/update)\n",
+        (unsigned long long)Updates,
+        (unsigned long long)Elapsed,
+        (unsigned long long)(Elapsed * 1000 / Updates));
+    ASSERT_EQ(0u, ExpiredCount);
+
+    //
+    // Let all the idle timeouts expire, driven by NextExpirationTime.
+    //
+    uint32_t Wakes = 0;
+    Begin = CxPlatTimeUs64();
+    while (Wheel.Wheel.NextExpirationTime != UINT64_MAX) {
+        TimeNow = CXPLAT_MAX(TimeNow, Wheel.Wheel.NextExpirationTime);
+        ExpiredCount += Wheel.Expire(TimeNow);
+        Wakes++;
+    }
+    Elapsed = CxPlatTimeDiff64(Begin, CxPlatTimeUs64());
+    printf("Expire: %u connections, %u wakes in %llu us\n",
+        ExpiredCount, Wakes, (unsigned long long)Elapsed);
+    ASSERT_EQ(Count, ExpiredCount);
+}
@@ -85,7 +85,9 @@ QuicWorkerInitialize(
     Worker->PriorityConnectionsTail = &Worker->Connections.Flink;
     CxPlatListInitializeHead(&Worker->Listeners);
     CxPlatListInitializeHead(&Worker->Operations);
+    CxPlatListInitializeHead(&Worker->SendBatchConnections);
 
+    QuicPacingWheelInitialize(&Worker->PacingWheel);
     QUIC_STATUS Status = QuicTimerWheelInitialize(&Worker->TimerWheel);
     if (QUIC_FAILED(Status)) {
         goto Error;
@@ -196,9 +198,12 @@ QuicWorkerUninitialize(
     Worker->PriorityConnectionsTail = NULL;
     CXPLAT_TEL_ASSERT(CxPlatListIsEmpty(&Worker->Operations));
     CXPLAT_TEL_ASSERT(CxPlatListIsEmpty(&Worker->Listeners));
+    CXPLAT_TEL_ASSERT(CxPlatListIsEmpty(&Worker->SendBatchConnections));
+    CXPLAT_TEL_ASSERT(Worker->SendBatch.Count == 0);
 
     CxPlatDispatchLockUninitialize(&Worker->Lock);
     QuicTimerWheelUninitialize(&Worker->TimerWheel);
+    QuicPacingWheelUninitialize(&Worker->PacingWheel);
 
     QuicTraceEvent(
         WorkerDestroyed,
@@ -553,6 +558,81 @@ QuicWorkerGetNextOperation(
     return Operation;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+CXPLAT_SEND_BATCH*
+QuicWorkerGetSendBatch(
+    _In_ QUIC_WORKER* Worker,
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    //
+    // Only batch if the connection is processed by this worker's loop. It may
+    // have just been moved to this worker while still being processed by the
+    // old one, or be processed outside of the loop during clean up.
+    //
+    if (Worker->SendBatchThreadID == 0 ||
+        Worker->SendBatchThreadID != Connection->WorkerThreadID) {
+        return NULL;
+    }
+
+    //
+    // Keep the connection, and so its current binding, alive until its sends
+    // have been flushed. Anything that releases a binding while the connection
+    // is in the batch must flush it first.
+    //
+    if (Connection->SendBatchLink.Flink == NULL) {
+        QuicConnAddRef(Connection, QUIC_CONN_REF_SEND_BATCH);
+        CxPlatListInsertTail(&Worker->SendBatchConnections, &Connection->SendBatchLink);
+    }
+
+    return &Worker->SendBatch;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicWorkerFlushSends(
+    _In_ QUIC_WORKER* Worker
+    )
+{
+    if (Worker->SendBatch.Count != 0) {
+        CxPlatSendBatchFlush(&Worker->SendBatch);
+    }
+
+    //
+    // Includes the system calls of flushes the datapath did on its own when
+    // the batch filled up.
+    //
+    if (Worker->SendBatch.SendCalls != 0) {
+        const uint64_t SendCost =
+            Worker->SendBatch.SendCallTimeNs / Worker->SendBatch.SendCalls;
+        Worker->AverageSendCost =
+            (uint32_t)CxPlatEwma(
+                Worker->AverageSendCost,
+                CXPLAT_MIN(SendCost, UINT32_MAX),
+                8);
+        Worker->SendBatch.SendCalls = 0;
+        Worker->SendBatch.SendCallTimeNs = 0;
+    }
+
+    if (Worker->SendBatch.CoalescedSends != 0) {
+        QuicPerfCounterAdd(
+            Worker->Partition,
+            QUIC_PERF_COUNTER_UDP_SEND_COALESCED,
+            (int64_t)Worker->SendBatch.CoalescedSends);
+        Worker->SendBatch.CoalescedSends = 0;
+    }
+
+    while (!CxPlatListIsEmpty(&Worker->SendBatchConnections)) {
+        QUIC_CONNECTION* Connection =
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&Worker->SendBatchConnections),
+                QUIC_CONNECTION,
+                SendBatchLink);
+        Connection->SendBatchLink.Flink = NULL;
+        QuicConnRelease(Connection, QUIC_CONN_REF_SEND_BATCH);
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicWorkerProcessTimers(
@@ -587,6 +667,40 @@ QuicWorkerProcessTimers(
     }
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicWorkerProcessPacing(
+    _In_ QUIC_WORKER* Worker,
+    _In_ CXPLAT_THREAD_ID ThreadID,
+    _In_ uint64_t TimeNow
+    )
+{
+    //
+    // Get the list of all connections due to send in this tick.
+    //
+    CXPLAT_LIST_ENTRY Departures;
+    CxPlatListInitializeHead(&Departures);
+    QuicPacingWheelGetDue(&Worker->PacingWheel, TimeNow, &Departures);
+
+    //
+    // Flush them all back to back, so their sends go out together.
+    //
+    while (!CxPlatListIsEmpty(&Departures)) {
+        CXPLAT_LIST_ENTRY* Entry = CxPlatListRemoveHead(&Departures);
+        Entry->Flink = NULL;
+
+        QUIC_CONNECTION* Connection =
+            CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, PacingLink);
+
+        Connection->WorkerThreadID = ThreadID;
+        QuicConfigurationAttachSilo(Connection->Configuration);
+        QuicConnPacingDeparture(Connection);
+        QuicConfigurationDetachSilo();
+        Connection->WorkerThreadID = 0;
+        QuicConnRelease(Connection, QUIC_CONN_REF_WORKER);
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicWorkerProcessConnection(
@@ -634,6 +748,13 @@ QuicWorkerProcessConnection(
         //
         Connection->State.UpdateWorker = FALSE;
         QuicTimerWheelUpdateConnection(&Worker->TimerWheel, Connection);
+        if (Connection->OutFlowBlockedReasons & QUIC_FLOW_BLOCKED_PACING) {
+            QuicPacingWheelInsertConnection(
+                &Worker->PacingWheel,
+                Connection,
+                *TimeNow,
+                Connection->PacingDepartureTime);
+        }
 
         //
         // When the worker changes the app layer needs to be informed so that
@@ -666,6 +787,10 @@ QuicWorkerProcessConnection(
     CxPlatDispatchLockAcquire(&Worker->Lock);
     Connection->WorkerProcessing = FALSE;
     Connection->HasQueuedWork |= StillHasWorkToDo;
+    QuicConnUpdateOperDrainQuota(
+        Connection,
+        StillHasWorkToDo && !Connection->State.UpdateWorker,
+        !CxPlatListIsEmpty(&Worker->Connections));
 
     BOOLEAN DoneWithConnection = TRUE;
     if (!Connection->State.UpdateWorker) {
@@ -701,10 +826,11 @@ QuicWorkerProcessConnection(
             //
             // Now that we know we want to process this connection, assign it
             // to the correct registration. Remove it from the current worker's
-            // timer wheel, and it will be added to the new one, when first
-            // processed on the other worker.
+            // timer and pacing wheels, and it will be added to the new ones,
+            // when first processed on the other worker.
             //
             QuicTimerWheelRemoveConnection(&Worker->TimerWheel, Connection);
+            QuicPacingWheelRemoveConnection(&Worker->PacingWheel, Connection);
             CXPLAT_FRE_ASSERT(Connection->Registration != NULL);
             QuicRegistrationQueueNewConnection(Connection->Registration, Connection);
             CXPLAT_DBG_ASSERT(Worker != Connection->Worker);
@@ -865,11 +991,15 @@ QuicWorkerLoop(
     //
     QuicPerfCounterTrySnapShot(State->TimeNow);
 
+    Worker->SendBatchThreadID = State->ThreadID;
+
     //
     // For every loop of the worker thread, in an attempt to balance things,
-    // first the timer wheel is checked and any expired timers are processed.
-    // Then, a single connection will be processed (if available), followed by a
-    // single stateless operation (if available).
+    // first the timer wheel is checked and any expired timers are processed,
+    // and then all the paced sends due by now are flushed. Then, a single
+    // connection will be processed (if available), followed by a single
+    // stateless operation (if available). The sends of all of them are
+    // batched and handed to the datapath at the end.
     //
 
     if (Worker->TimerWheel.NextExpirationTime != UINT64_MAX &&
@@ -878,6 +1008,12 @@ QuicWorkerLoop(
         State->NoWorkCount = 0;
     }
 
+    if (Worker->PacingWheel.NextDepartureTime != UINT64_MAX &&
+        Worker->PacingWheel.NextDepartureTime <= State->TimeNow) {
+        QuicWorkerProcessPacing(Worker, State->ThreadID, State->TimeNow);
+        State->NoWorkCount = 0;
+    }
+
     QUIC_CONNECTION* Connection = QuicWorkerGetNextConnection(Worker);
     if (Connection != NULL) {
         QuicWorkerProcessConnection(Worker, Connection, State->ThreadID, &State->TimeNow);
@@ -903,6 +1039,13 @@ QuicWorkerLoop(
         State->NoWorkCount = 0;
     }
 
+    //
+    // Hand all the sends of this iteration to the datapath at once, so sends
+    // of different connections on the same socket share system calls.
+    //
+    QuicWorkerFlushSends(Worker);
+    Worker->SendBatchThreadID = 0;
+
     if (Worker->ExecutionContext.Ready) {
         //
         // There is more work to be done.
@@ -923,16 +1066,19 @@ QuicWorkerLoop(
 
     //
     // We have no other work to process at the moment. Wait for work to come in
-    // or any timer to expire.
+    // or any timer or paced send to expire.
     //
     Worker->IsActive = FALSE;
-    Worker->ExecutionContext.NextTimeUs = Worker->TimerWheel.NextExpirationTime;
+    Worker->ExecutionContext.NextTimeUs =
+        CXPLAT_MIN(
+            Worker->TimerWheel.NextExpirationTime,
+            Worker->PacingWheel.NextDepartureTime);
     QuicTraceEvent(
         WorkerActivityStateUpdated,
         "[wrkr][%p] IsActive = %hhu, Arg = %u",
         Worker,
         Worker->IsActive,
-        (uint32_t)Worker->TimerWheel.NextExpirationTime);
+        (uint32_t)Worker->ExecutionContext.NextTimeUs);
     QuicWorkerResetQueueDelay(Worker);
     return TRUE;
 }
@@ -5,6 +5,10 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 //
 // A worker thread for draining queued operations on a connection.
 //
@@ -46,11 +50,33 @@ typedef struct QUIC_CACHEALIGN QUIC_WORKER {
     //
     uint32_t AverageQueueDelay;
 
+    //
+    // The average time a send system call takes in the datapath, in
+    // nanoseconds. Zero if the datapath doesn't measure it.
+    //
+    uint32_t AverageSendCost;
+
     //
     // Timers for the worker's connections.
     //
     QUIC_TIMER_WHEEL TimerWheel;
 
+    //
+    // Paced sends for the worker's connections.
+    //
+    QUIC_PACING_WHEEL PacingWheel;
+
+    //
+    // Sends of the connections processed in the current iteration of the
+    // worker loop, handed to the datapath together at the end of it. While
+    // the iteration runs, SendBatchThreadID is the thread running it. Each
+    // connection with sends in the batch is referenced and linked in
+    // SendBatchConnections until the batch is flushed.
+    //
+    CXPLAT_SEND_BATCH SendBatch;
+    CXPLAT_THREAD_ID SendBatchThreadID;
+    CXPLAT_LIST_ENTRY SendBatchConnections;
+
     //
     // An event to kick the thread.
     //
@@ -218,8 +244,34 @@ QuicWorkerQueueOperation(
     _In_ QUIC_OPERATION* Operation
     );
 
+//
+// Returns the send batch the connection's sends should be queued on, or NULL
+// if they should be sent immediately. Must only be called while processing
+// the connection.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+CXPLAT_SEND_BATCH*
+QuicWorkerGetSendBatch(
+    _In_ QUIC_WORKER* Worker,
+    _In_ QUIC_CONNECTION* Connection
+    );
+
+//
+// Hands the sends held in the worker's send batch to the datapath and releases
+// the connections they belong to. Must only be called on the worker's thread.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicWorkerFlushSends(
+    _In_ QUIC_WORKER* Worker
+    );
+
 BOOLEAN
 QuicWorkerPoolIsInPartition(
     _In_ QUIC_WORKER_POOL* WorkerPool,
     _In_ uint16_t PartitionIndex
     );
+
+#if defined(__cplusplus)
+}
+#endif
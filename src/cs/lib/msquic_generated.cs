@@ -100,6 +100,7 @@ namespace Microsoft.Quic
         INPROC_PEER_CERTIFICATE = 0x00080000,
         SET_CA_CERTIFICATE_FILE = 0x00100000,
         DISABLE_AIA = 0x00200000,
+        ASYNC_SIGNING = 0x00400000,
     }
 
     [System.Flags]
@@ -143,6 +144,8 @@ namespace Microsoft.Quic
     {
         FIFO = 0x0000,
         ROUND_ROBIN = 0x0001,
+        WEIGHTED_FAIR = 0x0002,
+        DEADLINE = 0x0003,
         COUNT,
     }
 
@@ -508,6 +511,7 @@ namespace Microsoft.Quic
     {
         CUBIC,
         BBR,
+        BBR3,
         MAX,
     }
 
@@ -942,6 +946,21 @@ namespace Microsoft.Quic
 
         [NativeTypeName("uint32_t")]
         internal uint ReceiveQueueDelayMaxUs;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong SendEcnEctPackets;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong SendEcnCePackets;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong RecvEcnCePackets;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong SendBatchCount;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong SendBatchDatagrams;
     }
 
     internal partial struct QUIC_NETWORK_STATISTICS
@@ -1479,6 +1498,19 @@ namespace Microsoft.Quic
             }
         }
 
+        internal ulong EcnL4sEnabled
+        {
+            get
+            {
+                return Anonymous2.Anonymous.EcnL4sEnabled;
+            }
+
+            set
+            {
+                Anonymous2.Anonymous.EcnL4sEnabled = value;
+            }
+        }
+
         internal ulong ReservedFlags
         {
             get
@@ -2151,17 +2183,31 @@ namespace Microsoft.Quic
                     }
                 }
 
-                [NativeTypeName("uint64_t : 18")]
+                [NativeTypeName("uint64_t : 1")]
+                internal ulong EcnL4sEnabled
+                {
+                    get
+                    {
+                        return (_bitfield >> 46) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 46)) | ((value & 0x1UL) << 46);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 17")]
                 internal ulong RESERVED
                 {
                     get
                     {
-                        return (_bitfield >> 46) & 0x3FFFFUL;
+                        return (_bitfield >> 47) & 0x1FFFFUL;
                     }
 
                     set
                     {
-                        _bitfield = (_bitfield & ~(0x3FFFFUL << 46)) | ((value & 0x3FFFFUL) << 46);
+                        _bitfield = (_bitfield & ~(0x1FFFFUL << 47)) | ((value & 0x1FFFFUL) << 47);
                     }
                 }
             }
@@ -2308,17 +2354,31 @@ namespace Microsoft.Quic
                     }
                 }
 
-                [NativeTypeName("uint64_t : 55")]
+                [NativeTypeName("uint64_t : 1")]
+                internal ulong EcnL4sEnabled
+                {
+                    get
+                    {
+                        return (_bitfield >> 9) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 9)) | ((value & 0x1UL) << 9);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 54")]
                 internal ulong ReservedFlags
                 {
                     get
                     {
-                        return (_bitfield >> 9) & 0x7FFFFFUL;
+                        return (_bitfield >> 10) & 0x3FFFFFUL;
                     }
 
                     set
                     {
-                        _bitfield = (_bitfield & ~(0x7FFFFFUL << 9)) | ((value & 0x7FFFFFUL) << 9);
+                        _bitfield = (_bitfield & ~(0x3FFFFFUL << 10)) | ((value & 0x3FFFFFUL) << 10);
                     }
                 }
             }
@@ -3822,6 +3882,9 @@ namespace Microsoft.Quic
         [NativeTypeName("#define QUIC_PARAM_STREAM_RELIABLE_OFFSET 0x08000005")]
         internal const uint QUIC_PARAM_STREAM_RELIABLE_OFFSET = 0x08000005;
 
+        [NativeTypeName("#define QUIC_PARAM_STREAM_SEND_DEADLINE 0x08000006")]
+        internal const uint QUIC_PARAM_STREAM_SEND_DEADLINE = 0x08000006;
+
         [NativeTypeName("#define QUIC_API_VERSION_2 2")]
         internal const uint QUIC_API_VERSION_2 = 2;
     }
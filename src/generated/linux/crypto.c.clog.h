@@ -365,6 +365,42 @@ tracepoint(CLOG_CRYPTO_C, DrainCrypto , arg1, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for CryptoTlsCallComplete
+// [conn][%p] TLS processing completed
+// QuicTraceLogConnVerbose(
+            CryptoTlsCallComplete,
+            Connection,
+            "TLS processing completed");
+// arg1 = arg1 = Connection = arg1
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_CryptoTlsCallComplete
+#define _clog_3_ARGS_TRACE_CryptoTlsCallComplete(uniqueId, arg1, encoded_arg_string)\
+tracepoint(CLOG_CRYPTO_C, CryptoTlsCallComplete , arg1);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for CryptoTlsCallPending
+// [conn][%p] TLS processing pending
+// QuicTraceLogConnVerbose(
+            CryptoTlsCallPending,
+            QuicCryptoGetConnection(Crypto),
+            "TLS processing pending");
+// arg1 = arg1 = QuicCryptoGetConnection(Crypto) = arg1
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_CryptoTlsCallPending
+#define _clog_3_ARGS_TRACE_CryptoTlsCallPending(uniqueId, arg1, encoded_arg_string)\
+tracepoint(CLOG_CRYPTO_C, CryptoTlsCallPending , arg1);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for CryptoNotReady
 // [conn][%p] No complete TLS messages to process
@@ -393,6 +393,44 @@ TRACEPOINT_EVENT(CLOG_CRYPTO_C, DrainCrypto,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for CryptoTlsCallComplete
+// [conn][%p] TLS processing completed
+// QuicTraceLogConnVerbose(
+            CryptoTlsCallComplete,
+            Connection,
+            "TLS processing completed");
+// arg1 = arg1 = Connection = arg1
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CRYPTO_C, CryptoTlsCallComplete,
+    TP_ARGS(
+        const void *, arg1), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for CryptoTlsCallPending
+// [conn][%p] TLS processing pending
+// QuicTraceLogConnVerbose(
+            CryptoTlsCallPending,
+            QuicCryptoGetConnection(Crypto),
+            "TLS processing pending");
+// arg1 = arg1 = QuicCryptoGetConnection(Crypto) = arg1
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CRYPTO_C, CryptoTlsCallPending,
+    TP_ARGS(
+        const void *, arg1), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for CryptoNotReady
 // [conn][%p] No complete TLS messages to process
@@ -14,6 +14,10 @@
 #include "datapath_linux.c.clog.h.lttng.h"
 #endif
 #include <lttng/tracepoint-event.h>
+#ifndef _clog_MACRO_QuicTraceLogInfo
+#define _clog_MACRO_QuicTraceLogInfo  1
+#define QuicTraceLogInfo(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
 #ifndef _clog_MACRO_QuicTraceEvent
 #define _clog_MACRO_QuicTraceEvent  1
 #define QuicTraceEvent(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
@@ -21,6 +25,26 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+/*----------------------------------------------------------
+// Decoder Ring for DatapathTxTimeQdiscUnsupported
+// [data] Not using departure times, qdisc %s on interface %d ignores them
+// QuicTraceLogInfo(
+                    DatapathTxTimeQdiscUnsupported,
+                    "[data] Not using departure times, qdisc %s on interface %d ignores them",
+                    Kind,
+                    Qdisc->tcm_ifindex);
+// arg2 = arg2 = Kind = arg2
+// arg3 = arg3 = Qdisc->tcm_ifindex = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_DatapathTxTimeQdiscUnsupported
+#define _clog_4_ARGS_TRACE_DatapathTxTimeQdiscUnsupported(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_DATAPATH_LINUX_C, DatapathTxTimeQdiscUnsupported , arg2, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for DatapathErrorStatus
 // [data][%p] ERROR, %u, %s.
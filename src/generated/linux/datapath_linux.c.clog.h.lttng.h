@@ -1,6 +1,29 @@
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for DatapathTxTimeQdiscUnsupported
+// [data] Not using departure times, qdisc %s on interface %d ignores them
+// QuicTraceLogInfo(
+                    DatapathTxTimeQdiscUnsupported,
+                    "[data] Not using departure times, qdisc %s on interface %d ignores them",
+                    Kind,
+                    Qdisc->tcm_ifindex);
+// arg2 = arg2 = Kind = arg2
+// arg3 = arg3 = Qdisc->tcm_ifindex = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_LINUX_C, DatapathTxTimeQdiscUnsupported,
+    TP_ARGS(
+        const char *, arg2,
+        int, arg3), 
+    TP_FIELDS(
+        ctf_string(arg2, arg2)
+        ctf_integer(int, arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for DatapathErrorStatus
 // [data][%p] ERROR, %u, %s.
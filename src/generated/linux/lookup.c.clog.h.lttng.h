@@ -175,3 +175,26 @@ TRACEPOINT_EVENT(CLOG_LOOKUP_C, LookupCidRemoved,
         ctf_integer_hex(uint64_t, arg3, (uint64_t)arg3)
     )
 )
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for AllocFailure
+// Allocation of '%s' failed. (%llu bytes)
+// QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "lock-free CID entry",
+            sizeof(QUIC_RCU_CID_ENTRY) + SourceCid->CID.Length);
+// arg2 = arg2 = "lock-free CID entry" = arg2
+// arg3 = arg3 = sizeof(QUIC_RCU_CID_ENTRY) + SourceCid->CID.Length = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LOOKUP_C, AllocFailure,
+    TP_ARGS(
+        const char *, arg2,
+        unsigned long long, arg3), 
+    TP_FIELDS(
+        ctf_string(arg2, arg2)
+        ctf_integer(uint64_t, arg3, arg3)
+    )
+)
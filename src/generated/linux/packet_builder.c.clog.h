@@ -92,11 +92,11 @@ tracepoint(CLOG_PACKET_BUILDER_C, GetPacketTypeFailure , arg1, arg3);\
 // [conn][%p] Sending batch. %hu datagrams
 // QuicTraceLogConnVerbose(
         PacketBuilderSendBatch,
-        Builder->Connection,
+        Connection,
         "Sending batch. %hu datagrams",
-        (uint16_t)Builder->TotalCountDatagrams);
-// arg1 = arg1 = Builder->Connection = arg1
-// arg3 = arg3 = (uint16_t)Builder->TotalCountDatagrams = arg3
+        (uint16_t)BatchDatagrams);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = (uint16_t)BatchDatagrams = arg3
 ----------------------------------------------------------*/
 #ifndef _clog_4_ARGS_TRACE_PacketBuilderSendBatch
 #define _clog_4_ARGS_TRACE_PacketBuilderSendBatch(uniqueId, arg1, encoded_arg_string, arg3)\
@@ -189,9 +189,9 @@ tracepoint(CLOG_PACKET_BUILDER_C, PacketEncrypt , arg2);\
 // Decoder Ring for PacketFinalize
 // [pack][%llu] Finalizing
 // QuicTraceEvent(
-            PacketFinalize,
-            "[pack][%llu] Finalizing",
-            Builder->Metadata->PacketId);
+                PacketFinalize,
+                "[pack][%llu] Finalizing",
+                Builder->Metadata->PacketId);
 // arg2 = arg2 = Builder->Metadata->PacketId = arg2
 ----------------------------------------------------------*/
 #ifndef _clog_3_ARGS_TRACE_PacketFinalize
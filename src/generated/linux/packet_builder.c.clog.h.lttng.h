@@ -71,11 +71,11 @@ TRACEPOINT_EVENT(CLOG_PACKET_BUILDER_C, GetPacketTypeFailure,
 // [conn][%p] Sending batch. %hu datagrams
 // QuicTraceLogConnVerbose(
         PacketBuilderSendBatch,
-        Builder->Connection,
+        Connection,
         "Sending batch. %hu datagrams",
-        (uint16_t)Builder->TotalCountDatagrams);
-// arg1 = arg1 = Builder->Connection = arg1
-// arg3 = arg3 = (uint16_t)Builder->TotalCountDatagrams = arg3
+        (uint16_t)BatchDatagrams);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = (uint16_t)BatchDatagrams = arg3
 ----------------------------------------------------------*/
 TRACEPOINT_EVENT(CLOG_PACKET_BUILDER_C, PacketBuilderSendBatch,
     TP_ARGS(
@@ -181,9 +181,9 @@ TRACEPOINT_EVENT(CLOG_PACKET_BUILDER_C, PacketEncrypt,
 // Decoder Ring for PacketFinalize
 // [pack][%llu] Finalizing
 // QuicTraceEvent(
-            PacketFinalize,
-            "[pack][%llu] Finalizing",
-            Builder->Metadata->PacketId);
+                PacketFinalize,
+                "[pack][%llu] Finalizing",
+                Builder->Metadata->PacketId);
 // arg2 = arg2 = Builder->Metadata->PacketId = arg2
 ----------------------------------------------------------*/
 TRACEPOINT_EVENT(CLOG_PACKET_BUILDER_C, PacketFinalize,
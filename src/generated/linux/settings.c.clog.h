@@ -707,6 +707,21 @@ tracepoint(CLOG_SETTINGS_C, SettingEcnEnabled , arg2);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingEcnL4sEnabled
+// [sett] EcnL4sEnabled          = %hhu
+// QuicTraceLogVerbose(SettingEcnL4sEnabled,               "[sett] EcnL4sEnabled          = %hhu", Settings->EcnL4sEnabled);
+// arg2 = arg2 = Settings->EcnL4sEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingEcnL4sEnabled
+#define _clog_3_ARGS_TRACE_SettingEcnL4sEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingEcnL4sEnabled , arg2);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for SettingHyStartEnabled
 // [sett] HyStartEnabled         = %hhu
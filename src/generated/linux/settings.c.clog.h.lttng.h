@@ -730,6 +730,22 @@ TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingEcnEnabled,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingEcnL4sEnabled
+// [sett] EcnL4sEnabled          = %hhu
+// QuicTraceLogVerbose(SettingEcnL4sEnabled,               "[sett] EcnL4sEnabled          = %hhu", Settings->EcnL4sEnabled);
+// arg2 = arg2 = Settings->EcnL4sEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingEcnL4sEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for SettingHyStartEnabled
 // [sett] HyStartEnabled         = %hhu
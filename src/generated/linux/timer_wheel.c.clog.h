@@ -29,26 +29,6 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
-/*----------------------------------------------------------
-// Decoder Ring for TimerWheelResize
-// [time][%p] Resizing timer wheel (new slot count = %u).
-// QuicTraceLogVerbose(
-        TimerWheelResize,
-        "[time][%p] Resizing timer wheel (new slot count = %u).",
-        TimerWheel,
-        NewSlotCount);
-// arg2 = arg2 = TimerWheel = arg2
-// arg3 = arg3 = NewSlotCount = arg3
-----------------------------------------------------------*/
-#ifndef _clog_4_ARGS_TRACE_TimerWheelResize
-#define _clog_4_ARGS_TRACE_TimerWheelResize(uniqueId, encoded_arg_string, arg2, arg3)\
-tracepoint(CLOG_TIMER_WHEEL_C, TimerWheelResize , arg2, arg3);\
-
-#endif
-
-
-
-
 /*----------------------------------------------------------
 // Decoder Ring for TimerWheelNextExpirationNull
 // [time][%p] Next Expiration = {NULL}.
@@ -75,10 +55,10 @@ tracepoint(CLOG_TIMER_WHEEL_C, TimerWheelNextExpirationNull , arg2);\
             "[time][%p] Next Expiration = {%llu, %p}.",
             TimerWheel,
             TimerWheel->NextExpirationTime,
-            TimerWheel->NextConnection);
+            NULL);
 // arg2 = arg2 = TimerWheel = arg2
 // arg3 = arg3 = TimerWheel->NextExpirationTime = arg3
-// arg4 = arg4 = TimerWheel->NextConnection = arg4
+// arg4 = arg4 = NULL = arg4
 ----------------------------------------------------------*/
 #ifndef _clog_5_ARGS_TRACE_TimerWheelNextExpiration
 #define _clog_5_ARGS_TRACE_TimerWheelNextExpiration(uniqueId, encoded_arg_string, arg2, arg3, arg4)\
@@ -129,13 +109,33 @@ tracepoint(CLOG_TIMER_WHEEL_C, TimerWheelUpdateConnection , arg2, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for TimerWheelResize
+// [time][%p] Resizing timer wheel (new slot count = %u).
+// QuicTraceLogVerbose(
+        TimerWheelResize,
+        "[time][%p] Resizing timer wheel (new slot count = %u).",
+        TimerWheel,
+        NewSlotCount);
+// arg2 = arg2 = TimerWheel = arg2
+// arg3 = arg3 = NewSlotCount = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_TimerWheelResize
+#define _clog_4_ARGS_TRACE_TimerWheelResize(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_TIMER_WHEEL_C, TimerWheelResize , arg2, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for StillInTimerWheel
 // [conn][%p] Still in timer wheel! Connection was likely leaked!
 // QuicTraceLogConnWarning(
-                    StillInTimerWheel,
-                    Connection,
-                    "Still in timer wheel! Connection was likely leaked!");
+            StillInTimerWheel,
+            Connection,
+            "Still in timer wheel! Connection was likely leaked!");
 // arg1 = arg1 = Connection = arg1
 ----------------------------------------------------------*/
 #ifndef _clog_3_ARGS_TRACE_StillInTimerWheel
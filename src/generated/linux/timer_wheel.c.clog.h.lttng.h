@@ -1,29 +1,6 @@
 
 
 
-/*----------------------------------------------------------
-// Decoder Ring for TimerWheelResize
-// [time][%p] Resizing timer wheel (new slot count = %u).
-// QuicTraceLogVerbose(
-        TimerWheelResize,
-        "[time][%p] Resizing timer wheel (new slot count = %u).",
-        TimerWheel,
-        NewSlotCount);
-// arg2 = arg2 = TimerWheel = arg2
-// arg3 = arg3 = NewSlotCount = arg3
-----------------------------------------------------------*/
-TRACEPOINT_EVENT(CLOG_TIMER_WHEEL_C, TimerWheelResize,
-    TP_ARGS(
-        const void *, arg2,
-        unsigned int, arg3), 
-    TP_FIELDS(
-        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
-        ctf_integer(unsigned int, arg3, arg3)
-    )
-)
-
-
-
 /*----------------------------------------------------------
 // Decoder Ring for TimerWheelNextExpirationNull
 // [time][%p] Next Expiration = {NULL}.
@@ -51,10 +28,10 @@ TRACEPOINT_EVENT(CLOG_TIMER_WHEEL_C, TimerWheelNextExpirationNull,
             "[time][%p] Next Expiration = {%llu, %p}.",
             TimerWheel,
             TimerWheel->NextExpirationTime,
-            TimerWheel->NextConnection);
+            NULL);
 // arg2 = arg2 = TimerWheel = arg2
 // arg3 = arg3 = TimerWheel->NextExpirationTime = arg3
-// arg4 = arg4 = TimerWheel->NextConnection = arg4
+// arg4 = arg4 = NULL = arg4
 ----------------------------------------------------------*/
 TRACEPOINT_EVENT(CLOG_TIMER_WHEEL_C, TimerWheelNextExpiration,
     TP_ARGS(
@@ -116,13 +93,36 @@ TRACEPOINT_EVENT(CLOG_TIMER_WHEEL_C, TimerWheelUpdateConnection,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for TimerWheelResize
+// [time][%p] Resizing timer wheel (new slot count = %u).
+// QuicTraceLogVerbose(
+        TimerWheelResize,
+        "[time][%p] Resizing timer wheel (new slot count = %u).",
+        TimerWheel,
+        NewSlotCount);
+// arg2 = arg2 = TimerWheel = arg2
+// arg3 = arg3 = NewSlotCount = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_TIMER_WHEEL_C, TimerWheelResize,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for StillInTimerWheel
 // [conn][%p] Still in timer wheel! Connection was likely leaked!
 // QuicTraceLogConnWarning(
-                    StillInTimerWheel,
-                    Connection,
-                    "Still in timer wheel! Connection was likely leaked!");
+            StillInTimerWheel,
+            Connection,
+            "Still in timer wheel! Connection was likely leaked!");
 // arg1 = arg1 = Connection = arg1
 ----------------------------------------------------------*/
 TRACEPOINT_EVENT(CLOG_TIMER_WHEEL_C, StillInTimerWheel,
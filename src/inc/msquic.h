@@ -147,6 +147,9 @@ typedef enum QUIC_CREDENTIAL_FLAGS {
     QUIC_CREDENTIAL_FLAG_INPROC_PEER_CERTIFICATE                = 0x00080000, // Schannel only
     QUIC_CREDENTIAL_FLAG_SET_CA_CERTIFICATE_FILE                = 0x00100000, // OpenSSL only currently
     QUIC_CREDENTIAL_FLAG_DISABLE_AIA                            = 0x00200000, // Schannel only currently
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+    QUIC_CREDENTIAL_FLAG_ASYNC_SIGNING                          = 0x00400000, // OpenSSL only currently. Starts signing threads per credential.
+#endif
 } QUIC_CREDENTIAL_FLAGS;
 
 DEFINE_ENUM_FLAG_OPERATORS(QUIC_CREDENTIAL_FLAGS)
@@ -190,6 +193,10 @@ DEFINE_ENUM_FLAG_OPERATORS(QUIC_SEND_RESUMPTION_FLAGS)
 typedef enum QUIC_STREAM_SCHEDULING_SCHEME {
     QUIC_STREAM_SCHEDULING_SCHEME_FIFO          = 0x0000,   // Sends stream data first come, first served. (Default)
     QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN   = 0x0001,   // Sends stream data evenly multiplexed.
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+    QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR = 0x0002,   // Shares bandwidth between streams, weighted by priority.
+    QUIC_STREAM_SCHEDULING_SCHEME_DEADLINE      = 0x0003,   // Sends the stream data with the earliest deadline first.
+#endif
     QUIC_STREAM_SCHEDULING_SCHEME_COUNT,                    // The number of stream scheduling schemes.
 } QUIC_STREAM_SCHEDULING_SCHEME;
 
@@ -368,6 +375,151 @@ typedef struct QUIC_XDP_MAP_CONFIG {
     QUIC_XDP_MAP_HANDLE MapHandle;  // XDP map handle.
 } QUIC_XDP_MAP_CONFIG;
 
+//
+// App provided congestion control. Passed via SetParam
+// (QUIC_PARAM_GLOBAL_CUSTOM_CONGESTION_CONTROL) after MsQuicOpenVersion but
+// before opening any registrations, and then selected per configuration with
+// QUIC_SETTINGS.CongestionControlAlgorithm set to the registered Algorithm.
+//
+// MsQuic keeps track of bytes in flight, exemptions (probes) and pacing; the
+// algorithm only needs to maintain its congestion window. All callbacks are
+// invoked on the connection's worker thread, serialized per connection, and
+// must not block or call back into MsQuic.
+//
+
+typedef struct QUIC_CUSTOM_CONGESTION_CONTROL_PARAMS {
+    uint32_t DatagramPayloadLength; // Current max UDP payload size.
+    uint32_t InitialWindowPackets;
+    uint32_t SendIdleTimeoutMs;
+} QUIC_CUSTOM_CONGESTION_CONTROL_PARAMS;
+
+typedef struct QUIC_CUSTOM_CONGESTION_CONTROL_ACK {
+    uint64_t TimeNow;               // microseconds
+    uint64_t LargestAck;            // Largest packet number acknowledged.
+    uint64_t LargestSentPacketNumber;
+    uint64_t SmoothedRtt;           // microseconds
+    uint64_t MinRtt;                // microseconds - Only valid if MinRttValid.
+    uint64_t OneWayDelay;           // microseconds - Only non-zero when one-way delay is negotiated.
+    uint32_t BytesAcked;
+    uint32_t BytesInFlight;         // After removing BytesAcked.
+    uint32_t DatagramPayloadLength;
+    BOOLEAN MinRttValid;
+    BOOLEAN HasLoss;
+    BOOLEAN IsLargestAckedPacketAppLimited;
+} QUIC_CUSTOM_CONGESTION_CONTROL_ACK;
+
+typedef struct QUIC_CUSTOM_CONGESTION_CONTROL_LOSS {
+    uint64_t LargestPacketNumber;   // Largest packet number lost (or acked with CE).
+    uint64_t LargestSentPacketNumber;
+    uint32_t BytesLost;             // Zero for ECN congestion events.
+    uint32_t BytesInFlight;         // After removing BytesLost.
+    uint32_t DatagramPayloadLength;
+    BOOLEAN PersistentCongestion;
+} QUIC_CUSTOM_CONGESTION_CONTROL_LOSS;
+
+//
+// Called for each new connection (or path reset) using the algorithm to create
+// its per-connection state. On failure, the connection falls back to Cubic.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+(QUIC_API * QUIC_CUSTOM_CONGESTION_CONTROL_CREATE_FN)(
+    _In_opt_ void* Context,
+    _In_ const QUIC_CUSTOM_CONGESTION_CONTROL_PARAMS* Params,
+    _Outptr_ void** State
+    );
+
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+(QUIC_API * QUIC_CUSTOM_CONGESTION_CONTROL_DELETE_FN)(
+    _In_ void* State
+    );
+
+//
+// Resets the window to its initial value. FullReset is FALSE on idle restart.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+(QUIC_API * QUIC_CUSTOM_CONGESTION_CONTROL_RESET_FN)(
+    _In_ void* State,
+    _In_ BOOLEAN FullReset
+    );
+
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+(QUIC_API * QUIC_CUSTOM_CONGESTION_CONTROL_DATA_SENT_FN)(
+    _In_ void* State,
+    _In_ uint32_t NumRetransmittableBytes
+    );
+
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+(QUIC_API * QUIC_CUSTOM_CONGESTION_CONTROL_DATA_ACKED_FN)(
+    _In_ void* State,
+    _In_ const QUIC_CUSTOM_CONGESTION_CONTROL_ACK* Ack
+    );
+
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+(QUIC_API * QUIC_CUSTOM_CONGESTION_CONTROL_CONGESTION_FN)(
+    _In_ void* State,
+    _In_ const QUIC_CUSTOM_CONGESTION_CONTROL_LOSS* Loss
+    );
+
+//
+// Called when the last congestion event turned out to be spurious. Returns
+// TRUE if the algorithm restored its previous window.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+(QUIC_API * QUIC_CUSTOM_CONGESTION_CONTROL_SPURIOUS_FN)(
+    _In_ void* State
+    );
+
+//
+// Returns the congestion window, in bytes.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+(QUIC_API * QUIC_CUSTOM_CONGESTION_CONTROL_GET_WINDOW_FN)(
+    _In_ const void* State
+    );
+
+//
+// Returns the pacing rate, in bytes per second, or zero to let MsQuic pace
+// based on the congestion window and smoothed RTT.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint64_t
+(QUIC_API * QUIC_CUSTOM_CONGESTION_CONTROL_GET_PACING_RATE_FN)(
+    _In_ const void* State
+    );
+
+typedef struct QUIC_CUSTOM_CONGESTION_CONTROL {
+    uint16_t Algorithm;             // QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_BASE + [0, QUIC_MAX_CUSTOM_CONGESTION_CONTROL_ALGORITHMS)
+    const char* Name;               // Must remain valid until MsQuicClose.
+    void* Context;                  // Passed to Create.
+    QUIC_CUSTOM_CONGESTION_CONTROL_CREATE_FN Create;
+    QUIC_CUSTOM_CONGESTION_CONTROL_DELETE_FN Delete;
+    QUIC_CUSTOM_CONGESTION_CONTROL_RESET_FN Reset;
+    QUIC_CUSTOM_CONGESTION_CONTROL_DATA_SENT_FN OnDataSent;                 // Optional
+    QUIC_CUSTOM_CONGESTION_CONTROL_DATA_ACKED_FN OnDataAcknowledged;
+    QUIC_CUSTOM_CONGESTION_CONTROL_CONGESTION_FN OnDataLost;
+    QUIC_CUSTOM_CONGESTION_CONTROL_CONGESTION_FN OnEcn;                     // Optional
+    QUIC_CUSTOM_CONGESTION_CONTROL_SPURIOUS_FN OnSpuriousCongestionEvent;   // Optional
+    QUIC_CUSTOM_CONGESTION_CONTROL_GET_WINDOW_FN GetCongestionWindow;
+    QUIC_CUSTOM_CONGESTION_CONTROL_GET_PACING_RATE_FN GetPacingRate;        // Optional
+} QUIC_CUSTOM_CONGESTION_CONTROL;
+
 #endif // QUIC_API_ENABLE_PREVIEW_FEATURES
 
 typedef struct QUIC_REGISTRATION_CONFIG { // All fields may be NULL/zero.
@@ -528,10 +680,20 @@ typedef enum QUIC_CONGESTION_CONTROL_ALGORITHM {
     QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC,
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
     QUIC_CONGESTION_CONTROL_ALGORITHM_BBR,
+    QUIC_CONGESTION_CONTROL_ALGORITHM_BBR3,
 #endif
     QUIC_CONGESTION_CONTROL_ALGORITHM_MAX,
 } QUIC_CONGESTION_CONTROL_ALGORITHM;
 
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+//
+// Algorithm values reserved for app provided congestion control, registered
+// via QUIC_PARAM_GLOBAL_CUSTOM_CONGESTION_CONTROL.
+//
+#define QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_BASE   0x80
+#define QUIC_MAX_CUSTOM_CONGESTION_CONTROL_ALGORITHMS   4
+#endif
+
 //
 // All the available information describing a handshake.
 //
@@ -661,6 +823,11 @@ typedef struct QUIC_STATISTICS_V2 {
     uint32_t SendQueueDelayMaxUs;           // Maximum send queue delay in microseconds
     uint32_t ReceiveQueueDelayAvgUs;        // Sliding average receive queue delay in microseconds
     uint32_t ReceiveQueueDelayMaxUs;        // Maximum receive queue delay in microseconds
+    uint64_t SendEcnEctPackets;             // Packets sent with an ECT(0) or ECT(1) codepoint.
+    uint64_t SendEcnCePackets;              // Sent packets the peer reported as CE marked.
+    uint64_t RecvEcnCePackets;              // Packets received with the CE codepoint.
+    uint64_t SendBatchCount;                // Send calls made to the datapath.
+    uint64_t SendBatchDatagrams;            // Datagrams handed to the datapath across all send calls.
 #endif
 
     // N.B. New fields must be appended to end
@@ -687,6 +854,8 @@ typedef struct QUIC_NETWORK_STATISTICS
 #define QUIC_STATISTICS_V2_SIZE_4   QUIC_STRUCT_SIZE_THRU_FIELD(QUIC_STATISTICS_V2, RttVariance)            // MsQuic v2.5 final size
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
 #define QUIC_STATISTICS_V2_SIZE_5   QUIC_STRUCT_SIZE_THRU_FIELD(QUIC_STATISTICS_V2, ReceiveQueueDelayMaxUs) // MsQuic v2.6 preview size
+#define QUIC_STATISTICS_V2_SIZE_6   QUIC_STRUCT_SIZE_THRU_FIELD(QUIC_STATISTICS_V2, RecvEcnCePackets)       // MsQuic v2.6 preview size (ECN counters)
+#define QUIC_STATISTICS_V2_SIZE_7   QUIC_STRUCT_SIZE_THRU_FIELD(QUIC_STATISTICS_V2, SendBatchDatagrams)     // MsQuic v2.6 preview size (send batching)
 #endif
 
 typedef struct QUIC_LISTENER_STATISTICS {
@@ -735,6 +904,11 @@ typedef enum QUIC_PERFORMANCE_COUNTERS {
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
     QUIC_PERF_COUNTER_ENCRYPT_DURATION_US,  // Total time spent on encryption in microseconds.
     QUIC_PERF_COUNTER_DECRYPT_DURATION_US,  // Total time spent on decryption in microseconds.
+    QUIC_PERF_COUNTER_UDP_SEND_COALESCED,   // Total UDP send API calls that shared a system call with another.
+    QUIC_PERF_COUNTER_CONN_OPER_DRAINS,     // Total times connections drained their operation queue.
+    QUIC_PERF_COUNTER_CONN_OPER_COALESCED,  // Total connection operations merged into an already queued operation.
+    QUIC_PERF_COUNTER_CONN_ARENA_ALLOC,     // Total connection objects allocated in the connection's own memory.
+    QUIC_PERF_COUNTER_CONN_ARENA_OVERFLOW,  // Total connection objects allocated separately because the connection's memory was in use.
 #endif
     QUIC_PERF_COUNTER_MAX,
 } QUIC_PERFORMANCE_COUNTERS;
@@ -819,7 +993,8 @@ typedef struct QUIC_SETTINGS {
             uint64_t XdpEnabled                             : 1;
             uint64_t QTIPEnabled                            : 1;
             uint64_t ReservedRioEnabled                     : 1;
-            uint64_t RESERVED                               : 18;
+            uint64_t EcnL4sEnabled                          : 1;
+            uint64_t RESERVED                               : 17;
 #else
             uint64_t RESERVED                               : 26;
 #endif
@@ -873,7 +1048,8 @@ typedef struct QUIC_SETTINGS {
             uint64_t XdpEnabled                : 1;
             uint64_t QTIPEnabled               : 1;
             uint64_t ReservedRioEnabled        : 1;
-            uint64_t ReservedFlags             : 55;
+            uint64_t EcnL4sEnabled             : 1;
+            uint64_t ReservedFlags             : 54;
 #else
             uint64_t ReservedFlags             : 63;
 #endif
@@ -1008,6 +1184,8 @@ void
 #define QUIC_PARAM_GLOBAL_STATELESS_RETRY_CONFIG        0x0100000D  // QUIC_STATELESS_RETRY_CONFIG
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
 #define QUIC_PARAM_GLOBAL_XDP_MAP_CONFIG                0x0100000E  // QUIC_XDP_MAP_CONFIG[]
+#define QUIC_PARAM_GLOBAL_CUSTOM_CONGESTION_CONTROL     0x0100000F  // QUIC_CUSTOM_CONGESTION_CONTROL - Set-only
+#define QUIC_PARAM_GLOBAL_TLS_SIGNING_POOL_SIZE         0x01000010  // uint16_t - Set-only
 #endif
 
 //
@@ -1110,6 +1288,7 @@ typedef struct QUIC_SCHANNEL_CONTEXT_ATTRIBUTE_EX_W {
 #define QUIC_PARAM_STREAM_STATISTICS                    0X08000004  // QUIC_STREAM_STATISTICS
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
 #define QUIC_PARAM_STREAM_RELIABLE_OFFSET               0x08000005  // uint64_t
+#define QUIC_PARAM_STREAM_SEND_DEADLINE                 0x08000006  // uint64_t - microseconds, relative to send (0 = none)
 #endif
 
 typedef
@@ -202,6 +202,11 @@ DumpMsQuicPerfCounters(
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
     printf("  ENCRYPT_DURATION_US:   %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_ENCRYPT_DURATION_US]);
     printf("  DECRYPT_DURATION_US:   %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_DECRYPT_DURATION_US]);
+    printf("  UDP_SEND_COALESCED:    %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_UDP_SEND_COALESCED]);
+    printf("  CONN_OPER_DRAINS:      %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_CONN_OPER_DRAINS]);
+    printf("  CONN_OPER_COALESCED:   %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_CONN_OPER_COALESCED]);
+    printf("  CONN_ARENA_ALLOC:      %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_CONN_ARENA_ALLOC]);
+    printf("  CONN_ARENA_OVERFLOW:   %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_CONN_ARENA_OVERFLOW]);
 #endif
 }
 
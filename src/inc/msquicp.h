@@ -126,6 +126,20 @@ typedef struct QUIC_PRIVATE_TRANSPORT_PARAMETER {
 //
 #define QUIC_PARAM_GLOBAL_DATAPATH_DSCP_RECV_ENABLED    0x81000007 // BOOLEAN
 
+//
+// Sets whether the datapath will send from a registered buffer arena with
+// zero-copy send operations (io_uring only). Falls back to copying sends when
+// not supported by the kernel.
+//
+#define QUIC_PARAM_GLOBAL_DATAPATH_SEND_ZERO_COPY_ENABLED 0x81000008 // BOOLEAN
+
+//
+// Sets whether paced sends are handed to the datapath with their departure
+// time (SO_TXTIME on Linux), instead of being held back by the pacing timer.
+// Requires the fq qdisc to be effective. Ignored when not supported.
+//
+#define QUIC_PARAM_GLOBAL_DATAPATH_SEND_TXTIME_ENABLED  0x81000009 // BOOLEAN
+
 //
 // The different private parameters for Configuration.
 //
@@ -361,6 +361,18 @@ CxPlatHpComputeMask(
         uint8_t* Mask
     );
 
+//
+// Enables or disables the use of a native (CPU specific) multi-block kernel for
+// header protection keys created after this call. Enabled by default when the
+// CPU supports it. Returns FALSE if there is no native kernel, in which case
+// the crypto library is always used.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+CxPlatHpSetNativeEnabled(
+    _In_ BOOLEAN Enabled
+    );
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 CxPlatHashCreate(
@@ -436,6 +436,8 @@ typedef enum CXPLAT_DATAPATH_FEATURES {
     CXPLAT_DATAPATH_FEATURE_TTL                = 0x00000080,
     CXPLAT_DATAPATH_FEATURE_SEND_DSCP          = 0x00000100,
     CXPLAT_DATAPATH_FEATURE_RECV_DSCP          = 0x00000200,
+    CXPLAT_DATAPATH_FEATURE_SEND_ZERO_COPY     = 0x00000400,
+    CXPLAT_DATAPATH_FEATURE_SEND_TXTIME        = 0x00000800,
 } CXPLAT_DATAPATH_FEATURES;
 
 DEFINE_ENUM_FLAG_OPERATORS(CXPLAT_DATAPATH_FEATURES)
@@ -481,6 +483,20 @@ typedef struct CXPLAT_DATAPATH_INIT_CONFIG {
     //
     BOOLEAN EnableDscpOnRecv;
 
+    //
+    // Whether the datapath should send from registered buffers with zero-copy
+    // send operations, when supported by the platform. Currently only used by
+    // the io_uring datapath.
+    //
+    BOOLEAN EnableSendZeroCopy;
+
+    //
+    // Whether the datapath should schedule sends at the departure time given
+    // in CXPLAT_SEND_CONFIG (earliest departure time, via SO_TXTIME), when
+    // supported by the platform.
+    //
+    BOOLEAN EnableSendTxTime;
+
     _Field_size_(XdpMapConfigCount)
     const CXPLAT_XDP_MAP_CONFIG* XdpMapConfigs;
     uint32_t XdpMapConfigCount;
@@ -518,6 +534,15 @@ CxPlatDataPathGetXdpRuleCount(
     _In_ CXPLAT_DATAPATH* Datapath
     );
 
+//
+// Returns the total number of sends the datapath has submitted as zero-copy.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint64_t
+CxPlatDataPathGetSendZeroCopyCount(
+    _In_ CXPLAT_DATAPATH* Datapath
+    );
+
 //
 // Updates the polling idle timeout of a datapath.
 //
@@ -804,6 +829,7 @@ typedef struct CXPLAT_SEND_CONFIG {
     uint8_t ECN; // CXPLAT_ECN_TYPE
     uint8_t Flags; // CXPLAT_SEND_FLAGS
     uint8_t DSCP; // CXPLAT_DSCP_TYPE
+    uint64_t TxTime; // Earliest departure time (CxPlatTimeUs64), 0 for now
 } CXPLAT_SEND_CONFIG;
 
 //
@@ -868,6 +894,63 @@ CxPlatSocketSend(
     _In_ CXPLAT_SEND_DATA* SendData
     );
 
+//
+// The maximum number of sends held by a send batch before it is flushed.
+//
+#define CXPLAT_SEND_BATCH_SIZE 64
+
+//
+// A set of sends, possibly for different sockets and remote addresses, that
+// are handed to the datapath together, so the datapath can submit sends that
+// share a socket in a single system call. A batch is owned and used by a
+// single thread and must be zero initialized.
+//
+typedef struct CXPLAT_SEND_BATCH {
+    //
+    // The sends not yet handed to the datapath, in the order they were queued.
+    //
+    CXPLAT_SEND_DATA* Sends[CXPLAT_SEND_BATCH_SIZE];
+    uint32_t Count;
+
+    //
+    // The number of flushed sends that shared a system call with an earlier
+    // send in the same flush, instead of needing one of their own.
+    //
+    uint64_t CoalescedSends;
+
+    //
+    // The number of send system calls made by flushes, and the time spent in
+    // them, in nanoseconds. Only datapaths that make the system call while
+    // flushing measure these; they stay zero otherwise.
+    //
+    uint32_t SendCalls;
+    uint64_t SendCallTimeNs;
+
+} CXPLAT_SEND_BATCH;
+
+//
+// Sends the data over the socket. If the datapath supports it, the send is
+// held in the batch until the next call to CxPlatSendBatchFlush, or until the
+// batch is full. The socket must not be deleted before the send is flushed.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSocketSendBatched(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    );
+
+//
+// Hands all the sends held in the batch to the datapath.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSendBatchFlush(
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    );
+
 typedef struct CXPLAT_TCP_STATISTICS { // Mostly copied from TCP_INFO_v1 for now
     uint32_t Mss;
     uint64_t ConnectionTimeMs;
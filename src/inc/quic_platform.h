@@ -163,6 +163,10 @@ typedef struct CXPLAT_SLIST_ENTRY {
 #define QUIC_POOL_TLS_AUX_DATA              '05cQ' // Qc50 - QUIC TLS Backing Aux data
 #define QUIC_POOL_TLS_RECORD_ENTRY          '15cQ' // Qc51 - QUIC TLS Backing Record storage
 #define QUIC_POOL_XDP_MAP_CONFIG            '25cQ' // Qc52 - QUIC XDP Map Config
+#define QUIC_POOL_DATAPATH_FIXED_FILES      '35cQ' // Qc53 - QUIC Datapath fixed file slots
+#define QUIC_POOL_SENT_PACKET_RING          '45cQ' // Qc54 - QUIC sent packet ring
+#define QUIC_POOL_PLATFORM_POOL             '55cQ' // Qc55 - QUIC Platform pool magazines
+#define QUIC_POOL_TLS_SIGNING_POOL          '65cQ' // Qc56 - QUIC TLS signing pool
 
 typedef enum CXPLAT_THREAD_FLAGS {
     CXPLAT_THREAD_FLAG_NONE               = 0x0000,
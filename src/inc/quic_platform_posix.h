@@ -482,52 +482,128 @@ typedef CXPLAT_RW_LOCK CXPLAT_DISPATCH_RW_LOCK;
 // Represents a QUIC memory pool used for fixed sized allocations.
 // This must be below the lock definitions.
 //
+// Free entries are cached per CPU in magazines, fixed size arrays of entries,
+// which the CPU allocates from and frees to without taking a lock. Only when
+// both of a CPU's magazines are empty (or full) does it exchange a whole
+// magazine with the depot of its NUMA node, under the depot's lock. Entries
+// always return to the depot of the node they were first allocated on.
+//
 
-FORCEINLINE
-void
-CxPlatListPushEntry(
-    _Inout_ CXPLAT_SLIST_ENTRY* ListHead,
-    _Inout_ __drv_aliasesMem CXPLAT_SLIST_ENTRY* Entry
-    );
+#define CXPLAT_POOL_MAGAZINE_SIZE   32
 
-FORCEINLINE
-CXPLAT_SLIST_ENTRY*
-CxPlatListPopEntry(
-    _Inout_ CXPLAT_SLIST_ENTRY* ListHead
+uint32_t
+CxPlatProcCurrentNumber(
+    void
     );
-typedef struct CXPLAT_POOL {
+
+typedef struct CXPLAT_POOL_MAGAZINE {
+    struct CXPLAT_POOL_MAGAZINE* Next;
+    uint32_t Count;
+    void* Entries[CXPLAT_POOL_MAGAZINE_SIZE]; // CXPLAT_POOL_HEADER
+} CXPLAT_POOL_MAGAZINE;
+
+//
+// The free entries cached for one CPU. Only accessed by the thread that swapped
+// it out of the CPU's slot in the pool.
+//
+typedef struct CXPLAT_POOL_CPU_CACHE {
 
     //
-    // List of free entries.
+    // Entries are allocated from and freed to the loaded magazine.
     //
-
-    CXPLAT_SLIST_ENTRY ListHead;
+    CXPLAT_POOL_MAGAZINE* Loaded;
 
     //
-    // Number of free entries in the list.
+    // A full or empty magazine, swapped with the loaded one before going to
+    // the depot.
     //
+    CXPLAT_POOL_MAGAZINE* Previous;
 
-    uint16_t ListDepth;
+    //
+    // The depot (NUMA node) of the CPU.
+    //
+    uint32_t Node;
 
     //
-    // Lock to synchronize access to the List.
-    // LINUX_TODO: Check how to make this lock free?
+    // Set by pruning and cleared on every use. A cache still idle at the next
+    // prune has its entries freed.
     //
+    BOOLEAN Idle;
+
+} CXPLAT_POOL_CPU_CACHE;
 
+//
+// Slot value while a thread is using the CPU's cache.
+//
+#define CXPLAT_POOL_CPU_CACHE_BUSY  ((CXPLAT_POOL_CPU_CACHE*)(uintptr_t)1)
+
+typedef struct CXPLAT_POOL_DEPOT {
+
+    //
+    // Lock to synchronize access to the magazines.
+    //
     CXPLAT_LOCK Lock;
 
     //
-    // Size of entries.
+    // Stacks of full and empty magazines.
+    //
+    CXPLAT_POOL_MAGAZINE* Full;
+    CXPLAT_POOL_MAGAZINE* Empty;
+    uint32_t FullCount;
+    uint32_t EmptyCount;
+
+    //
+    // Used for single entries, when no CPU cache is available.
+    //
+    CXPLAT_POOL_MAGAZINE* Partial;
+
+    //
+    // The number of full magazines the depot keeps. It doubles when the depot
+    // overflows after having run dry, up to the pool's MaxDepotFullCount, and
+    // is reset by pruning.
+    //
+    uint32_t MaxFullCount;
+    BOOLEAN Underflowed;
+
+} CXPLAT_POOL_DEPOT;
+
+typedef struct CXPLAT_POOL {
+
+    //
+    // Per-CPU slots holding the CPU's cache, NULL until the CPU first uses the
+    // pool. The array is NULL if it couldn't be allocated, in which case only
+    // the depots are used.
     //
+    CXPLAT_POOL_CPU_CACHE* volatile* Cpus;
 
+    //
+    // One depot per NUMA node.
+    //
+    CXPLAT_POOL_DEPOT* Depots;
+    uint32_t DepotCount;
+
+    //
+    // Size of entries.
+    //
     uint32_t Size;
 
     //
-    // The memory tag to use for any allocation from this pool.
+    // The most full magazines a depot may grow to. Without pruning a depot
+    // keeps its default depth. Pools that are pruned may grow until a depot
+    // holds CXPLAT_POOL_MAXIMUM_DEPOT_SIZE bytes of entries.
     //
+    uint32_t MaxDepotFullCount;
 
+    //
+    // The memory tag to use for any allocation from this pool.
+    //
     uint32_t Tag;
 
+    //
+    // Used as the only depot if there is one NUMA node.
+    //
+    CXPLAT_POOL_DEPOT LocalDepot;
+
 } CXPLAT_POOL;
 
 #define CXPLAT_MEMORY_ALIGNMENT 16
@@ -537,6 +613,7 @@ typedef struct __attribute__((aligned(CXPLAT_MEMORY_ALIGNMENT))) CXPLAT_POOL_HEA
     CXPLAT_POOL* Owner;
     CXPLAT_SLIST_ENTRY Entry;
     };
+    uint32_t Node; // Depot the entry belongs to.
 #if DEBUG
     uint64_t SpecialFlag;
 #endif
@@ -546,9 +623,13 @@ typedef struct __attribute__((aligned(CXPLAT_MEMORY_ALIGNMENT))) CXPLAT_POOL_HEA
 #define CXPLAT_POOL_ALLOC_FLAG  0xE9E9E9E9E9E9E9E9ull
 
 #ifndef DISABLE_CXPLAT_POOL
-#define CXPLAT_POOL_MAXIMUM_DEPTH   256 // Copied from EX_MAXIMUM_LOOKASIDE_DEPTH_BASE
+#define CXPLAT_POOL_MAXIMUM_DEPTH       0x4000  // 16384
+#define CXPLAT_POOL_DEFAULT_MAX_DEPTH   256     // Copied from EX_MAXIMUM_LOOKASIDE_DEPTH_BASE
+#define CXPLAT_POOL_MAXIMUM_DEPOT_SIZE  0x1000000 // 16MB of entries per depot
 #else
-#define CXPLAT_POOL_MAXIMUM_DEPTH   0   // TODO - Optimize this scenario better
+#define CXPLAT_POOL_MAXIMUM_DEPTH       0       // TODO - Optimize this scenario better
+#define CXPLAT_POOL_DEFAULT_MAX_DEPTH   0
+#define CXPLAT_POOL_MAXIMUM_DEPOT_SIZE  0
 #endif
 
 #if DEBUG
@@ -557,65 +638,113 @@ CxPlatGetAllocFailDenominator(
     );
 #endif
 
-QUIC_INLINE
 void
 CxPlatPoolInitialize(
     _In_ BOOLEAN IsPaged,
     _In_ uint32_t Size,
     _In_ uint32_t Tag,
     _Inout_ CXPLAT_POOL* Pool
-    )
-{
-    Pool->Size = Size + sizeof(CXPLAT_POOL_HEADER); // Add space for the pool header
-    Pool->Tag = Tag;
-    CxPlatLockInitialize(&Pool->Lock);
-    Pool->ListDepth = 0;
-    CxPlatZeroMemory(&Pool->ListHead, sizeof(Pool->ListHead));
-    UNREFERENCED_PARAMETER(IsPaged);
-}
+    );
 
-QUIC_INLINE
 void
 CxPlatPoolUninitialize(
     _Inout_ CXPLAT_POOL* Pool
+    );
+
+//
+// Called when the CPU's cache isn't available or its magazines are empty.
+// Takes ownership of the slot value that was swapped out. Falls back to a new
+// allocation.
+//
+CXPLAT_POOL_HEADER*
+CxPlatPoolAllocSlow(
+    _Inout_ CXPLAT_POOL* Pool,
+    _In_ uint32_t Cpu,
+    _In_opt_ CXPLAT_POOL_CPU_CACHE* Cache
+    );
+
+//
+// Called when the CPU's cache isn't available, its magazines are full or the
+// entry belongs to another node. Takes ownership of the slot value that was
+// swapped out.
+//
+void
+CxPlatPoolFreeSlow(
+    _Inout_ CXPLAT_POOL* Pool,
+    _In_ uint32_t Cpu,
+    _In_opt_ CXPLAT_POOL_CPU_CACHE* Cache,
+    _In_ CXPLAT_POOL_HEADER* Header
+    );
+
+//
+// Allocates a new entry from the heap, bypassing the caches.
+//
+CXPLAT_POOL_HEADER*
+CxPlatPoolAllocEntry(
+    _Inout_ CXPLAT_POOL* Pool
+    );
+
+QUIC_INLINE
+BOOLEAN
+CxPlatPoolIsCacheValid(
+    _In_opt_ const CXPLAT_POOL_CPU_CACHE* Cache
     )
 {
-    CXPLAT_POOL_HEADER* Entry;
-    while ((Entry = (CXPLAT_POOL_HEADER*)CxPlatListPopEntry(&Pool->ListHead)) != NULL) {
-        CXPLAT_DBG_ASSERT(Entry->SpecialFlag == CXPLAT_POOL_FREE_FLAG);
-        CxPlatFree(Entry, Pool->Tag);
-    }
-    CxPlatLockUninitialize(&Pool->Lock);
+    return Cache != NULL && Cache != CXPLAT_POOL_CPU_CACHE_BUSY;
 }
 
 QUIC_INLINE
-void*
-CxPlatPoolAlloc(
+CXPLAT_POOL_HEADER*
+CxPlatPoolAllocHeader(
     _Inout_ CXPLAT_POOL* Pool
     )
 {
-    CxPlatLockAcquire(&Pool->Lock);
-    CXPLAT_POOL_HEADER* Header =
-    #if DEBUG
-        CxPlatGetAllocFailDenominator() ? NULL : // No pool when using simulated alloc failures
-    #endif
-        (CXPLAT_POOL_HEADER*)CxPlatListPopEntry(&Pool->ListHead);
-    if (Header != NULL) {
-        CXPLAT_DBG_ASSERT(Pool->ListDepth > 0);
-        CXPLAT_DBG_ASSERT(Header->SpecialFlag == CXPLAT_POOL_FREE_FLAG);
-        Pool->ListDepth--;
+    CXPLAT_POOL_HEADER* Header;
+#ifndef DISABLE_CXPLAT_POOL
+#if DEBUG
+    if (CxPlatGetAllocFailDenominator()) {
+        Header = CxPlatPoolAllocEntry(Pool); // No pool when using simulated alloc failures
+    } else
+#endif
+    {
+        const uint32_t Cpu = CxPlatProcCurrentNumber();
+        CXPLAT_POOL_CPU_CACHE* Cache = NULL;
+        if (Pool->Cpus != NULL) {
+            Cache =
+                (CXPLAT_POOL_CPU_CACHE*)InterlockedExchangePointer(
+                    (void* volatile*)&Pool->Cpus[Cpu], CXPLAT_POOL_CPU_CACHE_BUSY);
+        }
+        if (CxPlatPoolIsCacheValid(Cache) && Cache->Loaded->Count != 0) {
+            Header = (CXPLAT_POOL_HEADER*)Cache->Loaded->Entries[--Cache->Loaded->Count];
+            Cache->Idle = FALSE;
+            __atomic_store_n(&Pool->Cpus[Cpu], Cache, __ATOMIC_RELEASE);
+        } else {
+            Header = CxPlatPoolAllocSlow(Pool, Cpu, Cache);
+        }
     }
-    CxPlatLockRelease(&Pool->Lock);
+#else
+    Header = CxPlatPoolAllocEntry(Pool);
+#endif
     if (Header == NULL) {
-        Header = (CXPLAT_POOL_HEADER*)CxPlatAlloc(Pool->Size, Pool->Tag);
-        if (Header == NULL) {
-            return NULL;
-        }
+        return NULL;
     }
 #if DEBUG
     Header->SpecialFlag = CXPLAT_POOL_ALLOC_FLAG;
 #endif
     Header->Owner = Pool;
+    return Header;
+}
+
+QUIC_INLINE
+void*
+CxPlatPoolAlloc(
+    _Inout_ CXPLAT_POOL* Pool
+    )
+{
+    CXPLAT_POOL_HEADER* Header = CxPlatPoolAllocHeader(Pool);
+    if (Header == NULL) {
+        return NULL;
+    }
     void* Result = (void*)((uint8_t*)Header + sizeof(CXPLAT_POOL_HEADER));
     CxPlatZeroMemory(Result, Pool->Size - sizeof(CXPLAT_POOL_HEADER));
     return Result;
@@ -627,28 +756,10 @@ CxPlatPoolAllocUninitialized(
     _Inout_ CXPLAT_POOL* Pool
     )
 {
-    CxPlatLockAcquire(&Pool->Lock);
-    CXPLAT_POOL_HEADER* Header =
-    #if DEBUG
-        CxPlatGetAllocFailDenominator() ? NULL : // No pool when using simulated alloc failures
-    #endif
-        (CXPLAT_POOL_HEADER*)CxPlatListPopEntry(&Pool->ListHead);
-    if (Header != NULL) {
-        CXPLAT_DBG_ASSERT(Pool->ListDepth > 0);
-        CXPLAT_DBG_ASSERT(Header->SpecialFlag == CXPLAT_POOL_FREE_FLAG);
-        Pool->ListDepth--;
-    }
-    CxPlatLockRelease(&Pool->Lock);
+    CXPLAT_POOL_HEADER* Header = CxPlatPoolAllocHeader(Pool);
     if (Header == NULL) {
-        Header = (CXPLAT_POOL_HEADER*)CxPlatAlloc(Pool->Size, Pool->Tag);
-        if (Header == NULL) {
-            return NULL;
-        }
+        return NULL;
     }
-#if DEBUG
-    Header->SpecialFlag = CXPLAT_POOL_ALLOC_FLAG;
-#endif
-    Header->Owner = Pool;
     return (void*)((uint8_t*)Header + sizeof(CXPLAT_POOL_HEADER));
 }
 
@@ -668,35 +779,48 @@ CxPlatPoolFree(
     }
     Header->SpecialFlag = CXPLAT_POOL_FREE_FLAG;
 #endif
-    if (Pool->ListDepth >= CXPLAT_POOL_MAXIMUM_DEPTH) {
-        CxPlatFree(Header, Pool->Tag);
+#ifndef DISABLE_CXPLAT_POOL
+    const uint32_t Cpu = CxPlatProcCurrentNumber();
+    CXPLAT_POOL_CPU_CACHE* Cache = NULL;
+    if (Pool->Cpus != NULL) {
+        Cache =
+            (CXPLAT_POOL_CPU_CACHE*)InterlockedExchangePointer(
+                (void* volatile*)&Pool->Cpus[Cpu], CXPLAT_POOL_CPU_CACHE_BUSY);
+    }
+    if (CxPlatPoolIsCacheValid(Cache) &&
+        Cache->Node == Header->Node &&
+        Cache->Loaded->Count < CXPLAT_POOL_MAGAZINE_SIZE) {
+        Cache->Loaded->Entries[Cache->Loaded->Count++] = Header;
+        Cache->Idle = FALSE;
+        __atomic_store_n(&Pool->Cpus[Cpu], Cache, __ATOMIC_RELEASE);
     } else {
-        CxPlatLockAcquire(&Pool->Lock);
-        CxPlatListPushEntry(&Pool->ListHead, &Header->Entry);
-        Pool->ListDepth++;
-        CxPlatLockRelease(&Pool->Lock);
+        CxPlatPoolFreeSlow(Pool, Cpu, Cache, Header);
     }
+#else
+    CxPlatFree(Header, Pool->Tag);
+#endif
 }
 
-QUIC_INLINE
+//
+// Lets the pool's depots grow past their default depth. Only for pools that
+// are pruned, i.e. registered with CxPlatAddDynamicPoolAllocator, which calls
+// this.
+//
+void
+CxPlatPoolAllowGrowth(
+    _Inout_ CXPLAT_POOL* Pool
+    );
+
+//
+// Frees one full magazine held by the pool's depots or, once those are gone,
+// the entries cached by one CPU that hasn't used the pool since the last prune.
+// Returns FALSE when there is nothing left to free, after shrinking the depots
+// back to their default depth and marking the CPU caches idle.
+//
 BOOLEAN
 CxPlatPoolPrune(
     _Inout_ CXPLAT_POOL* Pool
-    )
-{
-    CxPlatLockAcquire(&Pool->Lock);
-    void* Entry = CxPlatListPopEntry(&Pool->ListHead);
-    if (Entry != NULL) {
-        CXPLAT_FRE_ASSERT(Pool->ListDepth > 0);
-        Pool->ListDepth--;
-    }
-    CxPlatLockRelease(&Pool->Lock);
-    if (Entry == NULL) {
-        return FALSE;
-    }
-    CxPlatFree(Entry, Pool->Tag);
-    return TRUE;
-}
+    );
 
 //
 // Reference Count Interface
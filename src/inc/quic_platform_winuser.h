@@ -511,6 +511,15 @@ CxPlatPoolFree(
     }
 }
 
+QUIC_INLINE
+void
+CxPlatPoolAllowGrowth(
+    _Inout_ CXPLAT_POOL* Pool
+    )
+{
+    UNREFERENCED_PARAMETER(Pool); // The depth is always MaxDepth.
+}
+
 QUIC_INLINE
 BOOLEAN
 CxPlatPoolPrune(
@@ -61,7 +61,9 @@ typedef enum CXPLAT_TLS_CREDENTIAL_FLAGS {
 } CXPLAT_TLS_CREDENTIAL_FLAGS;
 
 //
-// Callback for indicating process can be completed.
+// Callback for indicating a pending CxPlatTlsProcessData call can be completed
+// with CxPlatTlsProcessDataComplete. Called on a thread other than the one that
+// made the CxPlatTlsProcessData call.
 //
 typedef
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -136,6 +138,12 @@ typedef struct CXPLAT_TLS_CALLBACKS {
     //
     CXPLAT_TLS_PEER_CERTIFICATE_RECEIVED_CALLBACK_HANDLER CertificateReceived;
 
+    //
+    // Invoked when a CxPlatTlsProcessData call that returned
+    // CXPLAT_TLS_RESULT_PENDING has finished.
+    //
+    CXPLAT_TLS_PROCESS_COMPLETE_CALLBACK_HANDLER ProcessComplete;
+
 } CXPLAT_TLS_CALLBACKS;
 
 //
@@ -212,6 +220,7 @@ typedef enum CXPLAT_TLS_RESULT_FLAGS {
     CXPLAT_TLS_RESULT_EARLY_DATA_ACCEPT   = 0x0010, // The server accepted the early (0-RTT) data.
     CXPLAT_TLS_RESULT_EARLY_DATA_REJECT   = 0x0020, // The server rejected the early (0-RTT) data.
     CXPLAT_TLS_RESULT_HANDSHAKE_COMPLETE  = 0x0040, // Handshake complete.
+    CXPLAT_TLS_RESULT_PENDING             = 0x0080, // Processing continues asynchronously.
     CXPLAT_TLS_RESULT_ERROR               = 0x8000  // An error occured.
 
 } CXPLAT_TLS_RESULT_FLAGS;
@@ -437,6 +446,30 @@ CxPlatTlsProcessData(
     _Inout_ CXPLAT_TLS_PROCESS_STATE* State
     );
 
+//
+// Called after the ProcessComplete callback to collect the results of a
+// CxPlatTlsProcessData call that returned CXPLAT_TLS_RESULT_PENDING. The input
+// buffer was already consumed by the original call. No other calls may be made
+// on the TLS context while processing is pending.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+CXPLAT_TLS_RESULT_FLAGS
+CxPlatTlsProcessDataComplete(
+    _In_ CXPLAT_TLS* TlsContext,
+    _Inout_ CXPLAT_TLS_PROCESS_STATE* State
+    );
+
+//
+// Sets the number of threads started for each server security configuration
+// created with QUIC_CREDENTIAL_FLAG_ASYNC_SIGNING. Zero indicates the default
+// (one per two processors, at most four).
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatTlsSetSigningPoolSize(
+    _In_ uint16_t ThreadCount
+    );
+
 //
 // Sets a Security Configuration parameter.
 //
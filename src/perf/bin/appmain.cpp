@@ -23,48 +23,77 @@ typedef struct {
 #include "quic_driver_helpers.h"
 #endif // _WIN32
 
+static const char* LatencyPhaseNames[PERF_LATENCY_PHASE_COUNT] = {
+    "request", "initial", "handshake", "shutdown"
+};
+
 void
-QuicHandleExtraData(
-    _In_reads_(Length) uint8_t* ExtraData,
-    _In_ uint32_t Length,
+QuicHandleLatencyPhase(
+    _In_ uint32_t Phase,
+    _In_reads_(Count) uint32_t* Values,
+    _In_ uint32_t Count,
+    _In_ uint64_t RunTime,
     _In_opt_z_ const char* FileName
     )
 {
-    uint64_t RunTime;
-    uint64_t CachedCompletedRequests;
-    CXPLAT_FRE_ASSERT(Length >= sizeof(RunTime) + sizeof(CachedCompletedRequests));
-    CxPlatCopyMemory(&RunTime, ExtraData, sizeof(RunTime));
-    ExtraData += sizeof(RunTime);
-    CxPlatCopyMemory(&CachedCompletedRequests, ExtraData, sizeof(CachedCompletedRequests));
-    ExtraData += sizeof(CachedCompletedRequests);
-    CXPLAT_FRE_ASSERT(CachedCompletedRequests <= UINT32_MAX);
-    uint32_t RestOfBufferLength = Length - sizeof(RunTime) - sizeof(CachedCompletedRequests);
-    RestOfBufferLength &= 0xFFFFFFFC; // Round down to nearest multiple of 4
-    uint32_t MaxCount = CXPLAT_MIN((uint32_t)CachedCompletedRequests, RestOfBufferLength);
-
-    uint32_t RPS = (uint32_t)((CachedCompletedRequests * 1000ull * 1000ull) / RunTime);
-    if (RPS == 0) {
-        printf("Error: No requests were completed\n");
+    if (Phase >= PERF_LATENCY_PHASE_COUNT) {
+        printf("Error: Unknown latency phase %u\n", Phase);
         return;
     }
 
     Statistics LatencyStats;
     Percentiles PercentileStats;
-    GetStatistics((uint32_t*)ExtraData, MaxCount, &LatencyStats, &PercentileStats);
-    WriteOutput(
-        "Result: %u RPS, Latency,us 0th: %d, 50th: %.0f, 90th: %.0f, 99th: %.0f, 99.9th: %.0f, 99.99th: %.0f, 99.999th: %.0f, 99.9999th: %.0f, Max: %d\n",
-        RPS,
-        LatencyStats.Min,
-        PercentileStats.P50,
-        PercentileStats.P90,
-        PercentileStats.P99,
-        PercentileStats.P99p9,
-        PercentileStats.P99p99,
-        PercentileStats.P99p999,
-        PercentileStats.P99p9999,
-        LatencyStats.Max);
+    if (Phase == PERF_LATENCY_PHASE_REQUEST) {
+        uint32_t RPS = (uint32_t)((Count * 1000ull * 1000ull) / RunTime);
+        if (RPS == 0) {
+            printf("Error: No requests were completed\n");
+            return;
+        }
+
+        GetStatistics(Values, Count, &LatencyStats, &PercentileStats);
+        WriteOutput(
+            "Result: %u RPS, Latency,us 0th: %d, 50th: %.0f, 90th: %.0f, 99th: %.0f, 99.9th: %.0f, 99.99th: %.0f, 99.999th: %.0f, 99.9999th: %.0f, Max: %d\n",
+            RPS,
+            LatencyStats.Min,
+            PercentileStats.P50,
+            PercentileStats.P90,
+            PercentileStats.P99,
+            PercentileStats.P99p9,
+            PercentileStats.P99p99,
+            PercentileStats.P99p999,
+            PercentileStats.P99p9999,
+            LatencyStats.Max);
+    } else {
+        if (Count == 0) {
+            printf("Error: No connections completed the %s phase\n", LatencyPhaseNames[Phase]);
+            return;
+        }
+
+        GetStatistics(Values, Count, &LatencyStats, &PercentileStats);
+        WriteOutput(
+            "Result: %s Latency,us 0th: %d, 50th: %.0f, 90th: %.0f, 99th: %.0f, 99.9th: %.0f, 99.99th: %.0f, 99.999th: %.0f, 99.9999th: %.0f, Max: %d\n",
+            LatencyPhaseNames[Phase],
+            LatencyStats.Min,
+            PercentileStats.P50,
+            PercentileStats.P90,
+            PercentileStats.P99,
+            PercentileStats.P99p9,
+            PercentileStats.P99p99,
+            PercentileStats.P99p999,
+            PercentileStats.P99p9999,
+            LatencyStats.Max);
+    }
 
     if (FileName != nullptr) {
+        //
+        // Request latency keeps the file name as given. Connection phases each
+        // get their own file, suffixed with the phase name.
+        //
+        char PhaseFileName[512];
+        if (Phase != PERF_LATENCY_PHASE_REQUEST) {
+            snprintf(PhaseFileName, sizeof(PhaseFileName), "%s.%s", FileName, LatencyPhaseNames[Phase]);
+            FileName = PhaseFileName;
+        }
 #ifdef _WIN32
         FILE* FilePtr = nullptr;
         errno_t FileErr = fopen_s(&FilePtr, FileName, "w");
@@ -77,11 +106,11 @@ QuicHandleExtraData(
             return;
         }
         struct hdr_histogram* histogram = nullptr;
-        if (hdr_init(1, LatencyStats.Max, 3, &histogram)) {
+        if (hdr_init(1, CXPLAT_MAX(LatencyStats.Max, 2), 3, &histogram)) {
             printf("Failed to create histogram\n");
         } else {
-            for (size_t i = 0; i < MaxCount; i++) {
-                hdr_record_value(histogram, ((uint32_t*)ExtraData)[i]);
+            for (size_t i = 0; i < Count; i++) {
+                hdr_record_value(histogram, Values[i]);
             }
             hdr_percentiles_print(histogram, FilePtr, 5, 1.0, CLASSIC);
             hdr_close(histogram);
@@ -90,6 +119,31 @@ QuicHandleExtraData(
     }
 }
 
+void
+QuicHandleExtraData(
+    _In_reads_(Length) uint8_t* ExtraData,
+    _In_ uint32_t Length,
+    _In_opt_z_ const char* FileName
+    )
+{
+    uint64_t RunTime;
+    CXPLAT_FRE_ASSERT(Length >= sizeof(RunTime));
+    CxPlatCopyMemory(&RunTime, ExtraData, sizeof(RunTime));
+    ExtraData += sizeof(RunTime);
+    Length -= sizeof(RunTime);
+
+    while (Length >= sizeof(PERF_LATENCY_HEADER)) {
+        PERF_LATENCY_HEADER Header;
+        CxPlatCopyMemory(&Header, ExtraData, sizeof(Header));
+        ExtraData += sizeof(Header);
+        Length -= sizeof(Header);
+        const uint32_t Count = CXPLAT_MIN(Header.Count, Length / (uint32_t)sizeof(uint32_t));
+        QuicHandleLatencyPhase(Header.Phase, (uint32_t*)ExtraData, Count, RunTime, FileName);
+        ExtraData += Count * sizeof(uint32_t);
+        Length -= Count * (uint32_t)sizeof(uint32_t);
+    }
+}
+
 QUIC_STATUS
 QuicUserMain(
     _In_ int argc,
@@ -41,6 +41,22 @@ PerfClient::Init(
             Download = S_TO_US(12); // 12 seconds
             Timed = TRUE;
             PrintThroughput = TRUE;
+        } else if (IsValue(ScenarioStr, "hps-resume")) {
+            ConnectionCount = 16 * CxPlatProcCount();
+            RunTime = S_TO_US(12); // 12 seconds
+            RepeatConnections = TRUE;
+            Resume = TRUE;
+            PrintIoRate = TRUE;
+        } else if (IsValue(ScenarioStr, "hps-0rtt")) {
+            Upload = 512;
+            Download = 4000;
+            ConnectionCount = 16 * CxPlatProcCount();
+            StreamCount = 1;
+            RunTime = S_TO_US(12); // 12 seconds
+            RepeatConnections = TRUE;
+            Resume = TRUE;
+            ZeroRtt = TRUE;
+            PrintIoRate = TRUE;
         } else if (IsValue(ScenarioStr, "hps")) {
             ConnectionCount = 16 * CxPlatProcCount();
             RunTime = S_TO_US(12); // 12 seconds
@@ -67,6 +83,13 @@ PerfClient::Init(
             RunTime = S_TO_US(20); // 20 seconds
             RepeatStreams = TRUE;
             PrintLatency = TRUE;
+        } else if (IsValue(ScenarioStr, "contention")) {
+            Upload = 512;
+            Download = 4000;
+            RunTime = S_TO_US(20); // 20 seconds
+            RepeatStreams = TRUE;
+            PrintLatency = TRUE;
+            BulkStreamCount = 4;
         } else {
             WriteOutput("Failed to parse scenario profile[%s]!\n", ScenarioStr);
             return QUIC_STATUS_INVALID_PARAMETER;
@@ -188,12 +211,47 @@ PerfClient::Init(
     TryGetValue(argc, argv, "rc", &RepeatConnections);
     TryGetValue(argc, argv, "rstream", &RepeatStreams);
     TryGetValue(argc, argv, "rs", &RepeatStreams);
+    TryGetValue(argc, argv, "resume", &Resume);
+    TryGetValue(argc, argv, "0rtt", &ZeroRtt);
+    TryGetVariableUnitValue(argc, argv, "rate", &ConnectionRate);
+    TryGetValue(argc, argv, "bulk", &BulkStreamCount);
+    TryGetValue(argc, argv, "deadline", &SendDeadline);
+
+    const char* SchedStr = GetValue(argc, argv, "sched");
+    if (SchedStr != nullptr) {
+        SetSchedulingScheme = TRUE;
+        if (IsValue(SchedStr, "fifo")) {
+            SchedulingScheme = QUIC_STREAM_SCHEDULING_SCHEME_FIFO;
+        } else if (IsValue(SchedStr, "rr")) {
+            SchedulingScheme = QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN;
+        } else if (IsValue(SchedStr, "wfq")) {
+            SchedulingScheme = QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR;
+        } else if (IsValue(SchedStr, "edf")) {
+            SchedulingScheme = QUIC_STREAM_SCHEDULING_SCHEME_DEADLINE;
+        } else {
+            WriteOutput("Failed to parse stream scheduling scheme[%s]!\n", SchedStr);
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    if (ZeroRtt) {
+        Resume = TRUE; // 0-RTT needs a ticket from a previous connection
+    }
+
+    if (ConnectionRate) {
+        RepeatConnections = TRUE; // Open loop keeps starting new connections
+    }
 
     if ((RepeatConnections || RepeatStreams) && !RunTime) {
         WriteOutput("Must specify a 'runtime' if using a repeat parameter!\n");
         return QUIC_STATUS_INVALID_PARAMETER;
     }
 
+    if (Resume && !RepeatConnections) {
+        WriteOutput("Must specify 'rconn' or 'rate' if using 'resume'!\n");
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
     if (UseTCP) {
         if (!UseEncryption) {
             WriteOutput("TCP mode doesn't support disabling encryption!\n");
@@ -203,6 +261,14 @@ PerfClient::Init(
             WriteOutput("TCP mode doesn't support CIBIR!\n");
             return QUIC_STATUS_INVALID_PARAMETER;
         }
+        if (BulkStreamCount || SetSchedulingScheme) {
+            WriteOutput("TCP mode doesn't support stream scheduling!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        if (Resume) {
+            WriteOutput("TCP mode doesn't support resumption!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
     }
 
     if ((Upload || Download) && !StreamCount) {
@@ -259,7 +325,11 @@ PerfClient::Init(
     }
 
     RequestBuffer.Init(IoSize, Timed ? UINT64_MAX : Download);
+    if (BulkStreamCount) {
+        BulkBuffer.Init(IoSize, 0); // No response
+    }
     if (PrintLatency) {
+        uint64_t MaxLatencyIndex;
         if (RunTime) {
             MaxLatencyIndex = ((uint64_t)RunTime / (1000 * 1000)) * PERF_MAX_REQUESTS_PER_SECOND;
             if (MaxLatencyIndex > (UINT32_MAX / sizeof(uint32_t))) {
@@ -271,11 +341,34 @@ PerfClient::Init(
             MaxLatencyIndex = ConnectionCount * StreamCount;
         }
 
-        LatencyValues = UniquePtr<uint32_t[]>(new(std::nothrow) uint32_t[(size_t)MaxLatencyIndex]);
-        if (LatencyValues == nullptr) {
-            return QUIC_STATUS_OUT_OF_MEMORY;
+        if (StreamCount) {
+            Status = Latency[PERF_LATENCY_PHASE_REQUEST].Initialize(MaxLatencyIndex);
+            if (QUIC_FAILED(Status)) {
+                return Status;
+            }
+        }
+
+        //
+        // Connection phases are only interesting when connections repeat.
+        //
+        if (RepeatConnections) {
+            uint64_t MaxHandshakeIndex =
+                ((uint64_t)RunTime / (1000 * 1000)) * PERF_MAX_HANDSHAKES_PER_SECOND;
+            if (MaxHandshakeIndex > (UINT32_MAX / sizeof(uint32_t))) {
+                MaxHandshakeIndex = UINT32_MAX / sizeof(uint32_t);
+                WriteOutput("Warning! Limiting handshake latency tracking to %llu handshakes\n",
+                    (unsigned long long)MaxHandshakeIndex);
+            }
+            for (uint32_t i = PERF_LATENCY_PHASE_INITIAL; i < PERF_LATENCY_PHASE_COUNT; ++i) {
+                if (UseTCP && i == PERF_LATENCY_PHASE_INITIAL) {
+                    continue; // Not observable for TCP
+                }
+                Status = Latency[i].Initialize(MaxHandshakeIndex);
+                if (QUIC_FAILED(Status)) {
+                    return Status;
+                }
+            }
         }
-        CxPlatZeroMemory(LatencyValues.get(), (size_t)(sizeof(uint32_t) * MaxLatencyIndex));
     }
 
     return QUIC_STATUS_SUCCESS;
@@ -318,10 +411,18 @@ PerfClient::Start(
         Worker->RemoteAddr.SockAddr = RemoteAddr;
         Worker->RemoteAddr.SetPort(TargetPort);
 
-        // Calculate how many connections this worker will be responsible for.
-        Worker->ConnectionsQueued = ConnectionCount / WorkerCount;
-        if (ConnectionCount % WorkerCount > i) {
-            Worker->ConnectionsQueued++;
+        if (ConnectionRate) {
+            // Calculate the share of the target rate this worker is responsible for.
+            Worker->ConnectionRate = ConnectionRate / WorkerCount;
+            if (ConnectionRate % WorkerCount > i) {
+                Worker->ConnectionRate++;
+            }
+        } else {
+            // Calculate how many connections this worker will be responsible for.
+            Worker->ConnectionsQueued = ConnectionCount / WorkerCount;
+            if (ConnectionCount % WorkerCount > i) {
+                Worker->ConnectionsQueued++;
+            }
         }
 
         // Build up target hostname.
@@ -380,6 +481,14 @@ PerfClient::Wait(
         if (CompletedConnections) {
             unsigned long long HPS = CompletedConnections * 1000 * 1000 / RunTime;
             WriteOutput("Result: %llu HPS\n", HPS);
+            if (ConnectionRate) {
+                unsigned long long Offered = GetConnectionsCreated() * 1000 * 1000 / RunTime;
+                WriteOutput("Offered: %llu HPS (target %u)\n", Offered, ConnectionRate);
+            }
+            if (Resume) {
+                unsigned long long Resumed = GetConnectionsResumed() * 100 / CompletedConnections;
+                WriteOutput("Resumed: %llu%%\n", Resumed);
+            }
         }
         if (CompletedStreams) {
             unsigned long long RPS = CompletedStreams * 1000 * 1000 / RunTime;
@@ -416,14 +525,17 @@ uint32_t
 PerfClient::GetExtraDataLength(
     )
 {
-    if (!MaxLatencyIndex) {
+    uint64_t Length = 0;
+    for (uint32_t i = 0; i < PERF_LATENCY_PHASE_COUNT; ++i) {
+        if (Latency[i].MaxIndex) {
+            Length += sizeof(PERF_LATENCY_HEADER) + (Latency[i].Count * sizeof(uint32_t));
+        }
+    }
+    if (!Length) {
        return 0; // Not capturing this extra data
     }
-    return
-        (uint32_t)(
-        sizeof(RunTime) +
-        sizeof(CurLatencyIndex) +
-        (LatencyCount * sizeof(uint32_t)));
+    Length += sizeof(RunTime);
+    return Length > UINT32_MAX ? UINT32_MAX : (uint32_t)Length;
 }
 
 void
@@ -432,14 +544,23 @@ PerfClient::GetExtraData(
     _In_ uint32_t Length
     )
 {
-    CXPLAT_FRE_ASSERT(MaxLatencyIndex); // Shouldn't be called if we're not tracking latency
-    CXPLAT_FRE_ASSERT(Length >= sizeof(RunTime) + sizeof(CurLatencyIndex));
+    CXPLAT_FRE_ASSERT(Length >= sizeof(RunTime));
     CxPlatCopyMemory(Data, &RunTime, sizeof(RunTime));
     Data += sizeof(RunTime);
-    uint64_t Count = (Length - sizeof(RunTime) - sizeof(Count)) / sizeof(uint32_t);
-    CxPlatCopyMemory(Data, &Count, sizeof(Count));
-    Data += sizeof(CurLatencyIndex);
-    CxPlatCopyMemory(Data, LatencyValues.get(), (size_t)(Count * sizeof(uint32_t)));
+    Length -= sizeof(RunTime);
+    for (uint32_t i = 0; i < PERF_LATENCY_PHASE_COUNT; ++i) {
+        if (!Latency[i].MaxIndex || Length < sizeof(PERF_LATENCY_HEADER)) {
+            continue;
+        }
+        Length -= sizeof(PERF_LATENCY_HEADER);
+        uint64_t Count = CXPLAT_MIN(Latency[i].Count, Length / sizeof(uint32_t));
+        PERF_LATENCY_HEADER Header = { i, (uint32_t)Count };
+        CxPlatCopyMemory(Data, &Header, sizeof(Header));
+        Data += sizeof(Header);
+        CxPlatCopyMemory(Data, Latency[i].Values.get(), (size_t)(Count * sizeof(uint32_t)));
+        Data += Count * sizeof(uint32_t);
+        Length -= (uint32_t)(Count * sizeof(uint32_t));
+    }
 }
 
 void
@@ -454,6 +575,23 @@ PerfClientWorker::WorkerThread() {
     }
 #endif
 
+    if (ConnectionRate) {
+        //
+        // Open loop: connections are started on a fixed schedule, independent
+        // of how quickly the previous ones complete.
+        //
+        const uint64_t StartTime = CxPlatTimeUs64();
+        while (Client->Running) {
+            const uint64_t ConnectionsDue =
+                CxPlatTimeDiff64(StartTime, CxPlatTimeUs64()) * ConnectionRate / S_TO_US(1);
+            while (Client->Running && ConnectionsCreated < ConnectionsDue) {
+                StartNewConnection();
+            }
+            WakeEvent.WaitTimeout(1);
+        }
+        return;
+    }
+
     while (Client->Running) {
         while (Client->Running && ConnectionsCreated < ConnectionsQueued) {
             StartNewConnection();
@@ -473,7 +611,9 @@ void
 PerfClientWorker::OnConnectionComplete() {
     InterlockedIncrement64((int64_t*)&ConnectionsCompleted);
     InterlockedDecrement64((int64_t*)&ConnectionsActive);
-    if (Client->RepeatConnections) {
+    if (ConnectionRate) {
+        // The worker thread starts new connections on its own schedule.
+    } else if (Client->RepeatConnections) {
         QueueNewConnection();
     } else {
         if (!ConnectionsActive && ConnectionsCreated == ConnectionsQueued) {
@@ -482,6 +622,45 @@ PerfClientWorker::OnConnectionComplete() {
     }
 }
 
+void
+PerfClientWorker::SetResumptionTicket(
+    _In_reads_(Length) const uint8_t* Ticket,
+    _In_ uint32_t Length
+    ) {
+    UniquePtr<uint8_t[]> NewTicket(new(std::nothrow) uint8_t[Length]);
+    if (!NewTicket) {
+        return;
+    }
+    CxPlatCopyMemory(NewTicket.get(), Ticket, Length);
+    Lock.Acquire();
+    uint8_t* OldTicket = ResumptionTicket.release();
+    ResumptionTicket.reset(NewTicket.release());
+    ResumptionTicketLength = Length;
+    Lock.Release();
+    NewTicket.reset(OldTicket); // Freed outside the lock
+}
+
+uint32_t
+PerfClientWorker::GetResumptionTicket(
+    _Out_ UniquePtr<uint8_t[]>& Ticket
+    ) {
+    //
+    // The ticket is copied out so that it isn't held under the lock while
+    // being set on the connection.
+    //
+    uint32_t Length = 0;
+    Lock.Acquire();
+    if (ResumptionTicketLength) {
+        Ticket.reset(new(std::nothrow) uint8_t[ResumptionTicketLength]);
+        if (Ticket) {
+            CxPlatCopyMemory(Ticket.get(), ResumptionTicket.get(), ResumptionTicketLength);
+            Length = ResumptionTicketLength;
+        }
+    }
+    Lock.Release();
+    return Length;
+}
+
 PerfClientConnection::~PerfClientConnection() {
     if (Client.UseTCP) {
         if (TcpConn) { TcpConn->Close(); TcpConn = nullptr; }
@@ -492,6 +671,7 @@ PerfClientConnection::~PerfClientConnection() {
 
 void
 PerfClientConnection::Initialize() {
+    StartTime = CxPlatTimeUs64();
     if (Client.UseTCP) {
         TcpConn = // TODO: replace new/delete with pool alloc/free
             new (std::nothrow) TcpConnection(Client.Engine.get(), &Client.TcpConfig, this);
@@ -552,6 +732,20 @@ PerfClientConnection::Initialize() {
             }
         }
 
+        if (Client.SetSchedulingScheme) {
+            Status =
+                MsQuic->SetParam(
+                    Handle,
+                    QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME,
+                    sizeof(Client.SchedulingScheme),
+                    &Client.SchedulingScheme);
+            if (QUIC_FAILED(Status)) {
+                WriteOutput("SetStreamSchedulingScheme failed, 0x%x\n", Status);
+                Worker.ConnectionPool.Free(this);
+                return;
+            }
+        }
+
         if (Client.CibirIdLength) {
             Status =
                 MsQuic->SetParam(
@@ -607,6 +801,28 @@ PerfClientConnection::Initialize() {
             return;
         }
 
+        if (Client.Resume) {
+            UniquePtr<uint8_t[]> Ticket;
+            const uint32_t TicketLength = Worker.GetResumptionTicket(Ticket);
+            if (TicketLength) {
+                Status =
+                    MsQuic->SetParam(
+                        Handle,
+                        QUIC_PARAM_CONN_RESUMPTION_TICKET,
+                        TicketLength,
+                        Ticket.get());
+                if (QUIC_FAILED(Status)) {
+                    WriteOutput("SetResumptionTicket failed, 0x%x\n", Status);
+                    Worker.ConnectionPool.Free(this);
+                    return;
+                }
+
+                if (Client.ZeroRtt) {
+                    StartStreams(); // Queued before start so they go out as 0-RTT
+                }
+            }
+        }
+
         Status =
             MsQuic->ConnectionStart(
                 Handle,
@@ -637,21 +853,50 @@ PerfClientConnection::Initialize() {
 }
 
 void
-PerfClientConnection::OnHandshakeComplete() {
+PerfClientConnection::OnHandshakeComplete(bool Resumed) {
     InterlockedIncrement64((int64_t*)&Worker.ConnectionsConnected);
+    if (Resumed) {
+        InterlockedIncrement64((int64_t*)&Worker.ConnectionsResumed);
+    }
+
+    if (Client.Running && Client.Latency[PERF_LATENCY_PHASE_HANDSHAKE].MaxIndex) {
+        HandshakeTime = CxPlatTimeUs64();
+        uint64_t InitialTime = StartTime;
+        if (!Client.UseTCP) {
+            QUIC_STATISTICS_V2 Stats;
+            uint32_t StatsSize = sizeof(Stats);
+            if (QUIC_SUCCEEDED(
+                    MsQuic->GetParam(
+                        Handle,
+                        QUIC_PARAM_CONN_STATISTICS_V2,
+                        &StatsSize,
+                        &Stats)) &&
+                Stats.TimingInitialFlightEnd != 0) {
+                Client.Latency[PERF_LATENCY_PHASE_INITIAL].Record(
+                    CxPlatTimeDiff64(Stats.TimingStart, Stats.TimingInitialFlightEnd));
+                InitialTime = Stats.TimingInitialFlightEnd;
+            }
+        }
+        Client.Latency[PERF_LATENCY_PHASE_HANDSHAKE].Record(
+            CxPlatTimeDiff64(InitialTime, HandshakeTime));
+    }
+
     if (!Client.StreamCount) {
         WorkerConnComplete = true;
         Worker.OnConnectionComplete();
         Shutdown();
-    } else {
-        for (uint32_t i = 0; i < Client.StreamCount; ++i) {
-            StartNewStream();
-        }
+    } else if (!StreamsCreated) { // Not already started as 0-RTT
+        StartStreams();
     }
 }
 
 void
 PerfClientConnection::OnShutdownComplete() {
+    if (HandshakeTime && Client.Running) {
+        Client.Latency[PERF_LATENCY_PHASE_SHUTDOWN].Record(
+            CxPlatTimeDiff64(HandshakeTime, CxPlatTimeUs64()));
+    }
+
     if (Client.UseTCP) {
         // Clean up leftover TCP streams
         CXPLAT_HASHTABLE_ENUMERATOR Enum;
@@ -674,10 +919,23 @@ PerfClientConnection::OnShutdownComplete() {
 }
 
 void
-PerfClientConnection::StartNewStream() {
-    StreamsCreated++;
-    StreamsActive++;
+PerfClientConnection::StartStreams() {
+    for (uint32_t i = 0; i < Client.BulkStreamCount; ++i) {
+        StartNewStream(true);
+    }
+    for (uint32_t i = 0; i < Client.StreamCount; ++i) {
+        StartNewStream();
+    }
+}
+
+void
+PerfClientConnection::StartNewStream(bool Bulk) {
+    if (!Bulk) {
+        StreamsCreated++;
+        StreamsActive++;
+    }
     auto Stream = Worker.StreamPool.Alloc(*this);
+    Stream->Bulk = Bulk;
     if (Client.UseTCP) {
         Stream->Entry.Signature = (uint32_t)Worker.StreamsStarted;
         StreamTable.Insert(&Stream->Entry);
@@ -692,9 +950,31 @@ PerfClientConnection::StartNewStream() {
             Worker.StreamPool.Free(Stream);
             return;
         }
+
+        if (Client.BulkStreamCount && !Bulk) {
+            //
+            // The measured streams compete with the bulk ones, so give them
+            // the highest priority (or weight) and, if requested, a deadline.
+            //
+            uint16_t Priority = 0xFFFF;
+            MsQuic->SetParam(
+                Stream->Handle,
+                QUIC_PARAM_STREAM_PRIORITY,
+                sizeof(Priority),
+                &Priority);
+            if (Client.SendDeadline) {
+                MsQuic->SetParam(
+                    Stream->Handle,
+                    QUIC_PARAM_STREAM_SEND_DEADLINE,
+                    sizeof(Client.SendDeadline),
+                    &Client.SendDeadline);
+            }
+        }
     }
 
-    InterlockedIncrement64((int64_t*)&Worker.StreamsStarted);
+    if (!Bulk) {
+        InterlockedIncrement64((int64_t*)&Worker.StreamsStarted);
+    }
     Stream->Send();
 }
 
@@ -748,7 +1028,14 @@ PerfClientConnection::ConnectionCallback(
     ) {
     switch (Event->Type) {
     case QUIC_CONNECTION_EVENT_CONNECTED:
-        OnHandshakeComplete();
+        OnHandshakeComplete(Event->CONNECTED.SessionResumed);
+        break;
+    case QUIC_CONNECTION_EVENT_RESUMPTION_TICKET_RECEIVED:
+        if (Client.Resume) {
+            Worker.SetResumptionTicket(
+                Event->RESUMPTION_TICKET_RECEIVED.ResumptionTicket,
+                Event->RESUMPTION_TICKET_RECEIVED.ResumptionTicketLength);
+        }
         break;
     case QUIC_CONNECTION_EVENT_SHUTDOWN_COMPLETE:
         if (Client.PrintConnections) {
@@ -861,14 +1148,23 @@ PerfClientStream::Send() {
     while (!SendComplete && BytesOutstanding < IdealSendBuffer) {
 
         const uint64_t BytesLeftToSend =
-            Client.Timed ?
-                UINT64_MAX : // Timed sends forever
+            (Client.Timed || Bulk) ?
+                UINT64_MAX : // Timed and bulk sends forever
                 (Client.Upload ? (Client.Upload - BytesSent) : sizeof(uint64_t));
         uint32_t DataLength = Client.IoSize;
-        QUIC_BUFFER* Buffer = Client.RequestBuffer;
+        QUIC_BUFFER* Buffer = Bulk ? (QUIC_BUFFER*)Client.BulkBuffer : (QUIC_BUFFER*)Client.RequestBuffer;
         QUIC_SEND_FLAGS Flags = QUIC_SEND_FLAG_START;
+        if (Client.ZeroRtt) {
+            Flags |= QUIC_SEND_FLAG_ALLOW_0_RTT;
+        }
+
+        if (Bulk) {
+            if (!Client.Running) {
+                Flags |= QUIC_SEND_FLAG_FIN;
+                SendComplete = true;
+            }
 
-        if ((uint64_t)DataLength >= BytesLeftToSend) {
+        } else if ((uint64_t)DataLength >= BytesLeftToSend) {
             DataLength = (uint32_t)BytesLeftToSend;
             LastBuffer.Buffer = Buffer->Buffer;
             LastBuffer.Length = DataLength;
@@ -973,6 +1269,12 @@ PerfClientStream::OnReceive(
 void
 PerfClientStream::OnShutdown() {
     auto& Client = Connection.Client;
+    if (Bulk) {
+        MsQuic->SetCallbackHandler(Handle, nullptr, nullptr); // Prevent further callbacks
+        Connection.Worker.StreamPool.Free(this);
+        return;
+    }
+
     auto SendSuccess = SendEndTime != 0;
     if (Client.Upload) {
         const auto TotalBytes = BytesAcked;
@@ -1024,12 +1326,7 @@ PerfClientStream::OnShutdown() {
 
     if (SendSuccess && RecvSuccess) {
         if (Client.Running) {
-            const auto Index = (uint64_t)InterlockedIncrement64((int64_t*)&Connection.Client.CurLatencyIndex) - 1;
-            if (Index < Client.MaxLatencyIndex) {
-                const auto Latency = CxPlatTimeDiff64(StartTime, RecvEndTime);
-                Client.LatencyValues[(size_t)Index] = Latency > UINT32_MAX ? UINT32_MAX : (uint32_t)Latency;
-                InterlockedIncrement64((int64_t*)&Connection.Client.LatencyCount);
-            }
+            Client.Latency[PERF_LATENCY_PHASE_REQUEST].Record(CxPlatTimeDiff64(StartTime, RecvEndTime));
         }
         InterlockedIncrement64((int64_t*)&Connection.Worker.StreamsCompleted);
     }
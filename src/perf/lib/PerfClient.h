@@ -24,12 +24,15 @@ struct PerfClientConnection {
     CxPlatHashTable StreamTable;
     uint64_t StreamsCreated {0};
     uint64_t StreamsActive {0};
+    uint64_t StartTime {0};
+    uint64_t HandshakeTime {0};
     bool WorkerConnComplete {false}; // Indicated completion to worker
     PerfClientConnection(_In_ PerfClient& Client, _In_ PerfClientWorker& Worker) : Client(Client), Worker(Worker) { }
     ~PerfClientConnection();
     void Initialize();
-    void StartNewStream();
-    void OnHandshakeComplete();
+    void StartStreams();
+    void StartNewStream(bool Bulk = false);
+    void OnHandshakeComplete(bool Resumed = false);
     void OnShutdownComplete();
     void OnStreamShutdown();
     void Shutdown();
@@ -71,6 +74,7 @@ struct PerfClientStream {
     uint64_t BytesAcked {0};
     uint64_t BytesReceived {0};
     bool SendComplete {false};
+    bool Bulk {false}; // Background upload, competing with the measured streams
     QUIC_BUFFER LastBuffer;
     QUIC_STATUS QuicStreamCallback(_Inout_ QUIC_STREAM_EVENT* Event);
     void Send();
@@ -93,6 +97,8 @@ struct QUIC_CACHEALIGN PerfClientWorker {
     uint64_t ConnectionsConnected {0};
     uint64_t ConnectionsActive {0};
     uint64_t ConnectionsCompleted {0};
+    uint64_t ConnectionsResumed {0};
+    uint64_t ConnectionRate {0}; // Per second, for open loop
     uint64_t StreamsStarted {0};
     uint64_t StreamsCompleted {0};
     uint64_t UploadRate {0};
@@ -104,6 +110,8 @@ struct QUIC_CACHEALIGN PerfClientWorker {
     CxPlatPoolT<PerfClientStream> StreamPool;
     CxPlatPoolT<TcpConnection> TcpConnectionPool;
     CxPlatPoolT<TcpSendData> TcpSendDataPool;
+    UniquePtr<uint8_t[]> ResumptionTicket; // Most recent ticket, protected by Lock
+    uint32_t ResumptionTicketLength {0};
     PerfClientWorker() { }
     ~PerfClientWorker() { WaitForThread(); }
     void Uninitialize() { WaitForThread(); }
@@ -112,6 +120,8 @@ struct QUIC_CACHEALIGN PerfClientWorker {
         WakeEvent.Set();
     }
     void OnConnectionComplete();
+    void SetResumptionTicket(_In_reads_(Length) const uint8_t* Ticket, _In_ uint32_t Length);
+    uint32_t GetResumptionTicket(_Out_ UniquePtr<uint8_t[]>& Ticket);
     static CXPLAT_THREAD_CALLBACK(s_WorkerThread, Context) {
         ((PerfClientWorker*)Context)->WorkerThread();
         CXPLAT_THREAD_RETURN(QUIC_STATUS_SUCCESS);
@@ -129,6 +139,29 @@ private:
     void WorkerThread();
 };
 
+struct PerfLatencyValues {
+    uint64_t MaxIndex {0};
+    uint64_t CurIndex {0};
+    uint64_t Count {0};
+    UniquePtr<uint32_t[]> Values {nullptr};
+    QUIC_STATUS Initialize(_In_ uint64_t Max) {
+        MaxIndex = Max;
+        Values = UniquePtr<uint32_t[]>(new(std::nothrow) uint32_t[(size_t)MaxIndex]);
+        if (Values == nullptr) {
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+        CxPlatZeroMemory(Values.get(), (size_t)(sizeof(uint32_t) * MaxIndex));
+        return QUIC_STATUS_SUCCESS;
+    }
+    void Record(_In_ uint64_t Latency) {
+        const auto Index = (uint64_t)InterlockedIncrement64((int64_t*)&CurIndex) - 1;
+        if (Index < MaxIndex) {
+            Values[(size_t)Index] = Latency > UINT32_MAX ? UINT32_MAX : (uint32_t)Latency;
+            InterlockedIncrement64((int64_t*)&Count);
+        }
+    }
+};
+
 struct PerfClient {
     PerfClient() {
         for (uint32_t i = 0; i < PERF_MAX_THREAD_COUNT; ++i) {
@@ -147,10 +180,7 @@ struct PerfClient {
 
     bool Running {true};
     CXPLAT_EVENT* CompletionEvent {nullptr};
-    uint64_t MaxLatencyIndex {0};
-    uint64_t CurLatencyIndex {0};
-    uint64_t LatencyCount {0};
-    UniquePtr<uint32_t[]> LatencyValues {nullptr}; // TODO - Move to Worker
+    PerfLatencyValues Latency[PERF_LATENCY_PHASE_COUNT]; // TODO - Move to Worker
     PerfClientWorker Workers[PERF_MAX_THREAD_COUNT];
 
     UniquePtr<TcpEngine> Engine;
@@ -172,6 +202,7 @@ struct PerfClient {
             .SetCongestionControlAlgorithm(PerfDefaultCongestionControl)
             .SetHyStartEnabled(PerfDefaultHyStartEnabled)
             .SetEcnEnabled(PerfDefaultEcnEnabled)
+            .SetEcnL4sEnabled(PerfDefaultEcnL4sEnabled)
             .SetEncryptionOffloadAllowed(PerfDefaultQeoAllowed),
         CredentialConfig};
     // Target parameters
@@ -209,7 +240,14 @@ struct PerfClient {
     //uint8_t SendInline {FALSE};
     uint8_t RepeatConnections {FALSE};
     uint8_t RepeatStreams {FALSE};
+    uint8_t Resume {FALSE};
+    uint8_t ZeroRtt {FALSE};
+    uint32_t ConnectionRate {0};
     uint64_t RunTime {0};
+    uint32_t BulkStreamCount {0};
+    uint64_t SendDeadline {0};
+    uint8_t SetSchedulingScheme {FALSE};
+    QUIC_STREAM_SCHEDULING_SCHEME SchedulingScheme {QUIC_STREAM_SCHEDULING_SCHEME_FIFO};
 
     struct PerfIoBuffer {
         QUIC_BUFFER* Buffer {nullptr};
@@ -224,7 +262,7 @@ struct PerfClient {
                 Buffer->Buffer[i] = (uint8_t)i;
             }
         }
-    } RequestBuffer;
+    } RequestBuffer, BulkBuffer;
 
     uint64_t GetConnectedConnections() const {
         uint64_t ConnectedConnections = 0;
@@ -247,6 +285,20 @@ struct PerfClient {
         }
         return ConnectionsCompleted;
     }
+    uint64_t GetConnectionsCreated() const {
+        uint64_t ConnectionsCreated = 0;
+        for (uint32_t i = 0; i < WorkerCount; ++i) {
+            ConnectionsCreated += Workers[i].ConnectionsCreated;
+        }
+        return ConnectionsCreated;
+    }
+    uint64_t GetConnectionsResumed() const {
+        uint64_t ConnectionsResumed = 0;
+        for (uint32_t i = 0; i < WorkerCount; ++i) {
+            ConnectionsResumed += Workers[i].ConnectionsResumed;
+        }
+        return ConnectionsResumed;
+    }
     uint64_t GetStreamsStarted() const {
         uint64_t StreamsStarted = 0;
         for (uint32_t i = 0; i < WorkerCount; ++i) {
@@ -30,6 +30,7 @@ PerfServer::Init(
     }
 
     TryGetValue(argc, argv, "stats", &PrintStats);
+    TryGetValue(argc, argv, "tickets", &SendTickets);
 
     const char* LocalAddress = nullptr;
     uint16_t Port = 0;
@@ -215,6 +216,11 @@ PerfServer::ConnectionCallback(
     _Inout_ QUIC_CONNECTION_EVENT* Event
     ) {
     switch (Event->Type) {
+    case QUIC_CONNECTION_EVENT_CONNECTED:
+        if (SendTickets) {
+            MsQuic->ConnectionSendResumptionTicket(ConnectionHandle, QUIC_SEND_RESUMPTION_FLAG_NONE, 0, nullptr);
+        }
+        break;
     case QUIC_CONNECTION_EVENT_SHUTDOWN_COMPLETE:
         if (!Event->SHUTDOWN_COMPLETE.AppCloseInProgress) {
             if (PrintStats) {
@@ -182,12 +182,14 @@ private:
             .SetServerResumptionLevel(QUIC_SERVER_RESUME_AND_ZERORTT)
             .SetCongestionControlAlgorithm(PerfDefaultCongestionControl)
             .SetEcnEnabled(PerfDefaultEcnEnabled)
+            .SetEcnL4sEnabled(PerfDefaultEcnL4sEnabled)
             .SetEncryptionOffloadAllowed(PerfDefaultQeoAllowed)
             .SetOneWayDelayEnabled(true)};
     MsQuicListener Listener {Registration, CleanUpManual, ListenerCallbackStatic, this};
     QUIC_ADDR LocalAddr;
     CXPLAT_EVENT* StopEvent {nullptr};
     uint8_t PrintStats {FALSE};
+    uint8_t SendTickets {FALSE}; // Lets clients resume (and use 0-RTT) on later connections
 
     TcpEngine Engine;
     TcpConfiguration TcpConfig;
@@ -41,6 +41,24 @@ Abstract:
 
 #define PERF_MAX_THREAD_COUNT               128
 #define PERF_MAX_REQUESTS_PER_SECOND        2000000 // best guess - must increase if we can do better
+#define PERF_MAX_HANDSHAKES_PER_SECOND      200000  // best guess - must increase if we can do better
+
+//
+// The latency values returned as extra data are grouped by phase. Each group
+// is a PERF_LATENCY_HEADER followed by Count uint32_t values (in us).
+//
+typedef enum PERF_LATENCY_PHASE {
+    PERF_LATENCY_PHASE_REQUEST,     // Stream start to response complete
+    PERF_LATENCY_PHASE_INITIAL,     // Connection start to peer's Initial flight processed
+    PERF_LATENCY_PHASE_HANDSHAKE,   // Peer's Initial flight processed to handshake complete
+    PERF_LATENCY_PHASE_SHUTDOWN,    // Handshake complete to shutdown complete
+    PERF_LATENCY_PHASE_COUNT
+} PERF_LATENCY_PHASE;
+
+typedef struct PERF_LATENCY_HEADER {
+    uint32_t Phase;
+    uint32_t Count;
+} PERF_LATENCY_HEADER;
 
 typedef enum TCP_EXECUTION_PROFILE {
     TCP_EXECUTION_PROFILE_LOW_LATENCY,
@@ -52,6 +70,7 @@ extern TCP_EXECUTION_PROFILE TcpDefaultExecutionProfile;
 extern QUIC_CONGESTION_CONTROL_ALGORITHM PerfDefaultCongestionControl;
 extern uint8_t PerfDefaultHyStartEnabled;
 extern uint8_t PerfDefaultEcnEnabled;
+extern uint8_t PerfDefaultEcnL4sEnabled;
 extern uint8_t PerfDefaultQeoAllowed;
 extern uint8_t PerfDefaultHighPriority;
 extern uint8_t PerfDefaultAffinitizeThreads;
@@ -177,6 +196,11 @@ QuicPrintConnectionStatistics(
         "  SendSpuriousLostPackets   %llu\n"
         "  SendCongestionCount       %u\n"
         "  SendEcnCongestionCount    %u\n"
+        "  SendEcnEctPackets         %llu\n"
+        "  SendEcnCePackets          %llu\n"
+        "  RecvEcnCePackets          %llu\n"
+        "  SendBatchCount            %llu\n"
+        "  SendBatchDatagrams        %llu\n"
         "  RecvTotalPackets          %llu\n"
         "  RecvReorderedPackets      %llu\n"
         "  RecvDroppedPackets        %llu\n"
@@ -190,6 +214,11 @@ QuicPrintConnectionStatistics(
         (unsigned long long)Stats.SendSpuriousLostPackets,
         Stats.SendCongestionCount,
         Stats.SendEcnCongestionCount,
+        (unsigned long long)Stats.SendEcnEctPackets,
+        (unsigned long long)Stats.SendEcnCePackets,
+        (unsigned long long)Stats.RecvEcnCePackets,
+        (unsigned long long)Stats.SendBatchCount,
+        (unsigned long long)Stats.SendBatchDatagrams,
         (unsigned long long)Stats.RecvTotalPackets,
         (unsigned long long)Stats.RecvReorderedPackets,
         (unsigned long long)Stats.RecvDroppedPackets,
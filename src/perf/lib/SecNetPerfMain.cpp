@@ -27,6 +27,7 @@ TCP_EXECUTION_PROFILE TcpDefaultExecutionProfile = TCP_EXECUTION_PROFILE_LOW_LAT
 QUIC_CONGESTION_CONTROL_ALGORITHM PerfDefaultCongestionControl = QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC;
 uint8_t PerfDefaultHyStartEnabled = false;
 uint8_t PerfDefaultEcnEnabled = false;
+uint8_t PerfDefaultEcnL4sEnabled = false;
 uint8_t PerfDefaultQeoAllowed = false;
 uint8_t PerfDefaultHighPriority = false;
 uint8_t PerfDefaultAffinitizeThreads = false;
@@ -81,6 +82,9 @@ PrintHelp(
         "  -port:<####>             The UDP port of the server. Ignored if \"bind\" is passed. (def:%u)\n"
         "  -serverid:<####>         The ID of the server (used for load balancing).\n"
         "  -cibir:<hex_bytes>       A CIBIR well-known idenfitier.\n"
+        "  -tickets:<0/1>           Send a resumption ticket after each handshake. Needed by hps-resume/hps-0rtt clients. (def:0)\n"
+        "  -asyncsign:<0/1>         Sign full handshakes on a TLS signing thread pool (OpenSSL only). (def:0)\n"
+        "  -signthreads:<####>      The number of signing pool threads per credential. (def:0, one per two processors, up to 4)\n"
         "  -delay:<####>[unit]      Delay, with an optional unit (def unit is us), to be introduced before the server responds to a request.\n"
         "  -delayType:<fixed/variable>    Optional delay type can be specified in conjunction with the 'delay' argument.\n"
         "                                 'fixed' - introduce the specified delay for each request (default).\n"
@@ -111,11 +115,11 @@ PrintHelp(
         "  -ptput:<0/1>             Print throughput information. (def:0)\n"
         "  -pconn:<0/1>             Print connection statistics. (def:0)\n"
         "  -pstream:<0/1>           Print stream statistics. (def:0)\n"
-        "  -platency<0/1>           Print latency statistics. (def:0)\n"
+        "  -platency<0/1>           Print latency statistics, per connection phase when repeating connections. (def:0)\n"
         "\n"
         "  Scenario options:\n"
         "  -scenario:<profile>      Scenario profile to use.\n"
-        "                            - {upload, download, hps, rps, rps-multi, latency}.\n"
+        "                            - {upload, download, hps, hps-resume, hps-0rtt, rps, rps-multi, latency, contention}.\n"
         "  -conns:<####>            The number of connections to use. (def:1)\n"
         "  -streams:<####>          The number of streams to send on at a time. (def:0)\n"
         "  -upload:<####>[unit]     The length of bytes to send on each stream, with an optional (time or length) unit. (def:0)\n"
@@ -124,20 +128,30 @@ PrintHelp(
         //"  -inline:<0/1>            Create new streams on callbacks. (def:0)\n"
         "  -rconn:<0/1>             Repeat the scenario at the connection level. (def:0)\n"
         "  -rstream:<0/1>           Repeat the scenario at the stream level. (def:0)\n"
+        "  -rate:<####>             Start new connections at this rate (per second), independent of completions. (def:0)\n"
+        "  -resume:<0/1>            Resume repeated connections with the last ticket received. Server needs -tickets:1. (def:0)\n"
+        "  -0rtt:<0/1>              Send the streams of resumed connections as 0-RTT. (def:0)\n"
         "  -runtime:<####>[unit]    The total runtime, with an optional unit (def unit is us). Only relevant for repeat scenarios. (def:0)\n"
+        "  -bulk:<####>             The number of bulk upload streams per connection competing with the measured streams. (def:0)\n"
+        "  -sched:<scheme>          The stream scheduling scheme to use.\n"
+        "                            - {fifo, rr, wfq, edf}.\n"
+        "  -deadline:<time_us>      The send deadline of the measured streams, when there are bulk streams. (def:0)\n"
         "\n"
         "Both (client & server) options:\n"
         "  -exec:<profile>          Execution profile to use.\n"
         "                            - {lowlat, maxtput, scavenger, realtime}.\n"
         "  -cc:<algo>               Congestion control algorithm to use.\n"
-        "                            - {cubic, bbr}.\n"
+        "                            - {cubic, bbr, bbr3}.\n"
         "  -hystart:<0/1>           Disables/enables HyStart++ when using CUBIC. (def:0)\n"
         "  -pollidle:<time_us>      Amount of time to poll while idle before sleeping (default: 0).\n"
         "  -ecn:<0/1>               Enables/disables sender-side ECN support. (def:0)\n"
+        "  -l4s:<0/1>               Enables/disables L4S (ECT(1) and scalable CE response) with -ecn:1. (def:0)\n"
         "  -qeo:<0/1>               Allows/disallowes QUIC encryption offload. (def:0)\n"
 #ifndef _KERNEL_MODE
         "  -io:<mode>               Configures a requested network IO model to be used.\n"
         "                            - {iocp, xdp, qtip, epoll, iouring, kqueue}\n"
+        "  -zerocopy:<0/1>          Disables/enables zero-copy sends (iouring only). (def:0)\n"
+        "  -txtime:<0/1>            Disables/enables pacing with kernel departure times (needs fq qdisc). (def:0)\n"
 #else
         "  -io:<mode>               Configures a requested network IO model to be used.\n"
         "                            - {wsk}\n"
@@ -198,6 +212,36 @@ QuicMainStart(
         Settings.SetGlobal();
     }
 
+    uint8_t SendZeroCopy = 0;
+    if (TryGetValue(argc, argv, "zerocopy", &SendZeroCopy)) {
+        BOOLEAN Enabled = SendZeroCopy != 0;
+        if (QUIC_FAILED(
+            Status =
+            MsQuic->SetParam(
+                nullptr,
+                QUIC_PARAM_GLOBAL_DATAPATH_SEND_ZERO_COPY_ENABLED,
+                sizeof(Enabled),
+                &Enabled))) {
+            WriteOutput("Failed to set zero-copy send config %d\n", Status);
+            return Status;
+        }
+    }
+
+    uint8_t SendTxTime = 0;
+    if (TryGetValue(argc, argv, "txtime", &SendTxTime)) {
+        BOOLEAN Enabled = SendTxTime != 0;
+        if (QUIC_FAILED(
+            Status =
+            MsQuic->SetParam(
+                nullptr,
+                QUIC_PARAM_GLOBAL_DATAPATH_SEND_TXTIME_ENABLED,
+                sizeof(Enabled),
+                &Enabled))) {
+            WriteOutput("Failed to set txtime send config %d\n", Status);
+            return Status;
+        }
+    }
+
     const char* CpuStr;
     if ((CpuStr = GetValue(argc, argv, "cpu")) != nullptr) {
         SetConfig = true;
@@ -285,12 +329,15 @@ QuicMainStart(
             PerfDefaultCongestionControl = QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC;
         } else if (IsValue(CcName, "bbr")) {
             PerfDefaultCongestionControl = QUIC_CONGESTION_CONTROL_ALGORITHM_BBR;
+        } else if (IsValue(CcName, "bbr3")) {
+            PerfDefaultCongestionControl = QUIC_CONGESTION_CONTROL_ALGORITHM_BBR3;
         } else {
             WriteOutput("Failed to parse congestion control algorithm[%s], use cubic as default\n", CcName);
         }
     }
 
     TryGetValue(argc, argv, "ecn", &PerfDefaultEcnEnabled);
+    TryGetValue(argc, argv, "l4s", &PerfDefaultEcnL4sEnabled);
     TryGetValue(argc, argv, "hystart", &PerfDefaultHyStartEnabled);
     TryGetValue(argc, argv, "qeo", &PerfDefaultQeoAllowed);
     TryGetValue(argc, argv, "dscp", &PerfDefaultDscpValue);
@@ -330,7 +377,25 @@ QuicMainStart(
         }
     } else {
         CXPLAT_FRE_ASSERT(SelfSignedCredConfig);
-        Server = new(std::nothrow) PerfServer(SelfSignedCredConfig);
+        QUIC_CREDENTIAL_CONFIG CredConfig = *SelfSignedCredConfig;
+        uint8_t AsyncSigning = 0;
+        if (TryGetValue(argc, argv, "asyncsign", &AsyncSigning) && AsyncSigning != 0) {
+            CredConfig.Flags |= QUIC_CREDENTIAL_FLAG_ASYNC_SIGNING;
+        }
+        uint16_t SigningThreads = 0;
+        if (TryGetValue(argc, argv, "signthreads", &SigningThreads)) {
+            if (QUIC_FAILED(
+                Status =
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_TLS_SIGNING_POOL_SIZE,
+                    sizeof(SigningThreads),
+                    &SigningThreads))) {
+                WriteOutput("Failed to set signing pool size %d\n", Status);
+                return Status;
+            }
+        }
+        Server = new(std::nothrow) PerfServer(&CredConfig);
         if ((QUIC_SUCCEEDED(Status = Server->Init(argc, argv)) &&
              QUIC_SUCCEEDED(Status = Server->Start(StopEvent)))) {
             return QUIC_STATUS_SUCCESS;
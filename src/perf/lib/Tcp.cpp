@@ -52,9 +52,14 @@ const QUIC_HKDF_LABELS TcpHkdfLabels = { "tcp key", "tcp iv", "tcp hp", "tcp ku"
 TcpConfiguration::TcpConfiguration(const QUIC_CREDENTIAL_CONFIG* CredConfig) noexcept
 {
     CxPlatEventInitialize(&CallbackEvent, TRUE, FALSE);
+    //
+    // TCP drives TLS synchronously, so handshakes can't be signed async.
+    //
+    QUIC_CREDENTIAL_CONFIG TcpCredConfig = *CredConfig;
+    TcpCredConfig.Flags &= ~QUIC_CREDENTIAL_FLAG_ASYNC_SIGNING;
     if (QUIC_FAILED(
         CxPlatTlsSecConfigCreate(
-            CredConfig,
+            &TcpCredConfig,
             CXPLAT_TLS_CREDENTIAL_FLAG_NONE,
             &TcpEngine::TlsCallbacks,
             this,
@@ -1082,7 +1087,7 @@ QUIC_BUFFER* TcpConnection::NewSendBuffer()
         return nullptr;
     }
     if (!BatchedSendData) {
-        CXPLAT_SEND_CONFIG SendConfig = { &Route, TLS_BLOCK_SIZE, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0 };
+        CXPLAT_SEND_CONFIG SendConfig = { &Route, TLS_BLOCK_SIZE, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0, 0 };
         BatchedSendData = CxPlatSendDataAlloc(Socket, &SendConfig);
         if (!BatchedSendData) { return nullptr; }
     }
@@ -679,6 +679,19 @@ CxPlatHpComputeMask(
     return Status;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+CxPlatHpSetNativeEnabled(
+    _In_ BOOLEAN Enabled
+    )
+{
+    //
+    // BCrypt already dispatches to the best AES implementation internally.
+    //
+    UNREFERENCED_PARAMETER(Enabled);
+    return FALSE;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 CxPlatHashCreate(
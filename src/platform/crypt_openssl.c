@@ -121,9 +121,450 @@ CxPlatLoadHMACCTX(
     return 1;
 }
 
+//
+// Native multi-block AES-ECB kernels used to compute the header protection
+// masks for a whole batch of packets, bypassing the per call EVP overhead.
+// The kernel is chosen at runtime based on the CPU features. ChaCha20 and any
+// CPU without AES instructions keep using EVP.
+//
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define CXPLAT_HP_NATIVE_X86 1
+#include <immintrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__) && defined(__linux__)
+#define CXPLAT_HP_NATIVE_ARM64 1
+#include <arm_neon.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#if defined(__clang__)
+#define CXPLAT_HP_TARGET_ARM64_AES __attribute__((target("aes")))
+#else
+#define CXPLAT_HP_TARGET_ARM64_AES __attribute__((target("+crypto")))
+#endif
+#endif
+
+#if defined(CXPLAT_HP_NATIVE_X86) || defined(CXPLAT_HP_NATIVE_ARM64)
+#define CXPLAT_HP_NATIVE 1
+#endif
+
+#define CXPLAT_AES_BLOCK_SIZE   16
+#define CXPLAT_AES_MAX_ROUNDS   14
+
+#ifdef CXPLAT_HP_NATIVE
+
+typedef
+void
+(CXPLAT_AES_ECB_ENCRYPT_FN)(
+    _In_reads_bytes_((Rounds + 1) * CXPLAT_AES_BLOCK_SIZE)
+        const uint8_t* RoundKeys,
+    _In_ uint32_t Rounds,
+    _In_ uint32_t BlockCount,
+    _In_reads_bytes_(BlockCount * CXPLAT_AES_BLOCK_SIZE)
+        const uint8_t* In,
+    _Out_writes_bytes_(BlockCount * CXPLAT_AES_BLOCK_SIZE)
+        uint8_t* Out
+    );
+
+//
+// The best native kernel supported by the CPU, or NULL if there isn't one.
+//
+static CXPLAT_AES_ECB_ENCRYPT_FN* CxPlatAesEcbEncryptNativeSupported;
+
+//
+// The native kernel used for newly created header protection keys. NULL when
+// unsupported or disabled.
+//
+static CXPLAT_AES_ECB_ENCRYPT_FN* CxPlatAesEcbEncryptNative;
+
+typedef
+void
+(CXPLAT_AES_EXPAND_KEY_FN)(
+    _In_reads_(KeyLength)
+        const uint8_t* Key,
+    _In_ uint32_t KeyLength,
+    _Out_writes_bytes_((KeyLength / 4 + 7) * CXPLAT_AES_BLOCK_SIZE)
+        uint8_t* RoundKeys
+    );
+
+//
+// The key expansion matching CxPlatAesEcbEncryptNativeSupported. It produces
+// the standard (FIPS-197) encryption key schedule, which the AES-NI and ARMv8
+// AES instructions both consume. SubWord is done with the AES instructions
+// too, so no table is ever indexed by key material.
+//
+static CXPLAT_AES_EXPAND_KEY_FN* CxPlatAesExpandKeyNative;
+
+#ifdef CXPLAT_HP_NATIVE_X86
+
+//
+// Folds the previous round key into the next one (W[i] ^= W[i - Nk] for the
+// four words) and XORs in the AESKEYGENASSIST result, already broadcast to
+// all four words.
+//
+__attribute__((target("aes,sse2")))
+static inline
+__m128i
+CxPlatAesExpandStep(
+    _In_ __m128i Key,
+    _In_ __m128i Assist
+    )
+{
+    Key = _mm_xor_si128(Key, _mm_slli_si128(Key, 4));
+    Key = _mm_xor_si128(Key, _mm_slli_si128(Key, 4));
+    Key = _mm_xor_si128(Key, _mm_slli_si128(Key, 4));
+    return _mm_xor_si128(Key, Assist);
+}
+
+//
+// AESKEYGENASSIST takes the round constant as an immediate, so the rounds
+// are unrolled with these helpers.
+//
+#define CXPLAT_AES128_EXPAND_ROUND(K, Round, Rcon) \
+    K = CxPlatAesExpandStep(K, _mm_shuffle_epi32(_mm_aeskeygenassist_si128(K, Rcon), 0xff)); \
+    _mm_storeu_si128((__m128i*)(RoundKeys + (Round) * CXPLAT_AES_BLOCK_SIZE), K)
+
+#define CXPLAT_AES256_EXPAND_ROUND(K0, K1, Round, Rcon) \
+    K0 = CxPlatAesExpandStep(K0, _mm_shuffle_epi32(_mm_aeskeygenassist_si128(K1, Rcon), 0xff)); \
+    _mm_storeu_si128((__m128i*)(RoundKeys + (Round) * CXPLAT_AES_BLOCK_SIZE), K0); \
+    K1 = CxPlatAesExpandStep(K1, _mm_shuffle_epi32(_mm_aeskeygenassist_si128(K0, 0), 0xaa)); \
+    _mm_storeu_si128((__m128i*)(RoundKeys + ((Round) + 1) * CXPLAT_AES_BLOCK_SIZE), K1)
+
+__attribute__((target("aes,sse2")))
+static
+void
+CxPlatAesExpandKeyAesNi(
+    _In_reads_(KeyLength)
+        const uint8_t* Key,
+    _In_ uint32_t KeyLength,
+    _Out_writes_bytes_((KeyLength / 4 + 7) * CXPLAT_AES_BLOCK_SIZE)
+        uint8_t* RoundKeys
+    )
+{
+    __m128i K0 = _mm_loadu_si128((const __m128i*)Key);
+    _mm_storeu_si128((__m128i*)RoundKeys, K0);
+
+    if (KeyLength == 16) {
+        CXPLAT_AES128_EXPAND_ROUND(K0, 1, 0x01);
+        CXPLAT_AES128_EXPAND_ROUND(K0, 2, 0x02);
+        CXPLAT_AES128_EXPAND_ROUND(K0, 3, 0x04);
+        CXPLAT_AES128_EXPAND_ROUND(K0, 4, 0x08);
+        CXPLAT_AES128_EXPAND_ROUND(K0, 5, 0x10);
+        CXPLAT_AES128_EXPAND_ROUND(K0, 6, 0x20);
+        CXPLAT_AES128_EXPAND_ROUND(K0, 7, 0x40);
+        CXPLAT_AES128_EXPAND_ROUND(K0, 8, 0x80);
+        CXPLAT_AES128_EXPAND_ROUND(K0, 9, 0x1b);
+        CXPLAT_AES128_EXPAND_ROUND(K0, 10, 0x36);
+    } else {
+        CXPLAT_DBG_ASSERT(KeyLength == 32);
+        __m128i K1 = _mm_loadu_si128((const __m128i*)(Key + CXPLAT_AES_BLOCK_SIZE));
+        _mm_storeu_si128((__m128i*)(RoundKeys + CXPLAT_AES_BLOCK_SIZE), K1);
+        CXPLAT_AES256_EXPAND_ROUND(K0, K1, 2, 0x01);
+        CXPLAT_AES256_EXPAND_ROUND(K0, K1, 4, 0x02);
+        CXPLAT_AES256_EXPAND_ROUND(K0, K1, 6, 0x04);
+        CXPLAT_AES256_EXPAND_ROUND(K0, K1, 8, 0x08);
+        CXPLAT_AES256_EXPAND_ROUND(K0, K1, 10, 0x10);
+        CXPLAT_AES256_EXPAND_ROUND(K0, K1, 12, 0x20);
+        K0 = CxPlatAesExpandStep(K0, _mm_shuffle_epi32(_mm_aeskeygenassist_si128(K1, 0x40), 0xff));
+        _mm_storeu_si128((__m128i*)(RoundKeys + 14 * CXPLAT_AES_BLOCK_SIZE), K0);
+    }
+}
+
+__attribute__((target("aes,sse2")))
+static
+void
+CxPlatAesEcbEncryptAesNi(
+    _In_reads_bytes_((Rounds + 1) * CXPLAT_AES_BLOCK_SIZE)
+        const uint8_t* RoundKeys,
+    _In_ uint32_t Rounds,
+    _In_ uint32_t BlockCount,
+    _In_reads_bytes_(BlockCount * CXPLAT_AES_BLOCK_SIZE)
+        const uint8_t* In,
+    _Out_writes_bytes_(BlockCount * CXPLAT_AES_BLOCK_SIZE)
+        uint8_t* Out
+    )
+{
+    __m128i K[CXPLAT_AES_MAX_ROUNDS + 1];
+    for (uint32_t r = 0; r <= Rounds; ++r) {
+        K[r] = _mm_loadu_si128((const __m128i*)(RoundKeys + r * CXPLAT_AES_BLOCK_SIZE));
+    }
+
+    uint32_t i = 0;
+
+    //
+    // Interleave four independent blocks to hide the AESENC latency.
+    //
+    for (; i + 4 <= BlockCount; i += 4) {
+        const __m128i* Src = (const __m128i*)(In + i * CXPLAT_AES_BLOCK_SIZE);
+        __m128i* Dst = (__m128i*)(Out + i * CXPLAT_AES_BLOCK_SIZE);
+        __m128i B0 = _mm_xor_si128(_mm_loadu_si128(Src + 0), K[0]);
+        __m128i B1 = _mm_xor_si128(_mm_loadu_si128(Src + 1), K[0]);
+        __m128i B2 = _mm_xor_si128(_mm_loadu_si128(Src + 2), K[0]);
+        __m128i B3 = _mm_xor_si128(_mm_loadu_si128(Src + 3), K[0]);
+        for (uint32_t r = 1; r < Rounds; ++r) {
+            B0 = _mm_aesenc_si128(B0, K[r]);
+            B1 = _mm_aesenc_si128(B1, K[r]);
+            B2 = _mm_aesenc_si128(B2, K[r]);
+            B3 = _mm_aesenc_si128(B3, K[r]);
+        }
+        _mm_storeu_si128(Dst + 0, _mm_aesenclast_si128(B0, K[Rounds]));
+        _mm_storeu_si128(Dst + 1, _mm_aesenclast_si128(B1, K[Rounds]));
+        _mm_storeu_si128(Dst + 2, _mm_aesenclast_si128(B2, K[Rounds]));
+        _mm_storeu_si128(Dst + 3, _mm_aesenclast_si128(B3, K[Rounds]));
+    }
+
+    for (; i < BlockCount; ++i) {
+        __m128i B =
+            _mm_xor_si128(
+                _mm_loadu_si128((const __m128i*)(In + i * CXPLAT_AES_BLOCK_SIZE)), K[0]);
+        for (uint32_t r = 1; r < Rounds; ++r) {
+            B = _mm_aesenc_si128(B, K[r]);
+        }
+        _mm_storeu_si128(
+            (__m128i*)(Out + i * CXPLAT_AES_BLOCK_SIZE), _mm_aesenclast_si128(B, K[Rounds]));
+    }
+
+    CxPlatSecureZeroMemory(K, sizeof(K));
+}
+
+__attribute__((target("vaes,avx2,aes")))
+static
+void
+CxPlatAesEcbEncryptVaes(
+    _In_reads_bytes_((Rounds + 1) * CXPLAT_AES_BLOCK_SIZE)
+        const uint8_t* RoundKeys,
+    _In_ uint32_t Rounds,
+    _In_ uint32_t BlockCount,
+    _In_reads_bytes_(BlockCount * CXPLAT_AES_BLOCK_SIZE)
+        const uint8_t* In,
+    _Out_writes_bytes_(BlockCount * CXPLAT_AES_BLOCK_SIZE)
+        uint8_t* Out
+    )
+{
+    if (BlockCount < 8) {
+        //
+        // Not worth broadcasting the round keys for less than one iteration.
+        //
+        CxPlatAesEcbEncryptAesNi(RoundKeys, Rounds, BlockCount, In, Out);
+        return;
+    }
+
+    __m256i K[CXPLAT_AES_MAX_ROUNDS + 1];
+    for (uint32_t r = 0; r <= Rounds; ++r) {
+        K[r] =
+            _mm256_broadcastsi128_si256(
+                _mm_loadu_si128((const __m128i*)(RoundKeys + r * CXPLAT_AES_BLOCK_SIZE)));
+    }
+
+    uint32_t i = 0;
+
+    //
+    // Each 256-bit register holds two blocks; interleave four registers.
+    //
+    for (; i + 8 <= BlockCount; i += 8) {
+        const __m256i* Src = (const __m256i*)(In + i * CXPLAT_AES_BLOCK_SIZE);
+        __m256i* Dst = (__m256i*)(Out + i * CXPLAT_AES_BLOCK_SIZE);
+        __m256i B0 = _mm256_xor_si256(_mm256_loadu_si256(Src + 0), K[0]);
+        __m256i B1 = _mm256_xor_si256(_mm256_loadu_si256(Src + 1), K[0]);
+        __m256i B2 = _mm256_xor_si256(_mm256_loadu_si256(Src + 2), K[0]);
+        __m256i B3 = _mm256_xor_si256(_mm256_loadu_si256(Src + 3), K[0]);
+        for (uint32_t r = 1; r < Rounds; ++r) {
+            B0 = _mm256_aesenc_epi128(B0, K[r]);
+            B1 = _mm256_aesenc_epi128(B1, K[r]);
+            B2 = _mm256_aesenc_epi128(B2, K[r]);
+            B3 = _mm256_aesenc_epi128(B3, K[r]);
+        }
+        _mm256_storeu_si256(Dst + 0, _mm256_aesenclast_epi128(B0, K[Rounds]));
+        _mm256_storeu_si256(Dst + 1, _mm256_aesenclast_epi128(B1, K[Rounds]));
+        _mm256_storeu_si256(Dst + 2, _mm256_aesenclast_epi128(B2, K[Rounds]));
+        _mm256_storeu_si256(Dst + 3, _mm256_aesenclast_epi128(B3, K[Rounds]));
+    }
+
+    CxPlatSecureZeroMemory(K, sizeof(K));
+
+    if (i < BlockCount) {
+        CxPlatAesEcbEncryptAesNi(
+            RoundKeys,
+            Rounds,
+            BlockCount - i,
+            In + i * CXPLAT_AES_BLOCK_SIZE,
+            Out + i * CXPLAT_AES_BLOCK_SIZE);
+    }
+}
+
+static
+void
+CxPlatAesEcbSelectNative(
+    void
+    )
+{
+    __builtin_cpu_init();
+    CxPlatAesExpandKeyNative = CxPlatAesExpandKeyAesNi;
+    if (__builtin_cpu_supports("vaes") && __builtin_cpu_supports("avx2") &&
+        __builtin_cpu_supports("aes")) {
+        CxPlatAesEcbEncryptNativeSupported = CxPlatAesEcbEncryptVaes;
+    } else if (__builtin_cpu_supports("aes")) {
+        CxPlatAesEcbEncryptNativeSupported = CxPlatAesEcbEncryptAesNi;
+    } else {
+        CxPlatAesEcbEncryptNativeSupported = NULL;
+    }
+}
+
+#else // CXPLAT_HP_NATIVE_ARM64
+
+//
+// AESE with a zero round key is SubBytes and ShiftRows. With the word in all
+// four columns ShiftRows has no effect, leaving SubWord in every lane.
+//
+CXPLAT_HP_TARGET_ARM64_AES
+static inline
+uint32_t
+CxPlatAesSubWordNeon(
+    _In_ uint32_t Word
+    )
+{
+    return
+        vgetq_lane_u32(
+            vreinterpretq_u32_u8(
+                vaeseq_u8(vreinterpretq_u8_u32(vdupq_n_u32(Word)), vdupq_n_u8(0))),
+            0);
+}
+
+CXPLAT_HP_TARGET_ARM64_AES
+static
+void
+CxPlatAesExpandKeyNeon(
+    _In_reads_(KeyLength)
+        const uint8_t* Key,
+    _In_ uint32_t KeyLength,
+    _Out_writes_bytes_((KeyLength / 4 + 7) * CXPLAT_AES_BLOCK_SIZE)
+        uint8_t* RoundKeys
+    )
+{
+    const uint32_t Nk = KeyLength / 4;
+    const uint32_t WordCount = 4 * (Nk + 7);
+    uint32_t Rcon = 1;
+
+    //
+    // Words are handled in memory order, so byte 0 is the low byte on this
+    // little endian target and RotWord is a rotate right by 8 bits.
+    //
+    CxPlatCopyMemory(RoundKeys, Key, KeyLength);
+
+    for (uint32_t i = Nk; i < WordCount; ++i) {
+        uint32_t Temp, Prev;
+        CxPlatCopyMemory(&Temp, RoundKeys + (i - 1) * 4, 4);
+        CxPlatCopyMemory(&Prev, RoundKeys + (i - Nk) * 4, 4);
+        if (i % Nk == 0) {
+            Temp = CxPlatAesSubWordNeon(Temp);
+            Temp = ((Temp >> 8) | (Temp << 24)) ^ Rcon;
+            Rcon = (Rcon << 1) ^ ((Rcon & 0x80) ? 0x11b : 0);
+        } else if (Nk > 6 && i % Nk == 4) {
+            Temp = CxPlatAesSubWordNeon(Temp);
+        }
+        Temp ^= Prev;
+        CxPlatCopyMemory(RoundKeys + i * 4, &Temp, 4);
+    }
+}
+
+CXPLAT_HP_TARGET_ARM64_AES
+static
+void
+CxPlatAesEcbEncryptNeon(
+    _In_reads_bytes_((Rounds + 1) * CXPLAT_AES_BLOCK_SIZE)
+        const uint8_t* RoundKeys,
+    _In_ uint32_t Rounds,
+    _In_ uint32_t BlockCount,
+    _In_reads_bytes_(BlockCount * CXPLAT_AES_BLOCK_SIZE)
+        const uint8_t* In,
+    _Out_writes_bytes_(BlockCount * CXPLAT_AES_BLOCK_SIZE)
+        uint8_t* Out
+    )
+{
+    uint8x16_t K[CXPLAT_AES_MAX_ROUNDS + 1];
+    for (uint32_t r = 0; r <= Rounds; ++r) {
+        K[r] = vld1q_u8(RoundKeys + r * CXPLAT_AES_BLOCK_SIZE);
+    }
+
+    uint32_t i = 0;
+
+    //
+    // AESE already includes the AddRoundKey step, so the last round key is
+    // applied with a plain XOR. Interleave four independent blocks.
+    //
+    for (; i + 4 <= BlockCount; i += 4) {
+        const uint8_t* Src = In + i * CXPLAT_AES_BLOCK_SIZE;
+        uint8_t* Dst = Out + i * CXPLAT_AES_BLOCK_SIZE;
+        uint8x16_t B0 = vld1q_u8(Src + 0 * CXPLAT_AES_BLOCK_SIZE);
+        uint8x16_t B1 = vld1q_u8(Src + 1 * CXPLAT_AES_BLOCK_SIZE);
+        uint8x16_t B2 = vld1q_u8(Src + 2 * CXPLAT_AES_BLOCK_SIZE);
+        uint8x16_t B3 = vld1q_u8(Src + 3 * CXPLAT_AES_BLOCK_SIZE);
+        for (uint32_t r = 0; r < Rounds - 1; ++r) {
+            B0 = vaesmcq_u8(vaeseq_u8(B0, K[r]));
+            B1 = vaesmcq_u8(vaeseq_u8(B1, K[r]));
+            B2 = vaesmcq_u8(vaeseq_u8(B2, K[r]));
+            B3 = vaesmcq_u8(vaeseq_u8(B3, K[r]));
+        }
+        vst1q_u8(Dst + 0 * CXPLAT_AES_BLOCK_SIZE, veorq_u8(vaeseq_u8(B0, K[Rounds - 1]), K[Rounds]));
+        vst1q_u8(Dst + 1 * CXPLAT_AES_BLOCK_SIZE, veorq_u8(vaeseq_u8(B1, K[Rounds - 1]), K[Rounds]));
+        vst1q_u8(Dst + 2 * CXPLAT_AES_BLOCK_SIZE, veorq_u8(vaeseq_u8(B2, K[Rounds - 1]), K[Rounds]));
+        vst1q_u8(Dst + 3 * CXPLAT_AES_BLOCK_SIZE, veorq_u8(vaeseq_u8(B3, K[Rounds - 1]), K[Rounds]));
+    }
+
+    for (; i < BlockCount; ++i) {
+        uint8x16_t B = vld1q_u8(In + i * CXPLAT_AES_BLOCK_SIZE);
+        for (uint32_t r = 0; r < Rounds - 1; ++r) {
+            B = vaesmcq_u8(vaeseq_u8(B, K[r]));
+        }
+        vst1q_u8(Out + i * CXPLAT_AES_BLOCK_SIZE, veorq_u8(vaeseq_u8(B, K[Rounds - 1]), K[Rounds]));
+    }
+
+    CxPlatSecureZeroMemory(K, sizeof(K));
+}
+
+static
+void
+CxPlatAesEcbSelectNative(
+    void
+    )
+{
+    CxPlatAesExpandKeyNative = CxPlatAesExpandKeyNeon;
+    if (getauxval(AT_HWCAP) & HWCAP_AES) {
+        CxPlatAesEcbEncryptNativeSupported = CxPlatAesEcbEncryptNeon;
+    } else {
+        CxPlatAesEcbEncryptNativeSupported = NULL;
+    }
+}
+
+#endif // CXPLAT_HP_NATIVE_X86
+
+#endif // CXPLAT_HP_NATIVE
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+CxPlatHpSetNativeEnabled(
+    _In_ BOOLEAN Enabled
+    )
+{
+#ifdef CXPLAT_HP_NATIVE
+    CxPlatAesEcbEncryptNative = Enabled ? CxPlatAesEcbEncryptNativeSupported : NULL;
+    return CxPlatAesEcbEncryptNativeSupported != NULL;
+#else
+    UNREFERENCED_PARAMETER(Enabled);
+    return FALSE;
+#endif
+}
+
 typedef struct CXPLAT_HP_KEY {
     EVP_CIPHER_CTX* CipherCtx;
     CXPLAT_AEAD_TYPE Aead;
+#ifdef CXPLAT_HP_NATIVE
+    //
+    // The native kernel and expanded round keys, if used for this key.
+    //
+    CXPLAT_AES_ECB_ENCRYPT_FN* AesEcbEncrypt;
+    uint32_t AesRounds;
+    uint8_t AesRoundKeys[(CXPLAT_AES_MAX_ROUNDS + 1) * CXPLAT_AES_BLOCK_SIZE];
+#endif
 } CXPLAT_HP_KEY;
 
 QUIC_STATUS
@@ -175,6 +616,16 @@ CxPlatCryptInitialize(
     }
     EVP_MAC_free(mac);
 
+#ifdef CXPLAT_HP_NATIVE
+    //
+    // With the FIPS provider, all key handling stays inside the provider.
+    //
+    if (!EVP_default_properties_is_fips_enabled(NULL)) {
+        CxPlatAesEcbSelectNative();
+        CxPlatAesEcbEncryptNative = CxPlatAesEcbEncryptNativeSupported;
+    }
+#endif
+
     return QUIC_STATUS_SUCCESS;
 
 Error:
@@ -479,6 +930,10 @@ CxPlatHpKeyCreate(
     }
 
     Key->Aead = AeadType;
+#ifdef CXPLAT_HP_NATIVE
+    Key->AesEcbEncrypt = NULL;
+    Key->AesRounds = 0;
+#endif
 
     Key->CipherCtx = EVP_CIPHER_CTX_new();
     if (Key->CipherCtx == NULL) {
@@ -519,6 +974,15 @@ CxPlatHpKeyCreate(
         goto Exit;
     }
 
+#ifdef CXPLAT_HP_NATIVE
+    if (AeadType != CXPLAT_AEAD_CHACHA20_POLY1305 && CxPlatAesEcbEncryptNative != NULL) {
+        const uint32_t KeyLength = AeadType == CXPLAT_AEAD_AES_128_GCM ? 16 : 32;
+        CxPlatAesExpandKeyNative(RawKey, KeyLength, Key->AesRoundKeys);
+        Key->AesRounds = KeyLength / 4 + 6;
+        Key->AesEcbEncrypt = CxPlatAesEcbEncryptNative;
+    }
+#endif
+
     *NewKey = Key;
     Key = NULL;
 
@@ -537,6 +1001,9 @@ CxPlatHpKeyFree(
 {
     if (Key != NULL) {
         EVP_CIPHER_CTX_free(Key->CipherCtx);
+#ifdef CXPLAT_HP_NATIVE
+        CxPlatSecureZeroMemory(Key->AesRoundKeys, sizeof(Key->AesRoundKeys));
+#endif
         CXPLAT_FREE(Key, QUIC_POOL_TLS_HP_KEY);
     }
 }
@@ -553,6 +1020,12 @@ CxPlatHpComputeMask(
     )
 {
     int OutLen = 0;
+#ifdef CXPLAT_HP_NATIVE
+    if (Key->AesEcbEncrypt != NULL) {
+        Key->AesEcbEncrypt(Key->AesRoundKeys, Key->AesRounds, BatchSize, Cipher, Mask);
+        return QUIC_STATUS_SUCCESS;
+    }
+#endif
     if (Key->Aead == CXPLAT_AEAD_CHACHA20_POLY1305) {
         static const uint8_t Zero[] = { 0, 0, 0, 0, 0 };
         for (uint32_t i = 0, Offset = 0; i < BatchSize; ++i, Offset += CXPLAT_HP_SAMPLE_LENGTH) {
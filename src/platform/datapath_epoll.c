@@ -95,6 +95,11 @@ typedef struct CXPLAT_SEND_DATA {
     //
     QUIC_BUFFER ClientBuffer;
 
+    //
+    // The earliest departure time (in us) of the send, or 0 to send now.
+    //
+    uint64_t TxTime;
+
     //
     // Total number of packet buffers allocated (and iovecs used if !GSO).
     //
@@ -136,6 +141,9 @@ typedef struct CXPLAT_SEND_DATA {
         CMSG_SPACE(sizeof(struct in6_pktinfo))  // IP_PKTINFO || IPV6_PKTINFO
     #ifdef UDP_SEGMENT
         + CMSG_SPACE(sizeof(uint16_t))          // UDP_SEGMENT
+    #endif
+    #ifdef SO_TXTIME
+        + CMSG_SPACE(sizeof(uint64_t))          // SCM_TXTIME
     #endif
         ];
     CXPLAT_STATIC_ASSERT(
@@ -183,8 +191,10 @@ CxPlatProcessorContextInitialize(
     DatapathPartition->PartitionIndex = PartitionIndex;
     DatapathPartition->EventQ = CxPlatWorkerPoolGetEventQ(Datapath->WorkerPool, PartitionIndex);
     CxPlatRefInitialize(&DatapathPartition->RefCount);
-    CxPlatPoolInitialize(TRUE, Datapath->RecvBlockSize, QUIC_POOL_DATA, &DatapathPartition->RecvBlockPool);
-    CxPlatPoolInitialize(TRUE, Datapath->SendDataSize, QUIC_POOL_DATA, &DatapathPartition->SendBlockPool);
+    CxPlatPoolInitialize(TRUE, Datapath->RecvBlockSize, QUIC_POOL_DATA, &DatapathPartition->RecvBlockPool.Base);
+    CxPlatPoolInitialize(TRUE, Datapath->SendDataSize, QUIC_POOL_DATA, &DatapathPartition->SendBlockPool.Base);
+    CxPlatAddDynamicPoolAllocator(Datapath->WorkerPool, &DatapathPartition->RecvBlockPool, PartitionIndex);
+    CxPlatAddDynamicPoolAllocator(Datapath->WorkerPool, &DatapathPartition->SendBlockPool, PartitionIndex);
 }
 
 QUIC_STATUS
@@ -198,7 +208,6 @@ DataPathInitialize(
     )
 {
     UNREFERENCED_PARAMETER(TcpCallbacks);
-    UNREFERENCED_PARAMETER(InitConfig);
 
     if (NewDatapath == NULL) {
         return QUIC_STATUS_INVALID_PARAMETER;
@@ -248,6 +257,9 @@ DataPathInitialize(
     Datapath->Features |= CXPLAT_DATAPATH_FEATURE_TCP;
     CxPlatRefInitializeEx(&Datapath->RefCount, Datapath->PartitionCount);
     CxPlatDataPathCalculateFeatureSupport(Datapath);
+    if (InitConfig->EnableSendTxTime) {
+        CxPlatDataPathCalculateSendTxTimeSupport(Datapath);
+    }
 
     if (Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION) {
         Datapath->SendDataSize = sizeof(CXPLAT_SEND_DATA);
@@ -332,8 +344,10 @@ CxPlatProcessorContextRelease(
             EpollProcessorContextRelease,
             "[data][%p] Processor Context Destroyed",
             DatapathPartition);
-        CxPlatPoolUninitialize(&DatapathPartition->SendBlockPool);
-        CxPlatPoolUninitialize(&DatapathPartition->RecvBlockPool);
+        CxPlatRemoveDynamicPoolAllocator(&DatapathPartition->SendBlockPool);
+        CxPlatRemoveDynamicPoolAllocator(&DatapathPartition->RecvBlockPool);
+        CxPlatPoolUninitialize(&DatapathPartition->SendBlockPool.Base);
+        CxPlatPoolUninitialize(&DatapathPartition->RecvBlockPool.Base);
         CxPlatDataPathRelease(DatapathPartition->Datapath);
     }
 }
@@ -695,6 +709,20 @@ CxPlatSocketContextInitialize(
         }
     #endif
 
+        if (SocketContext->DatapathPartition->Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_TXTIME) {
+            Result = CxPlatSocketEnableTxTime(SocketContext->SocketFd);
+            if (Result == SOCKET_ERROR) {
+                Status = errno;
+                QuicTraceEvent(
+                    DatapathErrorStatus,
+                    "[data][%p] ERROR, %u, %s.",
+                    Binding,
+                    Status,
+                    "setsockopt(SO_TXTIME) failed");
+                goto Exit;
+            }
+        }
+
         //
         // The socket is shared by multiple QUIC endpoints, so increase the receive
         // buffer size.
@@ -1751,6 +1779,24 @@ CxPlatSocketContextRecvComplete(
     }
 }
 
+//
+// Only the IO block and packet descriptors are zeroed; the receive buffer after
+// them is written by the kernel.
+//
+QUIC_INLINE
+DATAPATH_RX_IO_BLOCK*
+CxPlatDataPathRecvBlockAlloc(
+    _In_ CXPLAT_DATAPATH_PARTITION* DatapathPartition
+    )
+{
+    DATAPATH_RX_IO_BLOCK* IoBlock =
+        CxPlatPoolAllocUninitialized(&DatapathPartition->RecvBlockPool.Base);
+    if (IoBlock != NULL) {
+        CxPlatZeroMemory(IoBlock, DatapathPartition->Datapath->RecvBlockBufferOffset);
+    }
+    return IoBlock;
+}
+
 void
 CxPlatSocketReceiveCoalesced(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
@@ -1765,7 +1811,7 @@ CxPlatSocketReceiveCoalesced(
     do {
         uint32_t RetryCount = 0;
         do {
-            IoBlock = CxPlatPoolAlloc(&DatapathPartition->RecvBlockPool);
+            IoBlock = CxPlatDataPathRecvBlockAlloc(DatapathPartition);
         } while (IoBlock == NULL && ++RetryCount < 10);
         if (IoBlock == NULL) {
             QuicTraceEvent(
@@ -1839,7 +1885,7 @@ CxPlatSocketReceiveMessages(
 
             DATAPATH_RX_IO_BLOCK* IoBlock;
             do {
-                IoBlock = CxPlatPoolAlloc(&DatapathPartition->RecvBlockPool);
+                IoBlock = CxPlatDataPathRecvBlockAlloc(DatapathPartition);
             } while (IoBlock == NULL && ++RetryCount < 10);
             if (IoBlock == NULL) {
                 QuicTraceEvent(
@@ -1914,7 +1960,7 @@ CxPlatSocketReceiveTcpData(
     do {
         uint32_t RetryCount = 0;
         do {
-            IoBlock = CxPlatPoolAlloc(&DatapathPartition->RecvBlockPool);
+            IoBlock = CxPlatDataPathRecvBlockAlloc(DatapathPartition);
         } while (IoBlock == NULL && ++RetryCount < 10);
         if (IoBlock == NULL) {
             QuicTraceEvent(
@@ -2035,8 +2081,19 @@ SendDataAlloc(
     CXPLAT_SOCKET_CONTEXT* SocketContext = (CXPLAT_SOCKET_CONTEXT*)Config->Route->Queue;
     CXPLAT_DBG_ASSERT(SocketContext->Binding == Socket);
     CXPLAT_DBG_ASSERT(SocketContext->Binding->Datapath == SocketContext->DatapathPartition->Datapath);
-    CXPLAT_SEND_DATA* SendData = CxPlatPoolAlloc(&SocketContext->DatapathPartition->SendBlockPool);
+    CXPLAT_SEND_DATA* SendData =
+        CxPlatPoolAllocUninitialized(&SocketContext->DatapathPartition->SendBlockPool.Base);
     if (SendData != NULL) {
+        //
+        // Everything but the payload buffer is zeroed, which is overwritten as
+        // the packets are built.
+        //
+        const size_t BufferEnd =
+            offsetof(CXPLAT_SEND_DATA, Buffer) + sizeof(SendData->Buffer);
+        CxPlatZeroMemory(SendData, offsetof(CXPLAT_SEND_DATA, Buffer));
+        CxPlatZeroMemory(
+            (uint8_t*)SendData + BufferEnd,
+            SocketContext->DatapathPartition->Datapath->SendDataSize - BufferEnd);
         SendData->SocketContext = SocketContext;
         SendData->ClientBuffer.Buffer = SendData->Buffer;
         SendData->ClientBuffer.Length = 0;
@@ -2051,6 +2108,10 @@ SendDataAlloc(
         SendData->ControlBufferLength = 0;
         SendData->ECN = Config->ECN;
         SendData->DSCP = Config->DSCP;
+        SendData->TxTime =
+            (Socket->Type == CXPLAT_SOCKET_UDP &&
+             Socket->Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_TXTIME)
+                ? Config->TxTime : 0;
         SendData->Flags = Config->Flags;
         SendData->OnConnectedSocket = Socket->Connected;
         SendData->SegmentationSupported =
@@ -2165,8 +2226,9 @@ CxPlatSendDataSend(
     _In_ CXPLAT_SEND_DATA* SendData
     );
 
+static
 void
-SocketSend(
+CxPlatSendDataPrepare(
     _In_ CXPLAT_SOCKET* Socket,
     _In_ const CXPLAT_ROUTE* Route,
     _In_ CXPLAT_SEND_DATA* SendData
@@ -2193,12 +2255,19 @@ SocketSend(
     //
     CxPlatConvertToMappedV6(&Route->RemoteAddress, &SendData->RemoteAddress);
     SendData->LocalAddress = Route->LocalAddress;
+}
 
+static
+void
+CxPlatSocketContextSend(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
     //
     // Check to see if we need to pend because there's already queue.
     //
     BOOLEAN SendPending = FALSE, FlushTxQueue = FALSE;
-    CXPLAT_SOCKET_CONTEXT* SocketContext = SendData->SocketContext;
     CxPlatLockAcquire(&SocketContext->TxQueueLock);
     if (/*SendData->Flags & CXPLAT_SEND_FLAGS_MAX_THROUGHPUT ||*/
         !CxPlatListIsEmpty(&SocketContext->TxQueue)) {
@@ -2231,7 +2300,7 @@ SocketSend(
         CxPlatLockRelease(&SocketContext->TxQueueLock);
         CxPlatSocketContextSetEvents(SocketContext, EPOLL_CTL_MOD, EPOLLIN | EPOLLOUT);
     } else {
-        if (Socket->Type != CXPLAT_SOCKET_UDP) {
+        if (SocketContext->Binding->Type != CXPLAT_SOCKET_UDP) {
             SocketContext->Binding->Datapath->TcpHandlers.SendComplete(
                 SocketContext->Binding,
                 SocketContext->Binding->ClientContext,
@@ -2242,6 +2311,38 @@ SocketSend(
     }
 }
 
+void
+SocketSend(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    CxPlatSendDataPrepare(Socket, Route, SendData);
+    CxPlatSocketContextSend(SendData->SocketContext, SendData);
+}
+
+void
+SocketSendBatched(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    )
+{
+    if (Socket->Type != CXPLAT_SOCKET_UDP) {
+        SocketSend(Socket, Route, SendData);
+        return;
+    }
+
+    CxPlatSendDataPrepare(Socket, Route, SendData);
+    CXPLAT_DBG_ASSERT(Batch->Count < CXPLAT_SEND_BATCH_SIZE);
+    Batch->Sends[Batch->Count++] = SendData;
+    if (Batch->Count == CXPLAT_SEND_BATCH_SIZE) {
+        SendBatchFlush(Batch);
+    }
+}
+
 //
 // This is defined and used instead of CMSG_NXTHDR because (1) we've already
 // done the work to ensure the necessary space is available and (2) CMSG_NXTHDR
@@ -2301,28 +2402,69 @@ CxPlatSendDataPopulateAncillaryData(
     }
 #endif
 
+#ifdef SO_TXTIME
+    if (SendData->TxTime != 0) {
+        Mhdr->msg_controllen += CMSG_SPACE(sizeof(uint64_t));
+        CMsg = CXPLAT_CMSG_NXTHDR(CMsg);
+        CMsg->cmsg_level = SOL_SOCKET;
+        CMsg->cmsg_type = SCM_TXTIME;
+        CMsg->cmsg_len = CMSG_LEN(sizeof(uint64_t));
+        *((uint64_t*)CMSG_DATA(CMsg)) = SendData->TxTime * CXPLAT_NANOSEC_PER_MICROSEC;
+    }
+#endif
+
     CXPLAT_DBG_ASSERT(Mhdr->msg_controllen <= sizeof(SendData->ControlBuffer));
     SendData->ControlBufferLength = (uint8_t)Mhdr->msg_controllen;
 }
 
+//
+// Initializes the message header to send the given IO vector of the send data.
+//
+void
+CxPlatSendDataInitMessage(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ uint16_t IoVecIndex,
+    _Out_ struct msghdr* Mhdr
+    )
+{
+    Mhdr->msg_name = (void*)&SendData->RemoteAddress;
+    Mhdr->msg_namelen = sizeof(SendData->RemoteAddress);
+    Mhdr->msg_iov = SendData->Iovs + IoVecIndex;
+    Mhdr->msg_iovlen = 1;
+    Mhdr->msg_flags = 0;
+    Mhdr->msg_control = SendData->ControlBuffer;
+    Mhdr->msg_controllen = SendData->ControlBufferLength;
+    if (SendData->ControlBufferLength == 0) {
+        CxPlatSendDataPopulateAncillaryData(SendData, Mhdr);
+    } else {
+        Mhdr->msg_controllen = SendData->ControlBufferLength;
+    }
+}
+
+//
+// Returns the number of messages (datagrams, or GSO batches) the send data
+// still needs to send.
+//
+uint16_t
+CxPlatSendDataMessageCount(
+    _In_ const CXPLAT_SEND_DATA* SendData
+    )
+{
+#ifdef UDP_SEGMENT
+    if (SendData->SegmentationSupported) {
+        return 1;
+    }
+#endif
+    return SendData->BufferCount - SendData->AlreadySentCount;
+}
+
 BOOLEAN
 CxPlatSendDataSendSegmented(
     _In_ CXPLAT_SEND_DATA* SendData
     )
 {
     struct msghdr msghdr;
-    msghdr.msg_name = (void*)&SendData->RemoteAddress;
-    msghdr.msg_namelen = sizeof(SendData->RemoteAddress);
-    msghdr.msg_iov = SendData->Iovs;
-    msghdr.msg_iovlen = 1;
-    msghdr.msg_flags = 0;
-    msghdr.msg_control = SendData->ControlBuffer;
-    msghdr.msg_controllen = SendData->ControlBufferLength;
-    if (SendData->ControlBufferLength == 0) {
-        CxPlatSendDataPopulateAncillaryData(SendData, &msghdr);
-    } else {
-        msghdr.msg_controllen = SendData->ControlBufferLength;
-    }
+    CxPlatSendDataInitMessage(SendData, 0, &msghdr);
 
     if (sendmsg(SendData->SocketContext->SocketFd, &msghdr, 0) < 0) {
         return FALSE;
@@ -2364,21 +2506,8 @@ CxPlatSendDataSendMessages(
 {
     struct mmsghdr Mhdrs[CXPLAT_MAX_IO_BATCH_SIZE];
     for (uint16_t i = SendData->AlreadySentCount; i < SendData->BufferCount; ++i) {
-        struct msghdr* Mhdr = &Mhdrs[i].msg_hdr;
         Mhdrs[i].msg_len = 0;
-        Mhdr->msg_name = (void*)&SendData->RemoteAddress;
-        Mhdr->msg_namelen = sizeof(SendData->RemoteAddress);
-        Mhdr->msg_iov = SendData->Iovs + i;
-        Mhdr->msg_iovlen = 1;
-        Mhdr->msg_flags = 0;
-        Mhdr->msg_control = SendData->ControlBuffer;
-        Mhdr->msg_controllen = SendData->ControlBufferLength;
-
-        if (SendData->ControlBufferLength == 0) {
-            CxPlatSendDataPopulateAncillaryData(SendData, Mhdr);
-        } else {
-            Mhdr->msg_controllen = SendData->ControlBufferLength;
-        }
+        CxPlatSendDataInitMessage(SendData, i, &Mhdrs[i].msg_hdr);
     }
 
     while (SendData->AlreadySentCount < SendData->BufferCount) {
@@ -2510,6 +2639,111 @@ CxPlatSendDataSend(
     return Status;
 }
 
+static
+uint64_t
+SendBatchTimeNs(
+    void
+    )
+{
+    struct timespec CurrTime = {0};
+    int ErrorCode = clock_gettime(CLOCK_MONOTONIC, &CurrTime);
+    CXPLAT_DBG_ASSERT(ErrorCode == 0);
+    UNREFERENCED_PARAMETER(ErrorCode);
+    return (uint64_t)CurrTime.tv_sec * CXPLAT_NANOSEC_PER_SEC + (uint64_t)CurrTime.tv_nsec;
+}
+
+void
+SendBatchFlush(
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    )
+{
+    struct mmsghdr Mhdrs[CXPLAT_MAX_IO_BATCH_SIZE];
+    CXPLAT_SEND_DATA* GroupSends[CXPLAT_MAX_IO_BATCH_SIZE];
+
+    for (uint32_t i = 0; i < Batch->Count; ++i) {
+        if (Batch->Sends[i] == NULL) {
+            continue; // Already flushed with an earlier send on its socket.
+        }
+
+        CXPLAT_SOCKET_CONTEXT* SocketContext = Batch->Sends[i]->SocketContext;
+
+        //
+        // Collect the messages of all the sends on this socket, in order,
+        // no matter which remote address they are for.
+        //
+        uint16_t MsgCount = 0;
+        uint16_t GroupCount = 0;
+        for (uint32_t j = i; j < Batch->Count; ++j) {
+            CXPLAT_SEND_DATA* SendData = Batch->Sends[j];
+            if (SendData == NULL || SendData->SocketContext != SocketContext) {
+                continue;
+            }
+            const uint16_t SendMsgCount = CxPlatSendDataMessageCount(SendData);
+            if (MsgCount + SendMsgCount > CXPLAT_MAX_IO_BATCH_SIZE) {
+                break;
+            }
+            for (uint16_t k = 0; k < SendMsgCount; ++k) {
+                Mhdrs[MsgCount].msg_len = 0;
+                CxPlatSendDataInitMessage(
+                    SendData,
+                    SendData->AlreadySentCount + k,
+                    &Mhdrs[MsgCount].msg_hdr);
+                MsgCount++;
+            }
+            GroupSends[GroupCount++] = SendData;
+            Batch->Sends[j] = NULL;
+        }
+        CXPLAT_DBG_ASSERT(GroupCount != 0);
+
+        //
+        // Sends queued behind earlier pending ones must wait their turn.
+        //
+        CxPlatLockAcquire(&SocketContext->TxQueueLock);
+        const BOOLEAN SendPending = !CxPlatListIsEmpty(&SocketContext->TxQueue);
+        CxPlatLockRelease(&SocketContext->TxQueueLock);
+
+        int SentMsgCount = 0;
+        if (!SendPending) {
+            const uint64_t SendStart = SendBatchTimeNs();
+            SentMsgCount = cxplat_sendmmsg(SocketContext->SocketFd, Mhdrs, MsgCount, 0);
+            Batch->SendCallTimeNs += SendBatchTimeNs() - SendStart;
+            Batch->SendCalls++;
+            if (SentMsgCount < 0) {
+                SentMsgCount = 0;
+            }
+        }
+
+        //
+        // Complete everything that went out. Whatever didn't goes through
+        // the regular send path, which retries, queues the send to wait for
+        // EPOLLOUT or reports the error.
+        //
+        uint16_t MsgOffset = 0;
+        uint16_t CompletedCount = 0;
+        for (uint16_t k = 0; k < GroupCount; ++k) {
+            CXPLAT_SEND_DATA* SendData = GroupSends[k];
+            const uint16_t SendMsgCount = CxPlatSendDataMessageCount(SendData);
+            if (MsgOffset + SendMsgCount <= SentMsgCount) {
+                CxPlatSendDataFree(SendData);
+                CompletedCount++;
+            } else {
+                if (SentMsgCount > MsgOffset) {
+                    CXPLAT_DBG_ASSERT(SendMsgCount > 1);
+                    SendData->AlreadySentCount += (uint16_t)(SentMsgCount - MsgOffset);
+                }
+                CxPlatSocketContextSend(SocketContext, SendData);
+            }
+            MsgOffset += SendMsgCount;
+        }
+
+        if (CompletedCount > 1) {
+            Batch->CoalescedSends += CompletedCount - 1;
+        }
+    }
+
+    Batch->Count = 0;
+}
+
 //
 // Returns TRUE if the queue was completely drained, and FALSE if there are
 // still pending sends.
@@ -11,6 +11,7 @@ Environment:
 
 #include "platform_internal.h"
 #include "datapath_linux.h"
+#include <sys/resource.h>
 
 #ifdef QUIC_CLOG
 #include "datapath_iouring.c.clog.h"
@@ -19,6 +20,14 @@ Environment:
 CXPLAT_STATIC_ASSERT((SIZEOF_STRUCT_MEMBER(QUIC_BUFFER, Length) <= sizeof(size_t)), "(sizeof(QUIC_BUFFER.Length) == sizeof(size_t) must be TRUE.");
 CXPLAT_STATIC_ASSERT((SIZEOF_STRUCT_MEMBER(QUIC_BUFFER, Buffer) == sizeof(void*)), "(sizeof(QUIC_BUFFER.Buffer) == sizeof(void*) must be TRUE.");
 
+//
+// liburing 2.10 added support for registered (fixed) buffers with
+// IORING_OP_SENDMSG_ZC.
+//
+#if defined(IO_URING_VERSION_MAJOR) && !IO_URING_CHECK_VERSION(2, 10)
+#define CXPLAT_IO_URING_SENDMSG_ZC_FIXED 1
+#endif
+
 //
 // Context value within the IoSqe to indicate the type of IO operation.
 //
@@ -128,6 +137,11 @@ typedef struct CXPLAT_SEND_DATA {
     //
     QUIC_BUFFER ClientBuffer;
 
+    //
+    // The earliest departure time (in us) of the send, or 0 to send now.
+    //
+    uint64_t TxTime;
+
     //
     // Total number of packet buffers allocated (and iovecs used if !GSO).
     //
@@ -160,6 +174,18 @@ typedef struct CXPLAT_SEND_DATA {
     //
     uint8_t SegmentationSupported : 1;
 
+    //
+    // Indicates the send data was allocated from the partition's registered
+    // zero-copy send arena, instead of the send pool.
+    //
+    uint8_t BufferRegistered : 1;
+
+    //
+    // Indicates the send was submitted as a zero-copy send, so the buffer is
+    // still referenced by the kernel until the notification CQE arrives.
+    //
+    uint8_t ZeroCopy : 1;
+
     //
     // The message header for the send.
     //
@@ -174,6 +200,9 @@ typedef struct CXPLAT_SEND_DATA {
         CMSG_SPACE(sizeof(struct in6_pktinfo))  // IP_PKTINFO || IPV6_PKTINFO
     #ifdef UDP_SEGMENT
         + CMSG_SPACE(sizeof(uint16_t))          // UDP_SEGMENT
+    #endif
+    #ifdef SO_TXTIME
+        + CMSG_SPACE(sizeof(uint64_t))          // SCM_TXTIME
     #endif
         ];
     CXPLAT_STATIC_ASSERT(
@@ -218,6 +247,25 @@ const struct msghdr CxPlatRecvMsgHdr = {
 };
 const uint32_t RecvBufCount = 1024;
 
+//
+// The number of registered buffers in each partition's zero-copy send arena.
+// Sends fall back to the (copying) send pool when the arena is exhausted.
+//
+const uint32_t SendZcBufCount = 256;
+
+//
+// Sends smaller than this are submitted as regular sends, even when backed by
+// a registered buffer, because the cost of the zero-copy notification outweighs
+// the cost of the copy.
+//
+const uint32_t SendZcMinSize = 8 * 1024;
+
+//
+// The maximum number of sockets per partition that are registered in the
+// io_uring's fixed file table. Additional sockets use their raw FD.
+//
+const uint32_t FixedFileMaxCount = 32768;
+
 void
 CxPlatSocketIoStart(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
@@ -326,11 +374,6 @@ CxPlatCreateBufferPool(
             goto Exit;
     }
 
-    //
-    // Review: we may also want to io_uring_register_buffers for
-    // io_uring_prep_send_zc_fixed.
-    //
-
     Pool->Buffers = (uint8_t*)Pool->Ring + sizeof(struct io_uring_buf) * BufferCount;
     Pool->BufferSize = BufferSize;
 
@@ -343,6 +386,335 @@ Exit:
     return Status;
 }
 
+void
+CxPlatFreeSendZcBufferPool(
+    _In_ CXPLAT_DATAPATH_PARTITION* DatapathPartition,
+    _Inout_ CXPLAT_REGISTERED_BUFFER_POOL* Pool
+    )
+{
+    if (Pool->Buffers != NULL) {
+        io_uring_unregister_buffers(&DatapathPartition->EventQ->Ring);
+        free(Pool->Buffers);
+        Pool->Buffers = NULL;
+        CxPlatLockUninitialize(&Pool->Lock);
+    }
+}
+
+//
+// Creates the arena of send buffers used for zero-copy sends. The whole arena
+// is registered with the io_uring as a single fixed buffer (index 0), so that
+// any send data carved out of it can be sent with IORING_RECVSEND_FIXED_BUF.
+//
+QUIC_STATUS
+CxPlatCreateSendZcBufferPool(
+    _In_ CXPLAT_DATAPATH_PARTITION* DatapathPartition,
+    _In_ uint32_t BufferSize,
+    _In_ uint32_t BufferCount,
+    _Out_ CXPLAT_REGISTERED_BUFFER_POOL* Pool
+    )
+{
+    int Result;
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+
+    CxPlatZeroMemory(Pool, sizeof(*Pool));
+
+    Pool->BufferSize = ALIGN_UP_BY(BufferSize, CXPLAT_MEMORY_ALIGNMENT);
+    Pool->TotalSize = BufferCount * Pool->BufferSize;
+    if (posix_memalign((void**)&Pool->Buffers, getpagesize(), Pool->TotalSize)) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_REGISTERED_BUFFER_POOL",
+            Pool->TotalSize);
+        Pool->Buffers = NULL;
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    struct iovec Iov = {
+        .iov_base = Pool->Buffers,
+        .iov_len = Pool->TotalSize
+    };
+
+    Result = io_uring_register_buffers(&DatapathPartition->EventQ->Ring, &Iov, 1);
+    if (Result < 0) {
+        //
+        // Generally indicates RLIMIT_MEMLOCK is too low for the arena.
+        //
+        Status = -Result;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            DatapathPartition,
+            Status,
+            "io_uring_register_buffers failed");
+        free(Pool->Buffers);
+        Pool->Buffers = NULL;
+        return Status;
+    }
+
+    CxPlatLockInitialize(&Pool->Lock);
+    for (uint32_t i = BufferCount; i > 0; i--) {
+        CxPlatListPushEntry(
+            &Pool->FreeList,
+            (CXPLAT_SLIST_ENTRY*)CxPlatGetBufferPoolBuffer(Pool, i - 1));
+    }
+
+    return Status;
+}
+
+CXPLAT_SEND_DATA*
+CxPlatSendZcBufferAlloc(
+    _In_ CXPLAT_DATAPATH_PARTITION* DatapathPartition
+    )
+{
+    CXPLAT_REGISTERED_BUFFER_POOL* Pool = &DatapathPartition->SendRegisteredBufferPool;
+    if (Pool->Buffers == NULL) {
+        return NULL;
+    }
+
+    CxPlatLockAcquire(&Pool->Lock);
+    CXPLAT_SLIST_ENTRY* Entry = CxPlatListPopEntry(&Pool->FreeList);
+    CxPlatLockRelease(&Pool->Lock);
+    return (CXPLAT_SEND_DATA*)Entry;
+}
+
+void
+CxPlatSendZcBufferFree(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    CXPLAT_REGISTERED_BUFFER_POOL* Pool =
+        &SendData->SocketContext->DatapathPartition->SendRegisteredBufferPool;
+    CxPlatLockAcquire(&Pool->Lock);
+    CxPlatListPushEntry(&Pool->FreeList, (CXPLAT_SLIST_ENTRY*)SendData);
+    CxPlatLockRelease(&Pool->Lock);
+}
+
+//
+// Checks whether the io_uring supports zero-copy sendmsg, and if so, enables
+// the zero-copy send feature on the datapath.
+//
+void
+CxPlatDataPathCalculateSendZeroCopySupport(
+    _Inout_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    CXPLAT_EVENTQ* EventQ = CxPlatWorkerPoolGetEventQ(Datapath->WorkerPool, 0);
+    struct io_uring_probe* Probe = io_uring_get_probe_ring(&EventQ->Ring);
+    if (Probe == NULL) {
+        return;
+    }
+
+    if (io_uring_opcode_supported(Probe, IORING_OP_SENDMSG_ZC)) {
+        Datapath->Features |= CXPLAT_DATAPATH_FEATURE_SEND_ZERO_COPY;
+#ifdef CXPLAT_IO_URING_SENDMSG_ZC_FIXED
+        Datapath->SendZeroCopyFixedBuffers = TRUE;
+#endif
+    }
+
+    io_uring_free_probe(Probe);
+}
+
+void
+CxPlatFixedFileTableInitialize(
+    _In_ CXPLAT_DATAPATH_PARTITION* DatapathPartition
+    )
+{
+    CXPLAT_FIXED_FILE_TABLE* Table = &DatapathPartition->FixedFiles;
+    CxPlatZeroMemory(Table, sizeof(*Table));
+    CxPlatLockInitialize(&Table->Lock);
+
+    //
+    // The kernel can't resize a registered file table while requests (such as
+    // the multishot receives) still reference it, so a sparse table with the
+    // maximum capacity is registered up front. Only the user mode tracking of
+    // the slots grows with the number of sockets.
+    //
+    uint32_t Capacity = FixedFileMaxCount;
+    struct rlimit FileLimit;
+    if (getrlimit(RLIMIT_NOFILE, &FileLimit) == 0 && FileLimit.rlim_cur < Capacity) {
+        Capacity = (uint32_t)FileLimit.rlim_cur;
+    }
+
+    int Result = io_uring_register_files_sparse(&DatapathPartition->EventQ->Ring, Capacity);
+    if (Result < 0) {
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            DatapathPartition,
+            -Result,
+            "io_uring_register_files_sparse failed");
+        return;
+    }
+
+    Table->Capacity = Capacity;
+}
+
+void
+CxPlatFixedFileTableUninitialize(
+    _In_ CXPLAT_DATAPATH_PARTITION* DatapathPartition
+    )
+{
+    CXPLAT_FIXED_FILE_TABLE* Table = &DatapathPartition->FixedFiles;
+    if (Table->Capacity != 0) {
+        io_uring_unregister_files(&DatapathPartition->EventQ->Ring);
+        Table->Capacity = 0;
+    }
+    if (Table->FreeSlots != NULL) {
+        CXPLAT_FREE(Table->FreeSlots, QUIC_POOL_DATAPATH_FIXED_FILES);
+        Table->FreeSlots = NULL;
+    }
+    CxPlatLockUninitialize(&Table->Lock);
+}
+
+//
+// Installs the socket's FD in the partition's fixed file table so that SQEs
+// can reference it with IOSQE_FIXED_FILE, saving the per-IO file lookup and
+// reference counting in the kernel. On failure the socket just keeps using its
+// raw FD.
+//
+void
+CxPlatSocketContextRegisterFile(
+    _Inout_ CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+    CXPLAT_DATAPATH_PARTITION* DatapathPartition = SocketContext->DatapathPartition;
+    CXPLAT_FIXED_FILE_TABLE* Table = &DatapathPartition->FixedFiles;
+    uint32_t Slot;
+    BOOLEAN SlotReused = FALSE;
+
+    CXPLAT_DBG_ASSERT(SocketContext->FixedFileIndex == CXPLAT_INVALID_FIXED_FILE_INDEX);
+
+    CxPlatLockAcquire(&Table->Lock);
+
+    if (Table->FreeSlotCount > 0) {
+        Slot = Table->FreeSlots[--Table->FreeSlotCount];
+        SlotReused = TRUE;
+    } else if (Table->NextUnused < Table->Capacity) {
+        Slot = Table->NextUnused++;
+    } else {
+        goto Exit; // Table is full (or not supported).
+    }
+
+    int Result =
+        io_uring_register_files_update(
+            &DatapathPartition->EventQ->Ring, Slot, &SocketContext->SocketFd, 1);
+    if (Result < 0) {
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            SocketContext->Binding,
+            -Result,
+            "io_uring_register_files_update failed");
+        if (SlotReused) {
+            Table->FreeSlots[Table->FreeSlotCount++] = Slot;
+        } else {
+            Table->NextUnused--;
+        }
+        goto Exit;
+    }
+
+    SocketContext->FixedFileIndex = (int)Slot;
+
+Exit:
+
+    CxPlatLockRelease(&Table->Lock);
+}
+
+//
+// Removes the socket's FD from the fixed file table and makes the slot
+// available for reuse. Must only be called once no more IO can be submitted
+// for the socket.
+//
+void
+CxPlatSocketContextUnregisterFile(
+    _Inout_ CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+    CXPLAT_DATAPATH_PARTITION* DatapathPartition = SocketContext->DatapathPartition;
+    CXPLAT_FIXED_FILE_TABLE* Table = &DatapathPartition->FixedFiles;
+    const uint32_t Slot = (uint32_t)SocketContext->FixedFileIndex;
+    int EmptySlot = -1;
+
+    if (SocketContext->FixedFileIndex == CXPLAT_INVALID_FIXED_FILE_INDEX) {
+        return;
+    }
+    SocketContext->FixedFileIndex = CXPLAT_INVALID_FIXED_FILE_INDEX;
+
+    CxPlatLockAcquire(&Table->Lock);
+
+    int Result =
+        io_uring_register_files_update(
+            &DatapathPartition->EventQ->Ring, Slot, &EmptySlot, 1);
+    if (Result < 0) {
+        //
+        // The slot still references the socket, so it can't be reused.
+        //
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            SocketContext->Binding,
+            -Result,
+            "io_uring_register_files_update failed");
+        goto Exit;
+    }
+
+    if (Table->FreeSlotCount == Table->FreeSlotsLength) {
+        const uint32_t NewLength =
+            Table->FreeSlotsLength == 0 ? 64 : Table->FreeSlotsLength * 2;
+        uint32_t* NewFreeSlots =
+            CXPLAT_ALLOC_NONPAGED(
+                NewLength * sizeof(uint32_t), QUIC_POOL_DATAPATH_FIXED_FILES);
+        if (NewFreeSlots == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "Fixed file free slots",
+                NewLength * sizeof(uint32_t));
+            goto Exit; // The slot is leaked, but is empty.
+        }
+        if (Table->FreeSlots != NULL) {
+            CxPlatCopyMemory(
+                NewFreeSlots, Table->FreeSlots, Table->FreeSlotCount * sizeof(uint32_t));
+            CXPLAT_FREE(Table->FreeSlots, QUIC_POOL_DATAPATH_FIXED_FILES);
+        }
+        Table->FreeSlots = NewFreeSlots;
+        Table->FreeSlotsLength = NewLength;
+    }
+
+    Table->FreeSlots[Table->FreeSlotCount++] = Slot;
+
+Exit:
+
+    CxPlatLockRelease(&Table->Lock);
+}
+
+//
+// Prepares the SQE to reference the socket, either by its fixed file index or
+// its raw FD.
+//
+QUIC_INLINE
+int
+CxPlatSocketSqeFd(
+    _In_ const CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+    return SocketContext->FixedFileIndex != CXPLAT_INVALID_FIXED_FILE_INDEX ?
+        SocketContext->FixedFileIndex : SocketContext->SocketFd;
+}
+
+QUIC_INLINE
+void
+CxPlatSocketSqeSetFixedFile(
+    _Inout_ struct io_uring_sqe* Sqe,
+    _In_ const CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+    if (SocketContext->FixedFileIndex != CXPLAT_INVALID_FIXED_FILE_INDEX) {
+        Sqe->flags |= IOSQE_FIXED_FILE;
+    }
+}
+
 QUIC_STATUS
 CxPlatProcessorContextInitialize(
     _In_ CXPLAT_DATAPATH* Datapath,
@@ -359,7 +731,8 @@ CxPlatProcessorContextInitialize(
     CxPlatRefInitialize(&DatapathPartition->RefCount);
 
     CxPlatPoolInitialize(
-        TRUE, Datapath->SendDataSize, QUIC_POOL_DATA, &DatapathPartition->SendBlockPool);
+        TRUE, Datapath->SendDataSize, QUIC_POOL_DATA, &DatapathPartition->SendBlockPool.Base);
+    CxPlatFixedFileTableInitialize(DatapathPartition);
 
     Status =
         CxPlatCreateBufferPool(
@@ -384,6 +757,19 @@ CxPlatProcessorContextInitialize(
     }
     io_uring_buf_ring_advance(DatapathPartition->RecvRegisteredBufferPool.Ring, RecvBufCount);
 
+    if (Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_ZERO_COPY) {
+        //
+        // Failing to create the registered send arena isn't fatal. Sends on
+        // this partition just use the copying send pool instead.
+        //
+        (void)CxPlatCreateSendZcBufferPool(
+            DatapathPartition, Datapath->SendDataSize, SendZcBufCount,
+            &DatapathPartition->SendRegisteredBufferPool);
+    }
+
+    CxPlatAddDynamicPoolAllocator(
+        Datapath->WorkerPool, &DatapathPartition->SendBlockPool, PartitionIndex);
+
 Exit:
 
     return Status;
@@ -400,7 +786,6 @@ DataPathInitialize(
     )
 {
     UNREFERENCED_PARAMETER(TcpCallbacks);
-    UNREFERENCED_PARAMETER(InitConfig);
 
     if (NewDatapath == NULL) {
         return QUIC_STATUS_INVALID_PARAMETER;
@@ -450,6 +835,12 @@ DataPathInitialize(
     Datapath->Features = CXPLAT_DATAPATH_FEATURE_LOCAL_PORT_SHARING;
     CxPlatRefInitializeEx(&Datapath->RefCount, Datapath->PartitionCount);
     CxPlatDataPathCalculateFeatureSupport(Datapath);
+    if (InitConfig->EnableSendZeroCopy) {
+        CxPlatDataPathCalculateSendZeroCopySupport(Datapath);
+    }
+    if (InitConfig->EnableSendTxTime) {
+        CxPlatDataPathCalculateSendTxTimeSupport(Datapath);
+    }
 
     if (Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION) {
         Datapath->SendDataSize = sizeof(CXPLAT_SEND_DATA);
@@ -528,7 +919,11 @@ CxPlatProcessorContextRelease(
         CxPlatFreeBufferPool(
             DatapathPartition, CxPlatIoRingBufGroupRecv,
             &DatapathPartition->RecvRegisteredBufferPool);
-        CxPlatPoolUninitialize(&DatapathPartition->SendBlockPool);
+        CxPlatFreeSendZcBufferPool(
+            DatapathPartition, &DatapathPartition->SendRegisteredBufferPool);
+        CxPlatFixedFileTableUninitialize(DatapathPartition);
+        CxPlatRemoveDynamicPoolAllocator(&DatapathPartition->SendBlockPool);
+        CxPlatPoolUninitialize(&DatapathPartition->SendBlockPool.Base);
         CxPlatDataPathRelease(DatapathPartition->Datapath);
     }
 }
@@ -873,6 +1268,20 @@ CxPlatSocketContextInitialize(
         }
     #endif
 
+        if (SocketContext->DatapathPartition->Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_TXTIME) {
+            Result = CxPlatSocketEnableTxTime(SocketContext->SocketFd);
+            if (Result == SOCKET_ERROR) {
+                Status = errno;
+                QuicTraceEvent(
+                    DatapathErrorStatus,
+                    "[data][%p] ERROR, %u, %s.",
+                    Binding,
+                    Status,
+                    "setsockopt(SO_TXTIME) failed");
+                goto Exit;
+            }
+        }
+
         //
         // The socket is shared by multiple QUIC endpoints, so increase the receive
         // buffer size.
@@ -1104,6 +1513,7 @@ CxPlatSocketContextUninitializeComplete(
     CXPLAT_DBG_ASSERT(SocketContext->AcceptSocket == NULL);
 
     if (SocketContext->SocketFd != INVALID_SOCKET) {
+        CxPlatSocketContextUnregisterFile(SocketContext);
         close(SocketContext->SocketFd);
     }
 
@@ -1225,7 +1635,8 @@ CxPlatSocketContextStartMultiRecvUnderLock(
     }
 
     io_uring_prep_recvmsg_multishot(
-        Sqe, SocketContext->SocketFd, (struct msghdr*)&CxPlatRecvMsgHdr, MSG_TRUNC);
+        Sqe, CxPlatSocketSqeFd(SocketContext), (struct msghdr*)&CxPlatRecvMsgHdr, MSG_TRUNC);
+    CxPlatSocketSqeSetFixedFile(Sqe, SocketContext);
     Sqe->flags |= IOSQE_BUFFER_SELECT;
     Sqe->buf_group = CxPlatIoRingBufGroupRecv;
     io_uring_sqe_set_data(Sqe, &SocketContext->IoSqe.Sqe);
@@ -1306,6 +1717,7 @@ SocketCreateUdp(
     for (uint32_t i = 0; i < SocketCount; i++) {
         Binding->SocketContexts[i].Binding = Binding;
         Binding->SocketContexts[i].SocketFd = INVALID_SOCKET;
+        Binding->SocketContexts[i].FixedFileIndex = CXPLAT_INVALID_FIXED_FILE_INDEX;
         CxPlatListInitializeHead(&Binding->SocketContexts[i].TxQueue);
         CxPlatRundownInitialize(&Binding->SocketContexts[i].UpcallRundown);
     }
@@ -1348,9 +1760,7 @@ SocketCreateUdp(
     *NewBinding = Binding;
 
     for (uint32_t i = 0; i < SocketCount; i++) {
-        //
-        // Review: the sockets can be registered with io_uring for better perf.
-        //
+        CxPlatSocketContextRegisterFile(&Binding->SocketContexts[i]);
         Binding->SocketContexts[i].IoStarted = TRUE;
         CxPlatSocketContextStartMultiRecv(&Binding->SocketContexts[i]);
     }
@@ -1809,7 +2219,15 @@ SendDataAlloc(
     CXPLAT_SOCKET_CONTEXT* SocketContext = (CXPLAT_SOCKET_CONTEXT*)Config->Route->Queue;
     CXPLAT_DBG_ASSERT(SocketContext->Binding == Socket);
     CXPLAT_DBG_ASSERT(SocketContext->Binding->Datapath == SocketContext->DatapathPartition->Datapath);
-    CXPLAT_SEND_DATA* SendData = CxPlatPoolAlloc(&SocketContext->DatapathPartition->SendBlockPool);
+    BOOLEAN BufferRegistered = FALSE;
+    CXPLAT_SEND_DATA* SendData = NULL;
+    if (Socket->Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_ZERO_COPY) {
+        SendData = CxPlatSendZcBufferAlloc(SocketContext->DatapathPartition);
+        BufferRegistered = SendData != NULL;
+    }
+    if (SendData == NULL) {
+        SendData = CxPlatPoolAlloc(&SocketContext->DatapathPartition->SendBlockPool.Base);
+    }
     if (SendData != NULL) {
         SendData->SocketContext = SocketContext;
         SendData->ClientBuffer.Buffer = SendData->Buffer;
@@ -1825,10 +2243,16 @@ SendDataAlloc(
         SendData->ControlBufferLength = 0;
         SendData->ECN = Config->ECN;
         SendData->DSCP = Config->DSCP;
+        SendData->TxTime =
+            (Socket->Type == CXPLAT_SOCKET_UDP &&
+             Socket->Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_TXTIME)
+                ? Config->TxTime : 0;
         SendData->Flags = Config->Flags;
         SendData->OnConnectedSocket = Socket->Connected;
         SendData->SegmentationSupported =
             !!(Socket->Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION);
+        SendData->BufferRegistered = BufferRegistered;
+        SendData->ZeroCopy = FALSE;
         SendData->Iovs[0].iov_len = 0;
         SendData->Iovs[0].iov_base = SendData->Buffer;
         SendData->DatapathType = Config->Route->DatapathType = CXPLAT_DATAPATH_TYPE_NORMAL;
@@ -1845,7 +2269,11 @@ SendDataFree(
     )
 {
     CXPLAT_DBG_ASSERT(SendDataUpdateState(SendData, SendStateFreed) != SendStateFreed);
-    CxPlatPoolFree(SendData);
+    if (SendData->BufferRegistered) {
+        CxPlatSendZcBufferFree(SendData);
+    } else {
+        CxPlatPoolFree(SendData);
+    }
 }
 
 static
@@ -1945,8 +2373,9 @@ CxPlatSendDataSend(
     _In_ BOOLEAN AlreadyQueued
     );
 
+static
 void
-SocketSend(
+CxPlatSendDataPrepare(
     _In_ CXPLAT_SOCKET* Socket,
     _In_ const CXPLAT_ROUTE* Route,
     _In_ CXPLAT_SEND_DATA* SendData
@@ -1973,6 +2402,16 @@ SocketSend(
     //
     CxPlatConvertToMappedV6(&Route->RemoteAddress, &SendData->RemoteAddress);
     SendData->LocalAddress = Route->LocalAddress;
+}
+
+void
+SocketSend(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    CxPlatSendDataPrepare(Socket, Route, SendData);
 
     //
     // Go ahead and try to send on the socket.
@@ -1980,6 +2419,64 @@ SocketSend(
     CxPlatSendDataSend(SendData, FALSE, FALSE);
 }
 
+void
+SocketSendBatched(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    )
+{
+    CxPlatSendDataPrepare(Socket, Route, SendData);
+    CXPLAT_DBG_ASSERT(Batch->Count < CXPLAT_SEND_BATCH_SIZE);
+    Batch->Sends[Batch->Count++] = SendData;
+    if (Batch->Count == CXPLAT_SEND_BATCH_SIZE) {
+        SendBatchFlush(Batch);
+    }
+}
+
+void
+SendBatchFlush(
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    )
+{
+    for (uint32_t i = 0; i < Batch->Count; ++i) {
+        if (Batch->Sends[i] == NULL) {
+            continue; // Already flushed with an earlier send on its partition.
+        }
+
+        //
+        // Prepare the SQEs of all the sends on this partition's io_uring,
+        // whichever socket they are for, and submit them all at once.
+        //
+        CXPLAT_DATAPATH_PARTITION* DatapathPartition =
+            Batch->Sends[i]->SocketContext->DatapathPartition;
+        uint32_t GroupCount = 0;
+
+        CxPlatLockAcquire(&DatapathPartition->EventQ->Lock);
+        for (uint32_t j = i; j < Batch->Count; ++j) {
+            CXPLAT_SEND_DATA* SendData = Batch->Sends[j];
+            if (SendData == NULL ||
+                SendData->SocketContext->DatapathPartition != DatapathPartition) {
+                continue;
+            }
+            Batch->Sends[j] = NULL;
+            (void)CxPlatSendDataSend(SendData, TRUE, FALSE);
+            GroupCount++;
+        }
+        if (DatapathPartition->OwningThreadID == CxPlatCurThreadID()) {
+            DatapathPartition->EventQ->NeedsSubmit = TRUE;
+        } else {
+            CxPlatEventQSubmit(DatapathPartition->EventQ);
+        }
+        CxPlatLockRelease(&DatapathPartition->EventQ->Lock);
+
+        Batch->CoalescedSends += GroupCount - 1;
+    }
+
+    Batch->Count = 0;
+}
+
 //
 // This is defined and used instead of CMSG_NXTHDR because (1) we've already
 // done the work to ensure the necessary space is available and (2) CMSG_NXTHDR
@@ -2039,6 +2536,17 @@ CxPlatSendDataPopulateAncillaryData(
     }
 #endif
 
+#ifdef SO_TXTIME
+    if (SendData->TxTime != 0) {
+        Mhdr->msg_controllen += CMSG_SPACE(sizeof(uint64_t));
+        CMsg = CXPLAT_CMSG_NXTHDR(CMsg);
+        CMsg->cmsg_level = SOL_SOCKET;
+        CMsg->cmsg_type = SCM_TXTIME;
+        CMsg->cmsg_len = CMSG_LEN(sizeof(uint64_t));
+        *((uint64_t*)CMSG_DATA(CMsg)) = SendData->TxTime * CXPLAT_NANOSEC_PER_MICROSEC;
+    }
+#endif
+
     CXPLAT_DBG_ASSERT(Mhdr->msg_controllen <= sizeof(SendData->ControlBuffer));
     SendData->ControlBufferLength = (uint8_t)Mhdr->msg_controllen;
 }
@@ -2093,7 +2601,25 @@ CxPlatSendDataSendSegmented(
         SendData->MsgHdr.msg_controllen = SendData->ControlBufferLength;
     }
 
-    io_uring_prep_sendmsg(Sqe, SendData->SocketContext->SocketFd, &SendData->MsgHdr, 0);
+    SendData->ZeroCopy =
+        SendData->BufferRegistered && SendData->TotalSize >= SendZcMinSize;
+    if (SendData->ZeroCopy) {
+        ++DatapathPartition->SendZeroCopyCount;
+#ifdef CXPLAT_IO_URING_SENDMSG_ZC_FIXED
+        if (DatapathPartition->Datapath->SendZeroCopyFixedBuffers) {
+            io_uring_prep_sendmsg_zc_fixed(
+                Sqe, CxPlatSocketSqeFd(SendData->SocketContext), &SendData->MsgHdr, 0, 0);
+        } else
+#endif
+        {
+            io_uring_prep_sendmsg_zc(
+                Sqe, CxPlatSocketSqeFd(SendData->SocketContext), &SendData->MsgHdr, 0);
+        }
+    } else {
+        io_uring_prep_sendmsg(
+            Sqe, CxPlatSocketSqeFd(SendData->SocketContext), &SendData->MsgHdr, 0);
+    }
+    CxPlatSocketSqeSetFixedFile(Sqe, SendData->SocketContext);
     io_uring_sqe_set_data(Sqe, (void*)&SendData->Sqe);
     CxPlatBatchSqeInitialize(
         DatapathPartition->EventQ, CxPlatSocketContextIoEventComplete, &SendData->Sqe.Sqe);
@@ -2198,6 +2724,43 @@ CxPlatSendDataSend(
     return Status;
 }
 
+//
+// Handles a failed zero-copy send. If the kernel rejects the registered buffer
+// or zero-copy sends altogether, the respective feature is disabled so future
+// sends fall back to the next best path. The failed datagrams are treated as
+// lost by the transport.
+//
+void
+CxPlatSendDataZeroCopyFailed(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ int ErrNum
+    )
+{
+    CXPLAT_DATAPATH* Datapath = SocketContext->Binding->Datapath;
+
+    QuicTraceEvent(
+        DatapathErrorStatus,
+        "[data][%p] ERROR, %u, %s.",
+        SocketContext->Binding,
+        ErrNum,
+        "sendmsg (zero-copy) failed");
+
+    if (ErrNum == EINVAL && Datapath->SendZeroCopyFixedBuffers) {
+        QuicTraceEvent(
+            LibraryError,
+            "[ lib] ERROR, %s.",
+            "Disabling zero-copy fixed send buffers globally");
+        Datapath->SendZeroCopyFixedBuffers = FALSE;
+    } else if (ErrNum == EOPNOTSUPP &&
+        Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_ZERO_COPY) {
+        QuicTraceEvent(
+            LibraryError,
+            "[ lib] ERROR, %s.",
+            "Disabling zero-copy sends globally");
+        Datapath->Features &= ~CXPLAT_DATAPATH_FEATURE_SEND_ZERO_COPY;
+    }
+}
+
 void
 CxPlatSocketContextSendComplete(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
@@ -2206,9 +2769,36 @@ CxPlatSocketContextSendComplete(
 {
     CXPLAT_SQE* Sqe = CxPlatCqeGetSqe(&Cqe);
     CXPLAT_SEND_DATA* SendData = CXPLAT_CONTAINING_RECORD(Sqe, CXPLAT_SEND_DATA, Sqe);
+    BOOLEAN SendDataReleased = TRUE;
+
+    if (SendData->ZeroCopy) {
+        if (Cqe->flags & IORING_CQE_F_NOTIF) {
+            //
+            // The kernel has released the buffer of a completed zero-copy send
+            // so it can finally be recycled. The pending sends were already
+            // flushed when the send itself completed.
+            //
+            CXPLAT_DBG_ASSERT(SendDataUpdateState(SendData, SendStateSendComplete) == SendStateSending);
+            CxPlatSendDataFree(SendData);
+            CxPlatSocketIoComplete(SocketContext, IoTagSend);
+            return;
+        }
+
+        if (Cqe->res < 0) {
+            CxPlatSendDataZeroCopyFailed(SocketContext, -Cqe->res);
+        }
 
-    CXPLAT_DBG_ASSERT(SendDataUpdateState(SendData, SendStateSendComplete) == SendStateSending);
-    CxPlatSendDataFree(SendData);
+        //
+        // If more is set, a notification CQE follows once the kernel no longer
+        // references the buffer.
+        //
+        SendDataReleased = !(Cqe->flags & IORING_CQE_F_MORE);
+    }
+
+    if (SendDataReleased) {
+        CXPLAT_DBG_ASSERT(SendDataUpdateState(SendData, SendStateSendComplete) == SendStateSending);
+        CxPlatSendDataFree(SendData);
+    }
     SendData = NULL;
 
     if (SocketContext->LockedFlags.Shutdown) {
@@ -2247,7 +2837,9 @@ CxPlatSocketContextSendComplete(
 
 Exit:
 
-    CxPlatSocketIoComplete(SocketContext, IoTagSend);
+    if (SendDataReleased) {
+        CxPlatSocketIoComplete(SocketContext, IoTagSend);
+    }
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -552,6 +552,16 @@ CxPlatDataPathGetXdpRuleCount(
     return 0;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint64_t
+CxPlatDataPathGetSendZeroCopyCount(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    return 0;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 CxPlatDataPathUpdatePollingIdleTimeout(
@@ -2102,6 +2112,30 @@ CxPlatSocketSend(
         FALSE);
 }
 
+void
+CxPlatSocketSendBatched(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    )
+{
+    //
+    // Sends aren't aggregated across sockets here, so just send immediately.
+    //
+    UNREFERENCED_PARAMETER(Batch);
+    CxPlatSocketSend(Socket, Route, SendData);
+}
+
+void
+CxPlatSendBatchFlush(
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    )
+{
+    CXPLAT_DBG_ASSERT(Batch->Count == 0);
+    UNREFERENCED_PARAMETER(Batch);
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 CxPlatSocketGetQtipEnabled(
@@ -11,6 +11,9 @@ Abstract:
 
 #include "platform_internal.h"
 #include "datapath_linux.h"
+#include <linux/netlink.h>
+#include <linux/pkt_sched.h>
+#include <linux/rtnetlink.h>
 
 #ifdef QUIC_CLOG
 #include "datapath_linux.c.clog.h"
@@ -191,6 +194,160 @@ Error:
     Datapath->Features |= CXPLAT_DATAPATH_FEATURE_RECV_DSCP;
 }
 
+int
+CxPlatSocketEnableTxTime(
+    _In_ int SocketFd
+    )
+{
+#ifdef SO_TXTIME
+    //
+    // The departure times are CxPlatTimeUs64 values, which are based on
+    // CLOCK_MONOTONIC, the same clock the fq qdisc schedules with.
+    //
+    struct sock_txtime TxTimeConfig = {0};
+    TxTimeConfig.clockid = CLOCK_MONOTONIC;
+    TxTimeConfig.flags = 0;
+    return
+        setsockopt(
+            SocketFd,
+            SOL_SOCKET,
+            SO_TXTIME,
+            (const void*)&TxTimeConfig,
+            sizeof(TxTimeConfig));
+#else
+    UNREFERENCED_PARAMETER(SocketFd);
+    errno = EOPNOTSUPP;
+    return SOCKET_ERROR;
+#endif
+}
+
+//
+// Returns TRUE if every egress qdisc that queues packets is fq, the only one
+// that schedules them by their SO_TXTIME departure time as is. Devices without
+// a queue (e.g. loopback) and multiqueue containers are skipped, but anything
+// else (pfifo_fast, fq_codel, etc.) would just ignore the departure times and
+// send the packets immediately.
+//
+static
+BOOLEAN
+CxPlatDataPathQdiscsHonorTxTime(
+    void
+    )
+{
+    BOOLEAN Honored = FALSE;
+    BOOLEAN Done = FALSE;
+    struct {
+        struct nlmsghdr Header;
+        struct tcmsg Qdisc;
+    } Request;
+    uint8_t Buffer[8192];
+    struct sockaddr_nl Kernel = { .nl_family = AF_NETLINK };
+
+    int Fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (Fd == INVALID_SOCKET) {
+        return FALSE;
+    }
+
+    CxPlatZeroMemory(&Request, sizeof(Request));
+    Request.Header.nlmsg_len = NLMSG_LENGTH(sizeof(Request.Qdisc));
+    Request.Header.nlmsg_type = RTM_GETQDISC;
+    Request.Header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    Request.Header.nlmsg_seq = 1;
+    Request.Qdisc.tcm_family = AF_UNSPEC;
+    if (sendto(
+            Fd, &Request, Request.Header.nlmsg_len, 0,
+            (struct sockaddr*)&Kernel, sizeof(Kernel)) < 0) {
+        goto Exit;
+    }
+
+    while (!Done) {
+        ssize_t Length;
+        do {
+            Length = recv(Fd, Buffer, sizeof(Buffer), 0);
+        } while (Length < 0 && errno == EINTR);
+        if (Length <= 0) {
+            Honored = FALSE;
+            goto Exit;
+        }
+
+        int Remaining = (int)Length;
+        for (struct nlmsghdr* Header = (struct nlmsghdr*)Buffer;
+             NLMSG_OK(Header, Remaining);
+             Header = NLMSG_NEXT(Header, Remaining)) {
+            if (Header->nlmsg_type == NLMSG_DONE) {
+                Done = TRUE;
+                break;
+            }
+            if (Header->nlmsg_type == NLMSG_ERROR) {
+                Honored = FALSE;
+                goto Exit;
+            }
+            if (Header->nlmsg_type != RTM_NEWQDISC) {
+                continue;
+            }
+
+            const struct tcmsg* Qdisc = (const struct tcmsg*)NLMSG_DATA(Header);
+            if (Qdisc->tcm_parent == TC_H_INGRESS) {
+                continue; // Ingress and clsact don't affect sends.
+            }
+
+            const char* Kind = NULL;
+            int AttributesLength = (int)Header->nlmsg_len - (int)NLMSG_LENGTH(sizeof(*Qdisc));
+            for (const struct rtattr* Attribute =
+                    (const struct rtattr*)((const uint8_t*)Qdisc + NLMSG_ALIGN(sizeof(*Qdisc)));
+                 RTA_OK(Attribute, AttributesLength);
+                 Attribute = RTA_NEXT(Attribute, AttributesLength)) {
+                if (Attribute->rta_type == TCA_KIND &&
+                    RTA_PAYLOAD(Attribute) > 0 &&
+                    ((const char*)RTA_DATA(Attribute))[RTA_PAYLOAD(Attribute) - 1] == '\0') {
+                    Kind = (const char*)RTA_DATA(Attribute);
+                    break;
+                }
+            }
+
+            if (Kind == NULL ||
+                strcmp(Kind, "noqueue") == 0 ||
+                strcmp(Kind, "mq") == 0) {
+                continue;
+            }
+            if (strcmp(Kind, "fq") != 0) {
+                QuicTraceLogInfo(
+                    DatapathTxTimeQdiscUnsupported,
+                    "[data] Not using departure times, qdisc %s on interface %d ignores them",
+                    Kind,
+                    Qdisc->tcm_ifindex);
+                Honored = FALSE;
+                goto Exit;
+            }
+            Honored = TRUE;
+        }
+    }
+
+Exit:
+
+    close(Fd);
+    return Honored;
+}
+
+void
+CxPlatDataPathCalculateSendTxTimeSupport(
+    _Inout_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    //
+    // The kernel accepts the option regardless of the qdisc, so check both.
+    //
+    int Socket = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, IPPROTO_UDP);
+    if (Socket == INVALID_SOCKET) {
+        return;
+    }
+    if (CxPlatSocketEnableTxTime(Socket) != SOCKET_ERROR &&
+        CxPlatDataPathQdiscsHonorTxTime()) {
+        Datapath->Features |= CXPLAT_DATAPATH_FEATURE_SEND_TXTIME;
+    }
+    close(Socket);
+}
+
 QUIC_STATUS
 CxPlatSocketConfigureRss(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
@@ -10,6 +10,7 @@
 #include <fcntl.h>
 #include <linux/filter.h>
 #include <linux/in6.h>
+#include <linux/net_tstamp.h>
 #include <linux/stddef.h>
 #include <netinet/udp.h>
 
@@ -39,6 +40,23 @@ CxPlatDataPathCalculateFeatureSupport(
     _Inout_ CXPLAT_DATAPATH* Datapath
     );
 
+//
+// Indicates CXPLAT_DATAPATH_FEATURE_SEND_TXTIME if the kernel accepts SO_TXTIME
+// on UDP sockets and the egress qdiscs (fq) honor it.
+//
+void
+CxPlatDataPathCalculateSendTxTimeSupport(
+    _Inout_ CXPLAT_DATAPATH* Datapath
+    );
+
+//
+// Enables earliest departure time scheduling (SCM_TXTIME) on the socket.
+//
+int
+CxPlatSocketEnableTxTime(
+    _In_ int SocketFd
+    );
+
 QUIC_STATUS
 CxPlatSocketConfigureRss(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
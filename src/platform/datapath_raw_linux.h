@@ -0,0 +1,48 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#define QUIC_API_ENABLE_PREVIEW_FEATURES 1
+
+#include "platform_internal.h"
+#include "datapath_raw.h"
+
+typedef struct CXPLAT_ROUTE_RESOLUTION_OPERATION {
+    //
+    // Link in the worker's operation queue.
+    // N.B. Multi-threaded access, synchronized by worker's operation lock.
+    //
+    CXPLAT_LIST_ENTRY WorkerLink;
+    uint32_t IfIndex;
+    QUIC_ADDR NextHop;
+    void* Context;
+    uint8_t PathId;
+    CXPLAT_ROUTE_RESOLUTION_CALLBACK_HANDLER Callback;
+} CXPLAT_ROUTE_RESOLUTION_OPERATION;
+
+//
+// Looks up the neighbor (ARP/NDP) cache entry for the next hop on the given
+// interface. Returns TRUE if a usable link-layer address was found.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+CxPlatDpRawGetNeighbor(
+    _In_ uint32_t IfIndex,
+    _In_ const QUIC_ADDR* NextHop,
+    _Out_writes_bytes_(ETH_MAC_ADDR_LEN) uint8_t* PhysicalAddress
+    );
+
+//
+// Forces the kernel to resolve the link-layer address of the next hop and
+// waits (bounded) for the neighbor entry to become usable.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+CxPlatDpRawResolveNeighbor(
+    _In_ uint32_t IfIndex,
+    _In_ const QUIC_ADDR* NextHop,
+    _Out_writes_bytes_(ETH_MAC_ADDR_LEN) uint8_t* PhysicalAddress
+    );
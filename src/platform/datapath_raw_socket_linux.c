@@ -0,0 +1,497 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    QUIC raw datapath socket and route resolution abstractions (Linux)
+
+--*/
+
+#include "datapath_raw_linux.h"
+#include <linux/neighbour.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#ifdef QUIC_CLOG
+#include "datapath_raw_socket_linux.c.clog.h"
+#endif
+
+//
+// How long, and how often, to wait for the kernel to resolve a neighbor.
+//
+#define NEIGHBOR_RESOLUTION_TIMEOUT_MS  1000
+#define NEIGHBOR_RESOLUTION_POLL_MS     10
+
+#define NETLINK_BUFFER_SIZE             4096
+
+typedef struct NETLINK_REQUEST {
+    struct nlmsghdr Header;
+    union {
+        struct rtmsg Route;
+        struct ndmsg Neighbor;
+    };
+    uint8_t Attributes[64];
+} NETLINK_REQUEST;
+
+//
+// Socket Pool Logic
+//
+
+BOOLEAN
+CxPlatSockPoolInitialize(
+    _Inout_ CXPLAT_SOCKET_POOL* Pool
+    )
+{
+    if (!CxPlatHashtableInitializeEx(&Pool->Sockets, CXPLAT_HASH_MIN_SIZE)) {
+        return FALSE;
+    }
+    CxPlatRwLockInitialize(&Pool->Lock);
+    return TRUE;
+}
+
+void
+CxPlatSockPoolUninitialize(
+    _Inout_ CXPLAT_SOCKET_POOL* Pool
+    )
+{
+    CxPlatRwLockUninitialize(&Pool->Lock);
+    CxPlatHashtableUninitialize(&Pool->Sockets);
+}
+
+//
+// Netlink Helpers
+//
+
+static
+void
+CxPlatNetlinkAddAttribute(
+    _Inout_ NETLINK_REQUEST* Request,
+    _In_ uint16_t Type,
+    _In_reads_bytes_(Length) const void* Data,
+    _In_ uint16_t Length
+    )
+{
+    struct rtattr* Attribute =
+        (struct rtattr*)((uint8_t*)Request + NLMSG_ALIGN(Request->Header.nlmsg_len));
+    CXPLAT_DBG_ASSERT(
+        NLMSG_ALIGN(Request->Header.nlmsg_len) + RTA_LENGTH(Length) <= sizeof(*Request));
+    Attribute->rta_type = Type;
+    Attribute->rta_len = (unsigned short)RTA_LENGTH(Length);
+    memcpy(RTA_DATA(Attribute), Data, Length);
+    Request->Header.nlmsg_len = NLMSG_ALIGN(Request->Header.nlmsg_len) + RTA_ALIGN(Attribute->rta_len);
+}
+
+static
+void
+CxPlatNetlinkAddAddress(
+    _Inout_ NETLINK_REQUEST* Request,
+    _In_ uint16_t Type,
+    _In_ const QUIC_ADDR* Address
+    )
+{
+    if (QuicAddrGetFamily(Address) == QUIC_ADDRESS_FAMILY_INET) {
+        CxPlatNetlinkAddAttribute(
+            Request, Type, &Address->Ipv4.sin_addr, sizeof(Address->Ipv4.sin_addr));
+    } else {
+        CxPlatNetlinkAddAttribute(
+            Request, Type, &Address->Ipv6.sin6_addr, sizeof(Address->Ipv6.sin6_addr));
+    }
+}
+
+static
+void
+CxPlatNetlinkReadAddress(
+    _In_ const struct rtattr* Attribute,
+    _In_ QUIC_ADDRESS_FAMILY Family,
+    _Out_ QUIC_ADDR* Address
+    )
+{
+    CxPlatZeroMemory(Address, sizeof(*Address));
+    QuicAddrSetFamily(Address, Family);
+    if (Family == QUIC_ADDRESS_FAMILY_INET &&
+        RTA_PAYLOAD(Attribute) >= sizeof(Address->Ipv4.sin_addr)) {
+        memcpy(&Address->Ipv4.sin_addr, RTA_DATA(Attribute), sizeof(Address->Ipv4.sin_addr));
+    } else if (Family == QUIC_ADDRESS_FAMILY_INET6 &&
+        RTA_PAYLOAD(Attribute) >= sizeof(Address->Ipv6.sin6_addr)) {
+        memcpy(&Address->Ipv6.sin6_addr, RTA_DATA(Attribute), sizeof(Address->Ipv6.sin6_addr));
+    }
+}
+
+//
+// Sends a single netlink request and receives the single message response into
+// the provided buffer. Returns the response header on success.
+//
+static
+struct nlmsghdr*
+CxPlatNetlinkTransact(
+    _In_ NETLINK_REQUEST* Request,
+    _Out_writes_bytes_(NETLINK_BUFFER_SIZE) uint8_t* Buffer
+    )
+{
+    struct nlmsghdr* Response = NULL;
+    struct sockaddr_nl Kernel = { .nl_family = AF_NETLINK };
+    int Fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (Fd == INVALID_SOCKET) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            errno,
+            "socket(NETLINK_ROUTE)");
+        return NULL;
+    }
+
+    int Option = 1;
+    (void)setsockopt(Fd, SOL_NETLINK, NETLINK_GET_STRICT_CHK, &Option, sizeof(Option));
+
+    Request->Header.nlmsg_flags |= NLM_F_REQUEST;
+    Request->Header.nlmsg_seq = 1;
+    if (sendto(
+            Fd, Request, Request->Header.nlmsg_len, 0,
+            (struct sockaddr*)&Kernel, sizeof(Kernel)) < 0) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            errno,
+            "sendto(NETLINK_ROUTE)");
+        goto Exit;
+    }
+
+    ssize_t Length;
+    do {
+        Length = recv(Fd, Buffer, NETLINK_BUFFER_SIZE, 0);
+    } while (Length < 0 && errno == EINTR);
+
+    if (Length < (ssize_t)sizeof(struct nlmsghdr)) {
+        goto Exit;
+    }
+
+    struct nlmsghdr* Header = (struct nlmsghdr*)Buffer;
+    if (!NLMSG_OK(Header, (uint32_t)Length) ||
+        Header->nlmsg_type == NLMSG_ERROR ||
+        Header->nlmsg_type == NLMSG_DONE) {
+        goto Exit;
+    }
+
+    Response = Header;
+
+Exit:
+
+    close(Fd);
+    return Response;
+}
+
+//
+// Queries the kernel FIB for the best route to the remote address.
+//
+static
+BOOLEAN
+CxPlatDpRawGetBestRoute(
+    _In_ const QUIC_ADDR* LocalAddress,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _Out_ uint32_t* IfIndex,
+    _Out_ QUIC_ADDR* SourceAddress,
+    _Out_ QUIC_ADDR* NextHop
+    )
+{
+    const QUIC_ADDRESS_FAMILY Family = QuicAddrGetFamily(RemoteAddress);
+    NETLINK_REQUEST Request;
+    uint8_t Buffer[NETLINK_BUFFER_SIZE];
+    BOOLEAN FoundSource = FALSE;
+    BOOLEAN FoundGateway = FALSE;
+
+    *IfIndex = 0;
+
+    CxPlatZeroMemory(&Request, sizeof(Request));
+    Request.Header.nlmsg_len = NLMSG_LENGTH(sizeof(Request.Route));
+    Request.Header.nlmsg_type = RTM_GETROUTE;
+    Request.Route.rtm_family = Family == QUIC_ADDRESS_FAMILY_INET ? AF_INET : AF_INET6;
+    Request.Route.rtm_dst_len = Family == QUIC_ADDRESS_FAMILY_INET ? 32 : 128;
+    CxPlatNetlinkAddAddress(&Request, RTA_DST, RemoteAddress);
+    if (!QuicAddrIsWildCard(LocalAddress) && QuicAddrGetFamily(LocalAddress) == Family) {
+        Request.Route.rtm_src_len = Request.Route.rtm_dst_len;
+        CxPlatNetlinkAddAddress(&Request, RTA_SRC, LocalAddress);
+    }
+
+    struct nlmsghdr* Response = CxPlatNetlinkTransact(&Request, Buffer);
+    if (Response == NULL || Response->nlmsg_type != RTM_NEWROUTE) {
+        return FALSE;
+    }
+
+    struct rtmsg* Route = (struct rtmsg*)NLMSG_DATA(Response);
+    int AttributesLength = (int)RTM_PAYLOAD(Response);
+    for (struct rtattr* Attribute = RTM_RTA(Route);
+         RTA_OK(Attribute, AttributesLength);
+         Attribute = RTA_NEXT(Attribute, AttributesLength)) {
+        switch (Attribute->rta_type) {
+        case RTA_OIF:
+            *IfIndex = *(uint32_t*)RTA_DATA(Attribute);
+            break;
+        case RTA_PREFSRC:
+            CxPlatNetlinkReadAddress(Attribute, Family, SourceAddress);
+            FoundSource = TRUE;
+            break;
+        case RTA_GATEWAY:
+            CxPlatNetlinkReadAddress(Attribute, Family, NextHop);
+            FoundGateway = TRUE;
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (!FoundSource) {
+        *SourceAddress = *LocalAddress;
+    }
+    if (!FoundGateway) {
+        *NextHop = *RemoteAddress; // On-link
+    }
+
+    return *IfIndex != 0;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+CxPlatDpRawGetNeighbor(
+    _In_ uint32_t IfIndex,
+    _In_ const QUIC_ADDR* NextHop,
+    _Out_writes_bytes_(ETH_MAC_ADDR_LEN) uint8_t* PhysicalAddress
+    )
+{
+    NETLINK_REQUEST Request;
+    uint8_t Buffer[NETLINK_BUFFER_SIZE];
+
+    CxPlatZeroMemory(&Request, sizeof(Request));
+    Request.Header.nlmsg_len = NLMSG_LENGTH(sizeof(Request.Neighbor));
+    Request.Header.nlmsg_type = RTM_GETNEIGH;
+    Request.Neighbor.ndm_family =
+        QuicAddrGetFamily(NextHop) == QUIC_ADDRESS_FAMILY_INET ? AF_INET : AF_INET6;
+    Request.Neighbor.ndm_ifindex = (int)IfIndex;
+    CxPlatNetlinkAddAddress(&Request, NDA_DST, NextHop);
+
+    struct nlmsghdr* Response = CxPlatNetlinkTransact(&Request, Buffer);
+    if (Response == NULL || Response->nlmsg_type != RTM_NEWNEIGH) {
+        return FALSE;
+    }
+
+    struct ndmsg* Neighbor = (struct ndmsg*)NLMSG_DATA(Response);
+    if (!(Neighbor->ndm_state &
+          (NUD_REACHABLE | NUD_STALE | NUD_DELAY | NUD_PROBE | NUD_PERMANENT | NUD_NOARP))) {
+        return FALSE;
+    }
+
+    int AttributesLength = (int)(Response->nlmsg_len - NLMSG_LENGTH(sizeof(*Neighbor)));
+    for (struct rtattr* Attribute =
+            (struct rtattr*)((uint8_t*)Neighbor + NLMSG_ALIGN(sizeof(*Neighbor)));
+         RTA_OK(Attribute, AttributesLength);
+         Attribute = RTA_NEXT(Attribute, AttributesLength)) {
+        if (Attribute->rta_type == NDA_LLADDR && RTA_PAYLOAD(Attribute) == ETH_MAC_ADDR_LEN) {
+            memcpy(PhysicalAddress, RTA_DATA(Attribute), ETH_MAC_ADDR_LEN);
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+CxPlatDpRawResolveNeighbor(
+    _In_ uint32_t IfIndex,
+    _In_ const QUIC_ADDR* NextHop,
+    _Out_writes_bytes_(ETH_MAC_ADDR_LEN) uint8_t* PhysicalAddress
+    )
+{
+    if (CxPlatDpRawGetNeighbor(IfIndex, NextHop, PhysicalAddress)) {
+        return TRUE;
+    }
+
+    //
+    // There is no netlink request to synchronously resolve a neighbor, so
+    // send an empty datagram to the next hop (discard port) out the interface.
+    // This makes the kernel start ARP/NDP resolution, which is then polled for
+    // completion.
+    //
+    QUIC_ADDR Target = *NextHop;
+    QuicAddrSetPort(&Target, 9);
+    int Fd =
+        socket(
+            QuicAddrGetFamily(NextHop) == QUIC_ADDRESS_FAMILY_INET ? AF_INET : AF_INET6,
+            SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK,
+            IPPROTO_UDP);
+    if (Fd == INVALID_SOCKET) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            errno,
+            "socket(neighbor resolution)");
+        return FALSE;
+    }
+
+    int Index = (int)IfIndex;
+    (void)setsockopt(Fd, SOL_SOCKET, SO_BINDTOIFINDEX, &Index, sizeof(Index));
+    (void)sendto(
+        Fd, NULL, 0, 0, (struct sockaddr*)&Target,
+        QuicAddrGetFamily(NextHop) == QUIC_ADDRESS_FAMILY_INET ?
+            sizeof(Target.Ipv4) : sizeof(Target.Ipv6));
+    close(Fd);
+
+    for (uint32_t Waited = 0;
+         Waited < NEIGHBOR_RESOLUTION_TIMEOUT_MS;
+         Waited += NEIGHBOR_RESOLUTION_POLL_MS) {
+        CxPlatSleep(NEIGHBOR_RESOLUTION_POLL_MS);
+        if (CxPlatDpRawGetNeighbor(IfIndex, NextHop, PhysicalAddress)) {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+RawResolveRoute(
+    _In_ CXPLAT_SOCKET_RAW* Socket,
+    _Inout_ CXPLAT_ROUTE* Route,
+    _In_ uint8_t PathId,
+    _In_ void* Context,
+    _In_ CXPLAT_ROUTE_RESOLUTION_CALLBACK_HANDLER Callback
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    CXPLAT_ROUTE_STATE State = Route->State;
+    QUIC_ADDR LocalAddress = {0};
+    QUIC_ADDR NextHop = {0};
+    uint32_t IfIndex = 0;
+    uint8_t PhysicalAddress[ETH_MAC_ADDR_LEN];
+
+    CXPLAT_DBG_ASSERT(!QuicAddrIsWildCard(&Route->RemoteAddress));
+
+    Route->State = RouteResolving;
+
+    QuicTraceEvent(
+        DatapathGetRouteStart,
+        "[data][%p] Querying route, local=%!ADDR!, remote=%!ADDR!",
+        Socket,
+        CASTED_CLOG_BYTEARRAY(sizeof(Route->LocalAddress), &Route->LocalAddress),
+        CASTED_CLOG_BYTEARRAY(sizeof(Route->RemoteAddress), &Route->RemoteAddress));
+
+    //
+    // Find the best next hop IP address.
+    //
+    if (!CxPlatDpRawGetBestRoute(
+            &Route->LocalAddress, &Route->RemoteAddress, &IfIndex, &LocalAddress, &NextHop)) {
+        Status = QUIC_STATUS_UNREACHABLE;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Socket,
+            Status,
+            "CxPlatDpRawGetBestRoute");
+        goto Error;
+    }
+
+    QuicTraceEvent(
+        DatapathGetRouteComplete,
+        "[data][%p] Query route result: %!ADDR!",
+        Socket,
+        CASTED_CLOG_BYTEARRAY(sizeof(LocalAddress), &LocalAddress));
+
+    if (State == RouteSuspected && !QuicAddrCompareIp(&LocalAddress, &Route->LocalAddress)) {
+        //
+        // We can't handle local address change here easily due to lack of full migration support.
+        //
+        Status = QUIC_STATUS_INVALID_STATE;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Socket,
+            Status,
+            "CxPlatDpRawGetBestRoute returned different local address for the suspected route");
+        goto Error;
+    }
+
+    QuicAddrSetPort(&LocalAddress, QuicAddrGetPort(&Route->LocalAddress)); // Preserve local port.
+    Route->LocalAddress = LocalAddress;
+
+    //
+    // Find the interface that matches the route we just looked up.
+    //
+    CXPLAT_LIST_ENTRY* Entry = Socket->RawDatapath->Interfaces.Flink;
+    for (; Entry != &Socket->RawDatapath->Interfaces; Entry = Entry->Flink) {
+        CXPLAT_INTERFACE* Interface = CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_INTERFACE, Link);
+        if (Interface->IfIndex == IfIndex) {
+            CXPLAT_DBG_ASSERT(sizeof(Interface->PhysicalAddress) == sizeof(Route->LocalLinkLayerAddress));
+            CxPlatCopyMemory(&Route->LocalLinkLayerAddress, Interface->PhysicalAddress, sizeof(Route->LocalLinkLayerAddress));
+            CxPlatDpRawAssignQueue(Interface, Route);
+            break;
+        }
+    }
+
+    if (Route->Queue == NULL) {
+        Status = QUIC_STATUS_NOT_FOUND;
+        QuicTraceEvent(
+            DatapathError,
+            "[data][%p] ERROR, %s.",
+            Socket,
+            "no matching interface/queue");
+        goto Error;
+    }
+
+    //
+    // Check if there's already a usable cached neighbor.
+    //
+    BOOLEAN Cached = CxPlatDpRawGetNeighbor(IfIndex, &NextHop, PhysicalAddress);
+    QuicTraceLogConnInfo(
+        RouteResolutionStart,
+        Context,
+        "Starting to look up neighbor on Path[%hhu] with status %u",
+        PathId,
+        Cached ? QUIC_STATUS_SUCCESS : QUIC_STATUS_NOT_FOUND);
+    //
+    // We need to force neighbor resolution if any of the following is true:
+    // 1. No cached neighbor entry for the given destination address.
+    // 2. The neighbor entry isn't in a usable state.
+    // 3. When we are re-resolving a suspected route, the neighbor entry is the same as the existing one.
+    //
+    // We queue an operation on the route worker for resolution because it
+    // involves network IO and we don't want our connection worker queue blocked.
+    //
+    if (!Cached ||
+        (State == RouteSuspected &&
+         memcmp(
+             Route->NextHopLinkLayerAddress,
+             PhysicalAddress,
+             sizeof(Route->NextHopLinkLayerAddress)) == 0)) {
+        CXPLAT_ROUTE_RESOLUTION_WORKER* Worker = Socket->RawDatapath->RouteResolutionWorker;
+        CXPLAT_ROUTE_RESOLUTION_OPERATION* Operation = CxPlatPoolAlloc(&Worker->OperationPool);
+        if (Operation == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "CXPLAT_DATAPATH",
+                sizeof(CXPLAT_ROUTE_RESOLUTION_OPERATION));
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Error;
+        }
+        Operation->IfIndex = IfIndex;
+        Operation->NextHop = NextHop;
+        Operation->Context = Context;
+        Operation->Callback = Callback;
+        Operation->PathId = PathId;
+        CxPlatDispatchLockAcquire(&Worker->Lock);
+        CxPlatListInsertTail(&Worker->Operations, &Operation->WorkerLink);
+        CxPlatDispatchLockRelease(&Worker->Lock);
+        CxPlatEventSet(Worker->Ready);
+        return QUIC_STATUS_PENDING;
+    }
+
+    CxPlatResolveRouteComplete(Context, Route, PhysicalAddress, PathId);
+    return QUIC_STATUS_SUCCESS;
+
+Error:
+
+    CXPLAT_DBG_ASSERT(QUIC_FAILED(Status));
+    Callback(Context, NULL, PathId, FALSE);
+    return Status;
+}
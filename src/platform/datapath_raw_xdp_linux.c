@@ -0,0 +1,2080 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    QUIC AF_XDP Datapath Implementation (Linux)
+
+--*/
+
+#include "datapath_raw_linux.h"
+#include "datapath_raw_xdp.h"
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <net/if_arp.h>
+#include <netpacket/packet.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/bpf.h>
+#include <linux/ethtool.h>
+#include <linux/if_link.h>
+#include <linux/if_xdp.h>
+#include <linux/sockios.h>
+
+#ifdef QUIC_CLOG
+#include "datapath_raw_xdp_linux.c.clog.h"
+#endif
+
+#define UMEM_TAG 'MpdX' // XdpM
+
+//
+// Every UMEM frame is a fixed size, aligned chunk. The kernel places received
+// frames at (chunk + UMEM headroom + XDP_PACKET_HEADROOM), so the headroom is
+// where the RX packet metadata (XDP_RX_PACKET and client context) lives.
+//
+#define XDP_CHUNK_SIZE          4096
+#define XDP_KERNEL_HEADROOM     256 // XDP_PACKET_HEADROOM
+#define XDP_RX_HEADROOM_ALIGNMENT 64
+
+//
+// Busy poll configuration applied to each XSK (best effort).
+//
+#define XDP_BUSY_POLL_US        20
+#define XDP_BUSY_POLL_BUDGET    (RX_BATCH_SIZE * 4)
+
+#define XDP_PORT_FLAG_UDP       0x1
+#define XDP_PORT_FLAG_TCP       0x2
+#define XDP_PORT_COUNT          65536
+
+//
+// A single producer or consumer ring shared with the kernel.
+//
+typedef struct XSK_RING {
+    uint32_t* Producer;
+    uint32_t* Consumer;
+    uint32_t* Flags;
+    uint8_t* Elements;
+    void* Mapping;
+    size_t MappingSize;
+    uint32_t Size;
+    uint32_t Mask;
+    uint32_t ElementSize;
+    uint32_t CachedProducer;
+    uint32_t CachedConsumer;
+} XSK_RING;
+
+//
+// UMEM shared by all XSKs of a single partition.
+//
+typedef struct XDP_UMEM {
+    uint8_t* Buffers;
+    uint64_t Size;
+    int OwnerFd; // The XSK the UMEM was registered on.
+
+    //
+    // Only accessed by the partition's execution context.
+    //
+    CXPLAT_SLIST_ENTRY PartitionRxPool;
+
+    //
+    // Frames returned from other threads.
+    //
+    CXPLAT_LOCK RxPoolLock;
+    CXPLAT_SLIST_ENTRY RxPool;
+    CXPLAT_LOCK TxPoolLock;
+    CXPLAT_SLIST_ENTRY TxPool;
+} XDP_UMEM;
+
+typedef struct XDP_PORT_REFS {
+    uint16_t Udp;
+    uint16_t Tcp;
+} XDP_PORT_REFS;
+
+typedef struct XDP_DATAPATH {
+    CXPLAT_DATAPATH_RAW;
+
+    //
+    // Currently, all XDP interfaces share the same config.
+    //
+    CXPLAT_REF_COUNT RefCount;
+    uint32_t PartitionCount;
+    uint32_t RxBufferCount;
+    uint32_t RxRingSize;
+    uint32_t TxBufferCount;
+    uint32_t TxRingSize;
+    uint32_t RxHeadroom;
+    uint32_t PollingIdleTimeoutUs;
+    uint32_t NextPartition; // Round robin queue to partition assignment.
+    BOOLEAN Running;        // Signal to stop partitions.
+
+    //
+    // Port filter shared by the XDP programs on all interfaces.
+    //
+    CXPLAT_LOCK PortLock;
+    int PortMap;            // BPF array map: UDP/TCP port -> XDP_PORT_FLAG_*.
+    uint32_t PortCount;     // Number of ports currently redirected.
+    XDP_PORT_REFS* PortRefs;
+
+    XDP_UMEM* Umems;        // One per partition, follows Partitions.
+    XDP_PARTITION Partitions[0];
+} XDP_DATAPATH;
+
+typedef struct XDP_INTERFACE {
+    XDP_INTERFACE_COMMON;
+    int XskMap;             // XSKMAP used by our program (-1 until the program is attached).
+    int Program;
+    int XdpLink;            // BPF link; closing it detaches the program.
+    BOOLEAN MapConfigured;  // XSKs inserted into an application owned XSKMAP (map mode).
+    QUIC_XDP_MAP_HANDLE AppXskMap;
+    char Name[IF_NAMESIZE];
+} XDP_INTERFACE;
+
+typedef struct CXPLAT_QUEUE {
+    XDP_QUEUE_COMMON;
+    XDP_UMEM* Umem;
+    int Fd;
+    uint32_t QueueId;
+    uint32_t TxOutstanding; // Frames submitted to the TX ring, not yet completed.
+    BOOLEAN RxIoRegistered;
+    XSK_RING FillRing;
+    XSK_RING RxRing;
+    XSK_RING TxRing;
+    XSK_RING CompletionRing;
+    CXPLAT_SQE RxIoSqe;
+
+    CXPLAT_LIST_ENTRY PartitionTxQueue;
+
+    //
+    // Cross-thread TX queue.
+    //
+    CXPLAT_LOCK TxLock;
+    CXPLAT_LIST_ENTRY TxQueue;
+} CXPLAT_QUEUE;
+
+typedef struct XDP_RX_PACKET {
+    // N.B. This struct is also put in a SLIST, so the first field is overwritten.
+    CXPLAT_QUEUE* Queue;
+    CXPLAT_ROUTE RouteStorage;
+    CXPLAT_RECV_DATA RecvData;
+    // Followed by:
+    // uint8_t ClientContext[...];
+    // uint8_t FrameBuffer[MAX_ETH_FRAME_SIZE]; (after kernel headroom)
+} XDP_RX_PACKET;
+
+typedef struct XDP_TX_PACKET {
+    CXPLAT_SEND_DATA;
+    CXPLAT_QUEUE* Queue;
+    CXPLAT_LIST_ENTRY Link;
+    uint8_t FrameBuffer[MAX_ETH_FRAME_SIZE];
+} XDP_TX_PACKET;
+
+CXPLAT_STATIC_ASSERT(sizeof(XDP_TX_PACKET) <= XDP_CHUNK_SIZE, "TX packet must fit in a UMEM chunk");
+
+CXPLAT_EVENT_COMPLETION CxPlatIoXdpWaitRxEventComplete;
+CXPLAT_EVENT_COMPLETION CxPlatIoXdpShutdownEventComplete;
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+CxPlatXdpExecute(
+    _Inout_ void* Context,
+    _Inout_ CXPLAT_EXECUTION_STATE* State
+    );
+
+//
+// BPF and XSK ring helpers.
+//
+
+static
+int
+CxPlatBpf(
+    _In_ int Command,
+    _Inout_ union bpf_attr* Attr
+    )
+{
+    return (int)syscall(__NR_bpf, Command, Attr, sizeof(*Attr));
+}
+
+static
+int
+CxPlatBpfMapCreate(
+    _In_ uint32_t MapType,
+    _In_ uint32_t KeySize,
+    _In_ uint32_t ValueSize,
+    _In_ uint32_t MaxEntries
+    )
+{
+    union bpf_attr Attr;
+    CxPlatZeroMemory(&Attr, sizeof(Attr));
+    Attr.map_type = MapType;
+    Attr.key_size = KeySize;
+    Attr.value_size = ValueSize;
+    Attr.max_entries = MaxEntries;
+    return CxPlatBpf(BPF_MAP_CREATE, &Attr);
+}
+
+static
+int
+CxPlatBpfMapUpdate(
+    _In_ int Map,
+    _In_ const void* Key,
+    _In_ const void* Value
+    )
+{
+    union bpf_attr Attr;
+    CxPlatZeroMemory(&Attr, sizeof(Attr));
+    Attr.map_fd = (uint32_t)Map;
+    Attr.key = (uint64_t)(uintptr_t)Key;
+    Attr.value = (uint64_t)(uintptr_t)Value;
+    Attr.flags = BPF_ANY;
+    return CxPlatBpf(BPF_MAP_UPDATE_ELEM, &Attr);
+}
+
+static
+int
+CxPlatBpfMapDelete(
+    _In_ int Map,
+    _In_ const void* Key
+    )
+{
+    union bpf_attr Attr;
+    CxPlatZeroMemory(&Attr, sizeof(Attr));
+    Attr.map_fd = (uint32_t)Map;
+    Attr.key = (uint64_t)(uintptr_t)Key;
+    return CxPlatBpf(BPF_MAP_DELETE_ELEM, &Attr);
+}
+
+#define XDP_INSN(Code, Dst, Src, Off, Imm) \
+    { .code = (Code), .dst_reg = (Dst), .src_reg = (Src), .off = (Off), .imm = (Imm) }
+
+//
+// Loads the XDP program that redirects matching frames to the XSK bound to the
+// frame's RX queue. It is the equivalent of:
+//
+//  int prog(struct xdp_md* ctx) {
+//      parse Ethernet + IPv4 (no options) or IPv6 (no extension headers);
+//      if (IPv4 && (MF || fragment offset != 0)) return XDP_PASS;
+//      if (l4 != UDP && l4 != TCP) return XDP_PASS;
+//      uint8_t* flags = bpf_map_lookup_elem(&port_map, &dst_port);
+//      if (!flags || !(*flags & (l4 == UDP ? XDP_PORT_FLAG_UDP : XDP_PORT_FLAG_TCP)))
+//          return XDP_PASS;
+//      return bpf_redirect_map(&xsk_map, ctx->rx_queue_index, XDP_PASS);
+//  }
+//
+// Fragments are left to the kernel stack since only the first one carries the
+// L4 header, and steering on it would split a datagram across two paths. IPv6
+// fragments already fall through, as the Fragment header is an extension
+// header.
+//
+// It is hand assembled so that no BPF toolchain or libbpf is required.
+//
+static
+int
+CxPlatXdpLoadProgram(
+    _In_ int PortMap,
+    _In_ int XskMap
+    )
+{
+    const struct bpf_insn Program[] = {
+        XDP_INSN(BPF_ALU64 | BPF_MOV | BPF_X, 6, 1, 0, 0),          // r6 = ctx
+        XDP_INSN(BPF_LDX | BPF_MEM | BPF_W, 2, 6, 0, 0),            // r2 = ctx->data
+        XDP_INSN(BPF_LDX | BPF_MEM | BPF_W, 3, 6, 4, 0),            // r3 = ctx->data_end
+        XDP_INSN(BPF_ALU64 | BPF_MOV | BPF_X, 4, 2, 0, 0),
+        XDP_INSN(BPF_ALU64 | BPF_ADD | BPF_K, 4, 0, 0, 42),         // eth + ipv4 + udp/port
+        XDP_INSN(BPF_JMP | BPF_JGT | BPF_X, 4, 3, 35, 0),           // -> pass
+        XDP_INSN(BPF_LDX | BPF_MEM | BPF_H, 5, 2, 12, 0),           // r5 = ether type
+        XDP_INSN(BPF_JMP | BPF_JNE | BPF_K, 5, 0, 7, 0x0008),       // -> ipv6
+        XDP_INSN(BPF_LDX | BPF_MEM | BPF_B, 5, 2, 14, 0),
+        XDP_INSN(BPF_JMP | BPF_JNE | BPF_K, 5, 0, 31, 0x45),        // IPv4 options -> pass
+        XDP_INSN(BPF_LDX | BPF_MEM | BPF_H, 5, 2, 20, 0),           // r5 = flags + frag offset
+        XDP_INSN(BPF_JMP | BPF_JSET | BPF_K, 5, 0, 29, 0xff3f),     // MF or offset -> pass
+        XDP_INSN(BPF_LDX | BPF_MEM | BPF_B, 7, 2, 23, 0),           // r7 = protocol
+        XDP_INSN(BPF_LDX | BPF_MEM | BPF_H, 5, 2, 36, 0),           // r5 = dst port
+        XDP_INSN(BPF_JMP | BPF_JA, 0, 0, 6, 0),                     // -> l4
+        XDP_INSN(BPF_JMP | BPF_JNE | BPF_K, 5, 0, 25, 0xdd86),      // ipv6: not IPv6 -> pass
+        XDP_INSN(BPF_ALU64 | BPF_MOV | BPF_X, 4, 2, 0, 0),
+        XDP_INSN(BPF_ALU64 | BPF_ADD | BPF_K, 4, 0, 0, 62),         // eth + ipv6 + udp/port
+        XDP_INSN(BPF_JMP | BPF_JGT | BPF_X, 4, 3, 22, 0),           // -> pass
+        XDP_INSN(BPF_LDX | BPF_MEM | BPF_B, 7, 2, 20, 0),           // r7 = next header
+        XDP_INSN(BPF_LDX | BPF_MEM | BPF_H, 5, 2, 56, 0),           // r5 = dst port
+        XDP_INSN(BPF_ALU64 | BPF_MOV | BPF_K, 8, 0, 0, XDP_PORT_FLAG_UDP), // l4:
+        XDP_INSN(BPF_JMP | BPF_JEQ | BPF_K, 7, 0, 2, IPPROTO_UDP),  // -> lookup
+        XDP_INSN(BPF_JMP | BPF_JNE | BPF_K, 7, 0, 17, IPPROTO_TCP), // -> pass
+        XDP_INSN(BPF_ALU64 | BPF_MOV | BPF_K, 8, 0, 0, XDP_PORT_FLAG_TCP),
+        XDP_INSN(BPF_STX | BPF_MEM | BPF_W, 10, 5, -4, 0),          // lookup: key = port
+        XDP_INSN(BPF_ALU64 | BPF_MOV | BPF_X, 2, 10, 0, 0),
+        XDP_INSN(BPF_ALU64 | BPF_ADD | BPF_K, 2, 0, 0, -4),
+        XDP_INSN(BPF_LD | BPF_DW | BPF_IMM, 1, BPF_PSEUDO_MAP_FD, 0, PortMap),
+        XDP_INSN(0, 0, 0, 0, 0),
+        XDP_INSN(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_map_lookup_elem),
+        XDP_INSN(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 9, 0),            // -> pass
+        XDP_INSN(BPF_LDX | BPF_MEM | BPF_B, 1, 0, 0, 0),
+        XDP_INSN(BPF_ALU64 | BPF_AND | BPF_X, 1, 8, 0, 0),
+        XDP_INSN(BPF_JMP | BPF_JEQ | BPF_K, 1, 0, 6, 0),            // -> pass
+        XDP_INSN(BPF_LDX | BPF_MEM | BPF_W, 2, 6, 16, 0),           // r2 = ctx->rx_queue_index
+        XDP_INSN(BPF_LD | BPF_DW | BPF_IMM, 1, BPF_PSEUDO_MAP_FD, 0, XskMap),
+        XDP_INSN(0, 0, 0, 0, 0),
+        XDP_INSN(BPF_ALU64 | BPF_MOV | BPF_K, 3, 0, 0, XDP_PASS),
+        XDP_INSN(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_redirect_map),
+        XDP_INSN(BPF_JMP | BPF_EXIT, 0, 0, 0, 0),
+        XDP_INSN(BPF_ALU64 | BPF_MOV | BPF_K, 0, 0, 0, XDP_PASS),   // pass:
+        XDP_INSN(BPF_JMP | BPF_EXIT, 0, 0, 0, 0),
+    };
+
+    union bpf_attr Attr;
+    CxPlatZeroMemory(&Attr, sizeof(Attr));
+    Attr.prog_type = BPF_PROG_TYPE_XDP;
+    Attr.insns = (uint64_t)(uintptr_t)Program;
+    Attr.insn_cnt = ARRAYSIZE(Program);
+    Attr.license = (uint64_t)(uintptr_t)"Dual MIT/GPL";
+    return CxPlatBpf(BPF_PROG_LOAD, &Attr);
+}
+
+static
+QUIC_STATUS
+XskRingInitialize(
+    _In_ int Fd,
+    _In_ const struct xdp_ring_offset* Offsets,
+    _In_ off_t PageOffset,
+    _In_ uint32_t Size,
+    _In_ uint32_t ElementSize,
+    _Out_ XSK_RING* Ring
+    )
+{
+    CxPlatZeroMemory(Ring, sizeof(*Ring));
+    Ring->MappingSize = Offsets->desc + (size_t)Size * ElementSize;
+    Ring->Mapping =
+        mmap(
+            NULL, Ring->MappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+            Fd, PageOffset);
+    if (Ring->Mapping == MAP_FAILED) {
+        Ring->Mapping = NULL;
+        return errno;
+    }
+
+    uint8_t* Base = (uint8_t*)Ring->Mapping;
+    Ring->Producer = (uint32_t*)(Base + Offsets->producer);
+    Ring->Consumer = (uint32_t*)(Base + Offsets->consumer);
+    Ring->Flags = (uint32_t*)(Base + Offsets->flags);
+    Ring->Elements = Base + Offsets->desc;
+    Ring->Size = Size;
+    Ring->Mask = Size - 1;
+    Ring->ElementSize = ElementSize;
+    Ring->CachedProducer = *Ring->Producer;
+    Ring->CachedConsumer = *Ring->Consumer;
+    return QUIC_STATUS_SUCCESS;
+}
+
+static
+void
+XskRingUninitialize(
+    _Inout_ XSK_RING* Ring
+    )
+{
+    if (Ring->Mapping != NULL) {
+        munmap(Ring->Mapping, Ring->MappingSize);
+        Ring->Mapping = NULL;
+    }
+}
+
+QUIC_INLINE
+void*
+XskRingGetElement(
+    _In_ const XSK_RING* Ring,
+    _In_ uint32_t Index
+    )
+{
+    return Ring->Elements + (size_t)(Index & Ring->Mask) * Ring->ElementSize;
+}
+
+QUIC_INLINE
+uint32_t
+XskRingConsumerReserve(
+    _Inout_ XSK_RING* Ring,
+    _In_ uint32_t MaxCount,
+    _Out_ uint32_t* Index
+    )
+{
+    const uint32_t Available =
+        __atomic_load_n(Ring->Producer, __ATOMIC_ACQUIRE) - Ring->CachedConsumer;
+    *Index = Ring->CachedConsumer;
+    return CXPLAT_MIN(Available, MaxCount);
+}
+
+QUIC_INLINE
+void
+XskRingConsumerRelease(
+    _Inout_ XSK_RING* Ring,
+    _In_ uint32_t Count
+    )
+{
+    Ring->CachedConsumer += Count;
+    __atomic_store_n(Ring->Consumer, Ring->CachedConsumer, __ATOMIC_RELEASE);
+}
+
+QUIC_INLINE
+uint32_t
+XskRingProducerReserve(
+    _Inout_ XSK_RING* Ring,
+    _In_ uint32_t MaxCount,
+    _Out_ uint32_t* Index
+    )
+{
+    const uint32_t Available =
+        Ring->Size -
+        (Ring->CachedProducer - __atomic_load_n(Ring->Consumer, __ATOMIC_ACQUIRE));
+    *Index = Ring->CachedProducer;
+    return CXPLAT_MIN(Available, MaxCount);
+}
+
+QUIC_INLINE
+void
+XskRingProducerSubmit(
+    _Inout_ XSK_RING* Ring,
+    _In_ uint32_t Count
+    )
+{
+    Ring->CachedProducer += Count;
+    __atomic_store_n(Ring->Producer, Ring->CachedProducer, __ATOMIC_RELEASE);
+}
+
+QUIC_INLINE
+BOOLEAN
+XskRingProducerNeedPoke(
+    _In_ const XSK_RING* Ring
+    )
+{
+    return (__atomic_load_n(Ring->Flags, __ATOMIC_RELAXED) & XDP_RING_NEED_WAKEUP) != 0;
+}
+
+//
+// Interface and queue setup.
+//
+
+static
+uint32_t
+CxPlatXdpGetQueueCount(
+    _In_z_ const char* InterfaceName
+    )
+{
+    uint32_t QueueCount = 1;
+    struct ethtool_channels Channels = { .cmd = ETHTOOL_GCHANNELS };
+    struct ifreq Request;
+    CxPlatZeroMemory(&Request, sizeof(Request));
+    strncpy(Request.ifr_name, InterfaceName, sizeof(Request.ifr_name) - 1);
+    Request.ifr_data = (char*)&Channels;
+
+    int Fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (Fd != INVALID_SOCKET) {
+        if (ioctl(Fd, SIOCETHTOOL, &Request) == 0) {
+            QueueCount = CXPLAT_MAX(Channels.combined_count, Channels.rx_count);
+            if (QueueCount == 0) {
+                QueueCount = 1;
+            }
+        }
+        close(Fd);
+    }
+
+    return QueueCount;
+}
+
+static
+QUIC_STATUS
+CxPlatXdpUmemInitialize(
+    _In_ const XDP_DATAPATH* Xdp,
+    _Inout_ XDP_UMEM* Umem
+    )
+{
+    const uint32_t FrameCount = Xdp->RxBufferCount + Xdp->TxBufferCount;
+
+    Umem->Size = (uint64_t)FrameCount * XDP_CHUNK_SIZE;
+    Umem->Buffers =
+        mmap(NULL, Umem->Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (Umem->Buffers == MAP_FAILED) {
+        Umem->Buffers = NULL;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "XDP UMEM",
+            Umem->Size);
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    //
+    // The first RxBufferCount frames are used for RX, the rest for TX.
+    //
+    for (uint32_t i = Xdp->RxBufferCount; i > 0; i--) {
+        CxPlatListPushEntry(
+            &Umem->PartitionRxPool,
+            (CXPLAT_SLIST_ENTRY*)(Umem->Buffers + (uint64_t)(i - 1) * XDP_CHUNK_SIZE));
+    }
+    for (uint32_t i = FrameCount; i > Xdp->RxBufferCount; i--) {
+        CxPlatListPushEntry(
+            &Umem->TxPool,
+            (CXPLAT_SLIST_ENTRY*)(Umem->Buffers + (uint64_t)(i - 1) * XDP_CHUNK_SIZE));
+    }
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+static
+void
+CxPlatXdpUmemUninitialize(
+    _Inout_ XDP_UMEM* Umem
+    )
+{
+    if (Umem->Buffers != NULL) {
+        munmap(Umem->Buffers, Umem->Size);
+        Umem->Buffers = NULL;
+    }
+    CxPlatLockUninitialize(&Umem->RxPoolLock);
+    CxPlatLockUninitialize(&Umem->TxPoolLock);
+}
+
+static
+void
+CxPlatXdpQueueUninitialize(
+    _Inout_ CXPLAT_QUEUE* Queue
+    )
+{
+    if (Queue->Fd != INVALID_SOCKET) {
+        if (Queue->Umem != NULL && Queue->Umem->OwnerFd == Queue->Fd) {
+            //
+            // Only happens if the interface failed to initialize, in which case
+            // any other XSK sharing this UMEM is torn down with it.
+            //
+            Queue->Umem->OwnerFd = INVALID_SOCKET;
+        }
+        close(Queue->Fd);
+        Queue->Fd = INVALID_SOCKET;
+    }
+    XskRingUninitialize(&Queue->FillRing);
+    XskRingUninitialize(&Queue->RxRing);
+    XskRingUninitialize(&Queue->TxRing);
+    XskRingUninitialize(&Queue->CompletionRing);
+    CxPlatLockUninitialize(&Queue->TxLock);
+}
+
+static
+QUIC_STATUS
+CxPlatXdpQueueInitialize(
+    _In_ XDP_DATAPATH* Xdp,
+    _In_ XDP_INTERFACE* Interface,
+    _Inout_ CXPLAT_QUEUE* Queue,
+    _In_ XDP_UMEM* Umem
+    )
+{
+    QUIC_STATUS Status;
+    const BOOLEAN OwnsUmem = Umem->OwnerFd == INVALID_SOCKET;
+
+    Queue->Fd = socket(AF_XDP, SOCK_RAW | SOCK_CLOEXEC, 0);
+    if (Queue->Fd == INVALID_SOCKET) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "socket(AF_XDP)");
+        goto Error;
+    }
+
+    if (OwnsUmem) {
+        struct xdp_umem_reg UmemReg = {
+            .addr = (uint64_t)(uintptr_t)Umem->Buffers,
+            .len = Umem->Size,
+            .chunk_size = XDP_CHUNK_SIZE,
+            .headroom = Xdp->RxHeadroom,
+        };
+        if (setsockopt(Queue->Fd, SOL_XDP, XDP_UMEM_REG, &UmemReg, sizeof(UmemReg)) != 0) {
+            Status = errno;
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                Status,
+                "setsockopt(XDP_UMEM_REG)");
+            goto Error;
+        }
+    }
+
+    //
+    // Each (interface, queue) pair needs its own fill and completion rings,
+    // even when sharing the partition's UMEM.
+    //
+    if (setsockopt(Queue->Fd, SOL_XDP, XDP_UMEM_FILL_RING, &Xdp->RxRingSize, sizeof(Xdp->RxRingSize)) != 0 ||
+        setsockopt(Queue->Fd, SOL_XDP, XDP_UMEM_COMPLETION_RING, &Xdp->TxRingSize, sizeof(Xdp->TxRingSize)) != 0 ||
+        setsockopt(Queue->Fd, SOL_XDP, XDP_RX_RING, &Xdp->RxRingSize, sizeof(Xdp->RxRingSize)) != 0 ||
+        setsockopt(Queue->Fd, SOL_XDP, XDP_TX_RING, &Xdp->TxRingSize, sizeof(Xdp->TxRingSize)) != 0) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "setsockopt(XDP rings)");
+        goto Error;
+    }
+
+    struct xdp_mmap_offsets Offsets;
+    socklen_t OffsetsLength = sizeof(Offsets);
+    if (getsockopt(Queue->Fd, SOL_XDP, XDP_MMAP_OFFSETS, &Offsets, &OffsetsLength) != 0) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "getsockopt(XDP_MMAP_OFFSETS)");
+        goto Error;
+    }
+
+    if (QUIC_FAILED(Status =
+            XskRingInitialize(
+                Queue->Fd, &Offsets.fr, XDP_UMEM_PGOFF_FILL_RING, Xdp->RxRingSize,
+                sizeof(uint64_t), &Queue->FillRing)) ||
+        QUIC_FAILED(Status =
+            XskRingInitialize(
+                Queue->Fd, &Offsets.rx, XDP_PGOFF_RX_RING, Xdp->RxRingSize,
+                sizeof(struct xdp_desc), &Queue->RxRing)) ||
+        QUIC_FAILED(Status =
+            XskRingInitialize(
+                Queue->Fd, &Offsets.tx, XDP_PGOFF_TX_RING, Xdp->TxRingSize,
+                sizeof(struct xdp_desc), &Queue->TxRing)) ||
+        QUIC_FAILED(Status =
+            XskRingInitialize(
+                Queue->Fd, &Offsets.cr, XDP_UMEM_PGOFF_COMPLETION_RING, Xdp->TxRingSize,
+                sizeof(uint64_t), &Queue->CompletionRing))) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "mmap(XDP ring)");
+        goto Error;
+    }
+
+    struct sockaddr_xdp Address = {
+        .sxdp_family = AF_XDP,
+        .sxdp_ifindex = Interface->ActualIfIndex,
+        .sxdp_queue_id = Queue->QueueId,
+    };
+    if (OwnsUmem) {
+        //
+        // Prefer zero-copy, but fall back to copy mode for drivers (e.g. veth)
+        // without AF_XDP zero-copy support.
+        //
+        Address.sxdp_flags = XDP_ZEROCOPY | XDP_USE_NEED_WAKEUP;
+        if (bind(Queue->Fd, (struct sockaddr*)&Address, sizeof(Address)) != 0) {
+            Address.sxdp_flags = XDP_COPY | XDP_USE_NEED_WAKEUP;
+            if (bind(Queue->Fd, (struct sockaddr*)&Address, sizeof(Address)) != 0) {
+                Status = errno;
+                QuicTraceEvent(
+                    LibraryErrorStatus,
+                    "[ lib] ERROR, %u, %s.",
+                    Status,
+                    "bind(AF_XDP)");
+                goto Error;
+            }
+        }
+        Umem->OwnerFd = Queue->Fd;
+    } else {
+        //
+        // Shared UMEM sockets inherit the copy/zero-copy mode of the owner, so
+        // binding fails if this queue can't use the same mode.
+        //
+        Address.sxdp_flags = XDP_SHARED_UMEM;
+        Address.sxdp_shared_umem_fd = (uint32_t)Umem->OwnerFd;
+        if (bind(Queue->Fd, (struct sockaddr*)&Address, sizeof(Address)) != 0) {
+            Status = errno;
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                Status,
+                "bind(AF_XDP, XDP_SHARED_UMEM)");
+            goto Error;
+        }
+    }
+
+    //
+    // Opt into busy polling so that polling the XSK from the partition's
+    // execution context drives the driver's NAPI context directly.
+    //
+#ifdef SO_PREFER_BUSY_POLL
+    int Option = 1;
+    (void)setsockopt(Queue->Fd, SOL_SOCKET, SO_PREFER_BUSY_POLL, &Option, sizeof(Option));
+#endif
+#ifdef SO_BUSY_POLL
+    int BusyPollUs = XDP_BUSY_POLL_US;
+    (void)setsockopt(Queue->Fd, SOL_SOCKET, SO_BUSY_POLL, &BusyPollUs, sizeof(BusyPollUs));
+#endif
+#ifdef SO_BUSY_POLL_BUDGET
+    int BusyPollBudget = XDP_BUSY_POLL_BUDGET;
+    (void)setsockopt(
+        Queue->Fd, SOL_SOCKET, SO_BUSY_POLL_BUDGET, &BusyPollBudget, sizeof(BusyPollBudget));
+#endif
+
+    return QUIC_STATUS_SUCCESS;
+
+Error:
+
+    CxPlatXdpQueueUninitialize(Queue);
+    return Status;
+}
+
+//
+// Detaches and frees the redirect program of the interface, if attached.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+CxPlatDpRawInterfaceDetachProgram(
+    _Inout_ XDP_INTERFACE* Interface
+    )
+{
+    if (Interface->XdpLink != INVALID_SOCKET) {
+        close(Interface->XdpLink);
+        Interface->XdpLink = INVALID_SOCKET;
+    }
+
+    if (Interface->Program != INVALID_SOCKET) {
+        close(Interface->Program);
+        Interface->Program = INVALID_SOCKET;
+    }
+
+    if (Interface->XskMap != INVALID_SOCKET) {
+        close(Interface->XskMap);
+        Interface->XskMap = INVALID_SOCKET;
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDpRawInterfaceUninitialize(
+    _Inout_ XDP_INTERFACE* Interface
+    )
+{
+    CxPlatDpRawInterfaceDetachProgram(Interface);
+
+    for (uint32_t i = 0; Interface->Queues != NULL && i < Interface->QueueCount; i++) {
+        CxPlatXdpQueueUninitialize(&Interface->Queues[i]);
+    }
+
+    if (Interface->Queues != NULL) {
+        CxPlatFree(Interface->Queues, QUEUE_TAG);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatDpRawInterfaceInitialize(
+    _In_ XDP_DATAPATH* Xdp,
+    _Inout_ XDP_INTERFACE* Interface
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+
+    Interface->Xdp = Xdp;
+    Interface->XskMap = INVALID_SOCKET;
+    Interface->Program = INVALID_SOCKET;
+    Interface->XdpLink = INVALID_SOCKET;
+
+    const uint32_t QueueCount = CxPlatXdpGetQueueCount(Interface->Name);
+    Interface->QueueCount = (uint16_t)CXPLAT_MIN(QueueCount, UINT16_MAX);
+
+    QuicTraceLogVerbose(
+        XdpInterfaceQueues,
+        "[ixdp][%p] Initializing %u queues on interface",
+        Interface,
+        Interface->QueueCount);
+
+    Interface->Queues = CXPLAT_ALLOC_NONPAGED(Interface->QueueCount * sizeof(*Interface->Queues), QUEUE_TAG);
+    if (Interface->Queues == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "XDP Queues",
+            Interface->QueueCount * sizeof(*Interface->Queues));
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Error;
+    }
+
+    CxPlatZeroMemory(Interface->Queues, Interface->QueueCount * sizeof(*Interface->Queues));
+
+    for (uint16_t i = 0; i < Interface->QueueCount; i++) {
+        CXPLAT_QUEUE* Queue = &Interface->Queues[i];
+        const uint32_t PartitionIndex = (Xdp->NextPartition + i) % Xdp->PartitionCount;
+        XDP_UMEM* Umem = &Xdp->Umems[PartitionIndex];
+
+        Queue->Interface = Interface;
+        Queue->QueueId = i;
+        Queue->Fd = INVALID_SOCKET;
+        CxPlatLockInitialize(&Queue->TxLock);
+        CxPlatListInitializeHead(&Queue->TxQueue);
+        CxPlatListInitializeHead(&Queue->PartitionTxQueue);
+
+        if (Umem->Buffers == NULL) {
+            Status = CxPlatXdpUmemInitialize(Xdp, Umem);
+            if (QUIC_FAILED(Status)) {
+                goto Error;
+            }
+        }
+        Queue->Umem = Umem;
+
+        Status = CxPlatXdpQueueInitialize(Xdp, Interface, Queue, Umem);
+        if (QUIC_FAILED(Status)) {
+            goto Error;
+        }
+    }
+
+    //
+    // Add each queue to its partition, round robin across interfaces.
+    //
+    for (uint16_t i = 0; i < Interface->QueueCount; i++) {
+        XdpWorkerAddQueue(
+            &Xdp->Partitions[(Xdp->NextPartition + i) % Xdp->PartitionCount],
+            &Interface->Queues[i]);
+    }
+    Xdp->NextPartition += Interface->QueueCount;
+
+Error:
+
+    if (QUIC_FAILED(Status)) {
+        CxPlatDpRawInterfaceUninitialize(Interface);
+        Interface->Queues = NULL;
+    }
+
+    return Status;
+}
+
+//
+// Loads and attaches the redirect program to the interface, if not already
+// done. Called with the datapath's PortLock held.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+QUIC_STATUS
+CxPlatDpRawInterfaceAttachProgram(
+    _In_ XDP_DATAPATH* Xdp,
+    _Inout_ XDP_INTERFACE* Interface
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+
+    if (Interface->XdpLink != INVALID_SOCKET) {
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    Interface->XskMap =
+        CxPlatBpfMapCreate(BPF_MAP_TYPE_XSKMAP, sizeof(uint32_t), sizeof(uint32_t), Interface->QueueCount);
+    if (Interface->XskMap == INVALID_SOCKET) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "bpf(BPF_MAP_CREATE, XSKMAP)");
+        goto Error;
+    }
+
+    for (uint32_t i = 0; i < Interface->QueueCount; i++) {
+        uint32_t Fd = (uint32_t)Interface->Queues[i].Fd;
+        if (CxPlatBpfMapUpdate(Interface->XskMap, &i, &Fd) != 0) {
+            Status = errno;
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                Status,
+                "bpf(BPF_MAP_UPDATE_ELEM, XSKMAP)");
+            goto Error;
+        }
+    }
+
+    Interface->Program = CxPlatXdpLoadProgram(Xdp->PortMap, Interface->XskMap);
+    if (Interface->Program == INVALID_SOCKET) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "bpf(BPF_PROG_LOAD)");
+        goto Error;
+    }
+
+    //
+    // Prefer native (driver) mode and fall back to generic mode.
+    //
+    union bpf_attr Attr;
+    CxPlatZeroMemory(&Attr, sizeof(Attr));
+    Attr.link_create.prog_fd = (uint32_t)Interface->Program;
+    Attr.link_create.target_ifindex = Interface->ActualIfIndex;
+    Attr.link_create.attach_type = BPF_XDP;
+    Attr.link_create.flags = XDP_FLAGS_DRV_MODE;
+    Interface->XdpLink = CxPlatBpf(BPF_LINK_CREATE, &Attr);
+    if (Interface->XdpLink == INVALID_SOCKET) {
+        Attr.link_create.flags = XDP_FLAGS_SKB_MODE;
+        Interface->XdpLink = CxPlatBpf(BPF_LINK_CREATE, &Attr);
+    }
+    if (Interface->XdpLink == INVALID_SOCKET) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "bpf(BPF_LINK_CREATE)");
+        goto Error;
+    }
+
+    return QUIC_STATUS_SUCCESS;
+
+Error:
+
+    CxPlatDpRawInterfaceDetachProgram(Interface);
+
+    return Status;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+size_t
+CxPlatDpRawGetDatapathSize(
+    _In_ CXPLAT_WORKER_POOL* WorkerPool
+    )
+{
+    const uint32_t PartitionCount = CxPlatWorkerPoolGetCount(WorkerPool);
+    return sizeof(XDP_DATAPATH) + (PartitionCount * (sizeof(XDP_PARTITION) + sizeof(XDP_UMEM)));
+}
+
+static
+void
+CxPlatXdpCleanup(
+    _Inout_ XDP_DATAPATH* Xdp
+    )
+{
+    while (!CxPlatListIsEmpty(&Xdp->Interfaces)) {
+        XDP_INTERFACE* Interface =
+            CXPLAT_CONTAINING_RECORD(CxPlatListRemoveHead(&Xdp->Interfaces), XDP_INTERFACE, Link);
+        CxPlatDpRawInterfaceUninitialize(Interface);
+        CxPlatFree(Interface, IF_TAG);
+    }
+
+    for (uint32_t i = 0; i < Xdp->PartitionCount; i++) {
+        CxPlatXdpUmemUninitialize(&Xdp->Umems[i]);
+    }
+
+    if (Xdp->PortMap != INVALID_SOCKET) {
+        close(Xdp->PortMap);
+        Xdp->PortMap = INVALID_SOCKET;
+    }
+
+    if (Xdp->PortRefs != NULL) {
+        CxPlatFree(Xdp->PortRefs, PORT_SET_TAG);
+        Xdp->PortRefs = NULL;
+    }
+
+    CxPlatLockUninitialize(&Xdp->PortLock);
+}
+
+static
+void
+CxPlatXdpPartitionCleanupSqes(
+    _In_ XDP_PARTITION* Partition,
+    _In_opt_ const CXPLAT_QUEUE* LastQueue // Exclusive; NULL for all queues.
+    )
+{
+    CXPLAT_QUEUE* Queue = Partition->Queues;
+    while (Queue != LastQueue) {
+        CxPlatSqeCleanup(Partition->EventQ, &Queue->RxIoSqe);
+        Queue = Queue->Next;
+    }
+    CxPlatSqeCleanup(Partition->EventQ, &Partition->ShutdownSqe);
+}
+
+static
+BOOLEAN
+CxPlatXdpPartitionInitializeSqes(
+    _In_ XDP_PARTITION* Partition
+    )
+{
+    if (!CxPlatSqeInitialize(
+            Partition->EventQ,
+            CxPlatIoXdpShutdownEventComplete,
+            &Partition->ShutdownSqe)) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            errno,
+            "CxPlatSqeInitialize");
+        return FALSE;
+    }
+
+    CXPLAT_QUEUE* Queue = Partition->Queues;
+    while (Queue) {
+        if (!CxPlatSqeInitialize(
+                Partition->EventQ,
+                CxPlatIoXdpWaitRxEventComplete,
+                &Queue->RxIoSqe)) {
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                errno,
+                "CxPlatSqeInitialize");
+            CxPlatXdpPartitionCleanupSqes(Partition, Queue);
+            return FALSE;
+        }
+        Queue = Queue->Next;
+    }
+
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatDpRawInitialize(
+    _Inout_ CXPLAT_DATAPATH_RAW* Datapath,
+    _In_ uint32_t ClientRecvContextLength,
+    _In_ CXPLAT_WORKER_POOL* WorkerPool
+    )
+{
+    XDP_DATAPATH* Xdp = (XDP_DATAPATH*)Datapath;
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    struct ifaddrs* Addresses = NULL;
+    uint32_t PartitionsStarted = 0;
+
+    CxPlatListInitializeHead(&Xdp->Interfaces);
+    CxPlatLockInitialize(&Xdp->PortLock);
+    Xdp->PortMap = INVALID_SOCKET;
+    Xdp->PollingIdleTimeoutUs = 0;
+    Xdp->PartitionCount = CxPlatWorkerPoolGetCount(WorkerPool);
+    Xdp->Umems = (XDP_UMEM*)&Xdp->Partitions[Xdp->PartitionCount];
+    for (uint32_t i = 0; i < Xdp->PartitionCount; i++) {
+        Xdp->Partitions[i].Processor = (uint16_t)
+            CxPlatWorkerPoolGetIdealProcessor(WorkerPool, i);
+        XDP_UMEM* Umem = &Xdp->Umems[i];
+        CxPlatZeroMemory(Umem, sizeof(*Umem));
+        Umem->OwnerFd = INVALID_SOCKET;
+        CxPlatLockInitialize(&Umem->RxPoolLock);
+        CxPlatLockInitialize(&Umem->TxPoolLock);
+    }
+
+    //
+    // Frame counts are per partition UMEM; ring sizes are per queue.
+    //
+    Xdp->RxBufferCount = 2048;
+    Xdp->RxRingSize = 256;
+    Xdp->TxBufferCount = 2048;
+    Xdp->TxRingSize = 256;
+    Xdp->RxHeadroom =
+        ALIGN_UP_BY(sizeof(XDP_RX_PACKET) + ClientRecvContextLength, XDP_RX_HEADROOM_ALIGNMENT);
+    if (Xdp->RxHeadroom + XDP_KERNEL_HEADROOM + MAX_ETH_FRAME_SIZE > XDP_CHUNK_SIZE) {
+        Status = QUIC_STATUS_NOT_SUPPORTED;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Xdp->RxHeadroom,
+            "RX headroom too large for UMEM chunk");
+        goto Error;
+    }
+
+    Xdp->PortRefs =
+        CXPLAT_ALLOC_NONPAGED(XDP_PORT_COUNT * sizeof(XDP_PORT_REFS), PORT_SET_TAG);
+    if (Xdp->PortRefs == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "XDP port references",
+            XDP_PORT_COUNT * sizeof(XDP_PORT_REFS));
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Error;
+    }
+    CxPlatZeroMemory(Xdp->PortRefs, XDP_PORT_COUNT * sizeof(XDP_PORT_REFS));
+
+    if (getifaddrs(&Addresses) != 0) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "getifaddrs");
+        goto Error;
+    }
+
+    for (struct ifaddrs* Address = Addresses; Address != NULL; Address = Address->ifa_next) {
+        if (Address->ifa_addr == NULL || Address->ifa_addr->sa_family != AF_PACKET) {
+            continue;
+        }
+        const struct sockaddr_ll* LinkAddress = (const struct sockaddr_ll*)Address->ifa_addr;
+        if ((Address->ifa_flags & (IFF_UP | IFF_RUNNING)) != (IFF_UP | IFF_RUNNING) ||
+            (Address->ifa_flags & IFF_LOOPBACK) ||
+            LinkAddress->sll_hatype != ARPHRD_ETHER ||
+            LinkAddress->sll_halen != ETH_MAC_ADDR_LEN) {
+            continue;
+        }
+
+        XDP_INTERFACE* Interface = CXPLAT_ALLOC_NONPAGED(sizeof(XDP_INTERFACE), IF_TAG);
+        if (Interface == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "XDP interface",
+                sizeof(*Interface));
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Error;
+        }
+        CxPlatZeroMemory(Interface, sizeof(*Interface));
+        Interface->ActualIfIndex = Interface->IfIndex = (uint32_t)LinkAddress->sll_ifindex;
+        memcpy(
+            Interface->PhysicalAddress, LinkAddress->sll_addr,
+            sizeof(Interface->PhysicalAddress));
+        strncpy(Interface->Name, Address->ifa_name, sizeof(Interface->Name) - 1);
+
+        QuicTraceLogVerbose(
+            XdpInterfaceInitialize,
+            "[ixdp][%p] Initializing interface %u",
+            Interface,
+            Interface->ActualIfIndex);
+
+        Status = CxPlatDpRawInterfaceInitialize(Xdp, Interface);
+        if ((Status == EAFNOSUPPORT || Status == EPERM) && CxPlatListIsEmpty(&Xdp->Interfaces)) {
+            //
+            // AF_XDP isn't available (or permitted) on this system.
+            //
+            CxPlatFree(Interface, IF_TAG);
+            Status = QUIC_STATUS_NOT_SUPPORTED;
+            break;
+        } else if (QUIC_FAILED(Status)) {
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                Status,
+                "CxPlatDpRawInterfaceInitialize");
+            CxPlatFree(Interface, IF_TAG);
+            continue;
+        }
+        CxPlatListInsertTail(&Xdp->Interfaces, &Interface->Link);
+    }
+
+    if (CxPlatListIsEmpty(&Xdp->Interfaces)) {
+        if (Status == QUIC_STATUS_NOT_SUPPORTED) {
+            QuicTraceEvent(
+                LibraryError,
+                "[ lib] ERROR, %s.",
+                "XDP is not supported on this system");
+        } else {
+            QuicTraceEvent(
+                LibraryError,
+                "[ lib] ERROR, %s.",
+                "no XDP capable interface");
+            Status = QUIC_STATUS_NOT_FOUND;
+        }
+        goto Error;
+    }
+
+    for (; PartitionsStarted < Xdp->PartitionCount; PartitionsStarted++) {
+        XDP_PARTITION* Partition = &Xdp->Partitions[PartitionsStarted];
+        if (Partition->Queues == NULL) { continue; } // No queues for this partition.
+        Partition->EventQ = CxPlatWorkerPoolGetEventQ(WorkerPool, (uint16_t)PartitionsStarted);
+        if (!CxPlatXdpPartitionInitializeSqes(Partition)) {
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Error;
+        }
+    }
+
+    Xdp->Running = TRUE;
+    CxPlatRefInitialize(&Xdp->RefCount);
+    for (uint32_t i = 0; i < Xdp->PartitionCount; i++) {
+
+        XDP_PARTITION* Partition = &Xdp->Partitions[i];
+        if (Partition->Queues == NULL) { continue; } // No queues for this partition.
+
+        Partition->Xdp = Xdp;
+        Partition->PartitionIndex = (uint16_t)i;
+        Partition->Ec.Ready = TRUE;
+        Partition->Ec.NextTimeUs = UINT64_MAX;
+        Partition->Ec.Callback = CxPlatXdpExecute;
+        Partition->Ec.Context = &Xdp->Partitions[i];
+        CxPlatRefIncrement(&Xdp->RefCount);
+
+        uint32_t QueueCount = 0;
+        CXPLAT_QUEUE* Queue = Partition->Queues;
+        while (Queue) {
+            QuicTraceLogVerbose(
+                XdpQueueStart,
+                "[ xdp][%p] XDP queue start on partition %p",
+                Queue,
+                Partition);
+            ++QueueCount;
+            Queue = Queue->Next;
+        }
+
+        QuicTraceLogVerbose(
+            XdpWorkerStart,
+            "[ xdp][%p] XDP partition start, %u queues",
+            Partition,
+            QueueCount);
+        UNREFERENCED_PARAMETER(QueueCount);
+
+        CxPlatWorkerPoolAddExecutionContext(
+            WorkerPool, &Partition->Ec, Partition->PartitionIndex);
+    }
+    Status = QUIC_STATUS_SUCCESS;
+
+    QuicTraceLogVerbose(
+        XdpInitialize,
+        "[ xdp][%p] XDP initialized, %u procs",
+        Xdp,
+        Xdp->PartitionCount);
+
+Error:
+
+    if (Addresses != NULL) {
+        freeifaddrs(Addresses);
+    }
+
+    if (QUIC_FAILED(Status)) {
+        for (uint32_t i = 0; i < PartitionsStarted; i++) {
+            if (Xdp->Partitions[i].Queues != NULL) {
+                CxPlatXdpPartitionCleanupSqes(&Xdp->Partitions[i], NULL);
+            }
+        }
+        CxPlatXdpCleanup(Xdp);
+    }
+
+    return Status;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDpRawRelease(
+    _In_ XDP_DATAPATH* Xdp
+    )
+{
+    QuicTraceLogVerbose(
+        XdpRelease,
+        "[ xdp][%p] XDP release",
+        Xdp);
+    if (CxPlatRefDecrement(&Xdp->RefCount)) {
+        QuicTraceLogVerbose(
+            XdpUninitializeComplete,
+            "[ xdp][%p] XDP uninitialize complete",
+            Xdp);
+        CxPlatXdpCleanup(Xdp);
+        CxPlatDataPathUninitializeComplete((CXPLAT_DATAPATH_RAW*)Xdp);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDpRawUninitialize(
+    _In_ CXPLAT_DATAPATH_RAW* Datapath
+    )
+{
+    XDP_DATAPATH* Xdp = (XDP_DATAPATH*)Datapath;
+    QuicTraceLogVerbose(
+        XdpUninitialize,
+        "[ xdp][%p] XDP uninitialize",
+        Xdp);
+    Xdp->Running = FALSE;
+    for (uint32_t i = 0; i < Xdp->PartitionCount; i++) {
+        if (Xdp->Partitions[i].Queues != NULL) {
+            Xdp->Partitions[i].Ec.Ready = TRUE;
+            CxPlatWakeExecutionContext(&Xdp->Partitions[i].Ec);
+        }
+    }
+    CxPlatDpRawRelease(Xdp);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDpRawUpdatePollingIdleTimeout(
+    _In_ CXPLAT_DATAPATH_RAW* Datapath,
+    _In_ uint32_t PollingIdleTimeoutUs
+    )
+{
+    XDP_DATAPATH* Xdp = (XDP_DATAPATH*)Datapath;
+    Xdp->PollingIdleTimeoutUs = PollingIdleTimeoutUs;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+RawSocketUpdateQeo(
+    _In_ CXPLAT_SOCKET_RAW* Socket,
+    _In_reads_(OffloadCount)
+        const CXPLAT_QEO_CONNECTION* Offloads,
+    _In_ uint32_t OffloadCount
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Offloads);
+    UNREFERENCED_PARAMETER(OffloadCount);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+//
+// Updates the port filter entry for Port. Called with PortLock held.
+//
+static
+QUIC_STATUS
+CxPlatDpRawUpdatePortMap(
+    _In_ XDP_DATAPATH* Xdp,
+    _In_ uint16_t Port
+    )
+{
+    const XDP_PORT_REFS* Refs = &Xdp->PortRefs[Port];
+    const uint32_t Key = Port;
+    const uint8_t Flags =
+        (Refs->Udp > 0 ? XDP_PORT_FLAG_UDP : 0) | (Refs->Tcp > 0 ? XDP_PORT_FLAG_TCP : 0);
+
+    if (Xdp->PortMap == INVALID_SOCKET) {
+        if (Flags == 0) {
+            return QUIC_STATUS_SUCCESS;
+        }
+        Xdp->PortMap =
+            CxPlatBpfMapCreate(BPF_MAP_TYPE_ARRAY, sizeof(uint32_t), sizeof(uint8_t), XDP_PORT_COUNT);
+        if (Xdp->PortMap == INVALID_SOCKET) {
+            QUIC_STATUS Status = errno;
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                Status,
+                "bpf(BPF_MAP_CREATE, ARRAY)");
+            return Status;
+        }
+    }
+
+    if (CxPlatBpfMapUpdate(Xdp->PortMap, &Key, &Flags) != 0) {
+        QUIC_STATUS Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "bpf(BPF_MAP_UPDATE_ELEM, ARRAY)");
+        return Status;
+    }
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatDpRawPlumbRulesOnSocket(
+    _In_ CXPLAT_SOCKET_RAW* Socket,
+    _In_ BOOLEAN IsCreated
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    XDP_DATAPATH* Xdp = (XDP_DATAPATH*)Socket->RawDatapath;
+
+    //
+    // In map mode, the application manages XDP rules.
+    //
+    if (CxPlatDpRawIsRawDatapathOnly((CXPLAT_DATAPATH_RAW*)Xdp)) {
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    //
+    // The program only filters on destination port (the raw socket layer does
+    // the rest), so all sockets on the same port share a single entry. CIBIR
+    // sockets are matched by port as well, and demultiplexed by CID above.
+    //
+    // N.B. References are always taken on create, even if the program fails to
+    // attach, because the caller rolls back with IsCreated == FALSE.
+    //
+    const uint16_t Port = Socket->LocalAddress.Ipv4.sin_port;
+    const BOOLEAN Tcp = Socket->ReserveAuxTcpSockForQtip;
+    XDP_PORT_REFS* Refs = &Xdp->PortRefs[Port];
+
+    CxPlatLockAcquire(&Xdp->PortLock);
+
+    const BOOLEAN WasActive = Refs->Udp > 0 || Refs->Tcp > 0;
+    if (IsCreated) {
+        Refs->Udp++;
+        if (Tcp) {
+            Refs->Tcp++;
+        }
+    } else {
+        if (Refs->Udp > 0) {
+            Refs->Udp--;
+        }
+        if (Tcp && Refs->Tcp > 0) {
+            Refs->Tcp--;
+        }
+    }
+    const BOOLEAN IsActive = Refs->Udp > 0 || Refs->Tcp > 0;
+    if (!WasActive && IsActive) {
+        Xdp->PortCount++;
+    } else if (WasActive && !IsActive) {
+        Xdp->PortCount--;
+    }
+
+    Status = CxPlatDpRawUpdatePortMap(Xdp, Port);
+
+    if (QUIC_SUCCEEDED(Status) && IsCreated) {
+        CXPLAT_LIST_ENTRY* Entry;
+        for (Entry = Xdp->Interfaces.Flink; Entry != &Xdp->Interfaces; Entry = Entry->Flink) {
+            XDP_INTERFACE* Interface = CXPLAT_CONTAINING_RECORD(Entry, XDP_INTERFACE, Link);
+            Status = CxPlatDpRawInterfaceAttachProgram(Xdp, Interface);
+            if (QUIC_FAILED(Status)) {
+                break;
+            }
+        }
+    } else if (Xdp->PortCount == 0) {
+        //
+        // No ports are redirected anymore, so don't leave the program on
+        // the interfaces' receive path.
+        //
+        CXPLAT_LIST_ENTRY* Entry;
+        for (Entry = Xdp->Interfaces.Flink; Entry != &Xdp->Interfaces; Entry = Entry->Flink) {
+            XDP_INTERFACE* Interface = CXPLAT_CONTAINING_RECORD(Entry, XDP_INTERFACE, Link);
+            CxPlatDpRawInterfaceDetachProgram(Interface);
+        }
+    }
+
+    CxPlatLockRelease(&Xdp->PortLock);
+
+    return Status;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CxPlatDpRawIsL3TxXsumOffloadedOnQueue(
+    _In_ const CXPLAT_QUEUE* Queue
+    )
+{
+    UNREFERENCED_PARAMETER(Queue);
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CxPlatDpRawIsL4TxXsumOffloadedOnQueue(
+    _In_ const CXPLAT_QUEUE* Queue
+    )
+{
+    UNREFERENCED_PARAMETER(Queue);
+    return FALSE;
+}
+
+static
+BOOLEAN // Did work?
+CxPlatXdpRx(
+    _In_ const XDP_DATAPATH* Xdp,
+    _In_ CXPLAT_QUEUE* Queue,
+    _In_ uint16_t PartitionIndex,
+    _In_ BOOLEAN BusyPoll
+    )
+{
+    XDP_UMEM* Umem = Queue->Umem;
+    CXPLAT_RECV_DATA* Buffers[RX_BATCH_SIZE];
+    uint32_t RxIndex;
+    uint32_t FillIndex;
+    uint32_t ProdCount = 0;
+    uint32_t PacketCount = 0;
+
+    if (BusyPoll || XskRingProducerNeedPoke(&Queue->FillRing)) {
+        //
+        // With busy polling enabled this runs the driver's NAPI poll directly;
+        // otherwise it wakes up a zero-copy driver waiting on the fill ring.
+        //
+        (void)recvfrom(Queue->Fd, NULL, 0, MSG_DONTWAIT, NULL, NULL);
+    }
+
+    const uint32_t BuffersCount = XskRingConsumerReserve(&Queue->RxRing, RX_BATCH_SIZE, &RxIndex);
+
+    for (uint32_t i = 0; i < BuffersCount; i++) {
+        const struct xdp_desc* Buffer = XskRingGetElement(&Queue->RxRing, RxIndex++);
+        XDP_RX_PACKET* Packet =
+            (XDP_RX_PACKET*)(Umem->Buffers + (Buffer->addr & ~((uint64_t)XDP_CHUNK_SIZE - 1)));
+        uint8_t* FrameBuffer = Umem->Buffers + Buffer->addr;
+
+        CxPlatZeroMemory(Packet, sizeof(XDP_RX_PACKET));
+        Packet->Queue = Queue;
+        Packet->RouteStorage.Queue = Queue;
+        Packet->RecvData.Route = &Packet->RouteStorage;
+        Packet->RecvData.Route->DatapathType = Packet->RecvData.DatapathType = CXPLAT_DATAPATH_TYPE_RAW;
+        Packet->RecvData.PartitionIndex = PartitionIndex;
+
+        CxPlatDpRawParseEthernet(
+            (CXPLAT_DATAPATH*)Xdp,
+            &Packet->RecvData,
+            FrameBuffer,
+            (uint16_t)Buffer->len);
+
+        //
+        // The route has been filled in with the packet's src/dst IP and ETH addresses, so
+        // mark it resolved. This allows stateless sends to be issued without performing
+        // a route lookup.
+        //
+        Packet->RecvData.Route->State = RouteResolved;
+        CXPLAT_DBG_ASSERT(Packet->RecvData.Route->Queue != NULL);
+
+        if (Packet->RecvData.Buffer) {
+            Packet->RecvData.Allocated = TRUE;
+            Buffers[PacketCount++] = &Packet->RecvData;
+        } else {
+            CxPlatListPushEntry(&Umem->PartitionRxPool, (CXPLAT_SLIST_ENTRY*)Packet);
+        }
+    }
+
+    if (BuffersCount > 0) {
+        XskRingConsumerRelease(&Queue->RxRing, BuffersCount);
+    }
+
+    uint32_t FillAvailable = XskRingProducerReserve(&Queue->FillRing, UINT32_MAX, &FillIndex);
+    while (FillAvailable-- > 0) {
+        if (Umem->PartitionRxPool.Next == NULL &&
+            QuicReadPtrNoFence(&Umem->RxPool.Next) != NULL) {
+            CxPlatLockAcquire(&Umem->RxPoolLock);
+            Umem->PartitionRxPool.Next = Umem->RxPool.Next;
+            Umem->RxPool.Next = NULL;
+            CxPlatLockRelease(&Umem->RxPoolLock);
+        }
+
+        XDP_RX_PACKET* Packet = (XDP_RX_PACKET*)CxPlatListPopEntry(&Umem->PartitionRxPool);
+        if (Packet == NULL) {
+            break;
+        }
+
+        uint64_t* FillDesc = XskRingGetElement(&Queue->FillRing, FillIndex++);
+        *FillDesc = (uint64_t)((uint8_t*)Packet - Umem->Buffers);
+        ProdCount++;
+    }
+
+    if (ProdCount > 0) {
+        XskRingProducerSubmit(&Queue->FillRing, ProdCount);
+    }
+
+    if (PacketCount > 0) {
+        CxPlatDpRawRxEthernet((CXPLAT_DATAPATH_RAW*)Xdp, Buffers, (uint16_t)PacketCount);
+    }
+
+    return ProdCount > 0 || PacketCount > 0;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatDpRawRxFree(
+    _In_opt_ const CXPLAT_RECV_DATA* PacketChain
+    )
+{
+    CXPLAT_SLIST_ENTRY* Head = NULL;
+    CXPLAT_SLIST_ENTRY** Tail = &Head;
+    XDP_UMEM* Umem = NULL;
+
+    while (PacketChain) {
+        const XDP_RX_PACKET* Packet =
+            CXPLAT_CONTAINING_RECORD(PacketChain, XDP_RX_PACKET, RecvData);
+        PacketChain = PacketChain->Next;
+
+        if (Umem != Packet->Queue->Umem) {
+            if (Head != NULL) {
+                CxPlatLockAcquire(&Umem->RxPoolLock);
+                *Tail = Umem->RxPool.Next;
+                Umem->RxPool.Next = Head;
+                CxPlatLockRelease(&Umem->RxPoolLock);
+                Head = NULL;
+                Tail = &Head;
+            }
+
+            Umem = Packet->Queue->Umem;
+        }
+
+        *Tail = (CXPLAT_SLIST_ENTRY*)Packet;
+        Tail = &((CXPLAT_SLIST_ENTRY*)Packet)->Next;
+    }
+
+    if (Head != NULL) {
+        CxPlatLockAcquire(&Umem->RxPoolLock);
+        *Tail = Umem->RxPool.Next;
+        Umem->RxPool.Next = Head;
+        CxPlatLockRelease(&Umem->RxPoolLock);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+CXPLAT_SEND_DATA*
+CxPlatDpRawTxAlloc(
+    _Inout_ CXPLAT_SEND_CONFIG* Config
+    )
+{
+    CXPLAT_QUEUE* Queue = Config->Route->Queue;
+    CXPLAT_DBG_ASSERT(Queue != NULL);
+    XDP_UMEM* Umem = Queue->Umem;
+
+    CxPlatLockAcquire(&Umem->TxPoolLock);
+    XDP_TX_PACKET* Packet = (XDP_TX_PACKET*)CxPlatListPopEntry(&Umem->TxPool);
+    CxPlatLockRelease(&Umem->TxPoolLock);
+
+    if (Packet) {
+        HEADER_BACKFILL HeaderBackfill = CxPlatDpRawCalculateHeaderBackFill(Config->Route); // TODO - Cache in Route?
+        CXPLAT_DBG_ASSERT(Config->MaxPacketSize <= sizeof(Packet->FrameBuffer) - HeaderBackfill.AllLayer);
+        Packet->Queue = Queue;
+        Packet->Buffer.Length = Config->MaxPacketSize;
+        Packet->Buffer.Buffer = &Packet->FrameBuffer[HeaderBackfill.AllLayer];
+        Packet->ECN = Config->ECN;
+        Packet->DSCP = Config->DSCP;
+        Packet->DatapathType = Config->Route->DatapathType = CXPLAT_DATAPATH_TYPE_RAW;
+    }
+
+    return (CXPLAT_SEND_DATA*)Packet;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatDpRawTxFree(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    XDP_TX_PACKET* Packet = (XDP_TX_PACKET*)SendData;
+    XDP_UMEM* Umem = Packet->Queue->Umem;
+    CxPlatLockAcquire(&Umem->TxPoolLock);
+    CxPlatListPushEntry(&Umem->TxPool, (CXPLAT_SLIST_ENTRY*)Packet);
+    CxPlatLockRelease(&Umem->TxPoolLock);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatDpRawTxEnqueue(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    XDP_TX_PACKET* Packet = (XDP_TX_PACKET*)SendData;
+    XDP_PARTITION* Partition = Packet->Queue->Partition;
+
+    CxPlatLockAcquire(&Packet->Queue->TxLock);
+    CxPlatListInsertTail(&Packet->Queue->TxQueue, &Packet->Link);
+    CxPlatLockRelease(&Packet->Queue->TxLock);
+
+    Partition->Ec.Ready = TRUE;
+    CxPlatWakeExecutionContext(&Partition->Ec);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatDpRawTxSetL3ChecksumOffload(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    //
+    // AF_XDP TX checksum offload isn't used; checksums are computed in software.
+    //
+    UNREFERENCED_PARAMETER(SendData);
+    CXPLAT_DBG_ASSERT(FALSE);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatDpRawTxSetL4ChecksumOffload(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ BOOLEAN IsIpv6,
+    _In_ BOOLEAN IsTcp,
+    _In_ uint8_t L4HeaderLength
+    )
+{
+    UNREFERENCED_PARAMETER(SendData);
+    UNREFERENCED_PARAMETER(IsIpv6);
+    UNREFERENCED_PARAMETER(IsTcp);
+    UNREFERENCED_PARAMETER(L4HeaderLength);
+    CXPLAT_DBG_ASSERT(FALSE);
+}
+
+static
+BOOLEAN // Did work?
+CxPlatXdpTx(
+    _In_ CXPLAT_QUEUE* Queue
+    )
+{
+    XDP_UMEM* Umem = Queue->Umem;
+    uint32_t ProdCount = 0;
+    uint32_t CompCount = 0;
+    CXPLAT_SLIST_ENTRY* TxCompleteHead = NULL;
+    CXPLAT_SLIST_ENTRY** TxCompleteTail = &TxCompleteHead;
+
+    if (CxPlatListIsEmpty(&Queue->PartitionTxQueue) &&
+        QuicReadPtrNoFence(&Queue->TxQueue.Flink) != &Queue->TxQueue) {
+        CxPlatLockAcquire(&Queue->TxLock);
+        CxPlatListMoveItems(&Queue->TxQueue, &Queue->PartitionTxQueue);
+        CxPlatLockRelease(&Queue->TxLock);
+    }
+
+    uint32_t CompIndex;
+    uint32_t CompAvailable =
+        XskRingConsumerReserve(&Queue->CompletionRing, UINT32_MAX, &CompIndex);
+    while (CompAvailable-- > 0) {
+        const uint64_t* CompDesc = XskRingGetElement(&Queue->CompletionRing, CompIndex++);
+        CXPLAT_SLIST_ENTRY* Packet =
+            (CXPLAT_SLIST_ENTRY*)(Umem->Buffers + (*CompDesc & ~((uint64_t)XDP_CHUNK_SIZE - 1)));
+        *TxCompleteTail = Packet;
+        TxCompleteTail = &Packet->Next;
+        CompCount++;
+    }
+
+    if (CompCount > 0) {
+        XskRingConsumerRelease(&Queue->CompletionRing, CompCount);
+        Queue->TxOutstanding -= CompCount;
+        CxPlatLockAcquire(&Umem->TxPoolLock);
+        *TxCompleteTail = Umem->TxPool.Next;
+        Umem->TxPool.Next = TxCompleteHead;
+        CxPlatLockRelease(&Umem->TxPoolLock);
+    }
+
+    uint32_t TxIndex;
+    uint32_t TxAvailable = XskRingProducerReserve(&Queue->TxRing, UINT32_MAX, &TxIndex);
+    while (TxAvailable-- > 0 && !CxPlatListIsEmpty(&Queue->PartitionTxQueue)) {
+        struct xdp_desc* Buffer = XskRingGetElement(&Queue->TxRing, TxIndex++);
+        CXPLAT_LIST_ENTRY* Entry = CxPlatListRemoveHead(&Queue->PartitionTxQueue);
+        XDP_TX_PACKET* Packet = CXPLAT_CONTAINING_RECORD(Entry, XDP_TX_PACKET, Link);
+
+        Buffer->addr = (uint64_t)(Packet->FrameBuffer - Umem->Buffers);
+        Buffer->len = Packet->Buffer.Length;
+        Buffer->options = 0;
+        ProdCount++;
+    }
+
+    if (ProdCount > 0) {
+        XskRingProducerSubmit(&Queue->TxRing, ProdCount);
+        Queue->TxOutstanding += ProdCount;
+    }
+
+    //
+    // Copy mode (and some drivers) only transmit when kicked. The kernel
+    // processes a bounded batch per kick, so keep kicking while anything is
+    // outstanding.
+    //
+    if (Queue->TxOutstanding > 0 && XskRingProducerNeedPoke(&Queue->TxRing)) {
+        if (sendto(Queue->Fd, NULL, 0, MSG_DONTWAIT, NULL, 0) < 0 &&
+            errno != EAGAIN && errno != EBUSY && errno != ENOBUFS && errno != ENETDOWN &&
+            !Queue->Error) {
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                errno,
+                "sendto(AF_XDP)");
+            Queue->Error = TRUE;
+        }
+    }
+
+    return ProdCount > 0 || CompCount > 0;
+}
+
+static
+void
+CxPlatXdpQueueWaitRx(
+    _In_ XDP_PARTITION* Partition,
+    _In_ CXPLAT_QUEUE* Queue
+    )
+{
+    QuicTraceLogVerbose(
+        XdpQueueAsyncIoRx,
+        "[ xdp][%p] XDP async IO start (RX)",
+        Queue);
+#if CXPLAT_USE_IO_URING
+    CXPLAT_EVENTQ* EventQ = Partition->EventQ;
+    CxPlatLockAcquire(&EventQ->Lock);
+    struct io_uring_sqe* Sqe = CxPlatEventGetSqe(EventQ);
+    if (Sqe != NULL) {
+        io_uring_prep_poll_add(Sqe, Queue->Fd, POLLIN);
+        io_uring_sqe_set_data(Sqe, &Queue->RxIoSqe);
+        CxPlatEventQSubmit(EventQ);
+        Queue->RxQueued = TRUE;
+    }
+    CxPlatLockRelease(&EventQ->Lock);
+    if (!Queue->RxQueued) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            QUIC_STATUS_OUT_OF_MEMORY,
+            "CxPlatEventGetSqe(RX)");
+        Partition->Ec.Ready = TRUE;
+    }
+#else
+    struct epoll_event Event = {
+        .events = EPOLLIN | EPOLLONESHOT, .data = { .ptr = &Queue->RxIoSqe } };
+    if (epoll_ctl(
+            *Partition->EventQ,
+            Queue->RxIoRegistered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD,
+            Queue->Fd,
+            &Event) == 0) {
+        Queue->RxIoRegistered = TRUE;
+        Queue->RxQueued = TRUE;
+    } else {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            errno,
+            "epoll_ctl(RX)");
+        Partition->Ec.Ready = TRUE;
+    }
+#endif
+}
+
+static
+void
+CxPlatXdpQueueStopIo(
+    _In_ XDP_PARTITION* Partition,
+    _In_ CXPLAT_QUEUE* Queue
+    )
+{
+#if CXPLAT_USE_IO_URING
+    if (Queue->RxQueued) {
+        //
+        // The cancelled poll completes before the shutdown SQE, which is
+        // queued after this.
+        //
+        CXPLAT_EVENTQ* EventQ = Partition->EventQ;
+        CxPlatLockAcquire(&EventQ->Lock);
+        struct io_uring_sqe* Sqe = CxPlatEventGetSqe(EventQ);
+        if (Sqe != NULL) {
+            io_uring_prep_poll_remove(Sqe, (uint64_t)(uintptr_t)&Queue->RxIoSqe);
+            io_uring_sqe_set_data(Sqe, &Queue->RxIoSqe);
+            CxPlatEventQSubmit(EventQ);
+        }
+        CxPlatLockRelease(&EventQ->Lock);
+    }
+#else
+    if (Queue->RxIoRegistered) {
+        epoll_ctl(*Partition->EventQ, EPOLL_CTL_DEL, Queue->Fd, NULL);
+        Queue->RxIoRegistered = FALSE;
+    }
+#endif
+    close(Queue->Fd);
+    Queue->Fd = INVALID_SOCKET;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+CxPlatXdpExecute(
+    _Inout_ void* Context,
+    _Inout_ CXPLAT_EXECUTION_STATE* State
+    )
+{
+    XDP_PARTITION* Partition = (XDP_PARTITION*)Context;
+    const XDP_DATAPATH* Xdp = Partition->Xdp;
+
+    if (!Xdp->Running) {
+        QuicTraceLogVerbose(
+            XdpPartitionShutdown,
+            "[ xdp][%p] XDP partition shutdown",
+            Partition);
+        CXPLAT_QUEUE* Queue = Partition->Queues;
+        while (Queue) {
+            CxPlatXdpQueueStopIo(Partition, Queue);
+            Queue = Queue->Next;
+        }
+        CxPlatEventQEnqueue(Partition->EventQ, &Partition->ShutdownSqe);
+        return FALSE;
+    }
+
+    const BOOLEAN PollingExpired =
+        CxPlatTimeDiff64(State->LastWorkTime, State->TimeNow) >= Xdp->PollingIdleTimeoutUs;
+    const BOOLEAN BusyPoll = !PollingExpired && Xdp->PollingIdleTimeoutUs != 0;
+
+    BOOLEAN DidWork = FALSE;
+    CXPLAT_QUEUE* Queue = Partition->Queues;
+    while (Queue) {
+        DidWork |= CxPlatXdpRx(Xdp, Queue, Partition->PartitionIndex, BusyPoll);
+        DidWork |= CxPlatXdpTx(Queue);
+        Queue = Queue->Next;
+    }
+
+    if (DidWork) {
+        Partition->Ec.Ready = TRUE;
+        State->NoWorkCount = 0;
+    } else if (!PollingExpired) {
+        Partition->Ec.Ready = TRUE;
+    } else {
+        Queue = Partition->Queues;
+        while (Queue) {
+            if (Queue->TxOutstanding > 0 || !CxPlatListIsEmpty(&Queue->PartitionTxQueue)) {
+                //
+                // TX completions are only reaped by polling the completion
+                // ring, so keep running until the TX ring drains.
+                //
+                Partition->Ec.Ready = TRUE;
+            }
+            if (!Queue->RxQueued) {
+                CxPlatXdpQueueWaitRx(Partition, Queue);
+            }
+            Queue = Queue->Next;
+        }
+    }
+
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatIoXdpWaitRxEventComplete(
+    _In_ CXPLAT_CQE* Cqe
+    )
+{
+    CXPLAT_SQE* Sqe = CxPlatCqeGetSqe(Cqe);
+    CXPLAT_QUEUE* Queue = CXPLAT_CONTAINING_RECORD(Sqe, CXPLAT_QUEUE, RxIoSqe);
+    QuicTraceLogVerbose(
+        XdpQueueAsyncIoRxComplete,
+        "[ xdp][%p] XDP async IO complete (RX)",
+        Queue);
+    Queue->RxQueued = FALSE;
+    Queue->Partition->Ec.Ready = TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatIoXdpShutdownEventComplete(
+    _In_ CXPLAT_CQE* Cqe
+    )
+{
+    CXPLAT_SQE* Sqe = CxPlatCqeGetSqe(Cqe);
+    XDP_PARTITION* Partition =
+        CXPLAT_CONTAINING_RECORD(Sqe, XDP_PARTITION, ShutdownSqe);
+    QuicTraceLogVerbose(
+        XdpPartitionShutdownComplete,
+        "[ xdp][%p] XDP partition shutdown complete",
+        Partition);
+    CxPlatXdpPartitionCleanupSqes(Partition, NULL);
+    CxPlatDpRawRelease((XDP_DATAPATH*)Partition->Xdp);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatDataPathRssConfigGet(
+    _In_ uint32_t InterfaceIndex,
+    _Outptr_ _At_(*RssConfig, __drv_allocatesMem(Mem))
+        CXPLAT_RSS_CONFIG** RssConfig
+    )
+{
+    UNREFERENCED_PARAMETER(InterfaceIndex);
+    UNREFERENCED_PARAMETER(RssConfig);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDataPathRssConfigFree(
+    _In_ CXPLAT_RSS_CONFIG* RssConfig
+    )
+{
+    UNREFERENCED_PARAMETER(RssConfig);
+    CXPLAT_FRE_ASSERTMSG(FALSE, "CxPlatDataPathRssConfigFree not supported");
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+QUIC_STATUS
+CxPlatDpRawInsertXskInMap(
+    _In_ XDP_INTERFACE* Interface,
+    _In_ QUIC_XDP_MAP_HANDLE XskMap
+    )
+{
+    for (uint32_t j = 0; j < Interface->QueueCount; j++) {
+        const uint32_t Fd = (uint32_t)Interface->Queues[j].Fd;
+        if (CxPlatBpfMapUpdate(XskMap, &j, &Fd) != 0) {
+            QUIC_STATUS Status = errno;
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                Status,
+                "bpf(BPF_MAP_UPDATE_ELEM, application XSKMAP)");
+            //
+            // On failure, best-effort removal of XSKs already inserted for this interface.
+            //
+            for (uint32_t k = 0; k < j; k++) {
+                (void)CxPlatBpfMapDelete(XskMap, &k);
+            }
+            return Status;
+        }
+    }
+    Interface->AppXskMap = XskMap;
+    Interface->MapConfigured = TRUE;
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+CxPlatDpRawRemoveXskFromMap(
+    _In_ XDP_INTERFACE* Interface
+    )
+{
+    if (!Interface->MapConfigured) {
+        return;
+    }
+    for (uint32_t j = 0; j < Interface->QueueCount; j++) {
+        if (CxPlatBpfMapDelete(Interface->AppXskMap, &j) != 0) {
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                errno,
+                "bpf(BPF_MAP_DELETE_ELEM, application XSKMAP)");
+        }
+    }
+    Interface->MapConfigured = FALSE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatDpRawApplyMapConfigs(
+    _In_ CXPLAT_DATAPATH_RAW* RawDataPath,
+    _In_reads_(MapConfigCount) const CXPLAT_XDP_MAP_CONFIG* MapConfigs,
+    _In_ uint32_t MapConfigCount
+    )
+{
+    XDP_DATAPATH* Xdp = (XDP_DATAPATH*)RawDataPath;
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+
+    for (CXPLAT_LIST_ENTRY* Entry = Xdp->Interfaces.Flink; Entry != &Xdp->Interfaces; Entry = Entry->Flink) {
+        XDP_INTERFACE* Interface = CXPLAT_CONTAINING_RECORD(Entry, XDP_INTERFACE, Link);
+
+        const CXPLAT_XDP_MAP_CONFIG* MapConfig = NULL;
+        for (uint32_t i = 0; i < MapConfigCount; i++) {
+            if (MapConfigs[i].InterfaceIndex == Interface->IfIndex) {
+                MapConfig = &MapConfigs[i];
+                break;
+            }
+        }
+
+        if (MapConfig == NULL) {
+            continue;
+        }
+
+        Status = CxPlatDpRawInsertXskInMap(Interface, MapConfig->MapHandle);
+        if (QUIC_FAILED(Status)) {
+            //
+            // On failure, best-effort removal of all XSKs on all interfaces.
+            //
+            CxPlatDpRawCleanupMapConfigs(RawDataPath);
+            goto Exit;
+        }
+    }
+
+Exit:
+
+    return Status;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDpRawCleanupMapConfigs(
+    _In_ CXPLAT_DATAPATH_RAW* RawDataPath
+    )
+{
+    XDP_DATAPATH* Xdp = (XDP_DATAPATH*)RawDataPath;
+
+    for (CXPLAT_LIST_ENTRY* Entry = Xdp->Interfaces.Flink; Entry != &Xdp->Interfaces; Entry = Entry->Flink) {
+        XDP_INTERFACE* Interface = CXPLAT_CONTAINING_RECORD(Entry, XDP_INTERFACE, Link);
+        CxPlatDpRawRemoveXskFromMap(Interface);
+    }
+}
+
+uint32_t
+CxPlatDpRawGetTotalRuleCount(
+    _In_ const CXPLAT_DATAPATH_RAW* RawDataPath
+    )
+{
+    const XDP_DATAPATH* Xdp = (const XDP_DATAPATH*)RawDataPath;
+    uint32_t TotalRuleCount = 0;
+    for (const CXPLAT_LIST_ENTRY* Entry = Xdp->Interfaces.Flink; Entry != &Xdp->Interfaces; Entry = Entry->Flink) {
+        const XDP_INTERFACE* Interface = CXPLAT_CONTAINING_RECORD(Entry, XDP_INTERFACE, Link);
+        if (Interface->XdpLink != INVALID_SOCKET) {
+            TotalRuleCount += Xdp->PortCount;
+        }
+    }
+    return TotalRuleCount;
+}
@@ -156,6 +156,24 @@ CxPlatDataPathGetXdpRuleCount(
     return CxPlatDpRawGetTotalRuleCount(Datapath->RawDataPath);
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint64_t
+CxPlatDataPathGetSendZeroCopyCount(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+#ifdef CXPLAT_USE_IO_URING
+    uint64_t Count = 0;
+    for (uint32_t i = 0; i < Datapath->PartitionCount; i++) {
+        Count += Datapath->Partitions[i].SendZeroCopyCount;
+    }
+    return Count;
+#else
+    UNREFERENCED_PARAMETER(Datapath);
+    return 0;
+#endif
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 CxPlatDataPathUpdatePollingIdleTimeout(
@@ -523,6 +541,42 @@ CxPlatSocketSend(
      }
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSocketSendBatched(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    )
+{
+#if defined(CX_PLATFORM_LINUX)
+    if (DatapathType(SendData) == CXPLAT_DATAPATH_TYPE_NORMAL) {
+        SocketSendBatched(Socket, Route, SendData, Batch);
+        return;
+    }
+#else
+    UNREFERENCED_PARAMETER(Batch);
+#endif
+    CxPlatSocketSend(Socket, Route, SendData);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSendBatchFlush(
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    )
+{
+#if defined(CX_PLATFORM_LINUX)
+    if (Batch->Count != 0) {
+        SendBatchFlush(Batch);
+    }
+#else
+    CXPLAT_DBG_ASSERT(Batch->Count == 0);
+    UNREFERENCED_PARAMETER(Batch);
+#endif
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicCopyRouteInfo(
@@ -753,6 +753,35 @@ typedef enum CXPLAT_SOCKET_IO_TAG {
     IoTagMax
 } CXPLAT_SOCKET_IO_TAG;
 
+#define CXPLAT_INVALID_FIXED_FILE_INDEX -1
+
+//
+// Tracks the slots of the sparse fixed (registered) file table of a
+// partition's io_uring.
+//
+typedef struct CXPLAT_FIXED_FILE_TABLE {
+    CXPLAT_LOCK Lock;
+
+    //
+    // The number of slots registered with the io_uring. Zero if the io_uring
+    // doesn't support a fixed file table.
+    //
+    uint32_t Capacity;
+
+    //
+    // All slots at or above this index have never been used.
+    //
+    uint32_t NextUnused;
+
+    //
+    // Stack of released slots available for reuse. Grown on demand.
+    //
+    uint32_t* FreeSlots;
+    uint32_t FreeSlotCount;
+    uint32_t FreeSlotsLength;
+
+} CXPLAT_FIXED_FILE_TABLE;
+
 #endif // CXPLAT_USE_IO_URING
 
 //
@@ -775,6 +804,14 @@ typedef struct QUIC_CACHEALIGN CXPLAT_SOCKET_CONTEXT {
     //
     int SocketFd;
 
+#ifdef CXPLAT_USE_IO_URING
+    //
+    // The index of the socket in the partition's fixed file table, or
+    // CXPLAT_INVALID_FIXED_FILE_INDEX if SQEs use the raw socket FD.
+    //
+    int FixedFileIndex;
+#endif
+
     //
     // The submission queue event for shutdown.
     //
@@ -920,6 +957,11 @@ typedef struct CXPLAT_REGISTERED_BUFFER_POOL {
     uint32_t BufferSize;
     uint32_t TotalSize;
     CXPLAT_LOCK Lock;
+    //
+    // Buffers not currently in use. Only used by pools registered as fixed
+    // buffers, which have no provided buffer ring.
+    //
+    CXPLAT_SLIST_ENTRY FreeList;
 } CXPLAT_REGISTERED_BUFFER_POOL;
 
 //
@@ -953,9 +995,9 @@ typedef struct QUIC_CACHEALIGN CXPLAT_DATAPATH_PARTITION {
 
     //
     // Pool of receive packet contexts and buffers to be shared by all sockets
-    // on this core.
+    // on this core. Pruned by the partition's worker.
     //
-    CXPLAT_POOL RecvBlockPool;
+    CXPLAT_POOL_EX RecvBlockPool;
 
 #ifdef CXPLAT_USE_IO_URING
     //
@@ -966,15 +1008,25 @@ typedef struct QUIC_CACHEALIGN CXPLAT_DATAPATH_PARTITION {
 
     //
     // Pool of send packet contexts and buffers to be shared by all sockets
-    // on this core.
+    // on this core. Pruned by the partition's worker.
     //
-    CXPLAT_POOL SendBlockPool;
+    CXPLAT_POOL_EX SendBlockPool;
 
 #ifdef CXPLAT_USE_IO_URING
     //
     // Backing pool of registered buffers for the SendBlockPool.
     //
     CXPLAT_REGISTERED_BUFFER_POOL SendRegisteredBufferPool;
+
+    //
+    // The number of sends submitted as zero-copy on this partition.
+    //
+    uint64_t SendZeroCopyCount;
+
+    //
+    // Fixed file table for the sockets on this partition.
+    //
+    CXPLAT_FIXED_FILE_TABLE FixedFiles;
 #endif
 
     //
@@ -1039,6 +1091,14 @@ typedef struct CXPLAT_DATAPATH {
 
     uint8_t ReserveAuxTcpSockForQtip : 1;
 
+#ifdef CXPLAT_USE_IO_URING
+    //
+    // Indicates zero-copy sends may reference the registered send buffers
+    // directly (IORING_RECVSEND_FIXED_BUF) instead of pinning pages per send.
+    //
+    uint8_t SendZeroCopyFixedBuffers : 1;
+#endif
+
     //
     // The per proc datapath contexts.
     //
@@ -1170,6 +1230,25 @@ SocketSend(
     _In_ CXPLAT_SEND_DATA* SendData
     );
 
+#if defined(CX_PLATFORM_LINUX)
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+SocketSendBatched(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+SendBatchFlush(
+    _Inout_ CXPLAT_SEND_BATCH* Batch
+    );
+
+#endif // CX_PLATFORM_LINUX
+
 CXPLAT_SOCKET*
 CxPlatRawToSocket(
     _In_ CXPLAT_SOCKET_RAW* Socket
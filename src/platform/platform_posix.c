@@ -563,6 +563,619 @@ CxPlatProcCurrentNumber(
 #endif // CX_PLATFORM_DARWIN
 }
 
+//
+// Memory pool
+//
+
+static
+uint32_t
+CxPlatPoolNodeOfCpu(
+    _In_ const CXPLAT_POOL* Pool,
+    _In_ uint32_t Cpu
+    )
+{
+#ifdef CXPLAT_NUMA_AWARE
+    if (Pool->DepotCount > 1) {
+        const int Node = numa_node_of_cpu((int)Cpu);
+        if (Node > 0 && (uint32_t)Node < Pool->DepotCount) {
+            return (uint32_t)Node;
+        }
+    }
+#else
+    UNREFERENCED_PARAMETER(Pool);
+    UNREFERENCED_PARAMETER(Cpu);
+#endif
+    return 0;
+}
+
+static
+CXPLAT_POOL_HEADER*
+CxPlatPoolAllocEntryOnNode(
+    _In_ const CXPLAT_POOL* Pool,
+    _In_ uint32_t Node
+    )
+{
+    //
+    // New memory is first touched by the allocating CPU, so the kernel places
+    // it on that CPU's node.
+    //
+    CXPLAT_POOL_HEADER* Header = (CXPLAT_POOL_HEADER*)CxPlatAlloc(Pool->Size, Pool->Tag);
+    if (Header != NULL) {
+        Header->Node = Node;
+    }
+    return Header;
+}
+
+CXPLAT_POOL_HEADER*
+CxPlatPoolAllocEntry(
+    _Inout_ CXPLAT_POOL* Pool
+    )
+{
+    return CxPlatPoolAllocEntryOnNode(Pool, 0);
+}
+
+static
+CXPLAT_POOL_MAGAZINE*
+CxPlatPoolMagazineAlloc(
+    void
+    )
+{
+    CXPLAT_POOL_MAGAZINE* Magazine =
+        CXPLAT_ALLOC_NONPAGED(sizeof(CXPLAT_POOL_MAGAZINE), QUIC_POOL_PLATFORM_POOL);
+    if (Magazine != NULL) {
+        Magazine->Next = NULL;
+        Magazine->Count = 0;
+    }
+    return Magazine;
+}
+
+static
+void
+CxPlatPoolMagazineFreeEntries(
+    _In_ const CXPLAT_POOL* Pool,
+    _Inout_ CXPLAT_POOL_MAGAZINE* Magazine
+    )
+{
+    for (uint32_t i = 0; i < Magazine->Count; ++i) {
+        CXPLAT_POOL_HEADER* Header = (CXPLAT_POOL_HEADER*)Magazine->Entries[i];
+        CXPLAT_DBG_ASSERT(Header->SpecialFlag == CXPLAT_POOL_FREE_FLAG);
+        CxPlatFree(Header, Pool->Tag);
+    }
+    Magazine->Count = 0;
+}
+
+static
+void
+CxPlatPoolMagazineFree(
+    _In_ const CXPLAT_POOL* Pool,
+    _In_opt_ CXPLAT_POOL_MAGAZINE* Magazine
+    )
+{
+    if (Magazine != NULL) {
+        CxPlatPoolMagazineFreeEntries(Pool, Magazine);
+        CXPLAT_FREE(Magazine, QUIC_POOL_PLATFORM_POOL);
+    }
+}
+
+static
+CXPLAT_POOL_CPU_CACHE*
+CxPlatPoolCacheCreate(
+    _In_ const CXPLAT_POOL* Pool,
+    _In_ uint32_t Cpu
+    )
+{
+    CXPLAT_POOL_CPU_CACHE* Cache =
+        CXPLAT_ALLOC_NONPAGED(sizeof(CXPLAT_POOL_CPU_CACHE), QUIC_POOL_PLATFORM_POOL);
+    if (Cache == NULL) {
+        return NULL;
+    }
+    Cache->Loaded = CxPlatPoolMagazineAlloc();
+    Cache->Previous = CxPlatPoolMagazineAlloc();
+    if (Cache->Loaded == NULL || Cache->Previous == NULL) {
+        CxPlatPoolMagazineFree(Pool, Cache->Loaded);
+        CxPlatPoolMagazineFree(Pool, Cache->Previous);
+        CXPLAT_FREE(Cache, QUIC_POOL_PLATFORM_POOL);
+        return NULL;
+    }
+    Cache->Node = CxPlatPoolNodeOfCpu(Pool, Cpu);
+    Cache->Idle = FALSE;
+    return Cache;
+}
+
+//
+// The most full magazines a depot can hold within CXPLAT_POOL_MAXIMUM_DEPOT_SIZE
+// bytes of entries. Bounded by bytes rather than entries, as entry sizes range
+// from tens of bytes to tens of kilobytes.
+//
+static
+uint32_t
+CxPlatPoolDepotSizeFullCount(
+    _In_ const CXPLAT_POOL* Pool
+    )
+{
+    uint32_t FullCount =
+        CXPLAT_POOL_MAXIMUM_DEPOT_SIZE / (Pool->Size * CXPLAT_POOL_MAGAZINE_SIZE);
+    if (FullCount > CXPLAT_POOL_MAXIMUM_DEPTH / CXPLAT_POOL_MAGAZINE_SIZE) {
+        FullCount = CXPLAT_POOL_MAXIMUM_DEPTH / CXPLAT_POOL_MAGAZINE_SIZE;
+    } else if (FullCount == 0) {
+        FullCount = 1;
+    }
+    return FullCount;
+}
+
+//
+// The number of full magazines a depot keeps before it has to grow.
+//
+static
+uint32_t
+CxPlatPoolDefaultFullCount(
+    _In_ const CXPLAT_POOL* Pool
+    )
+{
+    return
+        CXPLAT_MIN(
+            CXPLAT_POOL_DEFAULT_MAX_DEPTH / CXPLAT_POOL_MAGAZINE_SIZE,
+            CxPlatPoolDepotSizeFullCount(Pool));
+}
+
+//
+// Must be called with the depot lock held. Returns TRUE if the depot can take
+// another full magazine.
+//
+static
+BOOLEAN
+CxPlatPoolDepotHasRoom(
+    _In_ const CXPLAT_POOL* Pool,
+    _Inout_ CXPLAT_POOL_DEPOT* Depot
+    )
+{
+    if (Depot->FullCount >= Depot->MaxFullCount &&
+        Depot->Underflowed &&
+        Depot->MaxFullCount < Pool->MaxDepotFullCount) {
+        //
+        // The depot both ran dry and filled up since it was last resized, so
+        // the working set is larger than the depot.
+        //
+        Depot->MaxFullCount = CXPLAT_MIN(Depot->MaxFullCount * 2, Pool->MaxDepotFullCount);
+        Depot->Underflowed = FALSE;
+    }
+    return Depot->FullCount < Depot->MaxFullCount;
+}
+
+//
+// Must be called with the depot lock held.
+//
+static
+CXPLAT_POOL_MAGAZINE*
+CxPlatPoolDepotPopEmpty(
+    _Inout_ CXPLAT_POOL_DEPOT* Depot
+    )
+{
+    CXPLAT_POOL_MAGAZINE* Magazine = Depot->Empty;
+    if (Magazine != NULL) {
+        Depot->Empty = Magazine->Next;
+        Depot->EmptyCount--;
+        return Magazine;
+    }
+    return CxPlatPoolMagazineAlloc();
+}
+
+//
+// Must be called with the depot lock held. Returns FALSE if the depot already
+// holds enough empty magazines and the caller should free this one.
+//
+static
+BOOLEAN
+CxPlatPoolDepotPushEmpty(
+    _Inout_ CXPLAT_POOL_DEPOT* Depot,
+    _In_ CXPLAT_POOL_MAGAZINE* Magazine
+    )
+{
+    CXPLAT_DBG_ASSERT(Magazine->Count == 0);
+    if (Depot->EmptyCount >= Depot->MaxFullCount) {
+        return FALSE;
+    }
+    Magazine->Next = Depot->Empty;
+    Depot->Empty = Magazine;
+    Depot->EmptyCount++;
+    return TRUE;
+}
+
+//
+// Exchanges an empty magazine for a full one. Returns NULL, leaving the empty
+// magazine with the caller, if the depot has no full magazines.
+//
+static
+CXPLAT_POOL_MAGAZINE*
+CxPlatPoolDepotGetFull(
+    _In_ const CXPLAT_POOL* Pool,
+    _Inout_ CXPLAT_POOL_DEPOT* Depot,
+    _In_ CXPLAT_POOL_MAGAZINE* Empty
+    )
+{
+    BOOLEAN FreeEmpty = FALSE;
+    CxPlatLockAcquire(&Depot->Lock);
+    CXPLAT_POOL_MAGAZINE* Full = Depot->Full;
+    if (Full != NULL) {
+        Depot->Full = Full->Next;
+        Depot->FullCount--;
+        FreeEmpty = !CxPlatPoolDepotPushEmpty(Depot, Empty);
+    } else {
+        Depot->Underflowed = TRUE;
+    }
+    CxPlatLockRelease(&Depot->Lock);
+    if (FreeEmpty) {
+        CxPlatPoolMagazineFree(Pool, Empty);
+    }
+    return Full;
+}
+
+//
+// Exchanges a full magazine for an empty one. If the depot is at its maximum
+// depth, the entries are freed instead and the same magazine returned.
+//
+static
+CXPLAT_POOL_MAGAZINE*
+CxPlatPoolDepotPutFull(
+    _In_ const CXPLAT_POOL* Pool,
+    _Inout_ CXPLAT_POOL_DEPOT* Depot,
+    _In_ CXPLAT_POOL_MAGAZINE* Full
+    )
+{
+    CXPLAT_POOL_MAGAZINE* Empty = NULL;
+    CxPlatLockAcquire(&Depot->Lock);
+    if (CxPlatPoolDepotHasRoom(Pool, Depot)) {
+        Empty = CxPlatPoolDepotPopEmpty(Depot);
+        if (Empty != NULL) {
+            Full->Next = Depot->Full;
+            Depot->Full = Full;
+            Depot->FullCount++;
+        }
+    }
+    CxPlatLockRelease(&Depot->Lock);
+    if (Empty == NULL) {
+        CxPlatPoolMagazineFreeEntries(Pool, Full);
+        Empty = Full;
+    }
+    return Empty;
+}
+
+//
+// Pops a single entry from the depot's partial magazine.
+//
+static
+CXPLAT_POOL_HEADER*
+CxPlatPoolDepotPop(
+    _Inout_ CXPLAT_POOL_DEPOT* Depot
+    )
+{
+    CXPLAT_POOL_HEADER* Header = NULL;
+    CxPlatLockAcquire(&Depot->Lock);
+    CXPLAT_POOL_MAGAZINE* Partial = Depot->Partial;
+    if ((Partial == NULL || Partial->Count == 0) && Depot->Full != NULL) {
+        if (Partial != NULL && !CxPlatPoolDepotPushEmpty(Depot, Partial)) {
+            CXPLAT_FREE(Partial, QUIC_POOL_PLATFORM_POOL);
+        }
+        Partial = Depot->Full;
+        Depot->Full = Partial->Next;
+        Depot->FullCount--;
+        Depot->Partial = Partial;
+    }
+    if (Partial != NULL && Partial->Count != 0) {
+        Header = (CXPLAT_POOL_HEADER*)Partial->Entries[--Partial->Count];
+    } else {
+        Depot->Underflowed = TRUE;
+    }
+    CxPlatLockRelease(&Depot->Lock);
+    return Header;
+}
+
+//
+// Pushes a single entry to the depot's partial magazine. Returns FALSE if the
+// depot is full and the caller should free the entry.
+//
+static
+BOOLEAN
+CxPlatPoolDepotPush(
+    _In_ const CXPLAT_POOL* Pool,
+    _Inout_ CXPLAT_POOL_DEPOT* Depot,
+    _In_ CXPLAT_POOL_HEADER* Header
+    )
+{
+    BOOLEAN Pushed = FALSE;
+    CxPlatLockAcquire(&Depot->Lock);
+    CXPLAT_POOL_MAGAZINE* Partial = Depot->Partial;
+    if (Partial != NULL &&
+        Partial->Count == CXPLAT_POOL_MAGAZINE_SIZE &&
+        CxPlatPoolDepotHasRoom(Pool, Depot)) {
+        Partial->Next = Depot->Full;
+        Depot->Full = Partial;
+        Depot->FullCount++;
+        Depot->Partial = Partial = NULL;
+    }
+    if (Partial == NULL) {
+        Depot->Partial = Partial = CxPlatPoolDepotPopEmpty(Depot);
+    }
+    if (Partial != NULL && Partial->Count < CXPLAT_POOL_MAGAZINE_SIZE) {
+        Partial->Entries[Partial->Count++] = Header;
+        Pushed = TRUE;
+    }
+    CxPlatLockRelease(&Depot->Lock);
+    return Pushed;
+}
+
+void
+CxPlatPoolInitialize(
+    _In_ BOOLEAN IsPaged,
+    _In_ uint32_t Size,
+    _In_ uint32_t Tag,
+    _Inout_ CXPLAT_POOL* Pool
+    )
+{
+    UNREFERENCED_PARAMETER(IsPaged);
+    Pool->Size = Size + sizeof(CXPLAT_POOL_HEADER); // Add space for the pool header
+    Pool->Tag = Tag;
+    Pool->Cpus = NULL;
+    Pool->MaxDepotFullCount = CxPlatPoolDefaultFullCount(Pool);
+    Pool->Depots = &Pool->LocalDepot;
+    Pool->DepotCount = 1;
+
+#ifndef DISABLE_CXPLAT_POOL
+#ifdef CXPLAT_NUMA_AWARE
+    if (CxPlatNumaNodeCount > 1) {
+        CXPLAT_POOL_DEPOT* Depots =
+            CXPLAT_ALLOC_NONPAGED(
+                sizeof(CXPLAT_POOL_DEPOT) * CxPlatNumaNodeCount,
+                QUIC_POOL_PLATFORM_POOL);
+        if (Depots != NULL) {
+            Pool->Depots = Depots;
+            Pool->DepotCount = CxPlatNumaNodeCount;
+        }
+    }
+#endif
+    Pool->Cpus =
+        CXPLAT_ALLOC_NONPAGED(
+            sizeof(CXPLAT_POOL_CPU_CACHE*) * CxPlatProcCount(),
+            QUIC_POOL_PLATFORM_POOL);
+    if (Pool->Cpus != NULL) {
+        CxPlatZeroMemory(
+            (void*)Pool->Cpus, sizeof(CXPLAT_POOL_CPU_CACHE*) * CxPlatProcCount());
+    }
+#endif
+
+    for (uint32_t i = 0; i < Pool->DepotCount; ++i) {
+        CXPLAT_POOL_DEPOT* Depot = &Pool->Depots[i];
+        CxPlatZeroMemory(Depot, sizeof(*Depot));
+        CxPlatLockInitialize(&Depot->Lock);
+        Depot->MaxFullCount = CxPlatPoolDefaultFullCount(Pool);
+    }
+}
+
+void
+CxPlatPoolUninitialize(
+    _Inout_ CXPLAT_POOL* Pool
+    )
+{
+    if (Pool->Cpus != NULL) {
+        for (uint32_t i = 0; i < CxPlatProcCount(); ++i) {
+            CXPLAT_POOL_CPU_CACHE* Cache = Pool->Cpus[i];
+            CXPLAT_DBG_ASSERT(Cache != CXPLAT_POOL_CPU_CACHE_BUSY);
+            if (CxPlatPoolIsCacheValid(Cache)) {
+                CxPlatPoolMagazineFree(Pool, Cache->Loaded);
+                CxPlatPoolMagazineFree(Pool, Cache->Previous);
+                CXPLAT_FREE(Cache, QUIC_POOL_PLATFORM_POOL);
+            }
+        }
+        CXPLAT_FREE((void*)Pool->Cpus, QUIC_POOL_PLATFORM_POOL);
+        Pool->Cpus = NULL;
+    }
+
+    for (uint32_t i = 0; i < Pool->DepotCount; ++i) {
+        CXPLAT_POOL_DEPOT* Depot = &Pool->Depots[i];
+        CXPLAT_POOL_MAGAZINE* Magazine;
+        CxPlatPoolMagazineFree(Pool, Depot->Partial);
+        while ((Magazine = Depot->Full) != NULL) {
+            Depot->Full = Magazine->Next;
+            CxPlatPoolMagazineFree(Pool, Magazine);
+        }
+        while ((Magazine = Depot->Empty) != NULL) {
+            Depot->Empty = Magazine->Next;
+            CxPlatPoolMagazineFree(Pool, Magazine);
+        }
+        CxPlatLockUninitialize(&Depot->Lock);
+    }
+    if (Pool->Depots != &Pool->LocalDepot) {
+        CXPLAT_FREE(Pool->Depots, QUIC_POOL_PLATFORM_POOL);
+    }
+    Pool->Depots = NULL;
+    Pool->DepotCount = 0;
+}
+
+CXPLAT_POOL_HEADER*
+CxPlatPoolAllocSlow(
+    _Inout_ CXPLAT_POOL* Pool,
+    _In_ uint32_t Cpu,
+    _In_opt_ CXPLAT_POOL_CPU_CACHE* Cache
+    )
+{
+    CXPLAT_POOL_HEADER* Header = NULL;
+    uint32_t Node;
+
+    if (Cache == NULL && Pool->Cpus != NULL) {
+        //
+        // First use of the pool on this CPU.
+        //
+        Cache = CxPlatPoolCacheCreate(Pool, Cpu);
+        if (Cache == NULL) {
+            __atomic_store_n(&Pool->Cpus[Cpu], NULL, __ATOMIC_RELEASE);
+        }
+    }
+
+    if (CxPlatPoolIsCacheValid(Cache)) {
+        CXPLAT_POOL_MAGAZINE* Loaded = Cache->Loaded;
+        Cache->Idle = FALSE;
+        if (Loaded->Count == 0) {
+            if (Cache->Previous->Count != 0) {
+                Cache->Loaded = Cache->Previous;
+                Cache->Previous = Loaded;
+            } else {
+                CXPLAT_POOL_MAGAZINE* Full =
+                    CxPlatPoolDepotGetFull(Pool, &Pool->Depots[Cache->Node], Cache->Previous);
+                if (Full != NULL) {
+                    Cache->Previous = Loaded;
+                    Cache->Loaded = Full;
+                }
+            }
+        }
+        if (Cache->Loaded->Count != 0) {
+            Header = (CXPLAT_POOL_HEADER*)Cache->Loaded->Entries[--Cache->Loaded->Count];
+        }
+        Node = Cache->Node;
+        __atomic_store_n(&Pool->Cpus[Cpu], Cache, __ATOMIC_RELEASE);
+
+    } else {
+        //
+        // Another thread is using this CPU's cache (it was preempted or
+        // migrated while holding it) or there is none.
+        //
+        Node = CxPlatPoolNodeOfCpu(Pool, Cpu);
+        Header = CxPlatPoolDepotPop(&Pool->Depots[Node]);
+    }
+
+    if (Header == NULL) {
+        Header = CxPlatPoolAllocEntryOnNode(Pool, Node);
+    } else {
+        CXPLAT_DBG_ASSERT(Header->SpecialFlag == CXPLAT_POOL_FREE_FLAG);
+    }
+    return Header;
+}
+
+void
+CxPlatPoolFreeSlow(
+    _Inout_ CXPLAT_POOL* Pool,
+    _In_ uint32_t Cpu,
+    _In_opt_ CXPLAT_POOL_CPU_CACHE* Cache,
+    _In_ CXPLAT_POOL_HEADER* Header
+    )
+{
+    if (Cache == NULL && Pool->Cpus != NULL) {
+        //
+        // First use of the pool on this CPU.
+        //
+        Cache = CxPlatPoolCacheCreate(Pool, Cpu);
+        if (Cache == NULL) {
+            __atomic_store_n(&Pool->Cpus[Cpu], NULL, __ATOMIC_RELEASE);
+        }
+    }
+
+    if (CxPlatPoolIsCacheValid(Cache)) {
+        Cache->Idle = FALSE;
+        if (Cache->Node == Header->Node) {
+            CXPLAT_POOL_MAGAZINE* Loaded = Cache->Loaded;
+            if (Loaded->Count == CXPLAT_POOL_MAGAZINE_SIZE) {
+                if (Cache->Previous->Count == 0) {
+                    Cache->Loaded = Cache->Previous;
+                } else {
+                    Cache->Loaded =
+                        CxPlatPoolDepotPutFull(Pool, &Pool->Depots[Cache->Node], Cache->Previous);
+                }
+                Cache->Previous = Loaded;
+            }
+            Cache->Loaded->Entries[Cache->Loaded->Count++] = Header;
+            __atomic_store_n(&Pool->Cpus[Cpu], Cache, __ATOMIC_RELEASE);
+            return;
+        }
+        __atomic_store_n(&Pool->Cpus[Cpu], Cache, __ATOMIC_RELEASE);
+    }
+
+    //
+    // The entry goes back to its own node's depot.
+    //
+    CXPLAT_DBG_ASSERT(Header->Node < Pool->DepotCount);
+    if (!CxPlatPoolDepotPush(Pool, &Pool->Depots[Header->Node], Header)) {
+        CxPlatFree(Header, Pool->Tag);
+    }
+}
+
+void
+CxPlatPoolAllowGrowth(
+    _Inout_ CXPLAT_POOL* Pool
+    )
+{
+    Pool->MaxDepotFullCount = CxPlatPoolDepotSizeFullCount(Pool);
+}
+
+BOOLEAN
+CxPlatPoolPrune(
+    _Inout_ CXPLAT_POOL* Pool
+    )
+{
+    for (uint32_t i = 0; i < Pool->DepotCount; ++i) {
+        CXPLAT_POOL_DEPOT* Depot = &Pool->Depots[i];
+        CxPlatLockAcquire(&Depot->Lock);
+        CXPLAT_POOL_MAGAZINE* Full = Depot->Full;
+        if (Full != NULL) {
+            Depot->Full = Full->Next;
+            Depot->FullCount--;
+        } else {
+            Depot->MaxFullCount = CxPlatPoolDefaultFullCount(Pool);
+            Depot->Underflowed = FALSE;
+        }
+        CxPlatLockRelease(&Depot->Lock);
+        if (Full != NULL) {
+            CxPlatPoolMagazineFree(Pool, Full);
+            return TRUE;
+        }
+    }
+
+    if (Pool->Cpus == NULL) {
+        return FALSE;
+    }
+
+    //
+    // Each CPU can hold two magazines of entries it may never use again. Free
+    // those of a CPU that was idle for a whole pruning period. The cache is
+    // taken the same way the CPU itself does, and skipped if it's in use.
+    //
+    for (uint32_t i = 0; i < CxPlatProcCount(); ++i) {
+        CXPLAT_POOL_CPU_CACHE* Cache =
+            (CXPLAT_POOL_CPU_CACHE*)InterlockedExchangePointer(
+                (void* volatile*)&Pool->Cpus[i], CXPLAT_POOL_CPU_CACHE_BUSY);
+        if (Cache == CXPLAT_POOL_CPU_CACHE_BUSY) {
+            continue; // The owner puts it back.
+        }
+        BOOLEAN Trimmed = FALSE;
+        if (Cache != NULL &&
+            Cache->Idle &&
+            (Cache->Loaded->Count != 0 || Cache->Previous->Count != 0)) {
+            CxPlatPoolMagazineFreeEntries(Pool, Cache->Loaded);
+            CxPlatPoolMagazineFreeEntries(Pool, Cache->Previous);
+            Trimmed = TRUE;
+        }
+        __atomic_store_n(&Pool->Cpus[i], Cache, __ATOMIC_RELEASE);
+        if (Trimmed) {
+            return TRUE;
+        }
+    }
+
+    //
+    // Nothing left to free. Start the next idle period.
+    //
+    for (uint32_t i = 0; i < CxPlatProcCount(); ++i) {
+        CXPLAT_POOL_CPU_CACHE* Cache =
+            (CXPLAT_POOL_CPU_CACHE*)InterlockedExchangePointer(
+                (void* volatile*)&Pool->Cpus[i], CXPLAT_POOL_CPU_CACHE_BUSY);
+        if (Cache == CXPLAT_POOL_CPU_CACHE_BUSY) {
+            continue;
+        }
+        if (Cache != NULL) {
+            Cache->Idle = TRUE;
+        }
+        __atomic_store_n(&Pool->Cpus[i], Cache, __ATOMIC_RELEASE);
+    }
+    return FALSE;
+}
+
 QUIC_STATUS
 CxPlatRandom(
     _In_ uint32_t BufferLen,
@@ -680,6 +680,7 @@ CxPlatAddDynamicPoolAllocator(
     CXPLAT_FRE_ASSERT(Index < WorkerPool->WorkerCount);
     CXPLAT_WORKER* Worker = &WorkerPool->Workers[Index];
     Pool->Owner = Worker;
+    CxPlatPoolAllowGrowth(&Pool->Base); // Pruning returns what it grows by.
     CxPlatLockAcquire(&Worker->ECLock);
     CxPlatListInsertTail(&Worker->DynamicPoolList, &Pool->Link);
     CxPlatLockRelease(&Worker->ECLock);
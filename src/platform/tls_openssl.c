@@ -67,6 +67,12 @@ typedef struct CXPLAT_SEC_CONFIG {
     //
     CXPLAT_TLS_CREDENTIAL_FLAGS TlsFlags;
 
+    //
+    // Threads that produce the signed server flight for full handshakes, when
+    // QUIC_CREDENTIAL_FLAG_ASYNC_SIGNING is set.
+    //
+    struct CXPLAT_TLS_SIGNING_POOL* SigningPool;
+
 } CXPLAT_SEC_CONFIG;
 
 //
@@ -103,6 +109,11 @@ typedef struct CXPLAT_TLS {
     //
     BOOLEAN PeerTPReceived : 1;
 
+    //
+    // Indicates the server's first flight has been handed to the signing pool.
+    //
+    BOOLEAN SigningOffloaded : 1;
+
     //
     // QUIC transport parameter extension type used in the session.
     //
@@ -148,6 +159,18 @@ typedef struct CXPLAT_TLS {
     //
     QUIC_TLS_SECRETS* TlsSecrets;
 
+    //
+    // Entry in the signing pool's queue.
+    //
+    CXPLAT_LIST_ENTRY SigningLink;
+
+    //
+    // Processing state written by the signing pool, so the connection's state
+    // is left alone while the pool runs. Merged back into the connection's
+    // state by CxPlatTlsProcessDataComplete.
+    //
+    CXPLAT_TLS_PROCESS_STATE SigningState;
+
 } CXPLAT_TLS;
 
 //
@@ -288,51 +311,26 @@ CxPlatTlsNegotiatedCiphers(
 }
 
 //
-// @brief Callback to send TLS handshake data to the QUIC stack.
-//
-// This function is called by OpenSSL to send handshake data over QUIC.
-// It submits the provided buffer to the QUIC connection for transmission.
-// If the submission fails, it sets the TLS error on the QUIC connection.
+// @brief Grows the processing state's buffer to hold at least the given length.
 //
-// @param[in]  s           Pointer to the SSL connection object.
-// @param[in]  buf         Pointer to the buffer containing data to send.
-// @param[in]  buf_len     Length of the data in @p buf.
-// @param[out] consumed    Number of bytes successfully consumed from @p buf.
-// @param[in]  arg         Unused argument (typically NULL).
+// @param[in] TlsContext            The TLS context that owns the state.
+// @param[in,out] TlsState          The processing state whose buffer is grown.
+// @param[in] RequiredBufferLength  The total number of bytes needed.
 //
-// @return 1 on success, -1 on failure.
+// @return TRUE on success; FALSE (with the error result flag set) otherwise.
 //
-static int QuicTlsSend(SSL *s, const unsigned char *Buf,
-                         size_t BufLen, size_t *Consumed,
-                         void *Arg)
+static
+BOOLEAN
+CxPlatTlsReserveBuffer(
+    _In_ CXPLAT_TLS* TlsContext,
+    _Inout_ CXPLAT_TLS_PROCESS_STATE* TlsState,
+    _In_ size_t RequiredBufferLength
+    )
 {
-    CXPLAT_TLS* TlsContext = SSL_get_app_data(s);
-    CXPLAT_TLS_PROCESS_STATE* TlsState = TlsContext->State;
-    struct AUX_DATA *AData = GetSslAuxData(s);
-
-    UNREFERENCED_PARAMETER(Arg);
-
-    //
-    // KeyTypes in msquic map directly to our protection levels
-    //
-    QUIC_PACKET_KEY_TYPE KeyType = (QUIC_PACKET_KEY_TYPE)AData->Level;
-
-    if (TlsContext->ResultFlags & CXPLAT_TLS_RESULT_ERROR) {
-        return -1;
-    }
-
-    QuicTraceLogConnVerbose(
-        OpenSslAddHandshakeData,
-        TlsContext->Connection,
-        "Sending %llu handshake bytes (Level = %u)",
-        (uint64_t)BufLen,
-        (uint32_t)AData->Level);
-
     //
     // Cap the buffer at 0x8000, the largest power of two that fits a uint16_t,
     // so the doubling growth below cannot overflow.
     //
-    size_t RequiredBufferLength = BufLen + TlsState->BufferLength;
     if (RequiredBufferLength > 0x8000) {
         QuicTraceEvent(
             TlsError,
@@ -340,7 +338,7 @@ static int QuicTlsSend(SSL *s, const unsigned char *Buf,
             TlsContext->Connection,
             "Too much handshake data");
         TlsContext->ResultFlags |= CXPLAT_TLS_RESULT_ERROR;
-        return -1;
+        return FALSE;
     }
 
     if (RequiredBufferLength > (size_t)TlsState->BufferAllocLength) {
@@ -361,7 +359,7 @@ static int QuicTlsSend(SSL *s, const unsigned char *Buf,
                 "New crypto Buffer",
                 NewBufferAllocLength);
             TlsContext->ResultFlags |= CXPLAT_TLS_RESULT_ERROR;
-            return -1;
+            return FALSE;
         }
 
         CxPlatCopyMemory(
@@ -373,6 +371,54 @@ static int QuicTlsSend(SSL *s, const unsigned char *Buf,
         TlsState->BufferAllocLength = NewBufferAllocLength;
     }
 
+    return TRUE;
+}
+
+//
+// @brief Callback to send TLS handshake data to the QUIC stack.
+//
+// This function is called by OpenSSL to send handshake data over QUIC.
+// It submits the provided buffer to the QUIC connection for transmission.
+// If the submission fails, it sets the TLS error on the QUIC connection.
+//
+// @param[in]  s           Pointer to the SSL connection object.
+// @param[in]  buf         Pointer to the buffer containing data to send.
+// @param[in]  buf_len     Length of the data in @p buf.
+// @param[out] consumed    Number of bytes successfully consumed from @p buf.
+// @param[in]  arg         Unused argument (typically NULL).
+//
+// @return 1 on success, -1 on failure.
+//
+static int QuicTlsSend(SSL *s, const unsigned char *Buf,
+                         size_t BufLen, size_t *Consumed,
+                         void *Arg)
+{
+    CXPLAT_TLS* TlsContext = SSL_get_app_data(s);
+    CXPLAT_TLS_PROCESS_STATE* TlsState = TlsContext->State;
+    struct AUX_DATA *AData = GetSslAuxData(s);
+
+    UNREFERENCED_PARAMETER(Arg);
+
+    //
+    // KeyTypes in msquic map directly to our protection levels
+    //
+    QUIC_PACKET_KEY_TYPE KeyType = (QUIC_PACKET_KEY_TYPE)AData->Level;
+
+    if (TlsContext->ResultFlags & CXPLAT_TLS_RESULT_ERROR) {
+        return -1;
+    }
+
+    QuicTraceLogConnVerbose(
+        OpenSslAddHandshakeData,
+        TlsContext->Connection,
+        "Sending %llu handshake bytes (Level = %u)",
+        (uint64_t)BufLen,
+        (uint32_t)AData->Level);
+
+    if (!CxPlatTlsReserveBuffer(TlsContext, TlsState, BufLen + TlsState->BufferLength)) {
+        return -1;
+    }
+
     switch (KeyType) {
     case QUIC_PACKET_KEY_HANDSHAKE:
         if (TlsState->BufferOffsetHandshake == 0) {
@@ -1181,6 +1227,8 @@ CxPlatTlsFlushFlightCallback(
 //     If the transport parameters were successfully found.
 // @retval SSL_CLIENT_HELLO_ERROR
 //     If an error occurred and the handshake should be aborted.
+// @retval SSL_CLIENT_HELLO_RETRY
+//     If the rest of the handshake step should run on the signing pool.
 //
 // @note The QUIC transport parameters are expected to be present in
 //       the ClientHello as a custom TLS extension.
@@ -1210,6 +1258,24 @@ CxPlatTlsClientHelloCallback(
         return SSL_CLIENT_HELLO_ERROR;
     }
 
+    if ((TlsContext->SecConfig->Flags & QUIC_CREDENTIAL_FLAG_ASYNC_SIGNING) &&
+        !TlsContext->SigningOffloaded) {
+        //
+        // Only full handshakes sign anything. A ClientHello with a PSK is most
+        // likely a resumption, so it stays on the connection's worker.
+        //
+        const uint8_t* Psk;
+        size_t PskLength;
+        if (!SSL_client_hello_get0_ext(Ssl, TLSEXT_TYPE_psk, &Psk, &PskLength)) {
+            //
+            // Suspend the handshake here; CxPlatTlsProcessData resumes it on
+            // the signing pool.
+            //
+            TlsContext->SigningOffloaded = TRUE;
+            return SSL_CLIENT_HELLO_RETRY;
+        }
+    }
+
     return SSL_CLIENT_HELLO_SUCCESS;
 }
 
@@ -1550,6 +1616,245 @@ CxPlatTlsGetProvider(
     return QUIC_TLS_PROVIDER_OPENSSL;
 }
 
+//
+// @struct CXPLAT_TLS_SIGNING_POOL
+// @brief Threads that finish the signing step of server handshakes.
+//
+// Signing the CertificateVerify with the certificate's private key is the most
+// expensive part of a full server handshake. When a credential has
+// QUIC_CREDENTIAL_FLAG_ASYNC_SIGNING, the SSL_do_handshake step that produces
+// the server's first flight (through the CertificateVerify and Finished) runs
+// on one of these threads, and the connection's worker moves on to other
+// connections meanwhile. OpenSSL is built without deprecated APIs, so there is
+// no key method hook to offload the signature by itself.
+//
+typedef struct CXPLAT_TLS_SIGNING_POOL {
+
+    //
+    // Protects the queue and the shutdown flag.
+    //
+    CXPLAT_LOCK Lock;
+
+    //
+    // Auto-reset event that wakes one thread when work is queued.
+    //
+    CXPLAT_EVENT WakeEvent;
+
+    //
+    // TLS contexts waiting for a thread.
+    //
+    CXPLAT_LIST_ENTRY Queue;
+
+    //
+    // Set when the owning security configuration is being deleted.
+    //
+    BOOLEAN ShuttingDown;
+
+    //
+    // Number of threads started.
+    //
+    uint16_t ThreadCount;
+
+    CXPLAT_THREAD Threads[0];
+
+} CXPLAT_TLS_SIGNING_POOL;
+
+//
+// Number of threads in each new signing pool. Zero means one thread for every
+// two processors, up to CXPLAT_TLS_SIGNING_POOL_DEFAULT_MAX_THREADS. Every
+// credential gets its own pool, so the default is kept small.
+//
+static uint16_t CxPlatTlsSigningPoolSize = 0;
+
+#define CXPLAT_TLS_SIGNING_POOL_DEFAULT_MAX_THREADS 4
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatTlsSetSigningPoolSize(
+    _In_ uint16_t ThreadCount
+    )
+{
+    CxPlatTlsSigningPoolSize = ThreadCount;
+    return QUIC_STATUS_SUCCESS;
+}
+
+//
+// @brief Signing pool thread.
+//
+// Runs queued handshake steps until the pool shuts down. The connection is
+// told about each completion through the ProcessComplete callback, after which
+// the TLS context may already be gone.
+//
+CXPLAT_THREAD_CALLBACK(CxPlatTlsSigningThread, Context)
+{
+    CXPLAT_TLS_SIGNING_POOL* Pool = (CXPLAT_TLS_SIGNING_POOL*)Context;
+
+    while (TRUE) {
+        CxPlatLockAcquire(&Pool->Lock);
+        while (CxPlatListIsEmpty(&Pool->Queue) && !Pool->ShuttingDown) {
+            CxPlatLockRelease(&Pool->Lock);
+            CxPlatEventWaitForever(Pool->WakeEvent);
+            CxPlatLockAcquire(&Pool->Lock);
+        }
+        if (CxPlatListIsEmpty(&Pool->Queue)) {
+            CxPlatLockRelease(&Pool->Lock);
+            break;
+        }
+        CXPLAT_TLS* TlsContext =
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&Pool->Queue),
+                CXPLAT_TLS,
+                SigningLink);
+        const BOOLEAN MoreQueued = !CxPlatListIsEmpty(&Pool->Queue);
+        CxPlatLockRelease(&Pool->Lock);
+
+        if (MoreQueued) {
+            CxPlatEventSet(Pool->WakeEvent); // Let another thread take the rest.
+        }
+
+        uint32_t BufferLength = 0;
+        (void)CxPlatTlsProcessData(
+            TlsContext,
+            CXPLAT_TLS_CRYPTO_DATA,
+            NULL,
+            &BufferLength,
+            &TlsContext->SigningState);
+
+        TlsContext->SecConfig->Callbacks.ProcessComplete(TlsContext->Connection);
+    }
+
+    //
+    // Pass the shutdown on to the next thread.
+    //
+    CxPlatEventSet(Pool->WakeEvent);
+
+    CXPLAT_THREAD_RETURN(0);
+}
+
+static
+void
+CxPlatTlsSigningPoolUninitialize(
+    _In_ __drv_freesMem(Mem) CXPLAT_TLS_SIGNING_POOL* Pool
+    )
+{
+    CxPlatLockAcquire(&Pool->Lock);
+    CXPLAT_DBG_ASSERT(CxPlatListIsEmpty(&Pool->Queue));
+    Pool->ShuttingDown = TRUE;
+    CxPlatLockRelease(&Pool->Lock);
+    CxPlatEventSet(Pool->WakeEvent);
+
+    for (uint16_t i = 0; i < Pool->ThreadCount; ++i) {
+        CxPlatThreadWait(&Pool->Threads[i]);
+        CxPlatThreadDelete(&Pool->Threads[i]);
+    }
+
+    CxPlatEventUninitialize(Pool->WakeEvent);
+    CxPlatLockUninitialize(&Pool->Lock);
+    CXPLAT_FREE(Pool, QUIC_POOL_TLS_SIGNING_POOL);
+}
+
+static
+QUIC_STATUS
+CxPlatTlsSigningPoolInitialize(
+    _Outptr_ _At_(*NewPool, __drv_allocatesMem(Mem))
+        CXPLAT_TLS_SIGNING_POOL** NewPool
+    )
+{
+    uint16_t ThreadCount = CxPlatTlsSigningPoolSize;
+    if (ThreadCount == 0) {
+        ThreadCount =
+            (uint16_t)CXPLAT_MIN(
+                CXPLAT_MAX(1, CxPlatProcCount() / 2),
+                CXPLAT_TLS_SIGNING_POOL_DEFAULT_MAX_THREADS);
+    }
+
+    const size_t PoolSize =
+        sizeof(CXPLAT_TLS_SIGNING_POOL) + ThreadCount * sizeof(CXPLAT_THREAD);
+    CXPLAT_TLS_SIGNING_POOL* Pool =
+        CXPLAT_ALLOC_NONPAGED(PoolSize, QUIC_POOL_TLS_SIGNING_POOL);
+    if (Pool == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_TLS_SIGNING_POOL",
+            PoolSize);
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    CxPlatZeroMemory(Pool, PoolSize);
+    CxPlatLockInitialize(&Pool->Lock);
+    CxPlatEventInitialize(&Pool->WakeEvent, FALSE, FALSE);
+    CxPlatListInitializeHead(&Pool->Queue);
+
+    CXPLAT_THREAD_CONFIG ThreadConfig = {
+        CXPLAT_THREAD_FLAG_NONE,
+        0,
+        "cxplat_sign",
+        CxPlatTlsSigningThread,
+        Pool
+    };
+
+    for (; Pool->ThreadCount < ThreadCount; ++Pool->ThreadCount) {
+        QUIC_STATUS Status =
+            CxPlatThreadCreate(&ThreadConfig, &Pool->Threads[Pool->ThreadCount]);
+        if (QUIC_FAILED(Status)) {
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                Status,
+                "CxPlatThreadCreate (signing pool)");
+            CxPlatTlsSigningPoolUninitialize(Pool);
+            return Status;
+        }
+    }
+
+    *NewPool = Pool;
+    return QUIC_STATUS_SUCCESS;
+}
+
+//
+// @brief Queues the rest of a server handshake step to the signing pool.
+//
+// @return FALSE if the context couldn't be queued, in which case the step must
+//         continue inline.
+//
+static
+BOOLEAN
+CxPlatTlsSigningPoolQueue(
+    _In_ CXPLAT_TLS_SIGNING_POOL* Pool,
+    _In_ CXPLAT_TLS* TlsContext,
+    _In_ const CXPLAT_TLS_PROCESS_STATE* State
+    )
+{
+    //
+    // The pool writes to its own copy of the processing state, since the
+    // connection keeps updating its state (e.g. as crypto data is acknowledged)
+    // while the pool runs.
+    //
+    CXPLAT_TLS_PROCESS_STATE* SigningState = &TlsContext->SigningState;
+    *SigningState = *State;
+    SigningState->BufferLength = 0;
+    CxPlatZeroMemory(SigningState->ReadKeys, sizeof(SigningState->ReadKeys));
+    CxPlatZeroMemory(SigningState->WriteKeys, sizeof(SigningState->WriteKeys));
+    SigningState->Buffer =
+        CXPLAT_ALLOC_NONPAGED(SigningState->BufferAllocLength, QUIC_POOL_TLS_BUFFER);
+    if (SigningState->Buffer == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "Signing crypto Buffer",
+            SigningState->BufferAllocLength);
+        return FALSE;
+    }
+
+    CxPlatLockAcquire(&Pool->Lock);
+    CxPlatListInsertTail(&Pool->Queue, &TlsContext->SigningLink);
+    CxPlatLockRelease(&Pool->Lock);
+    CxPlatEventSet(Pool->WakeEvent);
+
+    return TRUE;
+}
+
 //
 // @brief Creates a QUIC-compatible TLS security configuration.
 //
@@ -1635,6 +1940,11 @@ CxPlatTlsSecConfigCreate(
         return QUIC_STATUS_INVALID_PARAMETER; // Defer validation without indication doesn't make sense.
     }
 
+    if ((CredConfigFlags & QUIC_CREDENTIAL_FLAG_ASYNC_SIGNING) &&
+        (CredConfigFlags & QUIC_CREDENTIAL_FLAG_CLIENT)) {
+        return QUIC_STATUS_INVALID_PARAMETER; // Only server handshakes are offloaded.
+    }
+
     if ((CredConfigFlags & QUIC_CREDENTIAL_FLAG_USE_TLS_BUILTIN_CERTIFICATE_VALIDATION) &&
         (CredConfigFlags & QUIC_CREDENTIAL_FLAG_REVOCATION_CHECK_END_CERT ||
         CredConfigFlags & QUIC_CREDENTIAL_FLAG_REVOCATION_CHECK_CHAIN ||
@@ -2206,6 +2516,13 @@ CxPlatTlsSecConfigCreate(
 
         SSL_CTX_set_max_early_data(SecurityConfig->SSLCtx, UINT32_MAX);
         SSL_CTX_set_client_hello_cb(SecurityConfig->SSLCtx, CxPlatTlsClientHelloCallback, NULL);
+
+        if (CredConfigFlags & QUIC_CREDENTIAL_FLAG_ASYNC_SIGNING) {
+            Status = CxPlatTlsSigningPoolInitialize(&SecurityConfig->SigningPool);
+            if (QUIC_FAILED(Status)) {
+                goto Exit;
+            }
+        }
     }
 
     //
@@ -2267,6 +2584,10 @@ CxPlatTlsSecConfigDelete(
         CXPLAT_SEC_CONFIG* SecurityConfig
     )
 {
+    if (SecurityConfig->SigningPool != NULL) {
+        CxPlatTlsSigningPoolUninitialize(SecurityConfig->SigningPool);
+    }
+
     if (SecurityConfig->SSLCtx != NULL) {
         SSL_CTX_free(SecurityConfig->SSLCtx);
     }
@@ -2727,6 +3048,8 @@ CxPlatTlsUninitialize(
             TlsContext->Connection,
             "Cleaning up");
 
+        CXPLAT_DBG_ASSERT(TlsContext->SigningState.Buffer == NULL);
+
         if (TlsContext->SNI != NULL) {
             CXPLAT_FREE(TlsContext->SNI, QUIC_POOL_TLS_SNI);
             TlsContext->SNI = NULL;
@@ -3178,6 +3501,23 @@ more_handshake:
             case SSL_ERROR_WANT_READ:
             case SSL_ERROR_WANT_WRITE:
                 goto Exit;
+            case SSL_ERROR_WANT_CLIENT_HELLO_CB: {
+                //
+                // The ClientHello callback suspended the handshake so the
+                // signing step runs on the signing pool. Nothing may touch the
+                // context once it's queued.
+                //
+                CXPLAT_DBG_ASSERT(TlsContext->SigningOffloaded);
+                const CXPLAT_TLS_RESULT_FLAGS ResultFlags =
+                    TlsContext->ResultFlags | CXPLAT_TLS_RESULT_PENDING;
+                if (CxPlatTlsSigningPoolQueue(
+                        TlsContext->SecConfig->SigningPool,
+                        TlsContext,
+                        State)) {
+                    return ResultFlags;
+                }
+                goto more_handshake; // Finish the step inline instead.
+            }
             case SSL_ERROR_SSL: {
                 char buf[256];
                 const char* file;
@@ -3343,6 +3683,63 @@ Exit:
     return TlsContext->ResultFlags;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+CXPLAT_TLS_RESULT_FLAGS
+CxPlatTlsProcessDataComplete(
+    _In_ CXPLAT_TLS* TlsContext,
+    _Inout_ CXPLAT_TLS_PROCESS_STATE* State
+    )
+{
+    CXPLAT_TLS_PROCESS_STATE* SigningState = &TlsContext->SigningState;
+    CXPLAT_DBG_ASSERT(TlsContext->SigningOffloaded);
+    CXPLAT_DBG_ASSERT(SigningState->Buffer != NULL);
+
+    TlsContext->State = State;
+
+    //
+    // Append the flight the signing pool wrote after whatever the connection
+    // still has buffered. Both started at the same total length.
+    //
+    if (CxPlatTlsReserveBuffer(
+            TlsContext,
+            State,
+            (size_t)State->BufferLength + SigningState->BufferLength)) {
+        CxPlatCopyMemory(
+            State->Buffer + State->BufferLength,
+            SigningState->Buffer,
+            SigningState->BufferLength);
+        State->BufferLength += SigningState->BufferLength;
+        State->BufferTotalLength = SigningState->BufferTotalLength;
+        State->BufferOffsetHandshake = SigningState->BufferOffsetHandshake;
+        State->BufferOffset1Rtt = SigningState->BufferOffset1Rtt;
+    } else {
+        State->AlertCode = CXPLAT_TLS_ALERT_CODE_INTERNAL_ERROR;
+    }
+    CXPLAT_FREE(SigningState->Buffer, QUIC_POOL_TLS_BUFFER);
+    SigningState->Buffer = NULL;
+
+    for (uint8_t i = 0; i < QUIC_PACKET_KEY_COUNT; ++i) {
+        if (SigningState->ReadKeys[i] != NULL) {
+            CXPLAT_DBG_ASSERT(State->ReadKeys[i] == NULL);
+            State->ReadKeys[i] = SigningState->ReadKeys[i];
+        }
+        if (SigningState->WriteKeys[i] != NULL) {
+            CXPLAT_DBG_ASSERT(State->WriteKeys[i] == NULL);
+            State->WriteKeys[i] = SigningState->WriteKeys[i];
+        }
+    }
+    State->ReadKey = SigningState->ReadKey;
+    State->WriteKey = SigningState->WriteKey;
+    State->HandshakeComplete = SigningState->HandshakeComplete;
+    State->SessionResumed = SigningState->SessionResumed;
+    State->EarlyDataState = SigningState->EarlyDataState;
+    if (SigningState->AlertCode != 0) {
+        State->AlertCode = SigningState->AlertCode;
+    }
+
+    return TlsContext->ResultFlags;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 CxPlatSecConfigParamSet(
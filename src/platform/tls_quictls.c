@@ -949,7 +949,8 @@ CxPlatTlsSecConfigCreate(
     if (CredConfigFlags & QUIC_CREDENTIAL_FLAG_ENABLE_OCSP ||
         CredConfigFlags & QUIC_CREDENTIAL_FLAG_USE_SUPPLIED_CREDENTIALS ||
         CredConfigFlags & QUIC_CREDENTIAL_FLAG_USE_SYSTEM_MAPPER ||
-        CredConfigFlags & QUIC_CREDENTIAL_FLAG_INPROC_PEER_CERTIFICATE) {
+        CredConfigFlags & QUIC_CREDENTIAL_FLAG_INPROC_PEER_CERTIFICATE ||
+        CredConfigFlags & QUIC_CREDENTIAL_FLAG_ASYNC_SIGNING) {
         return QUIC_STATUS_NOT_SUPPORTED; // Not supported by this TLS implementation
     }
 
@@ -2178,6 +2179,32 @@ Exit:
     return TlsContext->ResultFlags;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+CXPLAT_TLS_RESULT_FLAGS
+CxPlatTlsProcessDataComplete(
+    _In_ CXPLAT_TLS* TlsContext,
+    _Inout_ CXPLAT_TLS_PROCESS_STATE* State
+    )
+{
+    //
+    // Processing never pends with this TLS implementation.
+    //
+    UNREFERENCED_PARAMETER(TlsContext);
+    UNREFERENCED_PARAMETER(State);
+    CXPLAT_FRE_ASSERT(FALSE);
+    return CXPLAT_TLS_RESULT_ERROR;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatTlsSetSigningPoolSize(
+    _In_ uint16_t ThreadCount
+    )
+{
+    UNREFERENCED_PARAMETER(ThreadCount);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 CxPlatSecConfigParamSet(
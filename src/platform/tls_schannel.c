@@ -1008,7 +1008,8 @@ CxPlatTlsSecConfigCreate(
         return QUIC_STATUS_INVALID_PARAMETER;
     }
 
-    if (CredConfig->Flags & QUIC_CREDENTIAL_FLAG_SET_CA_CERTIFICATE_FILE) {
+    if (CredConfig->Flags & QUIC_CREDENTIAL_FLAG_SET_CA_CERTIFICATE_FILE ||
+        CredConfig->Flags & QUIC_CREDENTIAL_FLAG_ASYNC_SIGNING) {
         return QUIC_STATUS_NOT_SUPPORTED;
     }
 
@@ -2894,6 +2895,32 @@ Error:
     return Result;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+CXPLAT_TLS_RESULT_FLAGS
+CxPlatTlsProcessDataComplete(
+    _In_ CXPLAT_TLS* TlsContext,
+    _Inout_ CXPLAT_TLS_PROCESS_STATE* State
+    )
+{
+    //
+    // Processing never pends with this TLS implementation.
+    //
+    UNREFERENCED_PARAMETER(TlsContext);
+    UNREFERENCED_PARAMETER(State);
+    CXPLAT_FRE_ASSERT(FALSE);
+    return CXPLAT_TLS_RESULT_ERROR;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatTlsSetSigningPoolSize(
+    _In_ uint16_t ThreadCount
+    )
+{
+    UNREFERENCED_PARAMETER(ThreadCount);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 CxPlatSecConfigParamSet(
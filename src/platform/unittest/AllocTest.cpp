@@ -5,12 +5,16 @@
 
 Abstract:
 
-    Tests to verify that memory allocations are zero-initialized by default.
+    Tests to verify that memory allocations are zero-initialized by default,
+    and tests and benchmarks for the memory pool.
 
 --*/
 
 #include "main.h"
 #include <algorithm>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 //
 // Size large enough to avoid small-allocation optimizations that might
@@ -127,3 +131,204 @@ TEST(AllocTest, PoolAllocIsZeroInitializedFresh)
     CxPlatPoolFree(Mem);
     CxPlatPoolUninitialize(&Pool);
 }
+
+//
+// Entries freed on a different thread than they were allocated on must be
+// reusable from either thread.
+//
+TEST(AllocTest, PoolReuseAcrossThreads)
+{
+    const uint32_t Count = 1000;
+    CXPLAT_POOL Pool;
+    CxPlatPoolInitialize(FALSE, TEST_ALLOC_SIZE, QUIC_POOL_TEST, &Pool);
+
+    std::vector<uint8_t*> Entries(Count);
+    std::thread Producer([&]() {
+        for (uint32_t i = 0; i < Count; ++i) {
+            Entries[i] = (uint8_t*)CxPlatPoolAlloc(&Pool);
+            ASSERT_NE(nullptr, Entries[i]);
+            memset(Entries[i], 0xDE, TEST_ALLOC_SIZE);
+        }
+    });
+    Producer.join();
+
+    for (uint32_t i = 0; i < Count; ++i) {
+        CxPlatPoolFree(Entries[i]);
+    }
+
+    for (uint32_t Round = 0; Round < 2; ++Round) {
+        for (uint32_t i = 0; i < Count; ++i) {
+            Entries[i] = (uint8_t*)CxPlatPoolAlloc(&Pool);
+            ASSERT_NE(nullptr, Entries[i]);
+            ASSERT_TRUE(IsZeroMemory(Entries[i], TEST_ALLOC_SIZE));
+            memset(Entries[i], 0xDE, TEST_ALLOC_SIZE);
+        }
+        std::sort(Entries.begin(), Entries.end());
+        ASSERT_EQ(Entries.end(), std::adjacent_find(Entries.begin(), Entries.end()));
+        std::thread Consumer([&]() {
+            for (uint32_t i = 0; i < Count; ++i) {
+                CxPlatPoolFree(Entries[i]);
+            }
+        });
+        Consumer.join();
+    }
+
+    CxPlatPoolUninitialize(&Pool);
+}
+
+TEST(AllocTest, PoolPrune)
+{
+    const uint32_t Count = 1000;
+    CXPLAT_POOL Pool;
+    CxPlatPoolInitialize(FALSE, TEST_ALLOC_SIZE, QUIC_POOL_TEST, &Pool);
+
+    std::vector<void*> Entries(Count);
+    for (uint32_t i = 0; i < Count; ++i) {
+        Entries[i] = CxPlatPoolAlloc(&Pool);
+        ASSERT_NE(nullptr, Entries[i]);
+    }
+    for (uint32_t i = 0; i < Count; ++i) {
+        CxPlatPoolFree(Entries[i]);
+    }
+
+    uint32_t Pruned = 0;
+    while (CxPlatPoolPrune(&Pool)) {
+        ASSERT_LE(++Pruned, Count);
+    }
+
+    void* Entry = CxPlatPoolAlloc(&Pool);
+    ASSERT_NE(nullptr, Entry);
+    CxPlatPoolFree(Entry);
+    CxPlatPoolUninitialize(&Pool);
+}
+
+//
+// Microbenchmarks for the memory pool, which is on the per-packet path. Run
+// them with --gtest_also_run_disabled_tests --gtest_filter=*Bench*. Each
+// reports the best of several rounds to filter out scheduling noise.
+//
+
+#define BENCH_POOL_BURST 64
+
+template<typename T>
+void
+PoolBench(
+    const char* Name,
+    uint64_t Operations,
+    T Round
+    )
+{
+    uint64_t Best = UINT64_MAX;
+    for (uint32_t i = 0; i < 5; ++i) {
+        const uint64_t Begin = CxPlatTimeUs64();
+        Round();
+        const uint64_t Elapsed = CxPlatTimeDiff64(Begin, CxPlatTimeUs64());
+        if (Elapsed < Best) {
+            Best = Elapsed;
+        }
+    }
+    printf("%s: %llu ops in %llu us (%llu ns/op)\n",
+        Name,
+        (unsigned long long)Operations,
+        (unsigned long long)Best,
+        (unsigned long long)(Best * 1000 / Operations));
+}
+
+//
+// Allocates and frees bursts of entries, like a batch of packets.
+//
+static
+void
+PoolBenchBursts(
+    _Inout_ CXPLAT_POOL* Pool,
+    uint32_t Bursts
+    )
+{
+    void* Entries[BENCH_POOL_BURST];
+    for (uint32_t i = 0; i < Bursts; ++i) {
+        for (uint32_t j = 0; j < BENCH_POOL_BURST; ++j) {
+            Entries[j] = CxPlatPoolAlloc(Pool);
+        }
+        for (uint32_t j = 0; j < BENCH_POOL_BURST; ++j) {
+            CxPlatPoolFree(Entries[j]);
+        }
+    }
+}
+
+TEST(AllocTest, DISABLED_BenchPoolBurst)
+{
+    const uint32_t Bursts = 20000;
+    CXPLAT_POOL Pool;
+    CxPlatPoolInitialize(FALSE, TEST_ALLOC_SIZE, QUIC_POOL_TEST, &Pool);
+    PoolBench("pool burst", 2ull * Bursts * BENCH_POOL_BURST, [&]() {
+        PoolBenchBursts(&Pool, Bursts);
+    });
+    CxPlatPoolUninitialize(&Pool);
+}
+
+TEST(AllocTest, DISABLED_BenchPoolBurstThreads)
+{
+    //
+    // Every thread allocates from and frees to the same pool.
+    //
+    const uint32_t Bursts = 20000;
+    const uint32_t ThreadCount = std::max(2u, std::min(8u, CxPlatProcCount()));
+    CXPLAT_POOL Pool;
+    CxPlatPoolInitialize(FALSE, TEST_ALLOC_SIZE, QUIC_POOL_TEST, &Pool);
+    PoolBench("pool burst threads", 2ull * Bursts * BENCH_POOL_BURST * ThreadCount, [&]() {
+        std::vector<std::thread> Threads;
+        for (uint32_t i = 0; i < ThreadCount; ++i) {
+            Threads.emplace_back([&]() { PoolBenchBursts(&Pool, Bursts); });
+        }
+        for (auto& Thread : Threads) {
+            Thread.join();
+        }
+    });
+    CxPlatPoolUninitialize(&Pool);
+}
+
+TEST(AllocTest, DISABLED_BenchPoolCrossThreadFree)
+{
+    //
+    // One thread allocates and hands bursts to another to free, like receive
+    // buffers processed on a different thread than they were received on.
+    //
+    const uint32_t Bursts = 20000;
+    CXPLAT_POOL Pool;
+    CxPlatPoolInitialize(FALSE, TEST_ALLOC_SIZE, QUIC_POOL_TEST, &Pool);
+    PoolBench("pool cross thread free", 2ull * Bursts * BENCH_POOL_BURST, [&]() {
+        std::mutex Lock;
+        std::vector<void*> Handoff;
+        bool Done = false;
+        std::thread Consumer([&]() {
+            std::vector<void*> Entries;
+            while (true) {
+                {
+                    std::lock_guard<std::mutex> Guard(Lock);
+                    Entries.swap(Handoff);
+                    if (Entries.empty() && Done) {
+                        break;
+                    }
+                }
+                for (void* Entry : Entries) {
+                    CxPlatPoolFree(Entry);
+                }
+                Entries.clear();
+            }
+        });
+        for (uint32_t i = 0; i < Bursts; ++i) {
+            void* Entries[BENCH_POOL_BURST];
+            for (uint32_t j = 0; j < BENCH_POOL_BURST; ++j) {
+                Entries[j] = CxPlatPoolAlloc(&Pool);
+            }
+            std::lock_guard<std::mutex> Guard(Lock);
+            Handoff.insert(Handoff.end(), Entries, Entries + BENCH_POOL_BURST);
+        }
+        {
+            std::lock_guard<std::mutex> Guard(Lock);
+            Done = true;
+        }
+        Consumer.join();
+    });
+    CxPlatPoolUninitialize(&Pool);
+}
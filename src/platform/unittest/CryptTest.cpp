@@ -529,6 +529,68 @@ TEST_F(CryptTest, HpMaskAes128)
     CxPlatHpKeyFree(HpKey);
 }
 
+//
+// Compares the native header protection kernel, if the CPU has one, against
+// the crypto library for various batch sizes. Verifies they compute the same
+// masks and reports the time per mask.
+//
+TEST_F(CryptTest, HpMaskBenchmark)
+{
+    const uint32_t Iterations = 20000;
+    const uint8_t MaxBatchSize = 16;
+    const uint8_t BatchSizes[] = { 1, 4, 8, MaxBatchSize };
+    const CXPLAT_AEAD_TYPE AeadTypes[] = { CXPLAT_AEAD_AES_128_GCM, CXPLAT_AEAD_AES_256_GCM };
+    uint8_t RawKey[32];
+    uint8_t Sample[CXPLAT_HP_SAMPLE_LENGTH * MaxBatchSize];
+    uint8_t Mask[CXPLAT_HP_SAMPLE_LENGTH * MaxBatchSize];
+    uint8_t NativeMask[CXPLAT_HP_SAMPLE_LENGTH * MaxBatchSize];
+    VERIFY_QUIC_SUCCESS(CxPlatRandom(sizeof(RawKey), RawKey));
+    VERIFY_QUIC_SUCCESS(CxPlatRandom(sizeof(Sample), Sample));
+
+    const BOOLEAN NativeSupported = CxPlatHpSetNativeEnabled(FALSE);
+
+    for (auto AeadType : AeadTypes) {
+        CXPLAT_HP_KEY* HpKey = nullptr;
+        CXPLAT_HP_KEY* NativeHpKey = nullptr;
+        VERIFY_QUIC_SUCCESS(CxPlatHpKeyCreate(AeadType, RawKey, &HpKey));
+        if (NativeSupported) {
+            CxPlatHpSetNativeEnabled(TRUE);
+            VERIFY_QUIC_SUCCESS(CxPlatHpKeyCreate(AeadType, RawKey, &NativeHpKey));
+            CxPlatHpSetNativeEnabled(FALSE);
+        }
+
+        for (auto BatchSize : BatchSizes) {
+            uint64_t Start = CxPlatTimeUs64();
+            for (uint32_t i = 0; i < Iterations; ++i) {
+                VERIFY_QUIC_SUCCESS(CxPlatHpComputeMask(HpKey, BatchSize, Sample, Mask));
+            }
+            const uint64_t LibraryTime = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+
+            std::cout << (AeadType == CXPLAT_AEAD_AES_128_GCM ? "AES-128" : "AES-256")
+                << " batch " << (uint32_t)BatchSize << ": library "
+                << (LibraryTime * 1000) / ((uint64_t)Iterations * BatchSize) << " ns/mask";
+
+            if (NativeHpKey != nullptr) {
+                Start = CxPlatTimeUs64();
+                for (uint32_t i = 0; i < Iterations; ++i) {
+                    VERIFY_QUIC_SUCCESS(CxPlatHpComputeMask(NativeHpKey, BatchSize, Sample, NativeMask));
+                }
+                const uint64_t NativeTime = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+                ASSERT_EQ(0, memcmp(Mask, NativeMask, BatchSize * CXPLAT_HP_SAMPLE_LENGTH));
+
+                std::cout << ", native "
+                    << (NativeTime * 1000) / ((uint64_t)Iterations * BatchSize) << " ns/mask";
+            }
+            std::cout << std::endl;
+        }
+
+        CxPlatHpKeyFree(NativeHpKey);
+        CxPlatHpKeyFree(HpKey);
+    }
+
+    CxPlatHpSetNativeEnabled(TRUE);
+}
+
 TEST_F(CryptTest, KbKdfDerive)
 {
     QuicBuffer Key256("3edc6b5b8f7aadbd713732b482b8f979286e1ea3b8f8f99c30c884cfe3349b83");
@@ -15,6 +15,11 @@ Abstract:
 #include "quic_datapath.h"
 
 #include "msquic.h"
+#ifdef CX_PLATFORM_LINUX
+#include <fcntl.h>
+#include <sched.h>
+#include <poll.h>
+#endif
 #ifdef QUIC_CLOG
 #include "DataPathTest.cpp.clog.h"
 #endif
@@ -31,6 +36,11 @@ extern bool UseDuoNic;
 const uint32_t ExpectedDataSize = 1 * 1024;
 char* ExpectedData;
 
+//
+// The smallest send the io_uring datapath submits as zero-copy.
+//
+const uint32_t ZeroCopyMinSendSize = 8 * 1024;
+
 //
 // Helper class for managing the memory of a IP address.
 //
@@ -316,7 +326,7 @@ protected:
 
                 ASSERT_EQ(CXPLAT_ECN_FROM_TOS(RecvData->TypeOfService), RecvContext->EcnType);
 
-                CXPLAT_SEND_CONFIG SendConfig = { RecvData->Route, 0, (uint8_t)RecvContext->EcnType, 0, (uint8_t)RecvContext->Dscp };
+                CXPLAT_SEND_CONFIG SendConfig = { RecvData->Route, 0, (uint8_t)RecvContext->EcnType, 0, (uint8_t)RecvContext->Dscp, 0 };
                 auto ServerSendData = CxPlatSendDataAlloc(Socket, &SendConfig);
                 ASSERT_NE(nullptr, ServerSendData);
                 auto ServerBuffer = CxPlatSendDataAllocBuffer(ServerSendData, ExpectedDataSize);
@@ -462,13 +472,17 @@ struct CxPlatDataPath {
         _In_opt_ const CXPLAT_UDP_DATAPATH_CALLBACKS* UdpCallbacks,
         _In_opt_ const CXPLAT_TCP_DATAPATH_CALLBACKS* TcpCallbacks = nullptr,
         _In_ uint32_t ClientRecvContextLength = 0,
-        _In_opt_ QUIC_GLOBAL_EXECUTION_CONFIG* Config = nullptr
+        _In_opt_ QUIC_GLOBAL_EXECUTION_CONFIG* Config = nullptr,
+        _In_ BOOLEAN EnableSendZeroCopy = FALSE,
+        _In_ BOOLEAN EnableSendTxTime = FALSE
         ) noexcept
     {
         WorkerPool =
             CxPlatWorkerPoolCreate(Config ? Config : &DefaultExecutionConfig, CXPLAT_WORKER_POOL_REF_TOOL);
         CXPLAT_DATAPATH_INIT_CONFIG InitConfig = {0};
         InitConfig.EnableDscpOnRecv = TRUE;
+        InitConfig.EnableSendZeroCopy = EnableSendZeroCopy;
+        InitConfig.EnableSendTxTime = EnableSendTxTime;
         InitStatus =
             CxPlatDataPathInitialize(
                 ClientRecvContextLength,
@@ -590,7 +604,7 @@ struct CxPlatSocket {
         if (QUIC_SUCCEEDED(InitStatus)) {
             CxPlatSocketGetLocalAddress(Socket, &Route.LocalAddress);
             CxPlatSocketGetRemoteAddress(Socket, &Route.RemoteAddress);
-            if (Datapath.IsSupported(CXPLAT_DATAPATH_FEATURE_RAW) &&
+            if (Datapath.IsSupported(CXPLAT_DATAPATH_FEATURE_RAW, InternalFlags) &&
                 !QuicAddrIsWildCard(&Route.RemoteAddress)) {
                 //
                 // This is a connected socket and its route must be resolved
@@ -841,7 +855,103 @@ TEST_P(DataPathTest, UdpData)
     VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
     ASSERT_NE(nullptr, Client.Socket);
 
-    CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_NON_ECT, 0, (uint8_t)RecvContext.Dscp };
+    CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_NON_ECT, 0, (uint8_t)RecvContext.Dscp, 0 };
+    auto ClientSendData = CxPlatSendDataAlloc(Client, &SendConfig);
+    ASSERT_NE(nullptr, ClientSendData);
+    auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData, ExpectedDataSize);
+    ASSERT_NE(nullptr, ClientBuffer);
+    memcpy(ClientBuffer->Buffer, ExpectedData, ExpectedDataSize);
+
+    Client.Send(ClientSendData);
+    ASSERT_TRUE(CxPlatEventWaitWithTimeout(RecvContext.ClientCompletion, 2000));
+}
+
+TEST_P(DataPathTest, UdpDataZeroCopy)
+{
+    UdpRecvContext RecvContext;
+    CxPlatDataPath Datapath(&UdpRecvCallbacks, nullptr, 0, nullptr, TRUE);
+    RecvContext.TtlSupported = Datapath.IsSupported(CXPLAT_DATAPATH_FEATURE_TTL);
+    RecvContext.DscpSupported = Datapath.IsDscpSupported();
+    VERIFY_QUIC_SUCCESS(Datapath.GetInitStatus());
+    ASSERT_NE(nullptr, Datapath.Datapath);
+
+    auto unspecAddress = GetNewUnspecAddr();
+    CxPlatSocket Server(Datapath, &unspecAddress.SockAddr, nullptr, &RecvContext);
+    while (Server.GetInitStatus() == QUIC_STATUS_ADDRESS_IN_USE) {
+        unspecAddress.SockAddr.Ipv4.sin_port = GetNextPort();
+        Server.CreateUdp(Datapath, &unspecAddress.SockAddr, nullptr, &RecvContext);
+    }
+    VERIFY_QUIC_SUCCESS(Server.GetInitStatus());
+    ASSERT_NE(nullptr, Server.Socket);
+
+    auto serverAddress = GetNewLocalAddr();
+    RecvContext.DestinationAddress = serverAddress.SockAddr;
+    RecvContext.DestinationAddress.Ipv4.sin_port = Server.GetLocalAddress().Ipv4.sin_port;
+    ASSERT_NE(RecvContext.DestinationAddress.Ipv4.sin_port, (uint16_t)0);
+
+    CxPlatSocket Client(Datapath, nullptr, &RecvContext.DestinationAddress, &RecvContext);
+    VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
+    ASSERT_NE(nullptr, Client.Socket);
+
+    //
+    // Only sends of at least ZeroCopyMinSendSize go out as zero-copy, so send
+    // that much as segments of a single send when segmentation is available.
+    // Zero-copy sends are best effort, so the data must be delivered whether
+    // or not the platform supports them.
+    //
+    const bool Segmentation = Datapath.IsSupported(CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION);
+    const uint32_t SegmentCount = Segmentation ? ZeroCopyMinSendSize / ExpectedDataSize : 1;
+    CXPLAT_SEND_CONFIG SendConfig = {
+        &Client.Route, (uint16_t)ExpectedDataSize, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0, 0 };
+    auto ClientSendData = CxPlatSendDataAlloc(Client, &SendConfig);
+    ASSERT_NE(nullptr, ClientSendData);
+    for (uint32_t i = 0; i < SegmentCount; ++i) {
+        auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData, ExpectedDataSize);
+        ASSERT_NE(nullptr, ClientBuffer);
+        memcpy(ClientBuffer->Buffer, ExpectedData, ExpectedDataSize);
+    }
+
+    Client.Send(ClientSendData);
+    ASSERT_TRUE(CxPlatEventWaitWithTimeout(RecvContext.ClientCompletion, 2000));
+
+    if (Segmentation && Datapath.IsSupported(CXPLAT_DATAPATH_FEATURE_SEND_ZERO_COPY)) {
+        ASSERT_NE(0ull, CxPlatDataPathGetSendZeroCopyCount(Datapath));
+    }
+}
+
+TEST_P(DataPathTest, UdpDataTxTime)
+{
+    UdpRecvContext RecvContext;
+    CxPlatDataPath Datapath(&UdpRecvCallbacks, nullptr, 0, nullptr, FALSE, TRUE);
+    RecvContext.TtlSupported = Datapath.IsSupported(CXPLAT_DATAPATH_FEATURE_TTL);
+    RecvContext.DscpSupported = Datapath.IsDscpSupported();
+    VERIFY_QUIC_SUCCESS(Datapath.GetInitStatus());
+    ASSERT_NE(nullptr, Datapath.Datapath);
+
+    auto unspecAddress = GetNewUnspecAddr();
+    CxPlatSocket Server(Datapath, &unspecAddress.SockAddr, nullptr, &RecvContext);
+    while (Server.GetInitStatus() == QUIC_STATUS_ADDRESS_IN_USE) {
+        unspecAddress.SockAddr.Ipv4.sin_port = GetNextPort();
+        Server.CreateUdp(Datapath, &unspecAddress.SockAddr, nullptr, &RecvContext);
+    }
+    VERIFY_QUIC_SUCCESS(Server.GetInitStatus());
+    ASSERT_NE(nullptr, Server.Socket);
+
+    auto serverAddress = GetNewLocalAddr();
+    RecvContext.DestinationAddress = serverAddress.SockAddr;
+    RecvContext.DestinationAddress.Ipv4.sin_port = Server.GetLocalAddress().Ipv4.sin_port;
+    ASSERT_NE(RecvContext.DestinationAddress.Ipv4.sin_port, (uint16_t)0);
+
+    CxPlatSocket Client(Datapath, nullptr, &RecvContext.DestinationAddress, &RecvContext);
+    VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
+    ASSERT_NE(nullptr, Client.Socket);
+
+    //
+    // Departure times are only honored by some qdiscs, so the data must be
+    // delivered either way.
+    //
+    CXPLAT_SEND_CONFIG SendConfig = {
+        &Client.Route, 0, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0, CxPlatTimeUs64() + 10000 };
     auto ClientSendData = CxPlatSendDataAlloc(Client, &SendConfig);
     ASSERT_NE(nullptr, ClientSendData);
     auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData, ExpectedDataSize);
@@ -852,6 +962,53 @@ TEST_P(DataPathTest, UdpData)
     ASSERT_TRUE(CxPlatEventWaitWithTimeout(RecvContext.ClientCompletion, 2000));
 }
 
+TEST_P(DataPathTest, UdpDataBatched)
+{
+    UdpRecvContext RecvContext;
+    CxPlatDataPath Datapath(&UdpRecvCallbacks);
+    RecvContext.TtlSupported = Datapath.IsSupported(CXPLAT_DATAPATH_FEATURE_TTL);
+    RecvContext.DscpSupported = Datapath.IsDscpSupported();
+    VERIFY_QUIC_SUCCESS(Datapath.GetInitStatus());
+    ASSERT_NE(nullptr, Datapath.Datapath);
+
+    auto unspecAddress = GetNewUnspecAddr();
+    CxPlatSocket Server(Datapath, &unspecAddress.SockAddr, nullptr, &RecvContext);
+    while (Server.GetInitStatus() == QUIC_STATUS_ADDRESS_IN_USE) {
+        unspecAddress.SockAddr.Ipv4.sin_port = GetNextPort();
+        Server.CreateUdp(Datapath, &unspecAddress.SockAddr, nullptr, &RecvContext);
+    }
+    VERIFY_QUIC_SUCCESS(Server.GetInitStatus());
+    ASSERT_NE(nullptr, Server.Socket);
+
+    auto serverAddress = GetNewLocalAddr();
+    RecvContext.DestinationAddress = serverAddress.SockAddr;
+    RecvContext.DestinationAddress.Ipv4.sin_port = Server.GetLocalAddress().Ipv4.sin_port;
+    ASSERT_NE(RecvContext.DestinationAddress.Ipv4.sin_port, (uint16_t)0);
+
+    CxPlatSocket Client(Datapath, nullptr, &RecvContext.DestinationAddress, &RecvContext);
+    VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
+    ASSERT_NE(nullptr, Client.Socket);
+
+    //
+    // Whether or not the datapath holds the sends until the flush, all of them
+    // must have been handed off once it returns.
+    //
+    CXPLAT_SEND_BATCH Batch = {};
+    for (uint32_t i = 0; i < 3; ++i) {
+        CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0, 0 };
+        auto ClientSendData = CxPlatSendDataAlloc(Client, &SendConfig);
+        ASSERT_NE(nullptr, ClientSendData);
+        auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData, ExpectedDataSize);
+        ASSERT_NE(nullptr, ClientBuffer);
+        memcpy(ClientBuffer->Buffer, ExpectedData, ExpectedDataSize);
+        CxPlatSocketSendBatched(Client, &Client.Route, ClientSendData, &Batch);
+    }
+    CxPlatSendBatchFlush(&Batch);
+    ASSERT_EQ(0u, Batch.Count);
+    ASSERT_LE(Batch.SendCalls, 3u); // Zero if the datapath doesn't measure them.
+    ASSERT_TRUE(CxPlatEventWaitWithTimeout(RecvContext.ClientCompletion, 2000));
+}
+
 #ifdef _WIN32
 TEST_P(DataPathTest, UdpDataShareCibirUdpPort) {
     UdpRecvContext RecvContext;
@@ -893,6 +1050,209 @@ TEST_P(DataPathTest, UdpDataShareCibirUdpPort) {
 }
 #endif
 
+#ifdef CX_PLATFORM_LINUX
+//
+// A veth pair whose peer end lives in its own network namespace, so the AF_XDP
+// datapath can be tested against a plain kernel UDP socket without DuoNic.
+//
+struct XdpVethPair {
+    static constexpr const char* Netns = "msquicxdp";
+    static constexpr const char* LocalIp = "192.168.200.1";
+    static constexpr const char* PeerIp = "192.168.200.2";
+    bool Created {false};
+    int PeerFd {-1};
+    XdpVethPair() noexcept {
+        Delete();
+        Created =
+            system(
+                "ip netns add msquicxdp && "
+                "ip link add msqxdp0 address 22:22:22:22:02:01 type veth "
+                    "peer name msqxdp1 address 22:22:22:22:02:02 && "
+                "ip link set msqxdp1 netns msquicxdp && "
+                "ip addr add 192.168.200.1/24 dev msqxdp0 && "
+                "ip link set msqxdp0 up && "
+                "ip neigh add 192.168.200.2 lladdr 22:22:22:22:02:02 dev msqxdp0 nud permanent && "
+                "ip netns exec msquicxdp ip addr add 192.168.200.2/24 dev msqxdp1 && "
+                "ip netns exec msquicxdp ip link set msqxdp1 up && "
+                "ip netns exec msquicxdp ip neigh add 192.168.200.1 lladdr 22:22:22:22:02:01 dev msqxdp1 nud permanent"
+                " > /dev/null 2>&1") == 0;
+    }
+    ~XdpVethPair() noexcept {
+        if (PeerFd >= 0) {
+            close(PeerFd);
+        }
+        Delete();
+    }
+    static void Delete() noexcept {
+        //
+        // Deleting the namespace deletes the peer end, and with it the pair.
+        //
+        if (system("ip netns del msquicxdp > /dev/null 2>&1; ip link del msqxdp0 > /dev/null 2>&1")) { }
+    }
+    //
+    // Creates a UDP socket inside the peer namespace, bound to PeerIp.
+    //
+    bool CreatePeerSocket(_Out_ QUIC_ADDR* PeerAddress) noexcept {
+        int Fd = -1;
+        int HostNs = open("/proc/self/ns/net", O_RDONLY | O_CLOEXEC);
+        int PeerNs = open("/var/run/netns/msquicxdp", O_RDONLY | O_CLOEXEC);
+        if (HostNs >= 0 && PeerNs >= 0 && setns(PeerNs, CLONE_NEWNET) == 0) {
+            Fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, IPPROTO_UDP);
+            setns(HostNs, CLONE_NEWNET);
+        }
+        if (PeerNs >= 0) { close(PeerNs); }
+        if (HostNs >= 0) { close(HostNs); }
+        if (Fd < 0) {
+            return false;
+        }
+        PeerFd = Fd;
+        //
+        // Let the kernel fragment datagrams larger than the link MTU.
+        //
+        int PmtuDisc = IP_PMTUDISC_DONT;
+        socklen_t AddressLength = sizeof(PeerAddress->Ipv4);
+        CxPlatZeroMemory(PeerAddress, sizeof(*PeerAddress));
+        PeerAddress->Ipv4.sin_family = AF_INET;
+        inet_pton(AF_INET, PeerIp, &PeerAddress->Ipv4.sin_addr);
+        if (setsockopt(Fd, IPPROTO_IP, IP_MTU_DISCOVER, &PmtuDisc, sizeof(PmtuDisc)) != 0 ||
+            bind(Fd, (struct sockaddr*)&PeerAddress->Ipv4, sizeof(PeerAddress->Ipv4)) != 0 ||
+            getsockname(Fd, (struct sockaddr*)&PeerAddress->Ipv4, &AddressLength) != 0) {
+            return false;
+        }
+        return true;
+    }
+};
+
+struct XdpVethRecvContext {
+    uint32_t ExpectedLength {0};
+    CXPLAT_EVENT Received;
+    XdpVethRecvContext() {
+        CxPlatEventInitialize(&Received, FALSE, FALSE);
+    }
+    ~XdpVethRecvContext() {
+        CxPlatEventUninitialize(Received);
+    }
+};
+
+static
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Function_class_(CXPLAT_DATAPATH_RECEIVE_CALLBACK)
+void
+XdpVethRecvCallback(
+    _In_ CXPLAT_SOCKET* /* Socket */,
+    _In_ void* Context,
+    _In_ CXPLAT_RECV_DATA* RecvDataChain
+    )
+{
+    XdpVethRecvContext* RecvContext = (XdpVethRecvContext*)Context;
+    for (CXPLAT_RECV_DATA* RecvData = RecvDataChain; RecvData != NULL; RecvData = RecvData->Next) {
+        if (RecvData->BufferLength != RecvContext->ExpectedLength) {
+            continue;
+        }
+        bool Match = true;
+        for (uint32_t i = 0; i < RecvData->BufferLength; ++i) {
+            if (RecvData->Buffer[i] != (uint8_t)i) {
+                Match = false;
+                break;
+            }
+        }
+        if (Match) {
+            CxPlatEventSet(RecvContext->Received);
+        }
+    }
+    CxPlatRecvDataReturn(RecvDataChain);
+}
+
+TEST_F(DataPathTest, UdpDataXdpVeth)
+{
+    const CXPLAT_UDP_DATAPATH_CALLBACKS XdpVethCallbacks = {
+        XdpVethRecvCallback,
+        EmptyUnreachableCallback,
+    };
+
+    if (geteuid() != 0) {
+        GTEST_SKIP_NO_RETURN_("Requires root to create the veth pair");
+        return;
+    }
+
+    //
+    // The pair must exist before the datapath is initialized, since the raw
+    // datapath enumerates the interfaces it attaches to at initialization.
+    //
+    XdpVethPair Veth;
+    if (!Veth.Created) {
+        GTEST_SKIP_NO_RETURN_("Failed to create the veth pair");
+        return;
+    }
+    QUIC_ADDR PeerAddress;
+    ASSERT_TRUE(Veth.CreatePeerSocket(&PeerAddress));
+    const int PeerFd = Veth.PeerFd;
+
+    XdpVethRecvContext RecvContext;
+    CxPlatDataPath Datapath(&XdpVethCallbacks);
+    VERIFY_QUIC_SUCCESS(Datapath.GetInitStatus());
+    if (!Datapath.IsSupported(CXPLAT_DATAPATH_FEATURE_RAW, CXPLAT_SOCKET_FLAG_XDP)) {
+        GTEST_SKIP_NO_RETURN_("AF_XDP datapath not available");
+        return;
+    }
+
+    QuicAddr LocalAddress;
+    QuicAddrSetFamily(&LocalAddress.SockAddr, QUIC_ADDRESS_FAMILY_INET);
+    ASSERT_TRUE(QuicAddrFromString(XdpVethPair::LocalIp, 0, &LocalAddress.SockAddr));
+    CxPlatSocket Client(
+        Datapath, &LocalAddress.SockAddr, &PeerAddress, &RecvContext, CXPLAT_SOCKET_FLAG_XDP);
+    VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
+    ASSERT_TRUE(CxPlatSocketRawSocketAvailable(Client));
+    QUIC_ADDR ClientAddress = Client.GetLocalAddress();
+
+    //
+    // XSK -> kernel: the peer must see the datagram sent on the XSK.
+    //
+    uint8_t Buffer[3000];
+    for (uint32_t i = 0; i < sizeof(Buffer); ++i) {
+        Buffer[i] = (uint8_t)i;
+    }
+    CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0, 0 };
+    auto SendData = CxPlatSendDataAlloc(Client, &SendConfig);
+    ASSERT_NE(nullptr, SendData);
+    auto SendBuffer = CxPlatSendDataAllocBuffer(SendData, ExpectedDataSize);
+    ASSERT_NE(nullptr, SendBuffer);
+    memcpy(SendBuffer->Buffer, Buffer, ExpectedDataSize);
+    Client.Send(SendData);
+
+    struct pollfd Poll = { PeerFd, POLLIN, 0 };
+    ASSERT_EQ(1, poll(&Poll, 1, 2000));
+    uint8_t PeerBuffer[sizeof(Buffer)];
+    ASSERT_EQ((ssize_t)ExpectedDataSize, recv(PeerFd, PeerBuffer, sizeof(PeerBuffer), 0));
+    ASSERT_EQ(0, memcmp(PeerBuffer, Buffer, ExpectedDataSize));
+
+    //
+    // Kernel -> XSK: the program must redirect the peer's reply.
+    //
+    RecvContext.ExpectedLength = ExpectedDataSize;
+    ASSERT_EQ(
+        (ssize_t)ExpectedDataSize,
+        sendto(
+            PeerFd, Buffer, ExpectedDataSize, 0,
+            (struct sockaddr*)&ClientAddress.Ipv4, sizeof(ClientAddress.Ipv4)));
+    ASSERT_TRUE(CxPlatEventWaitWithTimeout(RecvContext.Received, 2000));
+
+    //
+    // A datagram larger than the veth MTU arrives as IPv4 fragments. Only
+    // the first one has the UDP header, so the program must leave all of
+    // them to the kernel, which reassembles the datagram and delivers it
+    // on the socket's OS path.
+    //
+    RecvContext.ExpectedLength = sizeof(Buffer);
+    ASSERT_EQ(
+        (ssize_t)sizeof(Buffer),
+        sendto(
+            PeerFd, Buffer, sizeof(Buffer), 0,
+            (struct sockaddr*)&ClientAddress.Ipv4, sizeof(ClientAddress.Ipv4)));
+    ASSERT_TRUE(CxPlatEventWaitWithTimeout(RecvContext.Received, 2000));
+}
+#endif // CX_PLATFORM_LINUX
+
 TEST_P(DataPathTest, UdpDataPolling)
 {
     QUIC_GLOBAL_EXECUTION_CONFIG Config = { QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_NONE, UINT32_MAX, 0 };
@@ -923,7 +1283,7 @@ TEST_P(DataPathTest, UdpDataPolling)
     VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
     ASSERT_NE(nullptr, Client.Socket);
 
-    CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_NON_ECT, 0, (uint8_t)RecvContext.Dscp };
+    CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_NON_ECT, 0, (uint8_t)RecvContext.Dscp, 0 };
     auto ClientSendData = CxPlatSendDataAlloc(Client, &SendConfig);
     ASSERT_NE(nullptr, ClientSendData);
     auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData, ExpectedDataSize);
@@ -964,7 +1324,7 @@ TEST_P(DataPathTest, UdpDataRebind)
         VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
         ASSERT_NE(nullptr, Client.Socket);
 
-        CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_NON_ECT, 0, (uint8_t)RecvContext.Dscp };
+        CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_NON_ECT, 0, (uint8_t)RecvContext.Dscp, 0 };
         auto ClientSendData = CxPlatSendDataAlloc(Client, &SendConfig);
         ASSERT_NE(nullptr, ClientSendData);
         auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData, ExpectedDataSize);
@@ -981,7 +1341,7 @@ TEST_P(DataPathTest, UdpDataRebind)
         VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
         ASSERT_NE(nullptr, Client.Socket);
 
-        CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_NON_ECT, 0, (uint8_t)RecvContext.Dscp };
+        CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_NON_ECT, 0, (uint8_t)RecvContext.Dscp, 0 };
         auto ClientSendData = CxPlatSendDataAlloc(Client, &SendConfig);
         ASSERT_NE(nullptr, ClientSendData);
         auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData, ExpectedDataSize);
@@ -1023,7 +1383,7 @@ TEST_P(DataPathTest, UdpDataECT0)
     VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
     ASSERT_NE(nullptr, Client.Socket);
 
-    CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_ECT_0, 0, (uint8_t)RecvContext.Dscp };
+    CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_ECT_0, 0, (uint8_t)RecvContext.Dscp, 0 };
     auto ClientSendData = CxPlatSendDataAlloc(Client, &SendConfig);
     ASSERT_NE(nullptr, ClientSendData);
     auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData, ExpectedDataSize);
@@ -1075,7 +1435,7 @@ TEST_P(DataPathTest, UdpShareClientSocket)
     CxPlatSocket Client2(Datapath, &clientAddress, &serverAddress.SockAddr, &RecvContext, CXPLAT_SOCKET_FLAG_SHARE);
     VERIFY_QUIC_SUCCESS(Client2.GetInitStatus());
 
-    CXPLAT_SEND_CONFIG SendConfig = { &Client1.Route, 0, CXPLAT_ECN_NON_ECT, 0, (uint8_t)RecvContext.Dscp };
+    CXPLAT_SEND_CONFIG SendConfig = { &Client1.Route, 0, CXPLAT_ECN_NON_ECT, 0, (uint8_t)RecvContext.Dscp, 0 };
     auto ClientSendData = CxPlatSendDataAlloc(Client1, &SendConfig);
     ASSERT_NE(nullptr, ClientSendData);
     auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData, ExpectedDataSize);
@@ -1303,7 +1663,7 @@ TEST_P(DataPathTest, TcpDataClient)
     ASSERT_TRUE(CxPlatEventWaitWithTimeout(ListenerContext.AcceptEvent, 500));
     ASSERT_NE(nullptr, ListenerContext.Server);
 
-    CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0 };
+    CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0, 0 };
     auto SendData = CxPlatSendDataAlloc(Client, &SendConfig);
     ASSERT_NE(nullptr, SendData);
     auto SendBuffer = CxPlatSendDataAllocBuffer(SendData, ExpectedDataSize);
@@ -1348,7 +1708,7 @@ TEST_P(DataPathTest, TcpDataServer)
     CXPLAT_ROUTE Route = Listener.Route;
     Route.RemoteAddress = Client.GetLocalAddress();
 
-    CXPLAT_SEND_CONFIG SendConfig = { &Route, 0, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0 };
+    CXPLAT_SEND_CONFIG SendConfig = { &Route, 0, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0, 0 };
     auto SendData = CxPlatSendDataAlloc(ListenerContext.Server, &SendConfig);
     ASSERT_NE(nullptr, SendData);
     auto SendBuffer = CxPlatSendDataAllocBuffer(SendData, ExpectedDataSize);
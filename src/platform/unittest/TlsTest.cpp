@@ -6,6 +6,7 @@
 --*/
 
 #define _CRT_SECURE_NO_WARNINGS 1
+#define QUIC_API_ENABLE_PREVIEW_FEATURES 1
 #include "main.h"
 #include "msquic.h"
 #include "quic_tls.h"
@@ -68,6 +69,18 @@ protected:
                     OnSecConfigCreateComplete));
             ASSERT_NE(nullptr, SecConfig);
         }
+        QUIC_STATUS TryLoad(
+            _In_ const QUIC_CREDENTIAL_CONFIG* CredConfig,
+            _In_ CXPLAT_TLS_CREDENTIAL_FLAGS TlsFlags = CXPLAT_TLS_CREDENTIAL_FLAG_NONE
+            ) {
+            return
+                CxPlatTlsSecConfigCreate(
+                    CredConfig,
+                    TlsFlags,
+                    &TlsContext::TlsCallbacks,
+                    &SecConfig,
+                    OnSecConfigCreateComplete);
+        }
         _Function_class_(CXPLAT_SEC_CONFIG_CREATE_COMPLETE)
         static void
         QUIC_API
@@ -296,14 +309,20 @@ protected:
         uint32_t ExpectedErrorFlags {0};
         QUIC_STATUS ExpectedValidationStatus {QUIC_STATUS_SUCCESS};
 
+        CXPLAT_EVENT ProcessCompleteEvent;
+        bool ProcessPended {false};
+        bool DeferPendingCompletion {false};
+
         TlsContext() {
             CxPlatZeroMemory(&State, sizeof(State));
             State.Buffer = (uint8_t*)CXPLAT_ALLOC_NONPAGED(8000, QUIC_POOL_TEST);
             State.BufferAllocLength = 8000;
+            CxPlatEventInitialize(&ProcessCompleteEvent, FALSE, FALSE);
         }
 
         ~TlsContext() {
             CxPlatTlsUninitialize(Ptr);
+            CxPlatEventUninitialize(ProcessCompleteEvent);
             CXPLAT_FREE(State.Buffer, QUIC_POOL_TEST);
             for (uint8_t i = 0; i < QUIC_PACKET_KEY_COUNT; ++i) {
                 QuicPacketKeyFree(State.ReadKeys[i]);
@@ -454,6 +473,14 @@ protected:
                     BufferLength,
                     &State);
 
+            if (Result & CXPLAT_TLS_RESULT_PENDING) {
+                ProcessPended = true;
+                if (DeferPendingCompletion) {
+                    return Result;
+                }
+                Result = CompletePendingProcess();
+            }
+
             if (!ExpectError) {
                 EXPECT_TRUE((Result & CXPLAT_TLS_RESULT_ERROR) == 0);
             }
@@ -503,6 +530,15 @@ protected:
 
     public:
 
+        CXPLAT_TLS_RESULT_FLAGS
+        CompletePendingProcess()
+        {
+            CxPlatEventWaitForever(ProcessCompleteEvent);
+            auto Result = CxPlatTlsProcessDataComplete(Ptr, &State);
+            EXPECT_TRUE((Result & CXPLAT_TLS_RESULT_PENDING) == 0);
+            return Result;
+        }
+
         CXPLAT_TLS_RESULT_FLAGS
         ProcessData(
             _Inout_ CXPLAT_TLS_PROCESS_STATE* PeerState,
@@ -639,6 +675,14 @@ protected:
             }
             return Context->OnPeerCertReceivedResult;
         }
+
+        static void
+        OnProcessComplete(
+            _In_ QUIC_CONNECTION* Connection
+            )
+        {
+            CxPlatEventSet(((TlsContext*)Connection)->ProcessCompleteEvent);
+        }
     };
 
     struct PacketKey
@@ -854,7 +898,8 @@ protected:
 const CXPLAT_TLS_CALLBACKS TlsTest::TlsContext::TlsCallbacks = {
     TlsTest::TlsContext::OnQuicTPReceived,
     TlsTest::TlsContext::OnSessionTicketReceived,
-    TlsTest::TlsContext::OnPeerCertReceived
+    TlsTest::TlsContext::OnPeerCertReceived,
+    TlsTest::TlsContext::OnProcessComplete
 };
 
 QUIC_CREDENTIAL_FLAGS TlsTest::SelfSignedCertParamsFlags = QUIC_CREDENTIAL_FLAG_NONE;
@@ -890,6 +935,86 @@ TEST_F(TlsTest, Handshake)
     ASSERT_FALSE(ServerContext.State.SessionResumed);
 }
 
+TEST_F(TlsTest, HandshakeAsyncSigning)
+{
+    CxPlatClientSecConfig ClientConfig;
+    CxPlatSecConfig ServerConfig;
+    SelfSignedCertParams->Flags = SelfSignedCertParamsFlags | QUIC_CREDENTIAL_FLAG_ASYNC_SIGNING;
+    SelfSignedCertParams->AllowedCipherSuites = QUIC_ALLOWED_CIPHER_SUITE_NONE;
+    QUIC_STATUS Status = ServerConfig.TryLoad(SelfSignedCertParams);
+    if (Status == QUIC_STATUS_NOT_SUPPORTED) {
+        GTEST_SKIP(); // Not supported
+    }
+    VERIFY_QUIC_SUCCESS(Status);
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        TlsContext ServerContext, ClientContext;
+        ClientContext.InitializeClient(ClientConfig);
+        ServerContext.InitializeServer(ServerConfig);
+        DoHandshake(ServerContext, ClientContext);
+
+        ASSERT_TRUE(ServerContext.ProcessPended);
+        ASSERT_FALSE(ClientContext.ProcessPended);
+        ASSERT_FALSE(ServerContext.State.SessionResumed);
+    }
+}
+
+//
+// Measures how fast a server answers a burst of ClientHellos for full
+// handshakes, i.e. produces its signed first flight, with signing inline and
+// on the signing pool. Run it with --gtest_also_run_disabled_tests
+// --gtest_filter=*Bench*.
+//
+TEST_F(TlsTest, DISABLED_BenchHandshakeSigning)
+{
+    const uint32_t Burst = 1024;
+    CxPlatClientSecConfig ClientConfig;
+    CxPlatServerSecConfig ServerConfig;
+    CxPlatSecConfig AsyncServerConfig;
+    SelfSignedCertParams->Flags = SelfSignedCertParamsFlags | QUIC_CREDENTIAL_FLAG_ASYNC_SIGNING;
+    SelfSignedCertParams->AllowedCipherSuites = QUIC_ALLOWED_CIPHER_SUITE_NONE;
+    QUIC_STATUS Status = AsyncServerConfig.TryLoad(SelfSignedCertParams);
+    if (Status == QUIC_STATUS_NOT_SUPPORTED) {
+        GTEST_SKIP(); // Not supported
+    }
+    VERIFY_QUIC_SUCCESS(Status);
+
+    for (bool Async : { false, true }) {
+        TlsContext* ClientContexts = new TlsContext[Burst];
+        TlsContext* ServerContexts = new TlsContext[Burst];
+        for (uint32_t i = 0; i < Burst; ++i) {
+            ClientContexts[i].InitializeClient(ClientConfig);
+            ClientContexts[i].ProcessData(nullptr);
+            ServerContexts[i].InitializeServer(
+                Async ? AsyncServerConfig.SecConfig : ServerConfig.SecConfig);
+            ServerContexts[i].DeferPendingCompletion = true;
+        }
+
+        const uint64_t Start = CxPlatTimeUs64();
+        for (uint32_t i = 0; i < Burst; ++i) {
+            ServerContexts[i].ProcessData(&ClientContexts[i].State);
+        }
+        for (uint32_t i = 0; i < Burst; ++i) {
+            if (ServerContexts[i].ProcessPended) {
+                ServerContexts[i].CompletePendingProcess();
+            }
+        }
+        const uint64_t Elapsed = CXPLAT_MAX(1, CxPlatTimeDiff64(Start, CxPlatTimeUs64()));
+
+        for (uint32_t i = 0; i < Burst; ++i) {
+            ASSERT_EQ(Async, ServerContexts[i].ProcessPended);
+            ASSERT_NE(nullptr, ServerContexts[i].State.WriteKeys[QUIC_PACKET_KEY_1_RTT]);
+        }
+
+        std::cout << (Async ? "pool" : "inline") << " signing: " << Burst
+            << " handshakes in " << Elapsed << " us ("
+            << (Burst * 1000000ull) / Elapsed << " per second)" << std::endl;
+
+        delete[] ServerContexts;
+        delete[] ClientContexts;
+    }
+}
+
 TEST_F(TlsTest, ExportKeyingMaterial)
 {
     CxPlatClientSecConfig ClientConfig;
@@ -1252,6 +1377,40 @@ TEST_F(TlsTest, HandshakeResumption)
     ASSERT_EQ((uint32_t)0, ServerContext2.ReceivedSessionTicket.Length); // TODO - Refactor to send non-zero length ticket
 }
 
+TEST_F(TlsTest, HandshakeAsyncSigningResumption)
+{
+    CxPlatClientSecConfig ClientConfig;
+    CxPlatSecConfig ServerConfig;
+    SelfSignedCertParams->Flags = SelfSignedCertParamsFlags | QUIC_CREDENTIAL_FLAG_ASYNC_SIGNING;
+    SelfSignedCertParams->AllowedCipherSuites = QUIC_ALLOWED_CIPHER_SUITE_NONE;
+    QUIC_STATUS Status = ServerConfig.TryLoad(SelfSignedCertParams);
+    if (Status == QUIC_STATUS_NOT_SUPPORTED) {
+        GTEST_SKIP(); // Not supported
+    }
+    VERIFY_QUIC_SUCCESS(Status);
+
+    TlsContext ServerContext, ClientContext;
+    ClientContext.InitializeClient(ClientConfig);
+    ServerContext.InitializeServer(ServerConfig);
+    DoHandshake(ServerContext, ClientContext, DefaultFragmentSize, true);
+    ASSERT_TRUE(ServerContext.ProcessPended);
+
+    ASSERT_NE(nullptr, ClientContext.ReceivedSessionTicket.Buffer);
+    ASSERT_NE((uint32_t)0, ClientContext.ReceivedSessionTicket.Length);
+
+    //
+    // Resumed handshakes don't sign anything, so they aren't offloaded.
+    //
+    TlsContext ServerContext2, ClientContext2;
+    ClientContext2.InitializeClient(ClientConfig, false, 64, &ClientContext.ReceivedSessionTicket);
+    ServerContext2.InitializeServer(ServerConfig);
+    DoHandshake(ServerContext2, ClientContext2);
+
+    ASSERT_FALSE(ServerContext2.ProcessPended);
+    ASSERT_TRUE(ClientContext2.State.SessionResumed);
+    ASSERT_TRUE(ServerContext2.State.SessionResumed);
+}
+
 TEST_F(TlsTest, HandshakeResumptionRejection)
 {
     CxPlatClientSecConfig ClientConfig;
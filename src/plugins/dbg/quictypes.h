@@ -80,6 +80,8 @@ typedef union QUIC_STREAM_FLAGS {
         BOOLEAN InStreamTable           : 1;    // The stream is currently in the connection's table.
         BOOLEAN InWaitingList           : 1;    // The stream is currently in the waiting list for stream id FC.
         BOOLEAN DelayIdFcUpdate         : 1;    // Delay stream ID FC updates to StreamClose.
+
+        BOOLEAN SendBlocked             : 1;    // Queued in the blocked send list, waiting on flow control.
     };
 } QUIC_STREAM_FLAGS;
 
@@ -198,6 +200,18 @@ typedef union QUIC_CONNECTION_STATE {
         //
         BOOLEAN UseRoundRobinStreamScheduling : 1;
 
+        //
+        // Indicates the connection is using the weighted fair queuing stream
+        // scheduling scheme.
+        //
+        BOOLEAN UseWeightedFairStreamScheduling : 1;
+
+        //
+        // Indicates the connection is using the earliest deadline first stream
+        // scheduling scheme.
+        //
+        BOOLEAN UseDeadlineStreamScheduling : 1;
+
         //
         // Indicates that this connection has resumption enabled and needs to
         // keep the TLS state and transport parameters until it is done sending
@@ -176,6 +176,8 @@ pub const QUIC_PARAM_GLOBAL_STATELESS_RESET_KEY: u32 = 16777227;
 pub const QUIC_PARAM_GLOBAL_STATISTICS_V2_SIZES: u32 = 16777228;
 pub const QUIC_PARAM_GLOBAL_STATELESS_RETRY_CONFIG: u32 = 16777229;
 pub const QUIC_PARAM_GLOBAL_XDP_MAP_CONFIG: u32 = 16777230;
+pub const QUIC_PARAM_GLOBAL_CUSTOM_CONGESTION_CONTROL: u32 = 16777231;
+pub const QUIC_PARAM_GLOBAL_TLS_SIGNING_POOL_SIZE: u32 = 16777232;
 pub const QUIC_PARAM_CONFIGURATION_SETTINGS: u32 = 50331648;
 pub const QUIC_PARAM_CONFIGURATION_TICKET_KEYS: u32 = 50331649;
 pub const QUIC_PARAM_CONFIGURATION_VERSION_SETTINGS: u32 = 50331650;
@@ -345,6 +347,7 @@ pub const QUIC_CREDENTIAL_FLAGS_QUIC_CREDENTIAL_FLAG_INPROC_PEER_CERTIFICATE:
 pub const QUIC_CREDENTIAL_FLAGS_QUIC_CREDENTIAL_FLAG_SET_CA_CERTIFICATE_FILE:
     QUIC_CREDENTIAL_FLAGS = 1048576;
 pub const QUIC_CREDENTIAL_FLAGS_QUIC_CREDENTIAL_FLAG_DISABLE_AIA: QUIC_CREDENTIAL_FLAGS = 2097152;
+pub const QUIC_CREDENTIAL_FLAGS_QUIC_CREDENTIAL_FLAG_ASYNC_SIGNING: QUIC_CREDENTIAL_FLAGS = 4194304;
 pub type QUIC_CREDENTIAL_FLAGS = ::std::os::raw::c_uint;
 pub const QUIC_ALLOWED_CIPHER_SUITE_FLAGS_QUIC_ALLOWED_CIPHER_SUITE_NONE:
     QUIC_ALLOWED_CIPHER_SUITE_FLAGS = 0;
@@ -378,8 +381,12 @@ pub const QUIC_STREAM_SCHEDULING_SCHEME_QUIC_STREAM_SCHEDULING_SCHEME_FIFO:
     QUIC_STREAM_SCHEDULING_SCHEME = 0;
 pub const QUIC_STREAM_SCHEDULING_SCHEME_QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN:
     QUIC_STREAM_SCHEDULING_SCHEME = 1;
-pub const QUIC_STREAM_SCHEDULING_SCHEME_QUIC_STREAM_SCHEDULING_SCHEME_COUNT:
+pub const QUIC_STREAM_SCHEDULING_SCHEME_QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR:
     QUIC_STREAM_SCHEDULING_SCHEME = 2;
+pub const QUIC_STREAM_SCHEDULING_SCHEME_QUIC_STREAM_SCHEDULING_SCHEME_DEADLINE:
+    QUIC_STREAM_SCHEDULING_SCHEME = 3;
+pub const QUIC_STREAM_SCHEDULING_SCHEME_QUIC_STREAM_SCHEDULING_SCHEME_COUNT:
+    QUIC_STREAM_SCHEDULING_SCHEME = 4;
 pub type QUIC_STREAM_SCHEDULING_SCHEME = ::std::os::raw::c_uint;
 pub const QUIC_STREAM_OPEN_FLAGS_QUIC_STREAM_OPEN_FLAG_NONE: QUIC_STREAM_OPEN_FLAGS = 0;
 pub const QUIC_STREAM_OPEN_FLAGS_QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL: QUIC_STREAM_OPEN_FLAGS = 1;
@@ -808,8 +815,10 @@ pub const QUIC_CONGESTION_CONTROL_ALGORITHM_QUIC_CONGESTION_CONTROL_ALGORITHM_CU
     QUIC_CONGESTION_CONTROL_ALGORITHM = 0;
 pub const QUIC_CONGESTION_CONTROL_ALGORITHM_QUIC_CONGESTION_CONTROL_ALGORITHM_BBR:
     QUIC_CONGESTION_CONTROL_ALGORITHM = 1;
-pub const QUIC_CONGESTION_CONTROL_ALGORITHM_QUIC_CONGESTION_CONTROL_ALGORITHM_MAX:
+pub const QUIC_CONGESTION_CONTROL_ALGORITHM_QUIC_CONGESTION_CONTROL_ALGORITHM_BBR3:
     QUIC_CONGESTION_CONTROL_ALGORITHM = 2;
+pub const QUIC_CONGESTION_CONTROL_ALGORITHM_QUIC_CONGESTION_CONTROL_ALGORITHM_MAX:
+    QUIC_CONGESTION_CONTROL_ALGORITHM = 3;
 pub type QUIC_CONGESTION_CONTROL_ALGORITHM = ::std::os::raw::c_uint;
 #[repr(C)]
 #[derive(Debug, Copy, Clone)]
@@ -1218,10 +1227,15 @@ pub struct QUIC_STATISTICS_V2 {
     pub SendQueueDelayMaxUs: u32,
     pub ReceiveQueueDelayAvgUs: u32,
     pub ReceiveQueueDelayMaxUs: u32,
+    pub SendEcnEctPackets: u64,
+    pub SendEcnCePackets: u64,
+    pub RecvEcnCePackets: u64,
+    pub SendBatchCount: u64,
+    pub SendBatchDatagrams: u64,
 }
 #[allow(clippy::unnecessary_operation, clippy::identity_op)]
 const _: () = {
-    ["Size of QUIC_STATISTICS_V2"][::std::mem::size_of::<QUIC_STATISTICS_V2>() - 232usize];
+    ["Size of QUIC_STATISTICS_V2"][::std::mem::size_of::<QUIC_STATISTICS_V2>() - 272usize];
     ["Alignment of QUIC_STATISTICS_V2"][::std::mem::align_of::<QUIC_STATISTICS_V2>() - 8usize];
     ["Offset of field: QUIC_STATISTICS_V2::CorrelationId"]
         [::std::mem::offset_of!(QUIC_STATISTICS_V2, CorrelationId) - 0usize];
@@ -1301,6 +1315,16 @@ const _: () = {
         [::std::mem::offset_of!(QUIC_STATISTICS_V2, ReceiveQueueDelayAvgUs) - 224usize];
     ["Offset of field: QUIC_STATISTICS_V2::ReceiveQueueDelayMaxUs"]
         [::std::mem::offset_of!(QUIC_STATISTICS_V2, ReceiveQueueDelayMaxUs) - 228usize];
+    ["Offset of field: QUIC_STATISTICS_V2::SendEcnEctPackets"]
+        [::std::mem::offset_of!(QUIC_STATISTICS_V2, SendEcnEctPackets) - 232usize];
+    ["Offset of field: QUIC_STATISTICS_V2::SendEcnCePackets"]
+        [::std::mem::offset_of!(QUIC_STATISTICS_V2, SendEcnCePackets) - 240usize];
+    ["Offset of field: QUIC_STATISTICS_V2::RecvEcnCePackets"]
+        [::std::mem::offset_of!(QUIC_STATISTICS_V2, RecvEcnCePackets) - 248usize];
+    ["Offset of field: QUIC_STATISTICS_V2::SendBatchCount"]
+        [::std::mem::offset_of!(QUIC_STATISTICS_V2, SendBatchCount) - 256usize];
+    ["Offset of field: QUIC_STATISTICS_V2::SendBatchDatagrams"]
+        [::std::mem::offset_of!(QUIC_STATISTICS_V2, SendBatchDatagrams) - 264usize];
 };
 impl QUIC_STATISTICS_V2 {
     #[inline]
@@ -1722,7 +1746,17 @@ pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_ENCRYPT_DURATION_US:
     QUIC_PERFORMANCE_COUNTERS = 33;
 pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_DECRYPT_DURATION_US:
     QUIC_PERFORMANCE_COUNTERS = 34;
-pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_MAX: QUIC_PERFORMANCE_COUNTERS = 35;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_UDP_SEND_COALESCED:
+    QUIC_PERFORMANCE_COUNTERS = 35;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_OPER_DRAINS: QUIC_PERFORMANCE_COUNTERS =
+    36;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_OPER_COALESCED:
+    QUIC_PERFORMANCE_COUNTERS = 37;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_ARENA_ALLOC: QUIC_PERFORMANCE_COUNTERS =
+    38;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_ARENA_OVERFLOW:
+    QUIC_PERFORMANCE_COUNTERS = 39;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_MAX: QUIC_PERFORMANCE_COUNTERS = 40;
 pub type QUIC_PERFORMANCE_COUNTERS = ::std::os::raw::c_uint;
 #[repr(C)]
 #[derive(Debug, Copy, Clone)]
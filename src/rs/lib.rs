@@ -164,7 +164,9 @@ pub const SEND_RESUMPTION_FLAG_FINAL: SendResumptionFlags = 1;
 pub type StreamSchedulingScheme = u32;
 pub const STREAM_SCHEDULING_SCHEME_FIFO: StreamSchedulingScheme = 0;
 pub const STREAM_SCHEDULING_SCHEME_ROUND_ROBIN: StreamSchedulingScheme = 1;
-pub const STREAM_SCHEDULING_SCHEME_COUNT: StreamSchedulingScheme = 2;
+pub const STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR: StreamSchedulingScheme = 2;
+pub const STREAM_SCHEDULING_SCHEME_DEADLINE: StreamSchedulingScheme = 3;
+pub const STREAM_SCHEDULING_SCHEME_COUNT: StreamSchedulingScheme = 4;
 
 /// Key information for TLS session ticket encryption.
 #[repr(C)]
@@ -262,6 +264,16 @@ pub struct QuicPerformanceCounters {
     pub encrypt_duration_us: i64,
     #[cfg(feature = "preview-api")]
     pub decrypt_duration_us: i64,
+    #[cfg(feature = "preview-api")]
+    pub udp_send_coalesced: i64,
+    #[cfg(feature = "preview-api")]
+    pub conn_oper_drains: i64,
+    #[cfg(feature = "preview-api")]
+    pub conn_oper_coalesced: i64,
+    #[cfg(feature = "preview-api")]
+    pub conn_arena_alloc: i64,
+    #[cfg(feature = "preview-api")]
+    pub conn_arena_overflow: i64,
 }
 
 pub const QUIC_TLS_SECRETS_MAX_SECRET_LEN: usize = 64;
@@ -540,6 +552,24 @@ impl From<QuicPerformanceCountersParam> for QuicPerformanceCounters {
             decrypt_duration_us: value
                 [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_DECRYPT_DURATION_US
                     as usize],
+            #[cfg(feature = "preview-api")]
+            udp_send_coalesced: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_UDP_SEND_COALESCED
+                    as usize],
+            #[cfg(feature = "preview-api")]
+            conn_oper_drains: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_OPER_DRAINS as usize],
+            #[cfg(feature = "preview-api")]
+            conn_oper_coalesced: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_OPER_COALESCED
+                    as usize],
+            #[cfg(feature = "preview-api")]
+            conn_arena_alloc: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_ARENA_ALLOC as usize],
+            #[cfg(feature = "preview-api")]
+            conn_arena_overflow: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_ARENA_OVERFLOW
+                    as usize],
         }
     }
 }
@@ -176,6 +176,11 @@ QuicTestLocalPathChanges(
     const FamilyArgs& Params
     );
 
+void
+QuicTestLocalAddressChangeWithBatchedSends(
+    const FamilyArgs& Params
+    );
+
 //
 // Handshake Tests
 //
@@ -949,6 +949,15 @@ TEST_P(WithFamilyArgs, LocalPathChanges) {
     }
 }
 
+TEST_P(WithFamilyArgs, LocalAddressChangeWithBatchedSends) {
+    TestLoggerT<ParamType> Logger("QuicTestLocalAddressChangeWithBatchedSends", GetParam());
+    if (TestingKernelMode) {
+        ASSERT_TRUE(InvokeKernelTest(FUNC(QuicTestLocalAddressChangeWithBatchedSends), GetParam()));
+    } else {
+        QuicTestLocalAddressChangeWithBatchedSends(GetParam());
+    }
+}
+
 TEST(Mtu, Settings) {
     TestLogger Logger("QuicTestMtuSettings");
     if (TestingKernelMode) {
@@ -2100,7 +2109,7 @@ struct WithHandshakeLossPatternsArgs :
         ::std::vector<HandshakeLossPatternsArgs> list;
         for (int Family : { 4, 6 })
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
-        for (auto CcAlgo : { QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC, QUIC_CONGESTION_CONTROL_ALGORITHM_BBR })
+        for (auto CcAlgo : { QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC, QUIC_CONGESTION_CONTROL_ALGORITHM_BBR, QUIC_CONGESTION_CONTROL_ALGORITHM_BBR3 })
 #else
         for (auto CcAlgo : { QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC })
 #endif
@@ -2112,7 +2121,8 @@ struct WithHandshakeLossPatternsArgs :
 std::ostream& operator << (std::ostream& o, const HandshakeLossPatternsArgs& args) {
     return o <<
         (args.Family == 4 ? "v4" : "v6") << "/" <<
-        (args.CcAlgo == QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC ? "cubic" : "bbr");
+        (args.CcAlgo == QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC ? "cubic" :
+            (args.CcAlgo == QUIC_CONGESTION_CONTROL_ALGORITHM_BBR ? "bbr" : "bbr3"));
 }
 
 TEST_P(WithHandshakeLossPatternsArgs, HandshakeSpecificLossPatterns) {
@@ -507,6 +507,7 @@ ExecuteTestRequest(
     RegisterTestFunction(QuicTestCreateConnection);
     RegisterTestFunction(QuicTestConnectionCloseFromCallback);
     RegisterTestFunction(QuicTestConnectionRejection);
+    RegisterTestFunction(QuicTestLocalAddressChangeWithBatchedSends);
 #ifdef QUIC_TEST_DATAPATH_HOOKS_ENABLED
     RegisterTestFunction(QuicTestEcn);
     RegisterTestFunction(QuicTestLocalPathChanges);
@@ -2959,6 +2959,8 @@ void QuicTestGlobalParam()
             QUIC_STATISTICS_V2_SIZE_4,
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
             QUIC_STATISTICS_V2_SIZE_5,
+            QUIC_STATISTICS_V2_SIZE_6,
+            QUIC_STATISTICS_V2_SIZE_7,
 #endif
         };
 
@@ -5948,6 +5950,61 @@ void QuicTestStreamParam()
         }
     }
 
+#ifdef QUIC_PARAM_STREAM_SEND_DEADLINE
+    //
+    // QUIC_PARAM_STREAM_SEND_DEADLINE
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_STREAM_SEND_DEADLINE");
+        MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_NONE);
+        uint64_t Expected = 5000;
+        //
+        // SetParam
+        //
+        {
+            TestScopeLogger LogScope1("SetParam");
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    Stream.Handle,
+                    QUIC_PARAM_STREAM_SEND_DEADLINE,
+                    sizeof(uint32_t),
+                    &Expected));
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    Stream.Handle,
+                    QUIC_PARAM_STREAM_SEND_DEADLINE,
+                    sizeof(Expected),
+                    &Expected));
+        }
+
+        //
+        // GetParam
+        //
+        {
+            TestScopeLogger LogScope1("GetParam");
+            uint32_t Length = 0;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_BUFFER_TOO_SMALL,
+                MsQuic->GetParam(
+                    Stream.Handle,
+                    QUIC_PARAM_STREAM_SEND_DEADLINE,
+                    &Length,
+                    nullptr));
+            TEST_EQUAL(Length, sizeof(uint64_t));
+
+            uint64_t Deadline = 0;
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->GetParam(
+                    Stream.Handle,
+                    QUIC_PARAM_STREAM_SEND_DEADLINE,
+                    &Length,
+                    &Deadline));
+            TEST_EQUAL(Deadline, Expected);
+        }
+    }
+#endif
+
     //
     // QUIC_PARAM_STREAM_STATISTICS
     //
@@ -120,3 +120,107 @@ QuicTestLocalPathChanges(
         PeerStreamsChanged.Reset();
     }
 }
+
+struct BatchedSendRebindContext {
+    MsQuicConnection* Connection {nullptr};
+    QuicAddr NextLocalAddr;
+    uint16_t ServerPort {0};
+    uint32_t Rebinds {0};
+    uint64_t BytesReceived {0};
+    CxPlatEvent ServerStreamShutdown;
+
+    static QUIC_STATUS ServerStreamCallback(_In_ MsQuicStream*, _In_opt_ void* Context, _Inout_ QUIC_STREAM_EVENT* Event) {
+        auto Ctx = (BatchedSendRebindContext*)Context;
+        if (Event->Type == QUIC_STREAM_EVENT_RECEIVE) {
+            Ctx->BytesReceived += Event->RECEIVE.TotalBufferLength;
+        } else if (Event->Type == QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE) {
+            Ctx->ServerStreamShutdown.Set();
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ServerConnCallback(_In_ MsQuicConnection*, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+        if (Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+            new(std::nothrow) MsQuicStream(Event->PEER_STREAM_STARTED.Stream, CleanUpAutoDelete, ServerStreamCallback, Context);
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    //
+    // Send completions are indicated on the worker while the connection is
+    // being processed, so sends it made earlier in the same pass of the worker
+    // loop may still be held in the worker's send batch.
+    //
+    static QUIC_STATUS ClientStreamCallback(_In_ MsQuicStream*, _In_opt_ void* Context, _Inout_ QUIC_STREAM_EVENT* Event) {
+        auto Ctx = (BatchedSendRebindContext*)Context;
+        if (Event->Type == QUIC_STREAM_EVENT_SEND_COMPLETE && Ctx->Rebinds < 20) {
+            uint16_t NextPort = Ctx->NextLocalAddr.GetPort() + 1;
+            if (NextPort == Ctx->ServerPort) {
+                NextPort++;
+            }
+            Ctx->NextLocalAddr.SetPort(NextPort);
+            if (QUIC_SUCCEEDED(Ctx->Connection->SetLocalAddr(Ctx->NextLocalAddr))) {
+                Ctx->Rebinds++;
+            }
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+};
+
+void
+QuicTestLocalAddressChangeWithBatchedSends(
+    const FamilyArgs& Params
+    )
+{
+    const uint32_t SendCount = 64;
+    const uint32_t SendLength = 0x10000;
+    BatchedSendRebindContext Context;
+    MsQuicRegistration Registration{true};
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", MsQuicSettings().SetPeerUnidiStreamCount(1), ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", MsQuicCredentialConfig{});
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, BatchedSendRebindContext::ServerConnCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    QUIC_ADDRESS_FAMILY QuicAddrFamily = (Params.Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+    QuicAddr ServerLocalAddr(QuicAddrFamily);
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest", &ServerLocalAddr.SockAddr));
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+    Context.ServerPort = ServerLocalAddr.GetPort();
+
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    Context.Connection = &Connection;
+
+    TEST_QUIC_SUCCEEDED(Connection.Start(ClientConfiguration, ServerLocalAddr.GetFamily(), QUIC_TEST_LOOPBACK_FOR_AF(ServerLocalAddr.GetFamily()), ServerLocalAddr.GetPort()));
+    TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+    TEST_QUIC_SUCCEEDED(Connection.GetLocalAddr(Context.NextLocalAddr));
+
+    UniquePtr<uint8_t[]> RawBuffer{new(std::nothrow) uint8_t[SendLength]};
+    TEST_NOT_EQUAL(nullptr, RawBuffer.get());
+    CxPlatZeroMemory(RawBuffer.get(), SendLength);
+    QUIC_BUFFER Buffer { SendLength, RawBuffer.get() };
+
+    //
+    // Many separate sends, so their completions keep changing the local
+    // address while more of the stream is still being sent.
+    //
+    MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL, CleanUpManual, BatchedSendRebindContext::ClientStreamCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Stream.GetInitStatus());
+    for (uint32_t i = 0; i < SendCount; ++i) {
+        TEST_QUIC_SUCCEEDED(
+            Stream.Send(
+                &Buffer,
+                1,
+                (i == 0 ? QUIC_SEND_FLAG_START : QUIC_SEND_FLAG_NONE) |
+                (i == SendCount - 1 ? QUIC_SEND_FLAG_FIN : QUIC_SEND_FLAG_NONE)));
+    }
+
+    TEST_TRUE(Context.ServerStreamShutdown.WaitTimeout(TestWaitTimeout * 2));
+    TEST_EQUAL(Context.BytesReceived, (uint64_t)SendCount * SendLength);
+    TEST_NOT_EQUAL(0u, Context.Rebinds);
+}
@@ -320,6 +320,21 @@ QuicTraceGlobalEvent(
             case QUIC_PERF_COUNTER_DECRYPT_DURATION_US:
                 printf("    Total decryption duration (us):                     ");
                 break;
+            case QUIC_PERF_COUNTER_UDP_SEND_COALESCED:
+                printf("    Total UDP send calls sharing a system call:         ");
+                break;
+            case QUIC_PERF_COUNTER_CONN_OPER_DRAINS:
+                printf("    Total connection operation queue drains:            ");
+                break;
+            case QUIC_PERF_COUNTER_CONN_OPER_COALESCED:
+                printf("    Total connection operations coalesced:              ");
+                break;
+            case QUIC_PERF_COUNTER_CONN_ARENA_ALLOC:
+                printf("    Total connection arena allocations:                 ");
+                break;
+            case QUIC_PERF_COUNTER_CONN_ARENA_OVERFLOW:
+                printf("    Total connection arena overflows:                   ");
+                break;
             default:
                 printf("    Unknown:                                            ");
                 break;
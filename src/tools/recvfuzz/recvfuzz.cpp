@@ -1053,7 +1053,7 @@ void BuildAndSendLongHeaderPackets(
     )
 {
     const uint16_t DatagramLength = MinInitialDatagramLength;
-    CXPLAT_SEND_CONFIG SendConfig = { Route, DatagramLength, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0 };
+    CXPLAT_SEND_CONFIG SendConfig = { Route, DatagramLength, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0, 0 };
     CXPLAT_SEND_DATA* SendData = CxPlatSendDataAlloc(Binding, &SendConfig);
     CXPLAT_FRE_ASSERT(SendData != nullptr);
 
@@ -1220,7 +1220,7 @@ void BuildAndSendShortHeaderPackets(
     )
 {
     const uint16_t DatagramLength = 1200; // Standard datagram size
-    CXPLAT_SEND_CONFIG SendConfig = { Route, DatagramLength, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0 };
+    CXPLAT_SEND_CONFIG SendConfig = { Route, DatagramLength, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0, 0 };
     CXPLAT_SEND_DATA* SendData = CxPlatSendDataAlloc(Binding, &SendConfig);
     CXPLAT_FRE_ASSERT(SendData != nullptr);
 
@@ -0,0 +1,357 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    A sample LEDBAT (RFC 6817) style "scavenger" congestion control algorithm,
+    implemented only against the public custom congestion control interface
+    (QUIC_PARAM_GLOBAL_CUSTOM_CONGESTION_CONTROL).
+
+    The algorithm tries to keep the queuing delay it adds to the path at
+    TargetDelayUs, so it yields to any loss based flows (like Cubic) sharing
+    the bottleneck. The queuing delay is estimated as the current delay minus
+    the smallest delay seen over the last several minutes. The one-way delay is
+    used when the peer supports it, otherwise the RTT (a la Vegas).
+
+    Like LEDBAT++, slow start grows the window at half the normal rate and
+    exits early once the queuing delay reaches 3/4 of the target. Losses and
+    ECN congestion signals halve the window, at most once per round trip.
+
+--*/
+
+#define QUIC_API_ENABLE_PREVIEW_FEATURES 1
+
+#include "ledbat.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef UNREFERENCED_PARAMETER
+#define UNREFERENCED_PARAMETER(P) (void)(P)
+#endif
+
+//
+// The base delay is the minimum over LEDBAT_BASE_HISTORY intervals of
+// LEDBAT_BASE_INTERVAL_US each, so that it can adapt to route changes.
+//
+#define LEDBAT_BASE_HISTORY         10
+#define LEDBAT_BASE_INTERVAL_US     (60 * 1000 * 1000)
+
+#define LEDBAT_MIN_WINDOW_PACKETS   2
+
+typedef struct LEDBAT {
+
+    LEDBAT_CONFIG Config;
+
+    uint32_t DatagramPayloadLength;
+    uint32_t InitialWindowPackets;
+
+    uint32_t CongestionWindow; // bytes
+    uint32_t PrevCongestionWindow; // bytes
+
+    BOOLEAN InSlowStart;
+    BOOLEAN PrevInSlowStart;
+
+    //
+    // Set on a congestion event and cleared once a packet sent after it is
+    // acknowledged. RecoverySentPacketNumber is the largest packet sent at the
+    // time of the congestion event.
+    //
+    BOOLEAN InRecovery;
+    uint64_t RecoverySentPacketNumber;
+
+    BOOLEAN BaseDelayValid;
+    uint32_t BaseDelayIndex;
+    uint64_t BaseDelayIntervalStart; // microseconds
+    uint64_t BaseDelayHistory[LEDBAT_BASE_HISTORY]; // microseconds
+
+} LEDBAT;
+
+static
+uint32_t
+LedbatMinWindow(
+    _In_ const LEDBAT* Ledbat
+    )
+{
+    return LEDBAT_MIN_WINDOW_PACKETS * Ledbat->DatagramPayloadLength;
+}
+
+static
+uint64_t
+LedbatBaseDelay(
+    _In_ const LEDBAT* Ledbat
+    )
+{
+    uint64_t BaseDelay = UINT64_MAX;
+    for (uint32_t i = 0; i < LEDBAT_BASE_HISTORY; ++i) {
+        if (Ledbat->BaseDelayHistory[i] < BaseDelay) {
+            BaseDelay = Ledbat->BaseDelayHistory[i];
+        }
+    }
+    return BaseDelay;
+}
+
+static
+void
+LedbatUpdateBaseDelay(
+    _In_ LEDBAT* Ledbat,
+    _In_ uint64_t TimeNow,
+    _In_ uint64_t Delay
+    )
+{
+    if (!Ledbat->BaseDelayValid) {
+        for (uint32_t i = 0; i < LEDBAT_BASE_HISTORY; ++i) {
+            Ledbat->BaseDelayHistory[i] = UINT64_MAX;
+        }
+        Ledbat->BaseDelayIndex = 0;
+        Ledbat->BaseDelayIntervalStart = TimeNow;
+        Ledbat->BaseDelayValid = TRUE;
+
+    } else if (TimeNow - Ledbat->BaseDelayIntervalStart >= LEDBAT_BASE_INTERVAL_US) {
+        Ledbat->BaseDelayIndex = (Ledbat->BaseDelayIndex + 1) % LEDBAT_BASE_HISTORY;
+        Ledbat->BaseDelayHistory[Ledbat->BaseDelayIndex] = UINT64_MAX;
+        Ledbat->BaseDelayIntervalStart = TimeNow;
+    }
+
+    if (Delay < Ledbat->BaseDelayHistory[Ledbat->BaseDelayIndex]) {
+        Ledbat->BaseDelayHistory[Ledbat->BaseDelayIndex] = Delay;
+    }
+}
+
+static
+void
+LedbatOnCongestionEvent(
+    _In_ LEDBAT* Ledbat,
+    _In_ const QUIC_CUSTOM_CONGESTION_CONTROL_LOSS* Loss
+    )
+{
+    Ledbat->DatagramPayloadLength = Loss->DatagramPayloadLength;
+    if (!Ledbat->InRecovery ||
+        Loss->LargestPacketNumber > Ledbat->RecoverySentPacketNumber) {
+        Ledbat->PrevCongestionWindow = Ledbat->CongestionWindow;
+        Ledbat->PrevInSlowStart = Ledbat->InSlowStart;
+        Ledbat->CongestionWindow /= 2;
+        Ledbat->InSlowStart = FALSE;
+        Ledbat->InRecovery = TRUE;
+        Ledbat->RecoverySentPacketNumber = Loss->LargestSentPacketNumber;
+    }
+    if (Loss->PersistentCongestion) {
+        Ledbat->CongestionWindow = 0;
+    }
+    if (Ledbat->CongestionWindow < LedbatMinWindow(Ledbat)) {
+        Ledbat->CongestionWindow = LedbatMinWindow(Ledbat);
+    }
+}
+
+static
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+LedbatCreate(
+    _In_opt_ void* Context,
+    _In_ const QUIC_CUSTOM_CONGESTION_CONTROL_PARAMS* Params,
+    _Outptr_ void** State
+    )
+{
+    LEDBAT* Ledbat = (LEDBAT*)malloc(sizeof(LEDBAT));
+    if (Ledbat == NULL) {
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+    memset(Ledbat, 0, sizeof(*Ledbat));
+
+    if (Context != NULL) {
+        Ledbat->Config = *(const LEDBAT_CONFIG*)Context;
+    } else {
+        Ledbat->Config.TargetDelayUs = LEDBAT_DEFAULT_TARGET_DELAY_US;
+        Ledbat->Config.Gain = LEDBAT_DEFAULT_GAIN;
+    }
+    if (Ledbat->Config.TargetDelayUs == 0) {
+        Ledbat->Config.TargetDelayUs = LEDBAT_DEFAULT_TARGET_DELAY_US;
+    }
+    if (Ledbat->Config.Gain == 0) {
+        Ledbat->Config.Gain = LEDBAT_DEFAULT_GAIN;
+    }
+
+    Ledbat->DatagramPayloadLength = Params->DatagramPayloadLength;
+    Ledbat->InitialWindowPackets = Params->InitialWindowPackets;
+    Ledbat->CongestionWindow =
+        Ledbat->DatagramPayloadLength * Ledbat->InitialWindowPackets;
+    Ledbat->InSlowStart = TRUE;
+
+    *State = Ledbat;
+    return QUIC_STATUS_SUCCESS;
+}
+
+static
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QUIC_API
+LedbatDelete(
+    _In_ void* State
+    )
+{
+    free(State);
+}
+
+static
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QUIC_API
+LedbatReset(
+    _In_ void* State,
+    _In_ BOOLEAN FullReset
+    )
+{
+    LEDBAT* Ledbat = (LEDBAT*)State;
+    Ledbat->CongestionWindow =
+        Ledbat->DatagramPayloadLength * Ledbat->InitialWindowPackets;
+    Ledbat->InSlowStart = TRUE;
+    Ledbat->InRecovery = FALSE;
+    if (FullReset) {
+        //
+        // Likely a new path, so the old base delay no longer applies.
+        //
+        Ledbat->BaseDelayValid = FALSE;
+    }
+}
+
+static
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QUIC_API
+LedbatOnDataAcknowledged(
+    _In_ void* State,
+    _In_ const QUIC_CUSTOM_CONGESTION_CONTROL_ACK* Ack
+    )
+{
+    LEDBAT* Ledbat = (LEDBAT*)State;
+    Ledbat->DatagramPayloadLength = Ack->DatagramPayloadLength;
+
+    if (Ledbat->InRecovery) {
+        if (Ack->LargestAck <= Ledbat->RecoverySentPacketNumber) {
+            return; // Don't grow the window until recovery is over.
+        }
+        Ledbat->InRecovery = FALSE;
+    }
+
+    uint64_t Delay;
+    if (Ack->OneWayDelay != 0) {
+        Delay = Ack->OneWayDelay;
+    } else if (Ack->MinRttValid) {
+        Delay = Ack->MinRtt;
+    } else {
+        return;
+    }
+    LedbatUpdateBaseDelay(Ledbat, Ack->TimeNow, Delay);
+
+    const uint64_t QueuingDelay = Delay - LedbatBaseDelay(Ledbat);
+    const uint64_t Target = Ledbat->Config.TargetDelayUs;
+
+    if (Ledbat->InSlowStart) {
+        if (QueuingDelay * 4 > Target * 3) {
+            Ledbat->InSlowStart = FALSE;
+        } else if (!Ack->IsLargestAckedPacketAppLimited) {
+            Ledbat->CongestionWindow += (Ack->BytesAcked * Ledbat->Config.Gain) / 2;
+            return;
+        }
+    }
+
+    //
+    // cwnd += GAIN * off_target * bytes_acked * MSS / cwnd, where off_target
+    // is (target - queuing_delay) / target, clamped to [-1, 1].
+    //
+    int64_t OffTarget = (int64_t)Target - (int64_t)QueuingDelay;
+    if (OffTarget < -(int64_t)Target) {
+        OffTarget = -(int64_t)Target;
+    }
+    if (OffTarget > 0 && Ack->IsLargestAckedPacketAppLimited) {
+        return; // Only grow the window if it is actually being used.
+    }
+
+    const int64_t Delta =
+        ((int64_t)Ledbat->Config.Gain * OffTarget *
+            (int64_t)Ack->BytesAcked * (int64_t)Ledbat->DatagramPayloadLength) /
+        ((int64_t)Target * (int64_t)Ledbat->CongestionWindow);
+    int64_t NewWindow = (int64_t)Ledbat->CongestionWindow + Delta;
+    if (NewWindow < (int64_t)LedbatMinWindow(Ledbat)) {
+        NewWindow = LedbatMinWindow(Ledbat);
+    } else if (NewWindow > UINT32_MAX) {
+        NewWindow = UINT32_MAX;
+    }
+    Ledbat->CongestionWindow = (uint32_t)NewWindow;
+}
+
+static
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QUIC_API
+LedbatOnDataLost(
+    _In_ void* State,
+    _In_ const QUIC_CUSTOM_CONGESTION_CONTROL_LOSS* Loss
+    )
+{
+    LedbatOnCongestionEvent((LEDBAT*)State, Loss);
+}
+
+static
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QUIC_API
+LedbatOnEcn(
+    _In_ void* State,
+    _In_ const QUIC_CUSTOM_CONGESTION_CONTROL_LOSS* Loss
+    )
+{
+    LedbatOnCongestionEvent((LEDBAT*)State, Loss);
+}
+
+static
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QUIC_API
+LedbatOnSpuriousCongestionEvent(
+    _In_ void* State
+    )
+{
+    LEDBAT* Ledbat = (LEDBAT*)State;
+    if (!Ledbat->InRecovery) {
+        return FALSE;
+    }
+    Ledbat->CongestionWindow = Ledbat->PrevCongestionWindow;
+    Ledbat->InSlowStart = Ledbat->PrevInSlowStart;
+    Ledbat->InRecovery = FALSE;
+    return TRUE;
+}
+
+static
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QUIC_API
+LedbatGetCongestionWindow(
+    _In_ const void* State
+    )
+{
+    return ((const LEDBAT*)State)->CongestionWindow;
+}
+
+void
+LedbatGetCongestionControl(
+    _In_ uint16_t Algorithm,
+    _In_opt_ const LEDBAT_CONFIG* Config,
+    _Out_ QUIC_CUSTOM_CONGESTION_CONTROL* Custom
+    )
+{
+    memset(Custom, 0, sizeof(*Custom));
+    Custom->Algorithm = Algorithm;
+    Custom->Name = "LEDBAT";
+    Custom->Context = (void*)Config;
+    Custom->Create = LedbatCreate;
+    Custom->Delete = LedbatDelete;
+    Custom->Reset = LedbatReset;
+    Custom->OnDataAcknowledged = LedbatOnDataAcknowledged;
+    Custom->OnDataLost = LedbatOnDataLost;
+    Custom->OnEcn = LedbatOnEcn;
+    Custom->OnSpuriousCongestionEvent = LedbatOnSpuriousCongestionEvent;
+    Custom->GetCongestionWindow = LedbatGetCongestionWindow;
+}
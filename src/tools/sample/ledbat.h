@@ -0,0 +1,52 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    A sample LEDBAT style "scavenger" congestion control algorithm built only on
+    the public custom congestion control interface. See ledbat.c.
+
+--*/
+
+#pragma once
+
+#include "msquic.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+typedef struct LEDBAT_CONFIG {
+    //
+    // The amount of queuing delay the algorithm tries to add to the path. Any
+    // more than this and it backs off.
+    //
+    uint32_t TargetDelayUs;
+    //
+    // Multiplier on the per-RTT window change. 1 means at most one datagram per
+    // RTT, like TCP congestion avoidance.
+    //
+    uint32_t Gain;
+} LEDBAT_CONFIG;
+
+#define LEDBAT_DEFAULT_TARGET_DELAY_US  60000
+#define LEDBAT_DEFAULT_GAIN             1
+
+//
+// Fills in Custom with the LEDBAT callbacks for the given algorithm value.
+// Config may be NULL to use the defaults, otherwise it must remain valid until
+// MsQuicClose. The result is then registered with SetParam
+// (QUIC_PARAM_GLOBAL_CUSTOM_CONGESTION_CONTROL).
+//
+void
+LedbatGetCongestionControl(
+    _In_ uint16_t Algorithm,
+    _In_opt_ const LEDBAT_CONFIG* Config,
+    _Out_ QUIC_CUSTOM_CONGESTION_CONTROL* Custom
+    );
+
+#if defined(__cplusplus)
+}
+#endif
@@ -50,6 +50,7 @@ Abstract:
 #include <share.h>
 #endif
 #include "msquic.h"
+#include "ledbat.h"
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -84,6 +85,15 @@ const uint64_t IdleTimeoutMs = 1000;
 //
 const uint32_t SendBufferLength = 100;
 
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+//
+// The algorithm value the sample LEDBAT "scavenger" congestion control (see
+// ledbat.c) is registered as, and whether it is used (-scavenger).
+//
+const uint16_t ScavengerAlgorithm = QUIC_CONGESTION_CONTROL_ALGORITHM_CUSTOM_BASE;
+BOOLEAN UseScavenger = FALSE;
+#endif
+
 //
 // The QUIC API/function table returned from MsQuicOpen2. It contains all the
 // functions called by the app to interact with MsQuic.
@@ -131,6 +141,10 @@ void PrintUsage()
 #endif
         "  quicsample.exe -server -cert_hash:<...>\n"
         "  quicsample.exe -server -cert_file:<...> -key_file:<...> [-password:<...>]\n"
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+        "\n"
+        "  Add -scavenger to use the sample LEDBAT congestion control.\n"
+#endif
         );
 }
 
@@ -541,6 +555,15 @@ ServerLoadConfiguration(
     //
     Settings.IdleTimeoutMs = IdleTimeoutMs;
     Settings.IsSet.IdleTimeoutMs = TRUE;
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+    //
+    // Optionally use the app registered scavenger congestion control.
+    //
+    if (UseScavenger) {
+        Settings.CongestionControlAlgorithm = ScavengerAlgorithm;
+        Settings.IsSet.CongestionControlAlgorithm = TRUE;
+    }
+#endif
     //
     // Configures the server's resumption level to allow for resumption and
     // 0-RTT.
@@ -895,6 +918,15 @@ ClientLoadConfiguration(
     //
     Settings.IdleTimeoutMs = IdleTimeoutMs;
     Settings.IsSet.IdleTimeoutMs = TRUE;
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+    //
+    // Optionally use the app registered scavenger congestion control.
+    //
+    if (UseScavenger) {
+        Settings.CongestionControlAlgorithm = ScavengerAlgorithm;
+        Settings.IsSet.CongestionControlAlgorithm = TRUE;
+    }
+#endif
 
     //
     // Configures a default client configuration, optionally disabling
@@ -1111,6 +1143,22 @@ main(
         goto Error;
     }
 
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+    //
+    // Register the sample scavenger congestion control. This must be done
+    // before the first registration is opened.
+    //
+    if (GetFlag(argc, argv, "scavenger")) {
+        QUIC_CUSTOM_CONGESTION_CONTROL Scavenger;
+        LedbatGetCongestionControl(ScavengerAlgorithm, NULL, &Scavenger);
+        if (QUIC_FAILED(Status = MsQuic->SetParam(NULL, QUIC_PARAM_GLOBAL_CUSTOM_CONGESTION_CONTROL, sizeof(Scavenger), &Scavenger))) {
+            printf("SetParam(QUIC_PARAM_GLOBAL_CUSTOM_CONGESTION_CONTROL) failed, 0x%x!\n", Status);
+            goto Error;
+        }
+        UseScavenger = TRUE;
+    }
+#endif
+
     //
     // Create a registration for the app's connections.
     //